@@ -3,6 +3,8 @@
 #define __mixr_base_Component_H__
 
 #include "mixr/base/Object.hpp"
+#include "mixr/base/EventTable.hpp"
+#include "mixr/base/UpdatePlan.hpp"
 #include "mixr/base/safe_ptr.hpp"
 
 namespace mixr {
@@ -71,6 +73,14 @@ class String;
 //          'dt' is the delta time in seconds between calls.  Derived classes
 //          will provide updateData() routines, as needed.
 //
+//       UpdatePlan* getUpdatePlan()
+//          Returns a ref()'d pointer to the update plan of our component tree,
+//          which is a flat array of our (selected) components, their components,
+//          etc.  The plan is rebuilt only after a component is added, removed
+//          or selected anywhere in our tree.  Running the plan's tcFrame() or
+//          updateData() updates our tree without the per-level ref()'d component
+//          lists (see UpdatePlan.hpp).
+//
 //       bool isFrozen()
 //       freeze(bool flag)
 //          Gets/Sets our freeze flag.  When the freeze flag is set, delta time is
@@ -207,6 +217,11 @@ class String;
 //    handlers will return a boolean which will be 'true' if the event is processed,
 //    or 'false' if the event was not processed.
 //
+//    The macros build a per-class EventTable on the first event, and then each
+//    event is dispatched by a hash lookup of its token, with the ON_EVENT_OBJ
+//    argument types checked by MetaObject in place of dynamic_cast<> (see
+//    EventTable.hpp and macros.hpp).
+//
 //    Events that are not processed are passed up to the 'BaseClass' class until reaching
 //    this Component class.  'Key' events (see eventTokens.hpp) that are not processed by
 //    this Component class are passed up to the container object.
@@ -312,6 +327,7 @@ public:
    virtual void updateTC(const double dt = 0.0);
    virtual void updateData(const double dt = 0.0);
    void tcFrame(const double dt = 0.0);
+   UpdatePlan* getUpdatePlan();
 
    virtual bool isFrozen() const;
    virtual bool isNotFrozen() const;
@@ -390,6 +406,10 @@ protected:
          Component* const remove = nullptr   // Optional component to remove
       );
 
+   // Event table builder of the ON_EVENT() macros when they're used outside of
+   // BEGIN_EVENT_HANDLER(), i.e., never in build mode (see macros.hpp)
+   static EventTable* const _eventBuilder;
+
 private:
    safe_ptr<PairStream> components;    // Child components
    Component* containerPtr {};         // We are a component of this container
@@ -397,12 +417,17 @@ private:
    Component* selected {};             // Selected child (process only this one)
    Object* selection {};               // Name of selected child
 
+   safe_ptr<UpdatePlan> updatePlan;    // Update plan of our tree (see getUpdatePlan())
+   std::atomic<unsigned int> structVersion {}; // Structure version of our tree
+
    Statistic* timingStats {};          // Timing statistics
    bool pts {};                        // Print timing statistics
    bool frz {};                        // Freeze flag -- true if this component is frozen
    bool shutdown {};                   // True if this component is being (or has been) shutdown
 
 private:
+   void structureChanged();            // Our tree's structure has changed
+
    // slot table helper methods
    bool setSlotComponent(PairStream* const multiple);        // Sets the components list
    bool setSlotComponent(Component* const single);           // Sets a single component
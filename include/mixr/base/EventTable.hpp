@@ -0,0 +1,91 @@
+
+#ifndef __mixr_base_EventTable_H__
+#define __mixr_base_EventTable_H__
+
+#include <atomic>
+
+namespace mixr {
+namespace base {
+class Component;
+class MetaObject;
+class Object;
+
+//------------------------------------------------------------------------------
+// Class: EventTable
+//
+// Description: Event dispatch table of a component class: maps event tokens to
+//              the class' event handlers, which is used by the event() functions
+//              that are implemented using the BEGIN_EVENT_HANDLER() and
+//              END_EVENT_HANDLER() macros (see macros.hpp).
+//
+//    Each of those event() functions has its own (static) table, which is built
+//    the first time the function is called: the event() function body is run
+//    once in "build" mode, where the ON_EVENT(), ON_EVENT_OBJ(), ON_ANYKEY() and
+//    ON_ANYKEY_OBJ() macros add their entries to the table, in order.  After
+//    that, event() looks up the token's entries in a hash table and calls their
+//    handlers, in order, until one returns true, and unused events are passed to
+//    the BaseClass::event() function; there's no linear chain of token compares.
+//
+//    The argument type of ON_EVENT_OBJ() and ON_ANYKEY_OBJ() entries is checked
+//    using the argument's MetaObject (see Object::isKindOf()) in place of a
+//    dynamic_cast<>.
+//
+//    The table is built under a lock, and it's read-only once it's built.
+//------------------------------------------------------------------------------
+class EventTable
+{
+public:
+   // Handler thunk: calls the component's "on event" function (see the ON_EVENT macros)
+   typedef bool (*handler_func)(Component* const comp, const int event, Object* const obj);
+
+public:
+   EventTable() = default;
+   EventTable(const EventTable&) = delete;
+   EventTable& operator=(const EventTable&) = delete;
+   ~EventTable();
+
+   // Build mode: beginBuild() returns this table if it needs to be built (and
+   // then the caller adds the entries and calls endBuild()), or zero if it's
+   // already built.
+   EventTable* beginBuild();
+   void add(const int token, const MetaObject* const argType, const bool anyKey, handler_func handler);
+   void endBuild();
+
+   // Dispatches the event to the table's handlers; returns true if it was used
+   bool dispatch(Component* const comp, const int event, Object* const obj) const;
+
+private:
+   struct Entry {
+      int token;                 // Event token (not used by 'any key' entries)
+      const MetaObject* argType; // Argument type, or zero if there's no argument
+      bool anyKey;               // Entry handles any key event
+      handler_func handler;
+   };
+
+   struct Slot {
+      int token;                 // Event token
+      unsigned int first;        // First of the token's entries in 'lists'
+      unsigned int count;        // Number of entries, or zero for an empty slot
+   };
+
+   const Slot* find(const int token) const;
+
+   Entry* entries {};            // Entries, in order
+   unsigned int numEntries {};
+   unsigned int maxEntries {};
+
+   unsigned int* lists {};       // Each token's entries (entry indices, in order)
+   unsigned int keyFirst {};     // 'Any key' entries, used for key events that
+   unsigned int keyCount {};     //   have no entries of their own
+
+   Slot* slots {};               // Hash table of the tokens
+   unsigned int numSlots {};     // Hash table size (power of two)
+
+   std::atomic<bool> built {};
+   long semaphore {};
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,110 @@
+
+#ifndef __mixr_base_FactoryTable_H__
+#define __mixr_base_FactoryTable_H__
+
+#include <atomic>
+#include <string>
+
+namespace mixr {
+namespace base {
+class Object;
+
+//------------------------------------------------------------------------------
+// Class: FactoryTable
+//
+// Description: Hashed table of factory names and the functions that create
+//              their objects, which the library factory() functions use in
+//              place of chains of string compares.
+//
+//    Each library's factory.cpp defines its table from an array of entries,
+//    one per class, using the FACTORY_ENTRY() macro:
+//
+//       const base::FactoryTable::Entry entries[] = {
+//          FACTORY_ENTRY(Simulation),
+//          FACTORY_ENTRY(Station),
+//       };
+//       const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+//
+//       base::Object* factory(const std::string& name)
+//       {
+//          return table.create(name);
+//       }
+//
+//    If the same factory name is in the table more than once, the first entry
+//    is used (same as the old chains of string compares).
+//
+//    The hash table is built on first use (i.e., after static initialization,
+//    when the classes' factory names are available), and it's kept at most
+//    half full (open addressing with linear probing of FNV-1a hashes).
+//
+//
+// Registry:
+//
+//    The tables register themselves, when they're constructed, in a global
+//    list, and createObject() creates an object using the first registered
+//    table with the factory name: a runtime object creation API that doesn't
+//    need the application's factory function.  Only the tables of the libraries
+//    that are linked into the application (i.e., whose factory() functions are
+//    referenced) are registered.  The EDL parser uses createObject() when it's
+//    not given a factory function.
+//------------------------------------------------------------------------------
+class FactoryTable
+{
+public:
+   typedef const char* (*name_func)();    // Class' getFactoryName() function
+   typedef Object* (*create_func)();      // Creates a new object of the class
+
+   struct Entry {
+      name_func name;
+      create_func create;
+   };
+
+   // Create function of class 'T' (see FACTORY_ENTRY())
+   template <class T> static Object* newObject()   { return new T(); }
+
+public:
+   FactoryTable(const Entry* const entries, const unsigned int numEntries);
+   FactoryTable(const FactoryTable&) = delete;
+   FactoryTable& operator=(const FactoryTable&) = delete;
+   ~FactoryTable();
+
+   unsigned int getNumEntries() const             { return numEntries; }
+
+   // Returns a new object with factory name 'name', or nullptr if the name isn't in the table
+   Object* create(const std::string& name) const;
+   Object* create(const char* const name) const;
+
+   // Is 'name' in the table?
+   bool isFactoryName(const char* const name) const;
+
+   // Returns a new object with factory name 'name' using the registered tables,
+   // or nullptr if the name isn't in any of them
+   static Object* createObject(const std::string& name);
+
+private:
+   struct Slot {
+      const char* name;       // Factory name, or zero for an empty slot
+      unsigned int entry;     // Index of the entry
+   };
+
+   const Slot* find(const char* const name) const;
+   const Slot* getHashTable() const;      // builds the hash table on first use
+
+   const Entry* entries {};
+   unsigned int numEntries {};
+
+   mutable std::atomic<Slot*> hashTable {};
+   mutable unsigned int hashSize {};      // Hash table size (power of two)
+   mutable long semaphore {};
+
+   mutable const FactoryTable* next {};   // Next registered table (mutable: set on const tables)
+};
+
+}
+}
+
+// Factory table entry of class 'ThisType'
+#define FACTORY_ENTRY(ThisType)                                                        \
+    { &ThisType::getFactoryName, &::mixr::base::FactoryTable::newObject<ThisType> }
+
+#endif
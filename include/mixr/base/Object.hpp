@@ -102,6 +102,14 @@ namespace base {
 //       bool isClassType(const type_info& type)
 //          Returns true if this object's class type is 'type' or if it is
 //          derived from class 'type'. <defined by the macros>
+//
+//       const MetaObject* getClassMetaObject()
+//          Returns the MetaObject of this object's class. <defined by the macros>
+//
+//       bool isKindOf(const MetaObject* const mo)
+//          Returns true if this object's class is the class of MetaObject 'mo',
+//          e.g., Foo::getMetaObject(), or if it is derived from it.  Same as
+//          isClassType(), but without RTTI; it's a walk up the MetaObject chain.
 
 //       const char* Foo::getClassName()
 //          Static function that returns the full class name of class Foo.
@@ -285,6 +293,8 @@ class Object : public Referenced
 
    // helper methods
    public: virtual bool isClassType(const std::type_info& type) const;
+   public: virtual const MetaObject* getClassMetaObject() const;
+   public: bool isKindOf(const MetaObject* const mo) const;
    public: virtual bool isFactoryName(const char name[]) const;
    public: static const char* getFactoryName();
 
@@ -297,6 +307,7 @@ class Object : public Referenced
    public: static const SlotTable& getSlotTable();
    protected: virtual bool setSlotByIndex(const int slotindex, Object* const obj);
    public: bool setSlotByName(const char* const slotname, Object* const obj);
+   public: bool setSlotByNumber(const int slotindex, Object* const obj);
    public: const char* slotIndex2Name(const int slotindex) const;
    public: int slotName2Index(const char* const slotname) const;
 
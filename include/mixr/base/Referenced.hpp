@@ -4,15 +4,24 @@
 
 // framework configuration file
 #include "mixr/config.hpp"
-// lock/unlock, etc - reference system needs it
+// lock/unlock, etc
 #include "mixr/base/util/atomics.hpp"
 
+#include <atomic>
+
 namespace mixr {
 namespace base {
 
 //------------------------------------------------------------------------------
 // Class: Referenced
 // Description: Base class to enable reference counting mechanism for objects
+//
+//    The reference count is a lock-free atomic counter: ref() is a relaxed
+//    increment, and unref() is a release decrement followed by an acquire
+//    fence before the object is deleted.
+//
+//    The invalid reference count check in ref() (ExpInvalidRefCount) is
+//    enabled by MIXR_CONFIG_REF_COUNT_CHECKS (see "mixr/config.hpp").
 //------------------------------------------------------------------------------
 class Referenced
 {
@@ -22,7 +31,7 @@ public:
    Referenced& operator=(const Referenced&) = delete;
    virtual ~Referenced() =0;
 
-   unsigned int getRefCount() const { return refCount; }
+   unsigned int getRefCount() const { return refCount.load(std::memory_order_relaxed); }
 
    // ---
    // ref() --
@@ -68,31 +77,35 @@ public:
    };
 
 private:
-   mutable long semaphore {};           // ref(), unref() semaphore
-   mutable unsigned int refCount {1};   // reference count
+   mutable std::atomic<unsigned int> refCount {1};   // reference count
 };
 
 inline Referenced::~Referenced() {}
 
 inline void Referenced::ref() const
 {
-   lock(semaphore);
-   if (++(refCount) <= 1) throw new ExpInvalidRefCount();
-   else unlock(semaphore);
+   #if MIXR_CONFIG_REF_COUNT_CHECKS
+   if (refCount.fetch_add(1, std::memory_order_relaxed) < 1) throw new ExpInvalidRefCount();
+   #else
+   refCount.fetch_add(1, std::memory_order_relaxed);
+   #endif
 
    #ifdef MAX_REF_COUNT_ERROR
-   static int maxRefCount = MAX_REF_COUNT_ERROR;
-   if (which->refCount > maxRefCount) {
-      std::cout << "ref(" << this << "): refCount(" << which->refCount << ") exceeded max refCount(" << maxRefCount << ")." << std::endl;
+   static unsigned int maxRefCount = MAX_REF_COUNT_ERROR;
+   if (getRefCount() > maxRefCount) {
+      std::cout << "ref(" << this << "): refCount(" << getRefCount() << ") exceeded max refCount(" << maxRefCount << ")." << std::endl;
    }
    #endif
 }
 
 inline void Referenced::unref() const
 {
-   lock(semaphore);
-   if (--refCount == 0) delete this;
-   else unlock(semaphore);
+   // Release our writes to the object; the thread that deletes
+   // the object acquires everyone's writes before the delete.
+   if (refCount.fetch_sub(1, std::memory_order_release) == 1) {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      delete this;
+   }
 }
 
 }
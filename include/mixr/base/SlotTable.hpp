@@ -2,6 +2,8 @@
 #ifndef __mixr_base_SlotTable_H__
 #define __mixr_base_SlotTable_H__
 
+#include <atomic>
+
 namespace mixr {
 namespace base {
 
@@ -21,6 +23,11 @@ namespace base {
 // Slot tables are usually defined using the macros BEGIN_SLOTTABLE and
 // END_SLOTTABLE (see macros.hpp).
 //
+// The slot names of this table and all base class tables are hashed, on the
+// first call to index(), into a single table of names and index numbers, so
+// index() doesn't search each table in the chain.  As before, if a name is in
+// more than one table, the index of the most derived table's slot is used.
+//
 //------------------------------------------------------------------------------
 class SlotTable
 {
@@ -43,9 +50,20 @@ public:
    const char* name(const int slotindex) const;
 
 private:
+   struct Entry {
+      const char* name;       // Slot name, or zero for an empty entry
+      int index;              // Slot index number
+   };
+
+   const Entry* getHashTable() const;   // builds the hash table on first use
+
    SlotTable* baseTable {};   // Pointer to base class's slot table
    char** slots1 {};          // Array of slot names
    int nslots1 {};            // Number of slots in table
+
+   mutable std::atomic<Entry*> hashTable {};    // Slot names of all tables
+   mutable unsigned int hashSize {};            // Hash table size (power of two)
+   mutable long semaphore {};
 };
 
 }
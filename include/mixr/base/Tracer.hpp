@@ -0,0 +1,224 @@
+
+#ifndef __mixr_base_Tracer_H__
+#define __mixr_base_Tracer_H__
+
+// framework configuration file
+#include "mixr/config.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace mixr {
+namespace base {
+
+//------------------------------------------------------------------------------
+// Class: Tracer
+//
+// Description: Low overhead tracing profiler: records the begin and end times
+//              of named zones (e.g., a player's tcFrame(), a simulation phase or
+//              a network's input frame), on each thread, and writes them to a
+//              Chrome trace (JSON) file, which can be viewed using Perfetto
+//              (ui.perfetto.dev) or chrome://tracing.
+//
+//    Zones are scoped using the MIXR_TRACE_ZONE() and MIXR_TRACE_ZONE_ID()
+//    macros (see below); the zone names must be string literals (or other
+//    static strings).  The macros are compiled out when MIXR_CONFIG_TRACING
+//    is zero, and they only check the enabled flag when tracing is disabled.
+//
+//    MIXR_CONFIG_TRACING defaults to one (see config.hpp): while the tracer is
+//    disabled, a zone is a relaxed load and a branch (about 1 ns), and zones
+//    are only placed around whole frames, phases and per-player updates (tens
+//    of zones per player per frame), so traces can be taken from a release
+//    build, e.g. on a frame overrun, without rebuilding it.  Define it as zero
+//    to compile the zones out.
+//
+//    Each thread writes its zones to its own ring buffer of the last
+//    MIXR_CONFIG_TRACE_BUFFER_SIZE zones, without locks.  The buffers are
+//    created on each thread's first zone, and they're kept for the life of
+//    the process, so zones of threads that have ended can still be dumped.
+//    A zone looks up its thread's buffer when it starts, and the zone is
+//    written to the buffer inline when it ends.
+//
+//    The zone times are taken from the CPU's time stamp counter (x86), which
+//    is converted to wall clock time when the zones are dumped, or else from
+//    std::chrono::steady_clock; an enabled zone reads the time once at each
+//    of its two edges.
+//
+// Functions:
+//
+//    bool isEnabled()
+//    void setEnabled(const bool flag)
+//       Gets/sets the enabled flag (default: false); no zones are recorded
+//       while the tracer is disabled.
+//
+//    void clear()
+//       Clears the zones that have been recorded (i.e., they're not dumped).
+//
+//    void setThreadName(const char* const name)
+//       Sets the name (static string) of the calling thread, as shown by the
+//       trace viewers (e.g., the base::Thread classes use their factory names);
+//       the dumps add the thread's index to its name (e.g., "SyncTask 3"), so
+//       the threads of the same class can be told apart.
+//
+//    bool dump(const char* const filename)
+//       Writes the recorded zones of all threads to a Chrome trace file; can be
+//       called from any thread.
+//
+//    Frame overruns:
+//
+//    void setOverrunFile(const char* const filename)
+//       Sets the file that's written on a frame overrun (or zero for none).
+//
+//    void frameOverrun()
+//       A periodic task's frame has overrun (see PeriodicTask); requests an
+//       overrun dump, if there's an overrun file.
+//
+//    bool processRequests()
+//       Writes the requested overrun dump, if any, and returns true if it was
+//       written; called by a background task (e.g., Station's background
+//       thread) so the file isn't written by the time-critical thread.
+//------------------------------------------------------------------------------
+class Tracer
+{
+public:
+   static const unsigned int BUFFER_SIZE = MIXR_CONFIG_TRACE_BUFFER_SIZE;
+
+public:
+   Tracer() = delete;
+
+   static bool isEnabled()                   { return enabled.load(std::memory_order_relaxed); }
+   static void setEnabled(const bool flag);
+   static void clear();
+
+   static void setThreadName(const char* const name);
+
+   static bool dump(const char* const filename);
+
+   static void setOverrunFile(const char* const filename);
+   static void frameOverrun();
+   static bool processRequests();
+
+   // Current time stamp (ticks)
+   static std::uint64_t now();
+
+   // Recorded zone; the fields are atomics because dump() can read a zone
+   // while its thread is overwriting it
+   struct Zone {
+      std::atomic<const char*> name;
+      std::atomic<int> id;
+      std::atomic<std::uint64_t> t0;
+      std::atomic<std::uint64_t> t1;
+   };
+
+   // Thread's ring buffer of the last BUFFER_SIZE zones
+   struct Buffer {
+      Zone zones[BUFFER_SIZE];
+      std::atomic<std::uint64_t> head;    // Number of zones recorded
+      std::atomic<const char*> name;      // Thread name
+      unsigned int tid;                   // Thread number
+      Buffer* next;                       // Next buffer in the list
+   };
+
+   // Calling thread's buffer, which is created on its first zone
+   static Buffer* getBuffer();
+
+   // Records a zone in the calling thread's buffer, 'b'
+   static void record(Buffer* const b, const char* const name, const int id, const std::uint64_t t0, const std::uint64_t t1);
+
+private:
+   static std::atomic<bool> enabled;
+};
+
+inline std::uint64_t Tracer::now()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+   return __rdtsc();
+#else
+   return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+inline void Tracer::record(Buffer* const b, const char* const name, const int id, const std::uint64_t t0, const std::uint64_t t1)
+{
+   const std::uint64_t h {b->head.load(std::memory_order_relaxed)};
+
+   // (orders our previous 'head' store before the zone stores; see dump())
+   std::atomic_thread_fence(std::memory_order_release);
+
+   Zone& z {b->zones[h & (BUFFER_SIZE - 1)]};
+   z.name.store(name, std::memory_order_relaxed);
+   z.id.store(id, std::memory_order_relaxed);
+   z.t0.store(t0, std::memory_order_relaxed);
+   z.t1.store(t1, std::memory_order_relaxed);
+   b->head.store(h + 1, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+// Class: TraceZone
+//
+// Description: Scoped trace zone; records the zone from its construction
+//              to its destruction, if the tracer is enabled.  Use the
+//              MIXR_TRACE_ZONE() macros.
+//------------------------------------------------------------------------------
+class TraceZone
+{
+public:
+   TraceZone(const char* const zoneName, const int zoneId = 0) : name(zoneName), id(zoneId)
+   {
+      if (Tracer::isEnabled()) {
+         buffer = Tracer::getBuffer();
+         t0 = Tracer::now();
+      }
+   }
+
+   ~TraceZone()
+   {
+      if (buffer != nullptr) Tracer::record(buffer, name, id, t0, Tracer::now());
+   }
+
+   TraceZone(const TraceZone&) = delete;
+   TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+   const char* name {};
+   int id {};
+   std::uint64_t t0 {};
+   Tracer::Buffer* buffer {};       // Thread's buffer, if the zone is being recorded
+};
+
+}
+}
+
+//------------------------------------------------------------------------------
+// Macro: MIXR_TRACE_ZONE(name) and MIXR_TRACE_ZONE_ID(name, id)
+//
+//    Records the rest of the enclosing scope as the zone 'name' (string
+//    literal), with an optional integer 'id' (e.g., a player ID), if the
+//    tracer is enabled.  Compiled out when MIXR_CONFIG_TRACING is zero.
+//
+//    Example:
+//
+//       void Foo::process(const double dt)
+//       {
+//          MIXR_TRACE_ZONE("Foo::process");
+//          ...
+//       }
+//------------------------------------------------------------------------------
+#if MIXR_CONFIG_TRACING
+#define MIXR_TRACE_ZONE(name)             ::mixr::base::TraceZone _traceZone(name)
+#define MIXR_TRACE_ZONE_ID(name, id)      ::mixr::base::TraceZone _traceZone(name, id)
+#else
+#define MIXR_TRACE_ZONE(name)
+#define MIXR_TRACE_ZONE_ID(name, id)
+#endif
+
+#endif
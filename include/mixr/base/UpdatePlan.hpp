@@ -0,0 +1,75 @@
+
+#ifndef __mixr_base_UpdatePlan_H__
+#define __mixr_base_UpdatePlan_H__
+
+#include "mixr/base/Referenced.hpp"
+
+namespace mixr {
+namespace base {
+class Component;
+
+//------------------------------------------------------------------------------
+// Class: UpdatePlan
+//
+// Description: Flattened update plan of a component tree: a single array of
+//              the root component and all of its (selected) descendants, where
+//              the children of each component are contiguous entries.
+//
+//    The plan is built by Component::getUpdatePlan(), and it's rebuilt only
+//    after the structure of the tree is changed (i.e., components are added,
+//    removed or selected; see Component::processComponents() and select()).
+//
+//    tcFrame(dt) and updateData(dt)
+//       Calls the root component's tcFrame() or updateData().  While the plan
+//       is running, Component::updateTC() and updateData() get their children
+//       from the plan (see updateChildrenTC() and updateChildrenData()) in
+//       place of their ref()'d components lists, so the tree is updated without
+//       any reference counting or list traversal.  The derived classes'
+//       updateTC() and updateData() functions are called as usual, so the order
+//       of the updates is the same as without the plan.
+//
+//    The plan ref()'s the descendant components, so a component that is
+//    removed from the tree while another thread is running the plan is not
+//    deleted.  The root component, which owns the plan, is not ref()'d.
+//
+//    Once built, a plan is read-only, and it can be run by several threads
+//    at the same time (e.g., T/C and background threads); each thread's
+//    current plan entry is thread local.
+//------------------------------------------------------------------------------
+class UpdatePlan : public Referenced
+{
+public:
+   UpdatePlan(Component* const root, const unsigned int version);
+   ~UpdatePlan();
+
+   unsigned int getVersion() const            { return version; }
+   unsigned int getNumEntries() const         { return numEntries; }
+
+   // Updates the root component's tree
+   void tcFrame(const double dt) const;
+   void updateData(const double dt) const;
+
+   // Updates the children of component 'c' and returns true, if 'c' is being
+   // updated by a plan on this thread; else returns false
+   static bool updateChildrenTC(Component* const c, const double dt);
+   static bool updateChildrenData(Component* const c, const double dt);
+
+private:
+   struct Entry {
+      Component* comp;           // Component
+      unsigned int first;        // Component's first child entry
+      unsigned int count;        // Number of child entries
+   };
+
+   void add(Component* const c, unsigned int* const maxEntries);
+   static const Entry* current(const Component* const c);
+
+   Entry* entries {};            // Entries; the root is entry zero
+   unsigned int numEntries {};
+   unsigned int version {};      // Root's structure version
+};
+
+}
+}
+
+#endif
@@ -18,11 +18,64 @@ class Component;
 //    work function, userFunc(), which is called at fixed rate of 'rate' Hz
 //    until the parent component is shutdown.  A value of 1.0/rate is passed
 //    to userFunc() as the delta time parameter.
+//
+//    The frames are scheduled on an absolute timeline (Linux: CLOCK_MONOTONIC
+//    and clock_nanosleep(TIMER_ABSTIME)), so the frame rate doesn't drift and
+//    isn't affected by changes to the time of day.  With a busy wait time,
+//    the thread sleeps until that many microseconds before the start of the
+//    frame, and then spins until the start of the frame, which reduces the
+//    start of frame jitter at the cost of CPU time.
+//
+// Overrun policies:
+//
+//    A frame overruns when userFunc() ends after the start of the next frame.
+//
+//    CATCH_UP       Run the late frames back to back until we've caught up
+//                   with the timeline; delta time is always 1.0/rate (default)
+//
+//    SKIP_FRAMES    Skip the frames that were missed and wait for the start of
+//                   the next frame on the timeline; delta time is always 1.0/rate
+//
+//    REAL_DT        Start the next frame right away, on a new timeline, and pass
+//                   the actual time since the start of the previous frame as the
+//                   delta time
+//
+// Frame statistics (see getFrameStats()):
+//
+//    numFrames      Total frame count
+//    numOverruns    Number of overrun frames
+//    numSkipped     Number of skipped frames
+//    frameTimes     Histogram of the userFunc() times: bin 'i' counts the frames
+//                   that took i*10% to (i+1)*10% of the frame period; the last
+//                   bin counts the frames that took 190% or more.
+//    maxFrameTime   Max userFunc() time (seconds)
+//    avgLateStart   Average time from the scheduled start of frame to the
+//    maxLateStart   call to userFunc(), and its max (seconds)
+//
+//    The statistics are updated by the thread at the end of each frame, and
+//    getFrameStats() can be called from any thread.  An overrun frame also
+//    requests the tracer's overrun dump (see Tracer::frameOverrun()).
 //------------------------------------------------------------------------------
 class PeriodicTask : public Thread
 {
    DECLARE_SUBCLASS(PeriodicTask, Thread)
 
+public:
+   // Overrun policies
+   enum OverrunPolicy { CATCH_UP, SKIP_FRAMES, REAL_DT };
+
+   // Frame statistics
+   static const unsigned int NUM_FRAME_TIME_BINS = 20;
+   struct FrameStats {
+      unsigned int numFrames;                         // Total frame count
+      unsigned int numOverruns;                       // Number of overrun frames
+      unsigned int numSkipped;                        // Number of skipped frames
+      unsigned int frameTimes[NUM_FRAME_TIME_BINS];   // Frame time histogram (10% of the period per bin)
+      double maxFrameTime;                            // Max frame time (seconds)
+      double avgLateStart;                            // Average start of frame latency (seconds)
+      double maxLateStart;                            // Max start of frame latency (seconds)
+   };
+
 public:
    PeriodicTask(Component* const parent, const double priority, const double rate);
 
@@ -30,10 +83,21 @@ public:
    unsigned int getTotalFrameCount() const;        // Total frame count
 
    // Busted (overrun) frames statistics; overrun frames time (seconds)
-   // (Windows only)
    const Statistic& getBustedFrameStats() const;
 
-   // Variable delta time flag (windows only).
+   // Frame statistics; returns a copy of the current values
+   void getFrameStats(FrameStats* const stats) const;
+
+   // Overrun policy (set before creating the thread)
+   OverrunPolicy getOverrunPolicy() const;
+   bool setOverrunPolicy(const OverrunPolicy policy);
+
+   // Busy wait time before the start of each frame (microseconds; zero for no
+   // busy wait) (set before creating the thread)
+   unsigned int getBusyWaitTime() const;
+   bool setBusyWaitTime(const unsigned int usecs);
+
+   // Variable delta time flag -- same as the REAL_DT overrun policy.
    // If false (default), delta time is always passed as one over the update rate;
    // If true and there's a frame overrun then a delta time adjusted for the overrun
    // is used.
@@ -46,13 +110,27 @@ public:
 protected:
    PeriodicTask();
 
+   // Updates the frame statistics at the end of a frame
+   void updateFrameStats(
+      const double frameTime,       // userFunc() time (seconds)
+      const double lateStart,       // Start of frame latency (seconds)
+      const double overrun,         // Overrun time, or zero if the frame didn't overrun (seconds)
+      const unsigned int skipped    // Number of frames skipped
+   );
+
 private:
    virtual unsigned long mainThreadFunc() override;
 
    double rate {};         // Loop rate (hz); until our parent shuts down
-   Statistic bfStats {};   // Busted (overrun) frame statistics (windows only)
+   Statistic bfStats {};   // Busted (overrun) frame statistics
    unsigned int tcnt {};   // total frame count
-   bool vdtFlg {};         // Variable delta time flag
+
+   OverrunPolicy policy {CATCH_UP};    // Overrun policy
+   unsigned int busyWait {};           // Busy wait time (microseconds)
+
+   FrameStats fstats {};               // Frame statistics
+   double sumLateStart {};             // Sum of the start of frame latencies (seconds)
+   mutable long fsSemaphore {};        // Frame statistics lock
 };
 
 }
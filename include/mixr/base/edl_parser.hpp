@@ -11,7 +11,8 @@ class Object;
 
 //
 // factory function signature (e.g., factory(const std::string& name); )
-// -- the user defines this function
+// -- the user defines this function, or passes nullptr to use the registered
+// factory tables of the linked libraries (see FactoryTable::createObject())
 //
 typedef Object* (*factory_func)(const std::string& name);
 
@@ -21,6 +22,33 @@ typedef Object* (*factory_func)(const std::string& name);
 //
 extern Object* edl_parser(const std::string& filename, factory_func f, int* num_errors = nullptr);
 
+//
+// edl_compiler( text filename to parse, user supplied factory function to create objects,
+//               binary snapshot filename, pointer to variable for num of errors found )
+//
+//    Parses the EDL file, same as edl_parser(), and if there were no errors, writes a
+//    binary snapshot of the parsed objects: factory names and slot indices resolved to
+//    integers, and numeric lists stored as flat arrays.
+//
+extern Object* edl_compiler(const std::string& filename, factory_func f, const std::string& snapshot_file, int* num_errors = nullptr);
+
+//
+// edl_loader( binary snapshot filename, user supplied factory function to create objects,
+//             pointer to variable for num of errors found, text filename )
+//
+//    Rebuilds the objects from a snapshot written by edl_compiler(), without parsing.
+//    Returns nullptr if the snapshot can't be loaded, or if the EDL file name is given
+//    and the snapshot wasn't compiled from the EDL file's current contents; the caller
+//    should then use edl_parser() or edl_compiler().  For example,
+//
+//       Object* obj = edl_loader("scenario.snap", factory, &nerrors, "scenario.edl");
+//       if (obj == nullptr) obj = edl_compiler("scenario.edl", factory, "scenario.snap", &nerrors);
+//
+//    The snapshot is tied to the build: it's rejected if the slot names of any of
+//    its classes have changed.
+//
+extern Object* edl_loader(const std::string& snapshot_file, factory_func f, int* num_errors = nullptr, const std::string& filename = "");
+
 }
 }
 
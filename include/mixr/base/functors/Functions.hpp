@@ -18,6 +18,12 @@ class List;
 //------------------------------------------------------------------------------
 // Class: Func1
 // Description: Generic 1-Dimensional function; f(iv1)
+//
+// Note: fArray() of Func1 ... Func5 evaluates an array of inputs; when the
+// function is computed by its optional table, the table's lfiArray() is used
+// for the whole array.  Derived classes that override f() can also override
+// fArray(); by default, fArray() of a derived class calls f() for each input.
+//
 // Factory name: Func1
 //------------------------------------------------------------------------------
 class Func1 : public Function
@@ -28,6 +34,9 @@ public:
 
    virtual double f(const double iv1, FStorage* const s = nullptr) const;
 
+   // f() for each of the 'n' inputs (iv1[i]); results in 'values'
+   virtual void fArray(const double* const iv1, double* const values, const unsigned int n, FStorage* const s = nullptr) const;
+
 protected:
    // slot table helper methods
    virtual bool setSlotLfiTable(const Table* const) override;
@@ -46,6 +55,9 @@ public:
 
    virtual double f(const double iv1, const double iv2, FStorage* const s = nullptr) const;
 
+   // f() for each of the 'n' inputs (iv1[i], iv2[i]); results in 'values'
+   virtual void fArray(const double* const iv1, const double* const iv2, double* const values, const unsigned int n, FStorage* const s = nullptr) const;
+
 protected:
    // slot table helper methods
    virtual bool setSlotLfiTable(const Table* const) override;
@@ -64,6 +76,9 @@ public:
 
    virtual double f(const double iv1, const double iv2, const double iv3, FStorage* const s = nullptr) const;
 
+   // f() for each of the 'n' inputs (iv1[i], iv2[i], iv3[i]); results in 'values'
+   virtual void fArray(const double* const iv1, const double* const iv2, const double* const iv3, double* const values, const unsigned int n, FStorage* const s = nullptr) const;
+
 protected:
    // slot table helper methods
    virtual bool setSlotLfiTable(const Table* const) override;
@@ -82,6 +97,9 @@ public:
 
    virtual double f(const double iv1, const double iv2, const double iv3, const double iv4, FStorage* const s = nullptr) const;
 
+   // f() for each of the 'n' inputs (iv1[i], iv2[i], iv3[i], iv4[i]); results in 'values'
+   virtual void fArray(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, double* const values, const unsigned int n, FStorage* const s = nullptr) const;
+
 protected:
    // slot table helper methods
    virtual bool setSlotLfiTable(const Table* const) override;
@@ -100,6 +118,9 @@ public:
 
    virtual double f(const double iv1, const double iv2, const double iv3, const double iv4, const double iv5, FStorage* const s = nullptr) const;
 
+   // f() for each of the 'n' inputs (iv1[i], iv2[i], iv3[i], iv4[i], iv5[i]); results in 'values'
+   virtual void fArray(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, const double* const iv5, double* const values, const unsigned int n, FStorage* const s = nullptr) const;
+
 protected:
    // slot table helper methods
    virtual bool setSlotLfiTable(const Table* const) override;
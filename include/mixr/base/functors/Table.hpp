@@ -38,6 +38,18 @@ class Number;
 //       result is clamped at the last known dependent value.  If the extrapolate
 //       flag is true, we'll extrapolate beyond the given data table.
 //
+//    4) The lfiArray() functions interpolate an array of inputs in one call
+//       (see lfi_1D_array() ... lfi_5D_array() in "mixr/base/util/lfi.hpp")
+//       with the same results as calling lfi() for each input.  As with lfi(),
+//       using the lower dimension lfiArray() functions of a higher dimension
+//       table (e.g., Table1's on a Table3) interpolates at the first breakpoint
+//       of the higher dimensions.
+//
+//    5) The data and breakpoint arrays are reference counted, and they're
+//       shared, not copied, by copies (clones) of the table.  The arrays are
+//       never changed once they're loaded; setting new data or breakpoints
+//       replaces the array (see newArray(), shareArray() and releaseArray()).
+//
 // Exceptions:
 //      ExpInvalidTable
 //          Thrown by Table derived classes' lfi(), minX(), maxX(), minY(),
@@ -107,6 +119,11 @@ protected:
    virtual bool loadData(const List& list, double* const table) = 0;
    static bool loadVector(const List& list, double** table, unsigned int* n);
 
+   // Shared data and breakpoint arrays
+   static double* newArray(const unsigned int n);      // New array of 'n' values (one reference)
+   static double* shareArray(double* const array);     // Adds a reference to the array; returns 'array'
+   static void releaseArray(double* const array);      // Removes a reference; deletes the array with the last one
+
    bool valid {};        // Table is valid
 
 private:
@@ -43,6 +43,9 @@ public:
    // 1D Linear Function Interpolator: returns the result of f(x) using linear interpolation
    virtual double lfi(const double iv1, FStorage* const s = nullptr) const;
 
+   // 1D Linear Function Interpolator for the 'n' inputs iv1[0..n-1]; results in 'values'
+   void lfiArray(const double* const iv1, double* const values, const unsigned int n, FStorage* const s = nullptr) const;
+
    // Load the X (iv1) breakpoints
    virtual bool setXBreakpoints1(const List* const bkpts);
 
@@ -90,6 +93,10 @@ public:
    // 2D Linear Function Interpolator: returns the result of f(x,y) using linear interpolation
    virtual double lfi(const double iv1, const double iv2, FStorage* const s = nullptr) const;
 
+   // 2D Linear Function Interpolator for the 'n' inputs (iv1[i], iv2[i]); results in 'values'
+   void lfiArray(const double* const iv1, const double* const iv2, double* const values, const unsigned int n, FStorage* const s = nullptr) const;
+   using Table1::lfiArray;
+
    // Load the Y (iv2) breakpoints
    virtual bool setYBreakpoints2(const List* const bkpts);
 
@@ -139,6 +146,11 @@ public:
    // 3D Linear Function Interpolator: returns the result of f(x,y,z) using linear interpolation
    virtual double lfi(const double iv1, const double iv2, const double iv3, FStorage* const s = nullptr) const;
 
+   // 3D Linear Function Interpolator for the 'n' inputs (iv1[i], iv2[i], iv3[i]); results in 'values'
+   void lfiArray(const double* const iv1, const double* const iv2, const double* const iv3,
+                 double* const values, const unsigned int n, FStorage* const s = nullptr) const;
+   using Table2::lfiArray;
+
    // Loads the Z (iv3) breakpoints
    virtual bool setZBreakpoints3(const List* const bkpts);
 
@@ -190,6 +202,11 @@ public:
    // 4D Linear Function Interpolator: returns the result of f(x,y,z,w) using linear interpolation
    virtual double lfi(const double iv1, const double iv2, const double iv3, const double iv4, FStorage* const s = nullptr) const;
 
+   // 4D Linear Function Interpolator for the 'n' inputs (iv1[i], ... iv4[i]); results in 'values'
+   void lfiArray(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4,
+                 double* const values, const unsigned int n, FStorage* const s = nullptr) const;
+   using Table3::lfiArray;
+
    // Loads the W (iv4) breakpoints
    virtual bool setWBreakpoints4(const List* const bkpts);
 
@@ -242,6 +259,11 @@ public:
 
    virtual double lfi(const double iv1, const double iv2, const double iv3, const double iv4, const double iv5, FStorage* const s = nullptr) const;
 
+   // 5D Linear Function Interpolator for the 'n' inputs (iv1[i], ... iv5[i]); results in 'values'
+   void lfiArray(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4,
+                 const double* const iv5, double* const values, const unsigned int n, FStorage* const s = nullptr) const;
+   using Table4::lfiArray;
+
    // Loads the V (iv5) breakpoints
    virtual bool setVBreakpoints5(const List* const bkpts);
 
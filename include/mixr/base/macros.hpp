@@ -83,12 +83,22 @@
 //       events (see eventTokens.hpp) that are not mapped or processed by the
 //       Component class are passed to the container class.
 //
+//       The first call of event() runs the body of the function once to build
+//       the class' EventTable (a hash table of the tokens; see EventTable.hpp),
+//       and the events are then dispatched using the table, so the body should
+//       contain only the ON_EVENT() and ON_ANYKEY() macros.  A class that needs
+//       other code in its event() function (e.g., StateMachine) can write the
+//       function itself, using the same ON_EVENT() and ON_ANYKEY() macros, which
+//       are then tested in order, and end it by calling BaseClass::event().
+//
 //    ON_EVENT(token,onEvent)  (see eventTokens.hpp)
 //       Maps an event token, 'token', to the "on event" member function, 'onEvent'.
 //
 //    ON_EVENT_OBJ(token,onEvent,ObjType) 
 //       Maps an event token, 'token', with an argument of type 'ObjType' to the
-//       "on event" member function, 'onEvent'.
+//       "on event" member function, 'onEvent'.  The argument's type is checked
+//       using its MetaObject (see Object::isKindOf()), so 'ObjType' needs to be
+//       an Object class that's declared using DECLARE_SUBCLASS().
 //
 //    ON_ANYKEY(onEvent)
 //       Maps any event token to the "on event" member function, 'onEvent'.
@@ -123,6 +133,7 @@
 // to treat these macros, at least initially, as 'black boxes'.
 
 #include <typeinfo>   // need typeid()
+#include <type_traits> // need std::remove_pointer
 #include <cstring>    // need std::strcmp
 #include <iostream>   // need std::ostream
 
@@ -135,6 +146,7 @@
     protected: void copyData(const ThisType& org, const bool cc = false);                                                       \
     protected: void deleteData();                                                                                               \
     public: virtual bool isClassType(const std::type_info& type) const override;                                                \
+    public: virtual const ::mixr::base::MetaObject* getClassMetaObject() const override;                                        \
     private: static ::mixr::base::MetaObject metaObject;                                                                        \
     public: static const ::mixr::base::MetaObject* getMetaObject();                                                             \
     public: static const char* getFactoryName();                                                                                \
@@ -166,6 +178,10 @@
         if ( type == typeid(ThisType) ) return true;                                   \
         else return ThisType::BaseClass::isClassType(type);                            \
     }                                                                                  \
+    const ::mixr::base::MetaObject* ThisType::getClassMetaObject() const               \
+    {                                                                                  \
+        return &metaObject;                                                            \
+    }                                                                                  \
     ThisType::~ThisType() {                                                            \
         STANDARD_DESTRUCTOR()                                                          \
     }                                                                                  \
@@ -203,6 +219,10 @@
     {                                                                                  \
         if ( type == typeid(ThisType) ) return true;                                   \
         else return ThisType::BaseClass::isClassType(type);                            \
+    }                                                                                  \
+    const ::mixr::base::MetaObject* ThisType::getClassMetaObject() const               \
+    {                                                                                  \
+        return &metaObject;                                                            \
     }
 
 
@@ -225,6 +245,10 @@
         if ( type == typeid(ThisType) ) return true;                                   \
         else return ThisType::BaseClass::isClassType(type);                            \
     }                                                                                  \
+    const ::mixr::base::MetaObject* ThisType::getClassMetaObject() const               \
+    {                                                                                  \
+        return &metaObject;                                                            \
+    }                                                                                  \
     ThisType::~ThisType() {                                                            \
         STANDARD_DESTRUCTOR()                                                          \
     }                                                                                  \
@@ -324,38 +348,94 @@
     }
 
 
+// Event handler macros: in build mode (_eventBuilder isn't zero, see
+// BEGIN_EVENT_HANDLER()), the ON_EVENT() and ON_ANYKEY() macros add their
+// entries, with a handler thunk, to the class' EventTable; otherwise (e.g., in
+// Component::event(), where _eventBuilder is Component's zero constant), they
+// test and call the "on event" function directly.
+
 #define BEGIN_EVENT_HANDLER(ThisType)                                                  \
     bool ThisType::event(const int _event, ::mixr::base::Object* const _obj)           \
     {                                                                                  \
-        bool _used {};
+        static ::mixr::base::EventTable _eventTable;                                   \
+        ::mixr::base::EventTable* const _eventBuilder {_eventTable.beginBuild()};      \
+        if (_eventBuilder == nullptr) {                                                \
+            if (_eventTable.dispatch(this,_event,_obj)) return true;                   \
+            return BaseClass::event(_event,_obj);                                      \
+        }                                                                              \
+        bool _used {true};
 
 
 #define END_EVENT_HANDLER()                                                            \
+        _eventBuilder->endBuild();                                                     \
+        _used = _eventTable.dispatch(this,_event,_obj);                                \
         if (!_used) _used = BaseClass::event(_event,_obj);                             \
         return _used;                                                                  \
     }
 
 
 #define ON_EVENT_OBJ(token,onEvent,ObjType)                                            \
-    if (!_used && token == _event && dynamic_cast<ObjType*>(_obj) != nullptr) {        \
+    if (::mixr::base::EventTable* const _eb = _eventBuilder) {                         \
+        typedef std::remove_pointer<decltype(this)>::type _EventThisType;              \
+        struct _EventThunk {                                                           \
+            static bool call(::mixr::base::Component* const _c, const int,             \
+                             ::mixr::base::Object* const _o) {                         \
+                return static_cast<_EventThisType*>(_c)->onEvent(static_cast<ObjType*>(_o)); \
+            }                                                                          \
+        };                                                                             \
+        _eb->add(token, ObjType::getMetaObject(), false, &_EventThunk::call); \
+    }                                                                                  \
+    else if (!_used && token == _event && _obj != nullptr &&                           \
+             _obj->isKindOf(ObjType::getMetaObject())) {                               \
         _used = onEvent(static_cast<ObjType*>(_obj));                                  \
     }
 
 
 #define ON_EVENT(token,onEvent)                                                        \
-    if (!_used && token == _event) {                                                   \
+    if (::mixr::base::EventTable* const _eb = _eventBuilder) {                         \
+        typedef std::remove_pointer<decltype(this)>::type _EventThisType;              \
+        struct _EventThunk {                                                           \
+            static bool call(::mixr::base::Component* const _c, const int,             \
+                             ::mixr::base::Object* const) {                            \
+                return static_cast<_EventThisType*>(_c)->onEvent();                    \
+            }                                                                          \
+        };                                                                             \
+        _eb->add(token, nullptr, false, &_EventThunk::call);                 \
+    }                                                                                  \
+    else if (!_used && token == _event) {                                              \
         _used = onEvent();                                                             \
     }
 
 
-#define ON_ANYKEY_OBJ(onEvent,ObjType)                                                       \
-    if (!_used && _event <= MAX_KEY_EVENT && dynamic_cast<ObjType*>(_obj) != nullptr) {      \
-        _used = onEvent(_event,(static_cast<ObjType*>(_obj)));                               \
+#define ON_ANYKEY_OBJ(onEvent,ObjType)                                                 \
+    if (::mixr::base::EventTable* const _eb = _eventBuilder) {                         \
+        typedef std::remove_pointer<decltype(this)>::type _EventThisType;              \
+        struct _EventThunk {                                                           \
+            static bool call(::mixr::base::Component* const _c, const int _e,          \
+                             ::mixr::base::Object* const _o) {                         \
+                return static_cast<_EventThisType*>(_c)->onEvent(_e,(static_cast<ObjType*>(_o))); \
+            }                                                                          \
+        };                                                                             \
+        _eb->add(0, ObjType::getMetaObject(), true, &_EventThunk::call);     \
+    }                                                                                  \
+    else if (!_used && _event <= MAX_KEY_EVENT && _obj != nullptr &&                   \
+             _obj->isKindOf(ObjType::getMetaObject())) {                               \
+        _used = onEvent(_event,(static_cast<ObjType*>(_obj)));                         \
     }
 
 
 #define ON_ANYKEY(onEvent)                                                             \
-    if (!_used && _event <= MAX_KEY_EVENT) {                                           \
+    if (::mixr::base::EventTable* const _eb = _eventBuilder) {                         \
+        typedef std::remove_pointer<decltype(this)>::type _EventThisType;              \
+        struct _EventThunk {                                                           \
+            static bool call(::mixr::base::Component* const _c, const int _e,          \
+                             ::mixr::base::Object* const) {                            \
+                return static_cast<_EventThisType*>(_c)->onEvent(_e);                  \
+            }                                                                          \
+        };                                                                             \
+        _eb->add(0, nullptr, true, &_EventThunk::call);                      \
+    }                                                                                  \
+    else if (!_used && _event <= MAX_KEY_EVENT) {                                      \
         _used = onEvent(_event);                                                       \
     }
 
@@ -0,0 +1,158 @@
+
+#ifndef __mixr_base_mpsc_queue_H__
+#define __mixr_base_mpsc_queue_H__
+
+#include <atomic>
+
+namespace mixr {
+namespace base {
+
+//------------------------------------------------------------------------------
+// Template: mpsc_queue<T>
+//
+// Description: Bounded, lock-free, multiple producer/single consumer queue
+//              of items of type T
+//
+// Notes:
+//    1) Use the constructor's 'qsize' parameter to set the max size of the
+//       queue, which is rounded up to a power of two.
+//    2) Any number of threads can put() items; only one thread at a time may
+//       get() items.
+//    3) put() never blocks; it returns false if the queue is full.
+//    4) Each slot has a sequence number that tells the producers and the
+//       consumer whose turn it is, so there are no locks.
+//    5) get(items, max) drains up to 'max' items in one call; unlike get(),
+//       it doesn't need T to be constructible from zero (e.g., a struct).
+//    6) getNumContentions() counts the times a producer lost a slot to
+//       another producer and had to retry, and getNumFull() counts the
+//       items that put() rejected because the queue was full; use them to
+//       size the queue.
+//
+// Examples:
+//    base::mpsc_queue<Foo*>* q1 = new base::mpsc_queue<Foo*>(1024);
+//    q1->put(p1);          // puts p1 on the queue (any thread)
+//    q1->put(p2);          // puts p2 on the queue (any thread)
+//    Foo* p = q1->get();   // p is equal to p1 (consumer thread only)
+//
+//    Foo* list[16];
+//    unsigned int n = q1->get(list, 16);   // n is equal to 1; list[0] is p2
+//------------------------------------------------------------------------------
+template <class T> class mpsc_queue
+{
+public:
+   mpsc_queue(const unsigned int qsize) : SIZE(roundUp(qsize)), MASK(roundUp(qsize) - 1) {
+      cells = new Cell[SIZE];
+      for (unsigned int i = 0; i < SIZE; i++) {
+         cells[i].seq.store(i, std::memory_order_relaxed);
+      }
+   }
+   mpsc_queue(const mpsc_queue<T>&) = delete;
+   mpsc_queue<T>& operator=(const mpsc_queue<T>&) = delete;
+   ~mpsc_queue()                  { delete[] cells; }
+
+   unsigned int getSize() const   { return SIZE; }
+
+   // Number of items in the queue (approximate while producers are active)
+   unsigned int entries() const {
+      const unsigned int h = head.load(std::memory_order_relaxed);
+      const unsigned int n = tail.load(std::memory_order_relaxed) - h;
+      return (n <= SIZE ? n : 0);
+   }
+   bool isEmpty() const           { return (entries() == 0); }
+   bool isNotEmpty() const        { return (entries() != 0); }
+   bool isFull() const            { return (entries() >= SIZE); }
+   bool isNotFull() const         { return (entries() < SIZE); }
+
+   // Puts an item at the back of the queue; returns false if the queue is full
+   bool put(T item) {
+      unsigned int pos = tail.load(std::memory_order_relaxed);
+      for (;;) {
+         Cell& cell = cells[pos & MASK];
+         const unsigned int seq = cell.seq.load(std::memory_order_acquire);
+         const int dif = static_cast<int>(seq - pos);
+         if (dif == 0) {
+            // Our turn; claim the slot
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+               cell.item = item;
+               cell.seq.store(pos + 1, std::memory_order_release);
+               return true;
+            }
+            numContentions.fetch_add(1, std::memory_order_relaxed);
+         }
+         else if (dif < 0) {
+            // Slot still holds an item from the last time around
+            numFull.fetch_add(1, std::memory_order_relaxed);
+            return false;
+         }
+         else {
+            // Another producer claimed this slot
+            numContentions.fetch_add(1, std::memory_order_relaxed);
+            pos = tail.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   // Gets an item from the front of the queue (consumer thread only);
+   // returns zero if the queue is empty.
+   T get() {
+      T p = 0;
+      const unsigned int pos = head.load(std::memory_order_relaxed);
+      Cell& cell = cells[pos & MASK];
+      if (cell.seq.load(std::memory_order_acquire) == (pos + 1)) {
+         p = cell.item;
+         cell.seq.store(pos + SIZE, std::memory_order_release);
+         head.store(pos + 1, std::memory_order_relaxed);
+      }
+      return p;
+   }
+
+   // Gets up to 'max' items from the front of the queue (consumer thread
+   // only); returns the number of items
+   unsigned int get(T* const items, const unsigned int max) {
+      unsigned int n = 0;
+      unsigned int pos = head.load(std::memory_order_relaxed);
+      while (n < max) {
+         Cell& cell = cells[pos & MASK];
+         if (cell.seq.load(std::memory_order_acquire) != (pos + 1)) break;
+         items[n++] = cell.item;
+         cell.seq.store(pos + SIZE, std::memory_order_release);
+         pos++;
+      }
+      if (n > 0) head.store(pos, std::memory_order_relaxed);
+      return n;
+   }
+
+   // Counters (see note 6)
+   unsigned long getNumContentions() const  { return numContentions.load(std::memory_order_relaxed); }
+   unsigned long getNumFull() const         { return numFull.load(std::memory_order_relaxed); }
+   void clearCounters() {
+      numContentions.store(0, std::memory_order_relaxed);
+      numFull.store(0, std::memory_order_relaxed);
+   }
+
+private:
+   struct Cell {
+      std::atomic<unsigned int> seq;
+      T item {};
+   };
+
+   static unsigned int roundUp(const unsigned int n) {
+      unsigned int size = 2;
+      while (size < n) size <<= 1;
+      return size;
+   }
+
+   Cell* cells {};                         // The queue
+   const unsigned int SIZE {};             // Max size of the queue (power of two)
+   const unsigned int MASK {};             // SIZE - 1
+   std::atomic<unsigned int> tail {};      // Next put() position (producers)
+   std::atomic<unsigned long> numContentions {};   // Producer retries (see note 6)
+   std::atomic<unsigned long> numFull {};          // Items rejected, queue full
+   char pad[64] {};                        // Keeps 'head' and 'tail' on separate cache lines
+   std::atomic<unsigned int> head {};      // Next get() position (consumer)
+};
+
+}
+}
+
+#endif
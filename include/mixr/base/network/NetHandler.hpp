@@ -54,6 +54,9 @@ public:
    // the actual number of bytes received.
    virtual unsigned int recvData(char* const packet, const int maxSize) =0;
 
+   // Sends any buffered output data; returns true if successful
+   virtual bool flushData();
+
    // Set our socket for blocked (wait) I/O
    virtual bool setBlocked() =0;
 
@@ -3,11 +3,15 @@
 #define __mixr_base_PosixHandler_H__
 
 #include "mixr/base/network/NetHandler.hpp"
+#include "mixr/base/mpsc_queue.hpp"
+
+#include <atomic>
 
 namespace mixr {
 namespace base {
 class Number;
 class String;
+class Thread;
 
 //------------------------------------------------------------------------------
 // Class: PosixHandler
@@ -42,6 +46,15 @@ class String;
 //    ignoreSourcePort  ! Ignore messages from this port. This is one way to prevent receiving our
 //                      ! own data with multicast or broadcast.
 //
+//    batchSize         ! Max number of packets sent or received by each system call (Linux
+//                      ! recvmmsg()/sendmmsg()); zero or one disables batching (default: 0; max 64)
+//
+//    recvThread        ! Receive with our own thread (default: false)
+//
+//    recvQueueSize     ! Number of packet buffers in the receive thread's ring (default: 256)
+//
+//    recvPriority      ! Receive thread priority [ 0.0 ... 1.0 ] (default: 0.0 -- normal, non real-time)
+//
 //
 //    Local host side   Data Flow   Remote host side
 //    ---------------   ---------   ----------------
@@ -54,6 +67,31 @@ class String;
 //
 //      localPort#      <-------     <any-port>    ! Receiving anytime that 'localPort' is defined.
 //
+// Batched I/O (UDP sockets only):
+//
+//    With 'batchSize', recvData() reads up to 'batchSize' packets with each
+//    recvmmsg() call and returns them one at a time, and sendData() queues the
+//    packets until 'batchSize' packets are queued or flushData() is called, and
+//    then sends them all with one sendmmsg() call.  Users of batched output
+//    must call flushData() at the end of each output frame.
+//
+//    With 'recvThread', our receive thread waits for the packets, reads them
+//    (in batches, with 'batchSize') into a lock-free ring of 'recvQueueSize'
+//    packet buffers, and recvData() only takes the packets from the ring.
+//    When the ring is full, the packets are read and dropped.
+//
+//    Packets larger than MAX_PACKET_SIZE are dropped by the batched and threaded
+//    receive.  On other than Linux, the batch size is always one.
+//
+// Statistics:
+//
+//    getNumPacketsReceived()    ! Number of packets received
+//    getNumPacketsDropped()     ! Number of packets dropped (ring full or too large)
+//    getNumPacketsSent()        ! Number of packets sent
+//    getRecvBatchCount(bin)     ! Number of receive and send system calls by batch
+//    getSendBatchCount(bin)     ! size: bin 'i' counts the batches of 2^i to 2^(i+1)-1
+//                               ! packets [ 0 ... NUM_BATCH_BINS-1 ]
+//
 // Notes:
 //
 // M$ WinSock has slightly different return types, some different calling, and
@@ -68,6 +106,11 @@ class PosixHandler : public NetHandler
 {
    DECLARE_SUBCLASS(PosixHandler, NetHandler)
 
+public:
+   static const unsigned int MAX_BATCH_SIZE = 64;        // Max packets per system call
+   static const unsigned int MAX_PACKET_SIZE = 8192;     // Max size of batched/threaded packets
+   static const unsigned int NUM_BATCH_BINS = 7;         // Number of batch size histogram bins
+
 public:
    PosixHandler();
 
@@ -86,6 +129,7 @@ public:
    virtual bool closeConnection() override;
    virtual bool sendData(const char* const packet, const int size) override;
    virtual unsigned int recvData(char* const packet, const int maxSize) override;
+   virtual bool flushData() override;
    virtual bool setBlocked() override;
    virtual bool setNoWait() override;
 
@@ -93,11 +137,31 @@ public:
    uint32_t getLastFromAddr() const;     // IP address of last valid recvData()
    uint16_t getLastFromPort() const;     // Port address of last valid recvData()
 
+   // Batched I/O
+   unsigned int getBatchSize() const                 { return batchSize; }
+   bool isRecvThreadEnabled() const                  { return recvThreadEnabled; }
+   unsigned int getRecvQueueSize() const             { return recvQueueSize; }
+
+   // Statistics
+   unsigned int getNumPacketsReceived() const        { return numRecv; }
+   unsigned int getNumPacketsDropped() const         { return numDropped; }
+   unsigned int getNumPacketsSent() const            { return numSent; }
+   unsigned int getRecvBatchCount(const unsigned int bin) const;
+   unsigned int getSendBatchCount(const unsigned int bin) const;
+
+   // Receive thread's main loop (called by the receive thread)
+   void recvLoop();
+
 protected:
    virtual bool init() override;
+   virtual bool shutdownNotification() override;
 
    virtual bool bindSocket();          // Bind socket to address
 
+   // Sends a packet to 'ip' and 'port'; with batched output, the packet is
+   // queued and sent in order with the sendData() packets
+   bool sendPacket(const char* const packet, const int size, const uint32_t ip, const uint16_t port);
+
    // Sets the network IP address
    bool setNetAddr(const uint32_t);
 
@@ -138,6 +202,54 @@ private:
    unsigned int sendBuffSizeKb {32};   // Send buffer size in KBs
    unsigned int recvBuffSizeKb {128};  // Receive buffer size in KBs
 
+private:
+   // Batched and threaded I/O
+   struct Packet {
+      char data[MAX_PACKET_SIZE];      // Packet data
+      unsigned int size;               // Size of the packet (bytes)
+      uint32_t addr;                   // 'From' (received) or 'to' (sent) ip address
+      uint16_t port;                   // 'From' (received) or 'to' (sent) port number
+   };
+
+   bool isDatagramSocket() const;
+   bool waitForData(const unsigned int msecs) const;
+   unsigned int recvBatch(Packet** const pkts, const unsigned int n, const bool wait, unsigned int* const nRead);
+   bool sendBatch();
+   bool startRecvThread();
+   void stopRecvThread();
+   void deleteBuffers();
+   static unsigned int binOf(const unsigned int n);
+
+   unsigned int batchSize {};          // Max packets per system call (zero or one: no batching)
+   unsigned int recvQueueSize {256};   // Number of packet buffers in the receive ring
+   double recvPriority {};             // Receive thread priority
+   bool recvThreadEnabled {};          // Receive with our own thread
+
+   // Receive batch (without the receive thread)
+   Packet* recvBuff {};                // Packet buffers
+   Packet* recvPkts[MAX_BATCH_SIZE] {};   // Received packets
+   unsigned int recvCount {};          // Number of packets in the batch
+   unsigned int recvIndex {};          // Next packet in the batch
+
+   // Receive thread
+   Thread* recvThread {};              // Receive thread
+   std::atomic<bool> stopRecv {};      // Receive thread stop request
+   Packet* ringBuff {};                // Packet buffers (ring packets, then the thread's spare packets)
+   mpsc_queue<Packet*>* readyQueue {}; // Received packets (receive thread -> recvData())
+   mpsc_queue<Packet*>* freeQueue {};  // Free packets (recvData() -> receive thread)
+
+   // Send batch
+   Packet* sendBuff {};                // Queued packets
+   unsigned int sendCount {};          // Number of queued packets
+   long sendSemaphore {};              // Send batch lock
+
+   // Statistics
+   std::atomic<unsigned int> numRecv {};
+   std::atomic<unsigned int> numDropped {};
+   std::atomic<unsigned int> numSent {};
+   std::atomic<unsigned int> recvHist[NUM_BATCH_BINS] {};
+   std::atomic<unsigned int> sendHist[NUM_BATCH_BINS] {};
+
 private:
    // slot table helper methods
    bool setSlotLocalIpAddress(const String* const);
@@ -147,6 +259,10 @@ private:
    bool setSlotSendBuffSize(const Number* const);
    bool setSlotRecvBuffSize(const Number* const);
    bool setSlotIgnoreSourcePort(const Number* const);
+   bool setSlotBatchSize(const Number* const);
+   bool setSlotRecvThread(const Number* const);
+   bool setSlotRecvQueueSize(const Number* const);
+   bool setSlotRecvPriority(const Number* const);
 };
 
 // Port#
@@ -54,7 +54,8 @@ public:
    // Sets the destination port number (all future packets)
    bool setPort(const uint16_t n)               { return BaseClass::setPort(n); }
 
-   // Send data to a specific IP/Port
+   // Send data to a specific IP/Port; queued with the sendData() packets
+   // when the output is batched
    virtual bool sendDataTo(
          const char* const packet,  // Data packet
          const int size,            // Size of the data packet
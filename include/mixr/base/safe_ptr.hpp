@@ -4,6 +4,8 @@
 
 #include "mixr/base/util/atomics.hpp"
 
+#include <cstdint>
+
 namespace mixr {
 namespace base {
 
@@ -13,6 +15,15 @@ namespace base {
 // Description: Thread-safe shared pointer to an object of type T.
 //              Provides automatic ref() and unref() of the object.
 //
+//    Lock-free: the pointer shares a double word with a pin count and a
+//    generation, which are changed together by cas2() (see atomics.hpp).
+//    getRefPtr() pins the object before it ref()'s it, so it can't be
+//    deleted by a concurrent swap, and then unpins it.  Each swap (i.e.,
+//    assignment or set()) starts a new generation and moves the old
+//    object's pins to its ref count; a reader that finds a new generation
+//    when it unpins unref()'s the object instead.  The generation keeps
+//    that check free of ABA, even if the same object is swapped back in.
+//
 // Example #1
 //
 //    const auto ptr = new Object();      // New object; ref cnt is one
@@ -45,77 +56,105 @@ template <class T> class safe_ptr
 {
 public:
    safe_ptr() = default;
-   safe_ptr(T* x, const bool refThis = true) : ptr(x)    { if (ptr != nullptr && refThis) ptr->ref(); }
-   safe_ptr(safe_ptr<T>& x) : ptr(x.getRefPtr())         {}
-   ~safe_ptr()                                           { if (ptr != nullptr) ptr->unref(); }
+   safe_ptr(T* x, const bool refThis = true)             { word.lo = toWord(x); if (x != nullptr && refThis) x->ref(); }
+   safe_ptr(safe_ptr<T>& x)                              { word.lo = toWord(x.refPtr()); }
+   ~safe_ptr()                                           { T* x = ptr(); if (x != nullptr) x->unref(); }
 
    // Conversion operator to return raw pointer (T*)
-   operator T*()                               { return ptr; }
-   operator const T*() const                   { return ptr; }
+   operator T*()                               { return ptr(); }
+   operator const T*() const                   { return ptr(); }
    // Operators: -> == !=
-   bool operator==(const T* x) const           { return (ptr == x); }
-   bool operator!=(const T* x) const           { return (ptr != x); }
-   T* operator->()                             { return ptr; }
-   const T* operator->() const                 { return ptr; }
+   bool operator==(const T* x) const           { return (ptr() == x); }
+   bool operator!=(const T* x) const           { return (ptr() != x); }
+   T* operator->()                             { return ptr(); }
+   const T* operator->() const                 { return ptr(); }
 
    // Returns a pre-ref()'d pointer to the object
-   T* getRefPtr() {
-      lock();
-      T* x = ptr;
-      if (x != nullptr) x->ref();
-      unlock();
-      return x;
-   }
+   T* getRefPtr()                              { return refPtr(); }
 
    // Returns a pre-ref()'d const pointer to the object
-   const T* getRefPtr() const {
-      lock();
-      const T* x = ptr;
-      if (x != nullptr) x->ref();
-      unlock();
-      return x;
-   }
+   const T* getRefPtr() const                  { return refPtr(); }
 
    // Operator: =
    safe_ptr<T>& operator=(T* x) {
-      if (ptr != x) {
-         lock();
-         if (ptr != nullptr) ptr->unref();
-         ptr = x;
-         if (ptr != nullptr) ptr->ref();
-         unlock();
+      if (ptr() != x) {
+         if (x != nullptr) x->ref();
+         swap(x);
       }
       return *this;
    }
    safe_ptr<T>& operator=(safe_ptr<T>& x) {
-      if (this != &x) { 
-         x.lock();
-         operator=(x.ptr);
-         x.unlock();
+      if (this != &x) {
+         T* p = x.refPtr();
+         if (ptr() != p) swap(p);
+         else if (p != nullptr) p->unref();
       }
       return *this;
    }
 
    // set() -- set the pointer with an optional reference
    void set(T* const x, const bool refThis = true) {
-      lock();
-      if (ptr != nullptr) ptr->unref();
-      ptr = x;
-      if (ptr != nullptr && refThis) ptr->ref();
-      unlock();
+      if (x != nullptr && refThis) x->ref();
+      swap(x);
    }
 
 private:
-   void lock() const {
-      base::lock( semaphore );
+   // Pin count (low half) and generation (high half) of the high word
+   static const unsigned int GEN_SHIFT = 4 * sizeof(std::uintptr_t);
+   static const std::uintptr_t PIN_MASK = (static_cast<std::uintptr_t>(1) << GEN_SHIFT) - 1;
+
+   static std::uintptr_t toWord(const T* const x)     { return reinterpret_cast<std::uintptr_t>(x); }
+   T* ptr() const                                     { return reinterpret_cast<T*>(word.lo); }
+
+   // Returns a pre-ref()'d pointer to the object
+   T* refPtr() const {
+      // Pin the object, so that it can't be unref()'d by a swap while we
+      // ref() it ('w' may be torn; cas2() will get us the current word)
+      DoubleWord w = { word.lo, word.hi };
+      DoubleWord pinned {};
+      do {
+         if (w.lo == 0) return nullptr;
+         pinned.lo = w.lo;
+         pinned.hi = w.hi + 1;
+      } while (!cas2(&word, w, pinned));
+
+      T* x = reinterpret_cast<T*>(pinned.lo);
+      x->ref();
+
+      // Unpin it; if it's been swapped out since (i.e., a new generation),
+      // our pin was moved to its ref count, so unref() it instead
+      DoubleWord unpinned {};
+      w = pinned;
+      do {
+         if (w.lo != pinned.lo || (w.hi >> GEN_SHIFT) != (pinned.hi >> GEN_SHIFT)) {
+            x->unref();
+            break;
+         }
+         unpinned.lo = w.lo;
+         unpinned.hi = w.hi - 1;
+      } while (!cas2(&word, w, unpinned));
+
+      return x;
    }
 
-   void unlock() const {
-      base::unlock( semaphore );
+   // Swap in 'x', which has been ref()'d for us, with a new generation, and
+   // unref() the old object after moving its pins to its ref count
+   void swap(T* const x) {
+      DoubleWord w = { word.lo, word.hi };
+      DoubleWord n {};
+      n.lo = toWord(x);
+      do {
+         n.hi = ((w.hi >> GEN_SHIFT) + 1) << GEN_SHIFT;
+      } while (!cas2(&word, w, n));
+
+      T* old = reinterpret_cast<T*>(w.lo);
+      if (old != nullptr) {
+         for (std::uintptr_t i = (w.hi & PIN_MASK); i > 0; i--) old->ref();
+         old->unref();
+      }
    }
 
-   T* ptr {};                  // the pointer being managed
-   mutable long semaphore {};  // spin-lock semaphore
+   mutable DoubleWord word {};   // the pointer (lo) with its pin count and generation (hi)
 };
 
 }
@@ -110,8 +110,78 @@ double lfi_5D(const double x, const double y, const double z, const double w, co
          unsigned int* const vbp=nullptr
       );
 
+// ---
+// Array Linear Function Interpolators: same as lfi_1D() ... lfi_5D(), but
+// for the 'n' inputs in the independent variable arrays (e.g., x[0..n-1])
+// with the results in the array 'a'.
+//
+//    When the previous breakpoints (e.g., xbp) are given, the search for each
+//    input starts at the breakpoints of the previous input.  Otherwise, for
+//    uniformly spaced breakpoints the breakpoint is found directly, and for
+//    other tables by a binary search.
+// ---
+
+void lfi_1D_array(const double* const x,
+           double* const a, const unsigned int n,
+           const double* x_data, const unsigned int nx,
+           const double* a_data,
+           const bool eFlg=false,
+           unsigned int* const xbp=nullptr
+          );
+
+void lfi_2D_array(const double* const x, const double* const y,
+           double* const a, const unsigned int n,
+           const double* x_data, const unsigned int nx,
+           const double* y_data, const unsigned int ny,
+           const double* a_data,
+           const bool eFlg=false,
+           unsigned int* const xbp=nullptr,
+           unsigned int* const ybp=nullptr
+          );
+
+void lfi_3D_array(const double* const x, const double* const y, const double* const z,
+           double* const a, const unsigned int n,
+           const double* x_data, const unsigned int nx,
+           const double* y_data, const unsigned int ny,
+           const double* z_data, const unsigned int nz,
+           const double* a_data,
+           const bool eFlg=false,
+           unsigned int* const xbp=nullptr,
+           unsigned int* const ybp=nullptr,
+           unsigned int* const zbp=nullptr
+          );
+
+void lfi_4D_array(const double* const x, const double* const y, const double* const z, const double* const w,
+           double* const a, const unsigned int n,
+           const double* x_data, const unsigned int nx,
+           const double* y_data, const unsigned int ny,
+           const double* z_data, const unsigned int nz,
+           const double* w_data, const unsigned int nw,
+           const double* a_data,
+           const bool eFlg=false,
+           unsigned int* const xbp=nullptr,
+           unsigned int* const ybp=nullptr,
+           unsigned int* const zbp=nullptr,
+           unsigned int* const wbp=nullptr
+          );
+
+void lfi_5D_array(const double* const x, const double* const y, const double* const z, const double* const w, const double* const v,
+         double* const a, const unsigned int n,
+         const double* x_data, const unsigned int nx,
+         const double* y_data, const unsigned int ny,
+         const double* z_data, const unsigned int nz,
+         const double* w_data, const unsigned int nw,
+         const double* v_data, const unsigned int nv,
+         const double* a_data,
+         const bool eFlg=false,
+         unsigned int* const xbp=nullptr,
+         unsigned int* const ybp=nullptr,
+         unsigned int* const zbp=nullptr,
+         unsigned int* const wbp=nullptr,
+         unsigned int* const vbp=nullptr
+      );
+
 }
 }
 
 #endif
-
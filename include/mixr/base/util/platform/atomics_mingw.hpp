@@ -2,6 +2,8 @@
 #ifndef __mixr_base_util_atomics_mingw_H__
 #define __mixr_base_util_atomics_mingw_H__
 
+#include <cstdint>
+
 // ---
 // Simple semaphore spinlock and unlock functions: 
 //    lock(long int& s)      -- gets the semaphore w/spinlock wait
@@ -9,12 +11,22 @@
 //
 //    where 's' is the semaphore that must be initialized to zero.
 //
+// Double word compare-and-swap:
+//    cas2(DoubleWord* p, DoubleWord& expected, const DoubleWord desired)
+//       -- if '*p' equals 'expected' then sets '*p' to 'desired' and returns
+//          true, else sets 'expected' to '*p' and returns false (full barrier)
+//
 // MinGW version
 // ---
 
 namespace mixr {
 namespace base {
 
+struct alignas(2 * sizeof(std::uintptr_t)) DoubleWord {
+   std::uintptr_t lo;
+   std::uintptr_t hi;
+};
+
 inline void lock(long int& semaphore)
 {
 
@@ -71,6 +83,41 @@ inline void unlock(long int& semaphore)
 
 }
 
+inline bool cas2(DoubleWord* const p, DoubleWord& expected, const DoubleWord desired)
+{
+#if defined(__x86_64__)
+
+   // (cmpxchg16b directly, so we don't need -mcx16 or libatomic)
+   bool ok = false;
+   __asm__ __volatile__ (
+      "lock cmpxchg16b %1\n\t"
+      "sete %0\n\t"
+      : "=q" (ok), "+m" (*p), "+a" (expected.lo), "+d" (expected.hi)
+      : "b" (desired.lo), "c" (desired.hi)
+      : "memory", "cc"
+   );
+   return ok;
+
+#else
+
+   // 32 bit targets, or 64 bit targets with a native 16 byte __sync
+#if __SIZEOF_POINTER__ == 8
+   typedef unsigned __int128 Word;
+#else
+   typedef std::uint64_t Word;
+#endif
+   Word e = 0;
+   Word d = 0;
+   __builtin_memcpy(&e, &expected, sizeof(Word));
+   __builtin_memcpy(&d, &desired, sizeof(Word));
+   const Word v = __sync_val_compare_and_swap(reinterpret_cast<Word*>(p), e, d);
+   const bool ok = (v == e);
+   if (!ok) __builtin_memcpy(&expected, &v, sizeof(Word));
+   return ok;
+
+#endif
+}
+
 }
 }
 
@@ -14,9 +14,19 @@
 //
 #include <intrin.h>
 
+#include <cstdint>
+
 namespace mixr {
 namespace base {
 
+//
+// Double word (two pointers) for cas2()
+//
+struct alignas(2 * sizeof(std::uintptr_t)) DoubleWord {
+   std::uintptr_t lo;
+   std::uintptr_t hi;
+};
+
 //
 // lock(long int& s) -- locks the semaphore w/spinlock wait
 //
@@ -70,6 +80,29 @@ inline void unlock(long int& semaphore)
 #endif
 }
 
+//
+// cas2(DoubleWord* p, DoubleWord& expected, const DoubleWord desired) -- double
+// word compare-and-swap: if '*p' equals 'expected' then sets '*p' to 'desired'
+// and returns true, else sets 'expected' to '*p' and returns false (full barrier)
+//
+inline bool cas2(DoubleWord* const p, DoubleWord& expected, const DoubleWord desired)
+{
+#if defined(_WIN64)
+   // (sets 'expected' to '*p')
+   return _InterlockedCompareExchange128(reinterpret_cast<__int64 volatile*>(p),
+               static_cast<__int64>(desired.hi), static_cast<__int64>(desired.lo),
+               reinterpret_cast<__int64*>(&expected)) != 0;
+#else
+   const __int64 e = static_cast<__int64>((static_cast<unsigned __int64>(expected.hi) << 32) | expected.lo);
+   const __int64 d = static_cast<__int64>((static_cast<unsigned __int64>(desired.hi) << 32) | desired.lo);
+   const __int64 v = _InterlockedCompareExchange64(reinterpret_cast<__int64 volatile*>(p), d, e);
+   if (v == e) return true;
+   expected.lo = static_cast<std::uintptr_t>(static_cast<unsigned __int64>(v) & 0xffffffff);
+   expected.hi = static_cast<std::uintptr_t>(static_cast<unsigned __int64>(v) >> 32);
+   return false;
+#endif
+}
+
 }
 }
 
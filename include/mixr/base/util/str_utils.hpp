@@ -64,6 +64,10 @@ int utStrcasecmp(const char* const s1, const char* const s2);
 // (using lower case characters)
 int utStrncasecmp(const char* const s1, const char* const s2, const std::size_t n);
 
+// String hash function: Returns the 32 bit FNV-1a hash of the null terminated
+// string 's' (e.g., for hash tables of factory and slot names)
+unsigned int utStrHash(const char* const s);
+
 }
 }
 
@@ -15,6 +15,28 @@
 #define MIXR_VERSION                         1706c
 #endif
 
+// Check for invalid reference counts in base::Referenced::ref(), which throws
+// ExpInvalidRefCount (see Referenced.hpp); enabled unless NDEBUG is defined
+#ifndef MIXR_CONFIG_REF_COUNT_CHECKS
+#ifdef NDEBUG
+#define MIXR_CONFIG_REF_COUNT_CHECKS         0
+#else
+#define MIXR_CONFIG_REF_COUNT_CHECKS         1
+#endif
+#endif
+
+// Tracing profiler zones (see Tracer.hpp); when zero, the MIXR_TRACE_ZONE()
+// macros are compiled out.  Enabled by default: a zone is only a flag check
+// while the tracer is disabled (see Tracer.hpp for the costs)
+#ifndef MIXR_CONFIG_TRACING
+#define MIXR_CONFIG_TRACING                  1
+#endif
+
+// Size of each thread's trace buffer; number of zones (power of two) (see Tracer.hpp)
+#ifndef MIXR_CONFIG_TRACE_BUFFER_SIZE
+#define MIXR_CONFIG_TRACE_BUFFER_SIZE        8192
+#endif
+
 // Max number of interval timers (see Timers.hpp)
 #ifndef MIXR_CONFIG_MAX_INTERVAL_TIMERS
 #define MIXR_CONFIG_MAX_INTERVAL_TIMERS      500
@@ -40,7 +62,8 @@
 #define MIXR_CONFIG_MAX_REPORTS              200
 #endif
 
-// Max number of networked entites (see NetIO.hpp)
+// Max number of networked entites of the HLA object tables (see hla/NetIO.hpp);
+// the common NetIO input and output lists grow as needed
 #ifndef MIXR_CONFIG_MAX_NETIO_ENTITIES
 #define MIXR_CONFIG_MAX_NETIO_ENTITIES       5000
 #endif
@@ -0,0 +1,171 @@
+
+#ifndef __mixr_interop_common_DrEngine_H__
+#define __mixr_interop_common_DrEngine_H__
+
+#include "mixr/base/osg/Vec3d"
+
+namespace mixr {
+namespace interop {
+
+//------------------------------------------------------------------------------
+// Class: DrEngine
+//
+// Description: Dead reckoning (DR) state of a NetIO's NIBs, kept in structure
+//              of arrays form so the DR of all of the NIBs can be computed in
+//              one pass.
+//
+//    Each NIB is assigned a slot by allocate(), and its DR state at T0 (the
+//    algorithm, position, velocity, acceleration, Euler angles, angular
+//    rates, and the R0 matrix) is stored in the slot by reset().  The slots
+//    are kept in fixed size blocks, which are never moved, so a slot's data
+//    can be used by one thread while other slots are being allocated.
+//
+//    compute(slot, dT, pos, rpy)
+//       Computes the DR position and Euler angles of one slot at time 'dT'.
+//
+//    setErrorCheck(slot, time, dT, pos, rpy, maxPosErr, maxAngErr)
+//       Queues a check of the slot's DR position and Euler angles at time
+//       'dT' against the player's current position and Euler angles.  The
+//       'time' is the player's exec time, which identifies the results.
+//
+//    processErrorChecks()
+//       Computes the DR position and angles of all queued slots, block by
+//       block, and compares them with the max errors: the linear motion of
+//       all slots and the errors are computed in straight, branch free loops,
+//       and only the slots with rotating or body axis DR algorithms are
+//       computed one at a time.
+//
+//    getErrorCheck(slot, time, posErr, angErr)
+//       Returns true, and sets the position and angle error flags, if the
+//       slot was checked by the last processErrorChecks() with player exec
+//       time 'time' and has not been reset since.
+//
+//    deadReckon(dr, p0, v0, a0, rpy0, av0, dT, pos, rpy)
+//       Computes the DR position and Euler angles without a slot, using the
+//       same math (for NIBs that aren't attached to a NetIO).
+//
+//    Rotations use the 3x3 DR, R1 and R2 matrices of IEEE 1278.1, Annex E,
+//    and the body axis algorithms use R0 (the orientation at T0) to rotate
+//    the body axis displacement into the world frame.
+//
+// Notes:
+//    1) allocate() and release() can be called from any thread.
+//
+//    2) A slot's data is only used by its NIB's threads; the error checks
+//       are queued and processed by the NetIO's output thread.
+//------------------------------------------------------------------------------
+class DrEngine
+{
+public:
+   DrEngine() = default;
+   DrEngine(const DrEngine&) = delete;
+   DrEngine& operator=(const DrEngine&) = delete;
+   ~DrEngine();
+
+   static const unsigned int BLOCK_SIZE = 128;    // Slots per block
+   static const unsigned int MAX_BLOCKS = 2048;   // Max number of blocks
+
+   // Slots
+   int allocate();                        // Returns a new slot, or -1 if there are no more slots
+   void release(const int slot);
+   unsigned int getNumSlots() const       { return numSlots; }
+
+   // Sets the slot's DR algorithm and T0 values
+   void reset(
+      const int slot,
+      const unsigned char dr,       // Dead-Reckoning algorithm number (see Nib::DeadReckoning)
+      const base::Vec3d& p,         // Position vector @ T0 (meters) (ECEF)
+      const base::Vec3d& v,         // Velocity vector @ T0 (m/sec)  (ECEF or Body based on 'dr')
+      const base::Vec3d& a,         // Acceleration vector @ T0 ((m/sec)/sec) (ECEF or Body based on 'dr')
+      const base::Vec3d& rpy,       // Euler angles @ T0 (rad) [ phi theta psi ] (Body/ECEF)
+      const base::Vec3d& av         // Angular rates @ T0 (rad/sec)  [ phi theta psi ] (Body/ECEF)
+   );
+
+   // Sets the slot's DR algorithm
+   void setAlgorithm(const int slot, const unsigned char dr);
+
+   // Computes the slot's DR position and Euler angles at time 'dT'
+   void compute(const int slot, const double dT, base::Vec3d* const pNewP0, base::Vec3d* const pNewRPY) const;
+
+   // DR error checks
+   void setErrorCheck(
+      const int slot,
+      const double time,            // Player's exec time (seconds)
+      const double dT,              // DR time (seconds)
+      const base::Vec3d& pos,       // Player's position (meters) (ECEF)
+      const base::Vec3d& rpy,       // Player's Euler angles (rad) (Body/ECEF)
+      const double maxPosErr,       // Max position error (meters)
+      const double maxAngErr        // Max orientation error (radians)
+   );
+   void processErrorChecks();
+   bool getErrorCheck(const int slot, const double time, bool* const posErr, bool* const angErr) const;
+
+   // Computes the DR position and Euler angles without a slot
+   static void deadReckon(
+      const unsigned char dr,       // Dead-Reckoning algorithm number (see Nib::DeadReckoning)
+      const base::Vec3d& p0,        // Position vector @ T0 (meters) (ECEF)
+      const base::Vec3d& v0,        // Velocity vector @ T0 (m/sec)  (ECEF or Body based on 'dr')
+      const base::Vec3d& a0,        // Acceleration vector @ T0 ((m/sec)/sec) (ECEF or Body based on 'dr')
+      const base::Vec3d& rpy0,      // Euler angles @ T0 (rad) [ phi theta psi ] (Body/ECEF)
+      const base::Vec3d& av0,       // Angular rates @ T0 (rad/sec)  [ phi theta psi ] (Body/ECEF)
+      const double dT,              // DR time (seconds)
+      base::Vec3d* const pNewP0,    // DR Position vector @ time = 'dT' (meters) (ECEF)
+      base::Vec3d* const pNewRPY    // DR Euler angles @ time = 'dT' (rad) [ phi theta psi ] (Body/ECEF)
+   );
+
+   // Position and angle error flags of a DR position and Euler angles
+   static void computeErrors(
+      const base::Vec3d& drPos,     // DR position (meters) (ECEF)
+      const base::Vec3d& drRPY,     // DR Euler angles (rad) (Body/ECEF)
+      const base::Vec3d& pos,       // Player's position (meters) (ECEF)
+      const base::Vec3d& rpy,       // Player's Euler angles (rad) (Body/ECEF)
+      const double maxPosErr,       // Max position error (meters)
+      const double maxAngErr,       // Max orientation error (radians)
+      bool* const posErr,
+      bool* const angErr
+   );
+
+private:
+   // Error check states
+   enum { CHK_NONE, CHK_PENDING, CHK_DONE };
+
+   struct Block {
+      // T0 state
+      double p0[3][BLOCK_SIZE];     // Position vector (ECEF)
+      double v0[3][BLOCK_SIZE];     // Velocity vector
+      double a0[3][BLOCK_SIZE];     // Acceleration vector
+      double rpy0[3][BLOCK_SIZE];   // Euler angles
+      double av0[3][BLOCK_SIZE];    // Angular rates
+      double r0[9][BLOCK_SIZE];     // R0 matrix (row major)
+      double kv[BLOCK_SIZE];        // World velocity coefficient (0 or 1)
+      double ka[BLOCK_SIZE];        // Acceleration coefficient (0 or 1)
+      unsigned char drm[BLOCK_SIZE];     // DR algorithm
+      unsigned char flags[BLOCK_SIZE];   // Algorithm flags (rotation, body axis)
+
+      // Error checks
+      double ctime[BLOCK_SIZE];     // Player's exec time
+      double cdt[BLOCK_SIZE];       // DR time
+      double cpos[3][BLOCK_SIZE];   // Player's position
+      double crpy[3][BLOCK_SIZE];   // Player's Euler angles
+      double cmaxPos2[BLOCK_SIZE];  // Max position error squared
+      double cmaxAng[BLOCK_SIZE];   // Max orientation error
+      unsigned char cstate[BLOCK_SIZE];  // Check state
+      unsigned char cerr[BLOCK_SIZE];    // Check results: position (0x01) and angle (0x02) errors
+      unsigned int numPending;           // Number of pending checks
+
+      int next[BLOCK_SIZE];         // Free list
+   };
+
+   static void setCoefficients(const unsigned char dr, double* const kv, double* const ka, unsigned char* const flags);
+
+   Block* blocks[MAX_BLOCKS] {};          // Slot blocks
+   unsigned int numBlocks {};             // Number of allocated blocks
+   unsigned int numSlots {};              // Number of slots used (high water mark)
+   int freeList {-1};                     // First released slot, or -1
+   mutable long semaphore {};
+};
+
+}
+}
+
+#endif
@@ -3,9 +3,12 @@
 #define __mixr_interop_common_NetIO_H__
 
 #include "mixr/simulation/AbstractNetIO.hpp"
+#include "mixr/interop/common/DrEngine.hpp"
+#include "mixr/interop/common/NibIndex.hpp"
 
 #include "mixr/base/String.hpp"
 #include <array>
+#include <cstdint>
 
 namespace mixr {
 namespace base { class Angle; class Distance; class Identifier; class String; class Time; }
@@ -123,6 +126,13 @@ class Ntm;
 //    threads, and for HLA they need to be called from the same thread.
 //
 //
+// Dead reckoning:
+//
+//    The dead reckoning (DR) state of the input and output NIBs is kept by
+//    two DrEngine objects (see DrEngine.hpp).  Before the output NIBs are
+//    processed, the DR errors of all local players are checked in one batch.
+//
+//
 // Time line:
 //
 //    Data sent to the network can be marked with universal UTC time, or
@@ -277,10 +287,28 @@ public:
    virtual void destroyOutputNib(Nib* const nib);
    virtual bool addNib2InputList(Nib* const nib);
 
+   // Dead reckoning engine of the input or output NIBs
+   DrEngine* getDrEngine(const IoType ioType)   { return (ioType == INPUT_NIB ? &inputDr : &outputDr); }
+
 protected:
-   // Maximum number of active objects
+   // Maximum number of active objects (the input and output lists grow as
+   // needed; used by derived classes with their own object tables)
    static const int MAX_OBJECTS = MIXR_CONFIG_MAX_NETIO_ENTITIES;
 
+   // NIB index keys: the key of a NIB and the key of a player ID and
+   // federate name; the same IDs must give the same key.  By default, the
+   // player ID is combined with a hash of the federate name, and findNib()
+   // checks the federate name of the NIB that it finds.  Derived classes
+   // with integer federate IDs (e.g., DIS site and application IDs) can
+   // override these to give each NIB an unique key.
+   virtual std::uint64_t getNibKey(const Nib* const nib) const;
+   virtual std::uint64_t makeNibKey(const unsigned short playerID, const base::String* const federateName) const;
+
+   // Finds the NIB with 'key' using the input or output NIB index
+   Nib* findNibByKey(const std::uint64_t key, const IoType ioType) const {
+      return (ioType == INPUT_NIB ? inputIndex.find(key) : outputIndex.find(key));
+   }
+
    // Create NIB unique to protocol (pure functions!)
    virtual Nib* nibFactory(const NetIO::IoType ioType)=0;
 
@@ -305,7 +333,7 @@ protected:
 
    // Returns the input list
    Nib** getInputList() {
-      return inputList.data();
+      return inputList;
    }
 
    // Number of NIBs on the output list
@@ -315,7 +343,7 @@ protected:
 
    // Returns the input list
    Nib** getOutputList() {
-      return outputList.data();
+      return outputList;
    }
 
    // Returns the idx'th NIB from the output list
@@ -424,24 +452,23 @@ private:
 
 private: // Nib related private
    // input tables
-   std::array<Nib*, MAX_OBJECTS> inputList {};  // Table of input objects in name order
-   unsigned int nInNibs {};                    // Number of input objects in both tables
+   Nib** inputList {};                // Table of input objects (in the order they were added)
+   unsigned int inputListSize {};     // Size of the input table
+   unsigned int nInNibs {};           // Number of input objects
+   NibIndex inputIndex;               // Input objects by NIB key
 
    // output tables
-   std::array<Nib*, MAX_OBJECTS> outputList {}; // Table of output objects in name order
-   unsigned int nOutNibs {};                   // Number of output objects in both tables
-
-   // NIB quick lookup key
-   struct NibKey {
-      NibKey(const unsigned short playerId, const base::String* const federateName): id(playerId), fName(federateName) {}
-      // NIB IDs  -- Comparisons in this order --
-      unsigned short id {};                        // Player id
-      base::safe_ptr<const base::String> fName;    // Federate name
-   };
+   Nib** outputList {};               // Table of output objects (in the order they were added)
+   unsigned int outputListSize {};    // Size of the output table
+   unsigned int nOutNibs {};          // Number of output objects
+   NibIndex outputIndex;              // Output objects by NIB key
+
+   // Dead reckoning state of the input and output NIBs
+   DrEngine inputDr;
+   DrEngine outputDr;
 
-   // Search callbacks: object name compare function --
-   //   True types are (const NibKey* key, const Nib** nib)
-   static int compareKey2Nib(const void* key, const void* nib);
+   // True if the NIB's player ID and federate name match
+   static bool isNibMatch(const Nib* const nib, const unsigned short playerID, const base::String* const federateName);
 
 private:  // Ntm related private
    static const unsigned int MAX_ENTITY_TYPES = MIXR_CONFIG_MAX_NETIO_ENTITY_TYPES;
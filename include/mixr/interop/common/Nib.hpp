@@ -93,7 +93,7 @@ public:
    // Dead Reckoning (DR) algorithm (see enum DeadReckoning)
    bool isDeadReckoning(const unsigned char dr) const         { return (drNum == dr); }
    unsigned char getDeadReckoning() const                     { return drNum; }
-   bool setDeadReckoning(const unsigned char dr)              { drNum = dr; return true; }
+   bool setDeadReckoning(const unsigned char dr);
 
    // DR's position vector @ T0 (meters) (ECEF)
    const base::Vec3d& getDrPosition() const                   { return drP0; }
@@ -128,6 +128,10 @@ public:
          const double time = 0         // Initial time (seconds) (default: zero)
       );
 
+   // Queues this (output) NIB's DR error check with our NetIO's batch of
+   // checks; see NetIO::processOutputList() and DrEngine
+   void queueDrErrorCheck();
+
    // Checked flags
    bool isChecked() const                             { return checked; }
    void setCheckedFlag(const bool flg)                { checked = flg; }
@@ -229,49 +233,6 @@ protected:
 
    virtual bool shutdownNotification() override;
 
-private:
-   // compute the rotational matrix R0
-   static bool drComputeMatrixR0(
-         const base::Vec3d& RPY,      // [radians]
-         base::Matrixd* const pR0     // Rotational matrix R0
-      );
-
-   // compute the wwT matrix
-   static bool drComputeMatrixWwT(
-         const base::Vec3d& av,       // angular velocities [rps]
-         base::Matrixd* const pwwT    // matrix
-      );
-
-   // compute the omega matrix
-   static bool drComputeMatrixOmega(
-         const base::Vec3d& av,       // [rps]
-         base::Matrixd* const pOmega
-      );
-
-   static bool drComputeMatrixDR(
-         const double dT,             // DR time [sec]
-         const base::Vec3d& av,       // angular velocities [rps]
-         const base::Matrixd& wwT,    // wwT matrix
-         const base::Matrixd& omega,  // omega matrix
-         base::Matrixd* const pDR     // DR matrix
-      );
-
-   static bool drComputeMatrixR1(
-         const double dT,             // DR time [sec]
-         const base::Vec3d& av,       // angular velocities [rps]
-         const base::Matrixd& wwT,    // wwT matrix
-         const base::Matrixd& omega,  // omega matrix
-         base::Matrixd* const pR1     // Matrix R1
-      );
-
-   static bool drComputeMatrixR2(
-         const double dT,             // DR time [sec]
-         const base::Vec3d& av,       // angular velocities [rps]
-         const base::Matrixd& wwT,    // wwT matrix
-         const base::Matrixd& omega,  // omega matrix
-         base::Matrixd* const pR2     // Matrix R2
-      );
-
 private:
    void initData();
 
@@ -310,9 +271,8 @@ private:
    base::Vec3d  drA0;                  // Acceleration vector @ t0 ((m/sec)/sec) (ECEF or Body based on the DR algorithm)
    base::Vec3d  drRPY0;                // Euler angles @ t0 (rad) (Body/ECEF)
    base::Vec3d  drAV0;                 // Angular rates @ t0 (rad/sec) (Body/ECEF)
-   base::Matrixd drR0;                 // R0 matrix
-   base::Matrixd drWwT;                // wwT matrix
-   base::Matrixd drOmega;              // omega matrix
+   DrEngine* drEngine {};              // Our NetIO's DR engine, which has our DR state in slot 'drSlot'
+   int drSlot {-1};                    // Our DR engine slot
 
    // Current DR values (incoming only)
    double drTime {};                   // DR time (sec)
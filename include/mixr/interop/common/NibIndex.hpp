@@ -0,0 +1,74 @@
+
+#ifndef __mixr_interop_common_NibIndex_H__
+#define __mixr_interop_common_NibIndex_H__
+
+#include <cstdint>
+
+namespace mixr {
+namespace interop {
+class Nib;
+
+//------------------------------------------------------------------------------
+// Class: NibIndex
+//
+// Description: Quick lookup index of a NetIO's input or output NIBs, keyed
+//              on a 64 bit integer that's made from the NIB's IDs (see
+//              NetIO::getNibKey()).
+//
+//    find(key)
+//       Returns the NIB with 'key', or zero if not found.  If more than one
+//       NIB has the same key, the first one found is returned.
+//
+//    insert(key, nib)
+//       Adds 'nib' to the index with 'key'.
+//
+//    remove(key, nib)
+//       Removes 'nib', which was added with 'key', from the index.
+//
+//    Open addressing hash table (linear probing), which is kept at most
+//    half full and grows as needed, so there's no max number of NIBs.
+//
+// Notes:
+//    1) The NIBs are not ref()'d; they're owned by the NetIO's lists.
+//
+//    2) Each index is updated by its own list's thread, but it can be
+//       searched by any thread (e.g., the DIS input thread checks the
+//       output NIBs), so the table is protected by a spinlock.
+//------------------------------------------------------------------------------
+class NibIndex
+{
+public:
+   NibIndex() = default;
+   NibIndex(const NibIndex&) = delete;
+   NibIndex& operator=(const NibIndex&) = delete;
+   ~NibIndex();
+
+   unsigned int getNumEntries() const   { return numEntries; }
+
+   Nib* find(const std::uint64_t key) const;
+   void insert(const std::uint64_t key, Nib* const nib);
+   void remove(const std::uint64_t key, const Nib* const nib);
+   void clear();
+
+private:
+   static const unsigned int MIN_SIZE = 256;   // Initial table size
+
+   struct Entry {
+      std::uint64_t key;      // NIB key
+      Nib* nib;               // NIB (not ref()'d), or zero for an empty slot
+   };
+
+   static unsigned int hashKey(const std::uint64_t key);
+   void resize(const unsigned int size);
+
+   // Open addressing hash table (linear probing)
+   Entry* table {};
+   unsigned int size {};                 // Table size (power of two)
+   unsigned int numEntries {};           // Number of entries
+   mutable long semaphore {};
+};
+
+}
+}
+
+#endif
@@ -85,10 +85,9 @@ struct ActionResponsePDU_R;
 //    2) NetIO creates its own federation name based on the exercise number
 //       using makeFederationName().  (e.g., exercise = 13 gives the federation name "E13")
 //
-//    3) findDisNib() searches the same input and output lists that are maintained by
-//       NetIO, which are in order of player ID and the federate name.  Since our DIS
-//       federate names are generated by site and app IDs, the lists are seen by DIS as
-//       being order by player ID, site ID and app ID.
+//    3) findDisNib() searches the same input and output NIB indexes that are maintained
+//       by NetIO.  Our NIB keys are made from the player, site and app IDs (see
+//       makeDisNibKey()), so findDisNib() doesn't need to make a federate name.
 //
 //    4) For the slots maxTimeDR, maxPositionError, maxOrientationError, maxAge and
 //       maxEntityRange, if the slot type is base::Time, base::Angle or base::Distance then that
@@ -110,6 +109,11 @@ struct ActionResponsePDU_R;
 //       type id.  For incoming emission PDUs, the "emitter name" from the PDU
 //       is matched with the EmissionPduHandler's "emitterName" value.
 //
+//    7) The output network handler may buffer the outgoing PDUs (e.g., the
+//       PosixHandler's 'batchSize' slot); they're sent by flushData(), which
+//       is called at the end of each outputFrame().  The input and output
+//       network handlers are passed our shutdown event.
+//
 //------------------------------------------------------------------------------
 class NetIO : public interop::NetIO
 {
@@ -230,6 +234,11 @@ public:
    // Receives a packet (PDU) from the network
    int recvData(char* const packet, const int maxSize);
 
+   // Sends any packets (PDUs) that are buffered by the output network handler
+   bool flushData();
+
+   virtual void outputFrame(const double dt) override;
+
    unsigned int timeStamp();                                                  // Gets the current timestamp
    unsigned int makeTimeStamp(const double ctime, const bool absolute);       // Make a PDU time stamp
 
@@ -355,11 +364,15 @@ protected:
    virtual bool setSlotFederateName(const base::String* const msg) override;         // Sets our federate name
    virtual bool setSlotFederationName(const base::String* const msg) override;       // Sets our federation name
 
+   virtual bool shutdownNotification() override;
+
    // NetIO Interface
    virtual bool initNetwork() override;                                                   // Initialize the network
    virtual void netInputHander() override;                                                // Network input handler
    virtual void processInputList() override;                                              // Update players/systems from the Input-list
    virtual interop::Nib* nibFactory(const interop::NetIO::IoType ioType) override;        // Create a new Nib
+   virtual std::uint64_t getNibKey(const interop::Nib* const nib) const override;         // NIB key by player, site and app IDs
+   virtual std::uint64_t makeNibKey(const unsigned short playerID, const base::String* const federateName) const override;
    virtual interop::NetIO::NtmInputNode* rootNtmInputNodeFactory() const override;
    virtual void testOutputEntityTypes(const unsigned int) override;                       // Test quick lookup of outgoing entity types
    virtual void testInputEntityTypes(const unsigned int) override;                        // Test quick lookup of incoming entity types
@@ -367,6 +380,11 @@ protected:
 private:
     void initData();
 
+    // NIB key: site ID (bits 32-47), app ID (bits 16-31) and player ID (bits 0-15)
+    static std::uint64_t makeDisNibKey(const unsigned short playerID, const unsigned short site, const unsigned short app) {
+       return ( (static_cast<std::uint64_t>(site) << 32) | (static_cast<std::uint64_t>(app) << 16) | playerID );
+    }
+
     base::safe_ptr<base::NetHandler> netInput;    // Input network handler
     base::safe_ptr<base::NetHandler> netOutput;   // Output network handler
     unsigned char version {VERSION_1278_1A};      // Version number [ 0 .. 6 ]
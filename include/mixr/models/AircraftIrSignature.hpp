@@ -3,9 +3,10 @@
 #define __mixr_models_AircraftIrSignature_H__
 
 #include "mixr/models/IrSignature.hpp"
+#include "mixr/models/IrCache.hpp"
 
 namespace mixr {
-namespace base { class Number; class List; class Table1; class Table2;
+namespace base { class Angle; class Distance; class Number; class List; class Table1; class Table2;
                  class Table3; class Table4; class Table5; }
 namespace models {
 class AirVehicle;
@@ -27,9 +28,30 @@ class IrShape;
 //    hotPartsSignatureTable          <Table5>      !
 //    hotPartsWavebandFactorTable     <Table2>      !
 //
+//    signatureCache                  <Number>      ! Enable the signature cache (default: false)
+//    machTolerance                   <Number>      ! Signature cache bin size of the target's mach number (default: 0)
+//    altitudeTolerance               <Distance>    ! Signature cache bin size of the target's altitude (default: 0)
+//    azimuthTolerance                <Angle>       ! Signature cache bin size of the azimuth angle of incidence (default: 0)
+//    elevationTolerance              <Angle>       ! Signature cache bin size of the elevation angle of incidence (default: 0)
+//    plaTolerance                    <Number>      ! Signature cache bin size of the target's PLA (default: 0)
+//
 // Public member functions:
 //      double getIrSignature(IrQueryMsg* msg)
 //          Computes the IR signature for the emission.
+//
+//      IrCache* getSignatureCache()
+//          The signature cache, and its hit and miss statistics.  The cache
+//          is only used if the target is in a world model (see IrCache::frameOf()).
+//
+// Signature cache:
+//    The airframe, plume and hot parts signatures of all wavebands are
+//    computed in one pass over the wavebands (see computeHeatSignature()), and,
+//    if the signature cache is enabled, they're saved for the rest of the
+//    frame, keyed on the target's mach number, altitude and PLA, the angles
+//    of incidence and the sensor's waveband.  The queries of other seekers
+//    whose inputs fall in the same bins (see the tolerance slots) reuse the
+//    saved signatures; with tolerances of zero, only queries with the exact
+//    same inputs reuse them.
 //------------------------------------------------------------------------------
 class AircraftIrSignature : public IrSignature
 {
@@ -48,6 +70,11 @@ public:
    virtual bool setSlotHotPartsSignatureTable(const base::Table5* const tbl);
    virtual bool setSlotHotPartsWavebandFactorTable(const base::Table2* const tbl);
 
+   bool isSignatureCacheEnabled() const          { return signatureCache; }
+   virtual bool setSignatureCacheEnabled(const bool flg);
+   IrCache* getSignatureCache()                  { return &cache; }
+   const IrCache* getSignatureCache() const      { return &cache; }
+
 protected:
    virtual double* getHeatSignature(IrQueryMsg* msg);
 
@@ -79,7 +106,25 @@ protected:
 
    virtual double getPLA(const AirVehicle* const airModel);
 
+   // Signature inputs: mach number, altitude (meters), azimuth and elevation
+   // angles of incidence (radians), PLA and the sensor's waveband (microns)
+   enum { IN_MACH, IN_ALT, IN_AZ, IN_EL, IN_PLA, IN_LOWER, IN_UPPER, NUM_INPUTS };
+
+   // Computes the signatures of all wavebands in one pass
+   virtual void computeHeatSignature(const double* const inputs, const bool airVehicle, double* const sig);
+
+   // Slot functions
+   bool setSlotSignatureCache(const base::Number* const msg);
+   bool setSlotMachTolerance(const base::Number* const msg);
+   bool setSlotAltitudeTolerance(const base::Distance* const msg);
+   bool setSlotAzimuthTolerance(const base::Angle* const msg);
+   bool setSlotElevationTolerance(const base::Angle* const msg);
+   bool setSlotPlaTolerance(const base::Number* const msg);
+
 private:
+   static double getBandFactor(const base::Table2* const tbl, const unsigned int i,
+                               const double lowerBound, const double upperBound);
+
    const base::Table4* airframeSignatureTable {};
             // mapping of
             // signature  x is the velocity (in mach #) and y is altitude (in sim prevailing units --
@@ -129,6 +174,9 @@ private:
    double* airframeSig {};       // 2 dimensions i = bin, j = lower wavelength, upper wavelength, signature
    double* plumeSigs {};         // 2 dimensions i = bin, j = lower wavelength, upper wavelength, signature
    double* hotPartsSigs {};      // 2 dimensions i = bin, j = lower wavelength, upper wavelength, signature
+
+   bool signatureCache {};       // Signature cache enabled
+   mutable IrCache cache;        // Signature cache
 };
 
 }
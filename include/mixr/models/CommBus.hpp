@@ -0,0 +1,192 @@
+
+#ifndef __mixr_models_CommBus_H__
+#define __mixr_models_CommBus_H__
+
+#include "mixr/base/Object.hpp"
+#include "mixr/base/safe_ptr.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+
+namespace mixr {
+namespace base { class Number; }
+namespace terrain { class Terrain; }
+namespace models {
+class Datalink;
+class Player;
+
+//------------------------------------------------------------------------------
+// Class: CommBus
+// Description: Subscription based delivery of datalink messages between the
+//              local players of a world model (see WorldModel's 'commBus' slot).
+//
+//    Without a comm bus, a datalink without a radio sends each message to all
+//    of the active local players, and a datalink with a radio sends each message
+//    as an R/F emission.  With a comm bus, the datalinks subscribe to the bus by
+//    their network number and, if they have a radio, by the radio's frequency
+//    (i.e., its tuned channel), and a message is only delivered to the other
+//    datalinks on the same network and frequency.  Datalinks without a radio
+//    use a frequency of zero.
+//
+//    Messages are posted to the subscribers' lock-free inboxes, and each
+//    datalink handles its messages in its own dynamics() (see Datalink), so a
+//    message is never handled on the sending player's thread.  A message is
+//    handled by the receiver's next dynamics(), which can be the next frame,
+//    while the broadcast without a bus handles it right away.
+//
+//    The deliveries of a datalink with a radio are always limited to the
+//    radio's 'maxDetectRange', same as its R/F emissions without a bus.
+//
+//    Optional culling of the deliveries:
+//
+//       rangeCulling -- only to the players within the sender's max range,
+//                       for the datalinks without a radio (the datalink's
+//                       'maxRange')
+//
+//       losCulling   -- only to the players that are not occulted by the
+//                       terrain, if the world model has a terrain database
+//
+//    The subscriptions are grouped by network and frequency in a sorted table,
+//    which is rebuilt (copy-on-write) by the first publish() after any change,
+//    so publish() doesn't take any locks and it only visits the subscribers of
+//    its own network and frequency.
+//
+//    Each subscription holds a reference to its datalink and player; the
+//    subscriptions of deleted players are removed by removeDeletedPlayers(),
+//    which is called by WorldModel after each update of its player list.
+//
+// Statistics:
+//
+//    The number of messages published, the number of messages delivered, the
+//    number of deliveries culled by range or by line-of-sight, and the number
+//    of deliveries dropped because a subscriber's inbox was full are counted
+//    for each network (up to MAX_NETWORKS networks); see getNetworkStats()
+//    and printStats().
+//
+// Factory name: CommBus
+// Slots:
+//    rangeCulling   <base::Number>   ! Cull deliveries of datalinks without a radio by their max range (default: false)
+//    losCulling     <base::Number>   ! Cull deliveries by terrain line-of-sight (default: false)
+//
+// Example EDL:
+//
+//    ( WorldModel
+//       ...
+//       commBus: ( CommBus rangeCulling: true )
+//    )
+//------------------------------------------------------------------------------
+class CommBus : public base::Object
+{
+   DECLARE_SUBCLASS(CommBus, base::Object)
+
+public:
+   static const unsigned int MAX_NETWORKS = 32;    // Max number of networks with statistics
+
+   // Network statistics
+   struct NetworkStats {
+      int network;                  // Network number
+      unsigned long messages;       // Messages published
+      unsigned long deliveries;     // Messages delivered to subscribers
+      unsigned long rangeCulled;    // Deliveries culled by range
+      unsigned long losCulled;      // Deliveries culled by line-of-sight
+      unsigned long dropped;        // Deliveries dropped (subscriber's inbox was full)
+   };
+
+public:
+   CommBus();
+
+   bool isRangeCullingEnabled() const            { return rangeCulling; }
+   virtual bool setRangeCullingEnabled(const bool flg);
+
+   bool isLosCullingEnabled() const              { return losCulling; }
+   virtual bool setLosCullingEnabled(const bool flg);
+
+   // Subscribes datalink 'dl', of player 'own', to 'network' and frequency 'freq'
+   // (hertz; zero for no radio); replaces the datalink's previous subscription.
+   bool subscribe(Datalink* const dl, Player* const own, const int network, const double freq);
+
+   // Removes datalink 'dl's subscription
+   bool unsubscribe(const Datalink* const dl);
+
+   // Removes the subscriptions of the players that have been deleted
+   void removeDeletedPlayers();
+
+   // Removes all subscriptions
+   void unsubscribeAll();
+
+   unsigned int getNumSubscribers() const;
+
+   // Delivers message 'msg' from datalink 'sender', of player 'own', to the other
+   // subscribers of 'network' and frequency 'freq' (hertz); 'maxRange' (meters)
+   // is used for range culling (always, if the sender has a radio) and 'terrain'
+   // (optional) for line-of-sight culling.  Returns the number of subscribers that
+   // the message was delivered to.
+   unsigned int publish(
+      const Datalink* const sender,
+      const Player* const own,
+      base::Object* const msg,
+      const int network,
+      const double freq,
+      const double maxRange,
+      const terrain::Terrain* const terrain
+   );
+
+   // Statistics of the networks [ 0 .. getNumNetworks()-1 ]
+   unsigned int getNumNetworks() const;
+   bool getNetworkStats(const unsigned int idx, NetworkStats* const stats) const;
+   void clearStats();
+   void printStats(std::ostream& sout) const;
+
+protected:
+   // Slot functions
+   bool setSlotRangeCulling(const base::Number* const msg);
+   bool setSlotLosCulling(const base::Number* const msg);
+
+private:
+   // Subscription
+   struct Sub {
+      Datalink* dl;                 // Subscriber's datalink (ref()'d)
+      Player* own;                  // Subscriber's player (ref()'d)
+      int network;                  // Network number
+      std::int64_t freq;            // Frequency (hertz, rounded)
+
+      bool operator<(const Sub& s) const {
+         return (network < s.network || (network == s.network && freq < s.freq));
+      }
+   };
+
+   // Network statistics counters
+   struct Counters {
+      std::atomic<int> network;
+      std::atomic<unsigned long> messages;
+      std::atomic<unsigned long> deliveries;
+      std::atomic<unsigned long> rangeCulled;
+      std::atomic<unsigned long> losCulled;
+      std::atomic<unsigned long> dropped;
+   };
+
+   class Table;                     // Sorted table of subscriptions (see publish())
+
+   Table* getTable();               // Returns the current table (pre-ref()'d)
+   Counters* getCounters(const int network);
+   static std::int64_t freqKey(const double freq);
+
+   Sub* subs {};                    // Subscriptions (unsorted)
+   unsigned int numSubs {};
+   unsigned int maxSubs {};
+   mutable long semaphore {};       // Subscriptions lock
+   std::atomic<bool> changed {};    // Subscriptions have changed since the table was built
+   base::safe_ptr<Table> table;     // Sorted table of the subscriptions
+
+   Counters nets[MAX_NETWORKS] {};  // Network statistics
+   std::atomic<unsigned int> numNets {};
+
+   bool rangeCulling {};            // Cull deliveries by range
+   bool losCulling {};              // Cull deliveries by line-of-sight
+};
+
+}
+}
+
+#endif
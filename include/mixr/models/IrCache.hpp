@@ -0,0 +1,111 @@
+
+#ifndef __mixr_models_IrCache_H__
+#define __mixr_models_IrCache_H__
+
+#include <atomic>
+#include <cstdint>
+
+namespace mixr {
+namespace models {
+class WorldModel;
+
+//------------------------------------------------------------------------------
+// Class: IrCache
+//
+// Description: Memoized IR values (e.g., the signature or the atmosphere's
+//              contributions in each waveband), keyed on their quantized
+//              inputs; used by AircraftIrSignature and IrAtmosphere1 so the
+//              table lookups are only done once for the IR queries of several
+//              seekers that see the target from (nearly) the same aspect.
+//
+//    setup(numInputs, numValues)
+//       Sets the number of inputs (key) and values of each entry, and
+//       discards all entries.
+//
+//    setTolerance(idx, tol)
+//       Sets the bin size of input 'idx'; inputs within the same bin share
+//       the same entry, and its values are the ones computed for the first
+//       input of the bin.  With a tolerance of zero (default), an entry is
+//       only reused for the exact same input.
+//
+//    find(frame, inputs, values)
+//       Returns true, and copies the entry's values to 'values', if there's
+//       an entry for the quantized 'inputs' that was inserted this frame.
+//
+//    insert(frame, inputs, values)
+//       Saves the values computed for 'inputs'.
+//
+//    The entries are only valid for the frame (see frameOf()) that they were
+//    inserted in; the first find() or insert() of a new frame discards all
+//    of the entries, without touching the table.
+//
+//    Thread-safe; the table is locked by find() and insert(), and the hit
+//    and miss counters can be read by any thread.
+//------------------------------------------------------------------------------
+class IrCache
+{
+public:
+   static const unsigned int MAX_INPUTS = 8;       // Max number of inputs (key)
+
+public:
+   IrCache() = default;
+   IrCache(const IrCache&) = delete;
+   IrCache& operator=(const IrCache&) = delete;
+   ~IrCache();
+
+   unsigned int getNumInputs() const    { return numInputs; }
+   unsigned int getNumValues() const    { return numValues; }
+   bool setup(const unsigned int numInputs, const unsigned int numValues);
+
+   double getTolerance(const unsigned int idx) const;
+   bool setTolerance(const unsigned int idx, const double tol);
+
+   bool find(const unsigned int frame, const double* const inputs, double* const values);
+   void insert(const unsigned int frame, const double* const inputs, const double* const values);
+   void clear();
+
+   // Statistics
+   unsigned long getHits() const        { return hits.load(std::memory_order_relaxed); }
+   unsigned long getMisses() const      { return misses.load(std::memory_order_relaxed); }
+   double getHitRate() const;           // Hits / (hits + misses); zero if no queries
+   void clearStats();
+
+   // Frame number of the world model (zero if none)
+   static unsigned int frameOf(const WorldModel* const wm);
+
+private:
+   static const unsigned int MIN_SIZE = 64;        // Initial table size
+   static const unsigned int MAX_ENTRIES = 4096;   // Max entries per frame
+
+   void quantize(const double* const inputs, std::int64_t* const key) const;
+   unsigned int hashKey(const std::int64_t* const key) const;
+   bool sameKey(const unsigned int slot, const std::int64_t* const key) const;
+   void setFrame(const unsigned int frame);
+   void resize(const unsigned int size);
+   void deleteTable();
+
+   unsigned int numInputs {};            // Number of inputs
+   unsigned int numValues {};            // Number of values
+   double tolerances[MAX_INPUTS] {};     // Input bin sizes (zero for exact inputs)
+
+   // Open addressing hash table (linear probing); a slot is in use if its
+   // epoch is the current epoch
+   std::int64_t* keys {};                // Quantized inputs [ size * numInputs ]
+   double* values {};                    // Values [ size * numValues ]
+   unsigned int* epochs {};              // Epoch that each slot was inserted in [ size ]
+   unsigned int size {};                 // Table size (power of two)
+   unsigned int numEntries {};           // Number of entries this epoch
+   unsigned int epoch {1};               // Current epoch (incremented each frame)
+   unsigned int frame {};                // Current frame
+   bool haveFrame {};                    // Current frame is valid
+
+   mutable long semaphore {};            // Table lock
+
+   std::atomic<unsigned long> hits {};   // Number of finds that hit
+   std::atomic<unsigned long> misses {}; // Number of finds that missed
+};
+
+}
+}
+
+#endif
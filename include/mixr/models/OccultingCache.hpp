@@ -0,0 +1,89 @@
+
+#ifndef __mixr_models_OccultingCache_H__
+#define __mixr_models_OccultingCache_H__
+
+#include "mixr/base/osg/Vec3d"
+
+#include <cstdint>
+
+namespace mixr {
+namespace terrain { class Terrain; }
+namespace models {
+
+//------------------------------------------------------------------------------
+// Class: OccultingCache
+//
+// Description: Terrain occulting results of a gimbal's players of interest;
+//              used by Tdb::processPlayers() to skip the terrain occulting
+//              checks of targets that haven't moved.
+//
+//    setObserver(terrain, pos, tol)
+//       Sets the observer's geocentric position (ECEF) and the movement
+//       tolerance (meters); all results are discarded if the observer has
+//       moved more than 'tol' since the results were computed, or if the
+//       terrain database has changed.
+//
+//    find(key, pos, space, occulted)
+//       Returns true, and sets 'occulted', if there's a result for target
+//       'key' and the target hasn't moved more than the tolerance.
+//
+//    insert(key, pos, space, occulted)
+//       Saves the result for target 'key' at the geocentric position 'pos'.
+//
+//    The key identifies the target (e.g., its player and network IDs; zero
+//    isn't a valid key), and isn't a pointer, so a deleted player's entry
+//    can't be found by a new player that reuses its memory.  A result is only
+//    used for a target at the same position (within the tolerance) as the one
+//    that it was computed for, so two targets with the same key only cause
+//    cache misses.  With a tolerance of zero, results are only reused when
+//    neither the observer nor the target has moved, which gives the same
+//    results as checking the terrain each time.
+//
+//    Not thread-safe; each gimbal has its own cache, which is only used by
+//    the gimbal's processPlayersOfInterest().
+//------------------------------------------------------------------------------
+class OccultingCache
+{
+public:
+   OccultingCache() = default;
+   OccultingCache(const OccultingCache&) = delete;
+   OccultingCache& operator=(const OccultingCache&) = delete;
+   ~OccultingCache();
+
+   unsigned int getNumEntries() const   { return numEntries; }
+
+   void setObserver(const terrain::Terrain* const terrain, const base::Vec3d& pos, const double tol);
+   bool find(const std::uint64_t key, const base::Vec3d& pos, const bool space, bool* const occulted) const;
+   void insert(const std::uint64_t key, const base::Vec3d& pos, const bool space, const bool occulted);
+   void clear();
+
+private:
+   static const unsigned int MIN_SIZE = 64;        // Initial table size
+   static const unsigned int MAX_ENTRIES = 65536;  // Max entries before the cache is cleared
+
+   struct Entry {
+      std::uint64_t key;      // Target's key (zero for an empty slot)
+      base::Vec3d pos;        // Target's position when the result was computed (ECEF)
+      bool space;             // Target was a space vehicle
+      bool occulted;          // Target was occulted
+   };
+
+   static unsigned int hashKey(const std::uint64_t key);
+   void resize(const unsigned int size);
+   void clearEntries();
+
+   const terrain::Terrain* terrain {};   // Terrain database (only used to detect changes)
+   base::Vec3d observer;                 // Observer's position when the results were computed (ECEF)
+   bool haveObserver {};                 // Observer's position is valid
+   double tol2 {};                       // Movement tolerance squared (meters^2)
+
+   // Open addressing hash table (linear probing); 'key' is zero for an empty slot
+   Entry* table {};
+   unsigned int size {};                 // Table size (power of two)
+   unsigned int numEntries {};           // Number of entries
+};
+
+}
+}
+
+#endif
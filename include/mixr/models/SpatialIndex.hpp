@@ -0,0 +1,117 @@
+
+#ifndef __mixr_models_SpatialIndex_H__
+#define __mixr_models_SpatialIndex_H__
+
+#include "mixr/base/Object.hpp"
+#include "mixr/base/osg/Vec3d"
+
+#include <cstdint>
+
+namespace mixr {
+namespace base { class PairStream; }
+namespace models {
+class Player;
+
+//------------------------------------------------------------------------------
+// Class: SpatialIndex
+// Description: Uniform ECEF grid over the geocentric positions of the players
+//              on a player list; used by Tdb to find players of interest
+//              without scanning the whole player list.
+//
+//    The index is built by WorldModel once per background frame (see the
+//    WorldModel slot 'spatialIndexCellSize'); after that, only the players'
+//    drift (see measureDrift()) is updated.
+//
+//    query() returns the player list indices of the players that may be
+//    within 'radius' of 'center', in player list order, so callers that apply
+//    their own exact range, angle and type checks to the players (see
+//    getPlayer()) get the same results as a scan of the full player list.
+//    The indices are written to the caller's buffer, so concurrent queries
+//    don't allocate or share any memory.
+//
+//    measureDrift(time) measures how far the players have moved from their
+//    indexed positions; WorldModel calls it after each T/C frame, so it also
+//    sees the players that were repositioned or whose dead reckoning was
+//    corrected.  The players that moved more than a quarter of a cell are
+//    strays, which are returned by every query; the search radius is
+//    enlarged by the max drift of the other players, and by twice the
+//    distance that the fastest player could have moved since the drift was
+//    measured (i.e., a T/C frame that's in progress on another thread), so
+//    the players within 'radius' are never missed.
+//
+// Factory name: SpatialIndex
+//------------------------------------------------------------------------------
+class SpatialIndex : public base::Object
+{
+   DECLARE_SUBCLASS(SpatialIndex, base::Object)
+
+public:
+   SpatialIndex() = delete;
+   SpatialIndex(base::PairStream* const players, const double cellSize, const double time);
+
+   // True if this index was built from the player list 'pl'
+   bool isIndexOf(const base::PairStream* const pl) const   { return (pl != nullptr && pl == playerList); }
+
+   unsigned int getNumPlayers() const                       { return numPlayers; }
+   double getCellSize() const                               { return cellSize; }
+
+   // Player at index 'idx' of the player list, or nullptr
+   Player* getPlayer(const unsigned int idx) const          { return (idx < numPlayers ? players[idx] : nullptr); }
+
+   // Find the players of type 'mask' that may be within 'radius' (meters) of
+   // the ECEF position 'center' at executive time 'time'; returns the number
+   // of player list indices in 'idx' (max of 'max'), in player list order.
+   unsigned int query(
+      const base::Vec3d& center,
+      const double radius,
+      const double time,
+      const unsigned int mask,
+      unsigned int* const idx,
+      const unsigned int max
+   ) const;
+
+   // Measure the players' drift from their indexed positions at executive
+   // time 'time'; O(n)
+   void measureDrift(const double time);
+
+private:
+   // Grid entry, sorted by cell key
+   struct Entry {
+      std::uint64_t key;      // Cell key
+      unsigned int idx;       // Index of the player on the player list
+      bool operator<(const Entry& e) const { return key < e.key; }
+   };
+
+   static const unsigned int KEY_BITS = 21;                       // Bits per cell index
+   static const int KEY_BIAS = (1 << (KEY_BITS - 1));             // Cell index bias
+   static const int KEY_MAX = (1 << KEY_BITS) - 1;                // Max (biased) cell index
+
+   int cellIndex(const double v) const;
+   static std::uint64_t cellKey(const int ix, const int iy, const int iz);
+
+   void clear();
+
+   base::PairStream* playerList {};   // The indexed player list (ref()'d)
+   double cellSize {};                // Grid cell size (meters)
+
+   // Players' drift (locked by 'semaphore')
+   double drift {};                   // Max distance of the non-strays from their indexed positions (meters)
+   double driftSpeed {};              // Max player speed when measured (m/s)
+   double driftTime {};               // Executive time when measured (seconds)
+   unsigned int* strays {};           // Indices of the stray players, in player list order
+   unsigned int numStrays {};         // Number of stray players
+   mutable long semaphore {};
+
+   unsigned int* newStrays {};        // measureDrift()'s stray buffer (swapped with 'strays')
+
+   Entry* entries {};                 // Grid entries sorted by cell key
+   Player** players {};               // Players in player list order (ref()'d by the list)
+   base::Vec3d* positions {};         // Geocentric positions in player list order
+   unsigned int* types {};            // Major types in player list order
+   unsigned int numPlayers {};        // Number of players
+};
+
+}
+}
+
+#endif
@@ -6,8 +6,10 @@
 #include "mixr/base/osg/Vec3d"
 
 namespace mixr {
+namespace terrain { class Terrain; }
 namespace models {
 class Gimbal;
+class OccultingCache;
 class Player;
 
 //------------------------------------------------------------------------------
@@ -71,6 +73,10 @@ public:
    //------------------------------------------------------------------------------
    virtual unsigned int processPlayers(base::PairStream* const players);
 
+   // Sets the terrain occulting results that processPlayers() uses and
+   // updates (i.e., our gimbal's; see Gimbal::getOccultingCache())
+   void setOccultingCache(OccultingCache* const cache)   { occultingCache = cache; }
+
    // ---
    // Data from processPlayers()
    // ---
@@ -134,8 +140,21 @@ protected:
    // -- old data is lost
    virtual bool resizeArrays(const unsigned int newSize);
 
+   // Resize the terrain occulting arrays (grow only, or zero to free them)
+   void resizeOccultingArrays(const unsigned int newSize);
+
+   // Terrain occulting checks of the 'n' targets, which are in player list
+   // order; the targets that aren't occulted are added to the target list
+   void occultTargets(
+      const terrain::Terrain* const terrain,
+      Player** const tgts,
+      const double* const tanTgtAngs,
+      const unsigned int n
+   );
+
    const Player* ownship {};     // Our ownship player (set using setGimbal())
    const Gimbal* gimbal {};      // Our gimbal (set in setGimbal())
+   OccultingCache* occultingCache {}; // Terrain occulting results, or nullptr (not ref()'d)
 
    bool usingEcefFlg {};         // Using ECEF flag --
                                  //   When gimbal's 'useWorld' is true or when our ownship's
@@ -161,6 +180,21 @@ protected:
    double* za {};
    double* ra2 {};
    double* ra {};
+
+   // processPlayers() spatial index query buffer (grow only)
+   unsigned int* candidates {};  // Player list indices of the candidates
+   unsigned int maxCandidates {}; // Size of the candidates buffer
+
+   // Terrain occulting arrays (grow only)
+   Player** pending {};          // Targets waiting for their occulting check
+   double* pendingTan {};        // Tangents of their angles from local level
+   bool* occulted {};            // Target is occulted
+   unsigned int* bIdx {};        // Batch of standard targets: index of the target,
+   double* bLat {};              //    latitude (degs),
+   double* bLon {};              //    longitude (degs),
+   double* bAlt {};              //    altitude (meters),
+   bool* bOcculted {};           //    and its result
+   unsigned int maxOcculting {}; // Size of the terrain occulting arrays
 };
 
 }
@@ -0,0 +1,156 @@
+
+#ifndef __mixr_models_TrackAssociator_H__
+#define __mixr_models_TrackAssociator_H__
+
+#include "mixr/base/osg/Vec3d"
+
+#include <cstdint>
+
+namespace mixr {
+namespace models {
+
+//------------------------------------------------------------------------------
+// Class: TrackAssociator
+//
+// Description: Associates new reports (observations) with the current tracks;
+//              used by the track managers' processTrackList() in place of a
+//              dense report/track match matrix.
+//
+//    begin(numTracks, numReports)
+//       Starts a new association; the buffers grow as needed, so there's no
+//       fixed limit on the number of tracks or reports.
+//
+//    setTrack(it, key, pos) and setReport(ir, key, pos)
+//       Sets the target key and position of track 'it' and report 'ir'.
+//
+//    associate(method, gate)
+//       Associates the reports with the tracks, and returns the number of
+//       matches, which are sorted by report (see getMatchReport() and
+//       getMatchTrack()).  Reports without a match start new tracks.
+//
+// Methods:
+//
+//    TARGET
+//       Ground truth: a report matches each of the tracks with the same
+//       target key (same as the old match matrix), using a hash table of
+//       the track keys.
+//
+//    NEAREST_NEIGHBOR
+//       In report order, each report takes the nearest unmatched track
+//       that's within 'gate' meters.
+//
+//    GLOBAL_NEAREST_NEIGHBOR
+//       One-to-one assignment of reports to tracks that minimizes the total
+//       squared distance, where leaving a report unmatched costs gate
+//       squared (auction algorithm with epsilon scaling, within gate^2 * 1e-6
+//       of the optimal total).
+//
+//    For both nearest neighbor methods, the candidate pairs are found using
+//    a uniform grid, with a cell size of 'gate', over the track positions,
+//    so the cost is about linear in the number of tracks and reports.
+//
+//    Not thread-safe; each track manager has its own associator.
+//------------------------------------------------------------------------------
+class TrackAssociator
+{
+public:
+   enum Method { TARGET, NEAREST_NEIGHBOR, GLOBAL_NEAREST_NEIGHBOR };
+
+public:
+   TrackAssociator() = default;
+   TrackAssociator(const TrackAssociator&) = delete;
+   TrackAssociator& operator=(const TrackAssociator&) = delete;
+   ~TrackAssociator();
+
+   void begin(const unsigned int numTracks, const unsigned int numReports);
+
+   void setTrack(const unsigned int it, const void* const key, const base::Vec3d& pos);
+   void setReport(const unsigned int ir, const void* const key, const base::Vec3d& pos);
+
+   unsigned int associate(const Method method, const double gate);
+
+   unsigned int getNumTracks() const                           { return numTracks; }
+   unsigned int getNumReports() const                          { return numReports; }
+
+   // Matches, sorted by report, [ 0 .. getNumMatches()-1 ]
+   unsigned int getNumMatches() const                          { return numMatches; }
+   unsigned int getMatchReport(const unsigned int i) const     { return matchRpt[i]; }
+   unsigned int getMatchTrack(const unsigned int i) const      { return matchTrk[i]; }
+
+   // Number of matches of report 'ir' and track 'it'
+   unsigned int getReportNumMatches(const unsigned int ir) const  { return rptNumMatches[ir]; }
+   unsigned int getTrackNumMatches(const unsigned int it) const   { return trkNumMatches[it]; }
+
+private:
+   static const unsigned int KEY_BITS = 21;                    // Bits per cell index
+   static const int KEY_BIAS = (1 << (KEY_BITS - 1));          // Cell index bias
+   static const int KEY_MAX = (1 << KEY_BITS) - 1;             // Max (biased) cell index
+   static const unsigned int NONE = 0xffffffff;                // No track/report
+
+   struct Cell {
+      std::uint64_t key;      // Cell key
+      unsigned int first;     // First track in the cell, or NONE for an empty slot
+   };
+
+   void associateTargets();
+   void associateNearest();
+   void associateGlobal(const double gate2);
+
+   void buildGrid(const double gate);
+   void findCandidates(const double gate2);
+   unsigned int findCell(const std::uint64_t key) const;
+   int cellIndex(const double v) const;
+   static std::uint64_t cellKey(const int ix, const int iy, const int iz);
+
+   void addMatch(const unsigned int ir, const unsigned int it);
+
+   // Tracks
+   const void** trkKey {};
+   base::Vec3d* trkPos {};
+   unsigned int* trkNumMatches {};
+   unsigned int* trkNext {};              // Next track in the same hash chain or grid cell
+   unsigned int numTracks {};
+   unsigned int maxTracks {};
+
+   // Reports
+   const void** rptKey {};
+   base::Vec3d* rptPos {};
+   unsigned int* rptNumMatches {};
+   unsigned int* candFirst {};            // Report's first candidate, [ 0 .. numReports ]
+   unsigned int numReports {};
+   unsigned int maxReports {};
+
+   // Candidate report/track pairs, sorted by report
+   unsigned int* candTrk {};
+   double* candCost {};                   // Distance squared
+   unsigned int numCand {};
+   unsigned int maxCand {};
+
+   // Auction (GNN): the rows are the reports and then the tracks' dummies;
+   // the columns are the tracks and then the reports' dummies
+   unsigned int* rowFirst {};             // Row's first edge, [ 0 .. numRows ]
+   unsigned int* rowCol {};               // Column assigned to the row
+   unsigned int* rowQueue {};             // Unassigned rows
+   unsigned int* colOwner {};             // Row assigned to the column
+   double* colPrice {};                   // Column's price
+   unsigned int maxRows {};
+   unsigned int* edgeCol {};
+   double* edgeCost {};
+   unsigned int maxEdges {};
+
+   // Matches, sorted by report
+   unsigned int* matchRpt {};
+   unsigned int* matchTrk {};
+   unsigned int numMatches {};
+   unsigned int maxMatches {};
+
+   // Hash table of the track keys (TARGET) or of the grid cells
+   Cell* cells {};
+   unsigned int cellsSize {};             // Table size (power of two)
+   double cellSize {};                    // Grid cell size (meters)
+};
+
+}
+}
+
+#endif
@@ -8,6 +8,8 @@ namespace mixr {
 namespace terrain { class Terrain; }
 namespace models {
 class AbstractAtmosphere;
+class CommBus;
+class SpatialIndex;
 
 //------------------------------------------------------------------------------
 // Class: WorldModel
@@ -43,6 +45,11 @@ class AbstractAtmosphere;
 //    terrain        <terrain:Terrain>        ! Terrain elevation database (default: nullptr)
 //    atmosphere     <Atmosphere>             ! Atmosphere
 //
+//    spatialIndexCellSize <base::Distance>   ! Cell size of the players-of-interest spatial index,
+//                                            ! or zero for no index (default: 0)
+//
+//    commBus        <CommBus>                ! Datalink communications bus (default: nullptr)
+//
 
 // Gaming area reference point:
 //
@@ -73,6 +80,25 @@ class AbstractAtmosphere;
 //    Current simulation environments include terrain elevation posts, getTerrain(),
 //    and atmosphere model, getAtmosphere().
 //
+// Spatial index:
+//
+//    If the 'spatialIndexCellSize' slot is set, a uniform ECEF grid of the
+//    player positions (see SpatialIndex.hpp) is rebuilt after each update of
+//    the player list (i.e., once per background frame) and on reset(), and
+//    the players' drift from their indexed positions is measured after each
+//    time-critical frame, so the index finds the same players as a scan.  The
+//    gimbal's target data blocks (see Tdb.hpp) use getSpatialIndex() to find
+//    the players within range without scanning the full player list.  A cell
+//    size that is about the typical max range to the players of interest
+//    works well.
+//
+// Comm bus:
+//
+//    If the 'commBus' slot is set, the datalinks of the local players subscribe
+//    to the bus by network and radio frequency, and their messages are only
+//    delivered to the subscribers of the same network and frequency, in place
+//    of the broadcast to all players (see CommBus.hpp and Datalink.hpp).
+//
 // Shutdown:
 //
 //    At shutdown, the parent object must send a SHUTDOWN_EVENT event to
@@ -112,6 +138,16 @@ public:
     AbstractAtmosphere* getAtmosphere();                   // returns the atmosphere model
     const AbstractAtmosphere* getAtmosphere() const;       // returns the atmosphere model (const version)
 
+    // players-of-interest spatial index
+    SpatialIndex* getSpatialIndex();                       // returns the spatial index, or nullptr; pre-ref()'d
+    const SpatialIndex* getSpatialIndex() const;           // returns the spatial index, or nullptr; pre-ref()'d (const version)
+    double getSpatialIndexCellSize() const;                // spatial index cell size (meters), or zero if disabled
+
+    // datalink communications bus
+    CommBus* getCommBus();                                 // returns the comm bus, or nullptr
+    const CommBus* getCommBus() const;                     // returns the comm bus, or nullptr (const version)
+
+    virtual void updateTC(const double dt = 0.0) override;
     virtual void reset() override;
 
 protected:
@@ -122,6 +158,9 @@ protected:
     virtual bool setRefLatitude(const double v);      // Sets Ref latitude
     virtual bool setRefLongitude(const double v);     // Sets Ref longitude
     virtual bool setMaxRefRange(const double v);      // Sets the max range (meters) of the gaming area or zero if there's no limit.
+    virtual bool setSpatialIndexCellSize(const double v); // Sets the spatial index cell size (meters) or zero for no index
+
+    virtual void updatePlayerList() override;
 
    // environmental interface
     terrain::Terrain* getTerrain();                        // returns the terrain elevation database
@@ -129,6 +168,7 @@ protected:
 
 private:
    void initData();
+   void updateSpatialIndex();
 
    bool setSlotRefLatitude(const base::LatLon* const msg);
    bool setSlotRefLatitude(const base::Number* const msg);
@@ -143,6 +183,8 @@ private:
    // environmental interface
    bool setSlotTerrain(terrain::Terrain* const msg);
    bool setSlotAtmosphere(AbstractAtmosphere* const msg);
+   bool setSlotSpatialIndexCellSize(const base::Distance* const msg);
+   bool setSlotCommBus(CommBus* const msg);
 
    // Our Earth Model, or default to using base::EarthModel::wgs84 if zero
    const base::EarthModel* em {};
@@ -162,6 +204,11 @@ private:
    AbstractAtmosphere* atmosphere {};
    terrain::Terrain* terrain {};
 
+   double indexCellSize {};                     // Spatial index cell size (meters) or zero
+   base::safe_ptr<SpatialIndex> spatialIndex;   // Players-of-interest spatial index
+
+   CommBus* commBus {};                         // Datalink communications bus
+
 };
 
 }
@@ -3,9 +3,10 @@
 #define __mixr_models_IrAtmosphere1_H__
 
 #include "mixr/models/environment/IrAtmosphere.hpp"
+#include "mixr/models/IrCache.hpp"
 
 namespace mixr {
-namespace base { class Number; class Table1; class Table2; class Table3;
+namespace base { class Distance; class Number; class Table1; class Table2; class Table3;
                  class Table4; class Number; }
 namespace models {
 class IrQueryMsg;
@@ -21,6 +22,24 @@ class IrQueryMsg;
 //    solarRadiationTable        <Table2>       The table containing solar radiation tables
 //    backgroundRadiationTable   <Table3>       The background radiation table
 //    transmissivityTable        <Table4>       The table containing transmissivity data
+//    atmosphereCache            <Number>       Enable the atmosphere cache (default: false)
+//    altitudeTolerance          <Distance>     Atmosphere cache bin size of the seeker's and target's altitudes (default: 0)
+//    rangeTolerance             <Distance>     Atmosphere cache bin size of the ground range (default: 0)
+//
+// Atmosphere cache:
+//    The background radiation, the solar radiation and the transmissivity of
+//    all wavebands are computed in one pass over the wavebands (see
+//    computeWaveBands()), and, if the atmosphere cache is enabled, they're
+//    saved for the rest of the frame, keyed on the seeker's and the target's
+//    altitudes, the ground range and the sensor's waveband.  The queries whose
+//    inputs fall in the same bins (see the tolerance slots) reuse the saved
+//    values; with tolerances of zero, only queries with the exact same inputs
+//    reuse them.  The target's signature is not cached by the atmosphere (see
+//    AircraftIrSignature's signature cache).
+//
+//    IrCache* getAtmosphereCache()
+//       The atmosphere cache, and its hit and miss statistics.  The cache is
+//       only used if the ownship is in a world model (see IrCache::frameOf()).
 //
 // Public Member Functions:
 //
@@ -95,7 +114,23 @@ public:
    IrAtmosphere1();
    virtual bool calculateAtmosphereContribution(IrQueryMsg* const msg, double* totalSignal, double* totalBackground) override;
 
+   bool isAtmosphereCacheEnabled() const         { return atmosphereCache; }
+   virtual bool setAtmosphereCacheEnabled(const bool flg);
+   IrCache* getAtmosphereCache()                 { return &cache; }
+   const IrCache* getAtmosphereCache() const     { return &cache; }
+
 protected:
+   // Waveband inputs: seeker's and target's altitudes (meters), ground range
+   // (meters) and the sensor's waveband (microns), which are the cache's key,
+   // and the view angle (radians), which is computed from the key
+   enum { IN_OWN_ALT, IN_TGT_ALT, IN_RANGE, IN_LOWER, IN_UPPER, NUM_KEYS, IN_VIEW_ANGLE = NUM_KEYS, NUM_INPUTS };
+
+   // Waveband values: background and solar radiation within the sensor's
+   // waveband, transmissivity, and the waveband's fraction of a simple signature
+   enum { VAL_BACKGROUND, VAL_SOLAR, VAL_TRANS, VAL_FRACTION, NUM_VALUES };
+
+   // Computes the values of all wavebands in one pass [ numWaveBands * NUM_VALUES ]
+   virtual void computeWaveBands(const double* const inputs, double* const values) const;
 
    double getTransmissivity(
       const double lowerWavelength,      // The lower wavelength (microns)
@@ -145,11 +180,17 @@ protected:
    virtual bool setSlotSolarRadiationTable(const base::Table2* const tbl);
    virtual bool setSlotBackgroundRadiationTable(const base::Table3* const tbl);
    virtual bool setSlotTransmissivityTable(const base::Table4* const tbl);
+   bool setSlotAtmosphereCache(const base::Number* const msg);
+   bool setSlotAltitudeTolerance(const base::Distance* const msg);
+   bool setSlotRangeTolerance(const base::Distance* const msg);
 
 private:
    const base::Table2* solarRadiationTable {};
    const base::Table3* backgroundRadiationTable {};
    const base::Table4* transmissivityTable {};
+
+   bool atmosphereCache {};      // Atmosphere cache enabled
+   mutable IrCache cache;        // Atmosphere cache
 };
 
 }
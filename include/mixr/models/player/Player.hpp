@@ -169,6 +169,9 @@ class Track;
 //    DATALINK_MESSAGE        <base::Object>       ! Hit with a datalink message
 //    IR_QUERY_MSG            <IrQueryMsg>         ! IR seeker requests signature
 //
+//    Transmitters (see Antenna::rfTransmit()) deliver their RF emissions by
+//    calling onRfEmissions() with the emissions for this player, which is
+//    the same as an RF_EMISSION event for each of them.
 //
 //
 // Coordinate systems
@@ -871,6 +874,7 @@ public:
    virtual bool onTriggerSwEvent(const base::Boolean* const msg = nullptr);   // Handles the TRIGGER_SW_EVENT event
    virtual bool onTgtStepEvent();                                             // Handles the TGT_STEP_EVENT event
    virtual bool onRfEmissionEventPlayer(Emission* const msg);                 // Handles the RF_EMISSION event
+   virtual bool onRfEmissions(Emission* const* const ems, const unsigned int n); // Handles 'n' RF emissions sent to us (same as 'n' RF_EMISSION events)
    virtual bool onRfReflectedEmissionEventPlayer(Emission* const msg);        // Handles the RF_EMISSION event reflected to a 3rd party
    virtual bool onReflectionsRequest(base::Component* const msg);             // Handles the RF_REFLECTIONS_REQUEST event
    virtual bool onReflectionsCancel(const base::Component* const msg);        // Handles the RF_REFLECTIONS_CANCEL event
@@ -989,6 +993,7 @@ protected:
 private:
    void initData();
    WorldModel* getSimulationImp();
+   void onRfEmission(Emission* const em);
 
    // ---
    // Player identity
@@ -3,7 +3,6 @@
 #define __mixr_models_AngleOnlyTrackManager_H__
 
 #include "mixr/models/system/TrackManager.hpp"
-#include "mixr/base/safe_queue.hpp"
 #include "mixr/base/util/constants.hpp"
 
 namespace mixr {
@@ -30,9 +29,15 @@ public:
 
    virtual void newReport(IrQueryMsg* q, double snDbl);
 
+   // Emission reports (e.g., from a Radar or Rwr) are ignored: we queue only IR query messages
+   virtual void newReport(Emission* em, double snDbl) override;
+
    virtual void clearTracksAndQueues() override;
    virtual bool addTrack(Track* const t) override;
 
+   // Max of MAX_TRKS (AirAngleOnlyTrkMgr's report/track match arrays are fixed size)
+   virtual bool setMaxTracks(const unsigned int n) override;
+
 protected:
    virtual IrQueryMsg* getQuery(double* const sn);                     // Get the next 'new' report from the queue
 
@@ -49,10 +54,6 @@ protected:
    double elevationBin {base::PI};   // Elevation Bin
    double oneMinusAlpha {};          // 1 - Alpha parameter
    double oneMinusBeta {1.0};        // 1 - Beta parameter
-
-private:
-   base::safe_queue<IrQueryMsg*> queryQueue;  // Emission input queue (used with the
-                                              //   TrackManager::queueLock semaphore)
 };
 
 //------------------------------------------------------------------------------
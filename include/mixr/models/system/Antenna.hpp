@@ -4,8 +4,6 @@
 
 #include "mixr/models/system/ScanGimbal.hpp"
 
-#include "mixr/base/safe_queue.hpp"
-#include "mixr/base/safe_stack.hpp"
 #include "mixr/base/util/constants.hpp"
 
 namespace mixr {
@@ -48,7 +46,22 @@ class RfSystem;
 //
 //    2) When the Emission 'recycle' flag is enabled (default behavior), the
 //       system will try to reuse Emission objects, which removes the overhead
-//       of creating and deleting them.
+//       of creating and deleting them.  Each thread has its own emission
+//       arena, which isn't locked; the arena is reset once per phase, and an
+//       emission is reused only after the receiving players and systems have
+//       released it.  Free emissions are cleared, so they don't hold their
+//       ownship and target players, and the arena is released when the
+//       simulation shuts down or its thread exits.
+//
+//    3) rfTransmit() first fills a contiguous array with the emissions that
+//       are to be sent, one for each target above threshold, and then
+//       passes the array to deliverEmissions(), which groups the emissions
+//       by target and calls each target's Player::onRfEmissions() with its
+//       batch; this is the same as sending the target an RF_EMISSION event
+//       for each emission.  The receiving antennas (onRfEmissions()) look up
+//       their ownship, system and rotation matrix once per batch, and still
+//       call rfReceivedEmission() for each emission.  (A single rfTransmit()
+//       sends each target at most one emission, so its batches are of one.)
 //
 //------------------------------------------------------------------------------
 class Antenna : public ScanGimbal
@@ -119,23 +132,16 @@ public:
    virtual bool onEndScanEvent(base::Integer* const bar) override;
 
    virtual bool onRfEmissionEvent(Emission* const) override;
+   virtual bool onRfEmissions(Emission* const* const ems, const unsigned int n) override;
 
    virtual bool event(const int event, base::Object* const obj = nullptr) override;
-   virtual void reset() override;
 
 protected:
-   void clearQueues();
-
-   virtual void process(const double dt) override;     // Phase 3
+   // Delivers the 'n' emissions in 'ems' to their target players
+   virtual void deliverEmissions(Emission* const* const ems, const unsigned int n);
 
    virtual bool shutdownNotification() override;
 
-   base::safe_stack<Emission*> freeEmStack {MAX_EMISSIONS};  // Free emission stack
-   mutable long freeEmLock {};                               // Semaphore to protect 'freeEmStack'
-
-   base::safe_queue<Emission*> inUseEmQueue {MAX_EMISSIONS}; // In use emission queue
-   mutable long inUseEmLock {};                              // Semaphore to protect 'inUseEmQueue'
-
 private:
    static const int MAX_EMISSIONS = 10000;   // Max size of emission queues and arrays
 
@@ -154,6 +160,8 @@ private:
    bool gainPatternDeg {};          // Gain pattern is in degrees flag (else radians)
 
    bool recycle {true};             // Recycle emissions flag
+
+   void receiveEmission(Emission* const em, RfSystem* const rfSys, const base::Matrixd& mm);
 };
 
 }
@@ -5,10 +5,12 @@
 #include "mixr/models/system/System.hpp"
 
 #include "mixr/base/safe_queue.hpp"
+#include "mixr/base/mpsc_queue.hpp"
 
 namespace mixr {
 namespace base { class Distance; class Number; class String; }
 namespace models {
+class CommBus;
 class CommRadio;
 class TrackManager;
 
@@ -19,11 +21,12 @@ class TrackManager;
 // Factory name: Datalink
 // Slots:
 //    radioId           <Number>     ! Radio ID (see note #1) (default: 0)
-//    maxRange          <Distance>   ! Max range of the datalink (w/o a radio model) (see note #2)
+//    maxRange          <Distance>   ! Max range of the datalink (w/o a radio model) (see notes #2 and #5)
 //                                   ! (default: 5000)
 //    radioName         <Identifier> ! Name of the (optional) communication radio model (see notes #1 and #2)
 //                                   ! (default: 0)
 //    trackManagerName  <Identifier> ! Track Manager Name (default: 0)
+//    network           <Number>     ! Network number on the world model's comm bus (see note #4) (default: 0)
 //
 // Events:
 //    DATALINK_MESSAGE  (base::Object)  Default handler: Pass messages to subcomponents.
@@ -34,6 +37,19 @@ class TrackManager;
 //    2) 'maxRange' is used when a named radio, 'radioName', is not provided.
 //    3) This class is one of the "top level" systems attached to a Player
 //       class (see Player.hpp).
+//    4) If the world model has a comm bus (see CommBus.hpp), the player's top
+//       level datalink, and any datalink with a radio, subscribes to the bus by
+//       its 'network' number and its radio's frequency, and its messages are
+//       published on the bus in place of the broadcast to all local players
+//       or the radio's R/F emission; with a radio, the messages only reach
+//       the players within its 'maxDetectRange'.  Messages from the bus are
+//       posted to the datalink's inbox (see postMessage()), and they're passed
+//       to the DATALINK_MESSAGE event handler by dynamics(), on the datalink's
+//       own thread.  So a message on the bus is handled up to one frame later
+//       than the broadcast (i.e., by the receiver's next dynamics(), if the
+//       receiver has already run this frame's dynamics()).
+//    5) Without a radio, 'maxRange' only limits the messages on the comm bus
+//       if its 'rangeCulling' is enabled.
 //------------------------------------------------------------------------------
 class Datalink : public System
 {
@@ -66,6 +82,14 @@ public:
    bool isNetworkQueueEnabled() const                                  { return queueForNetwork; }
    virtual bool setNetworkQueueEnabled(const bool flg);
 
+   // Comm bus network number (default: 0)
+   int getNetwork() const                                              { return network; }
+   virtual bool setNetwork(const int num);
+
+   // Posts a message from the comm bus to our inbox (any thread); returns
+   // false if the inbox is full
+   bool postMessage(base::Object* const msg);
+
    // For network handler to get to the messages
    base::safe_queue<base::Object*>* getOutputQueue()                   { return outQueue; }
 
@@ -90,6 +114,7 @@ protected:
    // Slot functions
    virtual bool setSlotRadioId(const base::Number* const num);
    virtual bool setSlotMaxRange(const base::Distance* const num);
+   virtual bool setSlotNetwork(const base::Number* const num);
 
    virtual void dynamics(const double dt) override;
 
@@ -97,8 +122,13 @@ protected:
 
 private:
    void initData();
+   void updateCommBus();         // (Re)subscribes to the world model's comm bus
+   void unsubscribeCommBus();    // Unsubscribes from the comm bus
+   void processInbox();          // Handles the messages in our inbox
+   void clearInbox();
 
    static const int MAX_MESSAGES = 1000;  // Max number of messages in queues
+   static const unsigned int INBOX_BATCH = 64;   // Messages drained from the inbox at a time
 
    base::safe_queue<base::Object*>* inQueue {};   // Received message queue
    base::safe_queue<base::Object*>* outQueue {};  // Queue for messages going out over the network/DIS
@@ -115,6 +145,16 @@ private:
 
    TrackManager* trackManager {};        // Track manager
    const base::String* tmName {};        // Track manager name
+
+   int network {};                       // Comm bus network number
+   CommBus* commBus {};                  // Comm bus that we're subscribed to (ref()'d)
+   int busNetwork {};                    // Subscribed network number
+   double busFreq {};                    // Subscribed frequency (hertz)
+
+   // Comm bus inbox; the consumers (processInbox() and clearInbox()) are
+   // serialized by 'inboxLock'
+   base::mpsc_queue<base::Object*>* inbox {};
+   long inboxLock {};
 };
 
 }
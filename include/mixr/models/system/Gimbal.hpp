@@ -3,6 +3,7 @@
 #define __mixr_models_Gimbal_H__
 
 #include "mixr/models/system/System.hpp"
+#include "mixr/models/OccultingCache.hpp"
 
 #include "mixr/base/osg/Vec3d"
 #include "mixr/base/osg/Matrixd"
@@ -91,6 +92,8 @@ class Tdb;
 //
 //    terrainOcculting     (Boolean)         ! Enable terrain occulting of the players of interest (default: false)
 //    checkHorizon         (Boolean)         ! Enable horizon masking check (default: true)
+//    terrainOccultingTolerance (Distance)   ! Terrain occulting results are reused until the ownship or the target
+//                                           ! moves more than this distance (default: 0, i.e., until either moves)
 //
 //    playerOfInterestTypes (PairStream)     ! List of player of interest types (default: all types )
 //                                           ! Valid types: { "air" "ground" "weapon" "ship" "building" "lifeform" "space" }
@@ -216,6 +219,9 @@ public:  // Public section
    bool isLocalPlayersOfInterestOnly() const { return localOnly; }          // Local only players of interest flag
    bool isTerrainOccultingEnabled() const  { return terrainOcculting; }     // Terrain occulting enabled flag
    bool isHorizonCheckEnabled() const      { return checkHorizon; }         // Horizon masking enable flag
+   double getTerrainOccultingTolerance() const { return occultingTol; }     // Terrain occulting movement tolerance (meters)
+   OccultingCache* getOccultingCache()     { return &occultingCache; }      // Terrain occulting results (see Tdb::processPlayers())
+   const OccultingCache* getOccultingCache() const { return &occultingCache; } // Terrain occulting results (const version)
    bool isUsingWorldCoordinates() const    { return useWorld; }             // Returns true if using player of interest's world coordinates
    bool isUsingHeadingOnly() const         { return ownHeadingOnly; }       // Returns true if using players heading only
    double getEarthRadius() const;                                           // Returns earth radius (meters)
@@ -228,6 +234,7 @@ public:  // Public section
    virtual bool setLocalPlayersOfInterestOnly(const bool flg);             // Sets the local only players of interest flag
    virtual bool setTerrainOccultingEnabled(const bool flg);                // Sets the terrain occulting enabled flag
    virtual bool setHorizonCheckEnabled(const bool flg);                    // Sets the horizon check enabled flag
+   virtual bool setTerrainOccultingTolerance(const double meters);         // Sets the terrain occulting movement tolerance (meters)
    virtual bool setUseWorld(const bool flg);                               // Sets the using world coordinates flag
    virtual bool setOwnHeadingOnly(const bool flg);                         // Use only the ownship player's heading to when transforming between body and local NED
 
@@ -264,6 +271,7 @@ public:  // Public section
 
    // Event handler(s)
    virtual bool onRfEmissionEvent(Emission* const);                             // Handles R/F emission events
+   virtual bool onRfEmissions(Emission* const* const ems, const unsigned int n);  // Handles 'n' R/F emissions (same as 'n' R/F emission events)
 
    // Slot functions
    virtual bool setSlotType(const base::String* const msg);                     // Physical gimbal type: "mechanical" or "electronic"
@@ -303,6 +311,7 @@ public:  // Public section
 
    virtual bool setSlotTerrainOcculting(const base::Number* const msg);         // Enable target terrain occulting (default: false)
    virtual bool setSlotCheckHorizon(const base::Number* const msg);             // Enable horizon masking check (default: true)
+   virtual bool setSlotTerrainOccultingTolerance(const base::Distance* const msg); // Terrain occulting movement tolerance (default: 0)
 
    virtual bool setSlotPlayerTypes(const base::PairStream* const msg);          // Player of interest types (default: 0 )
    virtual bool setSlotMaxPlayers(const base::Number* const msg);               // Max number of players of interest (default: 0)
@@ -379,10 +388,13 @@ private:
    bool     localOnly {};              // Local players of interest only
    bool     terrainOcculting {};       // Target terrain occulting enabled flag
    bool     checkHorizon {true};       // Horizon masking check enabled flag
+   double   occultingTol {};           // Terrain occulting movement tolerance (meters)
    bool     useWorld {true};           // Using player of interest's world coordinates
    bool     ownHeadingOnly {true};     // Whether only the ownship heading is used by the target data block
 
    base::safe_ptr<Tdb> tdb;  // Current Target Data Block
+
+   OccultingCache occultingCache;      // Terrain occulting results
 };
 
 }
@@ -3,13 +3,16 @@
 #define __mixr_models_TrackManager_H__
 
 #include "mixr/models/system/System.hpp"
-#include "mixr/base/safe_queue.hpp"
+#include "mixr/models/TrackAssociator.hpp"
+#include "mixr/base/mpsc_queue.hpp"
 #include "mixr/base/units/distance_utils.hpp"
 
 namespace mixr {
+namespace base { class Identifier; }
 namespace models {
 class Emission;
 class Player;
+class SensorMsg;
 class Track;
 
 //------------------------------------------------------------------------------
@@ -19,7 +22,7 @@ class Track;
 //
 // Factory name: TrackManager
 // Slots:
-//    maxTracks       <Number>   ! Maximum number of tracks (default: MAX_TRKS)
+//    maxTracks       <Number>   ! Maximum number of tracks (default: MAX_TRKS; no upper limit)
 //
 //    maxTrackAge     <Time>     ! Maximum track age (default: 3) ### NES: the comment in the src says 2 sec
 //    maxTrackAge     <Number>   ! Maximum track age (seconds)
@@ -32,6 +35,35 @@ class Track;
 //
 //    logTrackUpdates <Boolean>  ! True to log all updates to tracks (default: true)
 //
+//    association     <Identifier> ! Report to track association: target, nearestNeighbor or
+//                                 ! globalNearestNeighbor (default: target)
+//    associationGate <Distance>   ! Nearest neighbor association gate (default: 2 NM)
+//    associationGate <Number>     ! Nearest neighbor association gate (meters)
+//
+//    reportQueueSize <Number>     ! Size of the new report queue (default: MAX_TRKS)
+//
+// Report to track association (see TrackAssociator):
+//
+//    target                  Ground truth: reports match the tracks of the same
+//                            target (the original behavior)
+//    nearestNeighbor         Each report takes the nearest unmatched track
+//                            within the gate
+//    globalNearestNeighbor   One-to-one assignment that minimizes the total
+//                            squared distance (auction algorithm)
+//
+//    The nearest neighbor methods search only the tracks in the grid cells
+//    around each report, so the cost doesn't grow as tracks x reports.
+//
+// New reports:
+//
+//    The sensors' receive phase, from any number of threads, queues the new
+//    reports using newReport(), and processTrackList() drains them in
+//    batches (see getReports()).  The queue is a bounded, lock-free, multiple
+//    producer/single consumer queue (base::mpsc_queue), so the producers
+//    don't contend on a lock; reports are dropped when the queue is full.
+//    Use getReportQueueContentions() and getReportQueueFull() to size the
+//    queue (reportQueueSize); set its size before the simulation starts.
+//
 //------------------------------------------------------------------------------
 class TrackManager : public System
 {
@@ -45,6 +77,17 @@ public:
 
    virtual unsigned int getMaxTracks() const;
    virtual unsigned int getNumTracks() const;
+   virtual bool setMaxTracks(const unsigned int n);
+
+   TrackAssociator::Method getAssociation() const;
+   double getAssociationGate() const;
+   virtual bool setAssociation(const TrackAssociator::Method m);
+   virtual bool setAssociationGate(const double meters);
+
+   unsigned int getReportQueueSize() const;
+   unsigned long getReportQueueContentions() const;    // Producer retries
+   unsigned long getReportQueueFull() const;           // Reports dropped, queue full
+   virtual bool setReportQueueSize(const unsigned int n);
 
    virtual int getTrackList(base::safe_ptr<Track>* const slist, const unsigned int max) const;
    virtual int getTrackList(base::safe_ptr<const Track>* const slist, const unsigned int max) const;
@@ -79,12 +122,22 @@ public:
 protected:
    static const unsigned int MAX_TRKS = MIXR_CONFIG_MAX_TRACKS;         // Max tracks
    static const unsigned int MAX_REPORTS = MIXR_CONFIG_MAX_REPORTS;     // Max number of reports
+   static const unsigned int REPORT_BATCH = 64;                         // Reports drained per getReports()
+
+   // New report: an emission, or an IR query message (AngleOnlyTrackManager)
+   struct Report {
+      SensorMsg* msg;      // Report (ref()'d)
+      double sn;           // Signal to noise ratio (dB)
+   };
 
    unsigned int getNewTrackID()                             { return nextTrkId++; }
 
    virtual void processTrackList(const double dt) =0;                   // Derived class unique
 
    virtual Emission* getReport(double* const sn);                       // Get the next 'new' report from the queue
+   unsigned int getReports(Report* const list, const unsigned int max); // Get up to 'max' new reports from the queue
+   bool putReport(SensorMsg* const msg, const double sn);               // Queue a new report (any thread)
+   void clearReports();                                                 // Clear (unref()) the queued reports
    virtual bool setSlotMaxTracks(const base::Number* const num);       // Sets the maximum number of track files
    virtual bool setSlotMaxTrackAge(const base::Number* const num);     // Sets the maximum age of tracks
    virtual bool setSlotFirstTrackId(const base::Number* const num);    // Sets the first (starting) track id number
@@ -92,13 +145,58 @@ protected:
    virtual bool setSlotBeta(const base::Number* const num);            // Sets beta
    virtual bool setSlotGamma(const base::Number* const num);           // Sets gamma
    virtual bool setSlotLogTrackUpdates(const base::Number* const num); // Sets logTrackUpdates
+   virtual bool setSlotAssociation(const base::Identifier* const msg); // Sets the association method
+   virtual bool setSlotAssociationGate(const base::Number* const num); // Sets the association gate
+   virtual bool setSlotReportQueueSize(const base::Number* const num); // Sets the size of the new report queue
+
+   // Per-frame report buffers of processTrackList(); grown to at least 'n' reports
+   void reserveReports(const unsigned int n);
+
+   // Per-frame track buffers of processTrackList(); grown to at least 'n' tracks
+   void reserveTrackInputs(const unsigned int n);
+
+   // Track events (REID_NEW_TRACK, REID_TRACK_DATA or REID_TRACK_REMOVED) of
+   // processTrackList(): added, with the track list locked, by addTrackEvent(),
+   // which ref()'s the track; sent to the data recorder, and logged (MSG_INFO),
+   // by recordTrackEvents() after the track list is unlocked.  With 'clearType',
+   // the type of each removed track is cleared after it's recorded.
+   void addTrackEvent(const unsigned int event, Track* const trk, const unsigned int idx);
+   void recordTrackEvents(const Player* const ownship, const char* const kind, const bool clearType = false);
 
    // Track List
-   Track*       tracks[MAX_TRKS] {};   // Tracks
+   Track**      tracks {};             // Tracks
    unsigned int nTrks {};              // Number of tracks
    unsigned int maxTrks {MAX_TRKS};    // Max number of tracks (input)
    mutable long trkListLock {};        // Semaphore to protect the track list
 
+   // Report to track association
+   TrackAssociator associator;
+   TrackAssociator::Method association {TrackAssociator::TARGET};
+   double associationGate {2.0 * base::distance::NM2M};   // meters
+
+   // Per-frame report buffers (see reserveReports())
+   Emission**   rptEmissions {};       // Reports
+   double*      rptSignal {};          // Signal of each report
+   double*      rptRdot {};            // Range rate of each report
+   base::Vec3d* rptPos {};             // Target position of each report (relative to ownship)
+   unsigned int rptBufSize {};         // Size of the report buffers
+
+   // Per-frame track buffers (see reserveTrackInputs())
+   base::Vec3d* trkU {};               // Track input vectors
+   double*      trkAge {};             // Track ages
+   bool*        trkHaveU {};           // Track has an input vector
+   unsigned int trkBufSize {};         // Size of the track buffers
+
+   // Track events of this frame (see addTrackEvent())
+   struct TrackEvent {
+      unsigned int event;              // Recorder event ID
+      Track* trk;                      // Track (ref()'d)
+      unsigned int idx;                // Track list index
+   };
+   TrackEvent*  trkEvents {};          // Track events
+   unsigned int nTrkEvents {};         // Number of track events
+   unsigned int maxTrkEvents {};       // Size of the track event buffer
+
    // Prediction parameters
    void makeMatrixA(const double dt);
    double A[3][3] {};            // A Matrix
@@ -110,9 +208,10 @@ protected:
    unsigned int nextTrkId {1000};          // Next track ID
    unsigned int firstTrkId {1000};         // First (starting) track ID
 
-   base::safe_queue<Emission*> emQueue {MAX_TRKS}; // Emission input queue
-   base::safe_queue<double>    snQueue {MAX_TRKS}; // S/N input queue.
-   mutable long queueLock {};                      // Semaphore to protect both emQueue and snQueue
+   // New report queue: any number of producers (newReport()); the consumers
+   // (getReports() and clearReports()) are serialized by 'drainLock'
+   base::mpsc_queue<Report>* rptQueue {};
+   mutable long drainLock {};
 
    // System class Interface -- phase() callbacks
    virtual void process(const double dt) override;     // Phase 3
@@ -161,11 +260,6 @@ private:
    double posGate {2.0 * base::distance::NM2M};   // Position Gate (meters)
    double rngGate {500.0};   // Range Gate (meters)
    double velGate {10.0};    // Velocity Gate (m/s)
-
-   // Used by processTrackList()
-   bool** report2TrackMatch {};           // Report/Track matched matrix
-   unsigned int* reportNumMatches {};     // Number of matches for each report
-   unsigned int* trackNumMatches {};      // Number of matcher for each track
 };
 
 //------------------------------------------------------------------------------
@@ -186,11 +280,6 @@ protected:
 
 private:
    void initData();
-
-   // Used by processTrackList()
-   bool** report2TrackMatch {};                 // Report/Track matched matrix
-   unsigned int* reportNumMatches {};           // Number of matches for each report
-   unsigned int* trackNumMatches {};            // Number of matcher for each track
 };
 
 //------------------------------------------------------------------------------
@@ -211,11 +300,6 @@ protected:
 
 private:
    void initData();
-
-   // Used by processTrackList()
-   bool** report2TrackMatch {};                 // Report/Track matched matrix
-   unsigned int* reportNumMatches {};           // Number of matches for each report
-   unsigned int* trackNumMatches {};            // Number of matcher for each track
 };
 
 }
@@ -8,6 +8,7 @@ namespace mixr {
 namespace recorder {
 // Main (protocol buffer) data record
 namespace pb { class DataRecord; }
+class DataRecordPool;
 
 //------------------------------------------------------------------------------
 // Class: DataRecordHandle
@@ -17,7 +18,8 @@ namespace pb { class DataRecord; }
 // 
 //    1) This handle will 'own' the DataRecord ...
 //
-//    2) When this handle is destroyed, the DataRecord will be deleted.
+//    2) When this handle is destroyed, the DataRecord will be deleted, or
+//       returned to its DataRecordPool if the handle was created with one.
 //
 //    3) Using the assignment operator ( e.g., handle1 = handle2; ), the contents
 //       of handle2's DataRecord will be copied into handle1's DataRecord.
@@ -29,6 +31,7 @@ class DataRecordHandle : public base::Object
 
 public:
    DataRecordHandle(pb::DataRecord* const record);
+   DataRecordHandle(pb::DataRecord* const record, DataRecordPool* const pool);
 
    const pb::DataRecord* getRecord() const;
 
@@ -37,6 +40,7 @@ protected:
 
 private:
    pb::DataRecord* record {};
+   DataRecordPool* pool {};      // Pool that the record is returned to (optional)
 };
 
 inline const pb::DataRecord* DataRecordHandle::getRecord() const { return record; }
@@ -0,0 +1,51 @@
+
+#ifndef __mixr_recorder_DataRecordPool_H__
+#define __mixr_recorder_DataRecordPool_H__
+
+#include "mixr/base/Object.hpp"
+#include "mixr/base/safe_stack.hpp"
+
+namespace mixr {
+namespace recorder {
+namespace pb { class DataRecord; }
+
+//------------------------------------------------------------------------------
+// Class: DataRecordPool
+// Description: Pool of reusable DataRecords
+//
+//    get() returns an empty DataRecord from the pool, or a new one if the
+//    pool is empty.  put() clears a DataRecord and returns it to the pool,
+//    or deletes it if the pool is full.
+//
+//    Cleared DataRecords keep the memory of their sub-messages, so records
+//    that are reused for the same type of data (e.g., REID_PLAYER_DATA)
+//    don't allocate any memory.
+//
+// Notes:
+//    1) get() and put() can be called from any thread.
+//
+//    2) DataRecordHandles that are created with a pool return their
+//       DataRecord to the pool, and the pool is ref()'d by the handle, so
+//       the pool stays around until all of its records have been returned.
+//------------------------------------------------------------------------------
+class DataRecordPool : public base::Object
+{
+   DECLARE_SUBCLASS(DataRecordPool, base::Object)
+
+public:
+   static const unsigned int MAX_RECORDS = 8192;   // Max number of records kept in the pool
+
+public:
+   DataRecordPool();
+
+   pb::DataRecord* get();
+   void put(pb::DataRecord* const record);
+
+private:
+   base::safe_stack<pb::DataRecord*> records {MAX_RECORDS};   // Free records
+};
+
+}
+}
+
+#endif
@@ -12,6 +12,7 @@ namespace recorder {
 namespace pb { class DataRecord; class PlayerId; class PlayerState;
                class TrackData; class EmissionData; }
 class DataRecordHandle;
+class DataRecordPool;
 class OutputHandler;
 
 //------------------------------------------------------------------------------
@@ -25,6 +26,11 @@ class OutputHandler;
 // Notes:
 //    1) negative time values are used when time is unknown.
 //
+//    2) DataRecords are taken from a pool (see DataRecordPool) and returned
+//       to the pool after they've been processed by the output handler, so
+//       recording doesn't allocate memory once the pool has warmed up.  Use
+//       newDataRecord() to get a record for sendDataRecord().
+//
 //------------------------------------------------------------------------------
 // Recorder events handled ---
 //
@@ -95,6 +101,7 @@ protected:
    virtual void genPlayerState( pb::PlayerState* const state, const models::Player* const player );
    virtual void genTrackData( pb::TrackData* const trkMsg, const models::Track* const track );
    virtual void genEmissionData( pb::EmissionData* const emMsg, const models::Emission* const emData);
+   pb::DataRecord* newDataRecord();                              // Empty DataRecord (from our pool)
    virtual void sendDataRecord(pb::DataRecord* const msg);       // Send the DataRecord to our output handler
    virtual void timeStamp(pb::DataRecord* const msg);            // Time stamp the DataRecord
    virtual std::string genTrackId(const models::Track* const track);
@@ -135,6 +142,7 @@ private:
    void initData();
 
    OutputHandler* outputHandler {};          // Our output handler
+   DataRecordPool* pool {};                  // Pool of DataRecords
    bool firstPass {true};
 
    std::string eventName;
@@ -5,7 +5,7 @@
 #include "mixr/recorder/InputHandler.hpp"
 
 namespace mixr {
-namespace base { class String; }
+namespace base { class Identifier; class String; }
 namespace recorder {
 
 //------------------------------------------------------------------------------
@@ -16,12 +16,17 @@ namespace recorder {
 // Slots:
 //     filename       <String>     ! Data file name (required)
 //     pathname       <String>     ! Path to the data file's directory (optional)
+//     framing        <Identifier> ! Record framing: ascii or varint (default: ascii)
 //
 // Notes
 //    1) The data file consists of a sequence of serialized data records
-//    that are preceded by 4 bytes that provided the size of each data record
-//    in bytes.  The 4 bytes are stored as an ascii string with leading spaces
-//    (e.g., " 123")
+//    that are preceded by the size of each data record in bytes.  With
+//    'ascii' framing, the size is stored in 4 bytes as an ascii string with
+//    leading spaces (e.g., " 123").  With 'varint' framing, the size is
+//    stored as a protocol buffer base 128 varint.  (see FileWriter)
+//
+//    2) The input buffer starts at MAX_INPUT_BUFFER_SIZE bytes and grows
+//    as needed for larger records.
 //------------------------------------------------------------------------------
 class FileReader : public InputHandler
 {
@@ -39,17 +44,27 @@ public:
    virtual bool openFile();         // Open the data file
    virtual void closeFile();        // Close the data file
 
+   bool isVarintFraming() const     { return varintFraming; }   // Varint (or ascii) record framing
+
    // File and path names; set before calling openFile()
    virtual bool setFilename(const base::String* const msg);
    virtual bool setPathName(const base::String* const msg);
 
+   // Framing; set before calling openFile()
+   bool setVarintFraming(const bool flg);
+
 protected:
+   virtual bool setSlotFraming(const base::Identifier* const msg);
+
    virtual const DataRecordHandle* readRecordImp() override;
 
 private:
    void initData();
+   bool readSize(unsigned int* const n);
 
    char* ibuf {};                    // Input data buffer
+   unsigned int ibufSize {};         // Size of the input data buffer (bytes)
+   bool varintFraming {};            // Varint (or ascii) record framing
 
    std::ifstream* sin {};            // Input stream
    const base::String* filename {};  // File name
@@ -5,7 +5,7 @@
 #include "mixr/recorder/OutputHandler.hpp"
 
 namespace mixr {
-namespace base { class String; }
+namespace base { class Identifier; class Number; class String; }
 namespace recorder {
 
 //------------------------------------------------------------------------------
@@ -17,20 +17,33 @@ namespace recorder {
 // Slots:
 //     filename       <String>     ! Data file name
 //     pathname       <String>     ! Path to the data file's directory (optional)
+//     framing        <Identifier> ! Record framing: ascii or varint (default: ascii)
+//     bufferSize     <Number>     ! Output buffer size in bytes (default: 1048576)
 //
 // Note:
 //    1) The data file consists of a sequence of serialized data records
-//    that are preceded by 4 bytes that provided the size of each data record
-//    in bytes.  The 4 bytes are stored as an ascii string with leading spaces
-//    (e.g., " 123")
+//    that are preceded by the size of each data record in bytes.  With
+//    'ascii' framing, the size is stored in 4 bytes as an ascii string with
+//    leading spaces (e.g., " 123"), which limits the records to 9999 bytes.
+//    With 'varint' framing, the size is stored as a protocol buffer base 128
+//    varint (i.e., protocol buffer's delimited format), which has no limit.
+//    The FileReader must use the same framing.
 //
-//    2) During open(), if the file already exists then a version number is appended
+//    2) The records are serialized directly into the output buffer, which
+//    is written to the file when it's full and after each batch of queued
+//    records (see OutputHandler::flushOutput()).  Records that are larger
+//    than the buffer are serialized separately and written along with the
+//    buffer using a single writev().
+//
+//    3) During open(), if the file already exists then a version number is appended
 //    to the end of the file name.  (e.g., filename_v01 to filename_v99)
+//    The replicates of a simulation::Ensemble each write to their own file,
+//    with their replicate ID appended to the file name (e.g., filename_r0001).
 //
-//    3) If the file hasn't been manually opened with openFile(), the file will
+//    4) If the file hasn't been manually opened with openFile(), the file will
 //    be automatically open with the first data message.
 //
-//    4) File will be closed with an end of data (REID_END_OF_DATA) message.
+//    5) File will be closed with an end of data (REID_END_OF_DATA) message.
 //    Calling openFile() or sending any additional data messages will open
 //    a new file with a new version number.
 //------------------------------------------------------------------------------
@@ -53,19 +66,42 @@ public:
    const char* getFullFilename() const;   // File name with path and possible version number
                                           // (valid only while file is open)
 
+   bool isVarintFraming() const           { return varintFraming; }   // Varint (or ascii) record framing
+   unsigned int getBufferSize() const     { return obufSize; }        // Output buffer size (bytes)
+
    // File and path names; set before calling openFile()
    virtual bool setFilename(const base::String* const msg);
    virtual bool setPathName(const base::String* const msg);
 
+   // Framing and buffer size; set before calling openFile()
+   bool setVarintFraming(const bool flg);
+   bool setBufferSize(const unsigned int n);
+
 protected:
    void setFullFilename(const char* const name);
 
+   virtual bool setSlotFraming(const base::Identifier* const msg);
+   virtual bool setSlotBufferSize(const base::Number* const msg);
+
    virtual void processRecordImp(const DataRecordHandle* const handle) override;
+   virtual void flushOutput() override;
 
    virtual bool shutdownNotification() override;
 
 private:
-   std::ofstream* sout {};            // Output stream
+   static const unsigned int DEFAULT_BUFFER_SIZE = 1048576;
+   static const unsigned int MIN_BUFFER_SIZE = 4096;
+
+   bool writeData(const char* const p1, const unsigned int n1, const char* const p2, const unsigned int n2);
+
+   int fd {-1};                       // Output file descriptor
+
+   char* obuf {};                     // Output buffer
+   unsigned int obufSize {DEFAULT_BUFFER_SIZE};   // Output buffer size (bytes)
+   unsigned int obufLen {};           // Number of bytes in the output buffer
+   char* rbuf {};                     // Serialization buffer for records larger than 'obuf'
+   unsigned int rbufSize {};          // Size of 'rbuf' (bytes)
+   bool varintFraming {};             // Varint (or ascii) record framing
 
    char* fullFilename {};             // Full file name of the output file
    const base::String* filename {};   // Output file name
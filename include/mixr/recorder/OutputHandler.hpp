@@ -4,9 +4,14 @@
 
 #include "mixr/simulation/AbstractRecorderComponent.hpp"
 #include "mixr/base/List.hpp"
+#include "mixr/base/mpsc_queue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 namespace mixr {
-namespace base { class List; }
+namespace base { class List; class Number; class Thread; }
 namespace recorder {
 class DataRecordHandle;
 
@@ -27,7 +32,29 @@ class DataRecordHandle;
 //    of subcomponent OutputHandlers.  The prcessRecord() function for each
 //    subcomponent OutputHandler is called from our processRecord() function.
 //
+//    4) By default, the queue is unbounded and protected by a semaphore.
+//    With the 'queueSize' slot, the queue is a bounded, lock-free ring
+//    buffer and addToQueue() never blocks: when the queue is full the
+//    record is dropped and counted (see getNumDropped()).
+//
+//    5) With the 'writerThread' slot, the queue is processed by our own
+//    writer thread, which is started by the first call to processQueue();
+//    after that, processQueue() just wakes up the writer thread, which
+//    sleeps while there's nothing to write.  A bounded queue also wakes up
+//    the writer thread when it's half full.  The writer thread is stopped,
+//    and the rest of the queue is processed, at shutdown.
+//
+//    6) flushOutput() is called after each batch of queued records has been
+//    processed, so derived classes can buffer their output.
+//
 // Factory name: OutputHandler
+// Slots:
+//    queueSize       <Number>  ! Max number of queued records, or zero for an
+//                              ! unbounded queue (default: 0)
+//    writerThread    <Boolean> ! Process the queue with our own writer thread
+//                              ! (default: false)
+//    writerPriority  <Number>  ! Writer thread priority [ 0.0 ... 1.0 ]
+//                              ! (default: 0.0 -- normal, non real-time)
 //
 // Overriding the Component class slot:
 //    components     ! Must contain only 'OutputHandler' type objects
@@ -49,13 +76,39 @@ public:
    // Process all data records from the queue
    void processQueue();
 
+   // Queue statistics
+   unsigned int getQueueDepth() const;          // Number of records in the queue
+   unsigned int getMaxQueueDepth() const;       // Max number of records found in the queue
+   unsigned int getNumQueued() const;           // Total number of records queued
+   unsigned int getNumDropped() const;          // Number of records dropped (queue was full)
+
+   unsigned int getQueueSize() const            { return queueSize; }
+   bool isWriterThreadEnabled() const           { return writerEnabled; }
+
+   bool setQueueSize(const unsigned int n);     // Set before queueing any records
+   bool setWriterThreadEnabled(const bool flg); // Set before the first processQueue()
+
+   // Writer thread's main loop (called by the writer thread)
+   void writerLoop();
+
 protected:
    // Process record implementations by derived classes
    virtual void processRecordImp(const DataRecordHandle* const handle);
 
+   // Write any buffered output; called after each batch of queued records
+   virtual void flushOutput();
+
+   // Stops the writer thread, if any, and processes the rest of the queue
+   void stopWriterThread();
+
    // Checks the data enabled list and returns true if the record should be processed.
    bool isDataTypeEnabled(const DataRecordHandle* const handle) const;
 
+   // Slot functions
+   virtual bool setSlotQueueSize(const base::Number* const msg);
+   virtual bool setSlotWriterThread(const base::Number* const msg);
+   virtual bool setSlotWriterPriority(const base::Number* const msg);
+
    virtual void processComponents(
       base::PairStream* const list,             // Source list of components
       const std::type_info& filter,             // Type filter
@@ -66,8 +119,28 @@ protected:
    virtual bool shutdownNotification() override;
 
 private:
-   base::List queue;            // Data Record Queue
+   const DataRecordHandle* getFromQueue();
+   unsigned int drainQueue();
+   void clearQueue();
+   void wakeWriter();
+
+   base::List queue;            // Data Record Queue (unbounded)
    mutable long semaphore {};
+
+   base::mpsc_queue<const DataRecordHandle*>* ring {};   // Data Record Queue (bounded)
+   unsigned int queueSize {};                            // Size of the bounded queue, or zero
+
+   base::Thread* writer {};               // Writer thread
+   std::atomic<bool> stopWriter {};       // Writer thread stop request
+   std::mutex wakeMutex;                  // Writer thread wake up ...
+   std::condition_variable wakeCond;      //  ... condition
+   bool wakeFlg {};                       //  ... and request (wakeMutex)
+   double writerPriority {};              // Writer thread priority
+   bool writerEnabled {};                 // Writer thread is enabled
+
+   std::atomic<unsigned int> numQueued {};   // Total number of records queued
+   std::atomic<unsigned int> numDropped {};  // Number of records dropped
+   std::atomic<unsigned int> maxDepth {};    // Max queue depth
 };
 
 }
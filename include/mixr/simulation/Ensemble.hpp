@@ -0,0 +1,140 @@
+
+#ifndef __mixr_simulation_Ensemble_H__
+#define __mixr_simulation_Ensemble_H__
+
+#include "mixr/base/Component.hpp"
+
+#include <atomic>
+
+namespace mixr {
+namespace base { class Number; class Time; }
+namespace simulation {
+class Station;
+
+//------------------------------------------------------------------------------
+// Class: Ensemble
+//
+// Description: Monte-Carlo ensemble runner -- runs replicates of one station,
+//              which is parsed (and its data loaded) only once, concurrently
+//              on a pool of threads.
+//
+// Factory name: Ensemble
+// Slots --
+//    station        <Station>              ! Prototype station (default: nullptr)
+//    numReplicates  <base::Number>         ! Number of replicates (default: 1)
+//    numThreads     <base::Number>         ! Number of replicates to run at the same time
+//                                          ! (default: 0 -- number of processors)
+//    seed           <base::Number>         ! Base random number seed; replicate 'i' is
+//                                          ! seeded with 'seed' + 'i' (default: 0)
+//    runTime        <base::Time>           ! Simulated time of each replicate
+//                                          ! (default: 0 -- use the station's 'batchRunTime')
+//
+//
+// Running the replicates:
+//
+//    The main application calls run(), which returns when all of the replicates
+//    have completed.  run() first resets the prototype station (RESET_EVENT)
+//    to load its data (e.g., terrain), and then each replicate, 'i' = 1 .. N,
+//
+//       a: is a clone() of the prototype station (clones are made one at a time);
+//
+//       b: is given its replicate ID, 'i', and seed, 'seed' + 'i' (see
+//          Simulation::setReplicateID() and Simulation::setSeed());
+//
+//       c: is reset and run in the station's batch mode (see Station::runBatch());
+//
+//       d: is passed to replicateCompleted(), which derived classes can use to
+//          collect the results, and then it's shut down and deleted.
+//
+//    The replicates are handed out to the threads one at a time, and the main
+//    application's thread runs replicates as well.
+//
+//
+// Shared data:
+//
+//    The clones share the prototype's large, read-only data, rather than copying
+//    it: terrain elevation data (see terrain::DataFile) and the data and
+//    breakpoint arrays of the function tables (see base::Table).  Each replicate
+//    has its own recorder output file (see recorder::FileWriter).
+//
+//
+// Notes:
+//    1) replicateCompleted() is called from the replicate's thread, so it must
+//       be thread safe.
+//
+//    2) The number of completed replicates, the total simulated time, and the
+//       wall clock time and speed (simulated seconds per wall clock second) of
+//       the last run are returned by getNumCompleted(), getSimTime(),
+//       getWallTime() and getSpeed().
+//------------------------------------------------------------------------------
+class Ensemble : public base::Component
+{
+   DECLARE_SUBCLASS(Ensemble, base::Component)
+
+public:
+   static const unsigned int MAX_THREADS = 64;
+
+public:
+   Ensemble();
+
+   Station* getStation();                                   // Prototype station
+   const Station* getStation() const;                       // Prototype station (const version)
+
+   unsigned int getNumReplicates() const;                   // Number of replicates
+   unsigned int getNumThreads() const;                      // Number of replicates run at the same time
+   unsigned int getSeed() const;                            // Base random number seed
+   double getRunTime() const;                               // Simulated time of each replicate (seconds; zero to use the station's)
+
+   virtual bool setStation(Station* const p);
+   virtual bool setNumReplicates(const unsigned int n);
+   virtual bool setNumThreads(const unsigned int n);        // (zero for the number of processors)
+   virtual bool setSeed(const unsigned int s);
+   virtual bool setRunTime(const double secs);
+
+   // Runs the replicates; returns when they've all completed
+   virtual bool run();
+   bool isRunning() const;                                  // Is run() running?
+
+   // Results of the last run
+   unsigned int getNumCompleted() const;                    // Number of completed replicates
+   double getSimTime() const;                               // Total simulated time of the replicates (seconds)
+   double getWallTime() const;                              // Wall clock time (seconds)
+   double getSpeed() const;                                 // Simulated seconds per wall clock second
+
+   // Runs replicates until there are none left (called by our threads)
+   void runReplicates();
+
+protected:
+   // Called, from the replicate's thread, when replicate 'id' has completed
+   virtual void replicateCompleted(const unsigned int id, Station* const sta);
+
+   bool setSlotNumReplicates(const base::Number* const msg);
+   bool setSlotNumThreads(const base::Number* const msg);
+   bool setSlotSeed(const base::Number* const msg);
+   bool setSlotRunTime(const base::Time* const msg);
+
+   virtual bool shutdownNotification() override;
+
+private:
+   unsigned int claimReplicate();                // Next replicate ID, or zero if there are none left
+   bool runReplicate(const unsigned int id);     // Clones and runs replicate 'id'
+
+   Station* station {};                  // Prototype station
+   unsigned int numReplicates {1};       // Number of replicates
+   unsigned int numThreads {};           // Number of replicates run at the same time (zero for # processors)
+   unsigned int seed {};                 // Base random number seed
+   double runTime {};                    // Simulated time of each replicate (seconds)
+
+   bool running {};                      // run() is running
+   std::atomic<unsigned int> nextReplicate {};   // Last replicate ID handed out
+   mutable long semaphore {};            // Protects the clone() calls and results
+
+   unsigned int numCompleted {};         // Number of completed replicates
+   double simTime {};                    // Total simulated time (seconds)
+   double wallTime {};                   // Wall clock time (seconds)
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,70 @@
+
+#ifndef __mixr_simulation_PlayerList_H__
+#define __mixr_simulation_PlayerList_H__
+
+#include "mixr/base/PairStream.hpp"
+
+namespace mixr {
+namespace simulation {
+class AbstractPlayer;
+
+//------------------------------------------------------------------------------
+// Class: PlayerList
+//
+// Description: Simulation's active player list; a PairStream of players
+//              (name, AbstractPlayer) with an immutable hash index for
+//              finding players by ID, by ID and network ID, and by name.
+//
+//    The index is built by buildIndex() after the list has been filled and
+//    before the list is published (see Simulation::updatePlayerList()).  The
+//    list must not be modified after that, so the find functions can be used
+//    by any thread without locking.  If the list was modified after the
+//    index was built then the find functions fall back to scanning the list.
+//
+//    As with a scan of the list, the find functions return the first
+//    matching player in list order.
+//
+// Factory name: PlayerList
+//------------------------------------------------------------------------------
+class PlayerList : public base::PairStream
+{
+   DECLARE_SUBCLASS(PlayerList, base::PairStream)
+
+public:
+   PlayerList();
+
+   // Builds the index of the players currently on the list
+   void buildIndex();
+
+   // True if the index is valid for the current list
+   bool isIndexValid() const                      { return (players != nullptr && numPlayers == entries()); }
+
+   // Find a player by player ID, or by player and network IDs if 'netID' is greater than zero
+   AbstractPlayer* findPlayer(const short id, const int netID = 0) const;
+
+   // Find a player by name
+   AbstractPlayer* findPlayerByName(const char* const playerName) const;
+
+private:
+   static unsigned int hashId(const unsigned int id, const unsigned int netID);
+   static unsigned int hashName(const char* const name);
+
+   void clearIndex();
+   AbstractPlayer* scanPlayer(const short id, const int netID) const;
+   AbstractPlayer* scanPlayerByName(const char* const playerName) const;
+
+   AbstractPlayer** players {};   // Players in list order
+   unsigned int numPlayers {};    // Number of players in the index
+
+   // Open addressing hash tables (linear probing) of indices into 'players',
+   // or -1 for an empty slot; 'mask' is the table size minus one.
+   int* idTable {};               // Keyed by player ID
+   int* idNetTable {};            // Keyed by player and network IDs
+   int* nameTable {};             // Keyed by player name
+   unsigned int mask {};
+};
+
+}
+}
+
+#endif
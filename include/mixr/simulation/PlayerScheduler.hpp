@@ -0,0 +1,96 @@
+
+#ifndef __mixr_simulation_PlayerScheduler_H__
+#define __mixr_simulation_PlayerScheduler_H__
+
+#include "mixr/base/safe_ptr.hpp"
+
+#include <atomic>
+
+namespace mixr {
+namespace base { class PairStream; }
+namespace simulation {
+class AbstractPlayer;
+
+//------------------------------------------------------------------------------
+// Class: PlayerScheduler
+//
+// Description: Work-stealing scheduler used by the Simulation's T/C and
+//              background thread pools to traverse the player list.
+//
+//    build(list)
+//       Copies the players of 'list' into a contiguous array; called once
+//       for each new player list (i.e., after updatePlayerList() swaps lists).
+//       The player list is ref()'d until the next build() or clear().
+//
+//    plan(n)
+//       Splits the player array into cost-weighted chunks and assigns a
+//       contiguous range of chunks to each of the 'n' threads.  A player's
+//       cost is the mean of its tcFrame() timing statistics (see the
+//       Component slot 'enableTimingStats'); players without statistics
+//       use the mean cost of the players that have them, or one.
+//
+//    restart()
+//       Makes all chunks available again; called before each pass over
+//       the player list (e.g., once per phase).
+//
+//    nextChunk(idx, first, last)
+//       Returns the next chunk, players [first .. last), for thread 'idx'
+//       [ 0 .. n-1 ].  Threads take chunks from their own range first and
+//       then steal from the other threads' ranges; returns false when all
+//       chunks have been taken.
+//------------------------------------------------------------------------------
+class PlayerScheduler
+{
+public:
+   static const unsigned int MAX_THREADS = 32;        // Max number of threads
+   static const unsigned int CHUNKS_PER_THREAD = 8;   // Target number of chunks per thread
+
+public:
+   PlayerScheduler();
+   PlayerScheduler(const PlayerScheduler&) = delete;
+   PlayerScheduler& operator=(const PlayerScheduler&) = delete;
+   ~PlayerScheduler();
+
+   bool isBuiltFor(const base::PairStream* const list) const    { return (list != nullptr && playerList == list); }
+   unsigned int getNumPlayers() const                           { return numPlayers; }
+   unsigned int getNumThreads() const                           { return numThreads; }
+   AbstractPlayer* getPlayer(const unsigned int i) const        { return (i < numPlayers ? players[i] : nullptr); }
+
+   void build(base::PairStream* const list);
+   void plan(const unsigned int n);
+   void restart();
+   bool nextChunk(const unsigned int idx, unsigned int* const first, unsigned int* const last);
+   void clear();
+
+private:
+   // Chunk range owned by a thread (aligned to a cache line to keep the
+   // threads' counters apart)
+   struct alignas(64) Range {
+      std::atomic<unsigned int> next {};     // Next chunk to take
+      unsigned int begin {};                 // First chunk
+      unsigned int end {};                   // One past the last chunk
+   };
+
+   bool takeChunk(Range& r, unsigned int* const first, unsigned int* const last);
+   void resize(const unsigned int n);
+
+   base::safe_ptr<base::PairStream> playerList;  // Player list used to build the array
+   AbstractPlayer** players {};                  // Contiguous player array
+   double* costs {};                             // Player costs
+   unsigned int* chunkEnd {};                    // Chunk boundaries; chunk 'c' is [ chunkEnd[c-1] .. chunkEnd[c] )
+   unsigned int capacity {};                     // Size of the arrays
+   unsigned int numPlayers {};                   // Number of players in the array
+   unsigned int numChunks {};                    // Number of chunks
+   unsigned int numThreads {};                   // Number of threads
+
+   // Per thread chunk ranges; they're in their own cache line aligned block,
+   // because 'new' doesn't honor extended alignments before C++17, and our
+   // owner (e.g., Simulation) is allocated with 'new'
+   char* rangeBlock {};                          // Memory block of the ranges
+   Range* ranges {};                             // Per thread chunk ranges [ MAX_THREADS ]
+};
+
+}
+}
+
+#endif
@@ -5,7 +5,9 @@
 #include "mixr/base/Component.hpp"
 #include "mixr/base/safe_queue.hpp"
 #include "mixr/base/osg/Matrixd"
+#include "mixr/simulation/PlayerScheduler.hpp"
 #include <array>
+#include <random>
 
 namespace mixr {
 namespace base { class Distance; class EarthModel; class LatLon; class Pair; class Time; }
@@ -50,6 +52,14 @@ class AbstractPlayer;
 //                                            !   default: 1 -- no additional threads)
 //                                            !   range: [ 1 .. (#CPUs-1) ]; minimum of one
 //
+//    workStealing   <base::Number>           ! Use the cost-weighted, work-stealing player scheduler with
+//                                            ! multiple T/C and background threads (default: false)
+//
+//    seed           <base::Number>           ! Random number generator seed (default: 0)
+//
+//    updatePlans    <base::Number>           ! Update each player's component tree using its flattened
+//                                            ! update plan (see Component::getUpdatePlan()) (default: false)
+//
 //
 // The player list
 //
@@ -70,14 +80,18 @@ class AbstractPlayer;
 //
 //    e) The Player list is sorted by networdID (zero being local) and then by
 //       player ID, therefore all local players are located at the beginning of
-//       the list.
+//       the list.  Players that are added or removed in the same background
+//       frame are handled as one batch: the new players are sorted and merged
+//       into the already sorted list (see mergePlayers()).
 //
 //    f) To ensure a stable player list throughout the time-critical and background
 //       frames, the player list is ref() before and unref() after the player list
 //       is traversed in both the updateTC() and updateData() functions.
 //
 //    g) You can find players on the list by Player ID [plus Net ID], findPlayer(),
-//       or by name using findPlayerByName().
+//       or by name using findPlayerByName().  The player list is a PlayerList
+//       (see PlayerList.hpp), which is indexed by ID, network ID and name
+//       before it's swapped in, so these lookups don't scan the list.
 //
 //
 // Cycles, frames and phases:
@@ -108,6 +122,21 @@ class AbstractPlayer;
 //    complexity of the players and the speed of your computer system, so you
 //    may need to do a little experimenting on your system.
 //
+//    By default, each thread walks the whole player list and processes every
+//    n'th player.  With the 'workStealing' slot set, a contiguous player array
+//    is built once for each new player list, and the players are handed out to
+//    the threads as cost-weighted chunks (see PlayerScheduler.hpp).  A thread
+//    that finishes its own chunks steals chunks from the other threads, so a
+//    phase finishes when the total work is done.  Player costs are taken from
+//    each player's timing statistics (see Component's 'enableTimingStats' slot),
+//    and the chunks are re-weighted once per cycle.
+//
+//    With the 'updatePlans' slot set, each player is updated by running its
+//    update plan, which is rebuilt only when components are added, removed or
+//    selected in its tree, so that its subsystems, their gimbals, antennas,
+//    etc., are updated from a flat array, and not by fetching ref()'d component
+//    lists at each level of its tree (see UpdatePlan.hpp).
+//
 //    These threads will be very CPU bound, so having more threads than CPUs is
 //    very ineffective.  And to be nice, ...
 //
@@ -153,6 +182,20 @@ class AbstractPlayer;
 //       c) To uniquely set player IDs for newly released weapons, use getNewReleasedWeaponID()
 //
 //
+// Random numbers and ensemble replicates:
+//
+//    1) getRandomGenerator() returns the simulation's random number generator
+//       (std::mt19937), which is re-seeded with getSeed() by reset(), so runs
+//       with the same seed repeat.  The generator is not thread safe: use it
+//       from one thread, or seed a model's own generator from getSeed() and
+//       its player ID.
+//
+//    2) Each replicate of an ensemble run (see Ensemble) is given its own seed
+//       and its replicate ID [ 1 .. N ], getReplicateID(), which is zero if
+//       we're not a replicate (e.g., the data recorder's file writer uses it
+//       to give each replicate its own output file).
+//
+//
 // Shutdown:
 //
 //    At shutdown, the parent object must send a SHUTDOWN_EVENT event to
@@ -213,6 +256,13 @@ public:
 
     virtual bool setInitialSimulationTime(const long time);    // Sets the initial simulated time (sec; or less than zero to slave to UTC)
 
+    // Random numbers and ensemble replicates
+    unsigned int getSeed() const;                  // Random number generator seed
+    virtual bool setSeed(const unsigned int s);    // Sets the seed (used by the next reset())
+    std::mt19937& getRandomGenerator();            // Random number generator (not thread safe)
+    unsigned int getReplicateID() const;           // Ensemble replicate ID [ 1 .. N ], or zero if we're not a replicate
+    virtual bool setReplicateID(const unsigned int id);
+
     virtual void updateTC(const double dt = 0.0) override;
     virtual void updateData(const double dt = 0.0) override;
     virtual void reset() override;
@@ -250,7 +300,8 @@ protected:
 private:
    Station* getStationImp();
 
-   bool insertPlayerSort(base::Pair* const newPlayer, base::PairStream* const newList);
+   static bool isPlayerBefore(const base::Pair* const a, const base::Pair* const b);
+   void mergePlayers(base::Pair** const oldPairs, const unsigned int n, base::Pair** const newPairs, const unsigned int k, base::PairStream* const newList);
    AbstractPlayer* findPlayerPrivate(const short id, const int netID) const;
    AbstractPlayer* findPlayerByNamePrivate(const char* const playerName) const;
 
@@ -263,6 +314,12 @@ private:
 
    bool setSlotNumTcThreads(const base::Number* const msg);
    bool setSlotNumBgThreads(const base::Number* const msg);
+   bool setSlotWorkStealing(const base::Number* const msg);
+   bool setSlotSeed(const base::Number* const msg);
+   bool setSlotUpdatePlans(const base::Number* const msg);
+
+   void tcFramePlayer(AbstractPlayer* const player, const double dt);
+   void updateDataPlayer(AbstractPlayer* const player, const double dt);
 
    base::safe_ptr<base::PairStream> players;     // Main player list (sorted by network and player IDs)
    base::safe_ptr<base::PairStream> origPlayers; // Original player list
@@ -308,6 +365,18 @@ private:
    unsigned int reqBgThreads {1};                          // Requested number of threads
    unsigned int numBgThreads {};                           // Number of threads in pool; should be (reqBgThreads - 1)
    bool bgThreadsFailed {};                                // Failed to create threads.
+
+   // Work-stealing player schedulers
+   bool workStealing {};                                   // Use the work-stealing schedulers
+   PlayerScheduler tcScheduler;                            // T/C thread pool scheduler
+   PlayerScheduler bgScheduler;                            // Background thread pool scheduler
+
+   bool updatePlans {};                                    // Update the players using their update plans
+
+   // Random numbers and ensemble replicates
+   unsigned int seed {};                                   // Random number generator seed
+   std::mt19937 rng;                                       // Random number generator
+   unsigned int replicateID {};                            // Ensemble replicate ID (zero if not a replicate)
 };
 
 }
@@ -3,9 +3,12 @@
 #define __mixr_simulation_Station_H__
 
 #include "mixr/base/Component.hpp"
+#include "mixr/base/concurrent/PeriodicTask.hpp"
+
+#include <atomic>
 
 namespace mixr {
-namespace base { class IoHandler; class Number; class Thread; class Time; }
+namespace base { class Identifier; class IoHandler; class Number; class Thread; class Time; }
 namespace simulation {
 class AbstractDataRecorder;
 class Simulation;
@@ -37,6 +40,10 @@ class AbstractOtw;
 //    tcRate             <base::Number>         ! Time-critical thread rate (Hz) (default: 50hz)
 //    tcPriority         <base::Number>         ! Time-critical thread priority  (default: DEFAULT_TC_THREAD_PRI)
 //    tcStackSize        <base::Number>         ! Time-critical thread stack size (default: <system default size>)
+//    tcOverrunPolicy    <base::Identifier>     ! Time-critical thread overrun policy: catchUp, skipFrames or realDt
+//                                              ! (default: catchUp) (see base::PeriodicTask)
+//    tcBusyWait         <base::Time>           ! Time-critical thread busy wait time before the start of each frame
+//                                              ! (default: 0 -- no busy wait) (see base::PeriodicTask)
 //
 //    fastForwardRate    <base::Number>         ! Fast forward rate for time critical functions
 //                                              ! (i.e., the number of times updateTC() is called per frame).
@@ -57,6 +64,14 @@ class AbstractOtw;
 //
 //    dataRecorder       <AbstractDataRecorder> ! Our Data Recorder
 //
+//    batchMode          <base::Boolean>        ! Batch (as-fast-as-possible) mode; no threads are created
+//                                              ! and runBatch() steps the station (default: false)
+//    batchRunTime       <base::Time>           ! Batch mode simulated time of each run (default: 0 -- no time limit)
+//
+//    trace              <base::Boolean>        ! Enable the tracing profiler (see base::Tracer) (default: false)
+//    traceFile          <base::String>         ! Trace file written by dumpTrace() and at shutdown (default: nullptr)
+//    traceOverrunFile   <base::String>         ! Trace file written when a frame overruns (default: nullptr)
+//
 //
 // Ownship player:
 //
@@ -131,6 +146,56 @@ class AbstractOtw;
 //       manager (see graphics::GlutDisplay) and therefore from the
 //       display manager's thread.
 //
+//    7) The frame statistics (frame time histogram, overrun and skipped
+//       frame counts, and start of frame latency) of our time-critical,
+//       network and background threads are returned by the functions
+//       getTimeCriticalFrameStats(), getNetworkFrameStats() and
+//       getBackgroundFrameStats(), respectively.
+//
+//
+// Batch mode:
+//
+//    With 'batchMode' enabled, the main application calls runBatch() instead
+//    of creating the threads and calling updateData().  runBatch() steps the
+//    station in a lock-step loop, as fast as possible and without sleeping,
+//    using the fixed delta time of 'tcRate':
+//
+//       a: every frame, the time-critical tasks (one tcFrame() call; the
+//          'fastForwardRate' is not used);
+//
+//       b: every 'tcRate'/'bgRate' frames (or every frame if 'bgRate' is zero),
+//          the background tasks, the station's updateData() components and the
+//          data recorder's processRecords();
+//
+//       c: every 'tcRate'/'netRate' frames (or every frame if 'netRate' is
+//          zero), the network input tasks (start of the frame) and output tasks
+//          (end of the frame).
+//
+//    Simulated time (getExecTimeSec(), getSimTimeOfDay(), etc.) advances by the
+//    delta times and is not tied to the wall clock; to repeat a run exactly, set
+//    the simulation's initial time and date (e.g., 'simulationTime').
+//
+//    The run ends at the first frame where isBatchRunComplete() is true; by
+//    default, when the run's simulated time reaches 'batchRunTime', when stopBatch()
+//    has been called (from any thread, e.g., by a model on an event), or when
+//    we're shutdown.  Derived classes can override isBatchRunComplete() for
+//    their own end conditions.  The number of frames, the simulated and wall
+//    clock times, and the speed (simulated seconds per wall clock second) of
+//    the last run are returned by getBatchFrames(), getBatchSimTime(),
+//    getBatchWallTime() and getBatchSpeed().
+//
+//
+// Tracing:
+//
+//    With the 'trace' slot set, the tracing profiler (see Tracer.hpp) records
+//    the zones of our thread loops, the simulation's phases, each player's
+//    tcFrame() and updateData(), the networks' input and output frames, and
+//    the models' zones (e.g., gimbals, antennas and track managers), which are
+//    written as a Chrome trace file to 'traceFile' by dumpTrace() and at
+//    shutdown.  When a thread's frame overruns, the trace is written to
+//    'traceOverrunFile' by the background task (i.e., the trace of the last
+//    overrun).
+//
 //
 // Shutdown:
 //
@@ -200,11 +265,20 @@ public:
    unsigned int getTimeCriticalStackSize() const;            // Time-critical thread stack size
    bool setTimeCriticalStackSize(const unsigned int bytes);  // Set Time-critical thread stack size  (bytes or zero for default)
 
+   // Time-critical thread overrun policy and busy wait time (seconds) (set before creating the thread)
+   base::PeriodicTask::OverrunPolicy getTimeCriticalOverrunPolicy() const;
+   bool setTimeCriticalOverrunPolicy(const base::PeriodicTask::OverrunPolicy p);
+   double getTimeCriticalBusyWait() const;
+   bool setTimeCriticalBusyWait(const double secs);
+
    // Optionally called by the main application  to create a thread
    // that will call 'updateTC()' at 'getTimeCriticalRate()' Hz
    virtual void createTimeCriticalProcess();
    bool doWeHaveTheTcThread() const;                         // Do we have a T/C thread?
 
+   // Time-critical thread frame statistics; returns false if we don't have the thread
+   bool getTimeCriticalFrameStats(base::PeriodicTask::FrameStats* const stats) const;
+
    // Fast forward rates used by processTimeCriticalTasks().
    //   (i.e., number of times Station::tcFrame() is called per frame)
    unsigned int getFastForwardRate() const { return fastForwardRate; } // Hz
@@ -218,6 +292,7 @@ public:
    unsigned int getNetworkStackSize() const;                 // Network thread stack size
    bool setNetworkStackSize(const unsigned int bytes);       // Network thread stack size (bytes or zero for default)
    bool doWeHaveTheNetThread() const;                        // Do we have a network thread?
+   bool getNetworkFrameStats(base::PeriodicTask::FrameStats* const stats) const;     // Network thread frame statistics
 
    // ---
    // Background thread support.
@@ -227,6 +302,25 @@ public:
    unsigned int getBackgroundStackSize() const;              // Background thread stack size
    bool setBackgroundStackSize(const unsigned int bytes);    // Background thread stack size (bytes or zero for default)
    bool doWeHaveTheBgThread() const;                         // Do we have a background thread?
+   bool getBackgroundFrameStats(base::PeriodicTask::FrameStats* const stats) const;  // Background thread frame statistics
+
+   // ---
+   // Batch (as-fast-as-possible) mode
+   // ---
+   bool isBatchModeEnabled() const;                          // Batch mode enabled?
+   virtual bool setBatchMode(const bool enb);                // Enables batch mode (set before creating any threads)
+   double getBatchRunTime() const;                           // Simulated time of each batch run (seconds; zero if no time limit)
+   virtual bool setBatchRunTime(const double secs);          // Sets the batch run time (seconds; zero for no time limit)
+   virtual bool runBatch();                                  // Runs the lock-step loop until the run is complete
+   void stopBatch();                                         // Ends the batch run at the end of the current frame
+   bool isBatchRunning() const;                              // Is runBatch() running?
+   unsigned int getBatchFrames() const;                      // Number of frames of the last run
+   double getBatchSimTime() const;                           // Simulated time of the last run (seconds)
+   double getBatchWallTime() const;                          // Wall clock time of the last run (seconds)
+   double getBatchSpeed() const;                             // Simulated seconds per wall clock second of the last run
+
+   // Tracing profiler
+   bool dumpTrace();                                         // Writes the trace to 'traceFile'
 
    // ---
    // Slot functions
@@ -240,6 +334,8 @@ public:
    virtual bool setSlotTimeCriticalRate(const base::Number* const hz);
    virtual bool setSlotTimeCriticalPri(const base::Number* const);
    virtual bool setSlotTimeCriticalStackSize(const base::Number* const);
+   virtual bool setSlotTimeCriticalOverrunPolicy(const base::Identifier* const);
+   virtual bool setSlotTimeCriticalBusyWait(const base::Time* const);
    virtual bool setSlotNetworkRate(const base::Number* const hz);
    virtual bool setSlotNetworkPri(const base::Number* const);
    virtual bool setSlotNetworkStackSize(const base::Number* const);
@@ -250,6 +346,11 @@ public:
    virtual bool setSlotOwnshipName(const base::String* const);
    virtual bool setSlotFastForwardRate(const base::Number* const);
    virtual bool setSlotEnableUpdateTimers(const base::Number* const);
+   virtual bool setSlotBatchMode(const base::Number* const);
+   virtual bool setSlotBatchRunTime(const base::Time* const);
+   virtual bool setSlotTrace(const base::Number* const);
+   virtual bool setSlotTraceFile(const base::String* const);
+   virtual bool setSlotTraceOverrunFile(const base::String* const);
 
    virtual void updateTC(const double dt = 0.0) override;
    virtual void updateData(const double dt = 0.0) override;
@@ -259,6 +360,8 @@ protected:
    virtual void inputDevices(const double dt);    // Handle device inputs
    virtual void outputDevices(const double dt);   // Handle device output
 
+   virtual bool isBatchRunComplete();             // Batch run end condition (checked at the end of each frame)
+
    base::Thread* getTcThread();                   // Pre-ref() pointer to the Time-critical thread
    void setTcThread(base::Thread*);
 
@@ -275,6 +378,9 @@ private:
    virtual void createNetworkProcess();           // Creates a network thread
    virtual void createBackgroundProcess();        // Creates a B/G thread
 
+   // Frame statistics of a (pre-ref()'d) thread
+   static bool getFrameStats(const base::Thread* const thread, base::PeriodicTask::FrameStats* const stats);
+
    Simulation* sim {};                            // Executable simulation model
    base::safe_ptr<base::PairStream> otw;          // List of  Out-The-Window visual system interfaces
    base::safe_ptr<base::PairStream> networks;     // List of networks
@@ -289,6 +395,8 @@ private:
    unsigned int tcStackSize {};                              // Time-critical thread stack size (bytes or zero for system default size)
    base::safe_ptr<base::Thread> tcThread;                    // The Time-critical thread
    unsigned int fastForwardRate {DEFAULT_FAST_FORWARD_RATE}; // Time-critical thread fast forward rate
+   base::PeriodicTask::OverrunPolicy tcOverrunPolicy {base::PeriodicTask::CATCH_UP};  // Time-critical thread overrun policy
+   double tcBusyWait {};                                     // Time-critical thread busy wait time (seconds)
 
    double netRate {};                                // Network thread Rate (hz)
    double netPri {DEFAULT_NET_THREAD_PRI};           // Priority of the Network thread (0->lowest, 1->highest)
@@ -302,6 +410,17 @@ private:
 
    double startupResetTimer {-1.0};             // Startup RESET timer (sends a RESET_EVENT after timeout)
    const base::Time* startupResetTimer0 {};     // Init value of the startup RESET timer
+
+   bool batchMode {};                           // Batch (as-fast-as-possible) mode
+   double batchRunTime {};                      // Simulated time of each batch run (seconds; zero if no time limit)
+   std::atomic<bool> batchRunning {};           // runBatch() is running
+   std::atomic<bool> batchStopReq {};           // stopBatch() has been called (by any thread)
+   unsigned int batchFrames {};                 // Number of frames of the last run
+   double batchExecTime0 {};                    // Executive time at the start of the run (seconds)
+   double batchSimTime {};                      // Simulated time of the last run (seconds)
+   double batchWallTime {};                     // Wall clock time of the last run (seconds)
+
+   const base::String* traceFile {};            // Trace file (see dumpTrace())
 };
 
 }
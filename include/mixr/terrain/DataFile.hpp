@@ -16,6 +16,9 @@ namespace terrain {
 //    1) the first elevation point [0] of all arrays is at the reference point
 //    2) the final elevation point [n-1] is at the maximum range
 //    3) The size of all arrays, n, must contain at least 2 points (ref point & max range)
+//    4) The elevation data is read-only once it's loaded, so it's shared, not
+//       copied, by copies (clones) of the data file; it's deleted along with
+//       the last data file that's using it.
 //------------------------------------------------------------------------------
 class DataFile : public Terrain
 {
@@ -30,6 +33,8 @@ public:
    double getLatSpacing() const;             // Spacing between latitude points (degs), or zero if the data isn't loaded
    double getLonSpacing() const;             // Spacing between longitude points (degs), or zero if the data isn't loaded
 
+   short getVoidValue() const;               // Value representing a void (missing) data point
+
    // Computes the nearest row index for the latitude (degs).
    // Returns true if the index is valid
    bool computerRowIndex(unsigned int* const irow, const double lat) const;
@@ -89,6 +94,11 @@ protected:
    short    voidValue {-32767};   // Value representing a void (missing) data point
 
    virtual void clearData() override;
+
+private:
+   class SharedColumns;
+   mutable SharedColumns* shared {};   // Elevation data shared with our copies (or zero if not shared)
+   mutable long semaphore {};          // Protects 'shared'
 };
 
 }
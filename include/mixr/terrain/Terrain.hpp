@@ -82,6 +82,20 @@ public:
          const double tgtAlt           // Target altitude (meters)
       ) const;
 
+   // Batch version of targetOcculting(): sets occulted[i] true if the i'th target
+   // point is occulted by the terrain as seen from the ref point; targets on
+   // about the same bearing share the elevation profile of the farthest one
+   virtual void targetsOcculting(
+         bool* const occulted,          // Occulted flags (true if the target is occulted)
+         const unsigned int n,          // Number of targets
+         const double refLat,           // Ref latitude (degs)
+         const double refLon,           // Ref longitude (degs)
+         const double refAlt,           // Ref altitude (meters)
+         const double* const tgtLat,    // Target latitudes (degs)
+         const double* const tgtLon,    // Target longitudes (degs)
+         const double* const tgtAlt     // Target altitudes (meters)
+      ) const;
+
    // Returns true if any terrain in the 'truBrg' direction for 'dist' meters
    // occults (or masks) a target with a look angle of atan(tanLookAng)
    virtual bool targetOcculting2(
@@ -186,6 +200,17 @@ protected:
    virtual bool setLongitudeNE(const double v);    // Northeast corner longitude of this database (degs: +/-180)
 
 private:
+   // Returns true if the tangent of the angle to any of the inner elevation
+   // points, as seen from the ref altitude, is greater than or equal to 'tanAng'
+   static bool tangentCheck(
+         const double* const elevations, // The elevation array (meters)
+         const bool* const validFlags,   // (Optional) Valid elevation flag array (true if elevation was found)
+         const unsigned int n,           // Size of the arrays
+         const double range,             // Range (meters)
+         const double refAlt,            // Ref altitude (meters)
+         const double tanAng             // Tangent of the angle
+      );
+
    virtual bool loadData() =0;      // Load the data file
 
    const base::String* path {};     // Data path name
@@ -0,0 +1,159 @@
+
+#ifndef __mixr_terrain_TiledFile_H__
+#define __mixr_terrain_TiledFile_H__
+
+#include "mixr/terrain/Terrain.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+namespace mixr {
+namespace base { class Number; }
+namespace terrain {
+class DataFile;
+
+//------------------------------------------------------------------------------
+// Class: TiledFile
+//
+// Description: Memory-mapped, tiled terrain elevation database.
+//
+//    A tiled file is a single mosaic of any number of DTED, SRTM or DED cells
+//    with the finest post spacing of the cells; cells with a coarser spacing
+//    (e.g., DTED above 50 degrees latitude, where the longitude spacing
+//    doubles) are resampled to it.  The posts are stored in square tiles of
+//    TILE_SIZE x TILE_SIZE elevations (column major, as DataFile's columns) and
+//    only the tiles that contain data are stored in the file.
+//
+//    The file is memory-mapped and the tiles are paged in by the operating
+//    system on demand.  The number of tiles kept resident is limited by the
+//    'maxTiles' slot; the least recently used tiles (CLOCK algorithm) are
+//    released back to the operating system.  Released tiles are still mapped,
+//    so the elevation functions never block on other threads.
+//
+//    Tiled files are created from loaded DataFile objects using convert().
+//
+// Factory name: TiledFile
+// Slots:
+//    maxTiles  <Number>  ! Max number of resident tiles (default: 256)
+//
+// Notes:
+//    1) Posts with the void value, and posts in tiles that are not stored in
+//       the file, are not found (i.e., the valid flag isn't set).
+//    2) The file is in the byte order of the machine that created it.
+//------------------------------------------------------------------------------
+class TiledFile : public Terrain
+{
+   DECLARE_SUBCLASS(TiledFile, Terrain)
+
+public:
+   static const unsigned int TILE_SIZE = 256;   // Tile size (posts)
+
+public:
+   TiledFile();
+
+   unsigned int getNumLatPoints() const       { return nptlat; }      // Number of latitude points (rows)
+   unsigned int getNumLonPoints() const       { return nptlong; }     // Number of longitude points (columns)
+   double getLatSpacing() const               { return latSpacing; }  // Spacing between latitude points (degs)
+   double getLonSpacing() const               { return lonSpacing; }  // Spacing between longitude points (degs)
+
+   unsigned int getMaxTiles() const           { return maxTiles; }    // Max number of resident tiles
+   unsigned int getNumResidentTiles() const   { return numResident; } // Number of resident tiles
+
+   // Creates the tiled file 'filename' from the 'n' loaded data files in
+   // 'files'; files with a coarser post spacing are resampled (nearest post)
+   // to the finest spacing.  Returns true if successful.
+   static bool convert(
+         const char* const filename,      // Tiled file name
+         const DataFile* const* const files, // Data files
+         const unsigned int n             // Number of data files
+      );
+
+   // ---
+   // simulation::Terrain interface
+   // ---
+
+   virtual bool isDataLoaded() const override;
+
+   // Locates an array of (at least two) elevation points (and sets valid flags if found)
+   // returns the number of points found within this TiledFile
+   virtual unsigned int getElevations(
+         double* const elevations,     // The elevation array (meters)
+         bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+         const unsigned int n,         // Size of elevation and valdFlags arrays
+         const double lat,             // Starting latitude (degs)
+         const double lon,             // Starting longitude (degs)
+         const double direction,       // True direction (heading) angle of the data (degs)
+         const double maxRng,          // Range to last elevation point (meters)
+         const bool   interp = false   // Interpolate between elevation posts (default: false)
+      ) const override;
+
+   // Locates an elevation value (meters) for a given reference point and returns
+   // it in 'elev'.  Function returns true if successful, otherwise 'elev' is unchanged.
+   virtual bool getElevation(
+         double* const elev,           // The elevation value (meters)
+         const double lat,             // Reference latitude (degs)
+         const double lon,             // Reference longitude (degs)
+         const bool interp = false     // Interpolate between elevation posts (default: false)
+      ) const override;
+
+protected:
+   virtual bool setSlotMaxTiles(const base::Number* const msg);
+
+   virtual void clearData() override;
+
+private:
+   static const unsigned int DEFAULT_MAX_TILES = 256;
+
+   // Tile states
+   static const unsigned char TILE_RELEASED = 0;      // Not resident (or released)
+   static const unsigned char TILE_RESIDENT = 1;      // Resident
+   static const unsigned char TILE_REFERENCED = 2;    // Resident and referenced since the last sweep
+
+   virtual bool loadData() override;
+
+   // Elevation at post [icol][irow], or false if the post has no data
+   bool getPost(short* const v, const unsigned int icol, const unsigned int irow) const;
+
+   // Returns the tile that contains post [icol][irow], or zero if not stored
+   const short* getTile(const unsigned int icol, const unsigned int irow) const;
+
+   void touchTile(const unsigned int idx) const;
+   void releaseTile(const unsigned int idx) const;
+
+   bool mapFile(const char* const filename);
+   void unmapFile();
+
+   // Mapped file
+   const unsigned char* mapAddr {};    // Mapped address
+   std::uint64_t mapSize {};           // Mapped size (bytes)
+   const std::uint32_t* tileIndex {};  // Tile index (in the mapped file); slot number + 1, or zero if not stored
+   const short* tileData {};           // First tile (in the mapped file)
+#if defined(WIN32)
+   void* fileHandle {};                // File handle
+   void* mapHandle {};                 // File mapping handle
+#else
+   int fd {-1};                        // File descriptor
+#endif
+
+   // Mosaic
+   double latSpacing {};               // Spacing between latitude points (degs)
+   double lonSpacing {};               // Spacing between longitude points (degs)
+   unsigned int nptlat {};             // Number of points in latitude (rows)
+   unsigned int nptlong {};            // Number of points in longitude (columns)
+   unsigned int ntlat {};              // Number of tile rows
+   unsigned int ntlong {};             // Number of tile columns
+   short voidValue {-32767};           // Value representing a void (missing) data point
+
+   // Resident tiles (CLOCK)
+   unsigned int maxTiles {DEFAULT_MAX_TILES};         // Max number of resident tiles
+   mutable std::atomic<unsigned char>* tileState {};  // Tile states (by tile number)
+   mutable unsigned int* clock {};                    // Resident tile numbers
+   mutable unsigned int numResident {};               // Number of resident tiles
+   mutable unsigned int hand {};                      // Clock hand
+   mutable long clockLock {};                         // Clock lock (base::lock())
+};
+
+}
+}
+
+#endif
@@ -75,6 +75,9 @@ void Component::copyData(const Component& org, const bool)
    setSelectionName(org.selection);
    selected = nullptr;
 
+   // (our tree's new update plan is built when it's needed)
+   updatePlan = nullptr;
+
    // Copy child components
    const PairStream* oc {org.components.getRefPtr()};
    if (oc != nullptr) {
@@ -109,8 +112,9 @@ void Component::deleteData()
     setSelectionName(nullptr);
     selected = nullptr;
 
-    // Delete list of components
+    // Delete list of components and our update plan
     components = nullptr;
+    updatePlan = nullptr;
 
     if (timingStats != nullptr) {
        timingStats->unref();
@@ -243,7 +247,9 @@ void Component::printTimingStats()
 //------------------------------------------------------------------------------
 void Component::updateTC(const double dt)
 {
-    // Update all my children
+    // Update all my children; by the running update plan, if any
+    if (UpdatePlan::updateChildrenTC(this, dt)) return;
+
     PairStream* subcomponents {getComponents()};
     if (subcomponents != nullptr) {
         if (selection != nullptr) {
@@ -270,7 +276,9 @@ void Component::updateTC(const double dt)
 //------------------------------------------------------------------------------
 void Component::updateData(const double dt)
 {
-    // Update all my children
+    // Update all my children; by the running update plan, if any
+    if (UpdatePlan::updateChildrenData(this, dt)) return;
+
     PairStream* subcomponents {getComponents()};
     if (subcomponents != nullptr) {
         if (selection != nullptr) {
@@ -292,6 +300,37 @@ void Component::updateData(const double dt)
     }
 }
 
+//------------------------------------------------------------------------------
+// getUpdatePlan() -- returns a ref()'d pointer to our tree's update plan;
+//                    need to unref() when completed.
+//------------------------------------------------------------------------------
+UpdatePlan* Component::getUpdatePlan()
+{
+   const unsigned int version {structVersion.load(std::memory_order_acquire)};
+   UpdatePlan* plan {updatePlan.getRefPtr()};
+   if (plan == nullptr || plan->getVersion() != version) {
+      // Rebuild the plan; a structure change while we're building it
+      // changes the version, so it'll be rebuilt again the next time.
+      if (plan != nullptr) plan->unref();
+      plan = new UpdatePlan(this, version);
+      updatePlan = plan;
+   }
+   return plan;
+}
+
+//------------------------------------------------------------------------------
+// structureChanged() -- changes the structure version of our tree, and of the
+//                       trees of all of our containers
+//------------------------------------------------------------------------------
+void Component::structureChanged()
+{
+   Component* p {this};
+   while (p != nullptr) {
+      p->structVersion.fetch_add(1, std::memory_order_release);
+      p = p->containerPtr;
+   }
+}
+
 //------------------------------------------------------------------------------
 // getComponents() -- returns a ref()'d pointer to our list of components;
 //                    need to unref() when completed.
@@ -640,6 +679,7 @@ void Component::processComponents(
    // ---
    components = newList;
    newList->unref();
+   structureChanged();
 
    // ---
    // Anything selected?
@@ -672,6 +712,7 @@ bool Component::setSelectionName(const Object* const s)
    if (s != nullptr) {
       selection = s->clone();
    }
+   structureChanged();
    return true;
 }
 
@@ -692,6 +733,7 @@ bool Component::select(const String* const name)
             ok = false;
         }
     }
+    structureChanged();
     return ok;
 }
 
@@ -711,6 +753,7 @@ bool Component::select(const Number* const num)
            ok = false;
         }
     }
+    structureChanged();
     return ok;
 }
 
@@ -0,0 +1,181 @@
+
+#include "mixr/base/EventTable.hpp"
+
+#include "mixr/base/Component.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+namespace mixr {
+namespace base {
+
+namespace {
+
+unsigned int hashToken(const int token)
+{
+   return (static_cast<unsigned int>(token) * 2654435761u);
+}
+
+}
+
+// Component's (never building) event table builder; it's defined here, and not
+// in Component.cpp, so that the compiler doesn't see the null value at the
+// (dead) build branches of Component's own event() function.
+EventTable* const Component::_eventBuilder {};
+
+EventTable::~EventTable()
+{
+   delete[] entries;
+   delete[] lists;
+   delete[] slots;
+}
+
+//------------------------------------------------------------------------------
+// beginBuild() -- returns this table, locked, if it needs to be built, or zero
+// if it's already built (see endBuild())
+//------------------------------------------------------------------------------
+EventTable* EventTable::beginBuild()
+{
+   EventTable* p {};
+   if (!built.load(std::memory_order_acquire)) {
+      lock( semaphore );
+      if (!built.load(std::memory_order_relaxed)) {
+         p = this;      // (unlocked by endBuild())
+      }
+      else {
+         unlock( semaphore );
+      }
+   }
+   return p;
+}
+
+//------------------------------------------------------------------------------
+// add() -- adds an entry (build mode)
+//------------------------------------------------------------------------------
+void EventTable::add(const int token, const MetaObject* const argType, const bool anyKey, handler_func handler)
+{
+   if (numEntries >= maxEntries) {
+      const unsigned int n {(maxEntries > 0) ? (maxEntries * 2) : 16};
+      const auto p = new Entry[n];
+      for (unsigned int i = 0; i < numEntries; i++) {
+         p[i] = entries[i];
+      }
+      delete[] entries;
+      entries = p;
+      maxEntries = n;
+   }
+   Entry& e {entries[numEntries++]};
+   e.token = token;
+   e.argType = argType;
+   e.anyKey = anyKey;
+   e.handler = handler;
+}
+
+//------------------------------------------------------------------------------
+// endBuild() -- builds each token's list of entries, which are its own
+// entries and, for key events, the 'any key' entries, in table order.
+//------------------------------------------------------------------------------
+void EventTable::endBuild()
+{
+   // Count the (distinct) tokens and the list sizes
+   unsigned int numTokens {};
+   unsigned int numAnyKey {};
+   for (unsigned int i = 0; i < numEntries; i++) {
+      if (entries[i].anyKey) numAnyKey++;
+   }
+   unsigned int size {numAnyKey};
+   for (unsigned int i = 0; i < numEntries; i++) {
+      if (entries[i].anyKey) continue;
+      bool first {true};
+      for (unsigned int j = 0; j < i && first; j++) {
+         first = (entries[j].anyKey || entries[j].token != entries[i].token);
+      }
+      if (first) {
+         numTokens++;
+         for (unsigned int j = 0; j < numEntries; j++) {
+            const Entry& e {entries[j]};
+            if ( (!e.anyKey && e.token == entries[i].token) ||
+                 (e.anyKey && entries[i].token <= Component::MAX_KEY_EVENT) ) size++;
+         }
+      }
+   }
+
+   numSlots = 16;
+   while (numSlots < numTokens * 2) numSlots *= 2;
+   slots = new Slot[numSlots];
+   for (unsigned int i = 0; i < numSlots; i++) {
+      slots[i].token = 0;
+      slots[i].first = 0;
+      slots[i].count = 0;
+   }
+   lists = new unsigned int[(size > 0) ? size : 1];
+
+   // 'Any key' list
+   unsigned int n {};
+   keyFirst = n;
+   for (unsigned int j = 0; j < numEntries; j++) {
+      if (entries[j].anyKey) lists[n++] = j;
+   }
+   keyCount = n - keyFirst;
+
+   // Token lists
+   const unsigned int mask {numSlots - 1};
+   for (unsigned int i = 0; i < numEntries; i++) {
+      const int token {entries[i].token};
+      if (entries[i].anyKey || find(token) != nullptr) continue;
+
+      unsigned int h {hashToken(token) & mask};
+      while (slots[h].count != 0) h = (h + 1) & mask;
+      slots[h].token = token;
+      slots[h].first = n;
+      for (unsigned int j = 0; j < numEntries; j++) {
+         const Entry& e {entries[j]};
+         if ( (!e.anyKey && e.token == token) ||
+              (e.anyKey && token <= Component::MAX_KEY_EVENT) ) lists[n++] = j;
+      }
+      slots[h].count = n - slots[h].first;
+   }
+
+   built.store(true, std::memory_order_release);
+   unlock( semaphore );
+}
+
+const EventTable::Slot* EventTable::find(const int token) const
+{
+   const unsigned int mask {numSlots - 1};
+   unsigned int h {hashToken(token) & mask};
+   while (slots[h].count != 0) {
+      if (slots[h].token == token) return &slots[h];
+      h = (h + 1) & mask;
+   }
+   return nullptr;
+}
+
+//------------------------------------------------------------------------------
+// dispatch() -- calls the handlers of the event, in order, until one of them
+// uses the event; returns true if the event was used
+//------------------------------------------------------------------------------
+bool EventTable::dispatch(Component* const comp, const int event, Object* const obj) const
+{
+   unsigned int first {};
+   unsigned int count {};
+   const Slot* const slot {find(event)};
+   if (slot != nullptr) {
+      first = slot->first;
+      count = slot->count;
+   }
+   else if (event <= Component::MAX_KEY_EVENT) {
+      first = keyFirst;
+      count = keyCount;
+   }
+
+   bool used {};
+   for (unsigned int i = 0; i < count && !used; i++) {
+      const Entry& e {entries[lists[first + i]]};
+      if (e.argType == nullptr || (obj != nullptr && obj->isKindOf(e.argType))) {
+         used = e.handler(comp, event, obj);
+      }
+   }
+   return used;
+}
+
+}
+}
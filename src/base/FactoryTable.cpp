@@ -0,0 +1,125 @@
+
+#include "mixr/base/FactoryTable.hpp"
+
+#include "mixr/base/util/atomics.hpp"
+#include "mixr/base/util/str_utils.hpp"
+
+#include <cstring>
+
+namespace mixr {
+namespace base {
+
+namespace {
+
+// Registered tables (constant initialized, so tables can register during static initialization)
+const FactoryTable* firstTable {};
+const FactoryTable* lastTable {};
+
+}
+
+FactoryTable::FactoryTable(const Entry* const e, const unsigned int n) : entries(e), numEntries(n)
+{
+   // Register
+   if (lastTable != nullptr) lastTable->next = this;
+   else firstTable = this;
+   lastTable = this;
+}
+
+FactoryTable::~FactoryTable()
+{
+   delete[] hashTable.load();
+}
+
+//------------------------------------------------------------------------------
+// getHashTable() -- returns the hash table, which is built on first use
+//------------------------------------------------------------------------------
+const FactoryTable::Slot* FactoryTable::getHashTable() const
+{
+   Slot* tbl {hashTable.load(std::memory_order_acquire)};
+   if (tbl == nullptr) {
+      lock( semaphore );
+      tbl = hashTable.load(std::memory_order_relaxed);
+      if (tbl == nullptr) {
+         unsigned int size {16};
+         while (size < numEntries * 2) size *= 2;
+         tbl = new Slot[size];
+         for (unsigned int i = 0; i < size; i++) {
+            tbl[i].name = nullptr;
+            tbl[i].entry = 0;
+         }
+
+         const unsigned int mask {size - 1};
+         for (unsigned int i = 0; i < numEntries; i++) {
+            const char* const name {entries[i].name()};
+            if (name == nullptr) continue;
+            unsigned int h {utStrHash(name) & mask};
+            bool found {};
+            while (tbl[h].name != nullptr && !found) {
+               found = (std::strcmp(tbl[h].name, name) == 0);
+               h = (h + 1) & mask;
+            }
+            // first entry with the name is used
+            if (!found) {
+               tbl[h].name = name;
+               tbl[h].entry = i;
+            }
+         }
+
+         hashSize = size;
+         hashTable.store(tbl, std::memory_order_release);
+      }
+      unlock( semaphore );
+   }
+   return tbl;
+}
+
+const FactoryTable::Slot* FactoryTable::find(const char* const name) const
+{
+   if (name == nullptr || numEntries == 0) return nullptr;
+
+   const Slot* const tbl {getHashTable()};
+   const unsigned int mask {hashSize - 1};
+   unsigned int h {utStrHash(name) & mask};
+   while (tbl[h].name != nullptr) {
+      if (std::strcmp(tbl[h].name, name) == 0) return &tbl[h];
+      h = (h + 1) & mask;
+   }
+   return nullptr;
+}
+
+//------------------------------------------------------------------------------
+// create() -- returns a new object with factory name 'name'
+//------------------------------------------------------------------------------
+Object* FactoryTable::create(const std::string& name) const
+{
+   return create(name.c_str());
+}
+
+Object* FactoryTable::create(const char* const name) const
+{
+   const Slot* const slot {find(name)};
+   return (slot != nullptr) ? entries[slot->entry].create() : nullptr;
+}
+
+bool FactoryTable::isFactoryName(const char* const name) const
+{
+   return (find(name) != nullptr);
+}
+
+//------------------------------------------------------------------------------
+// createObject() -- returns a new object with factory name 'name' using the
+// registered tables
+//------------------------------------------------------------------------------
+Object* FactoryTable::createObject(const std::string& name)
+{
+   Object* obj {};
+   const FactoryTable* table {firstTable};
+   while (obj == nullptr && table != nullptr) {
+      obj = table->create(name.c_str());
+      table = table->next;
+   }
+   return obj;
+}
+
+}
+}
@@ -62,6 +62,21 @@ bool Object::isClassType(const std::type_info& type) const
     else return false;
 }
 
+// Our class' MetaObject
+const MetaObject* Object::getClassMetaObject() const
+{
+    return &metaObject;
+}
+
+// Check class type using the MetaObjects
+bool Object::isKindOf(const MetaObject* const mo) const
+{
+    for (const MetaObject* p = getClassMetaObject(); p != nullptr; p = p->baseMetaObject) {
+        if (p == mo) return true;
+    }
+    return false;
+}
+
 // Check factory name
 bool Object::isFactoryName(const char name[]) const
 {
@@ -161,6 +176,20 @@ bool Object::setSlotByName(const char* const slotname, Object* const obj)
     return ok;
 }
 
+//------------------------------------------------------------------------------
+// setSlotByNumber() -- set the value of slot number 'slotindex' (e.g., from
+//                 slotName2Index()) to 'obj'.  Returns true if the slot and
+//                 object were processed; returns false if there was an error.
+//------------------------------------------------------------------------------
+bool Object::setSlotByNumber(const int slotindex, Object* const obj)
+{
+    bool ok {};
+    if (obj != nullptr && slotindex > 0 && slotindex <= slotTable->n()) {
+        ok = setSlotByIndex(slotindex,obj);
+    }
+    return ok;
+}
+
 //------------------------------------------------------------------------------
 // slotIndex2Name() -- returns the name of the slot at 'slotindex'
 //------------------------------------------------------------------------------
@@ -1,5 +1,7 @@
 
 #include "mixr/base/SlotTable.hpp"
+#include "mixr/base/util/atomics.hpp"
+#include "mixr/base/util/str_utils.hpp"
 #include <cstring>
 
 namespace mixr {
@@ -21,6 +23,8 @@ SlotTable::SlotTable(const char* s[], const int ns)
 
 SlotTable::~SlotTable()
 {
+   delete[] hashTable.load();
+   hashTable = nullptr;
    baseTable = nullptr;
    slots1 = nullptr;
    nslots1 = 0;
@@ -66,29 +70,67 @@ const char* SlotTable::name(const int slotindex) const
 //------------------------------------------------------------------------------
 int SlotTable::index(const char* const slotname) const
 {
-   int i {};
-
-   // First, check our slot names
-   {
-      // search our table
-      int j {};
-      for (j = 0; j < nslots1; j++) {
-         if (std::strcmp(slotname, slots1[j]) == 0) break;
-      }
-      if (j < nslots1) {
-         // if we're here, we found a match
-         i = j;                                    // a) start with j
-         i++;                                      // b) make it one based
-         if (baseTable != nullptr) i += baseTable->n();  // c) add baseTable->n()
-      }
+   if (slotname == nullptr) return 0;
+
+   const Entry* const tbl {getHashTable()};
+   const unsigned int mask {hashSize - 1};
+   unsigned int h {utStrHash(slotname) & mask};
+   while (tbl[h].name != nullptr) {
+      if (std::strcmp(tbl[h].name, slotname) == 0) return tbl[h].index;
+      h = (h + 1) & mask;
    }
+   return 0;
+}
 
-   // Second, check our baseTable
-   if (i == 0 && baseTable != nullptr) i = baseTable->index(slotname);
-
-   return i;
+//------------------------------------------------------------------------------
+// getHashTable() -- returns the hash table of the slot names of this table
+// and all base class tables, which is built on first use
+//------------------------------------------------------------------------------
+const SlotTable::Entry* SlotTable::getHashTable() const
+{
+   Entry* tbl {hashTable.load(std::memory_order_acquire)};
+   if (tbl == nullptr) {
+      lock( semaphore );
+      tbl = hashTable.load(std::memory_order_relaxed);
+      if (tbl == nullptr) {
+         const int num {n()};
+         unsigned int size {8};
+         while (size < static_cast<unsigned int>(num) * 2) size *= 2;
+         tbl = new Entry[size];
+         for (unsigned int i = 0; i < size; i++) {
+            tbl[i].name = nullptr;
+            tbl[i].index = 0;
+         }
+
+         // Most derived table first, so its slots are used over the base tables' slots
+         const unsigned int mask {size - 1};
+         const SlotTable* st {this};
+         while (st != nullptr) {
+            const int offset {(st->baseTable != nullptr) ? st->baseTable->n() : 0};
+            for (int j = 0; j < st->nslots1; j++) {
+               const char* const name {st->slots1[j]};
+               unsigned int h {utStrHash(name) & mask};
+               bool found {};
+               while (tbl[h].name != nullptr && !found) {
+                  found = (std::strcmp(tbl[h].name, name) == 0);
+                  h = (h + 1) & mask;
+               }
+               // first in the table is used (same as the linear search)
+               if (!found) {
+                  tbl[h].name = name;
+                  tbl[h].index = offset + j + 1;
+               }
+            }
+            st = st->baseTable;
+         }
+
+         hashSize = size;
+         hashTable.store(tbl, std::memory_order_release);
+      }
+      unlock( semaphore );
+   }
+   return tbl;
 }
 
 }
 }
-
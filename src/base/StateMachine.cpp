@@ -18,7 +18,11 @@ BEGIN_SLOT_MAP(StateMachine)
     ON_SLOT(1, setSlotStateMachines, PairStream)
 END_SLOT_MAP()
 
-BEGIN_EVENT_HANDLER(StateMachine)
+// (not BEGIN_EVENT_HANDLER(), which is table driven, because of the
+//  events passed to our current state's StateMachine)
+bool StateMachine::event(const int _event, Object* const _obj)
+{
+    bool _used {};
 
     ON_EVENT_OBJ(ON_ENTRY, onEntry, Object)     // always check w/Object first
     ON_EVENT(ON_ENTRY, onEntry)
@@ -31,7 +35,10 @@ BEGIN_EVENT_HANDLER(StateMachine)
    // If our current state is controlled by another StateMachine then
    // see if this StateMachine will handled this event.
    if (stMach != nullptr && !_used) _used = stMach->event(_event,_obj);
-END_EVENT_HANDLER()
+
+   if (!_used) _used = BaseClass::event(_event,_obj);
+   return _used;
+}
 
 StateMachine::StateMachine()
 {
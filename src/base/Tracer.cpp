@@ -0,0 +1,263 @@
+
+#include "mixr/base/Tracer.hpp"
+
+#include "mixr/base/util/atomics.hpp"
+#include "mixr/base/util/str_utils.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <string>
+
+namespace mixr {
+namespace base {
+
+static_assert((Tracer::BUFFER_SIZE & (Tracer::BUFFER_SIZE - 1)) == 0, "MIXR_CONFIG_TRACE_BUFFER_SIZE must be a power of two");
+
+namespace {
+
+// Copy of a zone (see readZones())
+struct ZoneCopy {
+   const char* name;
+   int id;
+   std::uint64_t t0;
+   std::uint64_t t1;
+};
+
+typedef Tracer::Zone Zone;
+typedef Tracer::Buffer Buffer;
+
+// List of all thread buffers (never deleted)
+std::atomic<Buffer*> buffers {};
+std::atomic<unsigned int> numThreads {};
+
+// Calling thread's buffer and name
+thread_local Buffer* tlsBuffer {};
+thread_local const char* tlsName {};
+
+// Time stamp (ticks) and steady clock (nanoseconds) of the first enable,
+// which are the start of the trace's time line
+std::atomic<std::uint64_t> epochTicks {};
+std::atomic<std::int64_t> epochNs {};
+long epochSemaphore {};
+
+// Zones recorded before this time stamp have been cleared
+std::atomic<std::uint64_t> sinceTicks {};
+
+// Frame overrun dump
+const unsigned int MAX_FILENAME = 512;
+char overrunFile[MAX_FILENAME] {};
+std::atomic<bool> overrunEnabled {};
+std::atomic<bool> overrunRequest {};
+long fileSemaphore {};
+
+std::int64_t steadyNs()
+{
+   return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+Buffer* newBuffer()
+{
+   const auto b = new Buffer();     // (zero initialized)
+   b->name.store(tlsName, std::memory_order_relaxed);
+   b->tid = numThreads.fetch_add(1, std::memory_order_relaxed) + 1;
+
+   // Push it on the list
+   Buffer* first {buffers.load(std::memory_order_relaxed)};
+   do {
+      b->next = first;
+   } while (!buffers.compare_exchange_weak(first, b, std::memory_order_release, std::memory_order_relaxed));
+
+   tlsBuffer = b;
+   return b;
+}
+
+// Copies the buffer's zones to 'zones', and returns the index of the first
+// zone that's still valid and the number of valid zones.  The zones that the
+// thread may have overwritten while they were being copied are dropped (same
+// as a seqlock reader).
+unsigned int readZones(const Buffer* const b, ZoneCopy* const zones, unsigned int* const first)
+{
+   const std::uint64_t h1 {b->head.load(std::memory_order_acquire)};
+   const std::uint64_t n {(h1 < Tracer::BUFFER_SIZE) ? h1 : Tracer::BUFFER_SIZE};
+   const std::uint64_t i0 {h1 - n};
+   for (std::uint64_t i = i0; i < h1; i++) {
+      const Zone& z {b->zones[i & (Tracer::BUFFER_SIZE - 1)]};
+      ZoneCopy& c {zones[i - i0]};
+      c.name = z.name.load(std::memory_order_relaxed);
+      c.id = z.id.load(std::memory_order_relaxed);
+      c.t0 = z.t0.load(std::memory_order_relaxed);
+      c.t1 = z.t1.load(std::memory_order_relaxed);
+   }
+   std::atomic_thread_fence(std::memory_order_acquire);
+   const std::uint64_t h2 {b->head.load(std::memory_order_relaxed)};
+
+   // Zones [ i0 .. h2-BUFFER_SIZE ] may have been overwritten
+   std::uint64_t valid {i0};
+   if (h2 >= Tracer::BUFFER_SIZE && (h2 - Tracer::BUFFER_SIZE + 1) > valid) {
+      valid = h2 - Tracer::BUFFER_SIZE + 1;
+   }
+   if (valid >= h1) return 0;
+
+   *first = static_cast<unsigned int>(valid - i0);
+   return static_cast<unsigned int>(h1 - valid);
+}
+
+// Writes a JSON string
+void writeString(std::ostream& sout, const char* const str)
+{
+   sout << '"';
+   for (const char* p = str; p != nullptr && *p != '\0'; p++) {
+      if (*p == '"' || *p == '\\') sout << '\\';
+      if (static_cast<unsigned char>(*p) >= 0x20) sout << *p;
+   }
+   sout << '"';
+}
+
+}
+
+std::atomic<bool> Tracer::enabled {};
+
+//------------------------------------------------------------------------------
+// setEnabled() -- enables/disables the tracer; the first enable starts the
+// trace's time line
+//------------------------------------------------------------------------------
+void Tracer::setEnabled(const bool flag)
+{
+   if (flag) {
+      lock( epochSemaphore );
+      if (epochNs.load(std::memory_order_relaxed) == 0) {
+         epochTicks.store(now(), std::memory_order_relaxed);
+         sinceTicks.store(epochTicks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+         epochNs.store(steadyNs(), std::memory_order_release);
+      }
+      unlock( epochSemaphore );
+   }
+   enabled.store(flag, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+// clear() -- clears the recorded zones
+//------------------------------------------------------------------------------
+void Tracer::clear()
+{
+   sinceTicks.store(now(), std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// setThreadName() -- sets the calling thread's name
+//------------------------------------------------------------------------------
+void Tracer::setThreadName(const char* const name)
+{
+   tlsName = name;
+   if (tlsBuffer != nullptr) tlsBuffer->name.store(name, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// getBuffer() -- returns the calling thread's buffer (see record())
+//------------------------------------------------------------------------------
+Tracer::Buffer* Tracer::getBuffer()
+{
+   Buffer* b {tlsBuffer};
+   if (b == nullptr) b = newBuffer();
+   return b;
+}
+
+//------------------------------------------------------------------------------
+// dump() -- writes the recorded zones of all threads to a Chrome trace file
+//------------------------------------------------------------------------------
+bool Tracer::dump(const char* const filename)
+{
+   if (filename == nullptr || epochNs.load(std::memory_order_acquire) == 0) return false;
+
+   lock( fileSemaphore );
+
+   std::ofstream sout(filename, std::ios::out | std::ios::trunc);
+   bool ok {sout.is_open()};
+   if (ok) {
+      // Time stamp ticks per microsecond
+      const std::uint64_t t0 {epochTicks.load(std::memory_order_relaxed)};
+      const double elapsedUs {static_cast<double>(steadyNs() - epochNs.load(std::memory_order_relaxed)) / 1000.0};
+      double ticksPerUs {1000.0};
+      if (elapsedUs > 1000.0) {
+         ticksPerUs = static_cast<double>(now() - t0) / elapsedUs;
+      }
+      const std::uint64_t since {sinceTicks.load(std::memory_order_relaxed)};
+
+      sout << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+      sout << std::fixed << std::setprecision(3);
+      bool first {true};
+
+      const auto zones = new ZoneCopy[BUFFER_SIZE];
+      for (const Buffer* b = buffers.load(std::memory_order_acquire); b != nullptr; b = b->next) {
+
+         // Thread name
+         const char* const name {b->name.load(std::memory_order_relaxed)};
+         if (!first) sout << "," << std::endl;
+         first = false;
+         sout << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->tid << ",\"args\":{\"name\":";
+         if (name != nullptr) writeString(sout, (std::string(name) + " " + std::to_string(b->tid)).c_str());
+         else sout << "\"thread " << b->tid << "\"";
+         sout << "}}";
+
+         // Zones ('complete' events)
+         unsigned int i0 {};
+         const unsigned int n {readZones(b, zones, &i0)};
+         for (unsigned int i = i0; i < (i0 + n); i++) {
+            const ZoneCopy& z {zones[i]};
+            if (z.t0 < since || z.t1 < z.t0) continue;
+
+            sout << "," << std::endl << "{\"name\":";
+            writeString(sout, z.name);
+            sout << ",\"cat\":\"mixr\",\"ph\":\"X\",\"pid\":1,\"tid\":" << b->tid;
+            sout << ",\"ts\":" << (static_cast<double>(z.t0 - t0) / ticksPerUs);
+            sout << ",\"dur\":" << (static_cast<double>(z.t1 - z.t0) / ticksPerUs);
+            sout << ",\"args\":{\"id\":" << z.id << "}}";
+         }
+      }
+      delete[] zones;
+
+      sout << std::endl << "]}" << std::endl;
+      ok = sout.good();
+      sout.close();
+   }
+
+   unlock( fileSemaphore );
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Frame overrun dumps
+//------------------------------------------------------------------------------
+void Tracer::setOverrunFile(const char* const filename)
+{
+   lock( fileSemaphore );
+   overrunFile[0] = '\0';
+   if (filename != nullptr) utStrcpy(overrunFile, MAX_FILENAME, filename);
+   overrunEnabled.store(overrunFile[0] != '\0', std::memory_order_relaxed);
+   unlock( fileSemaphore );
+}
+
+void Tracer::frameOverrun()
+{
+   if (isEnabled() && overrunEnabled.load(std::memory_order_relaxed)) {
+      overrunRequest.store(true, std::memory_order_relaxed);
+   }
+}
+
+bool Tracer::processRequests()
+{
+   bool ok {};
+   if (overrunRequest.exchange(false, std::memory_order_relaxed)) {
+      char filename[MAX_FILENAME] {};
+      lock( fileSemaphore );
+      utStrcpy(filename, MAX_FILENAME, overrunFile);
+      unlock( fileSemaphore );
+      if (filename[0] != '\0') ok = dump(filename);
+   }
+   return ok;
+}
+
+}
+}
@@ -0,0 +1,158 @@
+
+#include "mixr/base/UpdatePlan.hpp"
+
+#include "mixr/base/Component.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
+
+namespace mixr {
+namespace base {
+
+namespace {
+
+// This thread's running plan and its current entry
+thread_local const UpdatePlan* curPlan {};
+thread_local unsigned int curIndex {};
+
+}
+
+//------------------------------------------------------------------------------
+// Builds the plan of 'root's tree: each component's children, or just its
+// selected child, are added as contiguous entries (breadth first)
+//------------------------------------------------------------------------------
+UpdatePlan::UpdatePlan(Component* const root, const unsigned int v) : version(v)
+{
+   unsigned int maxEntries {16};
+   entries = new Entry[maxEntries];
+   entries[0].comp = root;
+   entries[0].first = 0;
+   entries[0].count = 0;
+   numEntries = 1;
+
+   for (unsigned int i = 0; i < numEntries; i++) {
+      Component* const c {entries[i].comp};
+      const unsigned int first {numEntries};
+      if (c->isComponentSelected()) {
+         Component* const selected {c->getSelectedComponent()};
+         if (selected != nullptr) add(selected, &maxEntries);
+      }
+      else {
+         PairStream* const subcomponents {c->getComponents()};
+         if (subcomponents != nullptr) {
+            List::Item* item {subcomponents->getFirstItem()};
+            while (item != nullptr) {
+               const auto pair = static_cast<Pair*>(item->getValue());
+               add(static_cast<Component*>(pair->object()), &maxEntries);
+               item = item->getNext();
+            }
+            subcomponents->unref();
+         }
+      }
+      entries[i].first = first;
+      entries[i].count = numEntries - first;
+   }
+}
+
+UpdatePlan::~UpdatePlan()
+{
+   for (unsigned int i = 1; i < numEntries; i++) {
+      entries[i].comp->unref();
+   }
+   delete[] entries;
+}
+
+//------------------------------------------------------------------------------
+// add() -- adds (and ref()'s) a component entry
+//------------------------------------------------------------------------------
+void UpdatePlan::add(Component* const c, unsigned int* const maxEntries)
+{
+   if (numEntries >= *maxEntries) {
+      const unsigned int n {*maxEntries * 2};
+      const auto p = new Entry[n];
+      for (unsigned int i = 0; i < numEntries; i++) {
+         p[i] = entries[i];
+      }
+      delete[] entries;
+      entries = p;
+      *maxEntries = n;
+   }
+   c->ref();
+   Entry& e {entries[numEntries++]};
+   e.comp = c;
+   e.first = 0;
+   e.count = 0;
+}
+
+//------------------------------------------------------------------------------
+// tcFrame() and updateData() -- updates the root component's tree
+//------------------------------------------------------------------------------
+void UpdatePlan::tcFrame(const double dt) const
+{
+   const UpdatePlan* const plan0 {curPlan};
+   const unsigned int index0 {curIndex};
+   curPlan = this;
+   curIndex = 0;
+   entries[0].comp->tcFrame(dt);
+   curPlan = plan0;
+   curIndex = index0;
+}
+
+void UpdatePlan::updateData(const double dt) const
+{
+   const UpdatePlan* const plan0 {curPlan};
+   const unsigned int index0 {curIndex};
+   curPlan = this;
+   curIndex = 0;
+   entries[0].comp->updateData(dt);
+   curPlan = plan0;
+   curIndex = index0;
+}
+
+//------------------------------------------------------------------------------
+// current() -- returns the current entry, if it's component 'c's entry
+//------------------------------------------------------------------------------
+const UpdatePlan::Entry* UpdatePlan::current(const Component* const c)
+{
+   const Entry* e {};
+   if (curPlan != nullptr && curPlan->entries[curIndex].comp == c) {
+      e = &curPlan->entries[curIndex];
+   }
+   return e;
+}
+
+//------------------------------------------------------------------------------
+// updateChildrenTC() and updateChildrenData() -- updates the children of the
+// current entry, if it's component 'c's entry
+//------------------------------------------------------------------------------
+bool UpdatePlan::updateChildrenTC(Component* const c, const double dt)
+{
+   const Entry* const e {current(c)};
+   if (e == nullptr) return false;
+
+   const unsigned int index {curIndex};
+   const unsigned int last {e->first + e->count};
+   for (unsigned int i = e->first; i < last; i++) {
+      curIndex = i;
+      curPlan->entries[i].comp->tcFrame(dt);
+   }
+   curIndex = index;
+   return true;
+}
+
+bool UpdatePlan::updateChildrenData(Component* const c, const double dt)
+{
+   const Entry* const e {current(c)};
+   if (e == nullptr) return false;
+
+   const unsigned int index {curIndex};
+   const unsigned int last {e->first + e->count};
+   for (unsigned int i = e->first; i < last; i++) {
+      curIndex = i;
+      curPlan->entries[i].comp->updateData(dt);
+   }
+   curIndex = index;
+   return true;
+}
+
+}
+}
@@ -2,6 +2,8 @@
 #include "mixr/base/concurrent/PeriodicTask.hpp"
 
 #include "mixr/base/Component.hpp"
+#include "mixr/base/Tracer.hpp"
+#include "mixr/base/util/atomics.hpp"
 #include <iostream>
 
 namespace mixr {
@@ -43,21 +45,80 @@ const Statistic& PeriodicTask::getBustedFrameStats() const
    return bfStats;
 }
 
+void PeriodicTask::getFrameStats(FrameStats* const stats) const
+{
+   if (stats != nullptr) {
+      lock( fsSemaphore );
+      *stats = fstats;
+      unlock( fsSemaphore );
+   }
+}
+
 unsigned int PeriodicTask::getTotalFrameCount() const
 {
    return tcnt;
 }
 
+PeriodicTask::OverrunPolicy PeriodicTask::getOverrunPolicy() const
+{
+   return policy;
+}
+
+bool PeriodicTask::setOverrunPolicy(const OverrunPolicy p)
+{
+   policy = p;
+   return true;
+}
+
+unsigned int PeriodicTask::getBusyWaitTime() const
+{
+   return busyWait;
+}
+
+bool PeriodicTask::setBusyWaitTime(const unsigned int usecs)
+{
+   busyWait = usecs;
+   return true;
+}
+
 bool PeriodicTask::isVariableDeltaTimeEnabled() const
 {
-   return vdtFlg;
+   return (policy == REAL_DT);
 }
 
 bool PeriodicTask::setVariableDeltaTimeFlag(const bool enable)
 {
-   vdtFlg = enable;
+   policy = (enable ? REAL_DT : CATCH_UP);
    return true;
 }
 
+//------------------------------------------------------------------------------
+// updateFrameStats() -- updates the frame statistics at the end of a frame
+//------------------------------------------------------------------------------
+void PeriodicTask::updateFrameStats(const double frameTime, const double lateStart, const double overrun, const unsigned int skipped)
+{
+   // Frame time histogram bin: 10% of the frame period per bin
+   int bin = static_cast<int>(frameTime * rate * 10.0);
+   if (bin < 0) bin = 0;
+   if (bin >= static_cast<int>(NUM_FRAME_TIME_BINS)) bin = NUM_FRAME_TIME_BINS - 1;
+
+   lock( fsSemaphore );
+   fstats.numFrames++;
+   fstats.frameTimes[bin]++;
+   if (frameTime > fstats.maxFrameTime) fstats.maxFrameTime = frameTime;
+   sumLateStart += lateStart;
+   fstats.avgLateStart = sumLateStart / static_cast<double>(fstats.numFrames);
+   if (lateStart > fstats.maxLateStart) fstats.maxLateStart = lateStart;
+   if (overrun > 0.0) {
+      fstats.numOverruns++;
+      bfStats.sigma(overrun);
+   }
+   fstats.numSkipped += skipped;
+   unlock( fsSemaphore );
+
+   // Request the tracer's overrun dump
+   if (overrun > 0.0) Tracer::frameOverrun();
+}
+
 }
 }
@@ -56,15 +56,16 @@ bool Thread::create()
       ok = false;
    }
 
-   // Create the thread
+   // Create the thread (a short thread can terminate before createThread()
+   // returns, so 'killed' is cleared first and not set after)
+   killed = false;
    if (ok) ok = createThread();
 
    if (!ok) {
       std::cerr << "Thread(" << this << ")::create() -- ERROR: Did NOT create the thread!" << std::endl;
+      killed = true;
    }
 
-   killed = !ok;
-
    return ok;
 }
 
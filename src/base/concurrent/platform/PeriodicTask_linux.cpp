@@ -5,6 +5,8 @@
 #include "mixr/base/util/math_utils.hpp"
 #include "mixr/base/util/system_utils.hpp"
 
+#include <cerrno>
+#include <ctime>
 #include <signal.h>
 #include <iostream>
 
@@ -14,6 +16,31 @@ namespace base {
 // max number of processors we'll allow
 static const unsigned int MAX_CPUS = 32;
 
+static const long long NSEC_PER_SEC = 1000000000LL;
+
+// Current CLOCK_MONOTONIC time (nanoseconds)
+static long long monotonicTime()
+{
+   struct timespec tp;
+   clock_gettime(CLOCK_MONOTONIC, &tp);
+   return (static_cast<long long>(tp.tv_sec) * NSEC_PER_SEC + tp.tv_nsec);
+}
+
+// Sleeps until CLOCK_MONOTONIC time 't' (nanoseconds); with 'spin', sleeps
+// until 'spin' nanoseconds before 't' and then busy waits until 't'
+static void waitUntil(const long long t, const long long spin)
+{
+   const long long t0 = t - spin;
+   struct timespec tp;
+   tp.tv_sec = static_cast<time_t>(t0 / NSEC_PER_SEC);
+   tp.tv_nsec = static_cast<long>(t0 % NSEC_PER_SEC);
+   while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &tp, nullptr) == EINTR) {}
+
+   if (spin > 0) {
+      while (monotonicTime() < t) {}
+   }
+}
+
 //-----------------------------------------------------------------------------
 // Our main thread function
 //-----------------------------------------------------------------------------
@@ -24,52 +51,70 @@ unsigned long PeriodicTask::mainThreadFunc()
       std::cout << "Thread(" << this << ")::mainLoopFunc(): Starting main loop ..." << std::endl;
    }
 
-   // Delta time
-   const double dt = 1.0/static_cast<double>(getRate());
-   int sec0 = static_cast<int>(dt);
-   int nsec0 = static_cast<int>((dt - static_cast<double>(sec0)) * 1000000000.0);
-
-   // Reference time
-   struct timespec tp;
-   clock_gettime(CLOCK_REALTIME, &tp);
-
-   // Mutex
-   pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
-   pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
-   pthread_mutex_lock(&mutex);
+   // Delta time and frame period (nanoseconds)
+   const double dt0 = 1.0/static_cast<double>(getRate());
+   const auto period = static_cast<long long>(dt0 * static_cast<double>(NSEC_PER_SEC));
+   const long long spin = static_cast<long long>(busyWait) * 1000LL;
 
    // ---
    // Inital wait for one frame --
    // --- Linux seems to need this otherwise the userFunc() call failes.
    // ---
-   tp.tv_nsec += (nsec0);
-   if (tp.tv_nsec >= 1000000000) {
-      tp.tv_sec++;
-      tp.tv_nsec -= 1000000000;
-   }
-   pthread_cond_timedwait(&cond, &mutex, &tp);
+   long long frameStart = monotonicTime() + period;   // Scheduled start of the frame
+   waitUntil(frameStart, spin);
+   long long prevStart = frameStart - period;           // Actual start of the previous frame
 
    while (!getParent()->isShutdown()) {
 
       // ---
       // User defined tasks
       // ---
+      const long long scheduled = frameStart;
+      const long long t0 = monotonicTime();
+      double dt = dt0;
+      if (policy == REAL_DT && t0 > prevStart) {
+         dt = static_cast<double>(t0 - prevStart) / static_cast<double>(NSEC_PER_SEC);
+      }
+      prevStart = t0;
+
       this->userFunc(dt);
       tcnt++;
 
+      const long long t1 = monotonicTime();
+
       // ---
-      // Wait for the end of frame
+      // Schedule the next frame, and check for an overrun
       // ---
-      tp.tv_nsec += (nsec0);
-      if (tp.tv_nsec >= 1000000000) {
-         tp.tv_sec++;
-         tp.tv_nsec -= 1000000000;
+      frameStart += period;
+      long long overrun = 0;
+      unsigned int skipped = 0;
+      if (t1 > frameStart) {
+         overrun = t1 - frameStart;
+         if (policy == SKIP_FRAMES) {
+            // Skip the missed frames
+            const long long n = overrun / period + 1;
+            frameStart += n * period;
+            skipped = static_cast<unsigned int>(n);
+         }
+         else if (policy == REAL_DT) {
+            // Start the next frame now, on a new timeline
+            frameStart = t1;
+         }
       }
-      pthread_cond_timedwait(&cond, &mutex, &tp);
 
-   }
+      updateFrameStats(
+         static_cast<double>(t1 - t0) / static_cast<double>(NSEC_PER_SEC),
+         static_cast<double>(t0 > scheduled ? t0 - scheduled : 0) / static_cast<double>(NSEC_PER_SEC),
+         static_cast<double>(overrun) / static_cast<double>(NSEC_PER_SEC),
+         skipped
+      );
 
-   pthread_mutex_unlock(&mutex);
+      // ---
+      // Wait for the start of the next frame
+      // ---
+      if (frameStart > t1) waitUntil(frameStart, spin);
+
+   }
 
    if (getParent()->isMessageEnabled(MSG_INFO) ) {
       std::cout << "Thread(" << this << ")::mainLoopFunc(): ... end of main loop." << std::endl;
@@ -36,49 +36,65 @@ unsigned long PeriodicTask::mainThreadFunc()
 
    // All of the real work is done by ...
    if (ok) {
-      double refTime = 0.0;                                  // Reference time
-      const double startTime = getComputerTime();;           // Computer's time of day (sec) run started
-      double dt = 1.0/static_cast<double>(getRate());
+      const double dt0 = 1.0/static_cast<double>(getRate());
+      const double spin = static_cast<double>(busyWait) / 1000000.0;
+      double frameStart = getComputerTime() + dt0;          // Scheduled start of the frame (sec)
+      double prevStart = frameStart - dt0;                  // Actual start of the previous frame (sec)
+
+      // Inital wait for one frame
+      {
+         const auto sleepFor = static_cast<int>((frameStart - spin - getComputerTime())*1000.0);
+         if (sleepFor > 0) Sleep(sleepFor);
+         if (spin > 0.0) {
+            while (getComputerTime() < frameStart) {}
+         }
+      }
 
       while (!getParent()->isShutdown()) {
 
          // ---
          // User defined tasks
          // ---
+         const double scheduled = frameStart;
+         const double t0 = getComputerTime();
+         double dt = dt0;
+         if (policy == REAL_DT && t0 > prevStart) dt = (t0 - prevStart);
+         prevStart = t0;
+
          this->userFunc(dt);
+         tcnt++;
+
+         const double t1 = getComputerTime();
 
          // ---
-         // Wait for the start of the next frame
+         // Schedule the next frame, and check for an overrun
          // ---
-         {
-            // Update reference time at the start of next frame
-            refTime = (refTime + dt);
-
-            // Current computer time
-            const double time = getComputerTime();
-
-            // Actual run time
-            const double t0 = (time - startTime);
-
-            // How long should we sleep for
-            const double st = refTime - t0;
-            const auto sleepFor = static_cast<int>(st*1000.0);
-
-            // wait for the next frame
-            if (sleepFor > 0) Sleep(sleepFor);
-
-            // Compute next delta time and update frame stats
-            dt = 1.0/static_cast<double>(getRate());
-            if (st < 0) {
-               const double overrun = -st;
-               bfStats.sigma(overrun);
-               if (vdtFlg) {
-                  // adjust for overrun
-                  dt += overrun;
-                  refTime += overrun;
-               }
+         frameStart += dt0;
+         double overrun = 0.0;
+         unsigned int skipped = 0;
+         if (t1 > frameStart) {
+            overrun = t1 - frameStart;
+            if (policy == SKIP_FRAMES) {
+               // Skip the missed frames
+               const auto n = static_cast<unsigned int>(overrun / dt0) + 1;
+               frameStart += n * dt0;
+               skipped = n;
+            }
+            else if (policy == REAL_DT) {
+               // Start the next frame now, on a new timeline
+               frameStart = t1;
             }
-            tcnt++;
+         }
+
+         updateFrameStats((t1 - t0), (t0 > scheduled ? t0 - scheduled : 0.0), overrun, skipped);
+
+         // ---
+         // Wait for the start of the next frame
+         // ---
+         const auto sleepFor = static_cast<int>((frameStart - spin - getComputerTime())*1000.0);
+         if (sleepFor > 0) Sleep(sleepFor);
+         if (spin > 0.0) {
+            while (getComputerTime() < frameStart) {}
          }
       }
    }
@@ -2,6 +2,7 @@
 #include "mixr/base/concurrent/Thread.hpp"
 
 #include "mixr/base/Component.hpp"
+#include "mixr/base/Tracer.hpp"
 #include "mixr/base/util/math_utils.hpp"
 #include "mixr/base/util/system_utils.hpp"
 
@@ -26,6 +27,9 @@ void* Thread::staticThreadFunc(void* lpParam)
    thread->ref();
    parent->ref();
 
+   // Name our thread's trace zones after our class
+   Tracer::setThreadName(thread->getClassMetaObject()->getFactoryName());
+
    // The main thread function, which is a Thread class memeber function,
    // will handle the rest.
    unsigned long rtn = thread->mainThreadFunc();
@@ -2,6 +2,7 @@
 #include "mixr/base/concurrent/Thread.hpp"
 
 #include "mixr/base/Component.hpp"
+#include "mixr/base/Tracer.hpp"
 #include "mixr/base/util/system_utils.hpp"
 #include <iostream>
 
@@ -29,6 +30,9 @@ DWORD WINAPI Thread::staticThreadFunc(LPVOID lpParam)
    thread->ref();
    parent->ref();
 
+   // Name our thread's trace zones after our class
+   Tracer::setThreadName(thread->getClassMetaObject()->getFactoryName());
+
    // The main thread function, which is a Thread class memeber function,
    // will handle the rest.
    DWORD rtn = thread->mainThreadFunc();
@@ -70,6 +70,7 @@
 #include <fstream>
 
 #include "mixr/base/edl_parser.hpp"
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 #include "mixr/base/String.hpp"
 #include "mixr/base/Identifier.hpp"
@@ -80,11 +81,13 @@
 #include "mixr/base/PairStream.hpp"
 #include "mixr/base/List.hpp"
 #include "EdlScanner.hpp"
+#include "EdlSnapshot.hpp"
 
 static mixr::base::Object* result {};          // result of all our work (i.e., an Object)
 static mixr::base::EdlScanner* scanner {};     // edl scanner
 static mixr::base::factory_func factory {};    // factory function 
 static int err_count {};                       // error count
+static mixr::base::EdlSnapshot* snapshot {};   // snapshot of the parsed forms (edl_compiler() only)
 
 //------------------------------------------------------------------------------
 // yylex() -- user defined; used by the parser to call the lexical generator
@@ -145,12 +148,17 @@ static mixr::base::Object* parse(const std::string& name, mixr::base::PairStream
             std::string msg = "undefined factory name: " + name;
             yyerror(msg.c_str());
         }
+
+        // record the form for the snapshot
+        if (snapshot != nullptr && obj != nullptr) {
+            snapshot->addForm(name.c_str(), obj, arg_list);
+        }
     }
     return obj;
 }
 
 
-#line 154 "EdlParser.cpp" /* yacc.c:339  */
+#line 162 "EdlParser.cpp" /* yacc.c:339  */
 
 # ifndef YY_NULLPTR
 #  if defined __cplusplus && 201103L <= __cplusplus
@@ -199,7 +207,7 @@ extern int yydebug;
 
 union YYSTYPE
 {
-#line 108 "edl_parser.y" /* yacc.c:355  */
+#line 116 "edl_parser.y" /* yacc.c:355  */
 
    double                     dval;
    long                       lval;
@@ -211,7 +219,7 @@ union YYSTYPE
    mixr::base::List*          lvalp;
    mixr::base::Number*        nvalp;
 
-#line 215 "EdlParser.cpp" /* yacc.c:355  */
+#line 223 "EdlParser.cpp" /* yacc.c:355  */
 };
 
 typedef union YYSTYPE YYSTYPE;
@@ -228,7 +236,7 @@ int yyparse (void);
 
 /* Copy the second part of user declarations.  */
 
-#line 232 "EdlParser.cpp" /* yacc.c:358  */
+#line 240 "EdlParser.cpp" /* yacc.c:358  */
 
 #ifdef short
 # undef short
@@ -1315,25 +1323,25 @@ yyreduce:
   switch (yyn)
     {
         case 2:
-#line 139 "edl_parser.y" /* yacc.c:1646  */
+#line 147 "edl_parser.y" /* yacc.c:1646  */
     { result = (yyvsp[0].ovalp); }
-#line 1321 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1329 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 3:
-#line 140 "edl_parser.y" /* yacc.c:1646  */
+#line 148 "edl_parser.y" /* yacc.c:1646  */
     { if ((yyvsp[0].ovalp) != 0) { result = new mixr::base::Pair((yyvsp[-1].cvalp), (yyvsp[0].ovalp)); delete[] (yyvsp[-1].cvalp); (yyvsp[0].ovalp)->unref(); } }
-#line 1327 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1335 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 4:
-#line 143 "edl_parser.y" /* yacc.c:1646  */
+#line 151 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.svalp) = new mixr::base::PairStream(); }
-#line 1333 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1341 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 5:
-#line 145 "edl_parser.y" /* yacc.c:1646  */
+#line 153 "edl_parser.y" /* yacc.c:1646  */
     { if ((yyvsp[0].ovalp) != 0) {
                                         int i = (yyvsp[-1].svalp)->entries();
                                         char cbuf[20] {};
@@ -1345,11 +1353,11 @@ yyreduce:
                                         (yyval.svalp) = (yyvsp[-1].svalp);
                                       }
                                     }
-#line 1349 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1357 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 6:
-#line 157 "edl_parser.y" /* yacc.c:1646  */
+#line 165 "edl_parser.y" /* yacc.c:1646  */
     {
                                     int i = (yyvsp[-1].svalp)->entries();
                                     char cbuf[20] {};
@@ -1360,95 +1368,95 @@ yyreduce:
                                     p->unref();
                                     (yyval.svalp) = (yyvsp[-1].svalp);
                                     }
-#line 1364 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1372 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 7:
-#line 168 "edl_parser.y" /* yacc.c:1646  */
+#line 176 "edl_parser.y" /* yacc.c:1646  */
     { (yyvsp[-1].svalp)->put((yyvsp[0].pvalp)); (yyvsp[0].pvalp)->unref(); (yyval.svalp) = (yyvsp[-1].svalp); }
-#line 1370 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1378 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 8:
-#line 172 "edl_parser.y" /* yacc.c:1646  */
+#line 180 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.ovalp) = parse((yyvsp[-2].cvalp), (yyvsp[-1].svalp)); delete[] (yyvsp[-2].cvalp); (yyvsp[-1].svalp)->unref(); }
-#line 1376 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1384 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 9:
-#line 174 "edl_parser.y" /* yacc.c:1646  */
+#line 182 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.ovalp) = (mixr::base::Object*) (yyvsp[-1].svalp); }
-#line 1382 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1390 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 10:
-#line 178 "edl_parser.y" /* yacc.c:1646  */
+#line 186 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.pvalp) = new mixr::base::Pair((yyvsp[-1].cvalp), (yyvsp[0].ovalp)); delete[] (yyvsp[-1].cvalp); (yyvsp[0].ovalp)->unref(); }
-#line 1388 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1396 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 11:
-#line 179 "edl_parser.y" /* yacc.c:1646  */
+#line 187 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.pvalp) = new mixr::base::Pair((yyvsp[-1].cvalp), (yyvsp[0].ovalp)); delete[] (yyvsp[-1].cvalp); (yyvsp[0].ovalp)->unref(); }
-#line 1394 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1402 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 12:
-#line 182 "edl_parser.y" /* yacc.c:1646  */
+#line 190 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.ovalp) = new mixr::base::String((yyvsp[0].cvalp)); delete[] (yyvsp[0].cvalp); }
-#line 1400 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1408 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 13:
-#line 183 "edl_parser.y" /* yacc.c:1646  */
+#line 191 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.ovalp) = new mixr::base::Identifier((yyvsp[0].cvalp)); delete[] (yyvsp[0].cvalp); }
-#line 1406 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1414 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 14:
-#line 184 "edl_parser.y" /* yacc.c:1646  */
+#line 192 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.ovalp) = new mixr::base::Boolean((yyvsp[0].bval)); }
-#line 1412 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1420 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 15:
-#line 185 "edl_parser.y" /* yacc.c:1646  */
+#line 193 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.ovalp) = (yyvsp[-1].lvalp); }
-#line 1418 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1426 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 16:
-#line 186 "edl_parser.y" /* yacc.c:1646  */
+#line 194 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.ovalp) = (yyvsp[0].nvalp); }
-#line 1424 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1432 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 17:
-#line 189 "edl_parser.y" /* yacc.c:1646  */
+#line 197 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.lvalp) = new mixr::base::List(); (yyval.lvalp)->put((yyvsp[0].nvalp)); (yyvsp[0].nvalp)->unref(); }
-#line 1430 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1438 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 18:
-#line 190 "edl_parser.y" /* yacc.c:1646  */
+#line 198 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.lvalp) = (yyvsp[-1].lvalp); (yyval.lvalp)->put((yyvsp[0].nvalp)); (yyvsp[0].nvalp)->unref(); }
-#line 1436 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1444 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 19:
-#line 193 "edl_parser.y" /* yacc.c:1646  */
+#line 201 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.nvalp) = new mixr::base::Integer((yyvsp[0].lval)); }
-#line 1442 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1450 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
   case 20:
-#line 194 "edl_parser.y" /* yacc.c:1646  */
+#line 202 "edl_parser.y" /* yacc.c:1646  */
     { (yyval.nvalp) = new mixr::base::Float((yyvsp[0].dval)); }
-#line 1448 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1456 "EdlParser.cpp" /* yacc.c:1646  */
     break;
 
 
-#line 1452 "EdlParser.cpp" /* yacc.c:1646  */
+#line 1460 "EdlParser.cpp" /* yacc.c:1646  */
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1676,7 +1684,7 @@ yyreturn:
 #endif
   return yyresult;
 }
-#line 196 "edl_parser.y" /* yacc.c:1906  */
+#line 204 "edl_parser.y" /* yacc.c:1906  */
 
 
 namespace mixr {
@@ -1684,12 +1692,13 @@ namespace base {
 
 //------------------------------------------------------------------------------
 // Returns an Object* that was constructed from parsing an EDL file.
-// factory is the name of the Object creation function  
+// factory is the name of the Object creation function, or nullptr to use
+// the registered factory tables (see FactoryTable::createObject())
 //------------------------------------------------------------------------------
 Object* edl_parser(const std::string& filename, factory_func f, int* num_errors)
 {
     // set the global file scope static variables
-    factory = f;
+    factory = (f != nullptr) ? f : FactoryTable::createObject;
     result = nullptr;
     err_count = 0;
 
@@ -1716,6 +1725,44 @@ Object* edl_parser(const std::string& filename, factory_func f, int* num_errors)
     return obj;
 }
 
+//------------------------------------------------------------------------------
+// Returns an Object* that was constructed from parsing an EDL file, same as
+// edl_parser(), and, if there were no errors, writes a binary snapshot of the
+// parsed objects to file 'snapshot_file' (see edl_loader()).
+//------------------------------------------------------------------------------
+Object* edl_compiler(const std::string& filename, factory_func f, const std::string& snapshot_file, int* num_errors)
+{
+    snapshot = new EdlSnapshot();
+
+    int errors {};
+    Object* obj {edl_parser(filename, f, &errors)};
+    if (obj != nullptr && errors == 0) {
+        snapshot->write(snapshot_file, obj, filename);
+    }
+    else {
+        std::cerr << "edl_compiler(): snapshot not written; errors while parsing: " << filename << std::endl;
+    }
+
+    delete snapshot;
+    snapshot = nullptr;
+
+    if (num_errors != nullptr) {
+        *num_errors = errors;
+    }
+    return obj;
+}
+
+//------------------------------------------------------------------------------
+// Returns an Object* that was rebuilt from the binary snapshot file,
+// 'snapshot_file', written by edl_compiler().  If the EDL file name is
+// given, nullptr is returned if the snapshot wasn't compiled from the
+// current contents of the EDL file.
+//------------------------------------------------------------------------------
+Object* edl_loader(const std::string& snapshot_file, factory_func f, int* num_errors, const std::string& filename)
+{
+    return EdlSnapshot::load(snapshot_file, f, filename, num_errors);
+}
+
 }
 }
 
@@ -0,0 +1,773 @@
+
+#include "EdlSnapshot.hpp"
+
+#include "mixr/base/FactoryTable.hpp"
+#include "mixr/base/Object.hpp"
+#include "mixr/base/String.hpp"
+#include "mixr/base/Identifier.hpp"
+#include "mixr/base/numeric/Integer.hpp"
+#include "mixr/base/numeric/Float.hpp"
+#include "mixr/base/numeric/Boolean.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/List.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <typeinfo>
+
+namespace mixr {
+namespace base {
+
+namespace {
+
+const char MAGIC[8] {'M','I','X','R','E','D','L','S'};
+const std::uint32_t BYTE_ORDER_MARK {0x01020304};
+
+// Value tags
+enum : std::uint8_t {
+   TAG_NONE, TAG_FORM, TAG_STRING, TAG_IDENTIFIER, TAG_BOOLEAN,
+   TAG_INTEGER, TAG_FLOAT, TAG_LIST, TAG_PAIRSTREAM, TAG_PAIR
+};
+
+// Numeric list types
+enum : std::uint8_t { LIST_INTEGERS, LIST_FLOATS, LIST_MIXED };
+
+//------------------------------------------------------------------------------
+// OutBuffer -- growing output buffer
+//------------------------------------------------------------------------------
+class OutBuffer
+{
+public:
+   OutBuffer() = default;
+   OutBuffer(const OutBuffer&) = delete;
+   OutBuffer& operator=(const OutBuffer&) = delete;
+   ~OutBuffer()                              { delete[] data; }
+
+   const char* getData() const               { return data; }
+   std::size_t getLength() const             { return len; }
+
+   void put(const void* const p, const std::size_t n)
+   {
+      if (len + n > size) {
+         std::size_t newSize {size > 0 ? size * 2 : 65536};
+         while (len + n > newSize) newSize *= 2;
+         const auto newData = new char[newSize];
+         if (len > 0) std::memcpy(newData, data, len);
+         delete[] data;
+         data = newData;
+         size = newSize;
+      }
+      std::memcpy(data + len, p, n);
+      len += n;
+   }
+
+   void putU8(const std::uint8_t v)          { put(&v, sizeof(v)); }
+   void putU32(const std::uint32_t v)        { put(&v, sizeof(v)); }
+   void putI32(const std::int32_t v)         { put(&v, sizeof(v)); }
+   void putU64(const std::uint64_t v)        { put(&v, sizeof(v)); }
+   void putF64(const double v)               { put(&v, sizeof(v)); }
+
+   void putStr(const char* const s)
+   {
+      const std::uint32_t n {s != nullptr ? static_cast<std::uint32_t>(std::strlen(s)) : 0};
+      putU32(n);
+      if (n > 0) put(s, n);
+   }
+
+private:
+   char* data {};
+   std::size_t len {};
+   std::size_t size {};
+};
+
+//------------------------------------------------------------------------------
+// InBuffer -- input buffer; all reads are bounds checked
+//------------------------------------------------------------------------------
+class InBuffer
+{
+public:
+   InBuffer(const char* const p, const std::size_t n) : cur(p), end(p + n) {}
+
+   bool isOk() const                         { return ok; }
+   bool isEnd() const                        { return (cur == end); }
+   void setError()                           { ok = false; }
+
+   bool get(void* const p, const std::size_t n)
+   {
+      if (ok && static_cast<std::size_t>(end - cur) >= n) {
+         std::memcpy(p, cur, n);
+         cur += n;
+      }
+      else {
+         ok = false;
+      }
+      return ok;
+   }
+
+   std::uint8_t getU8()                      { std::uint8_t v {};  get(&v, sizeof(v)); return v; }
+   std::uint32_t getU32()                    { std::uint32_t v {}; get(&v, sizeof(v)); return v; }
+   std::int32_t getI32()                     { std::int32_t v {};  get(&v, sizeof(v)); return v; }
+   std::uint64_t getU64()                    { std::uint64_t v {}; get(&v, sizeof(v)); return v; }
+   double getF64()                           { double v {};        get(&v, sizeof(v)); return v; }
+
+   // Checks that 'n' items of at least 'size' bytes each are left to
+   // read, so a bad count can't size an array beyond the snapshot
+   bool checkCount(const std::uint32_t n, const std::size_t size)
+   {
+      if (!ok || n > static_cast<std::size_t>(end - cur) / size) ok = false;
+      return ok;
+   }
+
+   std::string getStr()
+   {
+      const std::uint32_t n {getU32()};
+      std::string s;
+      if (ok && static_cast<std::size_t>(end - cur) >= n) {
+         s.assign(cur, n);
+         cur += n;
+      }
+      else {
+         ok = false;
+      }
+      return s;
+   }
+
+private:
+   const char* cur {};
+   const char* end {};
+   bool ok {true};
+};
+
+//------------------------------------------------------------------------------
+// Form lookup table (form object to form index), sorted by object address
+//------------------------------------------------------------------------------
+struct FormKey {
+   const Object* obj;
+   std::uint32_t index;
+};
+
+bool lessFormKey(const FormKey& a, const FormKey& b)
+{
+   return std::less<const Object*>()(a.obj, b.obj);
+}
+
+//------------------------------------------------------------------------------
+// Encoder -- writes the values
+//------------------------------------------------------------------------------
+class Encoder
+{
+public:
+   Encoder(OutBuffer* const b, const FormKey* const k, const unsigned int n) : buf(b), keys(k), numKeys(n) {}
+
+   bool isOk() const                         { return ok; }
+
+   void putValue(const Object* const v);
+
+private:
+   int findForm(const Object* const v) const;
+   void putList(const List* const list);
+
+   OutBuffer* buf {};
+   const FormKey* keys {};
+   unsigned int numKeys {};
+   bool ok {true};
+};
+
+int Encoder::findForm(const Object* const v) const
+{
+   FormKey key {v, 0};
+   const FormKey* k {std::lower_bound(keys, keys + numKeys, key, lessFormKey)};
+   return (k != keys + numKeys && k->obj == v) ? static_cast<int>(k->index) : -1;
+}
+
+void Encoder::putValue(const Object* const v)
+{
+   if (v == nullptr) {
+      buf->putU8(TAG_NONE);
+      return;
+   }
+
+   // Objects built from forms
+   const int form {findForm(v)};
+   if (form >= 0) {
+      buf->putU8(TAG_FORM);
+      buf->putU32(static_cast<std::uint32_t>(form));
+      return;
+   }
+
+   // Primitives (exact types only)
+   const std::type_info& type {typeid(*v)};
+   if (type == typeid(String)) {
+      buf->putU8(TAG_STRING);
+      buf->putStr(static_cast<const String*>(v)->getString());
+   }
+   else if (type == typeid(Identifier)) {
+      buf->putU8(TAG_IDENTIFIER);
+      buf->putStr(static_cast<const Identifier*>(v)->getString());
+   }
+   else if (type == typeid(Boolean)) {
+      buf->putU8(TAG_BOOLEAN);
+      buf->putU8(static_cast<const Boolean*>(v)->getBoolean() ? 1 : 0);
+   }
+   else if (type == typeid(Integer)) {
+      buf->putU8(TAG_INTEGER);
+      buf->putF64(static_cast<const Integer*>(v)->getReal());
+   }
+   else if (type == typeid(Float)) {
+      buf->putU8(TAG_FLOAT);
+      buf->putF64(static_cast<const Float*>(v)->getReal());
+   }
+   else if (type == typeid(List)) {
+      putList(static_cast<const List*>(v));
+   }
+   else if (type == typeid(PairStream)) {
+      const auto list = static_cast<const PairStream*>(v);
+      buf->putU8(TAG_PAIRSTREAM);
+      buf->putU32(list->entries());
+      const List::Item* item {list->getFirstItem()};
+      while (item != nullptr) {
+         putValue(item->getValue());
+         item = item->getNext();
+      }
+   }
+   else if (type == typeid(Pair)) {
+      const auto pair = static_cast<const Pair*>(v);
+      buf->putU8(TAG_PAIR);
+      buf->putStr(pair->slot()->getString());
+      putValue(pair->object());
+   }
+   else {
+      std::cerr << "EdlSnapshot: unsupported object type: " << type.name() << std::endl;
+      ok = false;
+   }
+}
+
+// Numeric lists are written as flat arrays of doubles
+void Encoder::putList(const List* const list)
+{
+   const unsigned int n {list->entries()};
+
+   // Integers, floats or both?
+   bool ints {};
+   bool floats {};
+   const List::Item* item {list->getFirstItem()};
+   while (item != nullptr) {
+      const std::type_info& type {typeid(*item->getValue())};
+      if (type == typeid(Integer)) ints = true;
+      else if (type == typeid(Float)) floats = true;
+      else {
+         std::cerr << "EdlSnapshot: unsupported list value type: " << type.name() << std::endl;
+         ok = false;
+      }
+      item = item->getNext();
+   }
+
+   buf->putU8(TAG_LIST);
+   buf->putU32(n);
+   if (ints && floats) {
+      buf->putU8(LIST_MIXED);
+      item = list->getFirstItem();
+      while (item != nullptr) {
+         buf->putU8(typeid(*item->getValue()) == typeid(Integer) ? TAG_INTEGER : TAG_FLOAT);
+         item = item->getNext();
+      }
+   }
+   else {
+      buf->putU8(ints ? LIST_INTEGERS : LIST_FLOATS);
+   }
+
+   item = list->getFirstItem();
+   while (item != nullptr) {
+      const auto num = dynamic_cast<const Number*>(item->getValue());
+      buf->putF64(num != nullptr ? num->getReal() : 0.0);
+      item = item->getNext();
+   }
+}
+
+//------------------------------------------------------------------------------
+// Decoder -- rebuilds the objects
+//------------------------------------------------------------------------------
+class Decoder
+{
+public:
+   Decoder(InBuffer* const b, factory_func f) : in(b), factory(f) {}
+   Decoder(const Decoder&) = delete;
+   Decoder& operator=(const Decoder&) = delete;
+   ~Decoder();
+
+   int getNumErrors() const                  { return errors; }
+
+   bool loadFactories();
+   bool loadForms();
+   Object* getValue();                       // Returns the value, which the caller unref()'s
+
+private:
+   struct Factory {
+      std::string name;                      // Factory name
+      std::string* slots;                    // Slot names
+      std::uint32_t numSlots;                // Number of slots
+      bool checked;                          // Slot names have been checked
+   };
+
+   Object* loadForm();
+   bool checkSlots(Factory* const fac, const Object* const obj);
+   void error(const std::string& msg);
+
+   InBuffer* in {};
+   factory_func factory {};
+
+   Factory* factories {};
+   std::uint32_t numFactories {};
+
+   Object** forms {};
+   std::uint32_t numForms {};                // Number of forms loaded
+   std::uint32_t maxForms {};
+
+   int errors {};
+};
+
+Decoder::~Decoder()
+{
+   for (std::uint32_t i = 0; i < numForms; i++) {
+      if (forms[i] != nullptr) forms[i]->unref();
+   }
+   delete[] forms;
+
+   for (std::uint32_t i = 0; i < numFactories; i++) {
+      delete[] factories[i].slots;
+   }
+   delete[] factories;
+}
+
+void Decoder::error(const std::string& msg)
+{
+   std::cerr << "edl_loader(): " << msg << std::endl;
+   errors++;
+}
+
+bool Decoder::loadFactories()
+{
+   // (each factory has at least its name's length and its number of slots)
+   const std::uint32_t n {in->getU32()};
+   if (!in->checkCount(n, 2 * sizeof(std::uint32_t))) return false;
+
+   factories = new Factory[n];
+   for (std::uint32_t i = 0; i < n && in->isOk(); i++) {
+      Factory& fac = factories[i];
+      fac.name = in->getStr();
+      fac.numSlots = in->getU32();
+      fac.slots = nullptr;
+      fac.checked = false;
+      numFactories++;
+      if (in->checkCount(fac.numSlots, sizeof(std::uint32_t))) {
+         fac.slots = new std::string[fac.numSlots];
+         for (std::uint32_t j = 0; j < fac.numSlots && in->isOk(); j++) {
+            fac.slots[j] = in->getStr();
+         }
+      }
+   }
+   return in->isOk();
+}
+
+bool Decoder::loadForms()
+{
+   // (each form has at least its factory index and its number of slots)
+   maxForms = in->getU32();
+   if (!in->checkCount(maxForms, 2 * sizeof(std::uint32_t))) return false;
+
+   forms = new Object*[maxForms];
+   bool ok {true};
+   while (ok && numForms < maxForms) {
+      forms[numForms] = loadForm();
+      numForms++;
+      ok = in->isOk();
+   }
+   return ok;
+}
+
+// Checks that the class' slot names still match the snapshot's
+bool Decoder::checkSlots(Factory* const fac, const Object* const obj)
+{
+   bool ok {true};
+   for (std::uint32_t i = 0; i < fac->numSlots && ok; i++) {
+      const char* name {obj->slotIndex2Name(static_cast<int>(i + 1))};
+      ok = (name != nullptr && fac->slots[i] == name);
+   }
+   if (ok) ok = (obj->slotIndex2Name(static_cast<int>(fac->numSlots + 1)) == nullptr);
+   fac->checked = true;
+   return ok;
+}
+
+Object* Decoder::loadForm()
+{
+   const std::uint32_t idx {in->getU32()};
+   const std::uint32_t nargs {in->getU32()};
+   if (!in->isOk() || idx >= numFactories) {
+      error("bad form");
+      return nullptr;
+   }
+   Factory* const fac {&factories[idx]};
+
+   // call user provided factory() to construct an object
+   Object* obj {factory(fac->name)};
+   if (obj == nullptr) {
+      error("undefined factory name: " + fac->name);
+   }
+   else if (!fac->checked && !checkSlots(fac, obj)) {
+      error("slots of '" + fac->name + "' don't match the snapshot; recompile it");
+      obj->unref();
+      obj = nullptr;
+   }
+
+   // set slots in our new object
+   for (std::uint32_t i = 0; i < nargs && in->isOk(); i++) {
+      const int slotindex {in->getI32()};
+      Object* const value {getValue()};
+      if (obj != nullptr) {
+         const bool ok {value != nullptr && obj->setSlotByNumber(slotindex, value)};
+         if (!ok) {
+            const char* name {obj->slotIndex2Name(slotindex)};
+            error("error while setting slot name: " + std::string(name != nullptr ? name : "?"));
+         }
+      }
+      if (value != nullptr) value->unref();
+   }
+
+   if (obj != nullptr && in->isOk() && !obj->isValid()) {
+      error("error: invalid object: " + fac->name);
+   }
+   return obj;
+}
+
+Object* Decoder::getValue()
+{
+   Object* v {};
+   const std::uint8_t tag {in->getU8()};
+   if (!in->isOk()) return v;
+
+   switch (tag) {
+      case TAG_NONE: {
+         break;
+      }
+      case TAG_FORM: {
+         const std::uint32_t idx {in->getU32()};
+         if (in->isOk() && idx < numForms) {
+            v = forms[idx];
+            if (v != nullptr) v->ref();
+         }
+         else {
+            error("bad form reference");
+         }
+         break;
+      }
+      case TAG_STRING: {
+         const std::string s {in->getStr()};
+         if (in->isOk()) v = new String(s.c_str());
+         break;
+      }
+      case TAG_IDENTIFIER: {
+         const std::string s {in->getStr()};
+         if (in->isOk()) v = new Identifier(s.c_str());
+         break;
+      }
+      case TAG_BOOLEAN: {
+         const std::uint8_t b {in->getU8()};
+         if (in->isOk()) v = new Boolean(b != 0);
+         break;
+      }
+      case TAG_INTEGER: {
+         const double d {in->getF64()};
+         if (in->isOk()) v = new Integer(static_cast<int>(d));
+         break;
+      }
+      case TAG_FLOAT: {
+         const double d {in->getF64()};
+         if (in->isOk()) v = new Float(d);
+         break;
+      }
+      case TAG_LIST: {
+         const std::uint32_t n {in->getU32()};
+         const std::uint8_t type {in->getU8()};
+         std::uint8_t* types {};
+         const std::size_t size {sizeof(double) + (type == LIST_MIXED ? sizeof(std::uint8_t) : 0)};
+         if (in->checkCount(n, size) && type == LIST_MIXED) {
+            types = new std::uint8_t[n];
+            in->get(types, n);
+         }
+         const auto list = new List();
+         for (std::uint32_t i = 0; i < n && in->isOk(); i++) {
+            const double d {in->getF64()};
+            bool isInt {type == LIST_INTEGERS};
+            if (types != nullptr) isInt = (types[i] == TAG_INTEGER);
+            Number* num {};
+            if (isInt) num = new Integer(static_cast<int>(d));
+            else num = new Float(d);
+            list->put(num);
+            num->unref();
+         }
+         delete[] types;
+         v = list;
+         break;
+      }
+      case TAG_PAIRSTREAM: {
+         const std::uint32_t n {in->getU32()};
+         const auto list = new PairStream();
+         for (std::uint32_t i = 0; i < n && in->isOk(); i++) {
+            Object* const p {getValue()};
+            const auto pair = dynamic_cast<Pair*>(p);
+            if (pair != nullptr) list->put(pair);
+            else error("bad pair");
+            if (p != nullptr) p->unref();
+         }
+         v = list;
+         break;
+      }
+      case TAG_PAIR: {
+         const std::string slot {in->getStr()};
+         Object* const obj {getValue()};
+         if (in->isOk()) v = new Pair(slot.c_str(), obj);
+         if (obj != nullptr) obj->unref();
+         break;
+      }
+      default: {
+         error("bad value tag");
+         in->setError();
+         break;
+      }
+   }
+   return v;
+}
+
+}
+
+//------------------------------------------------------------------------------
+// EdlSnapshot
+//------------------------------------------------------------------------------
+EdlSnapshot::~EdlSnapshot()
+{
+   for (unsigned int i = 0; i < numForms; i++) {
+      delete[] forms[i].name;
+      forms[i].obj->unref();
+      if (forms[i].args != nullptr) forms[i].args->unref();
+   }
+   delete[] forms;
+}
+
+//------------------------------------------------------------------------------
+// addForm() -- records a form: its factory name, its object and its slot values
+//------------------------------------------------------------------------------
+void EdlSnapshot::addForm(const char* const name, Object* const obj, PairStream* const args)
+{
+   if (name == nullptr || obj == nullptr) return;
+
+   if (numForms == maxForms) {
+      maxForms = (maxForms > 0 ? maxForms * 2 : 1024);
+      const auto newForms = new Form[maxForms];
+      for (unsigned int i = 0; i < numForms; i++) newForms[i] = forms[i];
+      delete[] forms;
+      forms = newForms;
+   }
+
+   Form& form = forms[numForms++];
+   const std::size_t len {std::strlen(name)};
+   form.name = new char[len + 1];
+   std::memcpy(form.name, name, len + 1);
+   form.obj = obj;
+   obj->ref();
+   form.args = args;
+   if (args != nullptr) args->ref();
+}
+
+//------------------------------------------------------------------------------
+// write() -- writes the snapshot of the recorded forms
+//------------------------------------------------------------------------------
+bool EdlSnapshot::write(const std::string& filename, const Object* const result, const std::string& source)
+{
+   std::uint64_t srcSize {};
+   std::uint64_t srcHash {};
+   if (!hashFile(source, &srcSize, &srcHash)) {
+      std::cerr << "EdlSnapshot::write(): unable to read EDL file: " << source << std::endl;
+      return false;
+   }
+
+   // Form lookup table
+   const auto keys = new FormKey[numForms > 0 ? numForms : 1];
+   for (unsigned int i = 0; i < numForms; i++) {
+      keys[i].obj = forms[i].obj;
+      keys[i].index = i;
+   }
+   std::sort(keys, keys + numForms, lessFormKey);
+
+   // Factory name table: the index of each form's factory name, and the first
+   // form of each factory name (for its slot names)
+   const auto formFactory = new std::uint32_t[numForms > 0 ? numForms : 1];
+   const auto firstForm = new unsigned int[numForms > 0 ? numForms : 1];
+   std::uint32_t numFactories {};
+   for (unsigned int i = 0; i < numForms; i++) {
+      std::uint32_t j {};
+      while (j < numFactories && std::strcmp(forms[firstForm[j]].name, forms[i].name) != 0) j++;
+      if (j == numFactories) firstForm[numFactories++] = i;
+      formFactory[i] = j;
+   }
+
+   OutBuffer buf;
+
+   // Header
+   buf.put(MAGIC, sizeof(MAGIC));
+   buf.putU32(VERSION);
+   buf.putU32(BYTE_ORDER_MARK);
+   buf.putU64(srcSize);
+   buf.putU64(srcHash);
+
+   // Factory names and their slot names
+   buf.putU32(numFactories);
+   for (std::uint32_t j = 0; j < numFactories; j++) {
+      const Form& form = forms[firstForm[j]];
+      buf.putStr(form.name);
+      std::uint32_t n {};
+      while (form.obj->slotIndex2Name(static_cast<int>(n + 1)) != nullptr) n++;
+      buf.putU32(n);
+      for (std::uint32_t k = 1; k <= n; k++) {
+         buf.putStr(form.obj->slotIndex2Name(static_cast<int>(k)));
+      }
+   }
+
+   // Forms, with their slot indices and values
+   Encoder encoder(&buf, keys, numForms);
+   buf.putU32(numForms);
+   for (unsigned int i = 0; i < numForms && encoder.isOk(); i++) {
+      const Form& form = forms[i];
+      buf.putU32(formFactory[i]);
+      buf.putU32(form.args != nullptr ? form.args->entries() : 0);
+      if (form.args != nullptr) {
+         const List::Item* item {form.args->getFirstItem()};
+         while (item != nullptr) {
+            const auto p = static_cast<const Pair*>(item->getValue());
+            buf.putI32(form.obj->slotName2Index(*p->slot()));
+            encoder.putValue(p->object());
+            item = item->getNext();
+         }
+      }
+   }
+
+   // Result
+   encoder.putValue(result);
+
+   delete[] firstForm;
+   delete[] formFactory;
+   delete[] keys;
+
+   bool ok {encoder.isOk()};
+   if (ok) {
+      std::ofstream fout(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+      ok = fout.is_open();
+      if (ok) {
+         fout.write(buf.getData(), static_cast<std::streamsize>(buf.getLength()));
+         ok = fout.good();
+         fout.close();
+      }
+      if (!ok) {
+         std::cerr << "EdlSnapshot::write(): unable to write snapshot file: " << filename << std::endl;
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// load() -- rebuilds the objects from snapshot file 'filename'
+//------------------------------------------------------------------------------
+Object* EdlSnapshot::load(const std::string& filename, factory_func f, const std::string& source, int* const num_errors)
+{
+   if (num_errors != nullptr) *num_errors = 0;
+   if (f == nullptr) f = FactoryTable::createObject;
+
+   // Read the whole file
+   std::ifstream fin(filename, std::ios::in | std::ios::binary);
+   if (!fin.is_open()) return nullptr;
+   fin.seekg(0, std::ios::end);
+   const std::streamoff len {fin.tellg()};
+   fin.seekg(0, std::ios::beg);
+   if (len <= 0) return nullptr;
+   const auto data = new char[static_cast<std::size_t>(len)];
+   fin.read(data, len);
+   const bool readOk {fin.good()};
+   fin.close();
+
+   InBuffer in(data, readOk ? static_cast<std::size_t>(len) : 0);
+
+   // Header
+   char magic[sizeof(MAGIC)] {};
+   in.get(magic, sizeof(magic));
+   const std::uint32_t version {in.getU32()};
+   const std::uint32_t bom {in.getU32()};
+   const std::uint64_t srcSize {in.getU64()};
+   const std::uint64_t srcHash {in.getU64()};
+
+   bool ok {in.isOk() && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 && version == VERSION && bom == BYTE_ORDER_MARK};
+   if (!ok) {
+      std::cerr << "edl_loader(): not a snapshot file, or from a different version or byte order: " << filename << std::endl;
+      if (num_errors != nullptr) *num_errors = 1;
+   }
+
+   // Out of date with the EDL file?  (not an error; the caller parses the EDL file)
+   if (ok && !source.empty()) {
+      std::uint64_t size {};
+      std::uint64_t hash {};
+      ok = hashFile(source, &size, &hash) && size == srcSize && hash == srcHash;
+   }
+
+   Object* obj {};
+   if (ok) {
+      Decoder decoder(&in, f);
+      ok = decoder.loadFactories() && decoder.loadForms();
+      if (ok) obj = decoder.getValue();
+      if (!in.isOk() || !in.isEnd()) {
+         std::cerr << "edl_loader(): bad or truncated snapshot file: " << filename << std::endl;
+         if (obj != nullptr) obj->unref();
+         obj = nullptr;
+      }
+      if (num_errors != nullptr) {
+         *num_errors = decoder.getNumErrors();
+         if (obj == nullptr && *num_errors == 0) *num_errors = 1;
+      }
+   }
+
+   delete[] data;
+   return obj;
+}
+
+//------------------------------------------------------------------------------
+// hashFile() -- size and FNV-1a hash of a file's contents
+//------------------------------------------------------------------------------
+bool EdlSnapshot::hashFile(const std::string& filename, std::uint64_t* const size, std::uint64_t* const hash)
+{
+   std::ifstream fin(filename, std::ios::in | std::ios::binary);
+   if (!fin.is_open()) return false;
+
+   std::uint64_t h {0xcbf29ce484222325ULL};
+   std::uint64_t n {};
+   const std::size_t BUF_SIZE {65536};
+   const auto buf = new unsigned char[BUF_SIZE];
+   while (fin) {
+      fin.read(reinterpret_cast<char*>(buf), BUF_SIZE);
+      const std::streamsize cnt {fin.gcount()};
+      for (std::streamsize i = 0; i < cnt; i++) {
+         h ^= buf[i];
+         h *= 0x100000001b3ULL;
+      }
+      n += static_cast<std::uint64_t>(cnt);
+   }
+   delete[] buf;
+   fin.close();
+
+   *size = n;
+   *hash = h;
+   return true;
+}
+
+}
+}
@@ -0,0 +1,84 @@
+
+#ifndef __mixr_base_edl_parser_EdlSnapshot_H__
+#define __mixr_base_edl_parser_EdlSnapshot_H__
+
+#include "mixr/base/edl_parser.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace mixr {
+namespace base {
+class Object;
+class PairStream;
+
+//------------------------------------------------------------------------------
+// Class: EdlSnapshot
+//
+// Description: Binary snapshot of the objects that were built by the EDL
+//              parser (see edl_compiler() and edl_loader()).
+//
+//    While compiling, the parser passes each form -- its factory name, the
+//    new object and its list of slot values -- to addForm(), in the order
+//    that they're built (i.e., inner forms first), and write() then writes
+//    the snapshot file:
+//
+//       header      magic "MIXREDLS", version, byte order mark, and the size
+//                   and FNV-1a hash of the EDL file
+//
+//       factories   table of the factory names, each with its class' slot
+//                   names, which are used to check that the slot indices
+//                   still match the classes
+//
+//       forms       factory name index, and the slot index and value of each
+//                   slot; forms are referenced by their index in the table
+//
+//       result      the parser's result (i.e., a form, a Pair or a PairStream)
+//
+//    Values are tagged: forms, strings, identifiers, booleans, numbers,
+//    numeric lists (flat arrays of doubles), PairStreams and Pairs.
+//
+//    load() rebuilds the same objects: each form's object is created by the
+//    factory function and its slots are set by index (i.e., no slot name
+//    lookup).
+//------------------------------------------------------------------------------
+class EdlSnapshot
+{
+public:
+   static const std::uint32_t VERSION = 1;
+
+public:
+   EdlSnapshot() = default;
+   EdlSnapshot(const EdlSnapshot&) = delete;
+   EdlSnapshot& operator=(const EdlSnapshot&) = delete;
+   ~EdlSnapshot();
+
+   // Records a form: its factory name, its object and its slot values
+   void addForm(const char* const name, Object* const obj, PairStream* const args);
+
+   // Writes the snapshot of the recorded forms, with the parser's 'result',
+   // that was compiled from EDL file 'source'
+   bool write(const std::string& filename, const Object* const result, const std::string& source);
+
+   // Rebuilds the objects from snapshot file 'filename'
+   static Object* load(const std::string& filename, factory_func f, const std::string& source, int* const num_errors);
+
+   // Size and FNV-1a hash of a file's contents
+   static bool hashFile(const std::string& filename, std::uint64_t* const size, std::uint64_t* const hash);
+
+private:
+   struct Form {
+      char* name;             // Factory name
+      Object* obj;            // Object (ref()'d)
+      PairStream* args;       // Slot values (ref()'d)
+   };
+
+   Form* forms {};
+   unsigned int numForms {};
+   unsigned int maxForms {};
+};
+
+}
+}
+
+#endif
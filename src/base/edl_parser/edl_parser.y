@@ -23,6 +23,7 @@
 #include <fstream>
 
 #include "mixr/base/edl_parser.hpp"
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 #include "mixr/base/String.hpp"
 #include "mixr/base/Identifier.hpp"
@@ -33,11 +34,13 @@
 #include "mixr/base/PairStream.hpp"
 #include "mixr/base/List.hpp"
 #include "EdlScanner.hpp"
+#include "EdlSnapshot.hpp"
 
 static mixr::base::Object* result {};          // result of all our work (i.e., an Object)
 static mixr::base::EdlScanner* scanner {};     // edl scanner
 static mixr::base::factory_func factory {};    // factory function 
 static int err_count {};                       // error count
+static mixr::base::EdlSnapshot* snapshot {};   // snapshot of the parsed forms (edl_compiler() only)
 
 //------------------------------------------------------------------------------
 // yylex() -- user defined; used by the parser to call the lexical generator
@@ -98,6 +101,11 @@ static mixr::base::Object* parse(const std::string& name, mixr::base::PairStream
             std::string msg = "undefined factory name: " + name;
             yyerror(msg.c_str());
         }
+
+        // record the form for the snapshot
+        if (snapshot != nullptr && obj != nullptr) {
+            snapshot->addForm(name.c_str(), obj, arg_list);
+        }
     }
     return obj;
 }
@@ -200,12 +208,13 @@ namespace base {
 
 //------------------------------------------------------------------------------
 // Returns an Object* that was constructed from parsing an EDL file.
-// factory is the name of the Object creation function  
+// factory is the name of the Object creation function, or nullptr to use
+// the registered factory tables (see FactoryTable::createObject())
 //------------------------------------------------------------------------------
 Object* edl_parser(const std::string& filename, factory_func f, int* num_errors)
 {
     // set the global file scope static variables
-    factory = f;
+    factory = (f != nullptr) ? f : FactoryTable::createObject;
     result = nullptr;
     err_count = 0;
 
@@ -232,6 +241,44 @@ Object* edl_parser(const std::string& filename, factory_func f, int* num_errors)
     return obj;
 }
 
+//------------------------------------------------------------------------------
+// Returns an Object* that was constructed from parsing an EDL file, same as
+// edl_parser(), and, if there were no errors, writes a binary snapshot of the
+// parsed objects to file 'snapshot_file' (see edl_loader()).
+//------------------------------------------------------------------------------
+Object* edl_compiler(const std::string& filename, factory_func f, const std::string& snapshot_file, int* num_errors)
+{
+    snapshot = new EdlSnapshot();
+
+    int errors {};
+    Object* obj {edl_parser(filename, f, &errors)};
+    if (obj != nullptr && errors == 0) {
+        snapshot->write(snapshot_file, obj, filename);
+    }
+    else {
+        std::cerr << "edl_compiler(): snapshot not written; errors while parsing: " << filename << std::endl;
+    }
+
+    delete snapshot;
+    snapshot = nullptr;
+
+    if (num_errors != nullptr) {
+        *num_errors = errors;
+    }
+    return obj;
+}
+
+//------------------------------------------------------------------------------
+// Returns an Object* that was rebuilt from the binary snapshot file,
+// 'snapshot_file', written by edl_compiler().  If the EDL file name is
+// given, nullptr is returned if the snapshot wasn't compiled from the
+// current contents of the EDL file.
+//------------------------------------------------------------------------------
+Object* edl_loader(const std::string& snapshot_file, factory_func f, int* num_errors, const std::string& filename)
+{
+    return EdlSnapshot::load(snapshot_file, f, filename, num_errors);
+}
+
 }
 }
 
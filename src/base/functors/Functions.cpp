@@ -11,6 +11,7 @@
 #include "mixr/base/List.hpp"
 #include "mixr/base/functors/Tables.hpp"
 #include <iostream>
+#include <typeinfo>
 
 namespace mixr {
 namespace base {
@@ -39,6 +40,20 @@ double Func1::f(const double iv1, FStorage* const s) const
    return value;
 }
 
+void Func1::fArray(const double* const iv1, double* const values, const unsigned int n, FStorage* const s) const
+{
+   const auto p = static_cast<const Table1*>(getTable());
+   if (p != nullptr && typeid(*this) == typeid(Func1)) {
+      // Not a derived class, so f() would use the table too; do them all at once
+      p->lfiArray(iv1, values, n, s);
+   }
+   else {
+      for (unsigned int i = 0; i < n; i++) {
+         values[i] = f(iv1[i], s);
+      }
+   }
+}
+
 bool Func1::setSlotLfiTable(const Table* const msg)
 {
    bool ok {};
@@ -78,6 +93,20 @@ double Func2::f(const double iv1, const double iv2, FStorage* const s) const
    return value;
 }
 
+void Func2::fArray(const double* const iv1, const double* const iv2, double* const values, const unsigned int n, FStorage* const s) const
+{
+   const auto p = static_cast<const Table2*>(getTable());
+   if (p != nullptr && typeid(*this) == typeid(Func2)) {
+      // Not a derived class, so f() would use the table too; do them all at once
+      p->lfiArray(iv1, iv2, values, n, s);
+   }
+   else {
+      for (unsigned int i = 0; i < n; i++) {
+         values[i] = f(iv1[i], iv2[i], s);
+      }
+   }
+}
+
 bool Func2::setSlotLfiTable(const Table* const msg)
 {
    bool ok {};
@@ -117,6 +146,20 @@ double Func3::f(const double iv1, const double iv2, const double iv3, FStorage*
    return value;
 }
 
+void Func3::fArray(const double* const iv1, const double* const iv2, const double* const iv3, double* const values, const unsigned int n, FStorage* const s) const
+{
+   const auto p = static_cast<const Table3*>(getTable());
+   if (p != nullptr && typeid(*this) == typeid(Func3)) {
+      // Not a derived class, so f() would use the table too; do them all at once
+      p->lfiArray(iv1, iv2, iv3, values, n, s);
+   }
+   else {
+      for (unsigned int i = 0; i < n; i++) {
+         values[i] = f(iv1[i], iv2[i], iv3[i], s);
+      }
+   }
+}
+
 bool Func3::setSlotLfiTable(const Table* const msg)
 {
    bool ok {};
@@ -157,6 +200,20 @@ double Func4::f(const double iv1, const double iv2, const double iv3, const doub
    return value;
 }
 
+void Func4::fArray(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, double* const values, const unsigned int n, FStorage* const s) const
+{
+   const auto p = static_cast<const Table4*>(getTable());
+   if (p != nullptr && typeid(*this) == typeid(Func4)) {
+      // Not a derived class, so f() would use the table too; do them all at once
+      p->lfiArray(iv1, iv2, iv3, iv4, values, n, s);
+   }
+   else {
+      for (unsigned int i = 0; i < n; i++) {
+         values[i] = f(iv1[i], iv2[i], iv3[i], iv4[i], s);
+      }
+   }
+}
+
 bool Func4::setSlotLfiTable(const Table* const msg)
 {
    bool ok {};
@@ -197,6 +254,20 @@ double Func5::f(const double iv1, const double iv2, const double iv3, const doub
    return value;
 }
 
+void Func5::fArray(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4, const double* const iv5, double* const values, const unsigned int n, FStorage* const s) const
+{
+   const auto p = static_cast<const Table5*>(getTable());
+   if (p != nullptr && typeid(*this) == typeid(Func5)) {
+      // Not a derived class, so f() would use the table too; do them all at once
+      p->lfiArray(iv1, iv2, iv3, iv4, iv5, values, n, s);
+   }
+   else {
+      for (unsigned int i = 0; i < n; i++) {
+         values[i] = f(iv1[i], iv2[i], iv3[i], iv4[i], iv5[i], s);
+      }
+   }
+}
+
 bool Func5::setSlotLfiTable(const Table* const msg)
 {
    bool ok {};
@@ -5,6 +5,9 @@
 #include "mixr/base/List.hpp"
 #include "mixr/base/Pair.hpp"
 
+#include <atomic>
+#include <new>
+
 namespace mixr {
 namespace base {
 
@@ -55,7 +58,7 @@ Table::Table(const double* dtbl, const unsigned int dsize)
 {
     STANDARD_CONSTRUCTOR()
     if (dtbl != nullptr && dsize > 0) {   // copy the data table
-        dtable = new double[dsize];
+        dtable = newArray(dsize);
         if (dtable != nullptr) {
             for (unsigned int i = 0; i < dsize; i++) {
                 dtable[i] = dtbl[i];
@@ -93,19 +96,16 @@ void Table::copyData(const Table& org, const bool cc)
 {
     BaseClass::copyData(org);
 
-    // Delete old data
+    // Release old data
     if ( !cc && dtable != nullptr ) {
-        delete[] dtable;
+        releaseArray(dtable);
         dtable = nullptr;
     }
 
-    // Copy new data
+    // Share the new data
     nd = org.nd;
     if (org.dtable != nullptr) {
-        dtable = new double[nd];
-        for (unsigned int i = 0; i < nd; i++) {
-            dtable[i] = org.dtable[i];
-        }
+        dtable = shareArray(org.dtable);
     } else {
         dtable = nullptr;
     }
@@ -115,7 +115,7 @@ void Table::copyData(const Table& org, const bool cc)
 
 void Table::deleteData()
 {
-    if (dtable != nullptr) delete[] dtable;
+    if (dtable != nullptr) releaseArray(dtable);
     dtable = nullptr;
     nd = 0;
 }
@@ -180,22 +180,61 @@ bool Table::loadVector(const List& list, double** table, unsigned int* nn)
     unsigned int n {list.entries()};
     if (n <= 0) return false;
 
-    const auto p = new double[n];
+    const auto p = newArray(n);
     unsigned int n2 = list.getNumberList(p, n);
     bool ok = (n == n2);
     if (ok) {
-        // Have the data!
+        // Have the data! (replaces any old table)
+        if (*table != nullptr) releaseArray(*table);
         *table = p;
         *nn = n;
     }
     else {
         // Something is wrong, free the table
-        delete[] p;
+        releaseArray(p);
         throw new ExpInvalidVector();     // invalid vector - throw an exception
     }
     return ok;
 }
 
+//------------------------------------------------------------------------------
+// Shared data and breakpoint arrays -- each array is preceded by a header
+// with its (atomic) reference count, which is padded to keep the array aligned
+//------------------------------------------------------------------------------
+namespace {
+   typedef std::atomic<unsigned int> ArrayRefCount;
+   const std::size_t ARRAY_HDR_SIZE = 16;
+   static_assert(sizeof(ArrayRefCount) <= ARRAY_HDR_SIZE, "array header is too small");
+}
+
+double* Table::newArray(const unsigned int n)
+{
+    char* const buff = new char[ARRAY_HDR_SIZE + n * sizeof(double)];
+    new (buff) ArrayRefCount(1);
+    return reinterpret_cast<double*>(buff + ARRAY_HDR_SIZE);
+}
+
+double* Table::shareArray(double* const array)
+{
+    if (array != nullptr) {
+        char* const buff = reinterpret_cast<char*>(array) - ARRAY_HDR_SIZE;
+        reinterpret_cast<ArrayRefCount*>(buff)->fetch_add(1, std::memory_order_relaxed);
+    }
+    return array;
+}
+
+void Table::releaseArray(double* const array)
+{
+    if (array != nullptr) {
+        char* const buff = reinterpret_cast<char*>(array) - ARRAY_HDR_SIZE;
+        ArrayRefCount* const refs = reinterpret_cast<ArrayRefCount*>(buff);
+        if (refs->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            refs->~ArrayRefCount();
+            delete[] buff;
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 //  setDataTable() -- for Table
 //------------------------------------------------------------------------------
@@ -209,18 +248,18 @@ bool Table::setDataTable(const List* const sdtobj)
         const unsigned int ts {tableSize()};
         if (ts > 0) {
             // Allocate table space and load the table
-            const auto p = new double[ts];
+            const auto p = newArray(ts);
             ok = loadData(*sdtobj, p);
             if (ok) {
                 // Loading completed, so
                 // free up any old data and set to the new.
-                if (dtable != nullptr) delete[] dtable;
+                if (dtable != nullptr) releaseArray(dtable);
                 dtable = p;
                 nd = ts;
             }
             else {
                 // Something is wrong!
-                delete[] p;
+                releaseArray(p);
                 std::cerr << "Table::setDataTable: Something is wrong!  Data table aborted." << std::endl;
                 ok = false;
             }
@@ -39,7 +39,7 @@ Table1::Table1(const double* dtbl, const unsigned int dsize,
 {
     STANDARD_CONSTRUCTOR()
     if (xtbl != nullptr && xsize > 0) {   /* Copy the x breakpoints */
-        xtable = new double[xsize];
+        xtable = newArray(xsize);
         if (xtable != nullptr) {
             for (unsigned int i = 0; i < xsize; i++) xtable[i] = xtbl[i];
             nx = xsize;
@@ -52,14 +52,13 @@ void Table1::copyData(const Table1& org, const bool cc)
 {
     BaseClass::copyData(org);
 
-    // Delete old data
-    if (!cc && xtable != nullptr) { delete[] xtable; xtable = nullptr; }
+    // Release old data
+    if (!cc && xtable != nullptr) { releaseArray(xtable); xtable = nullptr; }
 
-    // Copy new data
+    // Share new data
     nx = org.nx;
     if (org.xtable != nullptr) {
-        xtable = new double[nx];
-        for (unsigned int i = 0; i < nx; i++) xtable[i] = org.xtable[i];
+        xtable = shareArray(org.xtable);
     }
     else xtable = nullptr;
     valid = isValid();
@@ -67,7 +66,7 @@ void Table1::copyData(const Table1& org, const bool cc)
 
 void Table1::deleteData()
 {
-    if (xtable != nullptr) delete[] xtable;
+    if (xtable != nullptr) releaseArray(xtable);
     xtable = nullptr;
     nx = 0;
 }
@@ -151,6 +150,21 @@ Table1::lfi(const double iv1, FStorage* const f) const
    }
 }
 
+void Table1::lfiArray(const double* const iv1, double* const values, const unsigned int n, FStorage* const f) const
+{
+   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
+
+   if (f != nullptr) {
+      const auto s = dynamic_cast<TableStorage*>(f);
+      if (s == nullptr) throw new ExpInvalidFStorage();
+
+      lfi_1D_array(iv1, values, n, getXData(), getNumXPoints(), getDataTable(), isExtrapolationEnabled(), &s->xbp);
+   }
+   else {
+      lfi_1D_array(iv1, values, n, getXData(), getNumXPoints(), getDataTable(), isExtrapolationEnabled());
+   }
+}
+
 //------------------------------------------------------------------------------
 // setXBreakpoints1() -- for Table1
 //------------------------------------------------------------------------------
@@ -191,7 +205,7 @@ Table2::Table2(const double* dtbl, const unsigned int dsize,
 {
     STANDARD_CONSTRUCTOR()
     if (ytbl != nullptr && ysize > 0) {   /* Copy the y breakpoints */
-        ytable = new double[ysize];
+        ytable = newArray(ysize);
         if (ytable != nullptr) {
             for (unsigned int i = 0; i < ysize; i++) ytable[i] = ytbl[i];
             ny = ysize;
@@ -204,14 +218,13 @@ void Table2::copyData(const Table2& org, const bool cc)
 {
     BaseClass::copyData(org);
 
-    // Delete old data
-    if (!cc && ytable != nullptr) { delete[] ytable; ytable = nullptr; }
+    // Release old data
+    if (!cc && ytable != nullptr) { releaseArray(ytable); ytable = nullptr; }
 
-    // Copy new data
+    // Share new data
     ny = org.ny;
     if (org.ytable != nullptr) {
-        ytable = new double[ny];
-        for (unsigned int i = 0; i < ny; i++) ytable[i] = org.ytable[i];
+        ytable = shareArray(org.ytable);
     }
     else ytable = nullptr;
     valid = isValid();
@@ -219,7 +232,7 @@ void Table2::copyData(const Table2& org, const bool cc)
 
 void Table2::deleteData()
 {
-    if (ytable != nullptr) delete[] ytable;
+    if (ytable != nullptr) releaseArray(ytable);
     ytable = nullptr;
     ny = 0;
 }
@@ -333,6 +346,26 @@ double Table2::lfi(const double iv1, const double iv2, FStorage* const f) const
    }
 }
 
+void Table2::lfiArray(const double* const iv1, const double* const iv2, double* const values, const unsigned int n, FStorage* const f) const
+{
+   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
+
+   if (f != nullptr) {
+      const auto s = dynamic_cast<TableStorage*>(f);
+      if (s == nullptr) throw new ExpInvalidFStorage();
+
+      lfi_2D_array( iv1, iv2, values, n, getXData(), getNumXPoints(), getYData(),
+                        getNumYPoints(), getDataTable(),
+                        isExtrapolationEnabled(),
+                        &s->xbp, &s->ybp );
+   }
+   else {
+      lfi_2D_array( iv1, iv2, values, n, getXData(), getNumXPoints(), getYData(),
+                        getNumYPoints(), getDataTable(),
+                        isExtrapolationEnabled() );
+   }
+}
+
 //------------------------------------------------------------------------------
 // setYBreakpoints2() -- for Table2
 //------------------------------------------------------------------------------
@@ -374,7 +407,7 @@ Table3::Table3(const double* dtbl, const unsigned int dsize,
 {
     STANDARD_CONSTRUCTOR()
     if (ztbl != nullptr && zsize > 0) {   /* Copy the z breakpoints */
-        ztable = new double[zsize];
+        ztable = newArray(zsize);
         if (ztable != nullptr) {
             for (unsigned int i = 0; i < zsize; i++) ztable[i] = ztbl[i];
             nz = zsize;
@@ -387,14 +420,13 @@ void Table3::copyData(const Table3& org, const bool cc)
 {
     BaseClass::copyData(org);
 
-    // Delete old data
-    if (!cc && ztable != nullptr) { delete[] ztable; ztable = nullptr; }
+    // Release old data
+    if (!cc && ztable != nullptr) { releaseArray(ztable); ztable = nullptr; }
 
-    // Copy new data
+    // Share new data
     nz = org.nz;
     if (org.ztable != nullptr) {
-        ztable = new double[nz];
-        for (unsigned int i = 0; i < nz; i++) ztable[i] = org.ztable[i];
+        ztable = shareArray(org.ztable);
     }
     else ztable = nullptr;
     valid = isValid();
@@ -402,7 +434,7 @@ void Table3::copyData(const Table3& org, const bool cc)
 
 void Table3::deleteData()
 {
-    if (ztable != nullptr) delete[] ztable;
+    if (ztable != nullptr) releaseArray(ztable);
     ztable = nullptr;
     nz = 0;
 }
@@ -539,6 +571,27 @@ double Table3::lfi(const double iv1, const double iv2, const double iv3, FStorag
    }
 }
 
+void Table3::lfiArray(const double* const iv1, const double* const iv2, const double* const iv3,
+                      double* const values, const unsigned int n, FStorage* const f) const
+{
+   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
+
+   if (f != nullptr) {
+      const auto s = dynamic_cast<TableStorage*>(f);
+      if (s == nullptr) throw new ExpInvalidFStorage();
+
+      lfi_3D_array( iv1, iv2, iv3, values, n, getXData(), getNumXPoints(), getYData(),
+                        getNumYPoints(), getZData(), getNumZPoints(),
+                        getDataTable(), isExtrapolationEnabled(),
+                        &s->xbp, &s->ybp, &s->zbp );
+   }
+   else {
+      lfi_3D_array( iv1, iv2, iv3, values, n, getXData(), getNumXPoints(), getYData(),
+                        getNumYPoints(), getZData(), getNumZPoints(),
+                        getDataTable(), isExtrapolationEnabled() );
+   }
+}
+
 //------------------------------------------------------------------------------
 // setZBreakpoints3() -- for Table3
 //------------------------------------------------------------------------------
@@ -580,7 +633,7 @@ Table4::Table4(const double* dtbl, const unsigned int dsize,
 {
     STANDARD_CONSTRUCTOR()
     if (wtbl != nullptr && wsize > 0) {   /* Copy the w breakpoints */
-        wtable = new double[wsize];
+        wtable = newArray(wsize);
         if (wtable != nullptr) {
             for (unsigned int i = 0; i < wsize; i++) wtable[i] = wtbl[i];
             nw = wsize;
@@ -593,14 +646,13 @@ void Table4::copyData(const Table4& org, const bool cc)
 {
     BaseClass::copyData(org);
 
-    // Delete old data
-    if (!cc && wtable != nullptr) { delete[] wtable; wtable = nullptr; }
+    // Release old data
+    if (!cc && wtable != nullptr) { releaseArray(wtable); wtable = nullptr; }
 
-    // Copy new data
+    // Share new data
     nw = org.nw;
     if (org.wtable != nullptr) {
-        wtable = new double[nw];
-        for (unsigned int i = 0; i < nw; i++) wtable[i] = org.wtable[i];
+        wtable = shareArray(org.wtable);
     }
     else wtable = nullptr;
     valid = isValid();
@@ -608,7 +660,7 @@ void Table4::copyData(const Table4& org, const bool cc)
 
 void Table4::deleteData()
 {
-    if (wtable != nullptr) delete[] wtable;
+    if (wtable != nullptr) releaseArray(wtable);
     wtable = nullptr;
     nw = 0;
 }
@@ -788,6 +840,29 @@ double Table4::lfi(const double iv1, const double iv2, const double iv3, const d
    }
 }
 
+void Table4::lfiArray(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4,
+                      double* const values, const unsigned int n, FStorage* const f) const
+{
+   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
+
+   if (f != nullptr) {
+      const auto s = dynamic_cast<TableStorage*>(f);
+      if (s == nullptr) throw new ExpInvalidFStorage();
+
+      lfi_4D_array( iv1, iv2, iv3, iv4, values, n, getXData(), getNumXPoints(),
+                        getYData(), getNumYPoints(), getZData(),
+                        getNumZPoints(), getWData(), getNumWPoints(),
+                        getDataTable(), isExtrapolationEnabled(),
+                        &s->xbp, &s->ybp, &s->zbp, &s->wbp );
+   }
+   else {
+      lfi_4D_array( iv1, iv2, iv3, iv4, values, n, getXData(), getNumXPoints(),
+                        getYData(), getNumYPoints(), getZData(),
+                        getNumZPoints(), getWData(), getNumWPoints(),
+                        getDataTable(), isExtrapolationEnabled() );
+   }
+}
+
 //------------------------------------------------------------------------------
 // setWBreakpoints4() -- For Table4
 //------------------------------------------------------------------------------
@@ -832,7 +907,7 @@ Table5::Table5(const double* dtbl, const unsigned int dsize,
 {
     STANDARD_CONSTRUCTOR()
     if (vtbl != nullptr && vsize > 0) {   /* Copy the v breakpoints */
-        vtable = new double[vsize];
+        vtable = newArray(vsize);
         if (vtable != nullptr) {
             for (unsigned int i = 0; i < vsize; i++) vtable[i] = vtbl[i];
             nv = vsize;
@@ -845,14 +920,13 @@ void Table5::copyData(const Table5& org, const bool cc)
 {
     BaseClass::copyData(org);
 
-    // Delete old data
-    if (!cc && vtable != nullptr) { delete[] vtable; vtable = nullptr; }
+    // Release old data
+    if (!cc && vtable != nullptr) { releaseArray(vtable); vtable = nullptr; }
 
-    // Copy new data
+    // Share new data
     nv = org.nv;
     if (org.vtable != nullptr) {
-        vtable = new double[nv];
-        for (unsigned int i = 0; i < nv; i++) vtable[i] = org.vtable[i];
+        vtable = shareArray(org.vtable);
     }
     else vtable = nullptr;
     valid = isValid();
@@ -860,7 +934,7 @@ void Table5::copyData(const Table5& org, const bool cc)
 
 void Table5::deleteData()
 {
-    if (vtable != nullptr) delete[] vtable;
+    if (vtable != nullptr) releaseArray(vtable);
     vtable = nullptr;
     nv = 0;
 }
@@ -1059,6 +1133,31 @@ double Table5::lfi(const double iv1, const double iv2, const double iv3, const d
    }
 }
 
+void Table5::lfiArray(const double* const iv1, const double* const iv2, const double* const iv3, const double* const iv4,
+                      const double* const iv5, double* const values, const unsigned int n, FStorage* const f) const
+{
+   if (!valid) throw new ExpInvalidTable(); // Not valid - throw an exception
+
+   if (f != nullptr) {
+      const auto s = dynamic_cast<TableStorage*>(f);
+      if (s == nullptr) throw new ExpInvalidFStorage();
+
+      lfi_5D_array( iv1, iv2, iv3, iv4, iv5, values, n, getXData(), getNumXPoints(),
+                        getYData(), getNumYPoints(), getZData(),
+                        getNumZPoints(), getWData(), getNumWPoints(),
+                        getVData(), getNumVPoints(),
+                        getDataTable(), isExtrapolationEnabled(),
+                        &s->xbp, &s->ybp, &s->zbp, &s->wbp, &s->vbp );
+   }
+   else {
+      lfi_5D_array( iv1, iv2, iv3, iv4, iv5, values, n, getXData(), getNumXPoints(),
+                        getYData(), getNumYPoints(), getZData(),
+                        getNumZPoints(), getWData(), getNumWPoints(),
+                        getVData(), getNumVPoints(),
+                        getDataTable(), isExtrapolationEnabled() );
+   }
+}
+
 //------------------------------------------------------------------------------
 // setVBreakpoints5() -- For Table5
 //------------------------------------------------------------------------------
@@ -56,6 +56,14 @@ bool NetHandler::initNetwork(const bool noWaitFlag)
     return ok;
 }
 
+//------------------------------------------------------------------------------
+// flushData() -- Send any buffered output data (default: nothing's buffered)
+//------------------------------------------------------------------------------
+bool NetHandler::flushData()
+{
+    return true;
+}
+
 //------------------------------------------------------------------------------
 // init() -- initialize the network
 //------------------------------------------------------------------------------
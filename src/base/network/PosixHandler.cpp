@@ -10,6 +10,8 @@
     #include <arpa/inet.h>
     #include <sys/fcntl.h>
     #include <sys/ioctl.h>
+    #include <sys/select.h>
+    #include <sys/socket.h>
     #ifdef sun
         #include <sys/filio.h> // -- added for Solaris 10
     #endif
@@ -22,7 +24,10 @@
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/PairStream.hpp"
 #include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/concurrent/SingleTask.hpp"
+#include "mixr/base/util/atomics.hpp"
 #include "mixr/base/util/str_utils.hpp"
+#include "mixr/base/util/system_utils.hpp"
 
 #include <cstdio>
 #include <cstring>
@@ -30,6 +35,38 @@
 namespace mixr {
 namespace base {
 
+//==============================================================================
+// PosixHandler's receive thread
+//==============================================================================
+
+class PosixRecvThread : public SingleTask
+{
+   DECLARE_SUBCLASS(PosixRecvThread, SingleTask)
+   public: PosixRecvThread(Component* const parent, const double priority);
+   private: virtual unsigned long userFunc() override;
+};
+
+IMPLEMENT_SUBCLASS(PosixRecvThread, "PosixRecvThread")
+EMPTY_SLOTTABLE(PosixRecvThread)
+EMPTY_COPYDATA(PosixRecvThread)
+EMPTY_DELETEDATA(PosixRecvThread)
+
+PosixRecvThread::PosixRecvThread(Component* const parent, const double priority): SingleTask(parent, priority)
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+unsigned long PosixRecvThread::userFunc()
+{
+   const auto handler = static_cast<PosixHandler*>( getParent() );
+   handler->recvLoop();
+   return 0;
+}
+
+//==============================================================================
+// PosixHandler class
+//==============================================================================
+
 IMPLEMENT_SUBCLASS(PosixHandler, "PosixHandler")
 
 BEGIN_SLOTTABLE(PosixHandler)
@@ -42,6 +79,10 @@ BEGIN_SLOTTABLE(PosixHandler)
     "sendBuffSizeKb",       // 5) Send buffer size in KB's    (default:  32 Kb; max 1024)
     "recvBuffSizeKb",       // 6) Receive buffer size in KB's (default: 128 Kb; max 1024)
     "ignoreSourcePort",     // 7) Ignore message from this source port
+    "batchSize",            // 8) Max packets per recvmmsg()/sendmmsg() call (default: 0 -- no batching)
+    "recvThread",           // 9) Receive with our own thread (default: false)
+    "recvQueueSize",        // 10) Number of packet buffers in the receive thread's ring (default: 256)
+    "recvPriority",         // 11) Receive thread priority (default: 0.0)
 END_SLOTTABLE(PosixHandler)
 
 BEGIN_SLOT_MAP(PosixHandler)
@@ -52,6 +93,10 @@ BEGIN_SLOT_MAP(PosixHandler)
     ON_SLOT(5, setSlotSendBuffSize,     Number)
     ON_SLOT(6, setSlotRecvBuffSize,     Number)
     ON_SLOT(7, setSlotIgnoreSourcePort, Number)
+    ON_SLOT(8, setSlotBatchSize,        Number)
+    ON_SLOT(9, setSlotRecvThread,       Number)
+    ON_SLOT(10, setSlotRecvQueueSize,   Number)
+    ON_SLOT(11, setSlotRecvPriority,    Number)
 END_SLOT_MAP()
 
 PosixHandler::PosixHandler():localAddr(INADDR_ANY), netAddr(INADDR_ANY), fromAddr1(INADDR_NONE)
@@ -78,6 +123,19 @@ void PosixHandler::copyData(const PosixHandler& org, const bool)
     localAddr = org.localAddr;
     initialized = org.initialized;
 
+    // Don't copy the receive thread, the packet buffers or the statistics
+    batchSize = org.batchSize;
+    recvThreadEnabled = org.recvThreadEnabled;
+    recvQueueSize = org.recvQueueSize;
+    recvPriority = org.recvPriority;
+    numRecv = 0;
+    numDropped = 0;
+    numSent = 0;
+    for (unsigned int i = 0; i < NUM_BATCH_BINS; i++) {
+       recvHist[i] = 0;
+       sendHist[i] = 0;
+    }
+
     if (localIpAddr != nullptr) delete[] localIpAddr;
     localIpAddr = nullptr;
     if (org.localIpAddr != nullptr) {
@@ -91,6 +149,21 @@ void PosixHandler::deleteData()
 {
    if (localIpAddr != nullptr) delete[] localIpAddr;
    localIpAddr = nullptr;
+
+   // The receive thread holds a reference to us while it's running, so it
+   // has already been stopped
+   if (recvThread != nullptr) { recvThread->unref(); recvThread = nullptr; }
+   deleteBuffers();
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- Shutdown the simulation
+//------------------------------------------------------------------------------
+bool PosixHandler::shutdownNotification()
+{
+   stopRecvThread();
+   flushData();
+   return BaseClass::shutdownNotification();
 }
 
 //------------------------------------------------------------------------------
@@ -125,6 +198,26 @@ bool PosixHandler::initNetwork(const bool noWaitFlag)
     if (initialized && isMessageEnabled(MSG_DEBUG)) {
         std::cout << "PosixHandler::initNetwork() -- network initialized successfully" << std::endl;
     }
+
+    // ---
+    // Batched and threaded I/O (UDP only)
+    // ---
+    if (ok && (batchSize > 1 || recvThreadEnabled) && isDatagramSocket()) {
+#if defined(__linux__)
+        if (batchSize > 1 && sendBuff == nullptr) {
+            recvBuff = new Packet[batchSize];
+            for (unsigned int i = 0; i < batchSize; i++) {
+                recvPkts[i] = &recvBuff[i];
+            }
+            recvCount = 0;
+            recvIndex = 0;
+            sendBuff = new Packet[batchSize];
+            sendCount = 0;
+        }
+#endif
+        if (recvThreadEnabled) startRecvThread();
+    }
+
     return ok;
 }
 
@@ -277,6 +370,8 @@ bool PosixHandler::isConnected() const
 // -------------------------------------------------------------
 bool PosixHandler::closeConnection()
 {
+    stopRecvThread();
+    flushData();
     initialized = false;
     return true;
 }
@@ -285,34 +380,76 @@ bool PosixHandler::closeConnection()
 // sendData() -- Send data
 // -------------------------------------------------------------
 bool PosixHandler::sendData(const char* const packet, const int size)
+{
+    return sendPacket(packet, size, netAddr, port);
+}
+
+// -------------------------------------------------------------
+// sendPacket() -- Send data to a specific IP/Port
+// -------------------------------------------------------------
+bool PosixHandler::sendPacket(const char* const packet, const int size, const uint32_t ip0, const uint16_t port0)
 {
     if (socketNum == INVALID_SOCKET) return false;
 
+    if (sendBuff != nullptr) {
+        // Batched output: queue the packet, and send the batch when it's full
+        if (size > 0 && static_cast<unsigned int>(size) <= MAX_PACKET_SIZE) {
+            lock( sendSemaphore );
+            Packet* const p = &sendBuff[sendCount++];
+            std::memcpy(p->data, packet, size);
+            p->size = static_cast<unsigned int>(size);
+            p->addr = ip0;
+            p->port = port0;
+            bool ok = true;
+            if (sendCount >= batchSize) ok = sendBatch();
+            unlock( sendSemaphore );
+            return ok;
+        }
+
+        // Too large to queue; send it after the queued packets
+        flushData();
+    }
+
     // Send the data
     struct sockaddr_in addr;        // Working address structure
     bzero(&addr, sizeof(addr));
     addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = netAddr;
-    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = ip0;
+    addr.sin_port = htons(port0);
     socklen_t addrlen = sizeof(addr);
     int result = ::sendto(socketNum, packet, size, 0, reinterpret_cast<const struct sockaddr*>(&addr), addrlen);
     if (result == SOCKET_ERROR) {
 #if defined(WIN32)
         int err = ::WSAGetLastError();
         if (isMessageEnabled(MSG_ERROR)) {
-            std::cerr << "PosixHandler::sendData(): sendto error: " << err << " hex=0x" << std::hex << err << std::dec << std::endl;
+            std::cerr << "PosixHandler::sendPacket(): sendto error: " << err << " hex=0x" << std::hex << err << std::dec << std::endl;
         }
 #else
-        std::perror("PosixHandler::sendData(): sendto error msg");
+        std::perror("PosixHandler::sendPacket(): sendto error msg");
         if (isMessageEnabled(MSG_ERROR)) {
-            std::cerr << "PosixHandler::sendData(): sendto error result: " << result << std::endl;
+            std::cerr << "PosixHandler::sendPacket(): sendto error result: " << result << std::endl;
         }
 #endif
         return false;
     }
+    numSent++;
+    sendHist[0]++;
     return true;
 }
 
+// -------------------------------------------------------------
+// flushData() -- Send the queued (batched) output packets
+// -------------------------------------------------------------
+bool PosixHandler::flushData()
+{
+    if (sendBuff == nullptr) return true;
+
+    lock( sendSemaphore );
+    const bool ok = sendBatch();
+    unlock( sendSemaphore );
+    return ok;
+}
+
 // -------------------------------------------------------------
 // recvData() -- Receive data and possible ignore our own
 //               local port messages.
@@ -326,6 +463,35 @@ unsigned int PosixHandler::recvData(char* const packet, const int maxSize)
    fromAddr1 = INADDR_NONE;
    fromPort1 = 0;
 
+   // ---
+   // Batched or threaded input: take the next packet from the receive
+   // thread's ring, or from our batch (reading a new batch as needed)
+   // ---
+   if (recvThread != nullptr || recvBuff != nullptr) {
+      Packet* p = nullptr;
+      if (recvThread != nullptr) {
+         p = readyQueue->get();
+      }
+      else {
+         unsigned int nRead = 1;
+         while (recvIndex >= recvCount && nRead > 0) {
+            recvCount = recvBatch(recvPkts, batchSize, true, &nRead);
+            recvIndex = 0;
+            numRecv += recvCount;
+         }
+         if (recvIndex < recvCount) p = recvPkts[recvIndex++];
+      }
+
+      if (p != nullptr) {
+         n = (p->size < static_cast<unsigned int>(maxSize) ? p->size : static_cast<unsigned int>(maxSize));
+         std::memcpy(packet, p->data, n);
+         fromAddr1 = p->addr;
+         fromPort1 = p->port;
+         if (recvThread != nullptr) freeQueue->put(p);
+      }
+      return n;
+   }
+
    bool tryAgain = true;
    while (tryAgain) {
       tryAgain = false;
@@ -348,11 +514,288 @@ unsigned int PosixHandler::recvData(char* const packet, const int maxSize)
          n = result;
          fromAddr1 = raddr.sin_addr.s_addr;
          fromPort1 = ntohs(raddr.sin_port);
+         numRecv++;
+         recvHist[0]++;
       }
    }
    return n;
 }
 
+// -------------------------------------------------------------
+// recvBatch() -- Receive up to 'n' packets into 'pkts' with one
+// system call.  Returns the number of packets kept, which are moved
+// to the front of 'pkts' (the ignored and truncated packets are
+// skipped).  'nRead' is set to the number of packets read.  With
+// 'wait' the socket's blocked or no wait mode is used, otherwise
+// we don't wait.
+// -------------------------------------------------------------
+unsigned int PosixHandler::recvBatch(Packet** const pkts, const unsigned int n, const bool wait, unsigned int* const nRead)
+{
+   unsigned int k = 0;
+   *nRead = 0;
+
+#if defined(__linux__)
+   struct mmsghdr msgs[MAX_BATCH_SIZE];
+   struct iovec iovs[MAX_BATCH_SIZE];
+   struct sockaddr_in addrs[MAX_BATCH_SIZE];
+   bzero(msgs, sizeof(msgs[0]) * n);
+   for (unsigned int i = 0; i < n; i++) {
+      iovs[i].iov_base = pkts[i]->data;
+      iovs[i].iov_len = MAX_PACKET_SIZE;
+      msgs[i].msg_hdr.msg_name = &addrs[i];
+      msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+   }
+
+   const int result = ::recvmmsg(socketNum, msgs, n, (wait ? MSG_WAITFORONE : MSG_DONTWAIT), nullptr);
+   if (result > 0) {
+      *nRead = static_cast<unsigned int>(result);
+      recvHist[binOf(*nRead)]++;
+      for (unsigned int i = 0; i < *nRead; i++) {
+         const uint16_t rport = ntohs(addrs[i].sin_port);
+         if ((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+            numDropped++;
+         }
+         else if (ignoreSourcePort == 0 || rport != ignoreSourcePort) {
+            Packet* const p = pkts[i];
+            p->size = msgs[i].msg_len;
+            p->addr = addrs[i].sin_addr.s_addr;
+            p->port = rport;
+            pkts[i] = pkts[k];
+            pkts[k++] = p;
+         }
+      }
+   }
+#else
+   (void) n;
+   (void) wait;
+   struct sockaddr_in raddr;
+   socklen_t addrlen = sizeof(raddr);
+   const int result = ::recvfrom(socketNum, pkts[0]->data, MAX_PACKET_SIZE, 0, reinterpret_cast<struct sockaddr*>(&raddr), &addrlen);
+   if (result > 0) {
+      *nRead = 1;
+      recvHist[0]++;
+      const uint16_t rport = ntohs(raddr.sin_port);
+      if (ignoreSourcePort == 0 || rport != ignoreSourcePort) {
+         pkts[0]->size = static_cast<unsigned int>(result);
+         pkts[0]->addr = raddr.sin_addr.s_addr;
+         pkts[0]->port = rport;
+         k = 1;
+      }
+   }
+#endif
+
+   return k;
+}
+
+// -------------------------------------------------------------
+// sendBatch() -- Send the queued packets (send lock is set)
+// -------------------------------------------------------------
+bool PosixHandler::sendBatch()
+{
+   bool ok = true;
+
+#if defined(__linux__)
+   if (sendCount > 0) {
+      struct sockaddr_in addrs[MAX_BATCH_SIZE];
+      struct mmsghdr msgs[MAX_BATCH_SIZE];
+      struct iovec iovs[MAX_BATCH_SIZE];
+      bzero(addrs, sizeof(addrs[0]) * sendCount);
+      bzero(msgs, sizeof(msgs[0]) * sendCount);
+      for (unsigned int i = 0; i < sendCount; i++) {
+         addrs[i].sin_family = AF_INET;
+         addrs[i].sin_addr.s_addr = sendBuff[i].addr;
+         addrs[i].sin_port = htons(sendBuff[i].port);
+         iovs[i].iov_base = sendBuff[i].data;
+         iovs[i].iov_len = sendBuff[i].size;
+         msgs[i].msg_hdr.msg_name = &addrs[i];
+         msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+         msgs[i].msg_hdr.msg_iov = &iovs[i];
+         msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      unsigned int i = 0;
+      while (i < sendCount && ok) {
+         const int result = ::sendmmsg(socketNum, &msgs[i], sendCount - i, 0);
+         if (result > 0) {
+            numSent += result;
+            sendHist[binOf(static_cast<unsigned int>(result))]++;
+            i += static_cast<unsigned int>(result);
+         }
+         else {
+            std::perror("PosixHandler::sendBatch(): sendmmsg error msg");
+            if (isMessageEnabled(MSG_ERROR)) {
+               std::cerr << "PosixHandler::sendBatch(): dropped " << (sendCount - i) << " packets" << std::endl;
+            }
+            ok = false;
+         }
+      }
+      sendCount = 0;
+   }
+#endif
+
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Receive thread's main loop -- read packets into the ring until we're stopped
+//------------------------------------------------------------------------------
+void PosixHandler::recvLoop()
+{
+#if defined(__linux__)
+   const unsigned int n = (batchSize > 1 ? batchSize : 1);
+#else
+   const unsigned int n = 1;
+#endif
+
+   // Free packets that we're holding for the next read
+   Packet* held[MAX_BATCH_SIZE] {};
+   unsigned int nHeld = 0;
+
+   // Spare packets for reading (and dropping) when the ring is full
+   Packet* spare[MAX_BATCH_SIZE] {};
+   for (unsigned int i = 0; i < n; i++) {
+      spare[i] = &ringBuff[recvQueueSize + i];
+   }
+
+   while (!stopRecv) {
+      while (nHeld < n) {
+         Packet* const p = freeQueue->get();
+         if (p == nullptr) break;
+         held[nHeld++] = p;
+      }
+
+      if (waitForData(10)) {
+         unsigned int nRead = 0;
+         if (nHeld > 0) {
+            const unsigned int k = recvBatch(held, nHeld, false, &nRead);
+            for (unsigned int i = 0; i < k; i++) {
+               readyQueue->put(held[i]);
+            }
+            for (unsigned int i = k; i < nHeld; i++) {
+               held[i - k] = held[i];
+            }
+            nHeld -= k;
+            numRecv += k;
+         }
+         else {
+            const unsigned int k = recvBatch(spare, n, false, &nRead);
+            numRecv += k;
+            numDropped += k;
+         }
+      }
+   }
+}
+
+// Waits up to 'msecs' milliseconds for input data; returns true if there's data
+bool PosixHandler::waitForData(const unsigned int msecs) const
+{
+   fd_set fds;
+   FD_ZERO(&fds);
+   FD_SET(socketNum, &fds);
+   struct timeval tv;
+   tv.tv_sec = msecs / 1000;
+   tv.tv_usec = (msecs % 1000) * 1000;
+   const int result = ::select(static_cast<int>(socketNum + 1), &fds, nullptr, nullptr, &tv);
+   if (result == SOCKET_ERROR) msleep(msecs);
+   return (result > 0);
+}
+
+// Starts the receive thread
+bool PosixHandler::startRecvThread()
+{
+   if (recvThread != nullptr) return true;
+
+   ringBuff = new Packet[recvQueueSize + MAX_BATCH_SIZE];
+   readyQueue = new mpsc_queue<Packet*>(recvQueueSize);
+   freeQueue = new mpsc_queue<Packet*>(recvQueueSize);
+   for (unsigned int i = 0; i < recvQueueSize; i++) {
+      freeQueue->put(&ringBuff[i]);
+   }
+
+   stopRecv = false;
+   recvThread = new PosixRecvThread(this, recvPriority);
+   if ( !recvThread->create() ) {
+      recvThread->unref();
+      recvThread = nullptr;
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "PosixHandler::startRecvThread(): ERROR, failed to create the receive thread; receiving with the caller's thread." << std::endl;
+      }
+      return false;
+   }
+   return true;
+}
+
+// Stops the receive thread, if any
+void PosixHandler::stopRecvThread()
+{
+   if (recvThread != nullptr) {
+      stopRecv = true;
+      while ( !recvThread->isTerminated() ) {
+         msleep(1);
+      }
+      recvThread->unref();
+      recvThread = nullptr;
+   }
+}
+
+// Deletes the packet buffers
+void PosixHandler::deleteBuffers()
+{
+   if (readyQueue != nullptr) { delete readyQueue; readyQueue = nullptr; }
+   if (freeQueue != nullptr) { delete freeQueue; freeQueue = nullptr; }
+   if (ringBuff != nullptr) { delete[] ringBuff; ringBuff = nullptr; }
+   if (recvBuff != nullptr) { delete[] recvBuff; recvBuff = nullptr; }
+   if (sendBuff != nullptr) { delete[] sendBuff; sendBuff = nullptr; }
+   recvCount = 0;
+   recvIndex = 0;
+   sendCount = 0;
+}
+
+// Returns true if our socket is a datagram (UDP) socket
+bool PosixHandler::isDatagramSocket() const
+{
+   if (socketNum == INVALID_SOCKET) return false;
+
+   int type = 0;
+   socklen_t len = sizeof(type);
+#if defined(WIN32)
+   const int result = ::getsockopt(socketNum, SOL_SOCKET, SO_TYPE, reinterpret_cast<char*>(&type), &len);
+#else
+   const int result = ::getsockopt(socketNum, SOL_SOCKET, SO_TYPE, &type, &len);
+#endif
+   return (result != SOCKET_ERROR && type == SOCK_DGRAM);
+}
+
+// Batch size histogram bin of a batch of 'n' packets
+unsigned int PosixHandler::binOf(const unsigned int n)
+{
+   unsigned int bin = 0;
+   unsigned int m = n;
+   while (m > 1 && bin < (NUM_BATCH_BINS - 1)) {
+      m >>= 1;
+      bin++;
+   }
+   return bin;
+}
+
+//------------------------------------------------------------------------------
+// Statistics
+//------------------------------------------------------------------------------
+
+// Number of receive system calls in batch size histogram bin 'bin'
+unsigned int PosixHandler::getRecvBatchCount(const unsigned int bin) const
+{
+   return (bin < NUM_BATCH_BINS ? recvHist[bin].load() : 0);
+}
+
+// Number of send system calls in batch size histogram bin 'bin'
+unsigned int PosixHandler::getSendBatchCount(const unsigned int bin) const
+{
+   return (bin < NUM_BATCH_BINS ? sendHist[bin].load() : 0);
+}
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
@@ -580,5 +1023,58 @@ bool PosixHandler::setSlotIgnoreSourcePort(const Number* const msg)
     return ok;
 }
 
+// batchSize: Max packets per recvmmsg()/sendmmsg() call
+bool PosixHandler::setSlotBatchSize(const Number* const msg)
+{
+    bool ok = false;
+    if (msg != nullptr && sendBuff == nullptr) {
+        int ii = msg->getInt();
+        if (ii >= 0 && ii <= static_cast<int>(MAX_BATCH_SIZE)) {
+           batchSize = ii;
+           ok = true;
+        }
+    }
+    return ok;
+}
+
+// recvThread: Receive with our own thread
+bool PosixHandler::setSlotRecvThread(const Number* const msg)
+{
+    bool ok = false;
+    if (msg != nullptr && recvThread == nullptr) {
+        recvThreadEnabled = msg->getBoolean();
+        ok = true;
+    }
+    return ok;
+}
+
+// recvQueueSize: Number of packet buffers in the receive thread's ring
+bool PosixHandler::setSlotRecvQueueSize(const Number* const msg)
+{
+    bool ok = false;
+    if (msg != nullptr && recvThread == nullptr) {
+        int ii = msg->getInt();
+        if (ii >= 1) {
+           recvQueueSize = ii;
+           ok = true;
+        }
+    }
+    return ok;
+}
+
+// recvPriority: Receive thread priority
+bool PosixHandler::setSlotRecvPriority(const Number* const msg)
+{
+    bool ok = false;
+    if (msg != nullptr) {
+        const double pri = msg->getReal();
+        if (pri >= 0.0 && pri <= 1.0) {
+           recvPriority = pri;
+           ok = true;
+        }
+    }
+    return ok;
+}
+
 }
 }
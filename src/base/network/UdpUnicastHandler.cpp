@@ -136,7 +136,8 @@ bool UdpUnicastHandler::bindSocket()
 }
 
 // -------------------------------------------------------------
-// Send data to a specific IP/Port
+// Send data to a specific IP/Port; queued with the other packets
+// when the output is batched (see PosixHandler's 'batchSize')
 // -------------------------------------------------------------
 bool UdpUnicastHandler::sendDataTo(
          const char* const packet,  // Data packet
@@ -145,31 +146,7 @@ bool UdpUnicastHandler::sendDataTo(
          const uint16_t port0       // Destination port (this packet only)
       )
 {
-    if (socketNum == INVALID_SOCKET) return false;
-
-    // Send the data
-    struct sockaddr_in addr;        // Working address structure
-    bzero(&addr, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = ip0;
-    addr.sin_port = htons(port0);
-    socklen_t addrlen = sizeof(addr);
-    int result = ::sendto(socketNum, packet, size, 0, reinterpret_cast<const struct sockaddr*>(&addr), addrlen);
-    if (result == SOCKET_ERROR) {
-#if defined(WIN32)
-        int err = WSAGetLastError();
-        if (isMessageEnabled(MSG_ERROR)) {
-            std::cerr << "UdpUnicastHandler::sendDataTo(): sendto error: " << err << " hex=0x" << std::hex << err << std::dec << std::endl;
-        }
-#else
-        std::perror("UdpHandler::sendDataTo(): sendto error msg");
-        if (isMessageEnabled(MSG_ERROR)) {
-            std::cerr << "UdpUnicastHandler::sendDataTo(): sendto error result: " << result << std::endl;
-        }
-#endif
-        return false;
-    }
-    return true;
+    return sendPacket(packet, size, ip0, port0);
 }
 
 //------------------------------------------------------------------------------
@@ -1,6 +1,8 @@
 
 #include "mixr/base/util/lfi.hpp"
 
+#include <cmath>
+
 namespace mixr {
 namespace base {
 
@@ -482,5 +484,313 @@ double lfi_5D(
    return m * (a2 - a1) + a1;
 }
 
+//==============================================================================
+// Array Linear Function Interpolators
+//
+//    The inputs are interpolated in blocks.  For each block, the breakpoints
+//    and interpolation weights of each independent variable are found first,
+//    and then the dependent data at the corners of the blocks' cells are
+//    gathered and reduced, one dimension at a time, with loops over the block
+//    that the compiler can vectorize (e.g., with AVX2 when it's enabled in
+//    the compiler flags).  The interpolation is done in the same order as the
+//    scalar functions, so the results are the same.
+//==============================================================================
+
+namespace {
+
+const unsigned int LFI_BLOCK = 64;     // Number of inputs per block
+const unsigned int LFI_MAX_DIM = 5;    // Max number of independent variables
+
+//------------------------------------------------------------------------------
+// lfiBreakpoints() -- finds the breakpoints, 'i1' and 'i2', and the
+// interpolation weight, 'm', of one independent variable for 'n' inputs,
+// so that f(x) = m * (a[i2] - a[i1]) + a[i1]; at the ends of the table,
+// without extrapolation, 'i1' is the end point and 'm' is zero.
+//------------------------------------------------------------------------------
+void lfiBreakpoints(
+         const double* const x,     // Independent variable
+         const unsigned int n,      // Number of inputs
+         const double* const data,  // Table of breakpoints
+         const unsigned int nd,     // Size of data table
+         const bool eFlg,           // Extrapolation is enabled beyond the table
+         unsigned int* const bp,    // Previous breakpoint (optional)
+         unsigned int* const i1,    // (Output) lower breakpoints
+         unsigned int* const i2,    // (Output) upper breakpoints
+         double* const m            // (Output) interpolation weights
+      )
+{
+   // ---
+   // Only one point?
+   // ---
+   if (nd == 1) {
+      for (unsigned int k = 0; k < n; k++) {
+         i1[k] = 0;
+         i2[k] = 0;
+         m[k] = 0;
+      }
+      return;
+   }
+
+   // ---
+   // Check increasing vs decreasing order of the breakpoints
+   // ---
+   unsigned int low = 0;
+   unsigned int high = nd - 1;
+   int delta = 1;
+   if (data[1] < data[0]) {
+      // Reverse order of breakpoints
+      low = nd - 1;
+      high = 0;
+      delta = -1;
+   }
+
+   // Breakpoint spacing, if they were uniformly spaced
+   const double dx = (data[high] - data[low]) / (nd - 1);
+
+   for (unsigned int k = 0; k < n; k++) {
+      const double xk = x[k];
+
+      // ---
+      // Find the breakpoints with endpoint checks
+      // ---
+      unsigned int x2 = 0;
+      if (xk <= data[low]) {
+         // At or below the 'low' end
+         x2 = low + delta;
+         if (!eFlg) {
+            if (bp != nullptr) *bp = x2;
+            i1[k] = low;
+            i2[k] = x2;
+            m[k] = 0;
+            continue;
+         }
+      }
+      else if (xk >= data[high]) {
+         // At or above the 'high' end
+         x2 = high;
+         if (!eFlg) {
+            if (bp != nullptr) *bp = x2;
+            i1[k] = high;
+            i2[k] = high - delta;
+            m[k] = 0;
+            continue;
+         }
+      }
+      else if (bp != nullptr) {
+         // Start at the previous breakpoint
+         x2 = *bp;
+         if (x2 >= nd) x2 = 0;                          // safety check
+         while (xk > data[x2]) { x2 += delta; }         // search up
+         while (xk < data[x2-delta]) { x2 -= delta; }   // search down
+         *bp = x2;
+      }
+      else {
+         // The first breakpoint (from the 'low' end) that's not less than
+         // 'xk'; try the uniformly spaced index first, then a binary search
+         const double g = std::ceil((xk - data[low]) / dx);
+         unsigned int j = 1;
+         if (g >= (nd - 1)) j = nd - 1;
+         else if (g > 1) j = static_cast<unsigned int>(g);
+         x2 = (delta > 0 ? low + j : low - j);
+         if ( !(xk <= data[x2] && xk > data[x2-delta]) ) {
+            unsigned int lo = 1;
+            unsigned int hi = nd - 1;
+            while (lo < hi) {
+               const unsigned int mid = (lo + hi) / 2;
+               if (xk <= data[delta > 0 ? low + mid : low - mid]) hi = mid;
+               else lo = mid + 1;
+            }
+            x2 = (delta > 0 ? low + lo : low - lo);
+         }
+      }
+
+      const unsigned int x1 = x2 - delta;
+      i1[k] = x1;
+      i2[k] = x2;
+      m[k] = (xk - data[x1]) / (data[x2] - data[x1]);
+   }
+}
+
+//------------------------------------------------------------------------------
+// lfiArray() -- N dimensional array Linear Function Interpolator
+//------------------------------------------------------------------------------
+void lfiArray(
+         const unsigned int nDim,            // Number of independent variables
+         const double* const iv[],           // Independent variables
+         double* const a,                    // (Output) results
+         const unsigned int n,               // Number of inputs
+         const double* const bkpts[],        // Tables of breakpoints
+         const unsigned int nb[],            // Sizes of the breakpoint tables
+         const double* const a_data,         // Table of dependent variable data
+         const bool eFlg,                    // Extrapolation is enabled beyond the table
+         unsigned int* const bp[]            // Previous breakpoints (optional)
+      )
+{
+   // Data table strides
+   unsigned int stride[LFI_MAX_DIM];
+   stride[0] = 1;
+   for (unsigned int d = 1; d < nDim; d++) {
+      stride[d] = stride[d-1] * nb[d-1];
+   }
+
+   unsigned int i1[LFI_MAX_DIM][LFI_BLOCK];
+   unsigned int i2[LFI_MAX_DIM][LFI_BLOCK];
+   double m[LFI_MAX_DIM][LFI_BLOCK];
+   double v[1 << LFI_MAX_DIM][LFI_BLOCK];
+   unsigned int off[LFI_BLOCK];
+
+   const unsigned int nc = (1u << nDim);
+   for (unsigned int first = 0; first < n; first += LFI_BLOCK) {
+      const unsigned int cnt = ((n - first) < LFI_BLOCK ? (n - first) : LFI_BLOCK);
+
+      // ---
+      // Breakpoints and weights
+      // ---
+      for (unsigned int d = 0; d < nDim; d++) {
+         lfiBreakpoints(&iv[d][first], cnt, bkpts[d], nb[d], eFlg, bp[d], i1[d], i2[d], m[d]);
+      }
+
+      // ---
+      // Gather the data at the cell corners; bit 'd' of the corner
+      // number selects the lower or upper breakpoint of dimension 'd'
+      // ---
+      for (unsigned int c = 0; c < nc; c++) {
+         for (unsigned int k = 0; k < cnt; k++) { off[k] = 0; }
+         for (unsigned int d = 0; d < nDim; d++) {
+            const unsigned int* const idx = (((c >> d) & 1) != 0 ? i2[d] : i1[d]);
+            const unsigned int s = stride[d];
+            for (unsigned int k = 0; k < cnt; k++) { off[k] += idx[k] * s; }
+         }
+         double* const vc = v[c];
+         for (unsigned int k = 0; k < cnt; k++) { vc[k] = a_data[off[k]]; }
+      }
+
+      // ---
+      // Interpolate one dimension at a time (x first)
+      // ---
+      for (unsigned int d = 0; d < nDim; d++) {
+         const unsigned int h = (nc >> (d + 1));
+         const double* const md = m[d];
+         for (unsigned int j = 0; j < h; j++) {
+            double* const v1 = v[2*j];
+            double* const v2 = v[2*j + 1];
+            double* const vj = v[j];
+            for (unsigned int k = 0; k < cnt; k++) {
+               vj[k] = md[k] * (v2[k] - v1[k]) + v1[k];
+            }
+         }
+      }
+
+      for (unsigned int k = 0; k < cnt; k++) {
+         a[first + k] = v[0][k];
+      }
+   }
+}
+
+}
+
+//------------------------------------------------------------------------------
+// Array versions of lfi_1D() ... lfi_5D()
+//------------------------------------------------------------------------------
+void lfi_1D_array(
+         const double* const x,
+         double* const a, const unsigned int n,
+         const double* x_data, const unsigned int nx,
+         const double* a_data,
+         const bool eFlg,
+         unsigned int* const xbp
+      )
+{
+   const double* const iv[] = { x };
+   const double* const bkpts[] = { x_data };
+   const unsigned int nb[] = { nx };
+   unsigned int* const bp[] = { xbp };
+   lfiArray(1, iv, a, n, bkpts, nb, a_data, eFlg, bp);
+}
+
+void lfi_2D_array(
+         const double* const x, const double* const y,
+         double* const a, const unsigned int n,
+         const double* x_data, const unsigned int nx,
+         const double* y_data, const unsigned int ny,
+         const double* a_data,
+         const bool eFlg,
+         unsigned int* const xbp,
+         unsigned int* const ybp
+      )
+{
+   const double* const iv[] = { x, y };
+   const double* const bkpts[] = { x_data, y_data };
+   const unsigned int nb[] = { nx, ny };
+   unsigned int* const bp[] = { xbp, ybp };
+   lfiArray(2, iv, a, n, bkpts, nb, a_data, eFlg, bp);
+}
+
+void lfi_3D_array(
+         const double* const x, const double* const y, const double* const z,
+         double* const a, const unsigned int n,
+         const double* x_data, const unsigned int nx,
+         const double* y_data, const unsigned int ny,
+         const double* z_data, const unsigned int nz,
+         const double* a_data,
+         const bool eFlg,
+         unsigned int* const xbp,
+         unsigned int* const ybp,
+         unsigned int* const zbp
+      )
+{
+   const double* const iv[] = { x, y, z };
+   const double* const bkpts[] = { x_data, y_data, z_data };
+   const unsigned int nb[] = { nx, ny, nz };
+   unsigned int* const bp[] = { xbp, ybp, zbp };
+   lfiArray(3, iv, a, n, bkpts, nb, a_data, eFlg, bp);
+}
+
+void lfi_4D_array(
+         const double* const x, const double* const y, const double* const z, const double* const w,
+         double* const a, const unsigned int n,
+         const double* x_data, const unsigned int nx,
+         const double* y_data, const unsigned int ny,
+         const double* z_data, const unsigned int nz,
+         const double* w_data, const unsigned int nw,
+         const double* a_data,
+         const bool eFlg,
+         unsigned int* const xbp,
+         unsigned int* const ybp,
+         unsigned int* const zbp,
+         unsigned int* const wbp
+      )
+{
+   const double* const iv[] = { x, y, z, w };
+   const double* const bkpts[] = { x_data, y_data, z_data, w_data };
+   const unsigned int nb[] = { nx, ny, nz, nw };
+   unsigned int* const bp[] = { xbp, ybp, zbp, wbp };
+   lfiArray(4, iv, a, n, bkpts, nb, a_data, eFlg, bp);
+}
+
+void lfi_5D_array(
+         const double* const x, const double* const y, const double* const z, const double* const w, const double* const v,
+         double* const a, const unsigned int n,
+         const double* x_data, const unsigned int nx,
+         const double* y_data, const unsigned int ny,
+         const double* z_data, const unsigned int nz,
+         const double* w_data, const unsigned int nw,
+         const double* v_data, const unsigned int nv,
+         const double* a_data,
+         const bool eFlg,
+         unsigned int* const xbp,
+         unsigned int* const ybp,
+         unsigned int* const zbp,
+         unsigned int* const wbp,
+         unsigned int* const vbp
+      )
+{
+   const double* const iv[] = { x, y, z, w, v };
+   const double* const bkpts[] = { x_data, y_data, z_data, w_data, v_data };
+   const unsigned int nb[] = { nx, ny, nz, nw, nv };
+   unsigned int* const bp[] = { xbp, ybp, zbp, wbp, vbp };
+   lfiArray(5, iv, a, n, bkpts, nb, a_data, eFlg, bp);
+}
+
 }
 }
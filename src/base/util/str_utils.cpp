@@ -292,6 +292,19 @@ int utStrncasecmp(const char* const s1, const char* const s2, const std::size_t
    return 0;
 }
 
+//------------
+// String hash function (32 bit FNV-1a)
+//------------
+unsigned int utStrHash(const char* const s)
+{
+   unsigned int h {2166136261u};
+   for (const char* p = s; *p != '\0'; p++) {
+      h ^= static_cast<unsigned char>(*p);
+      h *= 16777619u;
+   }
+   return h;
+}
+
 }
 }
 
@@ -1,6 +1,7 @@
 
 #include "mixr/dafif/factory.hpp"
 
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 
 #include "mixr/dafif/AirportLoader.hpp"
@@ -12,21 +13,21 @@
 namespace mixr {
 namespace dafif {
 
+namespace {
+
+const base::FactoryTable::Entry entries[] = {
+    FACTORY_ENTRY(AirportLoader),
+    FACTORY_ENTRY(NavaidLoader),
+    FACTORY_ENTRY(WaypointLoader),
+};
+
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+
+}
+
 base::Object* factory(const std::string& name)
 {
-    base::Object* obj {};
-
-    if ( name == AirportLoader::getFactoryName() ) {
-        obj = new AirportLoader();
-    }
-    else if ( name == NavaidLoader::getFactoryName() ) {
-        obj = new NavaidLoader();
-    }
-    else if ( name == WaypointLoader::getFactoryName() ) {
-        obj = new WaypointLoader();
-    }
-
-    return obj;
+    return table.create(name);
 }
 
 }
@@ -1,6 +1,7 @@
 
 #include "mixr/graphics/factory.hpp"
 
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 
 #include "mixr/graphics/Graphic.hpp"
@@ -48,156 +49,78 @@
 namespace mixr {
 namespace graphics {
 
-base::Object* factory(const std::string& name)
-{
-    base::Object* obj {};
+namespace {
 
+const base::FactoryTable::Entry entries[] = {
     // General graphics support
-    if ( name == Graphic::getFactoryName() ) {
-        obj = new Graphic();
-    }
-    else if ( name == Page::getFactoryName() ) {
-        obj = new Page();
-    }
-    else if ( name == Display::getFactoryName() ) {
-        obj = new Display();
-    }
-    else if ( name == Translator::getFactoryName() ) {
-        obj = new Translator();
-    }
-    else if ( name == Rotators::getFactoryName() ) {
-        obj = new Rotators();
-    }
-    else if ( name == ColorRotary::getFactoryName() ) {
-        obj = new ColorRotary();
-    }
-    else if ( name == ColorGradient::getFactoryName() ) {
-        obj = new ColorGradient();
-    }
+    FACTORY_ENTRY(Graphic),
+    FACTORY_ENTRY(Page),
+    FACTORY_ENTRY(Display),
+    FACTORY_ENTRY(Translator),
+    FACTORY_ENTRY(Rotators),
+    FACTORY_ENTRY(ColorRotary),
+    FACTORY_ENTRY(ColorGradient),
 
     // Shapes
-    else if ( name == Circle::getFactoryName() ) {
-        obj = new Circle();
-    }
-    else if ( name == Point::getFactoryName() ) {
-        obj = new Point();
-    }
-    else if ( name == Polygon::getFactoryName() ) {
-        obj = new Polygon();
-    }
-    else if ( name == LineLoop::getFactoryName() ) {
-        obj = new LineLoop();
-    }
-    else if ( name == Line::getFactoryName() ) {
-        obj = new Line();
-    }
-    else if ( name == Arc::getFactoryName() ) {
-        obj = new Arc();
-    }
-    else if ( name == OcclusionCircle::getFactoryName() ) {
-        obj = new OcclusionCircle();
-    }
-    else if ( name == OcclusionArc::getFactoryName() ) {
-        obj = new OcclusionArc();
-    }
-    else if ( name == Quad::getFactoryName() ) {
-        obj = new Quad();
-    }
-    else if ( name == Triangle::getFactoryName() ) {
-        obj = new Triangle();
-    }
+    FACTORY_ENTRY(Circle),
+    FACTORY_ENTRY(Point),
+    FACTORY_ENTRY(Polygon),
+    FACTORY_ENTRY(LineLoop),
+    FACTORY_ENTRY(Line),
+    FACTORY_ENTRY(Arc),
+    FACTORY_ENTRY(OcclusionCircle),
+    FACTORY_ENTRY(OcclusionArc),
+    FACTORY_ENTRY(Quad),
+    FACTORY_ENTRY(Triangle),
 
     // Fields
-    else if ( name == AsciiText::getFactoryName() ) {
-        obj = new AsciiText();
-    }
-    else if ( name == Cursor::getFactoryName() ) {
-        obj = new Cursor();
-    }
+    FACTORY_ENTRY(AsciiText),
+    FACTORY_ENTRY(Cursor),
 
     // Readouts
-    else if ( name == NumericReadout::getFactoryName() ) {
-        obj = new NumericReadout();
-    }
-    else if ( name == HexReadout::getFactoryName() ) {
-        obj = new HexReadout();
-    }
-    else if ( name == OctalReadout::getFactoryName() ) {
-        obj = new OctalReadout();
-    }
-    else if ( name == TimeReadout::getFactoryName() ) {
-        obj = new TimeReadout();
-    }
-    else if ( name == DirectionReadout::getFactoryName() ) {
-        obj = new DirectionReadout();
-    }
-    else if ( name == LatitudeReadout::getFactoryName() ) {
-        obj = new LatitudeReadout();
-    }
-    else if ( name == LongitudeReadout::getFactoryName() ) {
-        obj = new LongitudeReadout();
-    }
-    else if ( name == Rotary::getFactoryName() ) {
-        obj = new Rotary();
-    }
-    else if ( name == Rotary2::getFactoryName() ) {
-        obj = new Rotary2();
-    }
+    FACTORY_ENTRY(NumericReadout),
+    FACTORY_ENTRY(HexReadout),
+    FACTORY_ENTRY(OctalReadout),
+    FACTORY_ENTRY(TimeReadout),
+    FACTORY_ENTRY(DirectionReadout),
+    FACTORY_ENTRY(LatitudeReadout),
+    FACTORY_ENTRY(LongitudeReadout),
+    FACTORY_ENTRY(Rotary),
+    FACTORY_ENTRY(Rotary2),
 
     // Stroke Font
-    else if ( name == StrokeFont::getFactoryName() ) {
-        obj = new StrokeFont();
-    }
+    FACTORY_ENTRY(StrokeFont),
 
     // Bitmap Font
-    else if ( name == BitmapFont::getFactoryName() ) {
-        obj = new BitmapFont();
-    }
+    FACTORY_ENTRY(BitmapFont),
 
     // FTGL Fonts
-    else if ( name == FtglBitmapFont::getFactoryName() ) {
-        obj = new FtglBitmapFont();
-    }
-    else if ( name == FtglOutlineFont::getFactoryName() ) {
-        obj = new FtglOutlineFont();
-    }
-    else if ( name == FtglExtrdFont::getFactoryName() ) {
-        obj = new FtglExtrdFont();
-    }
-    else if ( name == FtglPixmapFont::getFactoryName() ) {
-        obj = new FtglPixmapFont();
-    }
-    else if ( name == FtglPolygonFont::getFactoryName() ) {
-        obj = new FtglPolygonFont();
-    }
-    else if ( name == FtglHaloFont::getFactoryName() ) {
-        obj = new FtglHaloFont();
-    }
-    else if ( name == FtglTextureFont::getFactoryName() ) {
-        obj = new FtglTextureFont();
-    }
+    FACTORY_ENTRY(FtglBitmapFont),
+    FACTORY_ENTRY(FtglOutlineFont),
+    FACTORY_ENTRY(FtglExtrdFont),
+    FACTORY_ENTRY(FtglPixmapFont),
+    FACTORY_ENTRY(FtglPolygonFont),
+    FACTORY_ENTRY(FtglHaloFont),
+    FACTORY_ENTRY(FtglTextureFont),
 
     // Bitmap Textures
-    else if ( name == BmpTexture::getFactoryName() ) {
-        obj = new BmpTexture();
-    }
+    FACTORY_ENTRY(BmpTexture),
     // Material
-    else if ( name == Material::getFactoryName() ) {
-        obj = new Material();
-    }
+    FACTORY_ENTRY(Material),
     // pages
-    else if ( name == MfdPage::getFactoryName() ) {
-        obj = new MfdPage();
-    }
-    else if ( name == MapPage::getFactoryName() ) {
-        obj = new MapPage();
-    }
+    FACTORY_ENTRY(MfdPage),
+    FACTORY_ENTRY(MapPage),
     // Symbol loader
-    else if ( name == SymbolLoader::getFactoryName() ) {
-        obj = new SymbolLoader();
-    }
+    FACTORY_ENTRY(SymbolLoader),
+};
 
-    return obj;
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+
+}
+
+base::Object* factory(const std::string& name)
+{
+    return table.create(name);
 }
 
 }
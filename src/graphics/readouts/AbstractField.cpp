@@ -47,7 +47,12 @@ BEGIN_SLOT_MAP(AbstractField)
     ON_SLOT(12, setSlotStartCharPos, base::Number)
 END_SLOT_MAP()
 
-BEGIN_EVENT_HANDLER(AbstractField)
+// (not BEGIN_EVENT_HANDLER(), which is table driven, because the input
+//  mode key events depend on our current mode)
+bool AbstractField::event(const int _event, base::Object* const _obj)
+{
+    bool _used {};
+
     if (mode == input) {
         bool kb {( _event >= 0x20 && _event <= 0x7f )};
         ON_EVENT(FORWARD_SPACE,onForwardSpace)
@@ -72,7 +77,10 @@ BEGIN_EVENT_HANDLER(AbstractField)
     ON_EVENT_OBJ(SET_UNDERLINE,setSlotUnderline,base::Number)
     ON_EVENT_OBJ(SET_REVERSED,setSlotReversed,base::Number)
     ON_EVENT_OBJ(SET_JUSTIFICATION,setSlotJustification,base::String)
-END_EVENT_HANDLER()
+
+    if (!_used) _used = BaseClass::event(_event,_obj);
+    return _used;
+}
 
 AbstractField::AbstractField()
 {
@@ -1,6 +1,7 @@
 
 #include "mixr/instruments/factory.hpp"
 
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 
 // Top Level objects
@@ -54,120 +55,72 @@
 namespace mixr {
 namespace instruments {
 
-base::Object* factory(const std::string& name)
-{
-    base::Object* obj {};
+namespace {
 
+const base::FactoryTable::Entry entries[] = {
     // Instrument
-    if ( name == Instrument::getFactoryName() ) {
-        obj = new Instrument;
-    }
+    FACTORY_ENTRY(Instrument),
     // Analog Dial
-    else if ( name == AnalogDial::getFactoryName() ) {
-        obj = new AnalogDial;
-    }
+    FACTORY_ENTRY(AnalogDial),
     // Tick Marks for the analog dial
-    else if ( name == DialTickMarks::getFactoryName() ) {
-        obj = new DialTickMarks;
-    }
+    FACTORY_ENTRY(DialTickMarks),
     // Arc Segments for the analog dial
-    else if ( name == DialArcSegment::getFactoryName() ) {
-        obj = new DialArcSegment;
-    }
+    FACTORY_ENTRY(DialArcSegment),
     // Dial Pointer
-    else if ( name == DialPointer::getFactoryName() ) {
-        obj = new DialPointer;
-    }
+    FACTORY_ENTRY(DialPointer),
     // CompassRose
-    else if ( name == CompassRose::getFactoryName() ) {
-        obj = new CompassRose;
-    }
+    FACTORY_ENTRY(CompassRose),
     // Bearing Pointer
-    else if ( name == BearingPointer::getFactoryName() ) {
-        obj = new BearingPointer;
-    }
+    FACTORY_ENTRY(BearingPointer),
     // AltitudeDial
-    else if ( name == AltitudeDial::getFactoryName() ) {
-        obj = new AltitudeDial;
-    }
+    FACTORY_ENTRY(AltitudeDial),
     // GMeterDial
-    else if ( name == GMeterDial::getFactoryName() ) {
-        obj = new GMeterDial;
-    }    
+    FACTORY_ENTRY(GMeterDial),
     // Here is the analog gauge and its pieces
     // AnalogGauge
-    else if ( name == AnalogGauge::getFactoryName() ) {
-        obj = new AnalogGauge;
-    }
-    else if ( name == GaugeSlider::getFactoryName() ) {
-        obj = new GaugeSlider;
-    }
+    FACTORY_ENTRY(AnalogGauge),
+    FACTORY_ENTRY(GaugeSlider),
     // Tape
-    else if ( name == Tape::getFactoryName() ) {
-        obj = new Tape;
-    }
+    FACTORY_ENTRY(Tape),
     // digital AOA gauge
-    else if ( name == AoAIndexer::getFactoryName() ) {
-        obj = new AoAIndexer;
-    }
+    FACTORY_ENTRY(AoAIndexer),
     // Tick Marks (horizontal and vertical)
-    else if ( name == TickMarks::getFactoryName() ) {
-        obj = new TickMarks;
-    }
+    FACTORY_ENTRY(TickMarks),
     // Landing Gear
-    else if ( name == LandingGear::getFactoryName() ) {
-        obj = new LandingGear;
-    }
+    FACTORY_ENTRY(LandingGear),
     // Landing Lights
-    else if ( name == LandingLight::getFactoryName() ) {
-        obj = new LandingLight;
-    }
+    FACTORY_ENTRY(LandingLight),
     // EngPage
-    else if ( name == EngPage::getFactoryName() ) {
-        obj = new EngPage;
-    }
+    FACTORY_ENTRY(EngPage),
     // Button
-    else if (name == Button::getFactoryName() ) {
-        obj = new Button;
-    }
+    FACTORY_ENTRY(Button),
     // Push Button
-    else if (name == PushButton::getFactoryName() ) {
-        obj = new PushButton;
-    }
+    FACTORY_ENTRY(PushButton),
     // Rotary Switch
-    else if (name == RotarySwitch::getFactoryName() ) {
-        obj = new RotarySwitch;
-    }
+    FACTORY_ENTRY(RotarySwitch),
     // Knob
-    else if (name == Knob::getFactoryName() ) {
-        obj = new Knob;
-    }
+    FACTORY_ENTRY(Knob),
     // Switch
-    else if (name == Switch::getFactoryName() ) {
-        obj = new Switch;
-    }
+    FACTORY_ENTRY(Switch),
     // Hold Switch
-    else if (name == SolenoidSwitch::getFactoryName() ) {
-        obj = new SolenoidSwitch;
-    }
+    FACTORY_ENTRY(SolenoidSwitch),
     // Hold Button
-    else if (name == SolenoidButton::getFactoryName() ) {
-        obj = new SolenoidButton;
-    }
+    FACTORY_ENTRY(SolenoidButton),
     // Adi
-    else if (name == Adi::getFactoryName() ) {
-        obj = new Adi;
-    }
+    FACTORY_ENTRY(Adi),
     // Ghost Horizon
-    else if (name == GhostHorizon::getFactoryName() ) {
-        obj = new GhostHorizon;
-    }
+    FACTORY_ENTRY(GhostHorizon),
     // Eadi3D
-    else if (name == Eadi3DPage::getFactoryName() ) {
-        obj = new Eadi3DPage;
-    }
+    FACTORY_ENTRY(Eadi3DPage),
+};
 
-    return obj;
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+
+}
+
+base::Object* factory(const std::string& name)
+{
+    return table.create(name);
 }
 
 }
@@ -0,0 +1,562 @@
+
+#include "mixr/interop/common/DrEngine.hpp"
+#include "mixr/interop/common/Nib.hpp"
+
+#include "mixr/base/units/angle_utils.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+#include <cmath>
+
+namespace mixr {
+namespace interop {
+
+//==============================================================================
+// DR math
+//==============================================================================
+
+// Below this angle (|w| * dT radians), the R1 and R2 coefficients are
+// computed with their Taylor series
+static const double SMALL_ANGLE = 1.0e-3;
+
+// Algorithm flags
+static const unsigned char ROTATE = 0x01;   // 1st order rotation
+static const unsigned char BODY   = 0x02;   // Body axis velocity and acceleration
+
+//------------------------------------------------------------------------------
+// R0 -- initial orientation matrix (World --> Body), row major
+//------------------------------------------------------------------------------
+static void computeR0(const double rpy[3], double r0[9])
+{
+   const double sinRol = std::sin(rpy[0]);
+   const double cosRol = std::cos(rpy[0]);
+   const double sinPch = std::sin(rpy[1]);
+   const double cosPch = std::cos(rpy[1]);
+   const double sinYaw = std::sin(rpy[2]);
+   const double cosYaw = std::cos(rpy[2]);
+
+   r0[0] = cosPch * cosYaw;
+   r0[1] = cosPch * sinYaw;
+   r0[2] = -sinPch;
+
+   r0[3] = sinRol * sinPch * cosYaw - cosRol * sinYaw;
+   r0[4] = sinRol * sinPch * sinYaw + cosRol * cosYaw;
+   r0[5] = sinRol * cosPch;
+
+   r0[6] = cosRol * sinPch * cosYaw + sinRol * sinYaw;
+   r0[7] = cosRol * sinPch * sinYaw - sinRol * cosYaw;
+   r0[8] = cosRol * cosPch;
+}
+
+//------------------------------------------------------------------------------
+// m = k1 * wwT + k2 * I + k3 * omega, row major
+//------------------------------------------------------------------------------
+static void computeMatrix(const double w[3], const double k1, const double k2, const double k3, double m[9])
+{
+   m[0] = w[0]*w[0]*k1 + k2;
+   m[1] = w[0]*w[1]*k1 - w[2]*k3;
+   m[2] = w[0]*w[2]*k1 + w[1]*k3;
+
+   m[3] = w[1]*w[0]*k1 + w[2]*k3;
+   m[4] = w[1]*w[1]*k1 + k2;
+   m[5] = w[1]*w[2]*k1 - w[0]*k3;
+
+   m[6] = w[2]*w[0]*k1 - w[1]*k3;
+   m[7] = w[2]*w[1]*k1 + w[0]*k3;
+   m[8] = w[2]*w[2]*k1 + k2;
+}
+
+//------------------------------------------------------------------------------
+// Euler angles of the rotational matrix 'rm' (same as nav::computeEulerAngles())
+//------------------------------------------------------------------------------
+static void computeEulerAngles(const double rm[9], double rpy[3])
+{
+   double stht = -rm[2];
+   if (-1.0 > stht) stht = -1.0;
+   if ( 1.0 < stht) stht =  1.0;
+
+   const double ctht = std::sqrt(1.0 - stht*stht);
+
+   double sphi = 0;
+   double cphi = 1;
+   if (ctht > 0) {
+      sphi = rm[5]/ctht;
+      if ( 1.0 < sphi) sphi =  1.0;
+      if (-1.0 > sphi) sphi = -1.0;
+
+      cphi = rm[8]/ctht;
+      if ( 1.0 < cphi) cphi =  1.0;
+      if (-1.0 > cphi) cphi = -1.0;
+   }
+
+   double spsi = rm[6]*sphi - rm[3]*cphi;
+   if ( 1.0 < spsi) spsi =  1.0;
+   if (-1.0 > spsi) spsi = -1.0;
+
+   double cpsi = rm[4]*cphi - rm[7]*sphi;
+   if ( 1.0 < cpsi) cpsi =  1.0;
+   if (-1.0 > cpsi) cpsi = -1.0;
+
+   rpy[0] = std::atan2(sphi,cphi);
+   rpy[1] = std::atan2(stht,ctht);
+   rpy[2] = std::atan2(spsi,cpsi);
+}
+
+//------------------------------------------------------------------------------
+// Euler angles after a 1st order rotation: DR(dT) * R0
+//------------------------------------------------------------------------------
+static void computeRotation(const double w[3], const double r0[9], const double dT, double rpy[3])
+{
+   const double absAV2 = w[0]*w[0] + w[1]*w[1] + w[2]*w[2];
+   if (absAV2 > 0.0) {
+      const double absAV1 = std::sqrt(absAV2);
+      const double cosWT = std::cos(absAV1 * dT);
+      const double sinWT = std::sin(absAV1 * dT);
+
+      // DR = wwT * k1 + I * k2 - omega * k3
+      double dr[9];
+      computeMatrix(w, (1.0 - cosWT) / absAV2, cosWT, -sinWT / absAV1, dr);
+
+      double rwb[9];
+      for (unsigned int i = 0; i < 3; i++) {
+         for (unsigned int j = 0; j < 3; j++) {
+            rwb[i*3+j] = dr[i*3]*r0[j] + dr[i*3+1]*r0[3+j] + dr[i*3+2]*r0[6+j];
+         }
+      }
+      computeEulerAngles(rwb, rpy);
+   }
+   else {
+      computeEulerAngles(r0, rpy);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Body axis displacement, rotated to the world frame: R0' * (R1*v0 + R2*a0)
+//------------------------------------------------------------------------------
+static void computeBodyDisplacement(
+      const double w[3], const double r0[9], const double v0[3], const double a0[3],
+      const double ka, const double dT, double dp[3])
+{
+   const double absAV2 = w[0]*w[0] + w[1]*w[1] + w[2]*w[2];
+   const double absAV1 = std::sqrt(absAV2);
+   const double wt = absAV1 * std::fabs(dT);
+
+   double r1k1, r1k2, r1k3;
+   double r2k1, r2k2, r2k3;
+   if (wt > SMALL_ANGLE) {
+      const double absAV3 = absAV2 * absAV1;
+      const double absAV4 = absAV1 * absAV3;
+      const double cosWT = std::cos(absAV1 * dT);
+      const double sinWT = std::sin(absAV1 * dT);
+
+      r1k1 = (absAV1 * dT - sinWT) / absAV3;
+      r1k2 = sinWT / absAV1;
+      r1k3 = (1.0 - cosWT) / absAV2;
+
+      r2k1 = (0.5*absAV2*dT*dT - cosWT - absAV1*dT*sinWT + 1.0) / absAV4;
+      r2k2 = (cosWT + absAV1*dT*sinWT - 1.0) / absAV2;
+      r2k3 = (sinWT - absAV1*dT*cosWT) / absAV3;
+   }
+   else {
+      // Taylor series (and the limits as |w| goes to zero)
+      const double dT2 = dT*dT;
+      const double dT3 = dT2*dT;
+      r1k1 = dT3 / 6.0;
+      r1k2 = dT - absAV2*dT3 / 6.0;
+      r1k3 = 0.5*dT2 - absAV2*dT2*dT2 / 24.0;
+
+      r2k1 = dT2*dT2 / 8.0;
+      r2k2 = 0.5*dT2 - absAV2*dT2*dT2 / 8.0;
+      r2k3 = dT3 / 3.0 - absAV2*dT3*dT2 / 30.0;
+   }
+
+   double r1[9];
+   computeMatrix(w, r1k1, r1k2, r1k3, r1);
+   double b[3];
+   b[0] = r1[0]*v0[0] + r1[1]*v0[1] + r1[2]*v0[2];
+   b[1] = r1[3]*v0[0] + r1[4]*v0[1] + r1[5]*v0[2];
+   b[2] = r1[6]*v0[0] + r1[7]*v0[1] + r1[8]*v0[2];
+
+   if (ka != 0.0) {
+      double r2[9];
+      computeMatrix(w, r2k1, r2k2, r2k3, r2);
+      b[0] += r2[0]*a0[0] + r2[1]*a0[1] + r2[2]*a0[2];
+      b[1] += r2[3]*a0[0] + r2[4]*a0[1] + r2[5]*a0[2];
+      b[2] += r2[6]*a0[0] + r2[7]*a0[1] + r2[8]*a0[2];
+   }
+
+   // R0 is World --> Body, so its transpose takes us back to the world
+   dp[0] = r0[0]*b[0] + r0[3]*b[1] + r0[6]*b[2];
+   dp[1] = r0[1]*b[0] + r0[4]*b[1] + r0[7]*b[2];
+   dp[2] = r0[2]*b[0] + r0[5]*b[1] + r0[8]*b[2];
+}
+
+//------------------------------------------------------------------------------
+// DR position and Euler angles of one set of T0 values
+//------------------------------------------------------------------------------
+static void evaluate(
+      const unsigned char flags, const double kv, const double ka,
+      const double p0[3], const double v0[3], const double a0[3],
+      const double rpy0[3], const double av0[3], const double r0[9],
+      const double dT, double p[3], double rpy[3])
+{
+   const double t = kv*dT;
+   const double ht = ka*(0.5*dT*dT);
+   for (unsigned int i = 0; i < 3; i++) {
+      p[i] = p0[i] + v0[i]*t + a0[i]*ht;
+      rpy[i] = rpy0[i];
+   }
+
+   if ((flags & ROTATE) != 0) computeRotation(av0, r0, dT, rpy);
+
+   if ((flags & BODY) != 0) {
+      double dp[3];
+      computeBodyDisplacement(av0, r0, v0, a0, ka, dT, dp);
+      for (unsigned int i = 0; i < 3; i++) {
+         p[i] = p0[i] + dp[i];
+      }
+   }
+}
+
+//==============================================================================
+// Class DrEngine
+//==============================================================================
+
+DrEngine::~DrEngine()
+{
+   for (unsigned int i = 0; i < numBlocks; i++) {
+      delete blocks[i];
+   }
+}
+
+//------------------------------------------------------------------------------
+// Velocity and acceleration coefficients, and flags, of DR algorithm 'dr'
+//------------------------------------------------------------------------------
+void DrEngine::setCoefficients(const unsigned char dr, double* const kv, double* const ka, unsigned char* const flags)
+{
+   *kv = 0.0;
+   *ka = 0.0;
+   *flags = 0;
+   switch (dr) {
+      case Nib::FPW_DRM: { *kv = 1.0; }                                      break;
+      case Nib::RPW_DRM: { *kv = 1.0; *flags = ROTATE; }                     break;
+      case Nib::RVW_DRM: { *kv = 1.0; *ka = 1.0; *flags = ROTATE; }          break;
+      case Nib::FVW_DRM: { *kv = 1.0; *ka = 1.0; }                           break;
+      case Nib::FPB_DRM: { *flags = BODY; }                                  break;
+      case Nib::RPB_DRM: { *flags = (ROTATE | BODY); }                       break;
+      case Nib::RVB_DRM: { *ka = 1.0; *flags = (ROTATE | BODY); }            break;
+      case Nib::FVB_DRM: { *ka = 1.0; *flags = BODY; }                       break;
+      default: break;   // STATIC_DRM, OTHER_DRM: no dead reckoning
+   }
+}
+
+//------------------------------------------------------------------------------
+// allocate() -- returns a new slot, or -1 if there are no more slots
+//------------------------------------------------------------------------------
+int DrEngine::allocate()
+{
+   int slot = -1;
+   base::lock( semaphore );
+   if (freeList >= 0) {
+      slot = freeList;
+      freeList = blocks[slot / BLOCK_SIZE]->next[slot % BLOCK_SIZE];
+   }
+   else if (numSlots < MAX_BLOCKS * BLOCK_SIZE) {
+      const unsigned int b = numSlots / BLOCK_SIZE;
+      if (b == numBlocks) {
+         blocks[b] = new Block();
+         numBlocks++;
+      }
+      slot = static_cast<int>(numSlots++);
+   }
+   base::unlock( semaphore );
+
+   if (slot >= 0) {
+      Block* const k = blocks[slot / BLOCK_SIZE];
+      const unsigned int i = slot % BLOCK_SIZE;
+      k->drm[i] = Nib::STATIC_DRM;
+      k->flags[i] = 0;
+      k->kv[i] = 0.0;
+      k->ka[i] = 0.0;
+      k->cstate[i] = CHK_NONE;
+   }
+   return slot;
+}
+
+//------------------------------------------------------------------------------
+// release() -- returns the slot to the free list
+//------------------------------------------------------------------------------
+void DrEngine::release(const int slot)
+{
+   if (slot < 0 || static_cast<unsigned int>(slot) >= numSlots) return;
+
+   base::lock( semaphore );
+   Block* const k = blocks[slot / BLOCK_SIZE];
+   k->cstate[slot % BLOCK_SIZE] = CHK_NONE;
+   k->next[slot % BLOCK_SIZE] = freeList;
+   freeList = slot;
+   base::unlock( semaphore );
+}
+
+//------------------------------------------------------------------------------
+// reset() -- sets the slot's DR algorithm and T0 values
+//------------------------------------------------------------------------------
+void DrEngine::reset(
+      const int slot,
+      const unsigned char dr,
+      const base::Vec3d& p,
+      const base::Vec3d& v,
+      const base::Vec3d& a,
+      const base::Vec3d& rpy,
+      const base::Vec3d& av
+   )
+{
+   Block* const k = blocks[slot / BLOCK_SIZE];
+   const unsigned int i = slot % BLOCK_SIZE;
+
+   double rpy0[3];
+   double r0[9];
+   for (unsigned int j = 0; j < 3; j++) {
+      k->p0[j][i] = p[j];
+      k->v0[j][i] = v[j];
+      k->a0[j][i] = a[j];
+      k->rpy0[j][i] = rpy[j];
+      k->av0[j][i] = av[j];
+      rpy0[j] = rpy[j];
+   }
+   computeR0(rpy0, r0);
+   for (unsigned int j = 0; j < 9; j++) {
+      k->r0[j][i] = r0[j];
+   }
+
+   setAlgorithm(slot, dr);
+}
+
+//------------------------------------------------------------------------------
+// setAlgorithm() -- sets the slot's DR algorithm
+//------------------------------------------------------------------------------
+void DrEngine::setAlgorithm(const int slot, const unsigned char dr)
+{
+   Block* const k = blocks[slot / BLOCK_SIZE];
+   const unsigned int i = slot % BLOCK_SIZE;
+   k->drm[i] = dr;
+   setCoefficients(dr, &k->kv[i], &k->ka[i], &k->flags[i]);
+   k->cstate[i] = CHK_NONE;
+}
+
+//------------------------------------------------------------------------------
+// compute() -- computes the slot's DR position and Euler angles at time 'dT'
+//------------------------------------------------------------------------------
+void DrEngine::compute(const int slot, const double dT, base::Vec3d* const pNewP0, base::Vec3d* const pNewRPY) const
+{
+   const Block* const k = blocks[slot / BLOCK_SIZE];
+   const unsigned int i = slot % BLOCK_SIZE;
+
+   double p0[3], v0[3], a0[3], rpy0[3], av0[3], r0[9];
+   for (unsigned int j = 0; j < 3; j++) {
+      p0[j] = k->p0[j][i];
+      v0[j] = k->v0[j][i];
+      a0[j] = k->a0[j][i];
+      rpy0[j] = k->rpy0[j][i];
+      av0[j] = k->av0[j][i];
+   }
+   for (unsigned int j = 0; j < 9; j++) {
+      r0[j] = k->r0[j][i];
+   }
+
+   double p[3], rpy[3];
+   evaluate(k->flags[i], k->kv[i], k->ka[i], p0, v0, a0, rpy0, av0, r0, dT, p, rpy);
+   pNewP0->set(p[0], p[1], p[2]);
+   pNewRPY->set(rpy[0], rpy[1], rpy[2]);
+}
+
+//------------------------------------------------------------------------------
+// deadReckon() -- computes the DR position and Euler angles without a slot
+//------------------------------------------------------------------------------
+void DrEngine::deadReckon(
+      const unsigned char dr,
+      const base::Vec3d& p0,
+      const base::Vec3d& v0,
+      const base::Vec3d& a0,
+      const base::Vec3d& rpy0,
+      const base::Vec3d& av0,
+      const double dT,
+      base::Vec3d* const pNewP0,
+      base::Vec3d* const pNewRPY
+   )
+{
+   double kv {}, ka {};
+   unsigned char flags {};
+   setCoefficients(dr, &kv, &ka, &flags);
+
+   const double xp0[3] = { p0[0], p0[1], p0[2] };
+   const double xv0[3] = { v0[0], v0[1], v0[2] };
+   const double xa0[3] = { a0[0], a0[1], a0[2] };
+   const double xrpy0[3] = { rpy0[0], rpy0[1], rpy0[2] };
+   const double xav0[3] = { av0[0], av0[1], av0[2] };
+   double r0[9];
+   computeR0(xrpy0, r0);
+
+   double p[3], rpy[3];
+   evaluate(flags, kv, ka, xp0, xv0, xa0, xrpy0, xav0, r0, dT, p, rpy);
+   pNewP0->set(p[0], p[1], p[2]);
+   pNewRPY->set(rpy[0], rpy[1], rpy[2]);
+}
+
+//------------------------------------------------------------------------------
+// computeErrors() -- position and angle error flags
+//------------------------------------------------------------------------------
+void DrEngine::computeErrors(
+      const base::Vec3d& drPos,
+      const base::Vec3d& drRPY,
+      const base::Vec3d& pos,
+      const base::Vec3d& rpy,
+      const double maxPosErr,
+      const double maxAngErr,
+      bool* const posErr,
+      bool* const angErr
+   )
+{
+   const base::Vec3d errPos = drPos - pos;
+   *posErr = (errPos.length2() >= maxPosErr*maxPosErr);
+
+   bool err = false;
+   for (unsigned int j = 0; j < 3; j++) {
+      if (std::fabs( base::angle::aepcdDeg(drRPY[j] - rpy[j]) ) >= maxAngErr) err = true;
+   }
+   *angErr = err;
+}
+
+//------------------------------------------------------------------------------
+// setErrorCheck() -- queues a DR error check of the slot
+//------------------------------------------------------------------------------
+void DrEngine::setErrorCheck(
+      const int slot,
+      const double time,
+      const double dT,
+      const base::Vec3d& pos,
+      const base::Vec3d& rpy,
+      const double maxPosErr,
+      const double maxAngErr
+   )
+{
+   Block* const k = blocks[slot / BLOCK_SIZE];
+   const unsigned int i = slot % BLOCK_SIZE;
+
+   k->ctime[i] = time;
+   k->cdt[i] = dT;
+   for (unsigned int j = 0; j < 3; j++) {
+      k->cpos[j][i] = pos[j];
+      k->crpy[j][i] = rpy[j];
+   }
+   k->cmaxPos2[i] = maxPosErr*maxPosErr;
+   k->cmaxAng[i] = maxAngErr;
+   if (k->cstate[i] != CHK_PENDING) {
+      k->cstate[i] = CHK_PENDING;
+      k->numPending++;
+   }
+}
+
+//------------------------------------------------------------------------------
+// processErrorChecks() -- computes all of the queued DR error checks
+//------------------------------------------------------------------------------
+void DrEngine::processErrorChecks()
+{
+   const unsigned int nb = numBlocks;
+   for (unsigned int b = 0; b < nb; b++) {
+      Block* const k = blocks[b];
+      if (k->numPending == 0) continue;
+
+      double px[BLOCK_SIZE], py[BLOCK_SIZE], pz[BLOCK_SIZE];
+      double ax[BLOCK_SIZE], ay[BLOCK_SIZE], az[BLOCK_SIZE];
+
+      // ---
+      // 1) World linear motion and T0 angles of every slot
+      // ---
+      for (unsigned int i = 0; i < BLOCK_SIZE; i++) {
+         const double dT = k->cdt[i];
+         const double t = k->kv[i]*dT;
+         const double ht = k->ka[i]*(0.5*dT*dT);
+         px[i] = k->p0[0][i] + k->v0[0][i]*t + k->a0[0][i]*ht;
+         py[i] = k->p0[1][i] + k->v0[1][i]*t + k->a0[1][i]*ht;
+         pz[i] = k->p0[2][i] + k->v0[2][i]*t + k->a0[2][i]*ht;
+         ax[i] = k->rpy0[0][i];
+         ay[i] = k->rpy0[1][i];
+         az[i] = k->rpy0[2][i];
+      }
+
+      // ---
+      // 2) Rotations and body axis motion of the pending slots that need them
+      // ---
+      for (unsigned int i = 0; i < BLOCK_SIZE; i++) {
+         if (k->cstate[i] != CHK_PENDING || k->flags[i] == 0) continue;
+
+         const double w[3] = { k->av0[0][i], k->av0[1][i], k->av0[2][i] };
+         double r0[9];
+         for (unsigned int j = 0; j < 9; j++) r0[j] = k->r0[j][i];
+
+         if ((k->flags[i] & ROTATE) != 0) {
+            double rpy[3];
+            computeRotation(w, r0, k->cdt[i], rpy);
+            ax[i] = rpy[0];
+            ay[i] = rpy[1];
+            az[i] = rpy[2];
+         }
+         if ((k->flags[i] & BODY) != 0) {
+            const double v0[3] = { k->v0[0][i], k->v0[1][i], k->v0[2][i] };
+            const double a0[3] = { k->a0[0][i], k->a0[1][i], k->a0[2][i] };
+            double dp[3];
+            computeBodyDisplacement(w, r0, v0, a0, k->ka[i], k->cdt[i], dp);
+            px[i] = k->p0[0][i] + dp[0];
+            py[i] = k->p0[1][i] + dp[1];
+            pz[i] = k->p0[2][i] + dp[2];
+         }
+      }
+
+      // ---
+      // 3) Position errors of every slot
+      // ---
+      for (unsigned int i = 0; i < BLOCK_SIZE; i++) {
+         const double ex = px[i] - k->cpos[0][i];
+         const double ey = py[i] - k->cpos[1][i];
+         const double ez = pz[i] - k->cpos[2][i];
+         const double e2 = ex*ex + ey*ey + ez*ez;
+         k->cerr[i] = static_cast<unsigned char>(e2 >= k->cmaxPos2[i]);
+      }
+
+      // ---
+      // 4) Angle errors of the pending slots
+      // ---
+      for (unsigned int i = 0; i < BLOCK_SIZE; i++) {
+         if (k->cstate[i] != CHK_PENDING) continue;
+
+         const double maxAng = k->cmaxAng[i];
+         const bool angErr =
+            (std::fabs( base::angle::aepcdDeg(ax[i] - k->crpy[0][i]) ) >= maxAng) ||
+            (std::fabs( base::angle::aepcdDeg(ay[i] - k->crpy[1][i]) ) >= maxAng) ||
+            (std::fabs( base::angle::aepcdDeg(az[i] - k->crpy[2][i]) ) >= maxAng);
+         if (angErr) k->cerr[i] |= 0x02;
+         k->cstate[i] = CHK_DONE;
+      }
+
+      k->numPending = 0;
+   }
+}
+
+//------------------------------------------------------------------------------
+// getErrorCheck() -- results of the slot's last DR error check
+//------------------------------------------------------------------------------
+bool DrEngine::getErrorCheck(const int slot, const double time, bool* const posErr, bool* const angErr) const
+{
+   if (slot < 0 || static_cast<unsigned int>(slot) >= numSlots) return false;
+
+   const Block* const k = blocks[slot / BLOCK_SIZE];
+   const unsigned int i = slot % BLOCK_SIZE;
+   if (k->cstate[i] != CHK_DONE || k->ctime[i] != time) return false;
+
+   *posErr = ((k->cerr[i] & 0x01) != 0);
+   *angErr = ((k->cerr[i] & 0x02) != 0);
+   return true;
+}
+
+}
+}
@@ -159,17 +159,25 @@ void NetIO::copyData(const NetIO& org, const bool)
 
 void NetIO::deleteData()
 {
+   inputIndex.clear();
    for (unsigned int i = 0; i < nInNibs; i++) {
       inputList[i]->unref();
       inputList[i] = nullptr;
    }
    nInNibs = 0;
+   delete[] inputList;
+   inputList = nullptr;
+   inputListSize = 0;
 
+   outputIndex.clear();
    for (unsigned int i = 0; i < nOutNibs; i++) {
       outputList[i]->unref();
       outputList[i] = nullptr;
    }
    nOutNibs = 0;
+   delete[] outputList;
+   outputList = nullptr;
+   outputListSize = 0;
 
    clearInputEntityTypes();
    clearOutputEntityTypes();
@@ -414,6 +422,7 @@ void NetIO::cleanupInputList()
                inputList[i] = inputList[i+1];
             }
             inputList[nInNibs] = nullptr;
+            inputIndex.remove(getNibKey(nib), nib);
 
             // 2) Destroy the NIB
             destroyInputNib(nib);
@@ -428,6 +437,7 @@ void NetIO::cleanupInputList()
                inputList[i] = inputList[i+1];
             }
             inputList[nInNibs] = nullptr;
+            inputIndex.remove(getNibKey(nib), nib);
 
             // 2) Destroy the NIB
             destroyInputNib(nib);
@@ -458,6 +468,7 @@ void NetIO::updateOutputList()
             if (outputList[i]->isMode(models::Player::DELETE_REQUEST)) {
                // Deleting this NIB
                //std::cout << "NetIO::updateOutputList() cleanup: nib = " << outputList[i] << std::endl;
+               outputIndex.remove(getNibKey(outputList[i]), outputList[i]);
                destroyOutputNib(outputList[i++]);
             }
             else {
@@ -541,6 +552,15 @@ void NetIO::updateOutputList()
 //------------------------------------------------------------------------------
 void NetIO::processOutputList()
 {
+   // ---
+   // Check the dead reckoning errors of all local players in one batch;
+   // the results are used by the NIBs' isPlayerStateUpdateRequired()
+   // ---
+   for (unsigned int idx = 0; idx < getOutputListSize(); idx++) {
+      getOutputNib(idx)->queueDrErrorCheck();
+   }
+   outputDr.processErrorChecks();
+
    // ---
    // Send player states
    // ---
@@ -760,20 +780,16 @@ bool NetIO::addNib2InputList(Nib* const nib)
 //------------------------------------------------------------------------------
 Nib* NetIO::findNib(const unsigned short playerID, const base::String* const federateName, const IoType ioType)
 {
-   // Define the key
-   NibKey key(playerID, federateName);
+   Nib* found = findNibByKey(makeNibKey(playerID, federateName), ioType);
 
-   // Binary search the table for the NIB
-   Nib* found = nullptr;
-   if (ioType == INPUT_NIB) {
-      Nib** k =
-         static_cast<Nib**>(bsearch(&key, inputList.data(), nInNibs, sizeof(Nib*), compareKey2Nib));
-      if (k != nullptr) found = *k;
-   }
-   else {
-      Nib** k =
-         static_cast<Nib**>(bsearch(&key, outputList.data(), nOutNibs, sizeof(Nib*), compareKey2Nib));
-      if (k != nullptr) found = *k;
+   if (found != nullptr && !isNibMatch(found, playerID, federateName)) {
+      // Another NIB has the same key, so search the list
+      found = nullptr;
+      Nib** tbl = (ioType == INPUT_NIB ? inputList : outputList);
+      const unsigned int n = (ioType == INPUT_NIB ? nInNibs : nOutNibs);
+      for (unsigned int i = 0; i < n && found == nullptr; i++) {
+         if (isNibMatch(tbl[i], playerID, federateName)) found = tbl[i];
+      }
    }
    return found;
 }
@@ -796,59 +812,50 @@ Nib* NetIO::findNib(const models::Player* const player, const IoType ioType)
 }
 
 //------------------------------------------------------------------------------
-// addNibToList() -- adds a NIB to the quick access table
+// addNibToList() -- adds a NIB to the list and the quick access index
 //------------------------------------------------------------------------------
 bool NetIO::addNibToList(Nib* const nib, const IoType ioType)
 {
    bool ok = false;
    if (nib != nullptr) {
-      Nib** tbl = inputList.data();
-      int n = nInNibs;
-      if (ioType == OUTPUT_NIB) {
-         tbl = outputList.data();
-         n = nOutNibs;
+      Nib**& tbl = (ioType == INPUT_NIB ? inputList : outputList);
+      unsigned int& size = (ioType == INPUT_NIB ? inputListSize : outputListSize);
+      unsigned int& n = (ioType == INPUT_NIB ? nInNibs : nOutNibs);
+
+      // Grow the table as needed
+      if (n == size) {
+         const unsigned int newSize = (size > 0 ? size * 2 : 256);
+         Nib** newTbl = new Nib*[newSize];
+         for (unsigned int i = 0; i < newSize; i++) {
+            newTbl[i] = (i < n ? tbl[i] : nullptr);
+         }
+         delete[] tbl;
+         tbl = newTbl;
+         size = newSize;
       }
 
-      if (n < MAX_OBJECTS) {
-
-         // Put the NIB on the top of the table
-         nib->ref();
-         tbl[n] = nib;
-
-         // Create a key for this new NIB
-         NibKey key(nib->getPlayerID(), nib->getFederateName());
-
-         if (n > 0) {
-            // Now, 'bubble down' to its correct position
-            int idx = n-1;
-            while (idx >= 0 && compareKey2Nib(&key, &tbl[idx]) <= 0) {
-               // Swap the table entries
-               Nib* tmp = tbl[idx];
-               tbl[idx] = tbl[idx+1];
-               tbl[idx+1] = tmp;
-               idx--;
-            }
-         }
+      // Put the NIB on the top of the table
+      nib->ref();
+      tbl[n++] = nib;
 
-         // Increment the count
-         if (ioType == OUTPUT_NIB) nOutNibs++;
-         else nInNibs++;
+      // and add it to the index
+      if (ioType == INPUT_NIB) inputIndex.insert(getNibKey(nib), nib);
+      else outputIndex.insert(getNibKey(nib), nib);
 
-         ok = true;
-      }
+      ok = true;
    }
    return ok;
 }
 
 //------------------------------------------------------------------------------
-// removeNibFromList() -- removes a NIB from the quick access table
+// removeNibFromList() -- removes a NIB from the list and the quick access index
 //------------------------------------------------------------------------------
 void NetIO::removeNibFromList(Nib* const nib, const IoType ioType)
 {
-   Nib** tbl = inputList.data();
+   Nib** tbl = inputList;
    int n = nInNibs;
    if (ioType == OUTPUT_NIB) {
-      tbl = outputList.data();
+      tbl = outputList;
       n = nOutNibs;
    }
 
@@ -860,6 +867,9 @@ void NetIO::removeNibFromList(Nib* const nib, const IoType ioType)
 
    // Shift down all items above this NIB one position
    if (found >= 0) {
+      if (ioType == OUTPUT_NIB) outputIndex.remove(getNibKey(nib), nib);
+      else inputIndex.remove(getNibKey(nib), nib);
+
       tbl[found]->unref();
       int n1 = (n - 1);
       for (int i = found; i < n1; i++) {
@@ -874,32 +884,38 @@ void NetIO::removeNibFromList(Nib* const nib, const IoType ioType)
 }
 
 //------------------------------------------------------------------------------
-// bsearch callbacks: object name compare function --
-//   True types are (const NibKey* key, const Nib** nib)
+// NIB index keys -- player ID (16 LSBs) and a hash of the federate name
 //------------------------------------------------------------------------------
-int NetIO::compareKey2Nib(const void* key, const void* nib)
+std::uint64_t NetIO::getNibKey(const Nib* const nib) const
 {
+   return makeNibKey(nib->getPlayerID(), nib->getFederateName());
+}
 
-   // The Key
-   const NibKey* pKey = static_cast<const NibKey*>(key);
-
-   // The NIB
-   const Nib* const* pp = static_cast<const Nib* const*>(nib);
-   const Nib* pNib = *pp;
-
-   // Default to equal
-   int result = 0;
-
-   // First, compare the player IDs
-   if (pKey->id > pNib->getPlayerID()) result = +1;
-   else if (pKey->id < pNib->getPlayerID()) result = -1;
-
-   if (result == 0) {
-      // If they're the same, compare the federate names
-      result = std::strcmp(*pKey->fName, *pNib->getFederateName());
+std::uint64_t NetIO::makeNibKey(const unsigned short playerID, const base::String* const federateName) const
+{
+   // FNV-1a hash of the federate name
+   std::uint64_t h = 0xcbf29ce484222325ULL;
+   if (federateName != nullptr) {
+      const char* p = *federateName;
+      while (p != nullptr && *p != '\0') {
+         h ^= static_cast<unsigned char>(*p++);
+         h *= 0x100000001b3ULL;
+      }
    }
+   return ((h << 16) | playerID);
+}
 
-   return result;
+//------------------------------------------------------------------------------
+// isNibMatch() -- True if the NIB's player ID and federate name match
+//------------------------------------------------------------------------------
+bool NetIO::isNibMatch(const Nib* const nib, const unsigned short playerID, const base::String* const federateName)
+{
+   if (nib->getPlayerID() != playerID) return false;
+
+   const base::String* const nibName = nib->getFederateName();
+   if (nibName == federateName) return true;
+   if (nibName == nullptr || federateName == nullptr) return false;
+   return (std::strcmp(*nibName, *federateName) == 0);
 }
 
 //------------------------------------------------------------------------------
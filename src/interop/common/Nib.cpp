@@ -39,9 +39,6 @@ void Nib::initData()
    drA0.set(0,0,0);
    drRPY0.set(0,0,0);
    drAV0.set(0,0,0);
-   drR0.identity();
-   drWwT.identity();
-   drOmega.identity();
 
    drPos.set(0,0,0);
    drAngles.set(0,0,0);
@@ -89,9 +86,6 @@ void Nib::copyData(const Nib& org, const bool cc)
    drA0 = org.drA0;
    drRPY0 = org.drRPY0;
    drAV0 = org.drAV0;
-   drR0 = org.drR0;
-   drWwT = org.drWwT;
-   drOmega = org.drOmega;
 
    drTime = org.drTime;
    drPos = org.drPos;
@@ -285,7 +279,25 @@ bool Nib::setTypeMapper(const Ntm* const p)
 //------------------------------------------------------------------------------
 bool Nib::setNetIO(NetIO* const p)
 {
+    // Release our old DR engine slot
+    if (drEngine != nullptr) {
+       drEngine->release(drSlot);
+       drEngine = nullptr;
+       drSlot = -1;
+    }
+
     pNetIO = p;
+
+    // Move our DR state to the new NetIO's DR engine
+    if (p != nullptr) {
+       DrEngine* const engine = p->getDrEngine(ioType);
+       const int slot = engine->allocate();
+       if (slot >= 0) {
+          engine->reset(slot, drNum, drP0, drV0, drA0, drRPY0, drAV0);
+          drEngine = engine;
+          drSlot = slot;
+       }
+    }
     return true;
 }
 
@@ -293,6 +305,13 @@ bool Nib::setNetIO(NetIO* const p)
 // Player data set functions
 //------------------------------------------------------------------------------
 
+bool Nib::setDeadReckoning(const unsigned char dr)
+{
+   drNum = dr;
+   if (drEngine != nullptr) drEngine->setAlgorithm(drSlot, drNum);
+   return true;
+}
+
 void Nib::setTimeExec(const double t)
 {
     execTime = t;
@@ -423,48 +442,31 @@ bool Nib::isPlayerStateUpdateRequired(const double curExecTime)
       // 3-d) Check dead reckoning errors
       if (result == UNSURE && isNotFrozen()) {
 
-         // Compute our dead reckoned position and angles, which are
-         // based on our last packet sent.
-         base::Vec3d drPos;
-         base::Vec3d drAngles;
-         mainDeadReckoning(drTime, &drPos, &drAngles);
+         // Our dead reckoned position and angles, which are based on our
+         // last packet sent, are compared with the player's by our NetIO's
+         // batch of DR error checks; if we weren't in the batch, or the
+         // player's state has changed since, then we check them now.
+         bool posErr = false;
+         bool angErr = false;
+         if ( drEngine == nullptr || !drEngine->getErrorCheck(drSlot, playerState.getTimeExec(), &posErr, &angErr) ) {
+            base::Vec3d drPos;
+            base::Vec3d drAngles;
+            mainDeadReckoning(drTime, &drPos, &drAngles);
+            DrEngine::computeErrors(
+               drPos, drAngles,
+               playerState.getGeocPosition(), playerState.getGeocEulerAngles(),
+               getNetIO()->getMaxPositionErr(this), getNetIO()->getMaxOrientationErr(this),
+               &posErr, &angErr);
+         }
 
          // 3-d-1) Position error
-         if (!player->isPositionFrozen() && !player->isAltitudeFrozen()) {
-
-            // max position error (meters)
-            const double maxPosErr = getNetIO()->getMaxPositionErr(this);
-            const double maxPosErr2 = maxPosErr*maxPosErr;  // squared
-
-            // Check if the length of the position error (squared) is greater
-            // than the max error (squared)
-            //base::Vec3d ppos = player->getGeocPosition();
-            const base::Vec3d ppos = playerState.getGeocPosition();
-            const base::Vec3d errPos = drPos - ppos;
-            if (errPos.length2() >= maxPosErr2) {
-               result = YES;
-            }
+         if (!player->isPositionFrozen() && !player->isAltitudeFrozen() && posErr) {
+            result = YES;
          }
 
          // 3-d-2) Orientation error
-         if (result == UNSURE && !player->isAttitudeFrozen()) {
-
-            // max angle error (radians)
-            const double maxAngleErr = getNetIO()->getMaxOrientationErr(this);
-
-            // Compute angular error
-            //base::Vec3 errAngles = drAngles - player->getGeocEulerAngles();
-            base::Vec3d errAngles = drAngles - playerState.getGeocEulerAngles();
-
-            // Check if any angle error is greater than the max error
-            errAngles[0] = std::fabs( base::angle::aepcdDeg(errAngles[0]) );
-            if (errAngles[0] >= maxAngleErr) result = YES;
-
-            errAngles[1] = std::fabs( base::angle::aepcdDeg(errAngles[1]) );
-            if (errAngles[1] >= maxAngleErr) result = YES;
-
-            errAngles[2] = std::fabs( base::angle::aepcdDeg(errAngles[2]) );
-            if (errAngles[2] >= maxAngleErr) result = YES;
+         if (result == UNSURE && !player->isAttitudeFrozen() && angErr) {
+            result = YES;
          }
       }
    }
@@ -766,11 +768,9 @@ bool Nib::resetDeadReckoning(
    drAV0 = av;
 
    // ---
-   // Compute the matrices
+   // Update our DR engine slot
    // ---
-   drComputeMatrixR0(drRPY0, &drR0);
-   drComputeMatrixWwT(drAV0, &drWwT);
-   drComputeMatrixOmega(drAV0, &drOmega);
+   if (drEngine != nullptr) drEngine->reset(drSlot, dr, drP0, drV0, drA0, drRPY0, drAV0);
 
    // ---
    // Update the smoothing values ...
@@ -822,381 +822,44 @@ bool Nib::resetDeadReckoning(
 }
 
 //------------------------------------------------------------------------------
-// Main Dead Reckoning Function
-//------------------------------------------------------------------------------
-bool Nib::mainDeadReckoning(
-      const double dT,                 // DR time (seconds)
-      base::Vec3d* const pNewP0,       // DR Position vector @ time = 'dT' (meters) (ECEF)
-      base::Vec3d* const pNewRPY       // DR Euler angles @ time = 'dT' (rad) [ phi theta psi ] (Body/ECEF)
-   ) const
-{
-   switch (drNum) {
-
-      // World, No rotation, 1st order linear
-      case FPW_DRM: {
-         *pNewRPY = drRPY0;
-         *pNewP0 = drP0 + drV0*dT;
-      }
-      break;
-
-      // World, 1st order rotation, 1st order linear
-      case RPW_DRM: {
-         base::Matrixd DR;
-         drComputeMatrixDR(dT, drAV0, drWwT, drOmega, &DR);
-         base::Matrixd Rwb = DR * drR0;
-         base::nav::computeEulerAngles(Rwb, pNewRPY);
-
-         *pNewP0 = drP0 + drV0*dT;
-      }
-      break;
-
-      // World, 1st order rotation, 2nd order linear
-      case RVW_DRM: {
-         base::Matrixd DR;
-         drComputeMatrixDR(dT, drAV0, drWwT, drOmega, &DR);
-         base::Matrixd Rwb = DR * drR0;
-         base::nav::computeEulerAngles(Rwb, pNewRPY);
-
-         *pNewP0 = drP0 + drV0*dT + drA0*(0.5*dT*dT);
-      }
-      break;
-
-      // World, No rotation, 2nd order linear
-      case FVW_DRM: {
-         *pNewRPY = drRPY0;
-         *pNewP0 = drP0 + drV0*dT + drA0*(0.5*dT*dT);
-      }
-      break;
-
-      // Body, No rotation, 1st order linear
-      case FPB_DRM: {
-         *pNewRPY = drRPY0;
-
-         base::Matrixd R1;
-         drComputeMatrixR1(dT, drAV0, drWwT, drOmega, &R1);
-
-         base::Matrixd Rwb = drR0;
-         Rwb.transpose();
-
-         *pNewP0 = drP0 + Rwb * (R1 * drV0);
-      }
-      break;
-
-      // Body, 1st order rotation, 1st order linear
-      case RPB_DRM: {
-         base::Matrixd DR;
-         drComputeMatrixDR(dT, drAV0, drWwT, drOmega, &DR);
-         base::Matrixd Rwb = DR * drR0;
-
-         base::nav::computeEulerAngles(Rwb, pNewRPY);
-
-         base::Matrixd R1;
-         drComputeMatrixR1(dT, drAV0, drWwT, drOmega, &R1);
-
-         Rwb.transpose();
-         *pNewP0 = drP0 + Rwb * (R1 * drV0);
-      }
-      break;
-
-      // Body, 1st order rotation, 2nd order linear
-      case RVB_DRM: {
-         base::Matrixd DR;
-         drComputeMatrixDR(dT, drAV0, drWwT, drOmega, &DR);
-         base::Matrixd Rwb = DR * drR0;
-
-         base::nav::computeEulerAngles(Rwb, pNewRPY);
-
-         base::Matrixd R1;
-         drComputeMatrixR1(dT, drAV0, drWwT, drOmega, &R1);
-
-         base::Matrixd R2;
-         drComputeMatrixR2(dT, drAV0, drWwT, drOmega, &R1);
-
-         Rwb.transpose();
-         *pNewP0 = drP0 + Rwb * ((R1*drV0) + (R2*drA0));
-      }
-      break;
-
-      // Body, No rotation, 2nd order linear
-      case FVB_DRM: {
-         *pNewRPY = drRPY0;
-
-         base::Matrixd R1;
-         drComputeMatrixR1(dT, drAV0, drWwT, drOmega, &R1);
-
-         base::Matrixd R2;
-         drComputeMatrixR2(dT, drAV0, drWwT, drOmega, &R1);
-
-         base::Matrixd Rwb = drR0;
-         Rwb.transpose();
-
-         *pNewP0 = drP0 + Rwb * ((R1*drV0) + (R2*drA0));
-      }
-      break;
-
-      // No dead reckoning
-      case STATIC_DRM: {
-         *pNewP0 = drP0;
-         *pNewRPY = drRPY0;
-      }
-      break;
-
-      case OTHER_DRM:   // User defined
-      default:          // default
-         std::cout << "drNum == default" << std::endl;
-         *pNewP0 = drP0;
-         *pNewRPY = drRPY0;
-      break;
-   }
-
-   return true;
-}
-
-//------------------------------------------------------------------------------
-// drComputeMatrixR0
+// queueDrErrorCheck() -- queues our DR error check with our NetIO's batch
 //------------------------------------------------------------------------------
-bool Nib::drComputeMatrixR0(
-      const base::Vec3d& RPY,      // [radians]
-      base::Matrixd* const pR0     // Rotational matrix R0
-   )
+void Nib::queueDrErrorCheck()
 {
-   //--------------------------------------------------------------------------
-   // intermediate values
-   //--------------------------------------------------------------------------
-
-   const double Rol = RPY[0];
-   const double Pch = RPY[1];
-   const double Yaw = RPY[2];
-
-   const double sinRol = std::sin(Rol);
-   const double cosRol = std::cos(Rol);
-   const double sinPch = std::sin(Pch);
-   const double cosPch = std::cos(Pch);
-   const double sinYaw = std::sin(Yaw);
-   const double cosYaw = std::cos(Yaw);
-
-   //--------------------------------------------------------------------------
-   // Compute R0 - initial orientation matrix (World --> Body)
-   //--------------------------------------------------------------------------
-   (*pR0)(0,0) = cosPch * cosYaw;
-   (*pR0)(0,1) = cosPch * sinYaw;
-   (*pR0)(0,2) = -sinPch;
-
-   (*pR0)(1,0) = sinRol * sinPch * cosYaw - cosRol * sinYaw;
-   (*pR0)(1,1) = sinRol * sinPch * sinYaw + cosRol * cosYaw;
-   (*pR0)(1,2) = sinRol * cosPch;
-
-   (*pR0)(2,0) = cosRol * sinPch * cosYaw + sinRol * sinYaw;
-   (*pR0)(2,1) = cosRol * sinPch * sinYaw - sinRol * cosYaw;
-   (*pR0)(2,2) = cosRol * cosPch;
-
-   return true;
-}
-
-
-//------------------------------------------------------------------------------
-// Compute wwT matrix
-//------------------------------------------------------------------------------
-bool Nib::drComputeMatrixWwT(
-      const base::Vec3d& av,       // angular velocities [rps]
-      base::Matrixd* const pwwT    // matrix
-   )
-{
-   //--------------------------------------------------------------------------
-   // Compute wwT Matrix
-   //--------------------------------------------------------------------------
-
-   const double Wx = av[0];
-   const double Wy = av[1];
-   const double Wz = av[2];
-
-   (*pwwT)(0,0) = Wx * Wx;
-   (*pwwT)(0,1) = Wx * Wy;
-   (*pwwT)(0,2) = Wx * Wz;
-
-   (*pwwT)(1,0) = Wy * Wx;
-   (*pwwT)(1,1) = Wy * Wy;
-   (*pwwT)(1,2) = Wy * Wz;
-
-   (*pwwT)(2,0) = Wz * Wx;
-   (*pwwT)(2,1) = Wz * Wy;
-   (*pwwT)(2,2) = Wz * Wz;
-
-   return true;
-}
-
-
-//------------------------------------------------------------------------------
-// Compute the Omega matrix
-//------------------------------------------------------------------------------
-bool Nib::drComputeMatrixOmega(
-      const base::Vec3d& av,       // angular velocities [rps]
-      base::Matrixd* const pOmega  // matrix
-   )
-{
-   //--------------------------------------------------------------------------
-   // Compute Omega Matrix
-   //--------------------------------------------------------------------------
-
-   const double Wx = av[0];
-   const double Wy = av[1];
-   const double Wz = av[2];
-
-   (*pOmega)(0,0) = 0.0;
-   (*pOmega)(0,1) = -Wz;
-   (*pOmega)(0,2) = +Wy;
-
-   (*pOmega)(1,0) = +Wz;
-   (*pOmega)(1,1) = 0.0;
-   (*pOmega)(1,2) = -Wx;
-
-   (*pOmega)(2,0) = -Wy;
-   (*pOmega)(2,1) = +Wx;
-   (*pOmega)(2,2) = 0.0;
-
-   return true;
-}
-
-
-//------------------------------------------------------------------------------
-// drComputeMatrixDR
-//------------------------------------------------------------------------------
-bool Nib::drComputeMatrixDR(
-      const double dT,            // DR time [sec]
-      const base::Vec3d& av,      // angular velocities [rps]
-      const base::Matrixd& wwT,   // wwT matrix
-      const base::Matrixd& omega, // omega matrix
-      base::Matrixd* const pDR    // DR matrix
-   )
-{
-   //--------------------------------------------------------------------------
-   // intermediate values
-   //--------------------------------------------------------------------------
-
-   const double Wx = av[0];
-   const double Wy = av[1];
-   const double Wz = av[2];
-   const double absAV2 = Wx*Wx + Wy*Wy + Wz*Wz;
-
-   if (absAV2 > 0.0) {
-      const double absAV1 = std::sqrt(absAV2);
-
-      const double cosWT = std::cos(absAV1 * dT);
-      const double sinWT = std::sin(absAV1 * dT);
-
-      //--------------------------------------------------------------------------
-      // Get matrix scaling Coefficients (k1, k2, k3)
-      //--------------------------------------------------------------------------
-      const double k1 = (1.0 - cosWT) / absAV2;
-      const double k2 = cosWT;
-      const double k3 = sinWT / absAV1;
-
-      //--------------------------------------------------------------------------
-      // Compute Dead Reckoning Matrix (DR)
-      //--------------------------------------------------------------------------
-      static const base::Matrixd I3;
-      *pDR = wwT*k1 + I3*k2 - omega*k3;
-   }
-   else {
-      pDR->identity();
-   }
-
-   return true;
-}
-
-
-//------------------------------------------------------------------------------
-// drComputeMatrixR1
-//------------------------------------------------------------------------------
-bool Nib::drComputeMatrixR1(
-      const double dT,            // DR time [sec]
-      const base::Vec3d& av,      // angular velocities [rps]
-      const base::Matrixd& wwT,   // wwT matrix
-      const base::Matrixd& omega, // omega matrix
-      base::Matrixd* const pR1    // Matrix R1
-   )
-{
-   //--------------------------------------------------------------------------
-   // intermediate values
-   //--------------------------------------------------------------------------
-
-   const double Wx = av[0];
-   const double Wy = av[1];
-   const double Wz = av[2];
-   const double absAV2 = Wx*Wx + Wy*Wy + Wz*Wz;
-
-   if (absAV2 > 0.0) {
-      const double absAV1 = std::sqrt(absAV2);
-      const double absAV3 = absAV2 * absAV1;
-
-      const double cosWT = std::cos(absAV1 * dT);
-      const double sinWT = std::sin(absAV1 * dT);
-
-      //----------------------------------------------------------------------
-      // Get Matrix Coefficients (k1, k2, k3)
-      //----------------------------------------------------------------------
-      const double k1 = (absAV1 * dT - sinWT) / absAV3;
-      const double k2 = sinWT / absAV1;
-      const double k3 = (1.0 - cosWT) / absAV2;
-
-      //----------------------------------------------------------------------
-      // Compute R1 Matrix
-      //----------------------------------------------------------------------
-      static const base::Matrixd I3;
-      *pR1 = wwT*k1 + I3*k2 + omega*k3;
-   }
-   else {
-      pR1->identity();
+   const models::Player* player = getPlayer();
+   if (drEngine != nullptr && ioType == NetIO::OUTPUT_NIB &&
+      player != nullptr && player->isLocalPlayer() &&
+      isEntityTypeValid() && isNotFrozen() ) {
+
+      const models::SynchronizedState playerState = player->getSynchronizedState();
+      const double dT = static_cast<double>(playerState.getTimeExec()) - getTimeExec();
+      drEngine->setErrorCheck(
+         drSlot,
+         playerState.getTimeExec(),
+         dT,
+         playerState.getGeocPosition(),
+         playerState.getGeocEulerAngles(),
+         getNetIO()->getMaxPositionErr(this),
+         getNetIO()->getMaxOrientationErr(this)
+      );
    }
-
-   return true;
 }
 
-
 //------------------------------------------------------------------------------
-// drComputeMatrixR2
+// Main Dead Reckoning Function
 //------------------------------------------------------------------------------
-bool Nib::drComputeMatrixR2(
-      const double dT,                 // DR time [sec]
-      const base::Vec3d& av,      // angular velocities [rps]
-      const base::Matrixd& wwT,   // wwT matrix
-      const base::Matrixd& omega, // omega matrix
-      base::Matrixd* const pR2    // Matrix R2
-   )
+bool Nib::mainDeadReckoning(
+      const double dT,                 // DR time (seconds)
+      base::Vec3d* const pNewP0,       // DR Position vector @ time = 'dT' (meters) (ECEF)
+      base::Vec3d* const pNewRPY       // DR Euler angles @ time = 'dT' (rad) [ phi theta psi ] (Body/ECEF)
+   ) const
 {
-   //--------------------------------------------------------------------------
-   // intermediate values
-   //--------------------------------------------------------------------------
-   const double Wx = av[0];
-   const double Wy = av[1];
-   const double Wz = av[2];
-   const double absAV2 = Wx*Wx + Wy*Wy + Wz*Wz;
-
-   if (absAV2 > 0.0) {
-      const double absAV1 = std::sqrt(absAV2);
-      const double absAV3 = absAV2 * absAV1;
-      const double absAV4 = absAV1 * absAV3;
-
-      const double cosWT = std::cos(absAV1 * dT);
-      const double sinWT = std::sin(absAV1 * dT);
-
-      //--------------------------------------------------------------------------
-      // Get Matrix Scaling Coefficients (k1, k2, k3)
-      //--------------------------------------------------------------------------
-      const double k1 = (0.5*absAV2*dT*dT - cosWT - absAV1*dT*sinWT + 1.0) / absAV4;
-      const double k2 = (cosWT + absAV1*dT*sinWT - 1.0) / absAV2;
-      const double k3 = (sinWT - absAV1*dT*cosWT) / absAV3;
-
-      //--------------------------------------------------------------------------
-      // Compute R2 Matrix
-      //--------------------------------------------------------------------------
-      static const base::Matrixd I3;
-      *pR2 = wwT*k1 + I3*k2 + omega*k3;
+   if (drEngine != nullptr) {
+      drEngine->compute(drSlot, dT, pNewP0, pNewRPY);
    }
    else {
-      pR2->identity();
+      DrEngine::deadReckon(drNum, drP0, drV0, drA0, drRPY0, drAV0, dT, pNewP0, pNewRPY);
    }
-
    return true;
 }
 
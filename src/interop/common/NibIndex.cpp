@@ -0,0 +1,149 @@
+
+#include "mixr/interop/common/NibIndex.hpp"
+
+#include "mixr/base/util/atomics.hpp"
+
+namespace mixr {
+namespace interop {
+
+NibIndex::~NibIndex()
+{
+   delete[] table;
+}
+
+//------------------------------------------------------------------------------
+// find() -- returns the NIB with 'key', or zero if not found
+//------------------------------------------------------------------------------
+Nib* NibIndex::find(const std::uint64_t key) const
+{
+   Nib* found = nullptr;
+   base::lock( semaphore );
+   if (numEntries > 0) {
+      const unsigned int mask = size - 1;
+      unsigned int h = hashKey(key) & mask;
+      while (table[h].nib != nullptr && found == nullptr) {
+         if (table[h].key == key) found = table[h].nib;
+         h = (h + 1) & mask;
+      }
+   }
+   base::unlock( semaphore );
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// insert() -- adds 'nib' to the index with 'key'
+//------------------------------------------------------------------------------
+void NibIndex::insert(const std::uint64_t key, Nib* const nib)
+{
+   if (nib == nullptr) return;
+
+   base::lock( semaphore );
+
+   // Keep the table at most half full
+   if ((numEntries + 1) * 2 > size) {
+      resize(size > 0 ? size * 2 : MIN_SIZE);
+   }
+
+   const unsigned int mask = size - 1;
+   unsigned int h = hashKey(key) & mask;
+   while (table[h].nib != nullptr) {
+      h = (h + 1) & mask;
+   }
+   table[h].key = key;
+   table[h].nib = nib;
+   numEntries++;
+
+   base::unlock( semaphore );
+}
+
+//------------------------------------------------------------------------------
+// remove() -- removes 'nib', which was added with 'key', from the index
+//------------------------------------------------------------------------------
+void NibIndex::remove(const std::uint64_t key, const Nib* const nib)
+{
+   if (nib == nullptr) return;
+
+   base::lock( semaphore );
+   if (numEntries > 0) {
+      const unsigned int mask = size - 1;
+      unsigned int i = hashKey(key) & mask;
+      while (table[i].nib != nullptr && table[i].nib != nib) {
+         i = (i + 1) & mask;
+      }
+
+      if (table[i].nib != nullptr) {
+         table[i].nib = nullptr;
+         numEntries--;
+
+         // Shift back the entries that follow, so there are no gaps
+         // between any entry and its home slot
+         unsigned int j = i;
+         for (;;) {
+            j = (j + 1) & mask;
+            if (table[j].nib == nullptr) break;
+            const unsigned int k = hashKey(table[j].key) & mask;
+            const bool move = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+            if (move) {
+               table[i] = table[j];
+               table[j].nib = nullptr;
+               i = j;
+            }
+         }
+      }
+   }
+   base::unlock( semaphore );
+}
+
+//------------------------------------------------------------------------------
+// clear() -- removes all entries
+//------------------------------------------------------------------------------
+void NibIndex::clear()
+{
+   base::lock( semaphore );
+   for (unsigned int i = 0; i < size; i++) {
+      table[i].nib = nullptr;
+   }
+   numEntries = 0;
+   base::unlock( semaphore );
+}
+
+// Resize the table to 'n' slots (power of two) and rehash the entries
+void NibIndex::resize(const unsigned int n)
+{
+   if (n <= size) return;
+
+   Entry* const old = table;
+   const unsigned int oldSize = size;
+
+   table = new Entry[n];
+   size = n;
+   for (unsigned int i = 0; i < size; i++) {
+      table[i].key = 0;
+      table[i].nib = nullptr;
+   }
+
+   const unsigned int mask = size - 1;
+   for (unsigned int i = 0; i < oldSize; i++) {
+      if (old[i].nib != nullptr) {
+         unsigned int h = hashKey(old[i].key) & mask;
+         while (table[h].nib != nullptr) h = (h + 1) & mask;
+         table[h] = old[i];
+      }
+   }
+
+   delete[] old;
+}
+
+unsigned int NibIndex::hashKey(const std::uint64_t key)
+{
+   std::uint64_t h = key;
+   h ^= (h >> 33);
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= (h >> 33);
+   h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= (h >> 33);
+   return static_cast<unsigned int>(h);
+}
+
+}
+}
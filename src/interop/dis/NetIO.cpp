@@ -208,6 +208,21 @@ bool NetIO::setVersion(const unsigned char v)
    return true;
 }
 
+//------------------------------------------------------------------------------
+// shutdownNotification() -- Shutdown the simulation
+//------------------------------------------------------------------------------
+bool NetIO::shutdownNotification()
+{
+    // Our network handlers aren't components, so pass on the shutdown event
+    // (stops their threads and sends any buffered packets)
+    base::NetHandler* const in = netInput;
+    base::NetHandler* const out = netOutput;
+    if (in != nullptr) in->event(SHUTDOWN_EVENT);
+    if (out != nullptr && out != in) out->event(SHUTDOWN_EVENT);
+
+    return BaseClass::shutdownNotification();
+}
+
 bool NetIO::initNetwork()
 {
     bool ok = true;
@@ -610,15 +625,38 @@ interop::Nib* NetIO::createNewOutputNib(models::Player* const player)
 Nib* NetIO::findDisNib(const unsigned short playerID, const unsigned short site, const unsigned short app, const IoType ioType)
 {
    Nib* nib = nullptr;
-   char cbuff[32];
-   bool ok = makeFederateName(cbuff, 32, site, app);
-   if (ok) {
-      base::String fname(cbuff);
-      nib = dynamic_cast<Nib*>( findNib(playerID, &fname, ioType) );
+   if (site > 0 && app > 0) {
+      nib = static_cast<Nib*>( findNibByKey(makeDisNibKey(playerID, site, app), ioType) );
    }
    return nib;
 }
 
+//------------------------------------------------------------------------------
+// NIB index keys -- made from the player, site and app IDs
+//------------------------------------------------------------------------------
+std::uint64_t NetIO::getNibKey(const interop::Nib* const nib) const
+{
+   // All of our NIBs are created by our nibFactory()
+   const auto disNib = static_cast<const Nib*>(nib);
+   return makeDisNibKey(disNib->getPlayerID(), disNib->getSiteID(), disNib->getApplicationID());
+}
+
+std::uint64_t NetIO::makeNibKey(const unsigned short playerID, const base::String* const federateName) const
+{
+   // Same site and app IDs as createNewOutputNib(): from the federate name, if
+   // it can be parsed, or our own IDs.
+   unsigned short site = getSiteID();
+   unsigned short app  = getApplicationID();
+   if (federateName != nullptr) {
+      unsigned short tSite = 0;
+      unsigned short tApp = 0;
+      if (parseFederateName(&tSite, &tApp, *federateName)) {
+         site = tSite;
+         app = tApp;
+      }
+   }
+   return makeDisNibKey(playerID, site, app);
+}
 
 //------------------------------------------------------------------------------
 // processElectromagneticEmissionPDU() callback --
@@ -673,6 +711,28 @@ bool NetIO::sendData(const char* const packet, const int size)
    return result;
 }
 
+//------------------------------------------------------------------------------
+// flushData() -- send any buffered packets
+//------------------------------------------------------------------------------
+bool NetIO::flushData()
+{
+   bool result = false;
+   if (netOutput != nullptr) {
+      result = netOutput->flushData();
+   }
+   return result;
+}
+
+//------------------------------------------------------------------------------
+// outputFrame() -- output side of the network; the buffered PDUs are sent
+// at the end of the frame
+//------------------------------------------------------------------------------
+void NetIO::outputFrame(const double dt)
+{
+   BaseClass::outputFrame(dt);
+   if (isNetworkInitialized()) flushData();
+}
+
 //------------------------------------------------------------------------------
 // makeTimeStamp() -- makes a DIS time stamp
 //------------------------------------------------------------------------------
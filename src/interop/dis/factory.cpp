@@ -1,6 +1,7 @@
 
 #include "mixr/interop/dis/factory.hpp"
 
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 
 #include "mixr/interop/dis/NetIO.hpp"
@@ -13,21 +14,21 @@ namespace mixr {
 
 namespace dis {
 
+namespace {
+
+const base::FactoryTable::Entry entries[] = {
+    FACTORY_ENTRY(NetIO),
+    FACTORY_ENTRY(Ntm),
+    FACTORY_ENTRY(EmissionPduHandler),
+};
+
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+
+}
+
 base::Object* factory(const std::string& name)
 {
-    base::Object* obj {};
-
-    if ( name == NetIO::getFactoryName() ) {
-        obj = new NetIO();
-    }
-    else if ( name == Ntm::getFactoryName() ) {
-        obj = new Ntm();
-    }
-    else if ( name == EmissionPduHandler::getFactoryName() ) {
-        obj = new EmissionPduHandler();
-    }
-
-    return obj;
+    return table.create(name);
 }
 
 }
@@ -1,5 +1,7 @@
 
 #include "mixr/interop/rprfom/factory.hpp"
+
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/interop/rprfom/NetIO.hpp"
 
 #include <string>
@@ -7,15 +9,19 @@
 namespace mixr {
 namespace rprfom {
 
-base::Object* formFunc(const std::string& name)
-{
-    base::Object* obj {};
+namespace {
+
+const base::FactoryTable::Entry entries[] = {
+    FACTORY_ENTRY(NetIO),
+};
 
-    if ( name == NetIO::getFactoryName() ) {
-        obj = new NetIO();
-    }
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
 
-    return obj;
+}
+
+base::Object* formFunc(const std::string& name)
+{
+    return table.create(name);
 }
 
 }
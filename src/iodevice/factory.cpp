@@ -1,6 +1,7 @@
 
 #include "mixr/iodevice/factory.hpp"
 
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 
 #include "mixr/iodevice/Ai2DiSwitch.hpp"
@@ -22,45 +23,35 @@
 namespace mixr {
 namespace iodevice {
 
-base::Object* factory(const std::string& name)
-{
-    base::Object* obj {};
+namespace {
 
+const base::FactoryTable::Entry entries[] = {
     // Data buffers
-    if ( name == IoData::getFactoryName() ) {
-        obj = new IoData();
-    }
+    FACTORY_ENTRY(IoData),
 
     // Data Handlers
-    else if ( name == DiscreteInput::getFactoryName() ) {
-        obj = new DiscreteInput();
-    }
-    else if ( name == DiscreteOutput::getFactoryName() ) {
-        obj = new DiscreteOutput();
-    }
-    else if ( name == AnalogInput::getFactoryName() ) {
-        obj = new AnalogInput();
-    }
-    else if ( name == AnalogOutput::getFactoryName() ) {
-        obj = new AnalogOutput();
-    }
+    FACTORY_ENTRY(DiscreteInput),
+    FACTORY_ENTRY(DiscreteOutput),
+    FACTORY_ENTRY(AnalogInput),
+    FACTORY_ENTRY(AnalogOutput),
 
     // Signal converters and generators
-    else if ( name == Ai2DiSwitch::getFactoryName() ) {
-        obj = new Ai2DiSwitch();
-    }
-    else if ( name == SignalGen::getFactoryName() ) {
-        obj = new SignalGen();
-    }
+    FACTORY_ENTRY(Ai2DiSwitch),
+    FACTORY_ENTRY(SignalGen),
 
     // ---
     // Device handler implementations (Linux and/or Windows)
     // ---
-    else if ( name == UsbJoystick::getFactoryName() ) {
-        obj = new UsbJoystick();
-    }
+    FACTORY_ENTRY(UsbJoystick),
+};
 
-    return obj;
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+
+}
+
+base::Object* factory(const std::string& name)
+{
+    return table.create(name);
 }
 
 }
@@ -1,4 +1,5 @@
 
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 
 #include "mixr/map/rpf/factory.hpp"
@@ -10,20 +11,22 @@
 namespace mixr {
 namespace rpf  {
 
-base::Object* factory(const std::string& name)
-{
-    base::Object* obj {};
+namespace {
 
+const base::FactoryTable::Entry entries[] = {
     // Map Drawer
-    if ( name == MapDrawer::getFactoryName() ) {
-        obj = new MapDrawer();
-    }
+    FACTORY_ENTRY(MapDrawer),
     // CadrgMap
-    else if ( name == CadrgMap::getFactoryName() ) {
-        obj = new CadrgMap();
-    }
+    FACTORY_ENTRY(CadrgMap),
+};
 
-    return obj;
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+
+}
+
+base::Object* factory(const std::string& name)
+{
+    return table.create(name);
 }
 
 }
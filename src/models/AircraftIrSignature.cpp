@@ -11,7 +11,11 @@
 #include "mixr/base/functors/Tables.hpp"
 #include "mixr/base/List.hpp"
 #include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/units/Angles.hpp"
 #include "mixr/base/units/Areas.hpp"
+#include "mixr/base/units/Distances.hpp"
+
+#include <cmath>
 
 namespace mixr {
 namespace models {
@@ -60,6 +64,12 @@ BEGIN_SLOTTABLE(AircraftIrSignature)
             // data - factor. We multiply the base plume signature by this
             // factor to get the plume energy in this particular waveband.
             // the different factors should all sum to 1.0  .
+   "signatureCache",          // Enable the signature cache (default: false)
+   "machTolerance",           // Signature cache bin size of the mach number (default: 0)
+   "altitudeTolerance",       // Signature cache bin size of the altitude (default: 0)
+   "azimuthTolerance",        // Signature cache bin size of the azimuth angle of incidence (default: 0)
+   "elevationTolerance",      // Signature cache bin size of the elevation angle of incidence (default: 0)
+   "plaTolerance",            // Signature cache bin size of the PLA (default: 0)
 
 END_SLOTTABLE(AircraftIrSignature)
 
@@ -70,6 +80,12 @@ BEGIN_SLOT_MAP(AircraftIrSignature)
    ON_SLOT(4,setSlotPlumeWavebandFactorTable,base::Table2)
    ON_SLOT(5,setSlotHotPartsSignatureTable,base::Table5)
    ON_SLOT(6,setSlotHotPartsWavebandFactorTable,base::Table2)
+   ON_SLOT(7,setSlotSignatureCache,base::Number)
+   ON_SLOT(8,setSlotMachTolerance,base::Number)
+   ON_SLOT(9,setSlotAltitudeTolerance,base::Distance)
+   ON_SLOT(10,setSlotAzimuthTolerance,base::Angle)
+   ON_SLOT(11,setSlotElevationTolerance,base::Angle)
+   ON_SLOT(12,setSlotPlaTolerance,base::Number)
 END_SLOT_MAP()
 
 AircraftIrSignature::AircraftIrSignature()
@@ -135,6 +151,11 @@ void AircraftIrSignature::copyData(const AircraftIrSignature& org, const bool)
         setSlotHotPartsWavebandFactorTable(nullptr);
     }
 
+    signatureCache = org.signatureCache;
+    for (unsigned int i = 0; i < NUM_INPUTS; i++) {
+        cache.setTolerance(i, org.cache.getTolerance(i));
+    }
+
     BaseClass::copyData(org);
 }
 
@@ -184,6 +205,8 @@ void AircraftIrSignature::deleteData()
         delete[] hotPartsSigs;
         hotPartsSigs = nullptr;
     }
+
+    cache.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -303,6 +326,73 @@ bool AircraftIrSignature::setSlotHotPartsWavebandFactorTable(const base::Table2*
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Signature cache slot functions
+//------------------------------------------------------------------------------
+bool AircraftIrSignature::setSlotSignatureCache(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setSignatureCacheEnabled(msg->getBoolean());
+   }
+   return ok;
+}
+
+bool AircraftIrSignature::setSlotMachTolerance(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = cache.setTolerance(IN_MACH, msg->getReal());
+   }
+   return ok;
+}
+
+bool AircraftIrSignature::setSlotAltitudeTolerance(const base::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = cache.setTolerance(IN_ALT, base::Meters::convertStatic(*msg));
+   }
+   return ok;
+}
+
+bool AircraftIrSignature::setSlotAzimuthTolerance(const base::Angle* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = cache.setTolerance(IN_AZ, base::Radians::convertStatic(*msg));
+   }
+   return ok;
+}
+
+bool AircraftIrSignature::setSlotElevationTolerance(const base::Angle* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = cache.setTolerance(IN_EL, base::Radians::convertStatic(*msg));
+   }
+   return ok;
+}
+
+bool AircraftIrSignature::setSlotPlaTolerance(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = cache.setTolerance(IN_PLA, msg->getReal());
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// setSignatureCacheEnabled() -- enables/disables the signature cache
+//------------------------------------------------------------------------------
+bool AircraftIrSignature::setSignatureCacheEnabled(const bool flg)
+{
+   signatureCache = flg;
+   cache.clear();
+   return true;
+}
+
 //------------------------------------------------------------------------------
 // getAirframeSignature()
 //------------------------------------------------------------------------------
@@ -384,6 +474,7 @@ void AircraftIrSignature::getAirframeSignatures(const IrQueryMsg* const msg, con
         const double* centerWavelengths = airframeWavebandFactorTable->getXData();
         const double* widths = airframeWavebandFactorTable->getYData();
         double irPower = getCalculatedAirframeHeatSignature(msg);
+        if (airframeSig == nullptr) airframeSig = new double [getNumWaveBands() * 3];
 
         for (unsigned int i = 0; i < static_cast<unsigned int>(airframeWavebandFactorTable->getNumXPoints()); i++) {
             const double centerWavelength = centerWavelengths[i];
@@ -439,6 +530,7 @@ void AircraftIrSignature::getPlumeSignatures(const IrQueryMsg* const msg, const
         const double* centerWavelengths = plumeWavebandFactorTable->getXData();
         const double* widths = plumeWavebandFactorTable->getYData();
         double irPower = getPlumeRadiation(msg);
+        if (plumeSigs == nullptr) plumeSigs = new double [getNumWaveBands() * 3];
         for (unsigned int i = 0; i < static_cast<unsigned int>(plumeWavebandFactorTable->getNumXPoints()); i++) {
             const double centerWavelength = centerWavelengths[i];
             const double lowerWavelength = centerWavelength - (widths[i] / 2.0f);
@@ -546,6 +638,7 @@ void AircraftIrSignature::getHotPartsSignatures(const IrQueryMsg* const msg, con
         const double* centerWavelengths = hotPartsWavebandFactorTable->getXData();
         const double* widths = hotPartsWavebandFactorTable->getYData();
         double irPower = getHotPartsRadiation(msg);
+        if (hotPartsSigs == nullptr) hotPartsSigs = new double [getNumWaveBands() * 3];
         for (unsigned int i = 0; i < static_cast<unsigned int>(hotPartsWavebandFactorTable->getNumXPoints()); i++) {
             double centerWavelength = centerWavelengths[i];
             double lowerWavelength = centerWavelength - (widths[i] / 2.0f);
@@ -565,81 +658,129 @@ void AircraftIrSignature::getHotPartsSignatures(const IrQueryMsg* const msg, con
 }
 
 //------------------------------------------------------------------------------
-// getHeatSignature() - Get the heat signature
+// getHeatSignature() - Get the heat signature: the signature of each waveband
+//    (watts/steradian) within the sensor's waveband, which is saved in the
+//    signature cache, if enabled, for the rest of the frame
 //------------------------------------------------------------------------------
 double* AircraftIrSignature::getHeatSignature(IrQueryMsg* msg)
 {
-    Player* target = msg->getTarget();
-    if (target != nullptr) {
-        IrAtmosphere* atmos = nullptr;
-        WorldModel* sim = target->getWorldModel();
-        if (sim != nullptr) {
-            atmos = dynamic_cast<IrAtmosphere*>( sim->getAtmosphere() );
+    const Player* target = msg->getTarget();
+    const unsigned int numBins = getNumWaveBands();
+    if (target != nullptr && numBins > 0) {
+        if (airframeSig == nullptr) airframeSig = new double [numBins * 3];
+
+        // Signature inputs
+        const auto airVehicle = dynamic_cast<const AirVehicle*>(target);
+        double inputs[NUM_INPUTS] {};
+        inputs[IN_MACH] = target->getMach();
+        inputs[IN_ALT] = static_cast<double>(target->getAltitudeM());
+        inputs[IN_AZ] = std::fabs(msg->getAzimuthAoi());
+        inputs[IN_EL] = msg->getElevationAoi();
+        inputs[IN_PLA] = (airVehicle != nullptr ? getPLA(airVehicle) : 1.0);
+        inputs[IN_LOWER] = msg->getLowerWavelength();
+        inputs[IN_UPPER] = msg->getUpperWavelength();
+
+        // (without a world model there's no frame to key the entries on)
+        const WorldModel* const wm = target->getWorldModel();
+        const bool useCache = (signatureCache && wm != nullptr);
+
+        bool cached = false;
+        unsigned int frame = 0;
+        if (useCache) {
+            if (cache.getNumValues() != numBins * 3) cache.setup(NUM_INPUTS, numBins * 3);
+            frame = IrCache::frameOf(wm);
+            cached = cache.find(frame, inputs, airframeSig);
         }
 
-        unsigned int numBins = getNumWaveBands();
-        if (airframeSig == nullptr)  airframeSig = new double [numBins * 3];
-        if (plumeSigs == nullptr)    plumeSigs = new double [numBins * 3];
-        if (hotPartsSigs == nullptr) hotPartsSigs = new double [numBins * 3];
+        if (!cached) {
+            computeHeatSignature(inputs, (airVehicle != nullptr), airframeSig);
+            if (useCache) cache.insert(frame, inputs, airframeSig);
+        }
+    }
+    return airframeSig;
+}
 
-        //double reflectivity = 1.0f - getEmissivity();
-        double lowerBound = msg->getLowerWavelength();
-        double upperBound = msg->getUpperWavelength();
+//------------------------------------------------------------------------------
+// computeHeatSignature() - Computes the signatures of all wavebands in one pass:
+//    the airframe, plume and hot parts signatures are looked up once, and
+//    they're distributed to the wavebands by their waveband factor tables.
+//    Assumes that the bins of the waveband factor tables are the same as
+//    our wavebands.
+//------------------------------------------------------------------------------
+void AircraftIrSignature::computeHeatSignature(const double* const inputs, const bool airVehicle, double* const sig)
+{
+    const double mach = inputs[IN_MACH];
+    const double alt = inputs[IN_ALT];
+    const double az = inputs[IN_AZ];
+    const double el = inputs[IN_EL];
+    const double pla = inputs[IN_PLA];
+    const double lowerBound = inputs[IN_LOWER];
+    const double upperBound = inputs[IN_UPPER];
+
+    // Total signatures (watts/steradian); apparently no emissivity factor in these
+    // signatures, and the airframe signature is only for air vehicles
+    double airframePower = 0.0;
+    if (airVehicle && airframeWavebandFactorTable != nullptr && airframeSignatureTable != nullptr) {
+        airframePower = getAirframeSignature(mach, alt, az, el);
+    }
+    double plumePower = 0.0;
+    if (plumeWavebandFactorTable != nullptr && plumeSignatureTable != nullptr) {
+        plumePower = getPlumeSignature(pla, mach, alt, az, el);
+    }
+    double hotPartsPower = 0.0;
+    if (hotPartsWavebandFactorTable != nullptr && hotPartsSignatureTable != nullptr) {
+        hotPartsPower = getHotPartsSignature(pla, (airVehicle ? mach : 0.0), (airVehicle ? alt : 0.0), az, el);
+    }
 
-        if (atmos != nullptr) {
-            if (atmos->getNumWaveBands() != getNumWaveBands()) {
-                // warning message
-            }
+    const double* centerWavelengths = getWaveBandCenters();
+    const double* widths = getWaveBandWidths();
+    const unsigned int numBins = getNumWaveBands();
+
+    for (unsigned int i = 0; i < numBins; i++) {
+        const double lowerBandBound = centerWavelengths[i] - (widths[i] / 2.0f);
+        const double upperBandBound = lowerBandBound + widths[i];
+        sig[i*3] = lowerBandBound;
+        sig[i*3 + 1] = upperBandBound;
+        sig[i*3 + 2] = 0.0;
+
+        // determine if our sensor band overlap this signature band
+        if (upperBound > lowerBandBound && lowerBound < upperBandBound) {
+
+            // calculate how much of this wave band overlaps the sensor limits
+            const double lowerOverlap = getLowerEndOfWavelengthOverlap(lowerBandBound, lowerBound);
+            double upperOverlap = getUpperEndOfWavelengthOverlap(upperBandBound, upperBound);
+            if (upperOverlap < lowerOverlap) upperOverlap = lowerOverlap;
+            const double overlapRatio = (upperOverlap - lowerOverlap) / (upperBandBound - lowerBandBound);
+
+            double heatSignatureInBand = airframePower * getBandFactor(airframeWavebandFactorTable, i, lowerBound, upperBound);
+            heatSignatureInBand += plumePower * getBandFactor(plumeWavebandFactorTable, i, lowerBound, upperBound);
+            heatSignatureInBand += hotPartsPower * getBandFactor(hotPartsWavebandFactorTable, i, lowerBound, upperBound);
+
+            // the reflected solar radiation is added by the atmosphere model,
+            // during query return processing
+            sig[i*3 + 2] = heatSignatureInBand * overlapRatio;
         }
+    }
+}
 
-        // apparently no emissivity factor in these airframe signatures
-        getAirframeSignatures(msg, lowerBound, upperBound);
-        getPlumeSignatures(msg, lowerBound, upperBound);
-        getHotPartsSignatures(msg, lowerBound, upperBound);
-
-        const double* centerWavelengths = getWaveBandCenters();
-        const double* widths = getWaveBandWidths();
-        //double totalWavelengthRange = ((centerWavelengths[getNumWaveBands() - 1] + (widths[getNumWaveBands() - 1] / 2.0f))-(centerWavelengths[0] - (widths[0] / 2.0f)));
-
-        for (unsigned int i=0; i<getNumWaveBands(); i++) {
-            // determine if our sensor band overlap this signature band
-            double lowerBandBound = centerWavelengths[i] - (widths[i] / 2.0f);
-            double upperBandBound = lowerBandBound + widths[i];
-            if (upperBound > lowerBandBound && lowerBound < upperBandBound) {
-
-                // calculate how much of this wave band overlaps the sensor limits
-                double lowerOverlap = getLowerEndOfWavelengthOverlap(lowerBandBound, lowerBound);
-                double upperOverlap = getUpperEndOfWavelengthOverlap(upperBandBound, upperBound);
-                if (upperOverlap < lowerOverlap) upperOverlap = lowerOverlap;
-                double overlapRatio = (upperOverlap - lowerOverlap) / (upperBandBound - lowerBandBound);
-
-                // get our main signature piece - airframe
-                double baseHeatSignatureInBand = airframeSig[i*3 + 2];
-
-                //if (isMessageEnabled(MSG_INFO)) {
-                //std::cout << "For wavelength " << currentWavelength << " Airframe Heat Signature: " << baseHeatSignatureInBand << std::endl;
-                //std::cout << "For wavelength " << currentWavelength << " Plume Signature: " << plumeSigs[i *3 +2] << std::endl;
-                //std::cout << "For wavelength " << currentWavelength << " Hot Parts: " << hotPartsSigs[i * 3 + 2] << std::endl;
-                //}
-
-                // assume plume bins & hot parts bins are same as airframe bins, so we
-                // can re-use the same overlap ratios and fractions. If not,
-                // they will have to be separately calculated.
-                baseHeatSignatureInBand += plumeSigs[i*3 + 2];
-                baseHeatSignatureInBand += hotPartsSigs[i*3 + 2];
-
-                // if we have an atmosphere model, get the reflected solar radiation contribution
-                // Solar signature is solar value * reflectivity i.e. (1 - emissivity)
-                // use of reflectivity here suggests that this is solar radiation reflected from the target
-                // this now done in the atmosphere model, during query return processing
-                //if (atmos != nullptr)
-                //   baseHeatSignatureInBand += (reflectivity * atmos->getSolarRadiation(centerWavelengths[i], (double) target->getAltitudeM()));
-
-                airframeSig[i*3 + 2] = baseHeatSignatureInBand * overlapRatio;
-            }
-        } // for loop over waveBand
-    } // if (target != nullptr)
-    return airframeSig;
+//------------------------------------------------------------------------------
+// getBandFactor() - Waveband factor of the table's bin 'i', if the bin overlaps
+//    the sensor's waveband, else zero
+//------------------------------------------------------------------------------
+double AircraftIrSignature::getBandFactor(const base::Table2* const tbl, const unsigned int i,
+                                          const double lowerBound, const double upperBound)
+{
+    double factor = 0.0;
+    if (tbl != nullptr && i < static_cast<unsigned int>(tbl->getNumXPoints())) {
+        const double centerWavelength = tbl->getXData()[i];
+        const double width = tbl->getYData()[i];
+        const double lowerWavelength = centerWavelength - (width / 2.0f);
+        const double upperWavelength = lowerWavelength + width;
+        if (upperBound >= lowerWavelength && lowerBound <= upperWavelength) {
+            factor = tbl->lfi(centerWavelength, width);
+        }
+    }
+    return factor;
 }
 
 
@@ -0,0 +1,469 @@
+
+#include "mixr/models/CommBus.hpp"
+
+#include "mixr/models/player/Player.hpp"
+#include "mixr/models/system/Datalink.hpp"
+#include "mixr/models/system/Radio.hpp"
+
+#include "mixr/terrain/Terrain.hpp"
+
+#include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace mixr {
+namespace models {
+
+//------------------------------------------------------------------------------
+// Class: CommBus::Table
+// Description: Subscriptions sorted by network and frequency (then in the
+//              order that they were subscribed); read-only once it's built.
+//              The table references the subscribers' datalinks and players,
+//              so they're not deleted while a publish() is using the table.
+//------------------------------------------------------------------------------
+class CommBus::Table : public base::Referenced
+{
+public:
+   Table(const Sub* const list, const unsigned int n);
+   Table(const Table&) = delete;
+   Table& operator=(const Table&) = delete;
+   ~Table();
+
+   // Finds the subscriptions of 'network' and 'freq'; returns the index of the
+   // first one, 'first', and the number of them
+   unsigned int find(const int network, const std::int64_t freq, unsigned int* const first) const;
+
+   Sub* subs {};
+   unsigned int numSubs {};
+};
+
+CommBus::Table::Table(const Sub* const list, const unsigned int n)
+{
+   if (list != nullptr && n > 0) {
+      subs = new Sub[n];
+      for (unsigned int i = 0; i < n; i++) {
+         subs[i] = list[i];
+         subs[i].dl->ref();
+         subs[i].own->ref();
+      }
+      numSubs = n;
+      std::stable_sort(subs, subs + numSubs);
+   }
+}
+
+CommBus::Table::~Table()
+{
+   for (unsigned int i = 0; i < numSubs; i++) {
+      subs[i].dl->unref();
+      subs[i].own->unref();
+   }
+   delete[] subs;
+}
+
+unsigned int CommBus::Table::find(const int network, const std::int64_t freq, unsigned int* const first) const
+{
+   Sub key {};
+   key.network = network;
+   key.freq = freq;
+   const Sub* const p = std::lower_bound(subs, subs + numSubs, key);
+   const Sub* q = p;
+   while (q < (subs + numSubs) && q->network == network && q->freq == freq) q++;
+   *first = static_cast<unsigned int>(p - subs);
+   return static_cast<unsigned int>(q - p);
+}
+
+//==============================================================================
+// Class: CommBus
+//==============================================================================
+IMPLEMENT_SUBCLASS(CommBus, "CommBus")
+
+BEGIN_SLOTTABLE(CommBus)
+   "rangeCulling",      // 1: Cull deliveries by the sender's max range
+   "losCulling",        // 2: Cull deliveries by terrain line-of-sight
+END_SLOTTABLE(CommBus)
+
+BEGIN_SLOT_MAP(CommBus)
+    ON_SLOT(1, setSlotRangeCulling, base::Number)
+    ON_SLOT(2, setSlotLosCulling,   base::Number)
+END_SLOT_MAP()
+
+CommBus::CommBus()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void CommBus::copyData(const CommBus& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   // The subscriptions and statistics are not copied
+   rangeCulling = org.rangeCulling;
+   losCulling = org.losCulling;
+}
+
+void CommBus::deleteData()
+{
+   unsubscribeAll();
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+
+bool CommBus::setRangeCullingEnabled(const bool flg)
+{
+   rangeCulling = flg;
+   return true;
+}
+
+bool CommBus::setLosCullingEnabled(const bool flg)
+{
+   losCulling = flg;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Subscriptions
+//------------------------------------------------------------------------------
+
+bool CommBus::subscribe(Datalink* const dl, Player* const own, const int network, const double freq)
+{
+   if (dl == nullptr || own == nullptr) return false;
+
+   // (registers the network's statistics)
+   getCounters(network);
+
+   dl->ref();
+   own->ref();
+
+   Sub old {};
+   base::lock(semaphore);
+   unsigned int idx {numSubs};
+   for (unsigned int i = 0; i < numSubs && idx == numSubs; i++) {
+      if (subs[i].dl == dl) idx = i;
+   }
+   if (idx < numSubs) {
+      // Replace the datalink's subscription
+      old = subs[idx];
+   }
+   else {
+      // New subscription
+      if (numSubs >= maxSubs) {
+         const unsigned int n {(maxSubs > 0) ? (maxSubs * 2) : 64};
+         const auto p = new Sub[n];
+         for (unsigned int i = 0; i < numSubs; i++) {
+            p[i] = subs[i];
+         }
+         delete[] subs;
+         subs = p;
+         maxSubs = n;
+      }
+      numSubs++;
+   }
+   subs[idx].dl = dl;
+   subs[idx].own = own;
+   subs[idx].network = network;
+   subs[idx].freq = freqKey(freq);
+   changed.store(true, std::memory_order_release);
+   base::unlock(semaphore);
+
+   // (unref()'d outside of the lock)
+   if (old.dl != nullptr) old.dl->unref();
+   if (old.own != nullptr) old.own->unref();
+   return true;
+}
+
+bool CommBus::unsubscribe(const Datalink* const dl)
+{
+   Sub old {};
+   base::lock(semaphore);
+   for (unsigned int i = 0; i < numSubs && old.dl == nullptr; i++) {
+      if (subs[i].dl == dl) {
+         old = subs[i];
+         // Keep the remaining subscriptions in order
+         for (unsigned int j = i + 1; j < numSubs; j++) {
+            subs[j - 1] = subs[j];
+         }
+         numSubs--;
+         changed.store(true, std::memory_order_release);
+      }
+   }
+   base::unlock(semaphore);
+
+   if (old.dl != nullptr) old.dl->unref();
+   if (old.own != nullptr) old.own->unref();
+   return (old.dl != nullptr);
+}
+
+//------------------------------------------------------------------------------
+// removeDeletedPlayers() -- removes the subscriptions of the players that have
+// been deleted (i.e., in DELETE_REQUEST mode); called once per update of the
+// world model's player list.
+//------------------------------------------------------------------------------
+void CommBus::removeDeletedPlayers()
+{
+   Sub* removed {};
+   unsigned int numRemoved {};
+
+   base::lock(semaphore);
+   for (unsigned int i = 0; i < numSubs && removed == nullptr; i++) {
+      if (subs[i].own->isMode(Player::DELETE_REQUEST)) removed = new Sub[numSubs];
+   }
+   if (removed != nullptr) {
+      unsigned int n {};
+      for (unsigned int i = 0; i < numSubs; i++) {
+         if (subs[i].own->isMode(Player::DELETE_REQUEST)) removed[numRemoved++] = subs[i];
+         else subs[n++] = subs[i];
+      }
+      numSubs = n;
+      changed.store(true, std::memory_order_release);
+   }
+   base::unlock(semaphore);
+
+   for (unsigned int i = 0; i < numRemoved; i++) {
+      removed[i].dl->unref();
+      removed[i].own->unref();
+   }
+   delete[] removed;
+}
+
+void CommBus::unsubscribeAll()
+{
+   base::lock(semaphore);
+   Sub* const list {subs};
+   const unsigned int n {numSubs};
+   subs = nullptr;
+   numSubs = 0;
+   maxSubs = 0;
+   changed.store(false, std::memory_order_release);
+   base::unlock(semaphore);
+
+   table = nullptr;
+   for (unsigned int i = 0; i < n; i++) {
+      list[i].dl->unref();
+      list[i].own->unref();
+   }
+   delete[] list;
+}
+
+unsigned int CommBus::getNumSubscribers() const
+{
+   base::lock(semaphore);
+   const unsigned int n {numSubs};
+   base::unlock(semaphore);
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// getTable() -- returns the sorted table of the subscriptions (pre-ref()'d),
+// which is rebuilt if the subscriptions have changed.
+//------------------------------------------------------------------------------
+CommBus::Table* CommBus::getTable()
+{
+   if (changed.load(std::memory_order_acquire)) {
+      Table* old {};
+      base::lock(semaphore);
+      if (changed.load(std::memory_order_relaxed)) {
+         const auto t = new Table(subs, numSubs);
+         old = table.getRefPtr();
+         table = t;
+         t->unref();
+         changed.store(false, std::memory_order_release);
+      }
+      base::unlock(semaphore);
+
+      // (the old table, and any players that it was the last to reference,
+      // are deleted outside of the lock)
+      if (old != nullptr) old->unref();
+   }
+   return table.getRefPtr();
+}
+
+//------------------------------------------------------------------------------
+// publish() -- delivers a message to the other subscribers of its network
+// and frequency; same receivers as the datalink's broadcast to the players
+// (i.e., active, local players other than the sender), but limited to the
+// subscribers and culled by range (always, for a sender with a radio, which
+// would be limited to its radio's range without the bus) and, optionally,
+// by line-of-sight.
+//------------------------------------------------------------------------------
+unsigned int CommBus::publish(
+      const Datalink* const sender,
+      const Player* const own,
+      base::Object* const msg,
+      const int network,
+      const double freq,
+      const double maxRange,
+      const terrain::Terrain* const terrain
+   )
+{
+   if (msg == nullptr || own == nullptr) return 0;
+
+   unsigned long numDelivered {};
+   unsigned long numRangeCulled {};
+   unsigned long numLosCulled {};
+   unsigned long numDropped {};
+
+   Table* const t {getTable()};
+   if (t != nullptr) {
+      unsigned int first {};
+      const unsigned int n {t->find(network, freqKey(freq), &first)};
+      if (n > 0) {
+         const base::Vec3d pos0 {own->getGeocPosition()};
+         const bool radioLink {sender != nullptr && sender->getRadio() != nullptr};
+         const bool cullRange {(radioLink || rangeCulling) && maxRange > 0};
+         const double maxRange2 {maxRange * maxRange};
+         const bool cullLos {losCulling && terrain != nullptr};
+
+         for (unsigned int i = first; i < (first + n); i++) {
+            const Sub& s {t->subs[i]};
+            Player* const p {s.own};
+
+            // Active, local players only (and not to ourself)
+            if (s.dl == sender || p == own || !p->isLocalPlayer()) continue;
+            if (!p->isActive() && !p->isMode(Player::PRE_RELEASE)) continue;
+
+            // The subscriber's radio must be receiving
+            const CommRadio* const radio {s.dl->getRadio()};
+            if (radio != nullptr && !radio->isReceiverEnabled()) continue;
+
+            if (cullRange && (p->getGeocPosition() - pos0).length2() > maxRange2) {
+               numRangeCulled++;
+               continue;
+            }
+
+            if ( cullLos && terrain->targetOcculting(own->getLatitude(), own->getLongitude(), own->getAltitude(),
+                                                     p->getLatitude(), p->getLongitude(), p->getAltitude()) ) {
+               numLosCulled++;
+               continue;
+            }
+
+            if (s.dl->postMessage(msg)) numDelivered++;
+            else numDropped++;
+         }
+      }
+      t->unref();
+   }
+
+   Counters* const c {getCounters(network)};
+   if (c != nullptr) {
+      c->messages.fetch_add(1, std::memory_order_relaxed);
+      if (numDelivered > 0) c->deliveries.fetch_add(numDelivered, std::memory_order_relaxed);
+      if (numRangeCulled > 0) c->rangeCulled.fetch_add(numRangeCulled, std::memory_order_relaxed);
+      if (numLosCulled > 0) c->losCulled.fetch_add(numLosCulled, std::memory_order_relaxed);
+      if (numDropped > 0) c->dropped.fetch_add(numDropped, std::memory_order_relaxed);
+   }
+
+   return static_cast<unsigned int>(numDelivered);
+}
+
+//------------------------------------------------------------------------------
+// Network statistics
+//------------------------------------------------------------------------------
+
+// Returns the network's counters, which are added the first time that the
+// network is used, or zero if there are already MAX_NETWORKS networks.
+CommBus::Counters* CommBus::getCounters(const int network)
+{
+   unsigned int n {numNets.load(std::memory_order_acquire)};
+   for (unsigned int i = 0; i < n; i++) {
+      if (nets[i].network.load(std::memory_order_relaxed) == network) return &nets[i];
+   }
+
+   Counters* c {};
+   base::lock(semaphore);
+   n = numNets.load(std::memory_order_relaxed);
+   for (unsigned int i = 0; i < n && c == nullptr; i++) {
+      if (nets[i].network.load(std::memory_order_relaxed) == network) c = &nets[i];
+   }
+   if (c == nullptr && n < MAX_NETWORKS) {
+      c = &nets[n];
+      c->network.store(network, std::memory_order_relaxed);
+      numNets.store(n + 1, std::memory_order_release);
+   }
+   base::unlock(semaphore);
+   return c;
+}
+
+unsigned int CommBus::getNumNetworks() const
+{
+   return numNets.load(std::memory_order_acquire);
+}
+
+bool CommBus::getNetworkStats(const unsigned int idx, NetworkStats* const stats) const
+{
+   bool ok {};
+   if (stats != nullptr && idx < getNumNetworks()) {
+      const Counters& c {nets[idx]};
+      stats->network = c.network.load(std::memory_order_relaxed);
+      stats->messages = c.messages.load(std::memory_order_relaxed);
+      stats->deliveries = c.deliveries.load(std::memory_order_relaxed);
+      stats->rangeCulled = c.rangeCulled.load(std::memory_order_relaxed);
+      stats->losCulled = c.losCulled.load(std::memory_order_relaxed);
+      stats->dropped = c.dropped.load(std::memory_order_relaxed);
+      ok = true;
+   }
+   return ok;
+}
+
+void CommBus::clearStats()
+{
+   const unsigned int n {getNumNetworks()};
+   for (unsigned int i = 0; i < n; i++) {
+      nets[i].messages.store(0, std::memory_order_relaxed);
+      nets[i].deliveries.store(0, std::memory_order_relaxed);
+      nets[i].rangeCulled.store(0, std::memory_order_relaxed);
+      nets[i].losCulled.store(0, std::memory_order_relaxed);
+      nets[i].dropped.store(0, std::memory_order_relaxed);
+   }
+}
+
+void CommBus::printStats(std::ostream& sout) const
+{
+   const unsigned int n {getNumNetworks()};
+   for (unsigned int i = 0; i < n; i++) {
+      NetworkStats s {};
+      getNetworkStats(i, &s);
+      sout << "CommBus network " << s.network;
+      sout << ": messages = " << s.messages;
+      sout << ", deliveries = " << s.deliveries;
+      sout << ", rangeCulled = " << s.rangeCulled;
+      sout << ", losCulled = " << s.losCulled;
+      sout << ", dropped = " << s.dropped;
+      sout << std::endl;
+   }
+}
+
+// Frequency key: frequency rounded to the nearest hertz
+std::int64_t CommBus::freqKey(const double freq)
+{
+   return static_cast<std::int64_t>(std::llround(freq));
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool CommBus::setSlotRangeCulling(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setRangeCullingEnabled(msg->getBoolean());
+   }
+   return ok;
+}
+
+bool CommBus::setSlotLosCulling(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setLosCullingEnabled(msg->getBoolean());
+   }
+   return ok;
+}
+
+}
+}
@@ -0,0 +1,262 @@
+
+#include "mixr/models/IrCache.hpp"
+
+#include "mixr/models/WorldModel.hpp"
+
+#include "mixr/base/util/atomics.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace mixr {
+namespace models {
+
+IrCache::~IrCache()
+{
+   deleteTable();
+}
+
+//------------------------------------------------------------------------------
+// setup() -- sets the number of inputs and values of each entry
+//------------------------------------------------------------------------------
+bool IrCache::setup(const unsigned int ni, const unsigned int nv)
+{
+   if (ni == 0 || ni > MAX_INPUTS || nv == 0) return false;
+
+   base::lock(semaphore);
+   if (ni != numInputs || nv != numValues) {
+      deleteTable();
+      numInputs = ni;
+      numValues = nv;
+   }
+   base::unlock(semaphore);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Input tolerances (bin sizes)
+//------------------------------------------------------------------------------
+double IrCache::getTolerance(const unsigned int idx) const
+{
+   return (idx < MAX_INPUTS ? tolerances[idx] : 0.0);
+}
+
+bool IrCache::setTolerance(const unsigned int idx, const double tol)
+{
+   if (idx >= MAX_INPUTS || tol < 0.0) return false;
+
+   base::lock(semaphore);
+   tolerances[idx] = tol;
+   haveFrame = false;         // (discard the entries binned by the old tolerance)
+   base::unlock(semaphore);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// find() -- finds the values of 'inputs' inserted this frame
+//------------------------------------------------------------------------------
+bool IrCache::find(const unsigned int f, const double* const inputs, double* const vals)
+{
+   if (numInputs == 0) return false;
+
+   std::int64_t key[MAX_INPUTS] {};
+   quantize(inputs, key);
+
+   bool found = false;
+   base::lock(semaphore);
+   setFrame(f);
+   if (numEntries > 0) {
+      const unsigned int mask = size - 1;
+      unsigned int h = hashKey(key) & mask;
+      while (epochs[h] == epoch) {
+         if (sameKey(h, key)) {
+            std::memcpy(vals, &values[h * numValues], numValues * sizeof(double));
+            found = true;
+            break;
+         }
+         h = (h + 1) & mask;
+      }
+   }
+   base::unlock(semaphore);
+
+   if (found) hits.fetch_add(1, std::memory_order_relaxed);
+   else misses.fetch_add(1, std::memory_order_relaxed);
+   return found;
+}
+
+//------------------------------------------------------------------------------
+// insert() -- saves the values computed for 'inputs'
+//------------------------------------------------------------------------------
+void IrCache::insert(const unsigned int f, const double* const inputs, const double* const vals)
+{
+   if (numInputs == 0) return;
+
+   std::int64_t key[MAX_INPUTS] {};
+   quantize(inputs, key);
+
+   base::lock(semaphore);
+   setFrame(f);
+
+   // Keep the table at most half full
+   bool ok = true;
+   if ((numEntries + 1) * 2 > size) {
+      if (numEntries >= MAX_ENTRIES) ok = false;
+      else resize(size > 0 ? size * 2 : MIN_SIZE);
+   }
+
+   if (ok) {
+      const unsigned int mask = size - 1;
+      unsigned int h = hashKey(key) & mask;
+      while (epochs[h] == epoch && !sameKey(h, key)) {
+         h = (h + 1) & mask;
+      }
+      if (epochs[h] != epoch) {
+         epochs[h] = epoch;
+         numEntries++;
+      }
+      std::memcpy(&keys[h * numInputs], key, numInputs * sizeof(std::int64_t));
+      std::memcpy(&values[h * numValues], vals, numValues * sizeof(double));
+   }
+   base::unlock(semaphore);
+}
+
+//------------------------------------------------------------------------------
+// clear() -- discards all entries
+//------------------------------------------------------------------------------
+void IrCache::clear()
+{
+   base::lock(semaphore);
+   haveFrame = false;
+   setFrame(0);
+   base::unlock(semaphore);
+}
+
+//------------------------------------------------------------------------------
+// Statistics
+//------------------------------------------------------------------------------
+double IrCache::getHitRate() const
+{
+   const unsigned long h = getHits();
+   const unsigned long n = h + getMisses();
+   return (n > 0 ? static_cast<double>(h) / static_cast<double>(n) : 0.0);
+}
+
+void IrCache::clearStats()
+{
+   hits.store(0, std::memory_order_relaxed);
+   misses.store(0, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// frameOf() -- frame number of the world model: 16 frames per cycle
+//------------------------------------------------------------------------------
+unsigned int IrCache::frameOf(const WorldModel* const wm)
+{
+   unsigned int f = 0;
+   if (wm != nullptr) f = wm->cycle() * 16 + wm->frame();
+   return f;
+}
+
+//------------------------------------------------------------------------------
+// Private functions (the table is locked)
+//------------------------------------------------------------------------------
+
+// Quantizes the inputs to their bins; exact inputs (and the ones that
+// can't be binned) use their bit patterns
+void IrCache::quantize(const double* const inputs, std::int64_t* const key) const
+{
+   for (unsigned int i = 0; i < numInputs; i++) {
+      const double x = inputs[i];
+      const double tol = tolerances[i];
+      const double bin = (tol > 0.0 ? std::floor(x / tol + 0.5) : 0.0);
+      if (tol > 0.0 && std::fabs(bin) < 4.0e18) {
+         key[i] = static_cast<std::int64_t>(bin);
+      }
+      else {
+         const double y = (x == 0.0 ? 0.0 : x);    // (-0 and +0 are the same input)
+         std::memcpy(&key[i], &y, sizeof(std::int64_t));
+      }
+   }
+}
+
+unsigned int IrCache::hashKey(const std::int64_t* const key) const
+{
+   std::uint64_t h = 0x9e3779b97f4a7c15ULL;
+   for (unsigned int i = 0; i < numInputs; i++) {
+      h ^= static_cast<std::uint64_t>(key[i]);
+      h ^= (h >> 33);
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= (h >> 33);
+   }
+   return static_cast<unsigned int>(h);
+}
+
+bool IrCache::sameKey(const unsigned int slot, const std::int64_t* const key) const
+{
+   return (std::memcmp(&keys[slot * numInputs], key, numInputs * sizeof(std::int64_t)) == 0);
+}
+
+// Starts a new epoch, which discards all entries, if the frame has changed
+void IrCache::setFrame(const unsigned int f)
+{
+   if (!haveFrame || f != frame) {
+      frame = f;
+      haveFrame = true;
+      numEntries = 0;
+      epoch++;
+      if (epoch == 0) {
+         // wrapped: reset the slots' epochs
+         for (unsigned int i = 0; i < size; i++) epochs[i] = 0;
+         epoch = 1;
+      }
+   }
+}
+
+// Resize the table to 'n' slots (power of two) and rehash this epoch's entries
+void IrCache::resize(const unsigned int n)
+{
+   if (n <= size) return;
+
+   std::int64_t* const oldKeys = keys;
+   double* const oldValues = values;
+   unsigned int* const oldEpochs = epochs;
+   const unsigned int oldSize = size;
+
+   keys = new std::int64_t[n * numInputs];
+   values = new double[n * numValues];
+   epochs = new unsigned int[n];
+   size = n;
+   for (unsigned int i = 0; i < size; i++) {
+      epochs[i] = 0;
+   }
+
+   const unsigned int mask = size - 1;
+   for (unsigned int i = 0; i < oldSize; i++) {
+      if (oldEpochs[i] == epoch) {
+         unsigned int h = hashKey(&oldKeys[i * numInputs]) & mask;
+         while (epochs[h] == epoch) h = (h + 1) & mask;
+         epochs[h] = epoch;
+         std::memcpy(&keys[h * numInputs], &oldKeys[i * numInputs], numInputs * sizeof(std::int64_t));
+         std::memcpy(&values[h * numValues], &oldValues[i * numValues], numValues * sizeof(double));
+      }
+   }
+
+   delete[] oldKeys;
+   delete[] oldValues;
+   delete[] oldEpochs;
+}
+
+void IrCache::deleteTable()
+{
+   delete[] keys;
+   delete[] values;
+   delete[] epochs;
+   keys = nullptr;
+   values = nullptr;
+   epochs = nullptr;
+   size = 0;
+   numEntries = 0;
+}
+
+}
+}
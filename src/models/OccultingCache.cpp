@@ -0,0 +1,131 @@
+
+#include "mixr/models/OccultingCache.hpp"
+
+namespace mixr {
+namespace models {
+
+OccultingCache::~OccultingCache()
+{
+   delete[] table;
+}
+
+//------------------------------------------------------------------------------
+// setObserver() -- sets the observer's position and the movement tolerance
+//------------------------------------------------------------------------------
+void OccultingCache::setObserver(const terrain::Terrain* const t, const base::Vec3d& pos, const double tol)
+{
+   tol2 = (tol > 0.0 ? tol * tol : 0.0);
+
+   if ( !haveObserver || t != terrain || (pos - observer).length2() > tol2 ) {
+      clear();
+      terrain = t;
+      observer = pos;
+      haveObserver = true;
+   }
+}
+
+//------------------------------------------------------------------------------
+// find() -- finds the result for target 'key'
+//------------------------------------------------------------------------------
+bool OccultingCache::find(const std::uint64_t key, const base::Vec3d& pos, const bool space, bool* const occulted) const
+{
+   if (key == 0 || numEntries == 0) return false;
+
+   const unsigned int mask = size - 1;
+   unsigned int h = hashKey(key) & mask;
+   while (table[h].key != 0) {
+      if (table[h].key == key) {
+         const Entry& e = table[h];
+         if (e.space == space && (pos - e.pos).length2() <= tol2) {
+            *occulted = e.occulted;
+            return true;
+         }
+         return false;
+      }
+      h = (h + 1) & mask;
+   }
+   return false;
+}
+
+//------------------------------------------------------------------------------
+// insert() -- saves the result for target 'key'
+//------------------------------------------------------------------------------
+void OccultingCache::insert(const std::uint64_t key, const base::Vec3d& pos, const bool space, const bool occulted)
+{
+   if (key == 0) return;
+
+   // Keep the table at most half full; targets that have been deleted
+   // stay in the table, so start over if it gets too big
+   if ((numEntries + 1) * 2 > size) {
+      if (numEntries >= MAX_ENTRIES) clearEntries();
+      else resize(size > 0 ? size * 2 : MIN_SIZE);
+   }
+
+   const unsigned int mask = size - 1;
+   unsigned int h = hashKey(key) & mask;
+   while (table[h].key != 0 && table[h].key != key) {
+      h = (h + 1) & mask;
+   }
+   if (table[h].key == 0) numEntries++;
+
+   table[h].key = key;
+   table[h].pos = pos;
+   table[h].space = space;
+   table[h].occulted = occulted;
+}
+
+//------------------------------------------------------------------------------
+// clear() -- discards all results
+//------------------------------------------------------------------------------
+void OccultingCache::clear()
+{
+   clearEntries();
+   haveObserver = false;
+   terrain = nullptr;
+}
+
+void OccultingCache::clearEntries()
+{
+   for (unsigned int i = 0; i < size; i++) {
+      table[i].key = 0;
+   }
+   numEntries = 0;
+}
+
+// Resize the table to 'n' slots (power of two) and rehash the entries
+void OccultingCache::resize(const unsigned int n)
+{
+   if (n <= size) return;
+
+   Entry* const old = table;
+   const unsigned int oldSize = size;
+
+   table = new Entry[n];
+   size = n;
+   for (unsigned int i = 0; i < size; i++) {
+      table[i].key = 0;
+   }
+
+   const unsigned int mask = size - 1;
+   for (unsigned int i = 0; i < oldSize; i++) {
+      if (old[i].key != 0) {
+         unsigned int h = hashKey(old[i].key) & mask;
+         while (table[h].key != 0) h = (h + 1) & mask;
+         table[h] = old[i];
+      }
+   }
+
+   delete[] old;
+}
+
+unsigned int OccultingCache::hashKey(const std::uint64_t key)
+{
+   std::uint64_t h = key;
+   h ^= (h >> 33);
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= (h >> 33);
+   return static_cast<unsigned int>(h);
+}
+
+}
+}
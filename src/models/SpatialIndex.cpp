@@ -0,0 +1,280 @@
+
+#include "mixr/models/SpatialIndex.hpp"
+
+#include "mixr/models/player/Player.hpp"
+
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mixr {
+namespace models {
+
+IMPLEMENT_PARTIAL_SUBCLASS(SpatialIndex, "SpatialIndex")
+EMPTY_SLOTTABLE(SpatialIndex)
+
+SpatialIndex::SpatialIndex(base::PairStream* const pl, const double cs, const double time)
+{
+   STANDARD_CONSTRUCTOR()
+
+   cellSize = (cs > 1.0 ? cs : 1.0);
+   driftTime = time;
+
+   if (pl != nullptr) {
+      pl->ref();
+      playerList = pl;
+
+      const unsigned int n = pl->entries();
+      if (n > 0) {
+         entries = new Entry[n];
+         players = new Player*[n];
+         positions = new base::Vec3d[n];
+         types = new unsigned int[n];
+         strays = new unsigned int[n];
+         newStrays = new unsigned int[n];
+      }
+
+      // Collect the player positions in player list order
+      const base::List::Item* item = pl->getFirstItem();
+      while (item != nullptr && numPlayers < n) {
+         const auto pair = static_cast<const base::Pair*>(item->getValue());
+         const auto p = const_cast<Player*>(static_cast<const Player*>(pair->object()));
+
+         const base::Vec3d& pos = p->getGeocPosition();
+         players[numPlayers] = p;
+         positions[numPlayers] = pos;
+         types[numPlayers] = p->getMajorType();
+         entries[numPlayers].key = cellKey( cellIndex(pos.x()), cellIndex(pos.y()), cellIndex(pos.z()) );
+         entries[numPlayers].idx = numPlayers;
+
+         const double spd = p->getGeocVelocity().length();
+         if (spd > driftSpeed) driftSpeed = spd;
+
+         numPlayers++;
+         item = item->getNext();
+      }
+
+      // Sort by cell; players in the same cell stay together
+      std::sort(entries, entries + numPlayers);
+   }
+}
+
+SpatialIndex::SpatialIndex(const SpatialIndex& org)
+{
+   STANDARD_CONSTRUCTOR()
+   copyData(org, true);
+}
+
+SpatialIndex::~SpatialIndex()
+{
+   STANDARD_DESTRUCTOR()
+}
+
+SpatialIndex& SpatialIndex::operator=(const SpatialIndex& org)
+{
+   if (this != &org) copyData(org, false);
+   return *this;
+}
+
+SpatialIndex* SpatialIndex::clone() const
+{
+   return new SpatialIndex(*this);
+}
+
+void SpatialIndex::copyData(const SpatialIndex& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   clear();
+
+   cellSize = org.cellSize;
+
+   if (org.playerList != nullptr) {
+      org.playerList->ref();
+      playerList = org.playerList;
+   }
+
+   if (org.numPlayers > 0) {
+      numPlayers = org.numPlayers;
+      entries = new Entry[numPlayers];
+      players = new Player*[numPlayers];
+      positions = new base::Vec3d[numPlayers];
+      types = new unsigned int[numPlayers];
+      strays = new unsigned int[numPlayers];
+      newStrays = new unsigned int[numPlayers];
+      for (unsigned int i = 0; i < numPlayers; i++) {
+         entries[i] = org.entries[i];
+         players[i] = org.players[i];
+         positions[i] = org.positions[i];
+         types[i] = org.types[i];
+      }
+   }
+
+   base::lock(org.semaphore);
+   drift = org.drift;
+   driftSpeed = org.driftSpeed;
+   driftTime = org.driftTime;
+   numStrays = org.numStrays;
+   for (unsigned int i = 0; i < numStrays; i++) {
+      strays[i] = org.strays[i];
+   }
+   base::unlock(org.semaphore);
+}
+
+void SpatialIndex::deleteData()
+{
+   clear();
+}
+
+void SpatialIndex::clear()
+{
+   if (entries != nullptr)   { delete[] entries;   entries = nullptr; }
+   if (players != nullptr)   { delete[] players;   players = nullptr; }
+   if (positions != nullptr) { delete[] positions; positions = nullptr; }
+   if (types != nullptr)     { delete[] types;     types = nullptr; }
+   if (strays != nullptr)    { delete[] strays;    strays = nullptr; }
+   if (newStrays != nullptr) { delete[] newStrays; newStrays = nullptr; }
+   numPlayers = 0;
+   numStrays = 0;
+
+   if (playerList != nullptr) { playerList->unref(); playerList = nullptr; }
+}
+
+//------------------------------------------------------------------------------
+// Query the players of type 'mask' that may be within 'radius' of 'center'
+//------------------------------------------------------------------------------
+unsigned int SpatialIndex::query(
+      const base::Vec3d& center,
+      const double radius,
+      const double time,
+      const unsigned int mask,
+      unsigned int* const idx,
+      const unsigned int max
+   ) const
+{
+   if (idx == nullptr || max == 0 || numPlayers == 0) return 0;
+
+   // Start with the strays (they're checked by the caller), and enlarge
+   // the radius by the other players' drift, and by the distance that they
+   // may have moved since it was measured (doubled to allow for
+   // acceleration), plus a meter for round off
+   unsigned int n = 0;
+   bool scanAll = false;
+   base::lock(semaphore);
+   const double d = drift;
+   const double spd = driftSpeed;
+   double dt = time - driftTime;
+   if (numStrays <= max) {
+      for (unsigned int i = 0; i < numStrays; i++) {
+         if ((types[strays[i]] & mask) != 0) idx[n++] = strays[i];
+      }
+   }
+   else scanAll = true;
+   base::unlock(semaphore);
+   if (dt < 0) dt = 0;
+   const double r = radius + d + 2.0 * spd * dt + 1.0;
+   const double r2 = r * r;
+
+   // Cell range of the search cube
+   const int ix0 = cellIndex(center.x() - r);
+   const int ix1 = cellIndex(center.x() + r);
+   const int iy0 = cellIndex(center.y() - r);
+   const int iy1 = cellIndex(center.y() + r);
+   const int iz0 = cellIndex(center.z() - r);
+   const int iz1 = cellIndex(center.z() + r);
+
+   if (static_cast<double>(ix1 - ix0 + 1) * static_cast<double>(iy1 - iy0 + 1) >= numPlayers) scanAll = true;
+
+   if (!scanAll) {
+      // Cells with the same 'x' and 'y' indices are contiguous in the sorted
+      // entries, so there's one search for each column of the search cube
+      for (int ix = ix0; ix <= ix1 && !scanAll; ix++) {
+         for (int iy = iy0; iy <= iy1 && !scanAll; iy++) {
+            Entry lo;
+            lo.key = cellKey(ix, iy, iz0);
+            lo.idx = 0;
+            const std::uint64_t hi = cellKey(ix, iy, iz1);
+            const Entry* e = std::lower_bound(entries, entries + numPlayers, lo);
+            while (e != (entries + numPlayers) && e->key <= hi && !scanAll) {
+               const unsigned int i = e->idx;
+               if ((types[i] & mask) != 0 && (positions[i] - center).length2() <= r2) {
+                  if (n < max) idx[n++] = i;
+                  else scanAll = true;
+               }
+               e++;
+            }
+         }
+      }
+
+      // Back to player list order, without the strays that were also found
+      // in the grid
+      if (!scanAll) {
+         std::sort(idx, idx + n);
+         n = static_cast<unsigned int>(std::unique(idx, idx + n) - idx);
+      }
+   }
+
+   if (scanAll) {
+      // The search covers more grid columns than we have players (or there
+      // are more than 'max' players); the full player list
+      n = 0;
+      for (unsigned int i = 0; i < numPlayers && n < max; i++) {
+         if ((types[i] & mask) != 0) idx[n++] = i;
+      }
+   }
+
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// Measure the players' drift from their indexed positions
+//------------------------------------------------------------------------------
+void SpatialIndex::measureDrift(const double time)
+{
+   const double strayDist2 = (cellSize * cellSize) / 16.0;   // (quarter of a cell)
+
+   double d2 = 0;
+   double spd2 = 0;
+   unsigned int ns = 0;
+   for (unsigned int i = 0; i < numPlayers; i++) {
+      const double x = (players[i]->getGeocPosition() - positions[i]).length2();
+      if (x > strayDist2) newStrays[ns++] = i;
+      else if (x > d2) d2 = x;
+      const double v = players[i]->getGeocVelocity().length2();
+      if (v > spd2) spd2 = v;
+   }
+
+   base::lock(semaphore);
+   drift = std::sqrt(d2);
+   driftSpeed = std::sqrt(spd2);
+   driftTime = time;
+   unsigned int* const tmp = strays;
+   strays = newStrays;
+   newStrays = tmp;
+   numStrays = ns;
+   base::unlock(semaphore);
+}
+
+//------------------------------------------------------------------------------
+// Cell index and key functions
+//------------------------------------------------------------------------------
+int SpatialIndex::cellIndex(const double v) const
+{
+   const double c = std::floor(v / cellSize) + KEY_BIAS;
+   if (c < 0) return 0;
+   if (c > KEY_MAX) return KEY_MAX;
+   return static_cast<int>(c);
+}
+
+std::uint64_t SpatialIndex::cellKey(const int ix, const int iy, const int iz)
+{
+   return (static_cast<std::uint64_t>(ix) << (2 * KEY_BITS)) |
+          (static_cast<std::uint64_t>(iy) << KEY_BITS) |
+           static_cast<std::uint64_t>(iz);
+}
+
+}
+}
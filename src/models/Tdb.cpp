@@ -4,6 +4,8 @@
 #include "mixr/models/player/Player.hpp"
 #include "mixr/models/system/Gimbal.hpp"
 #include "mixr/models/WorldModel.hpp"
+#include "mixr/models/SpatialIndex.hpp"
+#include "mixr/models/OccultingCache.hpp"
 
 #include "mixr/terrain/Terrain.hpp"
 
@@ -15,10 +17,22 @@
 #include "mixr/base/util/osg_utils.hpp"
 
 #include <cmath>
+#include <cstdint>
 
 namespace mixr {
 namespace models {
 
+namespace {
+
+// Terrain occulting cache key of a target: its player and network IDs
+std::uint64_t occultingKey(const Player* const p)
+{
+   return (static_cast<std::uint64_t>(static_cast<unsigned int>(p->getNetworkID())) << 32) |
+          (static_cast<std::uint64_t>(p->getID()) << 1) | 1;
+}
+
+}
+
 IMPLEMENT_PARTIAL_SUBCLASS(Tdb, "Gimbal_Tdb")
 EMPTY_SLOTTABLE(Tdb)
 
@@ -76,12 +90,19 @@ void Tdb::copyData(const Tdb& org, const bool)
    }
    numTgts = org.numTgts;
    usingEcefFlg = org.usingEcefFlg;
+   occultingCache = org.occultingCache;
 }
 
 void Tdb::deleteData()
 {
    resizeArrays(0);
    setGimbal(nullptr);
+
+   if (candidates != nullptr) { delete[] candidates; candidates = nullptr; }
+   maxCandidates = 0;
+
+   resizeOccultingArrays(0);
+   occultingCache = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -168,6 +189,38 @@ bool Tdb::resizeArrays(const unsigned int newSize)
 }
 
 
+//------------------------------------------------------------------------------
+// Resize the terrain occulting arrays (grow only, or zero to free them)
+//------------------------------------------------------------------------------
+void Tdb::resizeOccultingArrays(const unsigned int newSize)
+{
+   if (newSize > 0 && newSize <= maxOcculting) return;
+
+   // Free up the old memory
+   if (pending    != nullptr) { delete[] pending;    pending    = nullptr; }
+   if (pendingTan != nullptr) { delete[] pendingTan; pendingTan = nullptr; }
+   if (occulted   != nullptr) { delete[] occulted;   occulted   = nullptr; }
+   if (bIdx       != nullptr) { delete[] bIdx;       bIdx       = nullptr; }
+   if (bLat       != nullptr) { delete[] bLat;       bLat       = nullptr; }
+   if (bLon       != nullptr) { delete[] bLon;       bLon       = nullptr; }
+   if (bAlt       != nullptr) { delete[] bAlt;       bAlt       = nullptr; }
+   if (bOcculted  != nullptr) { delete[] bOcculted;  bOcculted  = nullptr; }
+   maxOcculting = 0;
+
+   // Allocate new memory
+   if (newSize > 0) {
+      pending    = new Player*[newSize];
+      pendingTan = new double[newSize];
+      occulted   = new bool[newSize];
+      bIdx       = new unsigned int[newSize];
+      bLat       = new double[newSize];
+      bLon       = new double[newSize];
+      bAlt       = new double[newSize];
+      bOcculted  = new bool[newSize];
+      maxOcculting = newSize;
+   }
+}
+
 //------------------------------------------------------------------------------
 // Process players-of-interest ---  Scan the provided player list and generates
 // a sublist of target players that were filtered by player type, max range,
@@ -244,8 +297,6 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
    }
 
    // Geodetic position of our ownship
-   const double osLat = ownship->getLatitude();
-   const double osLon = ownship->getLongitude();
    const double osAlt = ownship->getAltitudeM();
 
    // If we're using ECEF coordinates then we compute the distance
@@ -277,14 +328,57 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
    const bool osSpaceVehicle = ownship->isMajorType(Player::SPACE_VEHICLE);
 
    // ---
-   // 1) Scan the player list ---
+   // Candidate players from the world model's spatial index, if we're using ECEF
+   // coordinates with a max range and the index was built from this player list;
+   // the candidates are in player list order, and are checked the same as a scan.
+   // ---
+   const SpatialIndex* index = nullptr;
+   unsigned int numCandidates = 0;
+   if (usingEcefFlg && maxRange > 0) {
+      const WorldModel* const sim = ownship->getWorldModel();
+      index = (sim != nullptr ? sim->getSpatialIndex() : nullptr);
+      if (index != nullptr && (!index->isIndexOf(players) || index->getNumPlayers() == 0)) {
+         index->unref();
+         index = nullptr;
+      }
+      if (index != nullptr) {
+         // Grow the query buffer as needed
+         const unsigned int n = index->getNumPlayers();
+         if (n > maxCandidates) {
+            if (candidates != nullptr) delete[] candidates;
+            candidates = new unsigned int[n];
+            maxCandidates = n;
+         }
+         numCandidates = index->query(p0, maxRange, sim->getExecTimeSec(), mask, candidates, n);
+      }
+   }
+
+   // ---
+   // Targets that are waiting for their terrain occulting check, which are
+   // checked in batches (see occultTargets()) in player list order
+   // ---
+   const bool occultCheck = (terrain != nullptr && !osSpaceVehicle);
+   unsigned int numPending = 0;
+   if (occultCheck) resizeOccultingArrays(maxTargets);
+
+   // ---
+   // 1) Scan the player list (or the candidates) ---
    // ---
    bool finished = false;
-   for (base::List::Item* item = players->getFirstItem(); item != nullptr && numTgts < maxTargets && !finished; item = item->getNext()) {
+   base::List::Item* item = (index == nullptr ? players->getFirstItem() : nullptr);
+   unsigned int icand = 0;
+   while ( (index != nullptr ? icand < numCandidates : item != nullptr) && (numTgts + numPending) < maxTargets && !finished ) {
 
       // Get the pointer to the target player
-      base::Pair* pair = static_cast<base::Pair*>(item->getValue());
-      Player* target = static_cast<Player*>(pair->object());
+      Player* target = nullptr;
+      if (index != nullptr) {
+         target = index->getPlayer(candidates[icand++]);
+      }
+      else {
+         base::Pair* pair = static_cast<base::Pair*>(item->getValue());
+         target = static_cast<Player*>(pair->object());
+         item = item->getNext();
+      }
 
       // Did we complete the local only players?
       finished = localOnly && target->isNetworkedPlayer();
@@ -351,33 +445,16 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
                if (inFov) {
 
                   // Terrain occulting if we have terrain data and we're not a space vehicle
-                  bool occulted = false;
-                  if (terrain != nullptr && !osSpaceVehicle) {
-
-                     const double tgtLat = target->getLatitude();
-                     const double tgtLon = target->getLongitude();
-                     const double tgtAlt = target->getAltitudeM();
-
-                     // Is the target a space vehicle?
-                     if ( target->isMajorType(Player::SPACE_VEHICLE) ) {
-                        // Get the true, great-circle bearing to the target
-                        double tbrg(0), distNM(0);
-                        base::nav::vll2bd(osLat, osLon, tgtLat, tgtLon, &tbrg, &distNM);
-
-                        // Set the distance to check to 60 nm
-                        double dist = 60.0 * base::distance::NM2M;
-
-                        // Terrain occulting check toward the space vehicle
-                        occulted = terrain->targetOcculting2(osLat, osLon, osAlt, tbrg, dist, -tanTgtAng);
-                     }
-                     else {
-                        // Occulting check between two standard player
-                        occulted = terrain->targetOcculting(osLat, osLon, static_cast<double>(osAlt),
-                                                            tgtLat, tgtLon, static_cast<double>(tgtAlt));
+                  if (occultCheck) {
+                     pending[numPending] = target;
+                     pendingTan[numPending] = tanTgtAng;
+                     numPending++;
+                     if ((numTgts + numPending) >= maxTargets) {
+                        occultTargets(terrain, pending, pendingTan, numPending);
+                        numPending = 0;
                      }
                   }
-
-                  if (!occulted) {
+                  else {
                      // !!! All is well with this target !!!
 
                      // Ref() and save the target pointer
@@ -390,9 +467,99 @@ unsigned int Tdb::processPlayers(base::PairStream* const players)
       }
    }
 
+   // Check the remaining targets
+   if (numPending > 0) {
+      occultTargets(terrain, pending, pendingTan, numPending);
+   }
+
+   if (index != nullptr) index->unref();
+
    return numTgts;
 }
 
+//------------------------------------------------------------------------------
+// occultTargets() -- terrain occulting checks of the 'n' targets in 'tgts',
+// which are in player list order, and saves the targets that aren't occulted.
+//
+// The results are reused from our gimbal's occulting cache when neither our
+// ownship nor the target has moved more than the gimbal's tolerance, and the
+// remaining standard (non-space vehicle) targets are checked as a batch.
+//------------------------------------------------------------------------------
+void Tdb::occultTargets(
+      const terrain::Terrain* const terrain, // Terrain database
+      Player** const tgts,                   // Targets
+      const double* const tanTgtAngs,        // Tangents of the angles from local level to the targets (positive down)
+      const unsigned int n                   // Number of targets
+   )
+{
+   // Geodetic position of our ownship
+   const double osLat = ownship->getLatitude();
+   const double osLon = ownship->getLongitude();
+   const double osAlt = ownship->getAltitudeM();
+
+   OccultingCache* const cache = occultingCache;
+   if (cache != nullptr) {
+      cache->setObserver(terrain, ownship->getGeocPosition(), gimbal->getTerrainOccultingTolerance());
+   }
+
+   // Batch of standard targets (the arrays already fit the targets
+   // that are pending in processPlayers())
+   resizeOccultingArrays(n);
+   unsigned int nb = 0;
+
+   for (unsigned int i = 0; i < n; i++) {
+      Player* const target = tgts[i];
+      const bool space = target->isMajorType(Player::SPACE_VEHICLE);
+
+      occulted[i] = false;
+      if (cache != nullptr && cache->find(occultingKey(target), target->getGeocPosition(), space, &occulted[i])) continue;
+
+      const double tgtLat = target->getLatitude();
+      const double tgtLon = target->getLongitude();
+
+      // Is the target a space vehicle?
+      if (space) {
+         // Get the true, great-circle bearing to the target
+         double tbrg(0), distNM(0);
+         base::nav::vll2bd(osLat, osLon, tgtLat, tgtLon, &tbrg, &distNM);
+
+         // Set the distance to check to 60 nm
+         double dist = 60.0 * base::distance::NM2M;
+
+         // Terrain occulting check toward the space vehicle
+         occulted[i] = terrain->targetOcculting2(osLat, osLon, osAlt, tbrg, dist, -tanTgtAngs[i]);
+         if (cache != nullptr) cache->insert(occultingKey(target), target->getGeocPosition(), space, occulted[i]);
+      }
+      else {
+         // Occulting check between two standard players (below)
+         bIdx[nb] = i;
+         bLat[nb] = tgtLat;
+         bLon[nb] = tgtLon;
+         bAlt[nb] = target->getAltitudeM();
+         nb++;
+      }
+   }
+
+   if (nb > 0) {
+      terrain->targetsOcculting(bOcculted, nb, osLat, osLon, osAlt, bLat, bLon, bAlt);
+      for (unsigned int k = 0; k < nb; k++) {
+         const unsigned int i = bIdx[k];
+         occulted[i] = bOcculted[k];
+         if (cache != nullptr) cache->insert(occultingKey(tgts[i]), tgts[i]->getGeocPosition(), false, occulted[i]);
+      }
+   }
+
+   for (unsigned int i = 0; i < n && numTgts < maxTargets; i++) {
+      if (!occulted[i]) {
+         // !!! All is well with this target !!!
+
+         // Ref() and save the target pointer
+         tgts[i]->ref();
+         targets[numTgts++] = tgts[i];
+      }
+   }
+}
+
 
 //------------------------------------------------------------------------------
 // Compute Boresight Data --- Scan the target list, which as been pre-processed by
@@ -0,0 +1,475 @@
+
+#include "mixr/models/TrackAssociator.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+namespace mixr {
+namespace models {
+
+namespace {
+
+// Replaces array 'p' with a new array of 'n' items (contents not kept)
+template <class T> void newArray(T*& p, const unsigned int n)
+{
+   delete[] p;
+   p = new T[n];
+}
+
+// Grows array 'p', of 'n' items, to 'm' items (contents kept)
+template <class T> void growArray(T*& p, const unsigned int n, const unsigned int m)
+{
+   T* const q = new T[m];
+   for (unsigned int i = 0; i < n; i++) { q[i] = p[i]; }
+   delete[] p;
+   p = q;
+}
+
+unsigned int hashKey(const std::uint64_t key)
+{
+   std::uint64_t h = key * 0x9E3779B97F4A7C15ull;
+   return static_cast<unsigned int>(h >> 32);
+}
+
+}
+
+TrackAssociator::~TrackAssociator()
+{
+   delete[] trkKey;
+   delete[] trkPos;
+   delete[] trkNumMatches;
+   delete[] trkNext;
+
+   delete[] rptKey;
+   delete[] rptPos;
+   delete[] rptNumMatches;
+   delete[] candFirst;
+
+   delete[] candTrk;
+   delete[] candCost;
+
+   delete[] rowFirst;
+   delete[] rowCol;
+   delete[] rowQueue;
+   delete[] colOwner;
+   delete[] colPrice;
+   delete[] edgeCol;
+   delete[] edgeCost;
+   delete[] matchRpt;
+   delete[] matchTrk;
+
+   delete[] cells;
+}
+
+//------------------------------------------------------------------------------
+// begin() -- starts a new association of 'nt' tracks and 'nr' reports
+//------------------------------------------------------------------------------
+void TrackAssociator::begin(const unsigned int nt, const unsigned int nr)
+{
+   if (nt > maxTracks) {
+      unsigned int n = (maxTracks > 0 ? maxTracks : 64);
+      while (n < nt) n *= 2;
+      newArray(trkKey, n);
+      newArray(trkPos, n);
+      newArray(trkNumMatches, n);
+      newArray(trkNext, n);
+      maxTracks = n;
+   }
+
+   if (nr > maxReports) {
+      unsigned int n = (maxReports > 0 ? maxReports : 64);
+      while (n < nr) n *= 2;
+      newArray(rptKey, n);
+      newArray(rptPos, n);
+      newArray(rptNumMatches, n);
+      newArray(candFirst, n + 1);
+      maxReports = n;
+   }
+
+   numTracks = nt;
+   numReports = nr;
+   numCand = 0;
+   numMatches = 0;
+
+   for (unsigned int it = 0; it < numTracks; it++) {
+      trkKey[it] = nullptr;
+      trkNumMatches[it] = 0;
+   }
+   for (unsigned int ir = 0; ir < numReports; ir++) {
+      rptKey[ir] = nullptr;
+      rptNumMatches[ir] = 0;
+   }
+}
+
+void TrackAssociator::setTrack(const unsigned int it, const void* const key, const base::Vec3d& pos)
+{
+   if (it < numTracks) {
+      trkKey[it] = key;
+      trkPos[it] = pos;
+   }
+}
+
+void TrackAssociator::setReport(const unsigned int ir, const void* const key, const base::Vec3d& pos)
+{
+   if (ir < numReports) {
+      rptKey[ir] = key;
+      rptPos[ir] = pos;
+   }
+}
+
+//------------------------------------------------------------------------------
+// associate() -- associates the reports with the tracks; returns the number
+// of matches
+//------------------------------------------------------------------------------
+unsigned int TrackAssociator::associate(const Method method, const double gate)
+{
+   numMatches = 0;
+   if (numTracks == 0 || numReports == 0) return 0;
+
+   if (method == TARGET) {
+      associateTargets();
+   }
+   else if (gate > 0.0) {
+      buildGrid(gate);
+      findCandidates(gate * gate);
+      if (method == GLOBAL_NEAREST_NEIGHBOR) associateGlobal(gate * gate);
+      else associateNearest();
+   }
+
+   return numMatches;
+}
+
+//------------------------------------------------------------------------------
+// associateTargets() -- matches each report with the tracks of its target
+//------------------------------------------------------------------------------
+void TrackAssociator::associateTargets()
+{
+   // Hash table of the track keys; each slot is the first track of a chain
+   unsigned int size = 16;
+   while (size < numTracks * 2) size *= 2;
+   if (size > cellsSize) {
+      newArray(cells, size);
+      cellsSize = size;
+   }
+   for (unsigned int i = 0; i < cellsSize; i++) {
+      cells[i].first = NONE;
+   }
+
+   // (in reverse, so each chain is in track order)
+   const unsigned int mask = cellsSize - 1;
+   for (unsigned int it = numTracks; it > 0; it--) {
+      const std::uint64_t key = reinterpret_cast<std::uintptr_t>(trkKey[it-1]);
+      unsigned int h = hashKey(key) & mask;
+      while (cells[h].first != NONE && cells[h].key != key) {
+         h = (h + 1) & mask;
+      }
+      trkNext[it-1] = (cells[h].first != NONE ? cells[h].first : NONE);
+      cells[h].key = key;
+      cells[h].first = it - 1;
+   }
+
+   for (unsigned int ir = 0; ir < numReports; ir++) {
+      const std::uint64_t key = reinterpret_cast<std::uintptr_t>(rptKey[ir]);
+      unsigned int h = hashKey(key) & mask;
+      while (cells[h].first != NONE && cells[h].key != key) {
+         h = (h + 1) & mask;
+      }
+      for (unsigned int it = cells[h].first; it != NONE; it = trkNext[it]) {
+         addMatch(ir, it);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// associateNearest() -- in report order, each report takes the nearest
+// unmatched track within the gate
+//------------------------------------------------------------------------------
+void TrackAssociator::associateNearest()
+{
+   for (unsigned int ir = 0; ir < numReports; ir++) {
+      unsigned int best = NONE;
+      double bestCost = 0.0;
+      for (unsigned int k = candFirst[ir]; k < candFirst[ir+1]; k++) {
+         const unsigned int it = candTrk[k];
+         if (trkNumMatches[it] == 0 && (best == NONE || candCost[k] < bestCost)) {
+            best = it;
+            bestCost = candCost[k];
+         }
+      }
+      if (best != NONE) addMatch(ir, best);
+   }
+}
+
+//------------------------------------------------------------------------------
+// associateGlobal() -- global nearest neighbor assignment
+//
+//    Auction algorithm (Bertsekas) with epsilon scaling.  So that the prices
+//    can be kept from one epsilon to the next, the problem is made symmetric
+//    by adding an "unmatched" dummy for each report and for each track: the
+//    rows are the reports and the track dummies, and the columns are the
+//    tracks and the report dummies, with the edges:
+//
+//       report ir   --> its candidate tracks (distance squared), and
+//                       report ir's dummy (gate squared)
+//       track it's  --> track it (zero), and the dummies of the reports
+//       dummy           with track it as a candidate (zero)
+//
+//    Unassigned rows bid for their best column, given the column prices; the
+//    column's price is raised by the bid increment plus epsilon, which takes
+//    the column from its previous owner.  Epsilon is scaled down from gate^2/4
+//    until the assignment is within (numRows * epsilon) of the optimal.  A row
+//    with a single edge (a report without candidates or a track that's not a
+//    candidate) owns its column, so it's not in the auction.
+//------------------------------------------------------------------------------
+void TrackAssociator::associateGlobal(const double gate2)
+{
+   const unsigned int numRows = numReports + numTracks;
+   const unsigned int numEdges = 2 * numCand + numRows;
+   if (numRows > maxRows) {
+      unsigned int n = (maxRows > 0 ? maxRows : 256);
+      while (n < numRows) n *= 2;
+      newArray(rowFirst, n + 1);
+      newArray(rowCol, n);
+      newArray(rowQueue, n);
+      newArray(colOwner, n);
+      newArray(colPrice, n);
+      maxRows = n;
+   }
+   if (numEdges > maxEdges) {
+      unsigned int n = (maxEdges > 0 ? maxEdges : 512);
+      while (n < numEdges) n *= 2;
+      newArray(edgeCol, n);
+      newArray(edgeCost, n);
+      maxEdges = n;
+   }
+
+   // Report rows
+   unsigned int ne = 0;
+   for (unsigned int ir = 0; ir < numReports; ir++) {
+      rowFirst[ir] = ne;
+      for (unsigned int k = candFirst[ir]; k < candFirst[ir+1]; k++) {
+         edgeCol[ne] = candTrk[k];
+         edgeCost[ne] = candCost[k];
+         ne++;
+      }
+      edgeCol[ne] = numTracks + ir;
+      edgeCost[ne] = gate2;
+      ne++;
+   }
+
+   // Track dummy rows (rowCol[] is the next edge to fill)
+   for (unsigned int it = 0; it < numTracks; it++) {
+      rowCol[numReports + it] = 1;
+   }
+   for (unsigned int k = 0; k < numCand; k++) {
+      rowCol[numReports + candTrk[k]]++;
+   }
+   for (unsigned int it = 0; it < numTracks; it++) {
+      const unsigned int r = numReports + it;
+      const unsigned int n = rowCol[r];
+      rowFirst[r] = ne;
+      edgeCol[ne] = it;
+      edgeCost[ne] = 0.0;
+      rowCol[r] = ne + 1;
+      ne += n;
+   }
+   rowFirst[numRows] = ne;
+   for (unsigned int ir = 0; ir < numReports; ir++) {
+      for (unsigned int k = candFirst[ir]; k < candFirst[ir+1]; k++) {
+         const unsigned int e = rowCol[numReports + candTrk[k]]++;
+         edgeCol[e] = numTracks + ir;
+         edgeCost[e] = 0.0;
+      }
+   }
+
+   for (unsigned int c = 0; c < numRows; c++) {
+      colPrice[c] = 0.0;
+   }
+
+   const double epsMin = gate2 * 1.0e-6 / (numRows + 1);
+   double eps = gate2 * 0.25;
+   bool done = false;
+   while (!done) {
+      // Clear the assignments (keep the prices)
+      for (unsigned int c = 0; c < numRows; c++) {
+         colOwner[c] = NONE;
+      }
+      unsigned int qn = 0;
+      for (unsigned int r = 0; r < numRows; r++) {
+         if (rowFirst[r+1] - rowFirst[r] == 1) {
+            rowCol[r] = edgeCol[rowFirst[r]];
+            colOwner[rowCol[r]] = r;
+         }
+         else {
+            rowCol[r] = NONE;
+            rowQueue[qn++] = r;
+         }
+      }
+
+      // Bid until all rows are assigned (circular queue)
+      unsigned int qhead = 0;
+      while (qn > 0) {
+         const unsigned int r = rowQueue[qhead];
+         qhead = (qhead + 1) % numRows;
+         qn--;
+
+         // Best and second best values (two or more edges)
+         unsigned int best = NONE;
+         double v1 = -HUGE_VAL;
+         double v2 = -HUGE_VAL;
+         for (unsigned int e = rowFirst[r]; e < rowFirst[r+1]; e++) {
+            const double v = -edgeCost[e] - colPrice[edgeCol[e]];
+            if (v > v1) {
+               v2 = v1;
+               v1 = v;
+               best = edgeCol[e];
+            }
+            else if (v > v2) {
+               v2 = v;
+            }
+         }
+
+         // Bid for the column, and take it from its owner
+         colPrice[best] += (v1 - v2) + eps;
+         const unsigned int prev = colOwner[best];
+         if (prev != NONE) {
+            rowCol[prev] = NONE;
+            rowQueue[(qhead + qn) % numRows] = prev;
+            qn++;
+         }
+         colOwner[best] = r;
+         rowCol[r] = best;
+      }
+
+      if (eps <= epsMin) done = true;
+      else {
+         eps *= 0.1;
+         if (eps < epsMin) eps = epsMin;
+      }
+   }
+
+   for (unsigned int ir = 0; ir < numReports; ir++) {
+      if (rowCol[ir] < numTracks) addMatch(ir, rowCol[ir]);
+   }
+}
+
+//------------------------------------------------------------------------------
+// buildGrid() -- builds the grid of the track positions
+//------------------------------------------------------------------------------
+void TrackAssociator::buildGrid(const double gate)
+{
+   cellSize = gate;
+
+   unsigned int size = 16;
+   while (size < numTracks * 2) size *= 2;
+   if (size > cellsSize) {
+      newArray(cells, size);
+      cellsSize = size;
+   }
+   for (unsigned int i = 0; i < cellsSize; i++) {
+      cells[i].first = NONE;
+   }
+
+   // (in reverse, so each cell's list is in track order)
+   const unsigned int mask = cellsSize - 1;
+   for (unsigned int it = numTracks; it > 0; it--) {
+      const base::Vec3d& p = trkPos[it-1];
+      const std::uint64_t key = cellKey(cellIndex(p.x()), cellIndex(p.y()), cellIndex(p.z()));
+      unsigned int h = hashKey(key) & mask;
+      while (cells[h].first != NONE && cells[h].key != key) {
+         h = (h + 1) & mask;
+      }
+      trkNext[it-1] = (cells[h].first != NONE ? cells[h].first : NONE);
+      cells[h].key = key;
+      cells[h].first = it - 1;
+   }
+}
+
+//------------------------------------------------------------------------------
+// findCandidates() -- finds the tracks within the gate of each report, using
+// the report's cell and its neighbors
+//------------------------------------------------------------------------------
+void TrackAssociator::findCandidates(const double gate2)
+{
+   numCand = 0;
+   for (unsigned int ir = 0; ir < numReports; ir++) {
+      candFirst[ir] = numCand;
+
+      const base::Vec3d& p = rptPos[ir];
+      const int ix = cellIndex(p.x());
+      const int iy = cellIndex(p.y());
+      const int iz = cellIndex(p.z());
+      for (int dx = -1; dx <= 1; dx++) {
+         for (int dy = -1; dy <= 1; dy++) {
+            for (int dz = -1; dz <= 1; dz++) {
+               const unsigned int c = findCell( cellKey(ix + dx, iy + dy, iz + dz) );
+               if (c == NONE) continue;
+               for (unsigned int it = cells[c].first; it != NONE; it = trkNext[it]) {
+                  const double d2 = (trkPos[it] - p).length2();
+                  if (d2 <= gate2) {
+                     if (numCand >= maxCand) {
+                        const unsigned int n = (maxCand > 0 ? maxCand * 2 : 256);
+                        growArray(candTrk, numCand, n);
+                        growArray(candCost, numCand, n);
+                        maxCand = n;
+                     }
+                     candTrk[numCand] = it;
+                     candCost[numCand] = d2;
+                     numCand++;
+                  }
+               }
+            }
+         }
+      }
+   }
+   candFirst[numReports] = numCand;
+}
+
+// Slot of the cell with key 'key', or NONE
+unsigned int TrackAssociator::findCell(const std::uint64_t key) const
+{
+   const unsigned int mask = cellsSize - 1;
+   unsigned int h = hashKey(key) & mask;
+   while (cells[h].first != NONE) {
+      if (cells[h].key == key) return h;
+      h = (h + 1) & mask;
+   }
+   return NONE;
+}
+
+// Biased cell index of coordinate 'v'
+int TrackAssociator::cellIndex(const double v) const
+{
+   const double c = std::floor(v / cellSize) + KEY_BIAS;
+   if (!(c >= 1.0)) return 1;      // (and NaN)
+   if (c > (KEY_MAX - 1)) return (KEY_MAX - 1);
+   return static_cast<int>(c);
+}
+
+std::uint64_t TrackAssociator::cellKey(const int ix, const int iy, const int iz)
+{
+   return (static_cast<std::uint64_t>(ix) << (2 * KEY_BITS)) |
+          (static_cast<std::uint64_t>(iy) << KEY_BITS) |
+          static_cast<std::uint64_t>(iz);
+}
+
+//------------------------------------------------------------------------------
+// addMatch() -- adds a report/track match
+//------------------------------------------------------------------------------
+void TrackAssociator::addMatch(const unsigned int ir, const unsigned int it)
+{
+   if (numMatches >= maxMatches) {
+      const unsigned int n = (maxMatches > 0 ? maxMatches * 2 : 256);
+      growArray(matchRpt, numMatches, n);
+      growArray(matchTrk, numMatches, n);
+      maxMatches = n;
+   }
+   matchRpt[numMatches] = ir;
+   matchTrk[numMatches] = it;
+   numMatches++;
+   rptNumMatches[ir]++;
+   trkNumMatches[it]++;
+}
+
+}
+}
@@ -9,6 +9,9 @@
 
 #include "mixr/base/util/nav_utils.hpp"
 
+#include "mixr/models/CommBus.hpp"
+#include "mixr/models/SpatialIndex.hpp"
+
 // environment models
 #include "mixr/models/environment/AbstractAtmosphere.hpp"
 #include "mixr/terrain/Terrain.hpp"
@@ -36,6 +39,8 @@ BEGIN_SLOTTABLE(WorldModel)
 
    "terrain",                 //  6) Terrain elevation database
    "atmosphere",              //  7) Atmospheric model
+   "spatialIndexCellSize",    //  8) Players-of-interest spatial index cell size, or zero for no index
+   "commBus",                 //  9) Datalink communications bus
 END_SLOTTABLE(WorldModel)
 
 BEGIN_SLOT_MAP(WorldModel)
@@ -54,6 +59,8 @@ BEGIN_SLOT_MAP(WorldModel)
 
     ON_SLOT( 6, setSlotTerrain,      terrain::Terrain)
     ON_SLOT( 7, setSlotAtmosphere,   AbstractAtmosphere)
+    ON_SLOT( 8, setSlotSpatialIndexCellSize, base::Distance)
+    ON_SLOT( 9, setSlotCommBus,      CommBus)
 END_SLOT_MAP()
 
 WorldModel::WorldModel()
@@ -83,6 +90,9 @@ void WorldModel::copyData(const WorldModel& org, const bool cc)
    gaUseEmFlg = org.gaUseEmFlg;
    wm = org.wm;
 
+   indexCellSize = org.indexCellSize;
+   spatialIndex = nullptr;
+
 
    if (org.terrain != nullptr) {
       terrain::Terrain* copy = org.terrain->clone();
@@ -101,12 +111,23 @@ void WorldModel::copyData(const WorldModel& org, const bool cc)
    else {
       setSlotAtmosphere(nullptr);
    }
+
+   if (org.commBus != nullptr) {
+      CommBus* copy = org.commBus->clone();
+      setSlotCommBus( copy );
+      copy->unref();
+   }
+   else {
+      setSlotCommBus(nullptr);
+   }
 }
 
 void WorldModel::deleteData()
 {
    setSlotAtmosphere( nullptr );
    setSlotTerrain( nullptr );
+   setSlotCommBus( nullptr );
+   spatialIndex = nullptr;
 }
 
 void WorldModel::reset()
@@ -126,6 +147,58 @@ void WorldModel::reset()
    // Reset atmospheric model
    // ---
    if (atmosphere != nullptr) atmosphere->reset();
+
+   // ---
+   // The players have been moved back to their initial positions
+   // ---
+   updateSpatialIndex();
+}
+
+//------------------------------------------------------------------------------
+// updateTC() -- update time critical stuff here, and then measure how far
+// the players have moved from their spatial index positions
+//------------------------------------------------------------------------------
+void WorldModel::updateTC(const double dt)
+{
+   BaseClass::updateTC(dt);
+
+   SpatialIndex* const idx = spatialIndex.getRefPtr();
+   if (idx != nullptr) {
+      idx->measureDrift(getExecTimeSec());
+      idx->unref();
+   }
+}
+
+//------------------------------------------------------------------------------
+// updatePlayerList() -- update the player list, and then rebuild the
+// players-of-interest spatial index and remove the deleted players from
+// the comm bus
+//------------------------------------------------------------------------------
+void WorldModel::updatePlayerList()
+{
+   BaseClass::updatePlayerList();
+
+   if (commBus != nullptr) commBus->removeDeletedPlayers();
+
+   updateSpatialIndex();
+}
+
+//------------------------------------------------------------------------------
+// updateSpatialIndex() -- rebuild the players-of-interest spatial index from
+// the current player positions
+//------------------------------------------------------------------------------
+void WorldModel::updateSpatialIndex()
+{
+   if (indexCellSize > 0) {
+      base::PairStream* pl = getPlayers();
+      const auto idx = new SpatialIndex(pl, indexCellSize, getExecTimeSec());
+      spatialIndex = idx;
+      idx->unref();
+      if (pl != nullptr) pl->unref();
+   }
+   else if (spatialIndex != nullptr) {
+      spatialIndex = nullptr;
+   }
 }
 
 bool WorldModel::shutdownNotification()
@@ -141,6 +214,11 @@ bool WorldModel::shutdownNotification()
    if (atmosphere != nullptr) atmosphere->event(SHUTDOWN_EVENT);
    if (terrain != nullptr) terrain->event(SHUTDOWN_EVENT);
 
+   // ---
+   // The players have unsubscribed from the comm bus; drop any others
+   // ---
+   if (commBus != nullptr) commBus->unsubscribeAll();
+
    return true;
 }
 
@@ -255,6 +333,14 @@ bool WorldModel::setMaxRefRange(const double v)
    return ok;
 }
 
+// Sets the spatial index cell size (meters) or zero for no index
+bool WorldModel::setSpatialIndexCellSize(const double v)
+{
+   bool ok = (v >= 0);
+   if (ok) indexCellSize = v;
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // Set Slot routines
 //------------------------------------------------------------------------------
@@ -362,6 +448,36 @@ const AbstractAtmosphere* WorldModel::getAtmosphere() const
    return atmosphere;
 }
 
+// returns the players-of-interest spatial index (pre-ref()'d)
+SpatialIndex* WorldModel::getSpatialIndex()
+{
+   return spatialIndex.getRefPtr();
+}
+
+// returns the players-of-interest spatial index (pre-ref()'d)
+const SpatialIndex* WorldModel::getSpatialIndex() const
+{
+   return spatialIndex.getRefPtr();
+}
+
+// spatial index cell size (meters), or zero if disabled
+double WorldModel::getSpatialIndexCellSize() const
+{
+   return indexCellSize;
+}
+
+// returns the datalink communications bus
+CommBus* WorldModel::getCommBus()
+{
+   return commBus;
+}
+
+// returns the datalink communications bus (const version)
+const CommBus* WorldModel::getCommBus() const
+{
+   return commBus;
+}
+
 bool WorldModel::setSlotTerrain(terrain::Terrain* const msg)
 {
    if (terrain != nullptr) terrain->unref();
@@ -378,6 +494,29 @@ bool WorldModel::setSlotAtmosphere(AbstractAtmosphere* const msg)
    return true;
 }
 
+bool WorldModel::setSlotCommBus(CommBus* const msg)
+{
+   if (commBus != nullptr) {
+      commBus->unsubscribeAll();
+      commBus->unref();
+   }
+   commBus = msg;
+   if (commBus != nullptr) commBus->ref();
+   return true;
+}
+
+bool WorldModel::setSlotSpatialIndexCellSize(const base::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setSpatialIndexCellSize( base::Meters::convertStatic(*msg) );
+      if (!ok) {
+         std::cerr << "WorldModel::setSlotSpatialIndexCellSize(): invalid cell size; must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
 }
 }
 
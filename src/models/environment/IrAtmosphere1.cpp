@@ -11,6 +11,7 @@
 #include "mixr/base/numeric/Number.hpp"
 
 #include "mixr/base/units/Distances.hpp"
+#include "mixr/base/util/constants.hpp"
 
 #include <cmath>
 
@@ -19,16 +20,25 @@ namespace models {
 
 IMPLEMENT_SUBCLASS(IrAtmosphere1, "IrAtmosphere1")
 
+// Max number of wavebands whose values are computed on the stack
+static const unsigned int MAX_BUFFER_BANDS = 64;
+
 BEGIN_SLOTTABLE(IrAtmosphere1)
    "solarRadiationTable",      // The tables containing solar radiation tables
    "backgroundRadiationTable", // The background radiation table
    "transmissivityTable",      // The tables containing transmissivity data
+   "atmosphereCache",          // Enable the atmosphere cache (default: false)
+   "altitudeTolerance",        // Atmosphere cache bin size of the altitudes (default: 0)
+   "rangeTolerance",           // Atmosphere cache bin size of the ground range (default: 0)
 END_SLOTTABLE(IrAtmosphere1)
 
 BEGIN_SLOT_MAP(IrAtmosphere1)
    ON_SLOT(1,setSlotSolarRadiationTable,base::Table2)
    ON_SLOT(2,setSlotBackgroundRadiationTable,base::Table3)
    ON_SLOT(3,setSlotTransmissivityTable,base::Table4)
+   ON_SLOT(4,setSlotAtmosphereCache,base::Number)
+   ON_SLOT(5,setSlotAltitudeTolerance,base::Distance)
+   ON_SLOT(6,setSlotRangeTolerance,base::Distance)
 END_SLOT_MAP()
 
 IrAtmosphere1::IrAtmosphere1()
@@ -39,6 +49,11 @@ IrAtmosphere1::IrAtmosphere1()
 void IrAtmosphere1::copyData(const IrAtmosphere1& org, const bool)
 {
    BaseClass::copyData(org);
+
+   atmosphereCache = org.atmosphereCache;
+   for (unsigned int i = 0; i < NUM_KEYS; i++) {
+      cache.setTolerance(i, org.cache.getTolerance(i));
+   }
 }
 
 void IrAtmosphere1::deleteData()
@@ -57,6 +72,8 @@ void IrAtmosphere1::deleteData()
       transmissivityTable->unref();
       transmissivityTable = nullptr;
    }
+
+   cache.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -99,22 +116,73 @@ bool IrAtmosphere1::setSlotTransmissivityTable(const base::Table4* const tbl)
    return ok;
 }
 
+bool IrAtmosphere1::setSlotAtmosphereCache(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setAtmosphereCacheEnabled(msg->getBoolean());
+   }
+   return ok;
+}
+
+bool IrAtmosphere1::setSlotAltitudeTolerance(const base::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const double tol = base::Meters::convertStatic(*msg);
+      ok = cache.setTolerance(IN_OWN_ALT, tol) && cache.setTolerance(IN_TGT_ALT, tol);
+   }
+   return ok;
+}
+
+bool IrAtmosphere1::setSlotRangeTolerance(const base::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = cache.setTolerance(IN_RANGE, base::Meters::convertStatic(*msg));
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// setAtmosphereCacheEnabled() -- enables/disables the atmosphere cache
+//------------------------------------------------------------------------------
+bool IrAtmosphere1::setAtmosphereCacheEnabled(const bool flg)
+{
+   atmosphereCache = flg;
+   cache.clear();
+   return true;
+}
+
 
+//------------------------------------------------------------------------------
+// calculateAtmosphereContribution() -- sums the total signal that reaches the
+// seeker of the target represented by the message and the background noise
+// observed by the seeker
+//------------------------------------------------------------------------------
 bool IrAtmosphere1::calculateAtmosphereContribution(IrQueryMsg* const msg, double* totalSignal, double* totalBackground)
 {
-   // Sum the total signal that reaches the seeker of the target represented by the message
-   // and the background noise observed by the seeker
+   *totalSignal = 0.0;
+   *totalBackground = 0.0;
+
+   const unsigned int numBands = getNumWaveBands();
+   if (numBands == 0) return true;
 
-   const double* centerWavelengths = getWaveBandCenters();
-   const double* widths = getWaveBandWidths();
    const double* sigArray = msg->getSignatureByWaveband();
    const Player* ownship = msg->getOwnship();
    const Player* target = msg->getTarget();
 
+   double inputs[NUM_INPUTS] {};
+   inputs[IN_OWN_ALT] = static_cast<double>(ownship->getAltitudeM());
+   inputs[IN_TGT_ALT] = static_cast<double>(target->getAltitudeM());
+   inputs[IN_RANGE] = msg->getRange();
+   inputs[IN_LOWER] = msg->getLowerWavelength();
+   inputs[IN_UPPER] = msg->getUpperWavelength();
+
    // FAB - this should be angle of gimbal, not angle to target. (see base class)
    // Determine the angle above the horizon to be used for background radiation lookup
-   const double range2D = msg->getRange();
-   const double tanPhi = static_cast<double>( (target->getAltitudeM() - ownship->getAltitudeM())/ range2D );
+   const double range2D = inputs[IN_RANGE];
+   const double tanPhi = static_cast<double>( (inputs[IN_TGT_ALT] - inputs[IN_OWN_ALT])/ range2D );
    const double tanPhiPrime = tanPhi - ( range2D / 12756776.0f ); // Twice earth radius
 
    // appears that negative angles are down in this calculation
@@ -122,20 +190,90 @@ bool IrAtmosphere1::calculateAtmosphereContribution(IrQueryMsg* const msg, doubl
 
    // table limits are 0 to pi; this correction assumes that 0 in the table is straight down, PI is straight up
    viewingAngle += base::PI / 2.0;
+   inputs[IN_VIEW_ANGLE] = viewingAngle;
+
+   // Waveband values -- from the cache or computed in one pass
+   double buffer[MAX_BUFFER_BANDS * NUM_VALUES];
+   double* values = buffer;
+   if (numBands > MAX_BUFFER_BANDS) values = new double[numBands * NUM_VALUES];
+
+   // (without a world model there's no frame to key the entries on)
+   const WorldModel* const wm = ownship->getWorldModel();
+   const bool useCache = (atmosphereCache && wm != nullptr);
+
+   bool cached = false;
+   unsigned int frame = 0;
+   if (useCache) {
+      if (cache.getNumValues() != numBands * NUM_VALUES) cache.setup(NUM_KEYS, numBands * NUM_VALUES);
+      frame = IrCache::frameOf(wm);
+      cached = cache.find(frame, inputs, values);
+   }
+   if (!cached) {
+      computeWaveBands(inputs, values);
+      if (useCache) cache.insert(frame, inputs, values);
+   }
 
-   *totalSignal = 0.0;
-   *totalBackground = 0.0;
+   const double reflectivity = 1.0 - msg->getEmissivity();
+   for (unsigned int i = 0; i < numBands; i++) {
+      const double* const v = &values[i * NUM_VALUES];
+
+      double radiantIntensityInBin(0.0);
+      if (sigArray == nullptr) {
+         // signature is a simple number
+         // distribute simple signature evenly across atmosphere bins
+         // need to apply overlapRatio to simple signature - already applied for complex signature in IrSignature...
+         radiantIntensityInBin = msg->getSignatureAtRange() * v[VAL_FRACTION];
+      }
+      else {
+         // assuming that signature bands match atmosphere bands
+         radiantIntensityInBin = sigArray[i*3 + 2];
+      }
+
+      // add in reflected solar radiation
+      radiantIntensityInBin += reflectivity * v[VAL_SOLAR];
+
+      *totalSignal += radiantIntensityInBin * v[VAL_TRANS];
+
+      // Add the background radiance from the this waveband within the sensor limits
+      // to the total background radiance received by the sensor, watts/sr-m^2
+      *totalBackground += v[VAL_BACKGROUND] * v[VAL_TRANS];
+   }
+
+   if (values != buffer) delete[] values;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// computeWaveBands() -- computes, in one pass, the background and solar
+// radiation within the sensor's waveband, the transmissivity, and the fraction
+// of a simple signature of each waveband
+//------------------------------------------------------------------------------
+void IrAtmosphere1::computeWaveBands(const double* const inputs, double* const values) const
+{
+   const double* centerWavelengths = getWaveBandCenters();
+   const double* widths = getWaveBandWidths();
+   const unsigned int numBands = getNumWaveBands();
+
+   const double ownAlt = inputs[IN_OWN_ALT];
+   const double tgtAlt = inputs[IN_TGT_ALT];
+   const double range2D = inputs[IN_RANGE];
+   const double viewingAngle = inputs[IN_VIEW_ANGLE];
+
+   // Find the limits of the sensor
+   const double lowerSensorBound = inputs[IN_LOWER];
+   const double upperSensorBound = inputs[IN_UPPER];
+
+   // Entire atmosphere waveband
+   const double totalBand = (centerWavelengths[numBands - 1] + (widths[numBands - 1] / 2.0f)) - (centerWavelengths[0] - (widths[0] / 2.0f));
+
+   for (unsigned int i = 0; i < numBands; i++) {
+      double* const v = &values[i * NUM_VALUES];
 
-   for (unsigned int i=0; i<getNumWaveBands(); i++) {
       const double lowerBandBound = centerWavelengths[i] - (widths[i] / 2.0f);
       const double upperBandBound = lowerBandBound + widths[i];
 
       // determine ratio of this band's coverage to entire atmosphere waveband
-      const double fractionOfBandToTotal = (upperBandBound - lowerBandBound) / ((centerWavelengths[getNumWaveBands() - 1] + (widths[getNumWaveBands() - 1] / 2.0f))-(centerWavelengths[0] - (widths[0] / 2.0f)));
-
-      // Find the limits of the sensor
-      const double lowerSensorBound = msg->getLowerWavelength();
-      const double upperSensorBound = msg->getUpperWavelength();
+      const double fractionOfBandToTotal = (upperBandBound - lowerBandBound) / totalBand;
 
       // Determine how much of this wave band overlaps the sensor limits
       const double lowerOverlap = getLowerEndOfWavelengthOverlap(lowerBandBound, lowerSensorBound);
@@ -146,48 +284,18 @@ bool IrAtmosphere1::calculateAtmosphereContribution(IrQueryMsg* const msg, doubl
       const double overlapRatio = (upperOverlap - lowerOverlap) / (upperBandBound - lowerBandBound);
 
       // Get the background radiation given the sensor altitude and the viewing angle
-      double backgroundRadianceInBand = overlapRatio * getBackgroundRadiation(
-                                                lowerBandBound,
-                                                upperBandBound,
-                                                static_cast<double>(ownship->getAltitudeM()),
-                                                viewingAngle);
-      double radiantIntensityInBin(0.0);
-      if (sigArray == nullptr) {
-         // signature is a simple number
-         // distribute simple signature evenly across atmosphere bins
-         // need to apply overlapRatio to simple signature - already applied for complex signature in IrSignature...
-         radiantIntensityInBin = msg->getSignatureAtRange() * fractionOfBandToTotal * overlapRatio;
-      }
-      else {
-         // Find the limits of the bin
-         //lowerBandBound = sigArray [i*3];
-         //upperBandBound = sigArray [i*3 + 1] ;
-         // assuming that signature bands match atmosphere bands
-         radiantIntensityInBin = sigArray[i*3 + 2];
-      }
+      v[VAL_BACKGROUND] = overlapRatio * getBackgroundRadiation(lowerBandBound, upperBandBound, ownAlt, viewingAngle);
 
-      // add in reflected solar radiation
-      const double solarRadiationInBin = ((1.0f - msg->getEmissivity()) * getSolarRadiation(centerWavelengths[i],
-                                    static_cast<double>(target->getAltitudeM())));
-      radiantIntensityInBin += (solarRadiationInBin * overlapRatio);
+      // Reflected solar radiation (before the target's reflectivity)
+      v[VAL_SOLAR] = getSolarRadiation(centerWavelengths[i], tgtAlt) * overlapRatio;
 
       // Lookup the transmissivity in the wave band given the altitudes of sensor
       // and target and the ground range between the two
-      const double transmissivity = getTransmissivity(
-                                                lowerBandBound,
-                                                upperBandBound,
-                                                static_cast<double>(ownship->getAltitudeM()),
-                                                static_cast<double>(target->getAltitudeM()),
-                                                range2D);
+      v[VAL_TRANS] = getTransmissivity(lowerBandBound, upperBandBound, ownAlt, tgtAlt, range2D);
 
-      *totalSignal += radiantIntensityInBin * transmissivity;
-
-      // Add the background radiance from the this waveband within the sensor limits
-      // to the total background radiance received by the sensor, watts/sr-m^2
-      *totalBackground += backgroundRadianceInBand * transmissivity;
+      // need to apply overlapRatio to simple signature
+      v[VAL_FRACTION] = fractionOfBandToTotal * overlapRatio;
    }
-
-   return true;
 }
 
 //------------------------------------------------------------------------------------------------------
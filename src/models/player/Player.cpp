@@ -2564,6 +2564,17 @@ bool Player::onTgtStepEvent()
 
 //------------------------------------------------------------------------------
 // onRfEmissionEventPlayer() -- process RF Emission events
+//------------------------------------------------------------------------------
+bool Player::onRfEmissionEventPlayer(Emission* const em)
+{
+   return onRfEmissions(&em, 1);
+}
+
+//------------------------------------------------------------------------------
+// onRfEmissions() -- process a batch of RF emissions that were sent to us; the
+// same as an RF_EMISSION event for each emission.
+//
+// For each emission,
 //
 // 1) compute the Line-Of-Sight (LOS) vectors back to the transmitter
 //
@@ -2576,15 +2587,46 @@ bool Player::onTgtStepEvent()
 //
 // 5) Send the reflected emission back to transmitter
 //
-// 6) Pass the emission to our antennas and unref() the emission
+// and then
+//
+// 6) Pass the emissions to our antennas
 //
-// 7) Pass the emission to anyone requesting reflected emissions
+// 7) Pass the emissions to anyone requesting reflected emissions
 //------------------------------------------------------------------------------
-bool Player::onRfEmissionEventPlayer(Emission* const em)
+bool Player::onRfEmissions(Emission* const* const ems, const unsigned int n)
 {
    // Player must be active ...
    if (isNotMode(ACTIVE)) return false;
 
+   for (unsigned int i = 0; i < n; i++) {
+      onRfEmission(ems[i]);
+   }
+
+   // 6) Pass the emissions to our antennas
+   {
+      Gimbal* g = getGimbal();
+      if (g != nullptr && g->getPowerSwitch() != System::PWR_OFF) {
+         g->onRfEmissions(ems, n);
+      }
+   }
+
+   // 7) Pass the emissions to anyone requesting reflected emissions
+   //    (we're doing do calculations here, this is only meaningful to
+   //     the receiving player)
+   for (unsigned int i = 0; i < MAX_RF_REFLECTIONS; i++) {
+      if (rfReflect[i] != nullptr) {
+         for (unsigned int j = 0; j < n; j++) {
+            rfReflect[i]->event(RF_REFLECTED_EMISSION, ems[j]);
+         }
+      }
+   }
+
+   return true;
+}
+
+// Steps 1 to 5 of onRfEmissions() for emission 'em'
+void Player::onRfEmission(Emission* const em)
+{
    // ---
    //  1) Compute the Line-Of-Sight vectors back to the transmitter (los0)
    // ---
@@ -2625,23 +2667,6 @@ bool Player::onRfEmissionEventPlayer(Emission* const em)
       // Send reflected emissions back to the transmitter
       em->getGimbal()->event(RF_EMISSION_RETURN,em);
    }
-
-   // 6) Pass the emission to our antennas
-   {
-      Gimbal* g = getGimbal();
-      if (g != nullptr && g->getPowerSwitch() != System::PWR_OFF) {
-         g->event(RF_EMISSION,em);
-      }
-   }
-
-   // 7) Pass the emission to anyone requesting reflected emissions
-   //    (we're doing do calculations here, this is only meaningful to
-   //     the receiving player)
-   for (unsigned int i = 0; i < MAX_RF_REFLECTIONS; i++) {
-      if (rfReflect[i] != nullptr) rfReflect[i]->event(RF_REFLECTED_EMISSION,em);
-   }
-
-   return true;
 }
 
 //------------------------------------------------------------------------------
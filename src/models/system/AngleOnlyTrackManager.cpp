@@ -35,12 +35,12 @@ BEGIN_SLOT_MAP(AngleOnlyTrackManager)
     ON_SLOT(2, setSlotElevationBin, base::Number)
 END_SLOT_MAP()
 
-AngleOnlyTrackManager::AngleOnlyTrackManager() : queryQueue(MAX_TRKS)
+AngleOnlyTrackManager::AngleOnlyTrackManager()
 {
     STANDARD_CONSTRUCTOR()
 }
 
-AngleOnlyTrackManager::AngleOnlyTrackManager(const AngleOnlyTrackManager& org) : queryQueue(MAX_TRKS)
+AngleOnlyTrackManager::AngleOnlyTrackManager(const AngleOnlyTrackManager& org)
 {
     STANDARD_CONSTRUCTOR()
     copyData(org, true);
@@ -94,12 +94,7 @@ void AngleOnlyTrackManager::clearTracksAndQueues()
     // ---
     // Clear out the queue(s)
     // ---
-    base::lock(queueLock);
-    for (IrQueryMsg* q = queryQueue.get(); q != nullptr; q = queryQueue.get()) {
-        q->unref();     // unref() the IR query message
-        snQueue.get();  // and every IR query message had a S/N value
-    }
-    base::unlock(queueLock);
+    clearReports();
 
     // ---
     // Clear the track list
@@ -122,14 +117,17 @@ void AngleOnlyTrackManager::newReport(IrQueryMsg* q, double sn)
 {
     // Queue up IR query messages reports
     if (q != nullptr) {
-        q->ref();
-        base::lock(queueLock);
-        queryQueue.put(q);
-        snQueue.put(sn);
-        base::unlock(queueLock);
+        putReport(q, sn);
     }
 }
 
+//------------------------------------------------------------------------------
+// newReport() -- Emission reports are ignored (see getQuery())
+//------------------------------------------------------------------------------
+void AngleOnlyTrackManager::newReport(Emission*, double)
+{
+}
+
 //------------------------------------------------------------------------------
 // getQuery() -- Get the next 'new' report of the queue
 //------------------------------------------------------------------------------
@@ -137,12 +135,11 @@ IrQueryMsg* AngleOnlyTrackManager::getQuery(double* const sn)
 {
     IrQueryMsg* q = nullptr;
 
-    base::lock(queueLock);
-    q = queryQueue.get();
-    if (q != nullptr) {
-        *sn = snQueue.get();
+    Report rpt;
+    if (getReports(&rpt, 1) > 0) {
+        q = static_cast<IrQueryMsg*>(rpt.msg);   // (we queue only IR query messages)
+        *sn = rpt.sn;
     }
-    base::unlock(queueLock);
 
     return q;
 }
@@ -165,6 +162,21 @@ bool AngleOnlyTrackManager::addTrack(Track* const t)
     return ok;
 }
 
+//------------------------------------------------------------------------------
+// setMaxTracks() -- Sets the maximum number of tracks, [ 1 .. MAX_TRKS ]
+//------------------------------------------------------------------------------
+bool AngleOnlyTrackManager::setMaxTracks(const unsigned int n)
+{
+    bool ok = false;
+    if (n <= MAX_TRKS) {
+        ok = BaseClass::setMaxTracks(n);
+    }
+    else {
+        std::cerr << "AngleOnlyTrackManager::setMaxTracks: maxTracks is invalid, range: [1 .. " << MAX_TRKS << "]" << std::endl;
+    }
+    return ok;
+}
+
 //------------------------------------------------------------------------------
 // Sets azimuth bin
 //------------------------------------------------------------------------------
@@ -4,12 +4,14 @@
 #include "mixr/models/system/RfSystem.hpp"
 #include "mixr/models/Emission.hpp"
 #include "mixr/models/Tdb.hpp"
+#include "mixr/models/WorldModel.hpp"
 
 #include "mixr/base/functors/Functions.hpp"
 #include "mixr/base/numeric/Integer.hpp"
 #include "mixr/base/List.hpp"
 #include "mixr/base/PairStream.hpp"
 #include "mixr/base/Pair.hpp"
+#include "mixr/base/Tracer.hpp"
 
 #include "mixr/base/units/Angles.hpp"
 #include "mixr/base/units/Decibel.hpp"
@@ -18,11 +20,144 @@
 
 #include "mixr/base/util/math_utils.hpp"
 
+#include <atomic>
 #include <cmath>
+#include <typeinfo>
 
 namespace mixr {
 namespace models {
 
+namespace {
+
+//------------------------------------------------------------------------------
+// EmissionArena -- per-thread pool of emissions for rfTransmit()
+//
+// The arena holds a reference to each of its emissions; an emission is free
+// when the arena holds the only reference.  reset() is called by each
+// rfTransmit(), but only resets the arena on the first call of each phase:
+// it clears the free emissions, which releases their players, and starts
+// the search for free emissions over from the front of the arena.
+//
+// release() is called after the emissions have been delivered and clears the
+// ones that the receivers didn't keep, so a free emission doesn't hold its
+// ownship and target players; flush() releases all of the emissions, and is
+// called by Antenna::shutdownNotification() at simulation shutdown and by the
+// arena's destructor at thread exit.
+//------------------------------------------------------------------------------
+class EmissionArena
+{
+public:
+   EmissionArena() = default;
+   EmissionArena(const EmissionArena&) = delete;
+   EmissionArena& operator=(const EmissionArena&) = delete;
+   ~EmissionArena();
+
+   void reset(const WorldModel* const sim);
+
+   // Returns a pre-ref()'d copy of 'xmit'
+   Emission* getEmission(const Emission* const xmit);
+
+   // Position of the search for free emissions, and clear the free
+   // emissions from position 'from' to the current position
+   unsigned int position() const      { return next; }
+   void release(const unsigned int from);
+
+   // Releases all emissions
+   void flush();
+
+private:
+   static const unsigned int MAX_SIZE = 10000;   // Max number of emissions in the arena
+
+   Emission** ems {};            // The emissions (ref()'d)
+   unsigned int size {};         // Number of emissions
+   unsigned int max {};          // Size of the 'ems' array
+   unsigned int next {};         // Next emission to check
+
+   const WorldModel* sim {};     // Simulation and executive counter
+   unsigned int phase {};        //  ... at our last reset
+};
+
+EmissionArena::~EmissionArena()
+{
+   flush();
+}
+
+void EmissionArena::flush()
+{
+   for (unsigned int i = 0; i < size; i++) {
+      ems[i]->unref();
+   }
+   if (ems != nullptr) delete[] ems;
+   ems = nullptr;
+   size = 0;
+   max = 0;
+   next = 0;
+   sim = nullptr;
+   phase = 0;
+}
+
+void EmissionArena::reset(const WorldModel* const s)
+{
+   const unsigned int p = (s != nullptr ? s->getExecCounter() : 0);
+   if (s == sim && p == phase) return;
+   sim = s;
+   phase = p;
+
+   std::atomic_thread_fence(std::memory_order_acquire);
+   for (unsigned int i = 0; i < size; i++) {
+      if (ems[i]->getRefCount() == 1) ems[i]->clear();
+   }
+   next = 0;
+}
+
+void EmissionArena::release(const unsigned int from)
+{
+   std::atomic_thread_fence(std::memory_order_acquire);
+   for (unsigned int i = from; i < next && i < size; i++) {
+      if (ems[i]->getRefCount() == 1) ems[i]->clear();
+   }
+}
+
+Emission* EmissionArena::getEmission(const Emission* const xmit)
+{
+   // Look for a free emission of the same type
+   while (next < size) {
+      Emission* em = ems[next++];
+      if (em->getRefCount() == 1 && typeid(*em) == typeid(*xmit)) {
+         // Make sure the receivers are finished with it before we reuse it
+         std::atomic_thread_fence(std::memory_order_acquire);
+         em->ref();
+         *em = *xmit;
+         return em;
+      }
+   }
+
+   // None free, so clone a new one ...
+   Emission* em = xmit->clone();
+
+   // ... and add it to the arena
+   if (em != nullptr && size < MAX_SIZE) {
+      if (size == max) {
+         const unsigned int n = (max > 0 ? 2 * max : 64);
+         Emission** tmp = new Emission*[n];
+         for (unsigned int i = 0; i < size; i++) {
+            tmp[i] = ems[i];
+         }
+         if (ems != nullptr) delete[] ems;
+         ems = tmp;
+         max = n;
+      }
+      ems[size++] = em;
+      next = size;
+      em->ref();
+   }
+   return em;
+}
+
+thread_local EmissionArena emArena;
+
+}
+
 IMPLEMENT_PARTIAL_SUBCLASS(Antenna, "Antenna")
 
 BEGIN_SLOTTABLE(Antenna)
@@ -103,14 +238,6 @@ void Antenna::deleteData()
 {
    setSystem(nullptr);
    setSlotGainPattern(nullptr);
-
-   clearQueues();
-}
-
-void Antenna::reset()
-{
-    BaseClass::reset();
-    clearQueues();
 }
 
 //------------------------------------------------------------------------------
@@ -119,52 +246,17 @@ void Antenna::reset()
 bool Antenna::shutdownNotification()
 {
     setSystem(nullptr);
-    clearQueues();
-
-    return BaseClass::shutdownNotification();
-}
-
-//------------------------------------------------------------------------------
-// process() -- Process phase
-//------------------------------------------------------------------------------
-void Antenna::process(const double dt)
-{
-   BaseClass::process(dt);
-
-   // ---
-   // Recycle emissions ...
-   // Update emission queues: from 'in-use' to 'free'
-   // ---
-   if (recycle) {
-      unsigned int n = inUseEmQueue.entries();
 
-      for (unsigned int i = 0; i < n; i++) {
-
-         base::lock(inUseEmLock);
-         Emission* em = inUseEmQueue.get();
-         base::unlock(inUseEmLock);
-
-         if (em != nullptr && em->getRefCount() > 1) {
-            // Others are still referencing the emission, put back on in-use queue
-            base::lock(inUseEmLock);
-            inUseEmQueue.put(em);
-            base::unlock(inUseEmLock);
-         }
-
-         else if (em != nullptr && em->getRefCount() <= 1) {
-            // No one else is referencing the emission, push to the free stack
-            em->clear();
-            base::lock(freeEmLock);
-            if (freeEmStack.isNotFull()) freeEmStack.push(em);
-            else em->unref();
-            base::unlock(freeEmLock);
-         }
-      }
-   }
+    // The arena is shared by all of this thread's antennas, so it's only
+    // released when the simulation is shutting down, and not when a single
+    // player is removed (the other threads' arenas, and this one if we're
+    // not shut down here, are released when their threads exit)
+    const WorldModel* const sim = getWorldModel();
+    if (sim == nullptr || sim->isShutdown()) emArena.flush();
 
+    return BaseClass::shutdownNotification();
 }
 
-
 //------------------------------------------------------------------------------
 // setSystem() -- Set pointer to our companion system
 //------------------------------------------------------------------------------
@@ -176,28 +268,6 @@ bool Antenna::setSystem(RfSystem* const s)
    return true;
 }
 
-//------------------------------------------------------------------------------
-// clearQueues() -- clear out all queues
-//------------------------------------------------------------------------------
-void Antenna::clearQueues()
-{
-   base::lock(freeEmLock);
-   Emission* em = freeEmStack.pop();
-   while (em != nullptr) {
-      em->unref();
-      em = freeEmStack.pop();
-   }
-   base::unlock(freeEmLock);
-
-   base::lock(inUseEmLock);
-   em = inUseEmQueue.get();
-   while (em != nullptr) {
-      em->unref();
-      em = inUseEmQueue.get();
-   }
-   base::unlock(inUseEmLock);
-}
-
 //------------------------------------------------------------------------------
 // setSlotPolarization() -- calls setPolarization()
 //------------------------------------------------------------------------------
@@ -381,6 +451,8 @@ bool Antenna::setBeamWidth(const double radians)
 //------------------------------------------------------------------------------
 void Antenna::rfTransmit(Emission* const xmit)
 {
+   MIXR_TRACE_ZONE("Antenna::rfTransmit");
+
    // Need something to transmit and someone to send to
    Tdb* tdb = getCurrentTDB();
    Player* ownship = getOwnship();
@@ -425,14 +497,19 @@ void Antenna::rfTransmit(Emission* const xmit)
             // Lookup gain in 2D table and convert from dB
             double gainTgt0[MAX_PLAYERS];
             if (gainPatternDeg) {
+               double aazd[MAX_PLAYERS];
+               double aeld[MAX_PLAYERS];
                for (unsigned int i1 = 0; i1 < ntgts; i1++) {
-                  gainTgt0[i1] = gainFunc2->f( (aazr[i1] * base::angle::R2DCC), (aelr[i1] * base::angle::R2DCC) )/10.0;
+                  aazd[i1] = aazr[i1] * base::angle::R2DCC;
+                  aeld[i1] = aelr[i1] * base::angle::R2DCC;
                }
+               gainFunc2->fArray(aazd, aeld, gainTgt0, ntgts);
             }
             else {
-               for (unsigned int i1 = 0; i1 < ntgts; i1++) {
-                  gainTgt0[i1] = gainFunc2->f( aazr[i1], aelr[i1] )/10.0f;
-               }
+               gainFunc2->fArray(aazr, aelr, gainTgt0, ntgts);
+            }
+            for (unsigned int i1 = 0; i1 < ntgts; i1++) {
+               gainTgt0[i1] /= 10.0;
             }
             base::pow10Array(gainTgt0, gainTgt, ntgts);
             haveGainTgt = true;
@@ -448,14 +525,17 @@ void Antenna::rfTransmit(Emission* const xmit)
             // Lookup gain in 1D table and convert from dB
             double gainTgt0[MAX_PLAYERS];
             if (gainPatternDeg) {
+               double aad[MAX_PLAYERS];
                for (unsigned int i2 = 0; i2 < ntgts; i2++) {
-                  gainTgt0[i2] = gainFunc1->f( aar[i2] * base::angle::R2DCC )/10.0;
+                  aad[i2] = aar[i2] * base::angle::R2DCC;
                }
+               gainFunc1->fArray(aad, gainTgt0, ntgts);
             }
             else {
-               for (unsigned int i2 = 0; i2 < ntgts; i2++) {
-                  gainTgt0[i2] = gainFunc1->f( aar[i2] )/10.0f;
-               }
+               gainFunc1->fArray(aar, gainTgt0, ntgts);
+            }
+            for (unsigned int i2 = 0; i2 < ntgts; i2++) {
+               gainTgt0[i2] /= 10.0;
             }
             base::pow10Array(gainTgt0, gainTgt, ntgts);
             haveGainTgt = true;
@@ -486,35 +566,28 @@ void Antenna::rfTransmit(Emission* const xmit)
       Player** targets = tdb->getTargets();
 
       // ---
-      // Send emission packets to the targets
+      // Fill the emission packets for the targets
       // ---
+      Emission* emissions[MAX_PLAYERS];
+      unsigned int nem = 0;
+      unsigned int first = 0;
+      if (recycle) {
+         emArena.reset(ownship->getWorldModel());
+         first = emArena.position();
+      }
       for (unsigned int i = 0; i < ntgts; i++) {
 
          // Only of power exceeds an optional threshold
          if (erp[i] > threshold) {
 
-            // Get a free emission packet
+            // Get a free emission packet (a copy of the template emission)
             Emission* em(nullptr);
-            if (recycle) {
-               base::lock(freeEmLock);
-               em = freeEmStack.pop();
-               base::unlock(freeEmLock);
-            }
-
-            bool cloned = false;
-            if (em == nullptr) {
-               // Otherwise, clone a new one
-               em = xmit->clone();
-               cloned = true;
-            }
+            if (recycle) em = emArena.getEmission(xmit);
+            else em = xmit->clone();
 
-            // Send the emission to the other player
             if (em != nullptr) {
 
-               // a) Copy the template emission
-               if (!cloned) *em = *xmit;
-
-               // b) Set target unique data
+               // Set target unique data
                em->setGimbal(this);
                em->setOwnship(ownship);
 
@@ -531,26 +604,7 @@ void Antenna::rfTransmit(Emission* const xmit)
                em->setPolarization(getPolarization());
                em->setLocalPlayersOnly( isLocalPlayersOfInterestOnly() );
 
-               // c) Send the emission to the target
-               targets[i]->event(RF_EMISSION, em);
-
-               // d) Recycle the emission (we don't bother)
-               //bool recycled = false;
-               //if (recycle) {
-               //   base::lock(inUseEmLock);
-               //   if (inUseEmQueue.isNotFull()) {
-                     // Store for future reference
-               //      inUseEmQueue.put(em);
-               //      recycled = true;
-               //   }
-               //   base::unlock(inUseEmLock);
-               //}
-
-               // or just forget it
-               //else {
-                  em->unref();
-               //}
-
+               emissions[nem++] = em;
             }
             else {
                // When we couldn't get a free emission packet
@@ -561,12 +615,41 @@ void Antenna::rfTransmit(Emission* const xmit)
          }
 
       }
+
+      // ---
+      // Send the emission packets to the targets and release them
+      // (the arena's emissions are reused once the receivers are done)
+      // ---
+      deliverEmissions(emissions, nem);
+      for (unsigned int i = 0; i < nem; i++) {
+         emissions[i]->unref();
+      }
+      if (recycle) emArena.release(first);
    }
 
    // Unref() the TDB
    tdb->unref();
 }
 
+//------------------------------------------------------------------------------
+// deliverEmissions() -- Send the emissions to their target players; each run
+// of emissions with the same target is passed to the target's onRfEmissions()
+// as one batch, which is the same as sending the target an RF_EMISSION event
+// for each emission, without the event dispatch.
+//------------------------------------------------------------------------------
+void Antenna::deliverEmissions(Emission* const* const ems, const unsigned int n)
+{
+   MIXR_TRACE_ZONE("Antenna::deliverEmissions");
+   unsigned int i = 0;
+   while (i < n) {
+      Player* const tgt = ems[i]->getTarget();
+      unsigned int j = i + 1;
+      while (j < n && ems[j]->getTarget() == tgt) j++;
+      if (tgt != nullptr) tgt->onRfEmissions(&ems[i], (j - i));
+      i = j;
+   }
+}
+
 //------------------------------------------------------------------------------
 // onStartScanEvent() -- process the start of a scan
 //------------------------------------------------------------------------------
@@ -615,87 +698,126 @@ bool Antenna::onRfEmissionEvent(Emission* const em)
       if (ownship != nullptr && sys1 != nullptr) {
          sys1->ref();
 
-         // Line-Of-Sight (LOS) vectors back to the transmitter.
-         const base::Vec3d xlos = em->getTgtLosVec();
-         const base::Vec4d los0( xlos.x(), xlos.y(), xlos.z(), 0.0);
-
-         // 2) Transform local NED LOS vectors to antenna coordinates
+         // Rotation matrix: local NED to antenna coordinates
          base::Matrixd mm = getRotMat();
          mm *= ownship->getRotMat();
-         base::Vec4d losA = mm * los0;
 
-         // ---
-         // Compute antenna gains in the direction of the transmitter
-         // ---
-         double rGainDb = 0.0;
-         if (gainPattern != nullptr) {
+         receiveEmission(em, sys1, mm);
+
+         sys1->unref();
+      }
 
-            const auto gainFunc1 = dynamic_cast<base::Func1*>(gainPattern);
-            const auto gainFunc2 = dynamic_cast<base::Func2*>(gainPattern);
-            if (gainFunc2 != nullptr) {
-               // ---
-               // 3-a) Antenna pattern: 2D table (az & el off antenna boresight)
-               // ---
+   }
 
-               // Get component arrays and ground range squared
-               const double xa =  losA.x();
-               const double ya =  losA.y();
-               const double za = -losA.z();
-               const double ra2 = xa*xa + ya*ya;
+   return BaseClass::onRfEmissionEvent(em);
+}
 
-               // Compute range along antenna x-y plane
-               const double ra = std::sqrt(ra2);
+//------------------------------------------------------------------------------
+// onRfEmissions() -- process a batch of RF emissions not sent by us; same as
+// onRfEmissionEvent() for each emission, but the ownship, system and rotation
+// matrix are looked up once for the batch.
+//------------------------------------------------------------------------------
+bool Antenna::onRfEmissions(Emission* const* const ems, const unsigned int n)
+{
+   Player* ownship = getOwnship();
+   RfSystem* sys1 = getSystem();
+   if (ownship != nullptr && sys1 != nullptr) {
+      sys1->ref();
 
-               // Compute azimuth off boresight
-               const double aazr = std::atan2(ya,xa);
+      // Rotation matrix: local NED to antenna coordinates
+      base::Matrixd mm = getRotMat();
+      mm *= ownship->getRotMat();
 
-               // Compute elevation off boresight
-               const double aelr = std::atan2(za,ra);
+      for (unsigned int i = 0; i < n; i++) {
+         // Is this emission from a player of interest?
+         if (fromPlayerOfInterest(ems[i])) receiveEmission(ems[i], sys1, mm);
+      }
 
-               // Lookup gain in 2D table and convert from dB
-               if (gainPatternDeg)
-                  rGainDb = gainFunc2->f( aazr * base::angle::R2DCC, aelr * base::angle::R2DCC );
-               else
-                  rGainDb = gainFunc2->f( aazr, aelr );
+      sys1->unref();
+   }
 
-            }
+   return BaseClass::onRfEmissions(ems, n);
+}
+
+//------------------------------------------------------------------------------
+// receiveEmission() -- compute the total receiving antenna gain for an RF
+// emission and send the emission to our system ('mm' is the local NED to
+// antenna coordinates rotation matrix)
+//------------------------------------------------------------------------------
+void Antenna::receiveEmission(Emission* const em, RfSystem* const rfSys, const base::Matrixd& mm)
+{
+   // Line-Of-Sight (LOS) vectors back to the transmitter.
+   const base::Vec3d xlos = em->getTgtLosVec();
+   const base::Vec4d los0( xlos.x(), xlos.y(), xlos.z(), 0.0);
 
-            else if (gainFunc1 != nullptr) {
-               // ---
-               // 3-b) Antenna Pattern: 1D table (off antenna boresight only
-               // ---
+   // 2) Transform local NED LOS vectors to antenna coordinates
+   const base::Vec4d losA = mm * los0;
 
-               // Compute angle off antenna boresight
-               const double aar = std::acos(losA.x());
+   // ---
+   // Compute antenna gains in the direction of the transmitter
+   // ---
+   double rGainDb = 0.0;
+   if (gainPattern != nullptr) {
 
-               // Lookup gain in 1D table and convert from dB
-               if (gainPatternDeg)
-                  rGainDb = gainFunc1->f( aar * base::angle::R2DCC );
-               else
-                  rGainDb = gainFunc1->f(aar);
+      const auto gainFunc1 = dynamic_cast<base::Func1*>(gainPattern);
+      const auto gainFunc2 = dynamic_cast<base::Func2*>(gainPattern);
+      if (gainFunc2 != nullptr) {
+         // ---
+         // 3-a) Antenna pattern: 2D table (az & el off antenna boresight)
+         // ---
 
-            }
-         }
+         // Get component arrays and ground range squared
+         const double xa =  losA.x();
+         const double ya =  losA.y();
+         const double za = -losA.z();
+         const double ra2 = xa*xa + ya*ya;
 
-         // Compute off-boresight gain
-         const double rGain = std::pow(10.0,rGainDb/10.0);
+         // Compute range along antenna x-y plane
+         const double ra = std::sqrt(ra2);
 
-         // Compute Antenna Effective Gain
-         const double aeGain = rGain * getGain();
-         const double lambda = em->getWavelength();
-         const double aea = getEffectiveArea(aeGain, lambda);
+         // Compute azimuth off boresight
+         const double aazr = std::atan2(ya,xa);
 
-         const double pGain = getPolarizationGain(em->getPolarization());
-         const double raGain = aea * pGain;
+         // Compute elevation off boresight
+         const double aelr = std::atan2(za,ra);
 
-         sys1->rfReceivedEmission(em, this, static_cast<double>(raGain));
+         // Lookup gain in 2D table and convert from dB
+         if (gainPatternDeg)
+            rGainDb = gainFunc2->f( aazr * base::angle::R2DCC, aelr * base::angle::R2DCC );
+         else
+            rGainDb = gainFunc2->f( aazr, aelr );
 
-         sys1->unref();
       }
 
+      else if (gainFunc1 != nullptr) {
+         // ---
+         // 3-b) Antenna Pattern: 1D table (off antenna boresight only
+         // ---
+
+         // Compute angle off antenna boresight
+         const double aar = std::acos(losA.x());
+
+         // Lookup gain in 1D table and convert from dB
+         if (gainPatternDeg)
+            rGainDb = gainFunc1->f( aar * base::angle::R2DCC );
+         else
+            rGainDb = gainFunc1->f(aar);
+
+      }
    }
 
-   return BaseClass::onRfEmissionEvent(em);
+   // Compute off-boresight gain
+   const double rGain = std::pow(10.0,rGainDb/10.0);
+
+   // Compute Antenna Effective Gain
+   const double aeGain = rGain * getGain();
+   const double lambda = em->getWavelength();
+   const double aea = getEffectiveArea(aeGain, lambda);
+
+   const double pGain = getPolarizationGain(em->getPolarization());
+   const double raGain = aea * pGain;
+
+   rfSys->rfReceivedEmission(em, this, static_cast<double>(raGain));
 }
 
 //------------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 
 #include "mixr/models/system/Datalink.hpp"
 #include "mixr/models/player/Player.hpp"
+#include "mixr/models/CommBus.hpp"
 #include "mixr/models/system/Radio.hpp"
 #include "mixr/models/system/TrackManager.hpp"
 #include "mixr/models/system/OnboardComputer.hpp"
@@ -13,6 +14,7 @@
 #include "mixr/base/String.hpp"
 #include "mixr/base/units/Distances.hpp"
 
+#include "mixr/base/util/atomics.hpp"
 #include "mixr/base/util/system_utils.hpp"
 
 namespace mixr {
@@ -25,6 +27,7 @@ BEGIN_SLOTTABLE(Datalink)
    "maxRange",          // 2: Max range of the datalink (w/o a radio model)
    "radioName",         // 3: Name of the (optional) communication radio mode
    "trackManagerName",  // 4: Track Manager Name
+   "network",           // 5: Comm bus network number
 END_SLOTTABLE(Datalink)
 
 BEGIN_SLOT_MAP(Datalink)
@@ -32,6 +35,7 @@ BEGIN_SLOT_MAP(Datalink)
     ON_SLOT(2,setSlotMaxRange,base::Distance)
     ON_SLOT(3,setRadioName,base::String)
     ON_SLOT(4,setTrackManagerName,base::String)
+    ON_SLOT(5,setSlotNetwork,base::Number)
 END_SLOT_MAP()
 
 BEGIN_EVENT_HANDLER(Datalink)
@@ -48,6 +52,7 @@ void Datalink::initData()
 {
    inQueue = new base::safe_queue<base::Object*>(MAX_MESSAGES);
    outQueue = new base::safe_queue<base::Object*>(MAX_MESSAGES);
+   inbox = new base::mpsc_queue<base::Object*>(MAX_MESSAGES);
 }
 
 void Datalink::copyData(const Datalink& org, const bool cc)
@@ -62,6 +67,9 @@ void Datalink::copyData(const Datalink& org, const bool cc)
    sendLocal = org.sendLocal;
    queueForNetwork = org.queueForNetwork;
 
+   network = org.network;
+   unsubscribeCommBus();
+
    {
       const base::String* p = nullptr;
       if (org.radioName != nullptr) {
@@ -83,6 +91,12 @@ void Datalink::copyData(const Datalink& org, const bool cc)
 
 void Datalink::deleteData()
 {
+   unsubscribeCommBus();
+   if (inbox != nullptr) {
+      clearInbox();
+      delete inbox;
+      inbox = nullptr;
+   }
    if (inQueue != nullptr && outQueue != nullptr) {
       clearQueues();
       delete inQueue;
@@ -101,6 +115,7 @@ void Datalink::deleteData()
 //------------------------------------------------------------------------------
 bool Datalink::shutdownNotification()
 {
+   unsubscribeCommBus();
    clearQueues();
    setRadio(nullptr);
    setTrackManager(nullptr);
@@ -149,6 +164,13 @@ bool Datalink::setNetworkQueueEnabled(const bool flg)
    return true;
 }
 
+// Comm bus network number
+bool Datalink::setNetwork(const int num)
+{
+   network = num;
+   return true;
+}
+
 // set our comm radio system
 bool Datalink::setRadio(CommRadio* const p)
 {
@@ -255,6 +277,7 @@ void Datalink::reset()
             rad->setTransmitterEnableFlag(true);
         }
    }
+   updateCommBus();
    BaseClass::reset();
 }
 
@@ -263,6 +286,10 @@ void Datalink::reset()
 //------------------------------------------------------------------------------
 void Datalink::dynamics(const double)
 {
+    // Handle the messages from the comm bus
+    updateCommBus();
+    processInbox();
+
     //age queues
     mixr::base::Object* tempInQueue[MAX_MESSAGES];
     int numIn = 0;
@@ -324,10 +351,28 @@ bool Datalink::sendMessage(base::Object* const msg)
 
    // If we can send to our local players directly (or via radio)
    if (sendLocal) {
+      WorldModel* sim = getWorldModel();
+      CommBus* bus = (sim != nullptr) ? sim->getCommBus() : nullptr;
+
+      // ---
+      // Have a comm bus -- then we'll publish this to the other datalinks on
+      // our network and (radio) frequency; with a radio, the bus only delivers
+      // to the players within its max detection range (see CommBus::publish())
+      // ---
+      if (bus != nullptr && getOwnship() != nullptr) {
+         if (radio == nullptr || radio->isTransmitterEnabled()) {
+            const double freq = (radio != nullptr) ? radio->getFrequency() : 0.0;
+            const double rngNM = (radio != nullptr) ? radio->getMaxDetectRange() : noRadioMaxRange;
+            const WorldModel* csim = sim;
+            bus->publish(this, getOwnship(), msg, network, freq, rngNM * base::distance::NM2M, csim->getTerrain());
+            sent = true;
+         }
+      }
+
       // ---
       // Have a comm radio -- then we'll just let our companion radio system handle this
       // ---
-      if (radio != nullptr) {
+      else if (radio != nullptr) {
          sent = radio->transmitDataMessage(msg);
       }
 
@@ -335,7 +380,6 @@ bool Datalink::sendMessage(base::Object* const msg)
       // No comm radio -- then we'll send this out to the other players ourself.
       // ---
       else if (getOwnship() != nullptr) {
-         WorldModel* sim = getWorldModel();
          if (sim != nullptr) {
 
             base::PairStream* players = sim->getPlayers();
@@ -394,6 +438,93 @@ base::Object* Datalink::receiveMessage()
    return inQueue->get();
 }
 
+//------------------------------------------------------------------------------
+// postMessage() -- post a message from the comm bus to our inbox; called by
+// the sending player's thread, so the message is handled later by our own
+// dynamics() (see processInbox()).
+//------------------------------------------------------------------------------
+bool Datalink::postMessage(base::Object* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr && inbox != nullptr) {
+      msg->ref();
+      ok = inbox->put(msg);
+      if (!ok) msg->unref();
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// processInbox() -- pass the messages in our inbox to our DATALINK_MESSAGE
+// event handler
+//------------------------------------------------------------------------------
+void Datalink::processInbox()
+{
+   if (inbox == nullptr) return;
+
+   base::Object* msgs[INBOX_BATCH];
+   unsigned int n = 0;
+   do {
+      base::lock(inboxLock);
+      n = inbox->get(msgs, INBOX_BATCH);
+      base::unlock(inboxLock);
+
+      for (unsigned int i = 0; i < n; i++) {
+         event(DATALINK_MESSAGE, msgs[i]);
+         msgs[i]->unref();
+      }
+   } while (n == INBOX_BATCH);
+}
+
+void Datalink::clearInbox()
+{
+   if (inbox == nullptr) return;
+
+   base::lock(inboxLock);
+   base::Object* msg = inbox->get();
+   while (msg != nullptr) {
+      msg->unref();
+      msg = inbox->get();
+   }
+   base::unlock(inboxLock);
+}
+
+//------------------------------------------------------------------------------
+// updateCommBus() -- subscribe to the world model's comm bus, if any, or change
+// our subscription when our network number or our radio's frequency changes.
+// Only local players subscribe, and only by their top level datalink, which
+// passes the messages to its subcomponents, and by datalinks with a radio.
+//------------------------------------------------------------------------------
+void Datalink::updateCommBus()
+{
+   CommBus* bus = nullptr;
+   Player* ownship = getOwnship();
+   if (ownship != nullptr && ownship->isLocalPlayer() && (radio != nullptr || ownship->getDatalink() == this)) {
+      WorldModel* sim = getWorldModel();
+      if (sim != nullptr) bus = sim->getCommBus();
+   }
+   const double freq = (radio != nullptr) ? radio->getFrequency() : 0.0;
+
+   if (bus != commBus || (bus != nullptr && (network != busNetwork || freq != busFreq))) {
+      unsubscribeCommBus();
+      if (bus != nullptr && bus->subscribe(this, ownship, network, freq)) {
+         commBus = bus;
+         commBus->ref();
+         busNetwork = network;
+         busFreq = freq;
+      }
+   }
+}
+
+void Datalink::unsubscribeCommBus()
+{
+   if (commBus != nullptr) {
+      commBus->unsubscribe(this);
+      commBus->unref();
+      commBus = nullptr;
+   }
+}
+
 //------------------------------------------------------------------------------
 // queueIncomingMessage() -- Queue up an incoming message
 //------------------------------------------------------------------------------
@@ -456,6 +587,7 @@ bool Datalink::queueOutgoingMessage(base::Object* const msg)
 //------------------------------------------------------------------------------
 void Datalink::clearQueues()
 {
+   clearInbox();
    base::Object* msg = inQueue->get();
    while (msg != nullptr) {
       msg->unref();
@@ -508,6 +640,15 @@ bool Datalink::setSlotRadioId(const base::Number* const msg)
    return ok;
 }
 
+bool Datalink::setSlotNetwork(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setNetwork(msg->getInt());
+   }
+   return ok;
+}
+
 bool Datalink::setSlotMaxRange(const base::Distance* const msg)
 {
    bool ok = false;
@@ -9,6 +9,7 @@
 #include "mixr/base/List.hpp"
 #include "mixr/base/PairStream.hpp"
 #include "mixr/base/Pair.hpp"
+#include "mixr/base/Tracer.hpp"
 
 #include "mixr/base/units/Angles.hpp"
 #include "mixr/base/units/Distances.hpp"
@@ -69,6 +70,7 @@ BEGIN_SLOTTABLE(Gimbal)
     "localPlayersOfInterestOnly",   // 34: Sets the local only players of interest flag (default: false)
     "useWorldCoordinates",          // 35: Using player of interest's world (ECEF) coordinate system
     "ownHeadingOnly",               // 36: Whether only the ownship heading is used by the target data block
+    "terrainOccultingTolerance",    // 37: Terrain occulting movement tolerance (default: 0)
 END_SLOTTABLE(Gimbal)
 
 BEGIN_SLOT_MAP(Gimbal)
@@ -120,6 +122,7 @@ BEGIN_SLOT_MAP(Gimbal)
 
     ON_SLOT(35, setSlotUseWorldCoordinates, base::Number)                // Using player of interest's world (ECEF) coordinate system
     ON_SLOT(36,setSlotUseOwnHeadingOnly,base::Number)
+    ON_SLOT(37, setSlotTerrainOccultingTolerance, base::Distance)        // Terrain occulting movement tolerance (default: 0)
 END_SLOT_MAP()
 
 BEGIN_EVENT_HANDLER(Gimbal)
@@ -183,12 +186,14 @@ void Gimbal::copyData(const Gimbal& org, const bool cc)
    localOnly = org.localOnly;
    terrainOcculting = org.terrainOcculting;
    checkHorizon = org.checkHorizon;
+   occultingTol = org.occultingTol;
    useWorld = org.useWorld;
    ownHeadingOnly = org.ownHeadingOnly;
    playerTypes = org.playerTypes;
    maxPlayers = org.maxPlayers;
 
    tdb = nullptr;
+   occultingCache.clear();
 }
 
 void Gimbal::deleteData()
@@ -205,6 +210,7 @@ void Gimbal::reset()
    cmdRate = initCmdRate;
    cmdPos = initCmdPos;
    updateMatrix();
+   occultingCache.clear();
    BaseClass::reset();
 }
 
@@ -223,6 +229,7 @@ bool Gimbal::shutdownNotification()
 //------------------------------------------------------------------------------
 void Gimbal::dynamics(const double dt)
 {
+   MIXR_TRACE_ZONE("Gimbal::dynamics");
    servoController(dt);
    BaseClass::dynamics(dt);
 }
@@ -253,6 +260,34 @@ bool Gimbal::onRfEmissionEvent(Emission* const em)
    return true;
 }
 
+//------------------------------------------------------------------------------
+// onRfEmissions() -- process a batch of RF emissions not sent by us; the same
+// as onRfEmissionEvent() for each emission, so subclasses that override
+// onRfEmissionEvent() should override this too.
+//------------------------------------------------------------------------------
+bool Gimbal::onRfEmissions(Emission* const* const ems, const unsigned int n)
+{
+   if (isComponentSelected()) {
+      // Just pass them to our selected subcomponent
+      const auto sc = dynamic_cast<Gimbal*>( getSelectedComponent() );
+      if (sc != nullptr && sc->getPowerSwitch() != System::PWR_OFF) sc->onRfEmissions(ems, n);
+   }
+   else {
+      // Pass them down to all of our subcomponents
+      base::PairStream* subcomponents = getComponents();
+      if (subcomponents != nullptr) {
+         for (base::List::Item* item = subcomponents->getFirstItem(); item != nullptr; item = item->getNext()) {
+            const auto pair = static_cast<base::Pair*>(item->getValue());
+            const auto sc = dynamic_cast<Gimbal*>( pair->object() );
+            if (sc != nullptr && sc->getPowerSwitch() != System::PWR_OFF) sc->onRfEmissions(ems, n);
+         }
+         subcomponents->unref();
+         subcomponents = nullptr;
+      }
+   }
+   return true;
+}
+
 //------------------------------------------------------------------------------
 // Returns true if this is a player of interest
 //------------------------------------------------------------------------------
@@ -539,6 +574,18 @@ bool Gimbal::setHorizonCheckEnabled(const bool flg)
    return true;
 }
 
+// Sets the terrain occulting movement tolerance (meters)
+bool Gimbal::setTerrainOccultingTolerance(const double meters)
+{
+   bool ok = false;
+   if (meters >= 0.0) {
+      occultingTol = meters;
+      occultingCache.clear();
+      ok = true;
+   }
+   return ok;
+}
+
 // Sets the using world coordinates flag
 bool Gimbal::setUseWorld(const bool flg)
 {
@@ -1116,6 +1163,16 @@ bool Gimbal::setSlotCheckHorizon(const base::Number* const msg)
    return ok;
 }
 
+// Terrain occulting movement tolerance (default: 0)
+bool Gimbal::setSlotTerrainOccultingTolerance(const base::Distance* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setTerrainOccultingTolerance( base::Meters::convertStatic(*msg) );
+   }
+   return ok;
+}
+
 // Player of interest types (default: 0 )
 bool Gimbal::setSlotPlayerTypes(const base::PairStream* const msg)
 {
@@ -1322,6 +1379,7 @@ void Gimbal::limitVec(base::Vec3d& vec, const base::Vec3d& ll, const base::Vec3d
 unsigned int Gimbal::processPlayersOfInterest(base::PairStream* const poi)
 {
    const auto tdb0 = new Tdb(maxPlayers, this);
+   tdb0->setOccultingCache(getOccultingCache());
 
    unsigned int ntgts = tdb0->processPlayers(poi);
    setCurrentTdb(tdb0);
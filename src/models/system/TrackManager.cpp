@@ -9,11 +9,13 @@
 #include "mixr/models/player/Player.hpp"
 #include "mixr/models/player/AbstractWeapon.hpp"
 
+#include "mixr/base/Identifier.hpp"
 #include "mixr/base/numeric/Number.hpp"
 
 #include "mixr/base/List.hpp"
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/PairStream.hpp"
+#include "mixr/base/Tracer.hpp"
 #include "mixr/base/units/Times.hpp"
 
 #include "mixr/base/units/Distances.hpp"
@@ -34,6 +36,9 @@ BEGIN_SLOTTABLE(TrackManager)
    "beta",             // 5: Beta
    "gamma",            // 6: Gamma
    "logTrackUpdates",  // 7: whether to log all updates to tracks (default: true)
+   "association",      // 8: Report to track association method
+   "associationGate",  // 9: Nearest neighbor association gate (meters)
+   "reportQueueSize",  // 10: Size of the new report queue
 END_SLOTTABLE(TrackManager)
 
 BEGIN_SLOT_MAP(TrackManager)
@@ -44,11 +49,16 @@ BEGIN_SLOT_MAP(TrackManager)
    ON_SLOT(5, setSlotBeta,  base::Number)
    ON_SLOT(6, setSlotGamma, base::Number)
    ON_SLOT(7, setSlotLogTrackUpdates, base::Number)
+   ON_SLOT(8, setSlotAssociation, base::Identifier)
+   ON_SLOT(9, setSlotAssociationGate, base::Number)
+   ON_SLOT(10, setSlotReportQueueSize, base::Number)
 END_SLOT_MAP()
 
 TrackManager::TrackManager()
 {
    STANDARD_CONSTRUCTOR()
+   setMaxTracks(maxTrks);
+   setReportQueueSize(MAX_TRKS);
 }
 
 TrackManager::TrackManager(const TrackManager& org)
@@ -60,6 +70,23 @@ TrackManager::TrackManager(const TrackManager& org)
 TrackManager::~TrackManager()
 {
    STANDARD_DESTRUCTOR()
+
+   delete[] tracks;
+   tracks = nullptr;
+
+   delete rptQueue;
+   rptQueue = nullptr;
+
+   delete[] rptEmissions;
+   delete[] rptSignal;
+   delete[] rptRdot;
+   delete[] rptPos;
+
+   delete[] trkU;
+   delete[] trkAge;
+   delete[] trkHaveU;
+
+   delete[] trkEvents;
 }
 
 TrackManager& TrackManager::operator=(const TrackManager& org)
@@ -79,9 +106,13 @@ void TrackManager::copyData(const TrackManager& org, const bool)
 
    logTrackUpdates = org.logTrackUpdates;
 
-   maxTrks = org.maxTrks;
-   maxTrackAge = org.maxTrackAge;
    clearTracksAndQueues();
+   setMaxTracks(org.maxTrks);
+   setReportQueueSize(org.getReportQueueSize());
+   maxTrackAge = org.maxTrackAge;
+
+   association = org.association;
+   associationGate = org.associationGate;
 
    type = org.type;
    firstTrkId = org.firstTrkId;
@@ -113,12 +144,7 @@ void TrackManager::clearTracksAndQueues()
    // ---
    // Clear out the queue(s)
    // ---
-   base::lock(queueLock);
-   for (Emission* em = emQueue.get(); em != nullptr; em = emQueue.get()) {
-      em->unref();    // unref() the emission
-      snQueue.get();  // and every emission had a S/N value
-   }
-   base::unlock(queueLock);
+   clearReports();
 
    // ---
    // Clear the track list
@@ -162,6 +188,7 @@ bool TrackManager::shutdownNotification()
 //------------------------------------------------------------------------------
 void TrackManager::process(const double dt)
 {
+   MIXR_TRACE_ZONE("TrackManager::process");
    processTrackList(dt);
    BaseClass::process(dt);
 }
@@ -184,6 +211,167 @@ unsigned int TrackManager::getNumTracks() const
    return nTrks;
 }
 
+//------------------------------------------------------------------------------
+// setMaxTracks() -- Sets the maximum number of tracks, which sizes the track
+// list (not less than the current number of tracks)
+//------------------------------------------------------------------------------
+bool TrackManager::setMaxTracks(const unsigned int n)
+{
+   bool ok = false;
+   if (n > 0) {
+      base::lock(trkListLock);
+      if (n >= nTrks) {
+         if (tracks == nullptr || n != maxTrks) {
+            const auto list = new Track*[n];
+            for (unsigned int i = 0; i < n; i++) {
+               list[i] = (i < nTrks ? tracks[i] : nullptr);
+            }
+            delete[] tracks;
+            tracks = list;
+         }
+         maxTrks = n;
+         ok = true;
+      }
+      base::unlock(trkListLock);
+   }
+   return ok;
+}
+
+TrackAssociator::Method TrackManager::getAssociation() const
+{
+   return association;
+}
+
+double TrackManager::getAssociationGate() const
+{
+   return associationGate;
+}
+
+bool TrackManager::setAssociation(const TrackAssociator::Method m)
+{
+   association = m;
+   return true;
+}
+
+bool TrackManager::setAssociationGate(const double meters)
+{
+   bool ok = false;
+   if (meters > 0.0) {
+      associationGate = meters;
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// reserveReports() -- Grows the per-frame report buffers to at least 'n'
+// reports (keeps their contents)
+//------------------------------------------------------------------------------
+void TrackManager::reserveReports(const unsigned int n)
+{
+   if (n > rptBufSize) {
+      unsigned int size = (rptBufSize > 0 ? rptBufSize * 2 : MAX_REPORTS);
+      while (size < n) size *= 2;
+
+      const auto em = new Emission*[size];
+      const auto sn = new double[size];
+      const auto rdot = new double[size];
+      const auto pos = new base::Vec3d[size];
+      for (unsigned int i = 0; i < rptBufSize; i++) {
+         em[i] = rptEmissions[i];
+         sn[i] = rptSignal[i];
+         rdot[i] = rptRdot[i];
+         pos[i] = rptPos[i];
+      }
+      delete[] rptEmissions;
+      delete[] rptSignal;
+      delete[] rptRdot;
+      delete[] rptPos;
+
+      rptEmissions = em;
+      rptSignal = sn;
+      rptRdot = rdot;
+      rptPos = pos;
+      rptBufSize = size;
+   }
+}
+
+//------------------------------------------------------------------------------
+// reserveTrackInputs() -- Grows the per-frame track buffers to at least 'n'
+// tracks (contents not kept)
+//------------------------------------------------------------------------------
+void TrackManager::reserveTrackInputs(const unsigned int n)
+{
+   if (n > trkBufSize) {
+      unsigned int size = (trkBufSize > 0 ? trkBufSize * 2 : MAX_TRKS);
+      while (size < n) size *= 2;
+
+      delete[] trkU;
+      delete[] trkAge;
+      delete[] trkHaveU;
+      trkU = new base::Vec3d[size];
+      trkAge = new double[size];
+      trkHaveU = new bool[size];
+      trkBufSize = size;
+   }
+}
+
+//------------------------------------------------------------------------------
+// addTrackEvent() -- Adds a track event to be recorded after the track list
+// is unlocked (see recordTrackEvents())
+//------------------------------------------------------------------------------
+void TrackManager::addTrackEvent(const unsigned int event, Track* const trk, const unsigned int idx)
+{
+   if (nTrkEvents >= maxTrkEvents) {
+      const unsigned int size = (maxTrkEvents > 0 ? maxTrkEvents * 2 : MAX_TRKS);
+      const auto events = new TrackEvent[size];
+      for (unsigned int i = 0; i < nTrkEvents; i++) {
+         events[i] = trkEvents[i];
+      }
+      delete[] trkEvents;
+      trkEvents = events;
+      maxTrkEvents = size;
+   }
+
+   trk->ref();
+   trkEvents[nTrkEvents].event = event;
+   trkEvents[nTrkEvents].trk = trk;
+   trkEvents[nTrkEvents].idx = idx;
+   nTrkEvents++;
+}
+
+//------------------------------------------------------------------------------
+// recordTrackEvents() -- Records (and logs) this frame's track events, and
+// frees their tracks; the track list must not be locked, so the data recorder
+// and the log don't hold up the other users of the track list.
+//------------------------------------------------------------------------------
+void TrackManager::recordTrackEvents(const Player* const ownship, const char* const kind, const bool clearType)
+{
+   for (unsigned int i = 0; i < nTrkEvents; i++) {
+      Track* const trk = trkEvents[i].trk;
+
+      // Object 1: player, Object 2: Track Data
+      BEGIN_RECORD_DATA_SAMPLE( getWorldModel()->getDataRecorder(), trkEvents[i].event )
+         SAMPLE_2_OBJECTS( ownship, trk )
+      END_RECORD_DATA_SAMPLE()
+
+      if (isMessageEnabled(MSG_INFO)) {
+         if (trkEvents[i].event == REID_NEW_TRACK) {
+            std::cout << "New " << kind << " track[it] = [" << trkEvents[i].idx << "] id = " << trk->getTrackID() << std::endl;
+         }
+         else if (trkEvents[i].event == REID_TRACK_REMOVED) {
+            std::cout << "Removed Aged " << kind << " track[it] = [" << trkEvents[i].idx << "] id = " << trk->getTrackID() << std::endl;
+         }
+      }
+
+      if (clearType && trkEvents[i].event == REID_TRACK_REMOVED) trk->setType(0);
+
+      trk->unref();
+      trkEvents[i].trk = nullptr;
+   }
+   nTrkEvents = 0;
+}
+
 bool TrackManager::isType(const short t) const
 {
    return ((type & t) != 0);
@@ -310,14 +498,7 @@ void TrackManager::newReport(Emission* em, double sn)
 {
    // Queue up emissions reports
    if (em != nullptr) {
-      base::lock(queueLock);
-      if (emQueue.isNotFull()) {
-      em->ref();
-      emQueue.put(em);
-      snQueue.put(sn);
-      }
-      base::unlock(queueLock);
-
+      putReport(em, sn);
    }
 }
 
@@ -328,16 +509,98 @@ Emission* TrackManager::getReport(double* const sn)
 {
    Emission* em = nullptr;
 
-   base::lock(queueLock);
-   em = emQueue.get();
-   if (em != nullptr) {
-      *sn = snQueue.get();
+   Report rpt;
+   if (getReports(&rpt, 1) > 0) {
+      em = static_cast<Emission*>(rpt.msg);   // (we queue only emissions)
+      *sn = rpt.sn;
    }
-   base::unlock(queueLock);
 
    return em;
 }
 
+//------------------------------------------------------------------------------
+// putReport() -- Queue a new report (any thread); the report is ref()'d,
+// or dropped if the queue is full
+//------------------------------------------------------------------------------
+bool TrackManager::putReport(SensorMsg* const msg, const double sn)
+{
+   bool ok = false;
+   if (rptQueue != nullptr) {
+      msg->ref();
+      Report rpt;
+      rpt.msg = msg;
+      rpt.sn = sn;
+      ok = rptQueue->put(rpt);
+      if (!ok) msg->unref();
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// getReports() -- Get up to 'max' new reports from the queue; returns the
+// number of reports, which the caller needs to unref()
+//------------------------------------------------------------------------------
+unsigned int TrackManager::getReports(Report* const list, const unsigned int max)
+{
+   unsigned int n = 0;
+   if (rptQueue != nullptr) {
+      base::lock(drainLock);
+      n = rptQueue->get(list, max);
+      base::unlock(drainLock);
+   }
+   return n;
+}
+
+//------------------------------------------------------------------------------
+// clearReports() -- Clear (unref()) the queued reports
+//------------------------------------------------------------------------------
+void TrackManager::clearReports()
+{
+   Report list[REPORT_BATCH];
+   for (unsigned int n = getReports(list, REPORT_BATCH); n > 0; n = getReports(list, REPORT_BATCH)) {
+      for (unsigned int i = 0; i < n; i++) {
+         list[i].msg->unref();
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Report queue size and statistics
+//------------------------------------------------------------------------------
+unsigned int TrackManager::getReportQueueSize() const
+{
+   return (rptQueue != nullptr ? rptQueue->getSize() : 0);
+}
+
+unsigned long TrackManager::getReportQueueContentions() const
+{
+   return (rptQueue != nullptr ? rptQueue->getNumContentions() : 0);
+}
+
+unsigned long TrackManager::getReportQueueFull() const
+{
+   return (rptQueue != nullptr ? rptQueue->getNumFull() : 0);
+}
+
+//------------------------------------------------------------------------------
+// setReportQueueSize() -- Sets the size of the new report queue (rounded up
+// to a power of two); any queued reports are cleared.  Not while the sensors
+// are queuing reports (i.e., set before the simulation starts).
+//------------------------------------------------------------------------------
+bool TrackManager::setReportQueueSize(const unsigned int n)
+{
+   bool ok = false;
+   if (n > 0) {
+      clearReports();
+      base::lock(drainLock);
+      delete rptQueue;
+      rptQueue = new base::mpsc_queue<Report>(n);
+      base::unlock(drainLock);
+      ok = true;
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // addTrack() -- Add a track to the list
 //------------------------------------------------------------------------------
@@ -346,7 +609,7 @@ bool TrackManager::addTrack(Track* const t)
    bool ok = false;
 
    base::lock(trkListLock);
-   if (nTrks < maxTrks) {
+   if (nTrks < maxTrks && tracks != nullptr) {
       t->ref();
       tracks[nTrks++] = t;
       ok = true;
@@ -388,12 +651,11 @@ bool TrackManager::setSlotMaxTracks(const base::Number* const num)
    bool ok = false;
    if (num != nullptr) {
       int max = num->getInt();
-      if (max > 0 && max <= static_cast<int>(MAX_TRKS)) {
-         maxTrks = static_cast<unsigned int>(max);
-         ok = true;
+      if (max > 0) {
+         ok = setMaxTracks( static_cast<unsigned int>(max) );
       }
-      else {
-         std::cerr << "TrackManager::setMaxTracks: maxTracks is invalid, range: [1 .. " << MAX_TRKS << "]" << std::endl;
+      if (!ok) {
+         std::cerr << "TrackManager::setMaxTracks: maxTracks is invalid" << std::endl;
       }
    }
    return ok;
@@ -508,6 +770,68 @@ bool TrackManager::setLogTrackUpdates (const bool b)
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Sets the report to track association method
+//------------------------------------------------------------------------------
+bool TrackManager::setSlotAssociation(const base::Identifier* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      if (*msg == "target") {
+         ok = setAssociation( TrackAssociator::TARGET );
+      }
+      else if (*msg == "nearestNeighbor") {
+         ok = setAssociation( TrackAssociator::NEAREST_NEIGHBOR );
+      }
+      else if (*msg == "globalNearestNeighbor") {
+         ok = setAssociation( TrackAssociator::GLOBAL_NEAREST_NEIGHBOR );
+      }
+      else {
+         std::cerr << "TrackManager::setSlotAssociation: Invalid method; use target, nearestNeighbor or globalNearestNeighbor" << std::endl;
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Sets the nearest neighbor association gate
+//------------------------------------------------------------------------------
+bool TrackManager::setSlotReportQueueSize(const base::Number* const num)
+{
+   bool ok = false;
+   if (num != nullptr) {
+      const int size = num->getInt();
+      if (size > 0) {
+         ok = setReportQueueSize( static_cast<unsigned int>(size) );
+      }
+      if (!ok) {
+         std::cerr << "TrackManager::setSlotReportQueueSize: reportQueueSize is invalid, must be greater than zero" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool TrackManager::setSlotAssociationGate(const base::Number* const num)
+{
+   double value = 0.0;
+   const auto p = dynamic_cast<const base::Distance*>(num);
+   if (p != nullptr) {
+      // We have a distance and we want it in meters ...
+      base::Meters meters;
+      value = meters.convert(*p);
+   }
+   else if (num != nullptr) {
+      // We have only a number, assume it's in meters ...
+      value = num->getReal();
+   }
+
+   const bool ok = setAssociationGate(value);
+   if (!ok) {
+      std::cerr << "TrackManager::setSlotAssociationGate: invalid gate, must be greater than zero." << std::endl;
+   }
+   return ok;
+}
+
 
 //==============================================================================
 // Class: AirTrkMgr
@@ -526,6 +850,8 @@ BEGIN_SLOT_MAP(AirTrkMgr)
    ON_SLOT(3, setVelocityGate, base::Number)
 END_SLOT_MAP()
 
+EMPTY_DELETEDATA(AirTrkMgr)
+
 AirTrkMgr::AirTrkMgr()
 {
    STANDARD_CONSTRUCTOR()
@@ -536,20 +862,6 @@ AirTrkMgr::AirTrkMgr()
 void AirTrkMgr::initData()
 {
    setType( Track::ONBOARD_SENSOR_BIT | Track::AIR_TRACK_BIT );
-
-   reportNumMatches = new unsigned int[MAX_REPORTS];
-   trackNumMatches = new unsigned int[MAX_TRKS];
-   report2TrackMatch = new bool*[MAX_REPORTS];
-   for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-      reportNumMatches[i] = 0;
-      report2TrackMatch[i] = new bool[MAX_TRKS];
-      for (unsigned int j = 0; j < MAX_TRKS; j++) {
-         report2TrackMatch[i][j] = false;
-      }
-   }
-   for (unsigned int i = 0; i < MAX_TRKS; i++) {
-      trackNumMatches[i] = 0;
-   }
 }
 
 void AirTrkMgr::copyData(const AirTrkMgr& org, const bool cc)
@@ -560,40 +872,6 @@ void AirTrkMgr::copyData(const AirTrkMgr& org, const bool cc)
    posGate = org.posGate;
    rngGate = org.rngGate;
    velGate = org.velGate;
-
-   for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-      reportNumMatches[i] = org.reportNumMatches[i];
-      for (unsigned int j = 0; j < MAX_TRKS; j++) {
-         report2TrackMatch[i][j] = org.report2TrackMatch[i][j];
-      }
-   }
-   for (unsigned int i = 0; i < MAX_TRKS; i++) {
-      trackNumMatches[i] = org.trackNumMatches[i];
-   }
-}
-
-void AirTrkMgr::deleteData()
-{
-   if (report2TrackMatch != nullptr) {
-      for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-         if (report2TrackMatch[i] != nullptr) {
-            delete[] report2TrackMatch[i];
-            report2TrackMatch[i] = nullptr;
-         }
-      }
-      delete[] report2TrackMatch;
-      report2TrackMatch = nullptr;
-   }
-
-   if (reportNumMatches != nullptr) {
-      delete[] reportNumMatches;
-      reportNumMatches = nullptr;
-   }
-
-   if (trackNumMatches != nullptr) {
-      delete[] trackNumMatches;
-      trackNumMatches = nullptr;
-   }
 }
 
 //------------------------------------------------------------------------------
@@ -611,6 +889,9 @@ void AirTrkMgr::processTrackList(const double dt)
    // Make sure we have the A and B matrix
    if (!haveMatrixA) makeMatrixA(dt);
 
+   // (the track list is locked once, for steps 1 through 8)
+   base::lock(trkListLock);
+
    // ---
    // 1) Apply ownship dynamics to current track positions and age the tracks by delta time
    // ---
@@ -618,117 +899,91 @@ void AirTrkMgr::processTrackList(const double dt)
    base::Vec3d osAccel = ownship->getAcceleration();
    const double osGndTrk = ownship->getGroundTrack();
 
-   base::lock(trkListLock);
    for (unsigned int i = 0; i < nTrks; i++) {
       tracks[i]->ownshipDynamics(osGndTrk, osVel, osAccel, dt);
       tracks[i]->updateTrackAge(dt);
    }
-   base::unlock(trkListLock);
 
    // ---
    // 2) Process new reports
    // ---
 
-   // Get each new emission report from the queue
+   // Get the new emission reports from the queue, a batch at a time
    unsigned int nReports = 0;
-   Emission* emissions[MAX_REPORTS];
-   double newSignal[MAX_REPORTS];
-   double newRdot[MAX_REPORTS];
-   base::Vec3d tgtPos[MAX_REPORTS];
-   double tmp =0.0;
-   for (Emission* em = getReport(&tmp); em != nullptr; em = getReport(&tmp)) {
-
-      if (nReports < MAX_REPORTS) {
+   Report batch[REPORT_BATCH];
+   for (unsigned int n = getReports(batch, REPORT_BATCH); n > 0; n = getReports(batch, REPORT_BATCH)) {
+      reserveReports(nReports + n);
+      for (unsigned int k = 0; k < n; k++) {
+         const auto em = static_cast<Emission*>(batch[k].msg);   // (we queue only emissions)
 
-      Player* tgt = em->getTarget();
+         Player* tgt = em->getTarget();
 
-      bool dummy = false;
-      if (tgt->isMajorType(Player::WEAPON)) {
-         dummy = (static_cast<const AbstractWeapon*>(tgt))->isDummy();
-      }
+         bool dummy = false;
+         if (tgt->isMajorType(Player::WEAPON)) {
+            dummy = (static_cast<const AbstractWeapon*>(tgt))->isDummy();
+         }
 
-      if ( tgt->isMajorType(Player::AIR_VEHICLE) ||
-         tgt->isMajorType(Player::SHIP) ||
-         (tgt->isMajorType(Player::WEAPON) && !dummy)
-         ) {
-            // Using only air vehicles
-            emissions[nReports] = em;
-            newSignal[nReports] = tmp;
-            newRdot[nReports] = emissions[nReports]->getRangeRate();
-            reportNumMatches[nReports] = 0;
-            tgtPos[nReports] = tgt->getPosition() - ownship->getPosition();
-            nReports++;
-      }
-      else {
-         // Free up emissions from other types of players
-         em->unref();
+         if ( tgt->isMajorType(Player::AIR_VEHICLE) ||
+            tgt->isMajorType(Player::SHIP) ||
+            (tgt->isMajorType(Player::WEAPON) && !dummy)
+            ) {
+               // Using only air vehicles
+               rptEmissions[nReports] = em;
+               rptSignal[nReports] = batch[k].sn;
+               rptRdot[nReports] = em->getRangeRate();
+               rptPos[nReports] = tgt->getPosition() - ownship->getPosition();
+               nReports++;
+         }
+         else {
+            // Free up emissions from other types of players
+            em->unref();
+         }
       }
-   }
-      else {
-         // ignore -- too many reports
-      em->unref();
-   }
    }
 
    // ---
    // 3) Match current tracks to new reports (observations)
    // ---
-   base::lock(trkListLock);
+   associator.begin(nTrks, nReports);
    for (unsigned int it = 0; it < nTrks; it++) {
-      trackNumMatches[it] = 0;
       const RfTrack* const trk = static_cast<const RfTrack*>(tracks[it]);  // we produce only RfTracks
-      const Player* const tgt = trk->getLastEmission()->getTarget();
-      for (unsigned int ir = 0; ir < nReports; ir++) {
-         if (emissions[ir]->getTarget() == tgt) {
-            // We have a new report for the same target as this track ...
-            report2TrackMatch[ir][it] = true;
-            trackNumMatches[it]++;
-            reportNumMatches[ir]++;
-         }
-         else report2TrackMatch[ir][it] = false;
-      }
+      associator.setTrack(it, trk->getLastEmission()->getTarget(), trk->getPosition());
+   }
+   for (unsigned int ir = 0; ir < nReports; ir++) {
+      associator.setReport(ir, rptEmissions[ir]->getTarget(), rptPos[ir]);
    }
-   base::unlock(trkListLock);
 
    // ---
    // 4) Apply rules to associate the proper report to track.
    // ---
-
-   // No Rules -- Just Right
+   associator.associate(getAssociation(), getAssociationGate());
 
    // ---
    // 5) Create inputs for current tracks
    // ---
-   base::Vec3d u[MAX_TRKS];
-   double age[MAX_TRKS];
-   bool haveU[MAX_TRKS];
-
-   base::lock(trkListLock);
+   reserveTrackInputs(nTrks);
    for (unsigned int it = 0; it < nTrks; it++) {
-      u[it].set(0,0,0);
-      haveU[it] = false;
-      if (trackNumMatches[it] > 0) {
-         for (unsigned int ir = 0; ir < nReports; ir++) {
-            if (report2TrackMatch[ir][it]) {
-               RfTrack* const trk = static_cast<RfTrack*>(tracks[it]);  // we produce only RfTracks
-
-               // Update the track's signal
-               trk->setSignal(newSignal[ir],emissions[ir]);
-
-               // Create a track input vector
-               u[it] = (tgtPos[ir] - trk->getPosition());
-
-               // Track age and flags
-               if (!haveU[it]) {
-                  age[it] = trk->getTrackAge();
-                  tracks[it]->resetTrackAge();
-                  haveU[it] = true;
-               }
-            }
-         }
+      trkU[it].set(0,0,0);
+      trkHaveU[it] = false;
+   }
+   for (unsigned int i = 0; i < associator.getNumMatches(); i++) {
+      const unsigned int ir = associator.getMatchReport(i);
+      const unsigned int it = associator.getMatchTrack(i);
+      RfTrack* const trk = static_cast<RfTrack*>(tracks[it]);  // we produce only RfTracks
+
+      // Update the track's signal
+      trk->setSignal(rptSignal[ir],rptEmissions[ir]);
+
+      // Create a track input vector
+      trkU[it] = (rptPos[ir] - trk->getPosition());
+
+      // Track age and flags
+      if (!trkHaveU[it]) {
+         trkAge[it] = trk->getTrackAge();
+         trk->resetTrackAge();
+         trkHaveU[it] = true;
       }
    }
-   base::unlock(trkListLock);
 
    // ---
    // 6) Smooth and predict position for the next frame
@@ -739,37 +994,33 @@ void AirTrkMgr::processTrackList(const double dt)
    //      U(k) is the difference between the observed & predicted positions
    // ---
    const double d2 = posGate * posGate;    // position gate squared
-   base::lock(trkListLock);
    for (unsigned int i = 0; i < nTrks; i++) {
       // Save X(k)
       base::Vec3d tpos = tracks[i]->getPosition();
       base::Vec3d tvel = tracks[i]->getVelocity();
       base::Vec3d tacc = tracks[i]->getAcceleration();
 
-      if (haveU[i]) {
+      if (trkHaveU[i]) {
          // Have Input vector U, use ...
          // where B is ...
          double b0 = alpha;
          double b1 = 0.0;
-         if (age[i] != 0) b1 = beta / age[i];
+         if (trkAge[i] != 0) b1 = beta / trkAge[i];
          double b2 = 0.0;
-         //double b2 = gamma * 2.0f / (age[i]*age[i]);
-         if (u[i].length2() > d2) {
+         //double b2 = gamma * 2.0f / (trkAge[i]*trkAge[i]);
+         if (trkU[i].length2() > d2) {
             // Large position change: just set position
             b0 = 1.0;
             b1 = 0.0;
          }
 
          // X(k+1) = A*X(k) + B*U(k)
-         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]) + (u[i]*b0) );
-         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]) + (u[i]*b1) );
-         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]) + (u[i]*b2) );
+         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]) + (trkU[i]*b0) );
+         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]) + (trkU[i]*b1) );
+         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]) + (trkU[i]*b2) );
 
-         // Object 1: player, Object 2: Track Data
          if (getLogTrackUpdates()) {
-            BEGIN_RECORD_DATA_SAMPLE( getWorldModel()->getDataRecorder(), REID_TRACK_DATA )
-               SAMPLE_2_OBJECTS( ownship, tracks[i] )
-            END_RECORD_DATA_SAMPLE()
+            addTrackEvent(REID_TRACK_DATA, tracks[i], i);
          }
 
       }
@@ -781,72 +1032,59 @@ void AirTrkMgr::processTrackList(const double dt)
          tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]));
       }
    }
-   base::unlock(trkListLock);
 
    // ---
    // 7) For tracks with new observation reports, reset their age.
-   //    Remove tracks that have aged beyond the limit.
+   //    Remove tracks that have aged beyond the limit (and move the
+   //    other tracks down in the list, in one pass).
    // ---
-   base::lock(trkListLock);
-   for (unsigned int it = 0; it < nTrks; /* update 'it' below */ ) {
+   unsigned int nKept = 0;
+   for (unsigned int it = 0; it < nTrks; it++) {
       RfTrack* const trk = static_cast<RfTrack*>(tracks[it]);  // we produce only RfTracks
       if (trk->getTrackAge() >= getMaxTrackAge()) {
+         addTrackEvent(REID_TRACK_REMOVED, trk, it);
 
-         // Object 1: player, Object 2: Track Data
-         BEGIN_RECORD_DATA_SAMPLE( getWorldModel()->getDataRecorder(), REID_TRACK_REMOVED )
-            SAMPLE_2_OBJECTS( ownship, tracks[it] )
-         END_RECORD_DATA_SAMPLE()
-
-         if (isMessageEnabled(MSG_INFO)) {
-            std::cout << "Removed Aged AIR track: player: " << trk->getLastEmission()->getTarget() << ", refCnt = " << trk->getLastEmission()->getTarget()->getRefCount() << std::endl;
-         }
-
-         // Track has timed out -- delete the track and ...
-         trk->setType(0);
+         // Track has timed out -- delete the track (its type is cleared once it's recorded)
          trk->unref();
-         nTrks--;
-         // move all other tracks down in the list.
-         for (unsigned int it2 = it; it2 < nTrks; it2++) {
-            tracks[it2] = tracks[it2+1];
-         }
       }
       else {
-         // update track index, it
-         it++;
+         tracks[nKept++] = trk;
       }
    }
-   base::unlock(trkListLock);
+   for (unsigned int it = nKept; it < nTrks; it++) {
+      tracks[it] = nullptr;
+   }
+   nTrks = nKept;
 
    // ---
    // 8) Create new tracks from unmatched reports and free up emissions
    // ---
-   base::lock(trkListLock);
    for (unsigned int i = 0; i < nReports; i++) {
-      if ((reportNumMatches[i] == 0) && (nTrks < maxTrks)) {
+      if ((associator.getReportNumMatches(i) == 0) && (nTrks < maxTrks)) {
          // This is a new report, so create a new track for it
          const auto newTrk = new RfTrack();
          newTrk->setTrackID( getNewTrackID() );
-         newTrk->setTarget( emissions[i]->getTarget() );
+         newTrk->setTarget( rptEmissions[i]->getTarget() );
          newTrk->setType(Track::AIR_TRACK_BIT | Track::ONBOARD_SENSOR_BIT);
-         newTrk->setPosition(tgtPos[i]);
+         newTrk->setPosition(rptPos[i]);
          newTrk->ownshipDynamics(osGndTrk, osVel, osAccel, 0.0);
-         newTrk->setRangeRate(newRdot[i]);
-         newTrk->setSignal(newSignal[i],emissions[i]);
+         newTrk->setRangeRate(rptRdot[i]);
+         newTrk->setSignal(rptSignal[i],rptEmissions[i]);
 
-         if (isMessageEnabled(MSG_INFO)) {
-            std::cout << "New AIR track[it] = [" << nTrks << "] id = " << newTrk->getTrackID() << std::endl;
-         }
-
-         BEGIN_RECORD_DATA_SAMPLE( getWorldModel()->getDataRecorder(), REID_NEW_TRACK )
-            SAMPLE_2_OBJECTS( ownship, tracks[i] )
-         END_RECORD_DATA_SAMPLE()
+         addTrackEvent(REID_NEW_TRACK, newTrk, nTrks);
 
          tracks[nTrks++] = newTrk;
       }
       // Free the emission report
-      emissions[i]->unref();
+      rptEmissions[i]->unref();
+      rptEmissions[i] = nullptr;
    }
+
    base::unlock(trkListLock);
+
+   // Record (and log) the new, updated and removed tracks, now that the
+   // track list is unlocked
+   recordTrackEvents(ownship, "AIR", true);
 }
 
 //------------------------------------------------------------------------------
@@ -936,6 +1174,7 @@ bool AirTrkMgr::setVelocityGate(const base::Number* const num)
 //==============================================================================
 IMPLEMENT_SUBCLASS(GmtiTrkMgr, "GmtiTrkMgr")
 EMPTY_SLOTTABLE(GmtiTrkMgr)
+EMPTY_DELETEDATA(GmtiTrkMgr)
 
 GmtiTrkMgr::GmtiTrkMgr()
 {
@@ -946,60 +1185,12 @@ GmtiTrkMgr::GmtiTrkMgr()
 void GmtiTrkMgr::initData()
 {
    setType( Track::ONBOARD_SENSOR_BIT | Track::GND_TRACK_BIT );
-
-   reportNumMatches = new unsigned int[MAX_REPORTS];
-   trackNumMatches = new unsigned int[MAX_TRKS];
-   report2TrackMatch = new bool*[MAX_REPORTS];
-   for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-      reportNumMatches[i] = 0;
-      report2TrackMatch[i] = new bool[MAX_TRKS];
-      for (unsigned int j = 0; j < MAX_TRKS; j++) {
-         report2TrackMatch[i][j] = false;
-      }
-   }
-   for (unsigned int i = 0; i < MAX_TRKS; i++) {
-      trackNumMatches[i] = 0;
-   }
 }
 
 void GmtiTrkMgr::copyData(const GmtiTrkMgr& org, const bool cc)
 {
    BaseClass::copyData(org);
    if (cc) initData();
-
-   for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-      reportNumMatches[i] = org.reportNumMatches[i];
-      for (unsigned int j = 0; j < MAX_TRKS; j++) {
-         report2TrackMatch[i][j] = org.report2TrackMatch[i][j];
-      }
-   }
-   for (unsigned int i = 0; i < MAX_TRKS; i++) {
-      trackNumMatches[i] = org.trackNumMatches[i];
-   }
-}
-
-void GmtiTrkMgr::deleteData()
-{
-   if (report2TrackMatch != nullptr) {
-      for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-         if (report2TrackMatch[i] != nullptr) {
-            delete[] report2TrackMatch[i];
-            report2TrackMatch[i] = nullptr;
-         }
-      }
-      delete[] report2TrackMatch;
-      report2TrackMatch = nullptr;
-   }
-
-   if (reportNumMatches != nullptr) {
-      delete[] reportNumMatches;
-      reportNumMatches = nullptr;
-   }
-
-   if (trackNumMatches != nullptr) {
-      delete[] trackNumMatches;
-      trackNumMatches = nullptr;
-   }
 }
 
 //------------------------------------------------------------------------------
@@ -1007,8 +1198,6 @@ void GmtiTrkMgr::deleteData()
 //------------------------------------------------------------------------------
 void GmtiTrkMgr::processTrackList(const double dt)
 {
-   double tmp;
-
    // Make sure we have an ownship to work with
    const auto ownship = dynamic_cast<Player*>( findContainerByType(typeid(Player)) );
    if (ownship == nullptr || dt == 0) return;
@@ -1016,111 +1205,90 @@ void GmtiTrkMgr::processTrackList(const double dt)
    // Make sure we have the A and B matrix
    if (!haveMatrixA) makeMatrixA(dt);
 
+   // (the track list is locked once, for steps 1 through 8)
+   base::lock(trkListLock);
+
    // ---
    // 1) Apply ownship dynamics to current track positions and age the tracks by delta time
    // ---
    const base::Vec3d osVel = ownship->getVelocity();
    const base::Vec3d osAccel = ownship->getAcceleration();
    const double osGndTrk = ownship->getGroundTrack();
-   base::lock(trkListLock);
    for (unsigned int i = 0; i < nTrks; i++) {
       tracks[i]->ownshipDynamics(osGndTrk, osVel, osAccel, dt);
       tracks[i]->updateTrackAge(dt);
    }
-   base::unlock(trkListLock);
 
    // ---
    // 2) Process new reports
    // ---
 
-   // Get each new emission report from the queue
+   // Get the new emission reports from the queue, a batch at a time
    unsigned int nReports = 0;
-   Emission* emissions[MAX_REPORTS];
-   double newSignal[MAX_REPORTS];
-   double newRdot[MAX_REPORTS];
-   base::Vec3d tgtPos[MAX_REPORTS];
-   for (Emission* em = getReport(&tmp); em != nullptr; em = getReport(&tmp)) {
-      if (nReports < MAX_REPORTS) {
-      Player* tgt = em->getTarget();
-      if (tgt->isMajorType(Player::GROUND_VEHICLE)) {
-         // Using only Ground vehicles
-         emissions[nReports] = em;
-         newSignal[nReports] = tmp;
-         newRdot[nReports] = emissions[nReports]->getRangeRate();
-         reportNumMatches[nReports] = 0;
-         tgtPos[nReports] = tgt->getPosition() - ownship->getPosition();
-         nReports++;
-      }
-      else {
-         // Free up emissions from other types of players
-         em->unref();
+   Report batch[REPORT_BATCH];
+   for (unsigned int n = getReports(batch, REPORT_BATCH); n > 0; n = getReports(batch, REPORT_BATCH)) {
+      reserveReports(nReports + n);
+      for (unsigned int k = 0; k < n; k++) {
+         const auto em = static_cast<Emission*>(batch[k].msg);   // (we queue only emissions)
+         Player* tgt = em->getTarget();
+         if (tgt->isMajorType(Player::GROUND_VEHICLE)) {
+            // Using only Ground vehicles
+            rptEmissions[nReports] = em;
+            rptSignal[nReports] = batch[k].sn;
+            rptRdot[nReports] = em->getRangeRate();
+            rptPos[nReports] = tgt->getPosition() - ownship->getPosition();
+            nReports++;
+         }
+         else {
+            // Free up emissions from other types of players
+            em->unref();
+         }
       }
-   }
-      else {
-         // ignore -- too many reports
-      em->unref();
-   }
    }
 
    // ---
    // 3) Match current tracks to new reports (observations)
    // ---
-   base::lock(trkListLock);
+   associator.begin(nTrks, nReports);
    for (unsigned int it = 0; it < nTrks; it++) {
-      trackNumMatches[it] = 0;
       const RfTrack* const trk = static_cast<const RfTrack*>(tracks[it]);  // we produce only RfTracks
-      const Player* const tgt = trk->getLastEmission()->getTarget();
-      for (unsigned int ir = 0; ir < nReports; ir++) {
-         if (emissions[ir]->getTarget() == tgt) {
-            // We have a new report for the same target as this track ...
-            report2TrackMatch[ir][it] = true;
-            trackNumMatches[it]++;
-            reportNumMatches[ir]++;
-         }
-         else report2TrackMatch[ir][it] = false;
-      }
+      associator.setTrack(it, trk->getLastEmission()->getTarget(), trk->getPosition());
+   }
+   for (unsigned int ir = 0; ir < nReports; ir++) {
+      associator.setReport(ir, rptEmissions[ir]->getTarget(), rptPos[ir]);
    }
-   base::unlock(trkListLock);
 
    // ---
    // 4) Apply rules to associate the proper report to track.
    // ---
-
-   // No Rules -- Just Right
+   associator.associate(getAssociation(), getAssociationGate());
 
    // ---
    // 5) Create inputs for current tracks
    // ---
-   base::Vec3d u[MAX_TRKS];
-   double age[MAX_TRKS];
-   bool haveU[MAX_TRKS];
-   base::lock(trkListLock);
+   reserveTrackInputs(nTrks);
    for (unsigned int it = 0; it < nTrks; it++) {
-      u[it].set(0,0,0);
-      haveU[it] = false;
-      if (trackNumMatches[it] > 0) {
-         for (unsigned int ir = 0; ir < nReports; ir++) {
-            if (report2TrackMatch[ir][it]) {
-
-               RfTrack* const trk = static_cast<RfTrack*>(tracks[it]);  // we produce only RfTracks
-
-               // Update the track's signal
-               trk->setSignal(newSignal[ir],emissions[ir]);
-
-               // Create a track input vector
-               u[it] = (tgtPos[ir] - trk->getPosition());
-
-               // Track age and flags
-               if (!haveU[it]) {
-                  age[it] = trk->getTrackAge();
-                  tracks[it]->resetTrackAge();
-                  haveU[it] = true;
-               }
-            }
-         }
+      trkU[it].set(0,0,0);
+      trkHaveU[it] = false;
+   }
+   for (unsigned int i = 0; i < associator.getNumMatches(); i++) {
+      const unsigned int ir = associator.getMatchReport(i);
+      const unsigned int it = associator.getMatchTrack(i);
+      RfTrack* const trk = static_cast<RfTrack*>(tracks[it]);  // we produce only RfTracks
+
+      // Update the track's signal
+      trk->setSignal(rptSignal[ir],rptEmissions[ir]);
+
+      // Create a track input vector
+      trkU[it] = (rptPos[ir] - trk->getPosition());
+
+      // Track age and flags
+      if (!trkHaveU[it]) {
+         trkAge[it] = trk->getTrackAge();
+         trk->resetTrackAge();
+         trkHaveU[it] = true;
       }
    }
-   base::unlock(trkListLock);
 
    // ---
    // 6) Smooth and predict position for the next frame
@@ -1130,31 +1298,27 @@ void GmtiTrkMgr::processTrackList(const double dt)
    //      X(k) is the state vector [ pos vel accel ]
    //      U(k) is the difference between the observed & predicted positions
    // ---
-   base::lock(trkListLock);
    for (unsigned int i = 0; i < nTrks; i++) {
       // Save X(k)
       const base::Vec3d tpos = tracks[i]->getPosition();
       const base::Vec3d tvel = tracks[i]->getVelocity();
       const base::Vec3d tacc = tracks[i]->getAcceleration();
 
-      if (haveU[i]) {
+      if (trkHaveU[i]) {
          // Have Input vector U, use ...
          // X(k+1) = A*X(k) + B*U(k)
          // where B is ...
          double b0 = alpha;
          double b1 = 0.0;
-         if (age[i] != 0) b1 = beta / age[i];
+         if (trkAge[i] != 0) b1 = beta / trkAge[i];
          double b2 = 0.0;
-         //double b2 = gamma * 2.0 / (age[i]*age[i]);
-         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]) + (u[i]*b0) );
-         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]) + (u[i]*b1) );
-         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]) + (u[i]*b2) );
+         //double b2 = gamma * 2.0 / (trkAge[i]*trkAge[i]);
+         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]) + (trkU[i]*b0) );
+         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]) + (trkU[i]*b1) );
+         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]) + (trkU[i]*b2) );
 
          if (getLogTrackUpdates()) {
-            // Object 1: player, Object 2: Track Data
-            BEGIN_RECORD_DATA_SAMPLE( getWorldModel()->getDataRecorder(), REID_TRACK_DATA )
-               SAMPLE_2_OBJECTS( ownship, tracks[i] )
-            END_RECORD_DATA_SAMPLE()
+            addTrackEvent(REID_TRACK_DATA, tracks[i], i);
          }
 
       }
@@ -1166,70 +1330,59 @@ void GmtiTrkMgr::processTrackList(const double dt)
          tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]));
       }
    }
-   base::unlock(trkListLock);
 
    // ---
    // 7) For tracks with new observation reports, reset their age.
-   //    Remove tracks that have aged beyond the limit.
+   //    Remove tracks that have aged beyond the limit (and move the
+   //    other tracks down in the list, in one pass).
    // ---
-   base::lock(trkListLock);
-   for (unsigned int it = 0; it < nTrks; /* update 'it' below */ ) {
-      if (tracks[it]->getTrackAge() >= getMaxTrackAge()) {
-         if (isMessageEnabled(MSG_INFO)) {
-            std::cout << "Removed Aged GND track[it] = [" << it << "] id = " << tracks[it]->getTrackID() << std::endl;
-         }
+   unsigned int nKept = 0;
+   for (unsigned int it = 0; it < nTrks; it++) {
+      Track* const trk = tracks[it];
+      if (trk->getTrackAge() >= getMaxTrackAge()) {
+         addTrackEvent(REID_TRACK_REMOVED, trk, it);
 
-         // Object 1: player, Object 2: Track Data
-         BEGIN_RECORD_DATA_SAMPLE( getWorldModel()->getDataRecorder(), REID_TRACK_REMOVED )
-            SAMPLE_2_OBJECTS( ownship, tracks[it] )
-         END_RECORD_DATA_SAMPLE()
-
-         // Track has timed out -- delete the track and ...
-         tracks[it]->unref();
-         nTrks--;
-         // move all other tracks down in the list.
-         for (unsigned int it2 = it; it2 < nTrks; it2++) {
-            tracks[it2] = tracks[it2+1];
-         }
+         // Track has timed out -- delete the track
+         trk->unref();
       }
       else {
-         // update track index, it
-         it++;
+         tracks[nKept++] = trk;
       }
    }
-   base::unlock(trkListLock);
+   for (unsigned int it = nKept; it < nTrks; it++) {
+      tracks[it] = nullptr;
+   }
+   nTrks = nKept;
 
    // ---
    // 8) Create new tracks from unmatched reports and free up emissions
    // ---
-   base::lock(trkListLock);
    for (unsigned int i = 0; i < nReports; i++) {
-      if ((reportNumMatches[i] == 0) && (nTrks < maxTrks)) {
+      if ((associator.getReportNumMatches(i) == 0) && (nTrks < maxTrks)) {
          // This is a new report, so create a new track for it
          RfTrack* newTrk = new RfTrack();
          newTrk->setTrackID( getNewTrackID() );
-         newTrk->setTarget( emissions[i]->getTarget() );
+         newTrk->setTarget( rptEmissions[i]->getTarget() );
          newTrk->setType(Track::GND_TRACK_BIT | Track::ONBOARD_SENSOR_BIT);
-         newTrk->setPosition(tgtPos[i]);
+         newTrk->setPosition(rptPos[i]);
          newTrk->ownshipDynamics(osGndTrk, osVel, osAccel, 0.0);
-         newTrk->setRangeRate(newRdot[i]);
-         newTrk->setSignal(newSignal[i], emissions[i]);
+         newTrk->setRangeRate(rptRdot[i]);
+         newTrk->setSignal(rptSignal[i], rptEmissions[i]);
 
-         if (isMessageEnabled(MSG_INFO)) {
-            std::cout << "New GND track[it] = [" << nTrks << "] id = " << newTrk->getTrackID() << std::endl;
-         }
-
-         // Object 1: player, Object 2: Track Data
-         BEGIN_RECORD_DATA_SAMPLE( getWorldModel()->getDataRecorder(), REID_NEW_TRACK )
-            SAMPLE_2_OBJECTS( ownship, newTrk )
-         END_RECORD_DATA_SAMPLE()
+         addTrackEvent(REID_NEW_TRACK, newTrk, nTrks);
 
          tracks[nTrks++] = newTrk;
       }
       // Free the emission report
-      emissions[i]->unref();
+      rptEmissions[i]->unref();
+      rptEmissions[i] = nullptr;
    }
+
    base::unlock(trkListLock);
+
+   // Record (and log) the new, updated and removed tracks, now that the
+   // track list is unlocked
+   recordTrackEvents(ownship, "GND");
 }
 
 
@@ -1238,6 +1391,7 @@ void GmtiTrkMgr::processTrackList(const double dt)
 //==============================================================================
 IMPLEMENT_SUBCLASS(RwrTrkMgr, "RwrTrkMgr")
 EMPTY_SLOTTABLE(RwrTrkMgr)
+EMPTY_DELETEDATA(RwrTrkMgr)
 
 RwrTrkMgr::RwrTrkMgr()
 {
@@ -1249,60 +1403,12 @@ RwrTrkMgr::RwrTrkMgr()
 void RwrTrkMgr::initData()
 {
    setType( Track::ONBOARD_SENSOR_BIT | Track::RWR_TRACK_BIT );
-
-   reportNumMatches = new unsigned int[MAX_REPORTS];
-   trackNumMatches = new unsigned int[MAX_TRKS];
-   report2TrackMatch = new bool*[MAX_REPORTS];
-   for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-      reportNumMatches[i] = 0;
-      report2TrackMatch[i] = new bool[MAX_TRKS];
-      for (unsigned int j = 0; j < MAX_TRKS; j++) {
-         report2TrackMatch[i][j] = false;
-      }
-   }
-   for (unsigned int i = 0; i < MAX_TRKS; i++) {
-      trackNumMatches[i] = 0;
-   }
 }
 
 void RwrTrkMgr::copyData(const RwrTrkMgr& org, const bool cc)
 {
    BaseClass::copyData(org);
    if (cc) initData();
-
-   for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-      reportNumMatches[i] = org.reportNumMatches[i];
-      for (unsigned int j = 0; j < MAX_TRKS; j++) {
-         report2TrackMatch[i][j] = org.report2TrackMatch[i][j];
-      }
-   }
-   for (unsigned int i = 0; i < MAX_TRKS; i++) {
-      trackNumMatches[i] = org.trackNumMatches[i];
-   }
-}
-
-void RwrTrkMgr::deleteData()
-{
-   if (report2TrackMatch != nullptr) {
-      for (unsigned int i = 0; i < MAX_REPORTS; i++) {
-         if (report2TrackMatch[i] != nullptr) {
-            delete[] report2TrackMatch[i];
-            report2TrackMatch[i] = nullptr;
-         }
-      }
-      delete[] report2TrackMatch;
-      report2TrackMatch = nullptr;
-   }
-
-   if (reportNumMatches != nullptr) {
-      delete[] reportNumMatches;
-      reportNumMatches = nullptr;
-   }
-
-   if (trackNumMatches != nullptr) {
-      delete[] trackNumMatches;
-      trackNumMatches = nullptr;
-   }
 }
 
 //------------------------------------------------------------------------------
@@ -1317,107 +1423,83 @@ void RwrTrkMgr::processTrackList(const double dt)
    // Make sure we have the A and B matrix
    if (!haveMatrixA) makeMatrixA(dt);
 
+   // (the track list is locked once, for steps 1 through 8)
+   base::lock(trkListLock);
+
    // ---
    // 1) Apply ownship dynamics to current track positions and age the tracks by delta time
    // ---
    base::Vec3d osVel = ownship->getVelocity();
    base::Vec3d osAccel = ownship->getAcceleration();
    double osGndTrk = ownship->getGroundTrack();
-   base::lock(trkListLock);
    for (unsigned int i = 0; i < nTrks; i++) {
       tracks[i]->ownshipDynamics(osGndTrk, osVel, osAccel, dt);
       tracks[i]->updateTrackAge(dt);
    }
-   base::unlock(trkListLock);
 
    // ---
    // 2) Process new reports
    // ---
 
-   // Get each new emission report from the queue
-   unsigned int nReports {};
-   Emission* emissions[MAX_REPORTS];
-   double newSignal[MAX_REPORTS];
-   double newRdot[MAX_REPORTS];
-   base::Vec3d tgtPos[MAX_REPORTS];
-   double tmp = 0.0;
-   for (Emission* em = getReport(&tmp); em != nullptr; em = getReport(&tmp)) {
-      if (nReports < MAX_REPORTS) {
+   // Get the new emission reports from the queue, a batch at a time
+   unsigned int nReports = 0;
+   Report batch[REPORT_BATCH];
+   for (unsigned int n = getReports(batch, REPORT_BATCH); n > 0; n = getReports(batch, REPORT_BATCH)) {
+      reserveReports(nReports + n);
+      for (unsigned int k = 0; k < n; k++) {
          // save the report
-      Player* tgt = em->getOwnship();  // The emissions ownship is our target!
-      emissions[nReports] = em;
-      newSignal[nReports] = tmp;
-      newRdot[nReports] = emissions[nReports]->getRangeRate();
-      reportNumMatches[nReports] = 0;
-      tgtPos[nReports] = tgt->getPosition() - ownship->getPosition();
-      nReports++;
-   }
-      else {
-         // ignore -- too many reports
-      em->unref();
+         const auto em = static_cast<Emission*>(batch[k].msg);   // (we queue only emissions)
+         Player* tgt = em->getOwnship();  // The emissions ownship is our target!
+         rptEmissions[nReports] = em;
+         rptSignal[nReports] = batch[k].sn;
+         rptRdot[nReports] = em->getRangeRate();
+         rptPos[nReports] = tgt->getPosition() - ownship->getPosition();
+         nReports++;
       }
    }
 
    // ---
    // 3) Match current tracks to new reports (observations)
    // ---
-   base::lock(trkListLock);
+   associator.begin(nTrks, nReports);
    for (unsigned int it = 0; it < nTrks; it++) {
-      trackNumMatches[it] = 0;
       const RfTrack* const trk = static_cast<const RfTrack*>(tracks[it]);        // we produce only RfTracks
-      const Player* const tgt = trk->getLastEmission()->getOwnship();            // The emissions ownship is our target!
-      for (unsigned int ir = 0; ir < nReports; ir++) {
-         if (emissions[ir]->getOwnship() == tgt) {  // The emissions ownship is our target!
-            // We have a new report for the same target as this track ...
-            report2TrackMatch[ir][it] = true;
-            trackNumMatches[it]++;
-            reportNumMatches[ir]++;
-         }
-         else report2TrackMatch[ir][it] = false;
-      }
+      associator.setTrack(it, trk->getLastEmission()->getOwnship(), trk->getPosition());  // The emissions ownship is our target!
+   }
+   for (unsigned int ir = 0; ir < nReports; ir++) {
+      associator.setReport(ir, rptEmissions[ir]->getOwnship(), rptPos[ir]);
    }
-   base::unlock(trkListLock);
 
    // ---
    // 4) Apply rules to associate the proper report to track.
    // ---
-
-   // No Rules -- Just Right
-
+   associator.associate(getAssociation(), getAssociationGate());
 
    // ---
    // 5) Create input vectors for the current tracks
    // ---
-   base::Vec3d u[MAX_TRKS];
-   //double age[MAX_TRKS];
-   bool haveU[MAX_TRKS];
-   base::lock(trkListLock);
+   reserveTrackInputs(nTrks);
    for (unsigned int it = 0; it < nTrks; it++) {
-      u[it].set(0,0,0);
-      haveU[it] = false;
-      if (trackNumMatches[it] > 0) {
-         for (unsigned int ir = 0; ir < nReports; ir++) {
-            if (report2TrackMatch[ir][it]) {
-
-               // Update the track's signal
-               RfTrack* const trk = static_cast<RfTrack*>(tracks[it]);        // we produce only RfTracks
-               trk->setSignal(newSignal[ir],emissions[ir]);
-
-               // Create a track input vector
-               u[it] = (tgtPos[ir] - tracks[it]->getPosition());
-               //base::Vec3d trkPos = tracks[it]->getPosition();
-
-               // Track age and flags
-               if (!haveU[it]) {
-                  //age[it] = trk->getTrackAge();
-                  tracks[it]->resetTrackAge();
-                  haveU[it] = true;
-               }
-            }
-         }
+      trkU[it].set(0,0,0);
+      trkHaveU[it] = false;
+   }
+   for (unsigned int i = 0; i < associator.getNumMatches(); i++) {
+      const unsigned int ir = associator.getMatchReport(i);
+      const unsigned int it = associator.getMatchTrack(i);
+      RfTrack* const trk = static_cast<RfTrack*>(tracks[it]);  // we produce only RfTracks
+
+      // Update the track's signal
+      trk->setSignal(rptSignal[ir],rptEmissions[ir]);
+
+      // Create a track input vector
+      trkU[it] = (rptPos[ir] - trk->getPosition());
+
+      // Track age and flags
+      if (!trkHaveU[it]) {
+         trk->resetTrackAge();
+         trkHaveU[it] = true;
       }
    }
-   base::unlock(trkListLock);
 
    // ---
    // 6) Smooth and predict position for the next frame
@@ -1427,28 +1509,25 @@ void RwrTrkMgr::processTrackList(const double dt)
    //      X(k) is the state vector [ pos vel accel ]
    //      U(k) is the difference between the observed & predicted positions
    // ---
-   base::lock(trkListLock);
    for (unsigned int i = 0; i < nTrks; i++) {
       // Save X(k)
       base::Vec3d tpos = tracks[i]->getPosition();
       base::Vec3d tvel = tracks[i]->getVelocity();
       base::Vec3d tacc = tracks[i]->getAcceleration();
 
-      if (haveU[i]) {
+      if (trkHaveU[i]) {
          // Have Input vector U, use ...
          // X(k+1) = A*X(k) + B*U(k)
          // where B is ...
          double b0 = alpha;
          double b1 = 0.0;
          double b2 = 0.0;
-         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]) + (u[i]*b0) );
-         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]) + (u[i]*b1) );
-         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]) + (u[i]*b2) );
+         tracks[i]->setPosition(     (tpos*A[0][0] + tvel*A[0][1] + tacc*A[0][2]) + (trkU[i]*b0) );
+         tracks[i]->setVelocity(     (tpos*A[1][0] + tvel*A[1][1] + tacc*A[1][2]) + (trkU[i]*b1) );
+         tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]) + (trkU[i]*b2) );
 
          if (getLogTrackUpdates()) {
-            BEGIN_RECORD_DATA_SAMPLE( getWorldModel()->getDataRecorder(), REID_TRACK_DATA )
-               SAMPLE_2_OBJECTS( ownship, tracks[i] )
-            END_RECORD_DATA_SAMPLE()
+            addTrackEvent(REID_TRACK_DATA, tracks[i], i);
          }
 
       }
@@ -1460,68 +1539,59 @@ void RwrTrkMgr::processTrackList(const double dt)
          tracks[i]->setAcceleration( (tpos*A[2][0] + tvel*A[2][1] + tacc*A[2][2]));
       }
    }
-   base::unlock(trkListLock);
 
    // ---
    // 7) For tracks with new observation reports, reset their age.
-   //    Remove tracks that have aged beyond the limit.
+   //    Remove tracks that have aged beyond the limit (and move the
+   //    other tracks down in the list, in one pass).
    // ---
-   base::lock(trkListLock);
-   for (unsigned int it = 0; it < nTrks; /* update 'it' below */ ) {
-      if (tracks[it]->getTrackAge() >= getMaxTrackAge()) {
-         if (isMessageEnabled(MSG_INFO)) {
-            std::cout << "Removed Aged RWR track[it] = [" << it << "] id = " << tracks[it]->getTrackID() << std::endl;
-         }
-
-         BEGIN_RECORD_DATA_SAMPLE( getWorldModel()->getDataRecorder(), REID_TRACK_REMOVED )
-            SAMPLE_2_OBJECTS( ownship, tracks[it] )
-         END_RECORD_DATA_SAMPLE()
+   unsigned int nKept = 0;
+   for (unsigned int it = 0; it < nTrks; it++) {
+      Track* const trk = tracks[it];
+      if (trk->getTrackAge() >= getMaxTrackAge()) {
+         addTrackEvent(REID_TRACK_REMOVED, trk, it);
 
-         // Track has timed out -- delete the track and ...
-         tracks[it]->unref();
-         nTrks--;
-         // move all other tracks down in the list.
-         for (unsigned int it2 = it; it2 < nTrks; it2++) {
-            tracks[it2] = tracks[it2+1];
-         }
+         // Track has timed out -- delete the track
+         trk->unref();
       }
       else {
-         // update track index, it
-         it++;
+         tracks[nKept++] = trk;
       }
    }
-   base::unlock(trkListLock);
+   for (unsigned int it = nKept; it < nTrks; it++) {
+      tracks[it] = nullptr;
+   }
+   nTrks = nKept;
 
    // ---
    // 8) Create new tracks from unmatched reports and free up emissions
    // ---
-   base::lock(trkListLock);
    for (unsigned int i = 0; i < nReports; i++) {
-      if ((reportNumMatches[i] == 0) && (nTrks < maxTrks)) {
+      if ((associator.getReportNumMatches(i) == 0) && (nTrks < maxTrks)) {
          // This is a new report, so create a new track for it
          const auto newTrk = new RfTrack();
          newTrk->setTrackID( getNewTrackID() );
-         newTrk->setTarget( emissions[i]->getOwnship() );  // The emissions ownship is our target!
+         newTrk->setTarget( rptEmissions[i]->getOwnship() );  // The emissions ownship is our target!
          newTrk->setType(Track::RWR_TRACK_BIT  | Track::ONBOARD_SENSOR_BIT);
-         newTrk->setPosition(tgtPos[i]);
+         newTrk->setPosition(rptPos[i]);
          newTrk->ownshipDynamics(osGndTrk, osVel, osAccel, 0.0f);
-         newTrk->setRangeRate(newRdot[i]);
-         newTrk->setSignal(newSignal[i],emissions[i]);
-
-         if (isMessageEnabled(MSG_INFO)) {
-            std::cout << "New RWR track[it] = [" << nTrks << "] id = " << newTrk->getTrackID() << std::endl;
-         }
+         newTrk->setRangeRate(rptRdot[i]);
+         newTrk->setSignal(rptSignal[i],rptEmissions[i]);
 
-         BEGIN_RECORD_DATA_SAMPLE( getWorldModel()->getDataRecorder(), REID_NEW_TRACK )
-            SAMPLE_2_OBJECTS( ownship, newTrk )
-         END_RECORD_DATA_SAMPLE()
+         addTrackEvent(REID_NEW_TRACK, newTrk, nTrks);
 
          tracks[nTrks++] = newTrk;
       }
       // Free the emission report
-      emissions[i]->unref();
+      rptEmissions[i]->unref();
+      rptEmissions[i] = nullptr;
    }
+
    base::unlock(trkListLock);
+
+   // Record (and log) the new, updated and removed tracks, now that the
+   // track list is unlocked
+   recordTrackEvents(ownship, "RWR");
 }
 
 }
@@ -1,6 +1,7 @@
 
 #include "mixr/otw/factory.hpp"
 
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 
 #include "mixr/otw/Otm.hpp"
@@ -15,28 +16,26 @@
 namespace mixr {
 namespace otw {
 
-base::Object* factory(const std::string& name)
-{
-    base::Object* obj {};
+namespace {
 
+const base::FactoryTable::Entry entries[] = {
     // Common Image Generation Interface (CIGI)
-    if ( name == OtwCigiCl::getFactoryName() ) {
-        obj = new OtwCigiCl();
-    }
-    else if ( name == CigiClNetwork::getFactoryName() ) {
-        obj = new CigiClNetwork();
-    }
+    FACTORY_ENTRY(OtwCigiCl),
+    FACTORY_ENTRY(CigiClNetwork),
 
     // PC Visual Driver
-    else if ( name == OtwPC::getFactoryName() ) {
-        obj = new OtwPC();
-    }
+    FACTORY_ENTRY(OtwPC),
 
-    else if ( name == Otm::getFactoryName() ) {
-        obj = new Otm();
-    }
+    FACTORY_ENTRY(Otm),
+};
 
-    return obj;
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+
+}
+
+base::Object* factory(const std::string& name)
+{
+    return table.create(name);
 }
 
 }
@@ -1,5 +1,6 @@
 
 #include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/recorder/DataRecordPool.hpp"
 #include "mixr/recorder/protobuf/DataRecord.pb.h"
 
 namespace mixr {
@@ -18,6 +19,12 @@ DataRecordHandle::DataRecordHandle(pb::DataRecord* const r) : record(r)
    STANDARD_CONSTRUCTOR()
 }
 
+DataRecordHandle::DataRecordHandle(pb::DataRecord* const r, DataRecordPool* const p) : record(r), pool(p)
+{
+   STANDARD_CONSTRUCTOR()
+   if (pool != nullptr) pool->ref();
+}
+
 void DataRecordHandle::copyData(const DataRecordHandle& org, const bool cc)
 {
    BaseClass::copyData(org);
@@ -29,7 +36,12 @@ void DataRecordHandle::copyData(const DataRecordHandle& org, const bool cc)
 
 void DataRecordHandle::deleteData()
 {
-   if (record != nullptr) { delete record;  record = nullptr; }
+   if (record != nullptr) {
+      if (pool != nullptr) pool->put(record);
+      else delete record;
+      record = nullptr;
+   }
+   if (pool != nullptr) { pool->unref(); pool = nullptr; }
 }
 
 }
@@ -0,0 +1,53 @@
+
+#include "mixr/recorder/DataRecordPool.hpp"
+#include "mixr/recorder/protobuf/DataRecord.pb.h"
+
+namespace mixr {
+namespace recorder {
+
+IMPLEMENT_SUBCLASS(DataRecordPool, "DataRecordPool")
+EMPTY_SLOTTABLE(DataRecordPool)
+
+DataRecordPool::DataRecordPool()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void DataRecordPool::copyData(const DataRecordPool& org, const bool)
+{
+   BaseClass::copyData(org);
+   // Don't copy the records
+}
+
+void DataRecordPool::deleteData()
+{
+   pb::DataRecord* record = records.pop();
+   while (record != nullptr) {
+      delete record;
+      record = records.pop();
+   }
+}
+
+//------------------------------------------------------------------------------
+// Returns an empty DataRecord
+//------------------------------------------------------------------------------
+pb::DataRecord* DataRecordPool::get()
+{
+   pb::DataRecord* record = records.pop();
+   if (record == nullptr) record = new pb::DataRecord();
+   return record;
+}
+
+//------------------------------------------------------------------------------
+// Clears the DataRecord and returns it to the pool
+//------------------------------------------------------------------------------
+void DataRecordPool::put(pb::DataRecord* const record)
+{
+   if (record != nullptr) {
+      record->Clear();
+      if (!records.push(record)) delete record;
+   }
+}
+
+}
+}
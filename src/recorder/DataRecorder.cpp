@@ -3,6 +3,7 @@
 
 #include "mixr/recorder/OutputHandler.hpp"
 #include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/recorder/DataRecordPool.hpp"
 #include "mixr/recorder/protobuf/DataRecord.pb.h"
 
 #include "mixr/models/player/AirVehicle.hpp"
@@ -17,6 +18,7 @@
 
 #include "mixr/base/numeric/Number.hpp"
 #include "mixr/base/String.hpp"
+#include "mixr/base/Tracer.hpp"
 #include "mixr/base/util/math_utils.hpp"
 
 #include <cstdio>
@@ -76,11 +78,18 @@ END_RECORDER_HANDLER_TABLE()
 DataRecorder::DataRecorder()
 {
    STANDARD_CONSTRUCTOR()
+   initData();
 }
 
-void DataRecorder::copyData(const DataRecorder& org, const bool)
+void DataRecorder::initData()
+{
+   pool = new DataRecordPool();
+}
+
+void DataRecorder::copyData(const DataRecorder& org, const bool cc)
 {
    BaseClass::copyData(org);
+   if (cc) initData();
 
    {  // clone the original's output handler
       OutputHandler* copy = nullptr;
@@ -102,6 +111,9 @@ void DataRecorder::copyData(const DataRecorder& org, const bool)
 void DataRecorder::deleteData()
 {
    setOutputHandler(nullptr);
+
+   // Records that are still queued hold their own reference to the pool
+   if (pool != nullptr) { pool->unref(); pool = nullptr; }
 }
 
 //------------------------------------------------------------------------------
@@ -109,6 +121,7 @@ void DataRecorder::deleteData()
 //------------------------------------------------------------------------------
 void DataRecorder::processRecords()
 {
+   MIXR_TRACE_ZONE("DataRecorder::processRecords");
    if (outputHandler != nullptr) outputHandler->processQueue();
 }
 
@@ -117,7 +130,7 @@ void DataRecorder::processRecords()
 //------------------------------------------------------------------------------
 bool DataRecorder::processUnhandledId(const unsigned int id)
 {
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // Record the unknown ID
    pb::UnknownIdMsg* unknownIdMsg = msg->mutable_unknown_id_msg();
@@ -141,7 +154,7 @@ void DataRecorder::reset()
 {
    BaseClass::reset();
 
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
    timeStamp(msg);
    msg->set_id( REID_RESET_EVENT );
    sendDataRecord(msg);
@@ -156,7 +169,7 @@ bool DataRecorder::shutdownNotification()
    if (outputHandler != nullptr) {
 
       // Send an end-of-data message
-      const auto msg = new pb::DataRecord();
+      const auto msg = newDataRecord();
       timeStamp(msg);
       msg->set_id( REID_END_OF_DATA );
       sendDataRecord(msg);
@@ -179,7 +192,7 @@ bool DataRecorder::shutdownNotification()
 //------------------------------------------------------------------------------
 bool DataRecorder::recordMarker(const base::Object* objs[4], const double values[4])
 {
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -204,7 +217,7 @@ bool DataRecorder::recordMarker(const base::Object* objs[4], const double values
 //------------------------------------------------------------------------------
 bool DataRecorder::recordAI(const base::Object* objs[4], const double values[4])
 {
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -231,7 +244,7 @@ bool DataRecorder::recordAI(const base::Object* objs[4], const double values[4])
 //------------------------------------------------------------------------------
 bool DataRecorder::recordDI(const base::Object* objs[4], const double values[4])
 {
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -259,7 +272,7 @@ bool DataRecorder::recordNewPlayer(const base::Object* objs[4], const double val
    const auto player = dynamic_cast<const models::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -286,7 +299,7 @@ bool DataRecorder::recordPlayerRemoved(const base::Object* objs[4], const double
    const auto player = dynamic_cast<const models::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -313,7 +326,7 @@ bool DataRecorder::recordPlayerData(const base::Object* objs[4], const double va
    const auto player = dynamic_cast<const models::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -347,7 +360,7 @@ bool DataRecorder::recordPlayerDamaged(const base::Object* objs[4], const double
    const auto player = dynamic_cast<const models::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -374,7 +387,7 @@ bool DataRecorder::recordPlayerCollision(const base::Object* objs[4], const doub
    const auto player = dynamic_cast<const models::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -406,7 +419,7 @@ bool DataRecorder::recordPlayerCrash(const base::Object* objs[4], const double v
    const auto player = dynamic_cast<const models::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -433,7 +446,7 @@ bool DataRecorder::recordPlayerKilled(const base::Object* objs[4], const double
    const auto player = dynamic_cast<const models::Player*>( objs[0] );
    if (player == nullptr) return false;
 
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -466,7 +479,7 @@ bool DataRecorder::recordWeaponReleased(const base::Object* objs[4], const doubl
    const auto wpn = dynamic_cast<const models::Player*>( objs[0] );
    if (wpn == nullptr) return false;
 
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -505,7 +518,7 @@ bool DataRecorder::recordWeaponHung(const base::Object* objs[4], const double va
    const auto wpn = dynamic_cast<const models::Player*>( objs[0] );
    if (wpn == nullptr) return false;
 
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -548,7 +561,7 @@ bool DataRecorder::recordWeaponDetonation(const base::Object* objs[4], const dou
    const unsigned int detType =  static_cast<unsigned int>(values[0]);
    const double missDist = values[1];
 
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -625,7 +638,7 @@ bool DataRecorder::recordGunFired(const base::Object* objs[4], const double valu
    if (shooter == nullptr) return false;
 
    const auto rounds = static_cast<const unsigned int>( values[0] );
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -655,7 +668,7 @@ bool DataRecorder::recordNewTrack(const base::Object* objs[4], const double valu
    if (player == nullptr || newTrack == nullptr) return false;
 
    // message
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -711,7 +724,7 @@ bool DataRecorder::recordTrackRemoved(const base::Object* objs[4], const double
    if (player == nullptr || track == nullptr) return false;
 
    // message
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -744,7 +757,7 @@ bool DataRecorder::recordTrackData(const base::Object* objs[4], const double val
    if (player == nullptr || trackData == nullptr) return false;
 
    // message
-   const auto msg = new pb::DataRecord();
+   const auto msg = newDataRecord();
 
    // DataRecord header
    timeStamp(msg);
@@ -1005,7 +1018,7 @@ void DataRecorder::sendDataRecord(pb::DataRecord* const msg)
          setFirstPass(false);
 
          // create and send File ID
-         const auto msg = new pb::DataRecord();
+         const auto msg = newDataRecord();
 
          // DataRecord header
          timeStamp(msg);
@@ -1026,7 +1039,7 @@ void DataRecorder::sendDataRecord(pb::DataRecord* const msg)
          fileIdMsg->set_year(getYear());
 
          // Create a handle and send the message to be processed
-         const auto h = new DataRecordHandle(msg);
+         const auto h = new DataRecordHandle(msg, pool);
 
          outputHandler->processRecord(h);
          h->unref();
@@ -1034,10 +1047,22 @@ void DataRecorder::sendDataRecord(pb::DataRecord* const msg)
       }
 
       // Create a handle and send the message to be processed
-      const auto h = new DataRecordHandle(msg);
+      const auto h = new DataRecordHandle(msg, pool);
       outputHandler->addToQueue(h);
       h->unref();
    }
+   else if (msg != nullptr) {
+      // No output handler; just return the record to the pool
+      pool->put(msg);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Returns an empty DataRecord from our pool of records
+//------------------------------------------------------------------------------
+pb::DataRecord* DataRecorder::newDataRecord()
+{
+   return pool->get();
 }
 
 //------------------------------------------------------------------------------
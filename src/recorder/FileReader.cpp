@@ -2,6 +2,7 @@
 #include "mixr/recorder/FileReader.hpp"
 #include "mixr/recorder/protobuf/DataRecord.pb.h"
 #include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/base/Identifier.hpp"
 #include "mixr/base/String.hpp"
 #include "mixr/base/util/str_utils.hpp"
 #include "mixr/base/util/system_utils.hpp"
@@ -17,11 +18,13 @@ IMPLEMENT_SUBCLASS(FileReader, "RecorderFileReader")
 BEGIN_SLOTTABLE(FileReader)
     "filename",         // 1) Data file name
     "pathname",         // 2) Path to the data file directory (optional)
+    "framing",          // 3) Record framing: ascii or varint (default: ascii)
 END_SLOTTABLE(FileReader)
 
 BEGIN_SLOT_MAP(FileReader)
-    ON_SLOT( 1, setFilename, base::String)
-    ON_SLOT( 2, setPathName, base::String)
+    ON_SLOT( 1, setFilename,    base::String)
+    ON_SLOT( 2, setPathName,    base::String)
+    ON_SLOT( 3, setSlotFraming, base::Identifier)
 END_SLOT_MAP()
 
 FileReader::FileReader()
@@ -33,6 +36,7 @@ FileReader::FileReader()
 void FileReader::initData()
 {
    ibuf = new char[MAX_INPUT_BUFFER_SIZE];
+   ibufSize = MAX_INPUT_BUFFER_SIZE;
 }
 
 void FileReader::copyData(const FileReader& org, const bool cc)
@@ -48,6 +52,7 @@ void FileReader::copyData(const FileReader& org, const bool cc)
    sin = nullptr;
    setFilename(org.filename);
    setPathName(org.pathname);
+   varintFraming = org.varintFraming;
    fileOpened = false;
    fileFailed = false;
    firstPassFlg = true;
@@ -65,6 +70,7 @@ void FileReader::deleteData()
    setPathName(nullptr);
 
    if (ibuf != nullptr) { delete[] ibuf; ibuf = nullptr; }
+   ibufSize = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -204,24 +210,21 @@ const DataRecordHandle* FileReader::readRecordImp()
       // ---
       // Read the size of the next serialized DataRecord
       // ---
-      char nbuff[8];
-      sin->read(nbuff, 4);
-
-      // Check for error or eof
-      if ( sin->eof() || sin->fail() ) {
+      if ( !readSize(&n) ) {
          fileFailed = sin->fail();
          if (fileFailed && isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
             std::cerr << "FileReader::readRecord() -- error reading data record size" << std::endl;
          }
+         n = 0;
       }
 
-      // Ok then get the size of the message from the buffer
-      else {
-         nbuff[4] = '\0';
-         n = std::atoi(nbuff);
+      // Make sure the record fits in the input buffer
+      if (n > ibufSize) {
+         delete[] ibuf;
+         ibuf = new char[n];
+         ibufSize = n;
       }
 
-
       // ---
       // Read the serialized DataRecord from the file, parse it as a DataRecord
       // and put it into a Handle.
@@ -243,9 +246,8 @@ const DataRecordHandle* FileReader::readRecordImp()
          else {
 
             // Parse the DataRecord
-            std::string wireFormat(ibuf, n);
             auto dataRecord = new pb::DataRecord();
-            bool ok = dataRecord->ParseFromString(wireFormat);
+            bool ok = dataRecord->ParseFromArray(ibuf, static_cast<int>(n));
 
             // Create a handle for the DataRecord (it now has ownership)
             if (ok) {
@@ -254,7 +256,7 @@ const DataRecordHandle* FileReader::readRecordImp()
 
             // parsing error
             else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
-               std::cerr << "FileReader::readRecord() -- ParseFromString() error" << std::endl;
+               std::cerr << "FileReader::readRecord() -- ParseFromArray() error" << std::endl;
                delete dataRecord;
                dataRecord = nullptr;
             }
@@ -268,6 +270,47 @@ const DataRecordHandle* FileReader::readRecordImp()
 }
 
 
+//------------------------------------------------------------------------------
+// Read the size of the next serialized DataRecord; returns false at
+// the end of the file or on a read error
+//------------------------------------------------------------------------------
+bool FileReader::readSize(unsigned int* const n)
+{
+   bool ok = false;
+
+   if (varintFraming) {
+      // Base 128 varint: seven bits per byte, least significant group
+      // first; the high bit is set on all but the last byte
+      unsigned int value = 0;
+      bool done = false;
+      for (unsigned int i = 0; i < 5 && !done; i++) {
+         char c = 0;
+         sin->read(&c, 1);
+         if ( sin->eof() || sin->fail() ) break;
+         const unsigned int b = static_cast<unsigned char>(c);
+         value |= (b & 0x7f) << (7 * i);
+         done = ((b & 0x80) == 0);
+      }
+      if (done) {
+         *n = value;
+         ok = true;
+      }
+   }
+   else {
+      // Four byte ascii string with leading spaces
+      char nbuff[8];
+      sin->read(nbuff, 4);
+      if ( !sin->eof() && !sin->fail() ) {
+         nbuff[4] = '\0';
+         *n = static_cast<unsigned int>(std::atoi(nbuff));
+         ok = true;
+      }
+   }
+
+   return ok;
+}
+
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
@@ -287,5 +330,29 @@ bool FileReader::setPathName(const base::String* const msg)
    return true;
 }
 
+bool FileReader::setVarintFraming(const bool flg)
+{
+   if (isOpen()) return false;
+   varintFraming = flg;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool FileReader::setSlotFraming(const base::Identifier* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      if (*msg == "ascii" || *msg == "ASCII") ok = setVarintFraming(false);
+      else if (*msg == "varint" || *msg == "VARINT") ok = setVarintFraming(true);
+      else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "FileReader::setSlotFraming(): ERROR, invalid framing: " << *msg << "; use ascii or varint" << std::endl;
+      }
+   }
+   return ok;
+}
+
 }
 }
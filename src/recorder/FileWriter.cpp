@@ -2,12 +2,30 @@
 #include "mixr/recorder/FileWriter.hpp"
 #include "mixr/recorder/protobuf/DataRecord.pb.h"
 #include "mixr/recorder/DataRecordHandle.hpp"
+#include "mixr/simulation/AbstractDataRecorder.hpp"
+#include "mixr/simulation/Simulation.hpp"
+#include "mixr/base/Identifier.hpp"
 #include "mixr/base/String.hpp"
+#include "mixr/base/Tracer.hpp"
+#include "mixr/base/numeric/Number.hpp"
 #include "mixr/base/util/str_utils.hpp"
 #include "mixr/base/util/system_utils.hpp"
 
-#include <fstream>
+#include <google/protobuf/io/coded_stream.h>
+
+#if defined(WIN32)
+   #include <io.h>
+   #include <fcntl.h>
+   #include <sys/stat.h>
+#else
+   #include <sys/uio.h>
+   #include <fcntl.h>
+   #include <unistd.h>
+   #include <cerrno>
+#endif
+
 #include <cstring>
+#include <cstdio>
 
 namespace mixr {
 namespace recorder {
@@ -17,11 +35,15 @@ IMPLEMENT_SUBCLASS(FileWriter, "RecorderFileWriter")
 BEGIN_SLOTTABLE(FileWriter)
     "filename",         // 1) Data file name (required)
     "pathname",         // 2) Path to the data file directory (optional)
+    "framing",          // 3) Record framing: ascii or varint (default: ascii)
+    "bufferSize",       // 4) Output buffer size in bytes
 END_SLOTTABLE(FileWriter)
 
 BEGIN_SLOT_MAP(FileWriter)
-    ON_SLOT( 1, setFilename, base::String)
-    ON_SLOT( 2, setPathName, base::String)
+    ON_SLOT( 1, setFilename,       base::String)
+    ON_SLOT( 2, setPathName,       base::String)
+    ON_SLOT( 3, setSlotFraming,    base::Identifier)
+    ON_SLOT( 4, setSlotBufferSize, base::Number)
 END_SLOT_MAP()
 
 FileWriter::FileWriter()
@@ -37,11 +59,14 @@ void FileWriter::copyData(const FileWriter& org, const bool)
    setPathName(org.pathname);
 
    // Need to re-open the file
-   if (sout != nullptr) {
-      if (isOpen()) sout->close();
-      delete sout;
-   }
-   sout = nullptr;
+   if (isOpen()) closeFile();
+   fd = -1;
+   if (obuf != nullptr) { delete[] obuf; obuf = nullptr; }
+   if (rbuf != nullptr) { delete[] rbuf; rbuf = nullptr; }
+   obufSize = org.obufSize;
+   obufLen = 0;
+   rbufSize = 0;
+   varintFraming = org.varintFraming;
    fileOpened = false;
    fileFailed = false;
    eodFlag    = false;
@@ -50,11 +75,9 @@ void FileWriter::copyData(const FileWriter& org, const bool)
 
 void FileWriter::deleteData()
 {
-   if (sout != nullptr) {
-      if (isOpen()) sout->close();
-      delete sout;
-   }
-   sout = nullptr;
+   if (isOpen()) closeFile();
+   if (obuf != nullptr) { delete[] obuf; obuf = nullptr; }
+   if (rbuf != nullptr) { delete[] rbuf; rbuf = nullptr; }
 
    setFilename(nullptr);
    setPathName(nullptr);
@@ -66,6 +89,9 @@ void FileWriter::deleteData()
 //------------------------------------------------------------------------------
 bool FileWriter::shutdownNotification()
 {
+   // Write the rest of the queue
+   stopWriterThread();
+
    // Close the file, if it's still open
    if (isOpen()) closeFile();
 
@@ -80,13 +106,13 @@ bool FileWriter::shutdownNotification()
 // Is the data file open?
 bool FileWriter::isOpen() const
 {
-   return fileOpened && sout != nullptr && sout->is_open();
+   return fileOpened && fd >= 0;
 }
 
 // Did we have an open or write error?
 bool FileWriter::isFailed() const
 {
-   return fileFailed || (sout != nullptr && sout->fail());
+   return fileFailed;
 }
 
 // File name with path and possible version number
@@ -148,6 +174,7 @@ bool FileWriter::openFile()
       }
       nameLength += filename->len();           // add the length of the file name
       nameLength += 4;                         // add characters for possible version number, "_V99"
+      nameLength += 12;                        // add characters for possible replicate ID, "_r0001"
       nameLength += 1;                         // Add one for the null(0) at the end of the string
 
       const auto fullname = new char[nameLength];
@@ -162,6 +189,18 @@ bool FileWriter::openFile()
       }
       base::utStrcat(fullname,nameLength,*filename);
 
+      //---
+      // Ensemble replicates each write to their own file
+      //---
+      {
+         const auto dr = static_cast<const simulation::AbstractDataRecorder*>( findContainerByType(typeid(simulation::AbstractDataRecorder)) );
+         if (dr != nullptr && dr->getSimulation() != nullptr && dr->getSimulation()->getReplicateID() > 0) {
+            char rbuf[16] {};
+            std::sprintf(rbuf, "_r%04u", dr->getSimulation()->getReplicateID());
+            base::utStrcat(fullname, nameLength, rbuf);
+         }
+      }
+
       //---
       // Make sure that it doesn't already exist (we don't want to over write good data).
       //---
@@ -197,20 +236,25 @@ bool FileWriter::openFile()
          setFullFilename(fullname);
 
          //---
-         // Make sure we have an output stream
+         // Make sure we have an output buffer
          //---
-         if (sout == nullptr) sout = new std::ofstream();
+         if (obuf == nullptr) obuf = new char[obufSize];
+         obufLen = 0;
 
          //---
          // Open the file (binary output mode)
          //---
-         sout->open(fullname, std::ios_base::out | std::ios_base::binary );
+#if defined(WIN32)
+         fd = _open(fullname, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+         fd = ::open(fullname, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
 
          if (isMessageEnabled(MSG_INFO)) {
             std::cout << "FileWriter::openFile() Opening data file = " << fullname << std::endl;
          }
 
-         if (sout->fail()) {
+         if (fd < 0) {
             if (isMessageEnabled(MSG_ERROR)) {
                std::cerr << "FileWriter::openFile(): Failed to open data file: " << fullname << std::endl;
             }
@@ -263,8 +307,14 @@ void FileWriter::closeFile()
          handle = nullptr;
       }
 
-      // now close the file
-      sout->close();
+      // now write the rest of the buffer and close the file
+      flushOutput();
+#if defined(WIN32)
+      _close(fd);
+#else
+      ::close(fd);
+#endif
+      fd = -1;
       fileOpened = false;
       fileFailed = false;
 
@@ -293,39 +343,53 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
       // The DataRecord to be sent
       const pb::DataRecord* dataRecord = handle->getRecord();
 
-      // Serialize the DataRecord
-      std::string wireFormat;
-      bool ok = dataRecord->SerializeToString(&wireFormat);
-
-      // Write the serialized DataRecord with its length to the file
-      if (ok) {
-         unsigned int n = wireFormat.length();
-
-         // Convert size to an integer string
-         char nbuff[8];
-         std::sprintf(nbuff, "%04d", n);
-
-         // Convert the leading zeros to spaces
-         if (nbuff[0] == '0') {
-            nbuff[0] = ' ';
-            if (nbuff[1] == '0') {
-               nbuff[1] = ' ';
-               if (nbuff[2] == '0') {
-                  nbuff[2] = ' ';
-               }
-            }
-         }
-
-         // Write the size of the serialized DataRecord as an ascii string
-         sout->write(nbuff, 4);
-
-         // Write the serialized DataRecord
-         sout->write( wireFormat.c_str(), n );
+      // Size of the serialized DataRecord (also caches the sizes for the serializer)
+#if GOOGLE_PROTOBUF_VERSION >= 3001000
+      const unsigned int n = static_cast<unsigned int>(dataRecord->ByteSizeLong());
+#else
+      const unsigned int n = static_cast<unsigned int>(dataRecord->ByteSize());
+#endif
+
+      // Frame header: the size of the serialized DataRecord
+      char hdr[16];
+      unsigned int nh = 0;
+      if (varintFraming) {
+         google::protobuf::uint8* const p = reinterpret_cast<google::protobuf::uint8*>(hdr);
+         nh = static_cast<unsigned int>(google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(n, p) - p);
+      }
+      else if (n <= 9999) {
+         // As an ascii string with leading spaces
+         std::sprintf(hdr, "%4u", n);
+         nh = 4;
       }
-
       else if (isMessageEnabled(MSG_ERROR | MSG_WARNING)) {
-         // If we had an error serializing the DataRecord
-         std::cerr << "FileWriter::processRecordImp() -- SerializeToString() error" << std::endl;
+         std::cerr << "FileWriter::processRecordImp() -- record size (" << n << ") is too large for ascii framing; use varint framing" << std::endl;
+      }
+
+      // Serialize the DataRecord, with its frame header, into the output buffer
+      if (nh > 0) {
+         const unsigned int nt = nh + n;
+         if (nt <= obufSize) {
+            if ((obufLen + nt) > obufSize) flushOutput();
+            std::memcpy(obuf + obufLen, hdr, nh);
+            dataRecord->SerializeWithCachedSizesToArray(reinterpret_cast<google::protobuf::uint8*>(obuf + obufLen + nh));
+            obufLen += nt;
+         }
+         else {
+            // Too large for the buffer, so serialize it separately and
+            // write it along with the buffer
+            if ((obufLen + nh) > obufSize) flushOutput();
+            std::memcpy(obuf + obufLen, hdr, nh);
+            obufLen += nh;
+            if (rbufSize < n) {
+               if (rbuf != nullptr) delete[] rbuf;
+               rbuf = new char[n];
+               rbufSize = n;
+            }
+            dataRecord->SerializeWithCachedSizesToArray(reinterpret_cast<google::protobuf::uint8*>(rbuf));
+            writeData(obuf, obufLen, rbuf, n);
+            obufLen = 0;
+         }
       }
 
       // Check for END_OF_DATA message
@@ -343,6 +407,68 @@ void FileWriter::processRecordImp(const DataRecordHandle* const handle)
 }
 
 
+//------------------------------------------------------------------------------
+// Write the output buffer to the file
+//------------------------------------------------------------------------------
+void FileWriter::flushOutput()
+{
+   MIXR_TRACE_ZONE("FileWriter::flushOutput");
+   if (obufLen > 0 && fd >= 0) {
+      writeData(obuf, obufLen, nullptr, 0);
+   }
+   obufLen = 0;
+
+   BaseClass::flushOutput();
+}
+
+//------------------------------------------------------------------------------
+// Write 'n1' bytes from 'p1' followed by 'n2' bytes from 'p2' to the file
+//------------------------------------------------------------------------------
+bool FileWriter::writeData(const char* const p1, const unsigned int n1, const char* const p2, const unsigned int n2)
+{
+   bool ok = true;
+
+#if defined(WIN32)
+   if (n1 > 0) ok = (_write(fd, p1, n1) == static_cast<int>(n1));
+   if (ok && n2 > 0) ok = (_write(fd, p2, n2) == static_cast<int>(n2));
+#else
+   struct iovec iov[2];
+   int iovcnt = 0;
+   if (n1 > 0) { iov[iovcnt].iov_base = const_cast<char*>(p1); iov[iovcnt].iov_len = n1; iovcnt++; }
+   if (n2 > 0) { iov[iovcnt].iov_base = const_cast<char*>(p2); iov[iovcnt].iov_len = n2; iovcnt++; }
+
+   struct iovec* iop = iov;
+   while (ok && iovcnt > 0) {
+      const ssize_t nw = ::writev(fd, iop, iovcnt);
+      if (nw < 0) {
+         ok = (errno == EINTR);
+      }
+      else {
+         // Skip what's been written (partial writes)
+         std::size_t nr = static_cast<std::size_t>(nw);
+         while (iovcnt > 0 && nr >= iop->iov_len) {
+            nr -= iop->iov_len;
+            iop++;
+            iovcnt--;
+         }
+         if (iovcnt > 0) {
+            iop->iov_base = static_cast<char*>(iop->iov_base) + nr;
+            iop->iov_len -= nr;
+         }
+      }
+   }
+#endif
+
+   if (!ok) {
+      fileFailed = true;
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "FileWriter::writeData(): ERROR, failed to write to data file: " << fullFilename << std::endl;
+      }
+   }
+   return ok;
+}
+
+
 //------------------------------------------------------------------------------
 // Set functions
 //------------------------------------------------------------------------------
@@ -376,5 +502,52 @@ bool FileWriter::setPathName(const base::String* const msg)
    return true;
 }
 
+bool FileWriter::setVarintFraming(const bool flg)
+{
+   if (isOpen()) return false;
+   varintFraming = flg;
+   return true;
+}
+
+bool FileWriter::setBufferSize(const unsigned int n)
+{
+   if (isOpen()) return false;
+   if (obuf != nullptr) { delete[] obuf; obuf = nullptr; }
+   obufSize = (n > MIN_BUFFER_SIZE ? n : MIN_BUFFER_SIZE);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool FileWriter::setSlotFraming(const base::Identifier* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      if (*msg == "ascii" || *msg == "ASCII") ok = setVarintFraming(false);
+      else if (*msg == "varint" || *msg == "VARINT") ok = setVarintFraming(true);
+      else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "FileWriter::setSlotFraming(): ERROR, invalid framing: " << *msg << "; use ascii or varint" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool FileWriter::setSlotBufferSize(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n > 0) {
+         ok = setBufferSize(static_cast<unsigned int>(n));
+      }
+      else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "FileWriter::setSlotBufferSize(): ERROR, buffer size must be greater than zero" << std::endl;
+      }
+   }
+   return ok;
+}
+
 }
 }
@@ -5,12 +5,58 @@
 
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/PairStream.hpp"
+#include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/concurrent/SingleTask.hpp"
+#include "mixr/base/util/system_utils.hpp"
 
 namespace mixr {
 namespace recorder {
 
+//==============================================================================
+// OutputHandler's writer thread
+//==============================================================================
+
+class WriterThread : public base::SingleTask
+{
+   DECLARE_SUBCLASS(WriterThread, base::SingleTask)
+   public: WriterThread(base::Component* const parent, const double priority);
+   private: virtual unsigned long userFunc() override;
+};
+
+IMPLEMENT_SUBCLASS(WriterThread, "RecorderWriterThread")
+EMPTY_SLOTTABLE(WriterThread)
+EMPTY_COPYDATA(WriterThread)
+EMPTY_DELETEDATA(WriterThread)
+
+WriterThread::WriterThread(base::Component* const parent, const double priority): base::SingleTask(parent, priority)
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+unsigned long WriterThread::userFunc()
+{
+   const auto handler = static_cast<OutputHandler*>( getParent() );
+   handler->writerLoop();
+   return 0;
+}
+
+//==============================================================================
+// OutputHandler class
+//==============================================================================
+
 IMPLEMENT_SUBCLASS(OutputHandler, "RecorderOutputHandler")
-EMPTY_SLOTTABLE(OutputHandler)
+
+BEGIN_SLOTTABLE(OutputHandler)
+   "queueSize",         // 1) Max number of queued records, or zero for an unbounded queue
+   "writerThread",      // 2) Process the queue with our own writer thread
+   "writerPriority",    // 3) Writer thread priority
+END_SLOTTABLE(OutputHandler)
+
+BEGIN_SLOT_MAP(OutputHandler)
+   ON_SLOT( 1, setSlotQueueSize,      base::Number)
+   ON_SLOT( 2, setSlotWriterThread,   base::Number)
+   ON_SLOT( 3, setSlotWriterPriority, base::Number)
+END_SLOT_MAP()
 
 OutputHandler::OutputHandler()
 {
@@ -21,18 +67,26 @@ void OutputHandler::copyData(const OutputHandler& org, const bool)
 {
    BaseClass::copyData(org);
 
-   // Don't copy the queue
-   base::lock(semaphore);
-   queue.clear();
-   base::unlock(semaphore);
+   // Don't copy the queue or the writer thread
+   clearQueue();
+   setQueueSize(org.queueSize);
+   writerEnabled = org.writerEnabled;
+   writerPriority = org.writerPriority;
+   numQueued = 0;
+   numDropped = 0;
+   maxDepth = 0;
 }
 
 void OutputHandler::deleteData()
 {
+   // The writer thread holds a reference to us while it's running, so it
+   // has already been stopped
+   if (writer != nullptr) { writer->unref(); writer = nullptr; }
+
    // clear the queue
-   base::lock(semaphore);
-   queue.clear();
-   base::unlock(semaphore);
+   clearQueue();
+   if (ring != nullptr) { delete ring; ring = nullptr; }
+   queueSize = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -40,6 +94,9 @@ void OutputHandler::deleteData()
 //------------------------------------------------------------------------------
 bool OutputHandler::shutdownNotification()
 {
+   // Stop our writer thread and process the rest of the queue
+   stopWriterThread();
+
    // Pass the shutdown notification to our subcomponent recorders
    base::PairStream* subcomponents = getComponents();
    if (subcomponents != nullptr) {
@@ -93,10 +150,26 @@ void OutputHandler::processRecord(const DataRecordHandle* const dataRecord)
 void OutputHandler::addToQueue(const DataRecordHandle* const dataRecord)
 {
    if (dataRecord != nullptr) {
-      base::lock( semaphore );
-      // const cast away to put into the queue
-      queue.put( const_cast<DataRecordHandle*>(static_cast<const DataRecordHandle*>(dataRecord)) );
-      base::unlock( semaphore );
+      if (ring != nullptr) {
+         // Bounded queue: never blocks; drop the record if the queue is full
+         dataRecord->ref();
+         if (ring->put(dataRecord)) {
+            ++numQueued;
+            // Don't wait for the next processQueue() if we're filling up
+            if (ring->entries() >= (queueSize / 2)) wakeWriter();
+         }
+         else {
+            dataRecord->unref();
+            ++numDropped;
+         }
+      }
+      else {
+         base::lock( semaphore );
+         // const cast away to put into the queue
+         queue.put( const_cast<DataRecordHandle*>(static_cast<const DataRecordHandle*>(dataRecord)) );
+         base::unlock( semaphore );
+         ++numQueued;
+      }
    }
 }
 
@@ -106,22 +179,117 @@ void OutputHandler::addToQueue(const DataRecordHandle* const dataRecord)
 //------------------------------------------------------------------------------
 void OutputHandler::processQueue()
 {
-   // Get the first record from the queue
-   base::lock( semaphore );
-   const DataRecordHandle* dataRecord = static_cast<const DataRecordHandle*>(queue.get());
-   base::unlock( semaphore );
+   // Start the writer thread, which will process the queue from now on
+   if (writerEnabled && writer == nullptr && !stopWriter && isNotShutdown()) {
+      writer = new WriterThread(this, writerPriority);
+      if ( !writer->create() ) {
+         writer->unref();
+         writer = nullptr;
+         writerEnabled = false;
+         if (isMessageEnabled(MSG_ERROR)) {
+            std::cerr << "OutputHandler::processQueue(): ERROR, failed to create the writer thread; processing the queue with the caller's thread." << std::endl;
+         }
+      }
+   }
+
+   if (writer == nullptr) drainQueue();
+   else wakeWriter();
+}
+
+
+//------------------------------------------------------------------------------
+// Writer thread's main loop -- process the queue until we're stopped
+//------------------------------------------------------------------------------
+void OutputHandler::writerLoop()
+{
+   while (!stopWriter) {
+      drainQueue();
 
-   // While we have records ...
+      // Sleep until there's more to write (see wakeWriter())
+      std::unique_lock<std::mutex> lock(wakeMutex);
+      wakeCond.wait(lock, [this] { return wakeFlg || stopWriter; });
+      wakeFlg = false;
+   }
+}
+
+// Wake up the writer thread
+void OutputHandler::wakeWriter()
+{
+   {
+      std::lock_guard<std::mutex> lock(wakeMutex);
+      wakeFlg = true;
+   }
+   wakeCond.notify_one();
+}
+
+
+//------------------------------------------------------------------------------
+// Stops the writer thread, if any, and processes the rest of the queue
+//------------------------------------------------------------------------------
+void OutputHandler::stopWriterThread()
+{
+   if (writer != nullptr) {
+      stopWriter = true;
+      wakeWriter();
+      while ( !writer->isTerminated() ) {
+         base::msleep(1);
+      }
+      writer->unref();
+      writer = nullptr;
+   }
+   drainQueue();
+}
+
+
+//------------------------------------------------------------------------------
+// Process the data records in the queue; returns the number of records
+//------------------------------------------------------------------------------
+unsigned int OutputHandler::drainQueue()
+{
+   const unsigned int depth = getQueueDepth();
+   if (depth > maxDepth) maxDepth = depth;
+
+   unsigned int n = 0;
+   const DataRecordHandle* dataRecord = getFromQueue();
    while (dataRecord != nullptr) {
-      // process this record,
       processRecord(dataRecord);
       dataRecord->unref();
+      n++;
+      dataRecord = getFromQueue();
+   }
+
+   if (n > 0) flushOutput();
+   return n;
+}
 
-      // and get the next one from the queue
+// Next record from the queue (pre-ref()'d), or zero if the queue is empty
+const DataRecordHandle* OutputHandler::getFromQueue()
+{
+   const DataRecordHandle* dataRecord = nullptr;
+   if (ring != nullptr) {
+      dataRecord = ring->get();
+   }
+   else {
       base::lock( semaphore );
       dataRecord = static_cast<const DataRecordHandle*>(queue.get());
       base::unlock( semaphore );
    }
+   return dataRecord;
+}
+
+// Discard all queued records
+void OutputHandler::clearQueue()
+{
+   if (ring != nullptr) {
+      const DataRecordHandle* dataRecord = ring->get();
+      while (dataRecord != nullptr) {
+         dataRecord->unref();
+         dataRecord = ring->get();
+      }
+   }
+   base::lock(semaphore);
+   queue.clear();
+   base::unlock(semaphore);
 }
 
 
@@ -133,6 +301,51 @@ void OutputHandler::processRecordImp(const DataRecordHandle* const)
 }
 
 
+//------------------------------------------------------------------------------
+// Flush our subcomponent OutputHandlers' output
+//------------------------------------------------------------------------------
+void OutputHandler::flushOutput()
+{
+   base::PairStream* subcomponents = getComponents();
+   if (subcomponents != nullptr) {
+      for (base::List::Item* item = subcomponents->getFirstItem(); item != nullptr; item = item->getNext()) {
+         base::Pair* pair = static_cast<base::Pair*>(item->getValue());
+         OutputHandler* sc = static_cast<OutputHandler*>(pair->object());
+         sc->flushOutput();
+      }
+      subcomponents->unref();
+      subcomponents = nullptr;
+   }
+}
+
+
+//------------------------------------------------------------------------------
+// Queue statistics
+//------------------------------------------------------------------------------
+unsigned int OutputHandler::getQueueDepth() const
+{
+   unsigned int n = 0;
+   if (ring != nullptr) n = ring->entries();
+   else n = queue.entries();
+   return n;
+}
+
+unsigned int OutputHandler::getMaxQueueDepth() const
+{
+   return maxDepth;
+}
+
+unsigned int OutputHandler::getNumQueued() const
+{
+   return numQueued;
+}
+
+unsigned int OutputHandler::getNumDropped() const
+{
+   return numDropped;
+}
+
+
 //------------------------------------------------------------------------------
 // Check the data filters and return true if we should process this type message
 //------------------------------------------------------------------------------
@@ -143,6 +356,76 @@ bool OutputHandler::isDataTypeEnabled(const DataRecordHandle* const handle) cons
 }
 
 
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+
+// Max number of queued records, or zero for an unbounded queue
+bool OutputHandler::setQueueSize(const unsigned int n)
+{
+   // Only before we've started processing the queue with our writer thread
+   if (writer != nullptr) return false;
+
+   clearQueue();
+   if (ring != nullptr) { delete ring; ring = nullptr; }
+   queueSize = n;
+   if (queueSize > 0) ring = new base::mpsc_queue<const DataRecordHandle*>(queueSize);
+   return true;
+}
+
+// Process the queue with our own writer thread
+bool OutputHandler::setWriterThreadEnabled(const bool flg)
+{
+   if (writer != nullptr) return false;
+   writerEnabled = flg;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+
+bool OutputHandler::setSlotQueueSize(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= 0) {
+         ok = setQueueSize(static_cast<unsigned int>(n));
+      }
+      else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "OutputHandler::setSlotQueueSize(): ERROR, queue size must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool OutputHandler::setSlotWriterThread(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setWriterThreadEnabled(msg->getBoolean());
+   }
+   return ok;
+}
+
+bool OutputHandler::setSlotWriterPriority(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const double pri = msg->getReal();
+      if (pri >= 0.0 && pri <= 1.0) {
+         writerPriority = pri;
+         ok = true;
+      }
+      else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "OutputHandler::setSlotWriterPriority(): ERROR, priority must be in the range [ 0.0 ... 1.0 ]" << std::endl;
+      }
+   }
+   return ok;
+}
+
+
 //------------------------------------------------------------------------------
 //  make sure our subcomponents are all of type OutputHandler (or derived)
 //------------------------------------------------------------------------------
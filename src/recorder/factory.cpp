@@ -1,6 +1,7 @@
 
 #include "mixr/recorder/factory.hpp"
 
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 
 #include "mixr/recorder/DataRecorder.hpp"
@@ -18,39 +19,27 @@
 namespace mixr {
 namespace recorder {
 
+namespace {
+
+const base::FactoryTable::Entry entries[] = {
+    FACTORY_ENTRY(FileWriter),
+    FACTORY_ENTRY(FileReader),
+    FACTORY_ENTRY(NetInput),
+    FACTORY_ENTRY(NetOutput),
+    FACTORY_ENTRY(OutputHandler),
+    FACTORY_ENTRY(TabPrinter),
+    FACTORY_ENTRY(PrintPlayer),
+    FACTORY_ENTRY(DataRecorder),
+    FACTORY_ENTRY(PrintSelected),
+};
+
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+
+}
+
 base::Object* factory(const std::string& name)
 {
-    base::Object* obj {};
-
-    if ( name == FileWriter::getFactoryName() ) {
-        obj = new FileWriter();
-    }
-    else if ( name == FileReader::getFactoryName() ) {
-        obj = new FileReader();
-    }
-    else if ( name == NetInput::getFactoryName() ) {
-        obj = new NetInput();
-    }
-    else if ( name == NetOutput::getFactoryName() ) {
-        obj = new NetOutput();
-    }
-    else if ( name == OutputHandler::getFactoryName() ) {
-        obj = new OutputHandler();
-    }
-    else if ( name == TabPrinter::getFactoryName() ) {
-        obj = new TabPrinter();
-    }
-    else if ( name == PrintPlayer::getFactoryName() ) {
-        obj = new PrintPlayer();
-    }
-    else if ( name == DataRecorder::getFactoryName()) {
-        obj = new DataRecorder();
-    }
-    else if ( name == PrintSelected::getFactoryName() ) {
-        obj = new PrintSelected();
-    }
-
-    return obj;
+    return table.create(name);
 }
 
 }
@@ -0,0 +1,412 @@
+
+#include "mixr/simulation/Ensemble.hpp"
+
+#include "mixr/simulation/Simulation.hpp"
+#include "mixr/simulation/Station.hpp"
+
+#include "mixr/base/concurrent/SingleTask.hpp"
+#include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/units/Times.hpp"
+#include "mixr/base/util/atomics.hpp"
+#include "mixr/base/util/system_utils.hpp"
+
+#include <iostream>
+
+namespace mixr {
+namespace simulation {
+
+//==============================================================================
+// EnsembleThread class -- runs the ensemble's replicates
+//==============================================================================
+class EnsembleThread : public base::SingleTask
+{
+   DECLARE_SUBCLASS(EnsembleThread, base::SingleTask)
+   public: EnsembleThread(base::Component* const parent, const double priority);
+   private: virtual unsigned long userFunc() override;
+};
+
+IMPLEMENT_SUBCLASS(EnsembleThread, "EnsembleThread")
+EMPTY_SLOTTABLE(EnsembleThread)
+EMPTY_COPYDATA(EnsembleThread)
+EMPTY_DELETEDATA(EnsembleThread)
+
+EnsembleThread::EnsembleThread(base::Component* const parent, const double priority): base::SingleTask(parent, priority)
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+unsigned long EnsembleThread::userFunc()
+{
+   const auto ensemble = static_cast<Ensemble*>( getParent() );
+   ensemble->runReplicates();
+   return 0;
+}
+
+//==============================================================================
+// Ensemble class
+//==============================================================================
+
+IMPLEMENT_SUBCLASS(Ensemble, "Ensemble")
+
+BEGIN_SLOTTABLE(Ensemble)
+   "station",           // 1: Prototype station
+   "numReplicates",     // 2: Number of replicates
+   "numThreads",        // 3: Number of replicates run at the same time (default: 0 -- number of processors)
+   "seed",              // 4: Base random number seed
+   "runTime",           // 5: Simulated time of each replicate (base::Time) (default: 0 -- use the station's)
+END_SLOTTABLE(Ensemble)
+
+BEGIN_SLOT_MAP(Ensemble)
+   ON_SLOT( 1, setStation,            Station)
+   ON_SLOT( 2, setSlotNumReplicates,  base::Number)
+   ON_SLOT( 3, setSlotNumThreads,     base::Number)
+   ON_SLOT( 4, setSlotSeed,           base::Number)
+   ON_SLOT( 5, setSlotRunTime,        base::Time)
+END_SLOT_MAP()
+
+Ensemble::Ensemble()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void Ensemble::copyData(const Ensemble& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   if (org.station != nullptr) {
+      Station* copy = org.station->clone();
+      setStation( copy );
+      copy->unref();
+   }
+   else {
+      setStation(nullptr);
+   }
+
+   numReplicates = org.numReplicates;
+   numThreads = org.numThreads;
+   seed = org.seed;
+   runTime = org.runTime;
+
+   running = false;
+   nextReplicate = 0;
+   numCompleted = 0;
+   simTime = 0.0;
+   wallTime = 0.0;
+}
+
+void Ensemble::deleteData()
+{
+   setStation(nullptr);
+}
+
+//------------------------------------------------------------------------------
+// shutdownNotification() -- We're shutting down
+//------------------------------------------------------------------------------
+bool Ensemble::shutdownNotification()
+{
+   // Tell our prototype station to shut down
+   if (station != nullptr) {
+      station->event(SHUTDOWN_EVENT);
+   }
+   return BaseClass::shutdownNotification();
+}
+
+//------------------------------------------------------------------------------
+// run() -- Runs the replicates; returns when they've all completed
+//------------------------------------------------------------------------------
+bool Ensemble::run()
+{
+   if (station == nullptr || running || isShutdown()) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Ensemble::run(): ERROR, no prototype station, already running or shut down!" << std::endl;
+      }
+      return false;
+   }
+
+   running = true;
+   nextReplicate = 0;
+   numCompleted = 0;
+   simTime = 0.0;
+   wallTime = 0.0;
+
+   const double wallTime0 = base::getComputerTime();
+
+   // Reset the prototype once, in batch mode (no threads), to load its data
+   // (e.g., terrain), which is then shared by its clones
+   station->setBatchMode(true);
+   station->event(RESET_EVENT);
+
+   // Number of threads: our own plus the ones we create
+   unsigned int n = numThreads;
+   if (n == 0) n = static_cast<unsigned int>( base::Thread::getNumProcessors() );
+   if (n > numReplicates) n = numReplicates;
+   if (n > MAX_THREADS) n = MAX_THREADS;
+   if (n == 0) n = 1;
+
+   base::Thread* threads[MAX_THREADS] {};
+   unsigned int numCreated = 0;
+   for (unsigned int i = 1; i < n; i++) {
+      const auto t = new EnsembleThread(this, 0.0);
+      if (t->create()) {
+         threads[numCreated++] = t;
+      }
+      else {
+         t->unref();
+         if (isMessageEnabled(MSG_WARNING)) {
+            std::cerr << "Ensemble::run(): WARNING, failed to create a replicate thread." << std::endl;
+         }
+      }
+   }
+
+   // The main application's thread runs replicates too
+   runReplicates();
+
+   // Wait for the other threads to finish
+   for (unsigned int i = 0; i < numCreated; i++) {
+      while ( !threads[i]->isTerminated() ) {
+         base::msleep(1);
+      }
+      threads[i]->unref();
+   }
+
+   wallTime = base::getComputerTime() - wallTime0;
+   running = false;
+
+   if (isMessageEnabled(MSG_INFO)) {
+      std::cout << "Ensemble::run(): " << numCompleted << " of " << numReplicates << " replicates (" << (numCreated + 1) << " threads), ";
+      std::cout << simTime << " simulated seconds in " << wallTime << " seconds (" << getSpeed() << " x real time)" << std::endl;
+   }
+
+   return (numCompleted == numReplicates);
+}
+
+//------------------------------------------------------------------------------
+// runReplicates() -- Runs replicates until there are none left
+//------------------------------------------------------------------------------
+void Ensemble::runReplicates()
+{
+   unsigned int id = claimReplicate();
+   while (id > 0 && !isShutdown()) {
+      runReplicate(id);
+      id = claimReplicate();
+   }
+}
+
+// Next replicate ID, or zero if there are none left
+unsigned int Ensemble::claimReplicate()
+{
+   const unsigned int id = ++nextReplicate;
+   return (id <= numReplicates) ? id : 0;
+}
+
+// Clones and runs replicate 'id'
+bool Ensemble::runReplicate(const unsigned int id)
+{
+   // Clone the prototype (one at a time)
+   base::lock( semaphore );
+   Station* const sta = station->clone();
+   base::unlock( semaphore );
+   if (sta == nullptr) return false;
+
+   sta->setBatchMode(true);
+   if (runTime > 0.0) sta->setBatchRunTime(runTime);
+
+   Simulation* const sim = sta->getSimulation();
+   if (sim != nullptr) {
+      sim->setReplicateID(id);
+      sim->setSeed(seed + id);
+   }
+
+   sta->event(RESET_EVENT);
+   const bool ok = sta->runBatch();
+   if (ok) {
+      replicateCompleted(id, sta);
+
+      base::lock( semaphore );
+      numCompleted++;
+      simTime += sta->getBatchSimTime();
+      base::unlock( semaphore );
+   }
+   else if (isMessageEnabled(MSG_ERROR)) {
+      std::cerr << "Ensemble::runReplicate(): ERROR, replicate " << id << " failed to run!" << std::endl;
+   }
+
+   sta->event(SHUTDOWN_EVENT);
+   sta->unref();
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// replicateCompleted() -- Called, from the replicate's thread, when replicate
+// 'id' has completed (derived classes collect the results here)
+//------------------------------------------------------------------------------
+void Ensemble::replicateCompleted(const unsigned int, Station* const)
+{
+}
+
+//------------------------------------------------------------------------------
+// Get functions
+//------------------------------------------------------------------------------
+Station* Ensemble::getStation()
+{
+   return station;
+}
+
+const Station* Ensemble::getStation() const
+{
+   return station;
+}
+
+unsigned int Ensemble::getNumReplicates() const
+{
+   return numReplicates;
+}
+
+unsigned int Ensemble::getNumThreads() const
+{
+   return numThreads;
+}
+
+unsigned int Ensemble::getSeed() const
+{
+   return seed;
+}
+
+double Ensemble::getRunTime() const
+{
+   return runTime;
+}
+
+bool Ensemble::isRunning() const
+{
+   return running;
+}
+
+unsigned int Ensemble::getNumCompleted() const
+{
+   return numCompleted;
+}
+
+double Ensemble::getSimTime() const
+{
+   return simTime;
+}
+
+double Ensemble::getWallTime() const
+{
+   return wallTime;
+}
+
+double Ensemble::getSpeed() const
+{
+   return (wallTime > 0.0) ? (simTime / wallTime) : 0.0;
+}
+
+//------------------------------------------------------------------------------
+// Set functions
+//------------------------------------------------------------------------------
+bool Ensemble::setStation(Station* const p)
+{
+   if (running) return false;
+   if (station != nullptr) {
+      station->container(nullptr);
+      station->unref();
+   }
+   station = p;
+   if (station != nullptr) {
+      station->ref();
+      station->container(this);
+   }
+   return true;
+}
+
+bool Ensemble::setNumReplicates(const unsigned int n)
+{
+   if (running) return false;
+   numReplicates = n;
+   return true;
+}
+
+bool Ensemble::setNumThreads(const unsigned int n)
+{
+   if (running) return false;
+   numThreads = n;
+   return true;
+}
+
+bool Ensemble::setSeed(const unsigned int s)
+{
+   if (running) return false;
+   seed = s;
+   return true;
+}
+
+bool Ensemble::setRunTime(const double secs)
+{
+   if (running || secs < 0.0) return false;
+   runTime = secs;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool Ensemble::setSlotNumReplicates(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= 0) {
+         ok = setNumReplicates( static_cast<unsigned int>(n) );
+      }
+      else {
+         std::cerr << "Ensemble::setSlotNumReplicates: Number of replicates must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Ensemble::setSlotNumThreads(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int n = msg->getInt();
+      if (n >= 0) {
+         ok = setNumThreads( static_cast<unsigned int>(n) );
+      }
+      else {
+         std::cerr << "Ensemble::setSlotNumThreads: Number of threads must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Ensemble::setSlotSeed(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int s = msg->getInt();
+      if (s >= 0) {
+         ok = setSeed( static_cast<unsigned int>(s) );
+      }
+      else {
+         std::cerr << "Ensemble::setSlotSeed: Seed must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Ensemble::setSlotRunTime(const base::Time* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setRunTime( base::Seconds::convertStatic(*msg) );
+      if (!ok) {
+         std::cerr << "Ensemble::setSlotRunTime: Run time must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+}
+}
@@ -0,0 +1,195 @@
+
+#include "mixr/simulation/PlayerList.hpp"
+
+#include "mixr/simulation/AbstractPlayer.hpp"
+
+#include "mixr/base/Pair.hpp"
+
+namespace mixr {
+namespace simulation {
+
+IMPLEMENT_SUBCLASS(PlayerList, "PlayerList")
+EMPTY_SLOTTABLE(PlayerList)
+
+PlayerList::PlayerList()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void PlayerList::copyData(const PlayerList& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   // Index our own copy of the players
+   clearIndex();
+   if (org.players != nullptr) buildIndex();
+}
+
+void PlayerList::deleteData()
+{
+   clearIndex();
+}
+
+//------------------------------------------------------------------------------
+// buildIndex() -- index the players that are currently on the list
+//------------------------------------------------------------------------------
+void PlayerList::buildIndex()
+{
+   clearIndex();
+
+   const unsigned int n = entries();
+
+   // Table size: power of two; at least twice the number of players
+   unsigned int size = 16;
+   while (size < (2 * n)) size <<= 1;
+   mask = size - 1;
+
+   players = new AbstractPlayer*[n > 0 ? n : 1];
+   idTable = new int[size];
+   idNetTable = new int[size];
+   nameTable = new int[size];
+   for (unsigned int i = 0; i < size; i++) {
+      idTable[i] = -1;
+      idNetTable[i] = -1;
+      nameTable[i] = -1;
+   }
+
+   // Players are added in list order, so with linear probing the
+   // first player in list order is always found first.
+   const base::List::Item* item = getFirstItem();
+   while (item != nullptr && numPlayers < n) {
+      const auto pair = static_cast<const base::Pair*>(item->getValue());
+      const auto ip = const_cast<AbstractPlayer*>(static_cast<const AbstractPlayer*>(pair->object()));
+      const int idx = static_cast<int>(numPlayers);
+      players[numPlayers++] = ip;
+
+      unsigned int h = hashId(ip->getID(), 0) & mask;
+      while (idTable[h] >= 0) h = (h + 1) & mask;
+      idTable[h] = idx;
+
+      h = hashId(ip->getID(), static_cast<unsigned int>(ip->getNetworkID())) & mask;
+      while (idNetTable[h] >= 0) h = (h + 1) & mask;
+      idNetTable[h] = idx;
+
+      const base::Identifier* name = ip->getName();
+      h = hashName(name != nullptr ? static_cast<const char*>(*name) : nullptr) & mask;
+      while (nameTable[h] >= 0) h = (h + 1) & mask;
+      nameTable[h] = idx;
+
+      item = item->getNext();
+   }
+}
+
+void PlayerList::clearIndex()
+{
+   if (players != nullptr)    { delete[] players;    players = nullptr; }
+   if (idTable != nullptr)    { delete[] idTable;    idTable = nullptr; }
+   if (idNetTable != nullptr) { delete[] idNetTable; idNetTable = nullptr; }
+   if (nameTable != nullptr)  { delete[] nameTable;  nameTable = nullptr; }
+   numPlayers = 0;
+   mask = 0;
+}
+
+//------------------------------------------------------------------------------
+// findPlayer() -- Find a player that matches 'id' and 'networkID'
+//------------------------------------------------------------------------------
+AbstractPlayer* PlayerList::findPlayer(const short id, const int netID) const
+{
+   if (!isIndexValid()) return scanPlayer(id, netID);
+
+   AbstractPlayer* iplayer = nullptr;
+   if (netID > 0) {
+      unsigned int h = hashId(static_cast<unsigned short>(id), static_cast<unsigned int>(netID)) & mask;
+      while (iplayer == nullptr && idNetTable[h] >= 0) {
+         AbstractPlayer* ip = players[idNetTable[h]];
+         if ((ip->getID() == id) && (ip->getNetworkID() == netID)) iplayer = ip;
+         h = (h + 1) & mask;
+      }
+   }
+   else {
+      unsigned int h = hashId(static_cast<unsigned short>(id), 0) & mask;
+      while (iplayer == nullptr && idTable[h] >= 0) {
+         AbstractPlayer* ip = players[idTable[h]];
+         if (ip->getID() == id) iplayer = ip;
+         h = (h + 1) & mask;
+      }
+   }
+   return iplayer;
+}
+
+//------------------------------------------------------------------------------
+// findPlayerByName() -- Find a player by name
+//------------------------------------------------------------------------------
+AbstractPlayer* PlayerList::findPlayerByName(const char* const playerName) const
+{
+   if (playerName == nullptr) return nullptr;
+   if (!isIndexValid()) return scanPlayerByName(playerName);
+
+   AbstractPlayer* iplayer = nullptr;
+   unsigned int h = hashName(playerName) & mask;
+   while (iplayer == nullptr && nameTable[h] >= 0) {
+      AbstractPlayer* ip = players[nameTable[h]];
+      if (ip->isName(playerName)) iplayer = ip;
+      h = (h + 1) & mask;
+   }
+   return iplayer;
+}
+
+//------------------------------------------------------------------------------
+// Scan the list (without an index)
+//------------------------------------------------------------------------------
+AbstractPlayer* PlayerList::scanPlayer(const short id, const int netID) const
+{
+   AbstractPlayer* iplayer = nullptr;
+   const base::List::Item* item = getFirstItem();
+   while (iplayer == nullptr && item != nullptr) {
+      const auto pair = static_cast<const base::Pair*>(item->getValue());
+      const auto ip = const_cast<AbstractPlayer*>(static_cast<const AbstractPlayer*>(pair->object()));
+      if (ip != nullptr && ip->getID() == id && (netID <= 0 || ip->getNetworkID() == netID)) {
+         iplayer = ip;
+      }
+      item = item->getNext();
+   }
+   return iplayer;
+}
+
+AbstractPlayer* PlayerList::scanPlayerByName(const char* const playerName) const
+{
+   AbstractPlayer* iplayer = nullptr;
+   const base::List::Item* item = getFirstItem();
+   while (iplayer == nullptr && item != nullptr) {
+      const auto pair = static_cast<const base::Pair*>(item->getValue());
+      const auto ip = const_cast<AbstractPlayer*>(static_cast<const AbstractPlayer*>(pair->object()));
+      if (ip != nullptr && ip->isName(playerName)) iplayer = ip;
+      item = item->getNext();
+   }
+   return iplayer;
+}
+
+//------------------------------------------------------------------------------
+// Hash functions
+//------------------------------------------------------------------------------
+unsigned int PlayerList::hashId(const unsigned int id, const unsigned int netID)
+{
+   unsigned int h = (id & 0xffff) | (netID << 16);
+   h ^= (h >> 16);
+   h *= 0x45d9f3bu;
+   h ^= (h >> 16);
+   return h;
+}
+
+unsigned int PlayerList::hashName(const char* const name)
+{
+   // FNV-1a
+   unsigned int h = 2166136261u;
+   if (name != nullptr) {
+      for (const char* p = name; *p != '\0'; p++) {
+         h ^= static_cast<unsigned char>(*p);
+         h *= 16777619u;
+      }
+   }
+   return h;
+}
+
+}
+}
@@ -0,0 +1,208 @@
+
+#include "mixr/simulation/PlayerScheduler.hpp"
+
+#include "mixr/simulation/AbstractPlayer.hpp"
+
+#include "mixr/base/PairStream.hpp"
+#include "mixr/base/Pair.hpp"
+#include "mixr/base/Statistic.hpp"
+
+#include <cstdint>
+#include <new>
+
+namespace mixr {
+namespace simulation {
+
+PlayerScheduler::PlayerScheduler()
+{
+   // Align the ranges to a cache line within an over-sized block
+   rangeBlock = new char[MAX_THREADS * sizeof(Range) + alignof(Range)];
+   const std::uintptr_t mask = alignof(Range) - 1;
+   char* const p = reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(rangeBlock) + mask) & ~mask);
+   ranges = reinterpret_cast<Range*>(p);
+   for (unsigned int t = 0; t < MAX_THREADS; t++) {
+      new (&p[t * sizeof(Range)]) Range();
+   }
+}
+
+PlayerScheduler::~PlayerScheduler()
+{
+   clear();
+   delete[] players;
+   delete[] costs;
+   delete[] chunkEnd;
+   delete[] rangeBlock;    // (the ranges are trivially destructible)
+}
+
+//------------------------------------------------------------------------------
+// build() -- copy the players of 'list' into our contiguous player array
+//------------------------------------------------------------------------------
+void PlayerScheduler::build(base::PairStream* const list)
+{
+   playerList = list;
+   numPlayers = 0;
+   numChunks = 0;
+   numThreads = 0;
+
+   if (list != nullptr) {
+      resize(list->entries());
+      const base::List::Item* item = list->getFirstItem();
+      while (item != nullptr && numPlayers < capacity) {
+         const auto pair = static_cast<const base::Pair*>(item->getValue());
+         players[numPlayers++] = const_cast<AbstractPlayer*>(static_cast<const AbstractPlayer*>(pair->object()));
+         item = item->getNext();
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// plan() -- split the player array into cost-weighted chunks and assign
+// a contiguous range of chunks to each of the 'n' threads
+//------------------------------------------------------------------------------
+void PlayerScheduler::plan(const unsigned int n)
+{
+   numThreads = (n < MAX_THREADS ? n : MAX_THREADS);
+   if (numThreads == 0) numThreads = 1;
+
+   // ---
+   // Player costs: mean tcFrame() time, when known
+   // ---
+   double measured {};
+   unsigned int nMeasured {};
+   for (unsigned int i = 0; i < numPlayers; i++) {
+      costs[i] = -1.0;
+      const base::Statistic* ts = players[i]->getTimingStats();
+      if (ts != nullptr && ts->getN() > 0 && ts->mean() > 0.0) {
+         costs[i] = ts->mean();
+         measured += costs[i];
+         nMeasured++;
+      }
+   }
+   const double defCost = (nMeasured > 0 ? (measured / nMeasured) : 1.0);
+   double total {};
+   for (unsigned int i = 0; i < numPlayers; i++) {
+      if (costs[i] < 0.0) costs[i] = defCost;
+      total += costs[i];
+   }
+
+   // ---
+   // Chunks of (about) equal cost
+   // ---
+   numChunks = 0;
+   unsigned int maxChunks = numThreads * CHUNKS_PER_THREAD;
+   if (maxChunks > numPlayers) maxChunks = numPlayers;
+   if (maxChunks > 0) {
+      const double chunkCost = total / maxChunks;
+      double sum {};
+      for (unsigned int i = 0; i < numPlayers; i++) {
+         sum += costs[i];
+         if (sum >= chunkCost || (i+1) == numPlayers) {
+            chunkEnd[numChunks++] = (i+1);
+            sum = 0.0;
+         }
+      }
+   }
+
+   // ---
+   // Assign each chunk to the thread whose share of the
+   // total cost contains the chunk's midpoint
+   // ---
+   for (unsigned int t = 0; t < numThreads; t++) {
+      ranges[t].begin = 0;
+      ranges[t].end = 0;
+   }
+   double cum {};
+   unsigned int first {};
+   unsigned int t {};
+   for (unsigned int c = 0; c < numChunks; c++) {
+      double cost {};
+      for (unsigned int i = first; i < chunkEnd[c]; i++) cost += costs[i];
+      first = chunkEnd[c];
+
+      const double mid = cum + cost / 2.0;
+      cum += cost;
+      unsigned int owner = (total > 0.0 ? static_cast<unsigned int>(mid / total * numThreads) : 0);
+      if (owner >= numThreads) owner = numThreads - 1;
+      if (owner < t) owner = t;
+
+      while (t < owner) {
+         t++;
+         ranges[t].begin = c;
+      }
+      ranges[t].end = c + 1;
+   }
+   for (t = t + 1; t < numThreads; t++) {
+      ranges[t].begin = numChunks;
+      ranges[t].end = numChunks;
+   }
+
+   restart();
+}
+
+//------------------------------------------------------------------------------
+// restart() -- make all chunks available again
+//------------------------------------------------------------------------------
+void PlayerScheduler::restart()
+{
+   for (unsigned int t = 0; t < numThreads; t++) {
+      if (ranges[t].end < ranges[t].begin) ranges[t].end = ranges[t].begin;
+      ranges[t].next.store(ranges[t].begin, std::memory_order_relaxed);
+   }
+}
+
+//------------------------------------------------------------------------------
+// nextChunk() -- returns the next chunk for thread 'idx'; our own range
+// first, and then steal from the other threads
+//------------------------------------------------------------------------------
+bool PlayerScheduler::nextChunk(const unsigned int idx, unsigned int* const first, unsigned int* const last)
+{
+   if (idx >= numThreads) return false;
+
+   if (takeChunk(ranges[idx], first, last)) return true;
+
+   for (unsigned int k = 1; k < numThreads; k++) {
+      Range& victim = ranges[(idx + k) % numThreads];
+      if (victim.next.load(std::memory_order_relaxed) < victim.end) {
+         if (takeChunk(victim, first, last)) return true;
+      }
+   }
+   return false;
+}
+
+bool PlayerScheduler::takeChunk(Range& r, unsigned int* const first, unsigned int* const last)
+{
+   const unsigned int c = r.next.fetch_add(1, std::memory_order_relaxed);
+   if (c >= r.end) return false;
+   *first = (c > 0 ? chunkEnd[c-1] : 0);
+   *last = chunkEnd[c];
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// clear() -- release the player list
+//------------------------------------------------------------------------------
+void PlayerScheduler::clear()
+{
+   playerList = nullptr;
+   numPlayers = 0;
+   numChunks = 0;
+   numThreads = 0;
+}
+
+// Grow our arrays to hold at least 'n' players
+void PlayerScheduler::resize(const unsigned int n)
+{
+   if (n <= capacity) return;
+
+   delete[] players;
+   delete[] costs;
+   delete[] chunkEnd;
+
+   capacity = n + (n / 4) + 16;
+   players = new AbstractPlayer*[capacity];
+   costs = new double[capacity];
+   chunkEnd = new unsigned int[capacity];
+}
+
+}
+}
@@ -2,6 +2,7 @@
 #include "mixr/simulation/Simulation.hpp"
 
 #include "mixr/simulation/AbstractPlayer.hpp"
+#include "mixr/simulation/PlayerList.hpp"
 
 #include "mixr/simulation/SimTcThread.hpp"
 #include "mixr/simulation/SimBgThread.hpp"
@@ -14,8 +15,10 @@
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/units/Times.hpp"
 #include "mixr/base/Statistic.hpp"
+#include "mixr/base/Tracer.hpp"
 #include "mixr/base/util/system_utils.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <cmath>
 
@@ -34,7 +37,10 @@ BEGIN_SLOTTABLE(Simulation)
    "firstWeaponId",  // 6) First Released Weapon ID (default: 10001)
 
    "numTcThreads",   // 7) Number of T/C threads to use with the player list
-   "numBgThreads"    // 8) Number of background threads to use with the player list
+   "numBgThreads",   // 8) Number of background threads to use with the player list
+   "workStealing",   // 9) Use the work-stealing player scheduler
+   "seed",           // 10) Random number generator seed
+   "updatePlans"     // 11) Update the players using their update plans
 END_SLOTTABLE(Simulation)
 
 BEGIN_SLOT_MAP(Simulation)
@@ -49,6 +55,10 @@ BEGIN_SLOT_MAP(Simulation)
 
     ON_SLOT( 7, setSlotNumTcThreads,    base::Number)
     ON_SLOT( 8, setSlotNumBgThreads,    base::Number)
+    ON_SLOT( 9, setSlotWorkStealing,    base::Number)
+
+    ON_SLOT(10, setSlotSeed,            base::Number)
+    ON_SLOT(11, setSlotUpdatePlans,     base::Number)
 END_SLOT_MAP()
 
 Simulation::Simulation() : newPlayerQueue(MAX_NEW_PLAYERS)
@@ -148,6 +158,16 @@ void Simulation::copyData(const Simulation& org, const bool)
    numBgThreads = 0;
    bgThreadsFailed = false;
    reqBgThreads = org.reqBgThreads;
+
+   workStealing = org.workStealing;
+   tcScheduler.clear();
+   bgScheduler.clear();
+
+   updatePlans = org.updatePlans;
+
+   seed = org.seed;
+   rng.seed(seed);
+   replicateID = org.replicateID;
 }
 
 void Simulation::deleteData()
@@ -177,6 +197,9 @@ void Simulation::deleteData()
    numBgThreads = 0;
    bgThreadsFailed = false;
 
+   tcScheduler.clear();
+   bgScheduler.clear();
+
    station = nullptr;
 }
 
@@ -189,58 +212,63 @@ void Simulation::reset()
    // Something old and something new ...
    // ... We're going to create a new player list.
    // ---
-   base::safe_ptr<base::PairStream> newList( new base::PairStream() );
+   const auto newPlayerList = new PlayerList();
+   base::safe_ptr<base::PairStream> newList( newPlayerList );
    newList->unref();  // 'newList' has it, so unref() from the 'new'
 
    // ---
-   // Copy original players to the new list
+   // Collect the original players and the old networked players (IPlayers)
    // ---
-   {
-      if (origPlayers != nullptr) {
-         base::safe_ptr<base::PairStream> origPlayerList = origPlayers;
-         base::List::Item* item = origPlayerList->getFirstItem();
-         while (item != nullptr) {
-            base::Pair* pair = static_cast<base::Pair*>(item->getValue());
-            AbstractPlayer* ip = static_cast<AbstractPlayer*>(pair->object());
+   base::safe_ptr<base::PairStream> origPlayerList = origPlayers;
+   base::safe_ptr<base::PairStream> oldPlayerList = players;
+   unsigned int maxPlayers = 0;
+   if (origPlayerList != nullptr) maxPlayers += origPlayerList->entries();
+   if (oldPlayerList != nullptr) maxPlayers += oldPlayerList->entries();
+   base::Pair** newPairs = new base::Pair*[maxPlayers > 0 ? maxPlayers : 1];
+   unsigned int numNew = 0;
+
+   if (origPlayerList != nullptr) {
+      base::List::Item* item = origPlayerList->getFirstItem();
+      while (item != nullptr) {
+         base::Pair* pair = static_cast<base::Pair*>(item->getValue());
+         AbstractPlayer* ip = static_cast<AbstractPlayer*>(pair->object());
+
+         // reinstated the container pointer and player name
+         ip->container(this);
+         ip->setName(*pair->slot());
+
+         newPairs[numNew++] = pair;
+         item = item->getNext();
+      }
+   }
+
+   if (oldPlayerList != nullptr) {
+      base::List::Item* item = oldPlayerList->getFirstItem();
+      while (item != nullptr) {
+         base::Pair* pair = static_cast<base::Pair*>(item->getValue());
+         AbstractPlayer* ip = static_cast<AbstractPlayer*>(pair->object());
+         if (ip->isNetworkedPlayer()) {
 
             // reinstated the container pointer and player name
             ip->container(this);
             ip->setName(*pair->slot());
 
-            // Insert the player into the new list in sorted order
-            insertPlayerSort(pair, newList);
-            item = item->getNext();
+            newPairs[numNew++] = pair;
          }
+         item = item->getNext();
       }
    }
 
    // ---
-   // Copy the old networked players (IPlayers) to the new list
+   // Add them to the new list in sorted order
    // ---
-   {
-      if (players != nullptr) {
-         base::safe_ptr<base::PairStream> origPlayerList = players;
-         base::List::Item* item = origPlayerList->getFirstItem();
-         while (item != nullptr) {
-            base::Pair* pair = static_cast<base::Pair*>(item->getValue());
-            AbstractPlayer* ip = static_cast<AbstractPlayer*>(pair->object());
-            if (ip->isNetworkedPlayer()) {
-
-               // reinstated the container pointer and player name
-               ip->container(this);
-               ip->setName(*pair->slot());
-
-               // Insert the IPlayer into the new list in sorted order
-               insertPlayerSort(pair, newList);
-            }
-            item = item->getNext();
-         }
-      }
-   }
+   mergePlayers(nullptr, 0, newPairs, numNew, newList);
+   delete[] newPairs;
 
    // ---
-   // Swap the lists
+   // Index and swap the lists
    // ---
+   newPlayerList->buildIndex();
    players = newList;
 
    // ---
@@ -311,6 +339,11 @@ void Simulation::reset()
 
    }
 
+   // ---
+   // Re-seed the random number generator
+   // ---
+   rng.seed(seed);
+
    // ---
    // Reset simulated time (if not slaved to UTC)
    // ---
@@ -548,11 +581,28 @@ void Simulation::updateTC(const double dt)
       // This locks the current player list for this time-critical frame
       base::safe_ptr<base::PairStream> currentPlayerList = players;
 
+      // Rebuild the scheduler's player array for a new player list, and
+      // re-weight its chunks once per cycle
+      const bool scheduled = (workStealing && numTcThreads > 0 && currentPlayerList != nullptr);
+      if (scheduled) {
+         if (!tcScheduler.isBuiltFor(currentPlayerList)) {
+            tcScheduler.build(currentPlayerList);
+            tcScheduler.plan(reqTcThreads);
+         }
+         else if (frame() == 0) {
+            tcScheduler.plan(reqTcThreads);
+         }
+      }
+
       for (unsigned int f = 0; f < 4; f++) {
 
+         MIXR_TRACE_ZONE_ID("Simulation::phase", static_cast<int>(f));
+
          // Set the current phase
          setPhase(f);
 
+         if (scheduled) tcScheduler.restart();
+
          if (reqTcThreads == 1) {
             // Our single TC thread
             updateTcPlayerList(currentPlayerList, (dt0/4.0), 1, 1);
@@ -595,7 +645,8 @@ void Simulation::updateTC(const double dt)
 
 //------------------------------------------------------------------------------
 // Time critical thread processing for every n'th player starting
-// with the idx'th player
+// with the idx'th player, or for the chunks of players handed out
+// to the idx'th thread by the work-stealing scheduler
 //------------------------------------------------------------------------------
 void Simulation::updateTcPlayerList(
    base::PairStream* const playerList,
@@ -603,7 +654,16 @@ void Simulation::updateTcPlayerList(
    const unsigned int idx,
    const unsigned int n)
 {
-   if (playerList != nullptr) {
+   if (workStealing && n > 1 && tcScheduler.isBuiltFor(playerList)) {
+      unsigned int first {};
+      unsigned int last {};
+      while (tcScheduler.nextChunk(idx-1, &first, &last)) {
+         for (unsigned int i = first; i < last; i++) {
+            tcFramePlayer(tcScheduler.getPlayer(i), dt);
+         }
+      }
+   }
+   else if (playerList != nullptr) {
       unsigned int index = idx;
       unsigned int count = 0;
       base::List::Item* item = playerList->getFirstItem();
@@ -612,7 +672,7 @@ void Simulation::updateTcPlayerList(
          if (count == index) {
             base::Pair* pair = static_cast<base::Pair*>(item->getValue());
             AbstractPlayer* ip = static_cast<AbstractPlayer*>(pair->object());
-            ip->tcFrame(dt);
+            tcFramePlayer(ip, dt);
             index += n;
          }
          item = item->getNext();
@@ -639,6 +699,14 @@ void Simulation::updateData(const double dt)
     if (players != nullptr) {
          base::safe_ptr<base::PairStream> currentPlayerList = players;
 
+         // Rebuild the scheduler's player array for a new player list
+         if (workStealing && numBgThreads > 0) {
+            if (!bgScheduler.isBuiltFor(currentPlayerList)) {
+               bgScheduler.build(currentPlayerList);
+            }
+            bgScheduler.plan(reqBgThreads);
+         }
+
          if (reqBgThreads == 1) {
             // Our single thread
             updateBgPlayerList(currentPlayerList, dt0, 1, 1);
@@ -671,7 +739,8 @@ void Simulation::updateData(const double dt)
 
 //------------------------------------------------------------------------------
 // Background thread processing for every n'th player starting
-// with the idx'th player
+// with the idx'th player, or for the chunks of players handed out
+// to the idx'th thread by the work-stealing scheduler
 //------------------------------------------------------------------------------
 void Simulation::updateBgPlayerList(
          base::PairStream* const playerList,
@@ -679,7 +748,16 @@ void Simulation::updateBgPlayerList(
          const unsigned int idx,
          const unsigned int n)
 {
-   if (playerList != nullptr) {
+   if (workStealing && n > 1 && bgScheduler.isBuiltFor(playerList)) {
+      unsigned int first {};
+      unsigned int last {};
+      while (bgScheduler.nextChunk(idx-1, &first, &last)) {
+         for (unsigned int i = first; i < last; i++) {
+            updateDataPlayer(bgScheduler.getPlayer(i), dt);
+         }
+      }
+   }
+   else if (playerList != nullptr) {
       unsigned int index = idx;
       unsigned int count = 0;
       base::List::Item* item = playerList->getFirstItem();
@@ -688,7 +766,7 @@ void Simulation::updateBgPlayerList(
          if (count == index) {
          base::Pair* pair = static_cast<base::Pair*>(item->getValue());
             AbstractPlayer* ip = static_cast<AbstractPlayer*>(pair->object());
-            ip->updateData(dt);
+            updateDataPlayer(ip, dt);
             index += n;
          }
          item = item->getNext();
@@ -696,6 +774,36 @@ void Simulation::updateBgPlayerList(
    }
 }
 
+//------------------------------------------------------------------------------
+// Updates one player: its tcFrame() or updateData(), or by running its update
+// plan (see the 'updatePlans' slot)
+//------------------------------------------------------------------------------
+void Simulation::tcFramePlayer(AbstractPlayer* const player, const double dt)
+{
+   MIXR_TRACE_ZONE_ID("Player::tcFrame", player->getID());
+   if (updatePlans) {
+      const base::UpdatePlan* plan = player->getUpdatePlan();
+      plan->tcFrame(dt);
+      plan->unref();
+   }
+   else {
+      player->tcFrame(dt);
+   }
+}
+
+void Simulation::updateDataPlayer(AbstractPlayer* const player, const double dt)
+{
+   MIXR_TRACE_ZONE_ID("Player::updateData", player->getID());
+   if (updatePlans) {
+      const base::UpdatePlan* plan = player->getUpdatePlan();
+      plan->updateData(dt);
+      plan->unref();
+   }
+   else {
+      player->updateData(dt);
+   }
+}
+
 //------------------------------------------------------------------------------
 // printTimingStats() -- Update time critical stuff here
 //------------------------------------------------------------------------------
@@ -797,6 +905,24 @@ unsigned short Simulation::getNewReleasedWeaponID()
    return relWpnId++;
 };
 
+// Random number generator seed
+unsigned int Simulation::getSeed() const
+{
+   return seed;
+}
+
+// Random number generator
+std::mt19937& Simulation::getRandomGenerator()
+{
+   return rng;
+}
+
+// Ensemble replicate ID, or zero if we're not a replicate
+unsigned int Simulation::getReplicateID() const
+{
+   return replicateID;
+}
+
 // Returns the data recorder
 AbstractDataRecorder* Simulation::getDataRecorder()
 {
@@ -932,20 +1058,24 @@ bool Simulation::setSlotPlayers(base::PairStream* const pl)
       origPlayers = pl;
 
       // Create the new active player list
-      base::PairStream* newList( new base::PairStream() );
+      const auto newList = new PlayerList();
 
-      // Copy original players to the new list
+      // Copy original players to the new list in sorted order
       if (origPlayers != nullptr) {
          base::safe_ptr<base::PairStream> origPlayerList = origPlayers;
+         base::Pair** newPairs = new base::Pair*[origPlayerList->entries() + 1];
+         unsigned int numNew = 0;
          base::List::Item* item = origPlayerList->getFirstItem();
          while (item != nullptr) {
-            base::Pair* pair = static_cast<base::Pair*>(item->getValue());
-            insertPlayerSort(pair, newList);
+            newPairs[numNew++] = static_cast<base::Pair*>(item->getValue());
             item = item->getNext();
          }
+         mergePlayers(nullptr, 0, newPairs, numNew, newList);
+         delete[] newPairs;
       }
 
-      // Set the active player list pointer
+      // Index and set the active player list pointer
+      newList->buildIndex();
       players = newList;
       newList->unref();
    }
@@ -987,21 +1117,24 @@ void Simulation::updatePlayerList()
         // ---
         // Something old and something new ...
         // ---
-        base::safe_ptr<base::PairStream> newList( new base::PairStream() );
+        const auto newPlayerList = new PlayerList();
+        base::safe_ptr<base::PairStream> newList( newPlayerList );
         newList->unref();  // 'newList' has it, so unref() from the 'new'
 
         // ---
-        // Copy players to the new list; except 'deleteRequest' mode players
+        // Keep the old players, which are already sorted; except 'deleteRequest' mode players
         // ---
         base::safe_ptr<base::PairStream> oldList = players;
+        base::Pair** oldPairs = new base::Pair*[oldList->entries() + 1];
+        unsigned int numOld = 0;
         base::List::Item* item = oldList->getFirstItem();
         while (item != nullptr) {
             base::Pair* pair = static_cast<base::Pair*>(item->getValue());
             item = item->getNext();
             const auto p = static_cast<AbstractPlayer*>(pair->object());
             if (p->isNotMode(AbstractPlayer::DELETE_REQUEST)) {
-                // Add the player to the new list
-                newList->put(pair);
+                // Keep the player
+                oldPairs[numOld++] = pair;
             }
             else {
                 // Deleting this player: remove us as its container
@@ -1015,10 +1148,12 @@ void Simulation::updatePlayerList()
         }
 
         // ---
-        // Add any new players
+        // Collect any new players
         // ---
-      base::Pair* newPlayer = newPlayerQueue.get();
-      while (newPlayer != nullptr) {
+        base::Pair** newPairs = new base::Pair*[MAX_NEW_PLAYERS];
+        unsigned int numNew = 0;
+        base::Pair* newPlayer = nullptr;
+        while (numNew < MAX_NEW_PLAYERS && (newPlayer = newPlayerQueue.get()) != nullptr) {
             // get the player
             const auto ip = static_cast<AbstractPlayer*>(newPlayer->object());
 
@@ -1030,17 +1165,24 @@ void Simulation::updatePlayerList()
             ip->container(this);
             ip->setName(*newPlayer->slot());
 
-            // Insert the new player into the new list in sorted order
-            insertPlayerSort(newPlayer, newList);
+            newPairs[numNew++] = newPlayer;
+        }
 
-            newPlayer->unref();
+        // ---
+        // Merge the new players into the kept players
+        // ---
+        mergePlayers(oldPairs, numOld, newPairs, numNew, newList);
 
-         newPlayer = newPlayerQueue.get();
+        for (unsigned int i = 0; i < numNew; i++) {
+            newPairs[i]->unref();
         }
+        delete[] newPairs;
+        delete[] oldPairs;
 
         // ---
-        // Swap the lists
+        // Index and swap the lists
         // ---
+        newPlayerList->buildIndex();
         players = newList;
     }
 }
@@ -1078,74 +1220,83 @@ bool Simulation::addNewPlayer(const char* const playerName, AbstractPlayer* cons
 }
 
 //------------------------------------------------------------------------------
-// insertPlayerSort() -- Insert the new player into the new list in sorted order
+// isPlayerBefore() -- True if player 'a' is sorted before player 'b' on the
+// player list: local players first, by player ID, and then the networked
+// players (IPlayers), by federate name and NIB player ID.
 //------------------------------------------------------------------------------
-bool Simulation::insertPlayerSort(base::Pair* const newPlayerPair, base::PairStream* const newList)
-{
-    newList->ref();
-
-    // create a new base::List::Item to hold the player
-    base::List::Item* newItem = new base::List::Item;
-    newPlayerPair->ref();
-    newItem->value = newPlayerPair;
-
-    // Get the player
-    const auto newPlayer = static_cast<AbstractPlayer*>(newPlayerPair->object());
-
-    // Search the new player list and insert into the correct position --
-    //  -- sorted by network ID and player ID
-    bool inserted = false;
-    base::List::Item* refItem = newList->getFirstItem();
-    while (refItem != nullptr && !inserted) {
-        base::Pair* refPair = static_cast<base::Pair*>(refItem->getValue());
-        const auto refPlayer = static_cast<AbstractPlayer*>(refPair->object());
-
-        bool insert = false;
-        if (newPlayer->isNetworkedPlayer()) {
-
-            // *** Insert IPlayer -- after local players and lower NIB IDs first
-            if (refPlayer->isNetworkedPlayer()) {
-
-               // Get the NIBs
-               const AbstractNib* nNib = newPlayer->getNib();
-               const AbstractNib* rNib = refPlayer->getNib();
-
-               // Compare federate names
-               int result = std::strcmp(*nNib->getFederateName(), *rNib->getFederateName());
-               if (result == 0) {
-                  // Same federate name; compare player IDs
-                  if (nNib->getPlayerID() > rNib->getPlayerID()) result = +1;
-                  else if (nNib->getPlayerID() < rNib->getPlayerID()) result = -1;
-               }
-
-               // Insert if the new NIB's IDs are less than the ref NIB's IDs
-               insert = (result < 0);
-            }
-        }
-        else {
+bool Simulation::isPlayerBefore(const base::Pair* const a, const base::Pair* const b)
+{
+    const auto newPlayer = static_cast<const AbstractPlayer*>(a->object());
+    const auto refPlayer = static_cast<const AbstractPlayer*>(b->object());
 
-            // *** Insert a local player -- by player ID and before any IPlayer
-            insert = ( (newPlayer->getID() < refPlayer->getID()) || refPlayer->isNetworkedPlayer() );
+    bool before = false;
+    if (newPlayer->isNetworkedPlayer()) {
 
-        }
+        // *** IPlayer -- after local players and lower NIB IDs first
+        if (refPlayer->isNetworkedPlayer()) {
 
-        if (insert) {
-            newList->insert(newItem, refItem);
-            inserted = true;
-        }
+           // Get the NIBs
+           const AbstractNib* nNib = newPlayer->getNib();
+           const AbstractNib* rNib = refPlayer->getNib();
 
-        refItem = refItem->getNext();
+           // Compare federate names
+           int result = std::strcmp(*nNib->getFederateName(), *rNib->getFederateName());
+           if (result == 0) {
+              // Same federate name; compare player IDs
+              if (nNib->getPlayerID() > rNib->getPlayerID()) result = +1;
+              else if (nNib->getPlayerID() < rNib->getPlayerID()) result = -1;
+           }
+
+           before = (result < 0);
+        }
     }
+    else {
+
+        // *** Local player -- by player ID and before any IPlayer
+        before = ( (newPlayer->getID() < refPlayer->getID()) || refPlayer->isNetworkedPlayer() );
 
-    // Hasn't been inserted yet, so add to the tail
-    if (!inserted) {
-        newList->insert(newItem, nullptr);
     }
 
-    newList->unref();
-    return true;
+    return before;
 }
 
+//------------------------------------------------------------------------------
+// mergePlayers() -- Adds the 'n' sorted old players and the 'k' new players
+// to the (empty) new list in sorted order.  The new players are sorted, and
+// each is then placed after the old players using a binary search, so that's
+// O(k log k + k log n) player compares.  Players with equal IDs keep their
+// order, with the old players first (same as inserting the new players one
+// at a time).
+//------------------------------------------------------------------------------
+void Simulation::mergePlayers(
+      base::Pair** const oldPairs,
+      const unsigned int n,
+      base::Pair** const newPairs,
+      const unsigned int k,
+      base::PairStream* const newList)
+{
+    if (newList == nullptr) return;
+
+    if (k > 1) std::stable_sort(newPairs, newPairs + k, isPlayerBefore);
+
+    unsigned int first = 0;
+    for (unsigned int i = 0; i < k; i++) {
+        // Position of the first old player that the new player goes before
+        unsigned int pos = n;
+        if (first < n) {
+            pos = static_cast<unsigned int>(std::upper_bound(oldPairs + first, oldPairs + n, newPairs[i], isPlayerBefore) - oldPairs);
+        }
+
+        // Old players before the new player
+        while (first < pos) newList->put(oldPairs[first++]);
+
+        // and the new player
+        newList->put(newPairs[i]);
+    }
+
+    // The rest of the old players
+    while (first < n) newList->put(oldPairs[first++]);
+}
 
 //------------------------------------------------------------------------------
 // findPlayer() -- Find a player that matches 'id' and 'networkID'
@@ -1165,27 +1316,27 @@ AbstractPlayer* Simulation::findPlayerPrivate(const short id, const int netID) c
     // Quick out
     if (players == nullptr) return nullptr;
 
-    // Find a Player that matches player ID and Sources
+    // Find a Player that matches player ID and Sources using the list's index
     AbstractPlayer* iplayer = nullptr;
-    const base::List::Item* item = players->getFirstItem();
-    while (iplayer == nullptr && item != nullptr) {
-        const auto pair = static_cast<const base::Pair*>(item->getValue());
-        if (pair != nullptr) {
-            const auto ip = const_cast<AbstractPlayer*>(static_cast<const AbstractPlayer*>(pair->object()));
-            if (ip != nullptr) {
-                if (netID > 0) {
-                    if ((ip->getID() == id) && (ip->getNetworkID() == netID)) {
-                        iplayer = ip;
-                    }
-                }
-                else {
-                    if (ip->getID() == id) {
-                        iplayer = ip;
-                    }
+    const base::PairStream* pl = players.getRefPtr();
+    if (pl != nullptr) {
+        const auto playerList = dynamic_cast<const PlayerList*>(pl);
+        if (playerList != nullptr) {
+            iplayer = playerList->findPlayer(id, netID);
+        }
+        else {
+            // Not a PlayerList; scan the list
+            const base::List::Item* item = pl->getFirstItem();
+            while (iplayer == nullptr && item != nullptr) {
+                const auto pair = static_cast<const base::Pair*>(item->getValue());
+                const auto ip = const_cast<AbstractPlayer*>(static_cast<const AbstractPlayer*>(pair->object()));
+                if (ip != nullptr && ip->getID() == id && (netID <= 0 || ip->getNetworkID() == netID)) {
+                    iplayer = ip;
                 }
+                item = item->getNext();
             }
         }
-        item = item->getNext();
+        pl->unref();
     }
 
     return iplayer;
@@ -1209,18 +1360,25 @@ AbstractPlayer* Simulation::findPlayerByNamePrivate(const char* const playerName
     // Quick out
     if (players == nullptr || playerName == nullptr) return nullptr;
 
-    // Find a Player named 'playerName'
+    // Find a Player named 'playerName' using the list's index
     AbstractPlayer* iplayer = nullptr;
-    const base::List::Item* item = players->getFirstItem();
-    while (iplayer == nullptr && item != nullptr) {
-        const auto pair = static_cast<const base::Pair*>(item->getValue());
-        if (pair != nullptr) {
-            const auto ip = const_cast<AbstractPlayer*>(static_cast<const AbstractPlayer*>(pair->object()));
-            if (ip != nullptr && ip->isName(playerName)) {
-               iplayer = ip;
+    const base::PairStream* pl = players.getRefPtr();
+    if (pl != nullptr) {
+        const auto playerList = dynamic_cast<const PlayerList*>(pl);
+        if (playerList != nullptr) {
+            iplayer = playerList->findPlayerByName(playerName);
+        }
+        else {
+            // Not a PlayerList; scan the list
+            const base::List::Item* item = pl->getFirstItem();
+            while (iplayer == nullptr && item != nullptr) {
+                const auto pair = static_cast<const base::Pair*>(item->getValue());
+                const auto ip = const_cast<AbstractPlayer*>(static_cast<const AbstractPlayer*>(pair->object()));
+                if (ip != nullptr && ip->isName(playerName)) iplayer = ip;
+                item = item->getNext();
             }
         }
-        item = item->getNext();
+        pl->unref();
     }
 
     return iplayer;
@@ -1237,6 +1395,20 @@ bool Simulation::setInitialSimulationTime(const long time)
    return true;
 }
 
+// Sets the random number generator seed (used by the next reset())
+bool Simulation::setSeed(const unsigned int s)
+{
+   seed = s;
+   return true;
+}
+
+// Sets the ensemble replicate ID
+bool Simulation::setReplicateID(const unsigned int id)
+{
+   replicateID = id;
+   return true;
+}
+
 // Increment the cycle counter
 void Simulation::incCycle()
 {
@@ -1407,6 +1579,41 @@ bool Simulation::setSlotNumBgThreads(const base::Number* const msg)
    return ok;
 }
 
+bool Simulation::setSlotWorkStealing(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      workStealing = msg->getBoolean();
+      ok = true;
+   }
+   return ok;
+}
+
+bool Simulation::setSlotSeed(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int v = msg->getInt();
+      if (v >= 0) {
+         ok = setSeed( static_cast<unsigned int>(v) );
+      }
+      else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Simulation::setSlotSeed(): invalid seed; must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+bool Simulation::setSlotUpdatePlans(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      updatePlans = msg->getBoolean();
+      ok = true;
+   }
+   return ok;
+}
+
 }
 }
 
@@ -10,10 +10,13 @@
 
 #include "mixr/base/io/IoHandler.hpp"
 #include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/Identifier.hpp"
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/PairStream.hpp"
 #include "mixr/base/Timers.hpp"
+#include "mixr/base/Tracer.hpp"
 #include "mixr/base/units/Times.hpp"
+#include "mixr/base/util/system_utils.hpp"
 
 #include "mixr/simulation/StationTcThread.hpp"
 #include "mixr/simulation/StationBgThread.hpp"
@@ -49,6 +52,13 @@ BEGIN_SLOTTABLE(Station)
    "startupResetTimer", // 16: Startup (initial) RESET event timer value (base::Time) (default: no reset event)
    "enableUpdateTimers",// 17: Enable calling base::Timers::updateTimers() from updateTC() (default: false)
    "dataRecorder",      // 18) Our Data Recorder
+   "tcOverrunPolicy",   // 19: Time-critical thread overrun policy (catchUp, skipFrames or realDt)
+   "tcBusyWait",        // 20: Time-critical thread busy wait time (base::Time) (default: 0 -- no busy wait)
+   "batchMode",         // 21: Batch (as-fast-as-possible) mode (default: false)
+   "batchRunTime",      // 22: Batch mode simulated time of each run (base::Time) (default: 0 -- no time limit)
+   "trace",             // 23: Enable the tracing profiler (default: false)
+   "traceFile",         // 24: Trace file written by dumpTrace() and at shutdown
+   "traceOverrunFile",  // 25: Trace file written when a frame overruns
 END_SLOTTABLE(Station)
 
 BEGIN_SLOT_MAP(Station)
@@ -81,6 +91,16 @@ BEGIN_SLOT_MAP(Station)
    ON_SLOT(17,  setSlotEnableUpdateTimers,    base::Number)
 
    ON_SLOT(18, setDataRecorder,               AbstractDataRecorder)
+
+   ON_SLOT(19,  setSlotTimeCriticalOverrunPolicy, base::Identifier)
+   ON_SLOT(20,  setSlotTimeCriticalBusyWait,      base::Time)
+
+   ON_SLOT(21,  setSlotBatchMode,             base::Number)
+   ON_SLOT(22,  setSlotBatchRunTime,          base::Time)
+
+   ON_SLOT(23,  setSlotTrace,                 base::Number)
+   ON_SLOT(24,  setSlotTraceFile,             base::String)
+   ON_SLOT(25,  setSlotTraceOverrunFile,      base::String)
 END_SLOT_MAP()
 
 Station::Station()
@@ -148,6 +168,8 @@ void Station::copyData(const Station& org, const bool)
    tcPri = org.tcPri;
    tcStackSize = org.tcStackSize;
    fastForwardRate = org.fastForwardRate;
+   tcOverrunPolicy = org.tcOverrunPolicy;
+   tcBusyWait = org.tcBusyWait;
 
    netRate = org.netRate;
    netPri = org.netPri;
@@ -159,6 +181,13 @@ void Station::copyData(const Station& org, const bool)
 
    tmrUpdateEnbl = org.tmrUpdateEnbl;
 
+   batchMode = org.batchMode;
+   batchRunTime = org.batchRunTime;
+   batchRunning = false;
+   batchStopReq = false;
+
+   setSlotTraceFile(org.traceFile);
+
    if (org.startupResetTimer0!= nullptr) {
       base::Time* copy = org.startupResetTimer0->clone();
       setSlotStartupResetTime( copy );
@@ -200,6 +229,7 @@ void Station::deleteData()
    setSlotSimulation(nullptr);
    setSlotStartupResetTime(nullptr);
    setDataRecorder(nullptr);
+   setSlotTraceFile(nullptr);
 }
 
 //------------------------------------------------------------------------------
@@ -343,23 +373,26 @@ void Station::updateTC(const double dt)
 //------------------------------------------------------------------------------
 void Station::updateData(const double dt)
 {
+   // No threads in batch mode
+   const bool threads = !isBatchModeEnabled();
+
    // Create a background thread (if needed)
-   if (getBackgroundRate() > 0 && !doWeHaveTheBgThread()) {
+   if (threads && getBackgroundRate() > 0 && !doWeHaveTheBgThread()) {
       createBackgroundProcess();
    }
 
    // Our simulation model and OTW interfaces (if no separate thread)
-   if (getBackgroundRate() == 0 && !doWeHaveTheBgThread()) {
+   if ((!threads || getBackgroundRate() == 0) && !doWeHaveTheBgThread()) {
       processBackgroundTasks(dt);
    }
 
    // Create a network thread (if needed)
-   if (getNetworkRate() > 0 && networks != nullptr && !doWeHaveTheNetThread()) {
+   if (threads && getNetworkRate() > 0 && networks != nullptr && !doWeHaveTheNetThread()) {
       createNetworkProcess();
    }
 
    // Our interoperability networks (if no separate thread)
-   if (getNetworkRate() == 0 && networks != nullptr && !doWeHaveTheNetThread()) {
+   if ((!threads || getNetworkRate() == 0) && networks != nullptr && !doWeHaveTheNetThread()) {
       processNetworkInputTasks(dt);
       processNetworkOutputTasks(dt);
    }
@@ -378,6 +411,9 @@ void Station::updateData(const double dt)
 //------------------------------------------------------------------------------
 bool Station::shutdownNotification()
 {
+   // Write our trace
+   if (traceFile != nullptr) dumpTrace();
+
    // Tell the interoperability networks that we're shutting down
    if (networks != nullptr) {
       base::List::Item* item = networks->getFirstItem();
@@ -482,9 +518,13 @@ void Station::outputDevices(const double dt)
 //------------------------------------------------------------------------------
 void Station::createTimeCriticalProcess()
 {
-   if ( tcThread == nullptr ) {
-      tcThread = new TcThread(this, getTimeCriticalPriority(), getTimeCriticalRate());
-      tcThread->unref(); // 'tcThread' is a safe_ptr<>
+   // (no threads in batch mode; see runBatch())
+   if ( tcThread == nullptr && !isBatchModeEnabled() ) {
+      TcThread* p = new TcThread(this, getTimeCriticalPriority(), getTimeCriticalRate());
+      p->setOverrunPolicy( tcOverrunPolicy );
+      p->setBusyWaitTime( static_cast<unsigned int>(tcBusyWait * 1000000.0 + 0.5) );
+      tcThread = p;
+      p->unref(); // 'tcThread' is a safe_ptr<>
 
       if (tcStackSize > 0) tcThread->setStackSize( tcStackSize );
 
@@ -540,11 +580,104 @@ void Station::createBackgroundProcess()
    }
 }
 
+//------------------------------------------------------------------------------
+// runBatch() -- Batch mode: steps the T/C, background, network and data
+// recorder tasks in a lock-step loop, as fast as possible, until the run
+// is complete (see isBatchRunComplete())
+//------------------------------------------------------------------------------
+bool Station::runBatch()
+{
+   if (!isBatchModeEnabled() || isBatchRunning() || sim == nullptr || isShutdown()) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Station::runBatch(): ERROR, batch mode isn't enabled, is already running, or has no simulation!" << std::endl;
+      }
+      return false;
+   }
+
+   // Fixed delta time, and the number of frames per background and network step
+   const double tcHz = getTimeCriticalRate();
+   const double dt = 1.0 / tcHz;
+
+   unsigned int bgFrames = 1;
+   if (getBackgroundRate() > 0) bgFrames = static_cast<unsigned int>(tcHz / getBackgroundRate() + 0.5);
+   if (bgFrames < 1) bgFrames = 1;
+   const double bgDt = dt * bgFrames;
+
+   unsigned int netFrames = 1;
+   if (getNetworkRate() > 0) netFrames = static_cast<unsigned int>(tcHz / getNetworkRate() + 0.5);
+   if (netFrames < 1) netFrames = 1;
+   const double netDt = dt * netFrames;
+
+   batchRunning = true;
+   batchStopReq = false;
+   batchFrames = 0;
+   batchExecTime0 = sim->getExecTimeSec();
+   const double wallTime0 = base::getComputerTime();
+
+   bool done = false;
+   while (!done) {
+      const bool bgFrame = (batchFrames % bgFrames) == 0;
+      const bool netFrame = (networks != nullptr) && ((batchFrames % netFrames) == 0);
+
+      // Network inputs
+      if (netFrame) processNetworkInputTasks(netDt);
+
+      // Time-critical tasks
+      tcFrame(dt);
+
+      // Background tasks and the data recorder
+      if (bgFrame) {
+         processBackgroundTasks(bgDt);
+         BaseClass::updateData(bgDt);
+         if (dataRecorder != nullptr) dataRecorder->processRecords();
+      }
+
+      // Network outputs
+      if (netFrame) processNetworkOutputTasks(netDt);
+
+      batchFrames++;
+      done = isBatchRunComplete();
+   }
+
+   batchWallTime = base::getComputerTime() - wallTime0;
+   batchSimTime = (sim != nullptr) ? (sim->getExecTimeSec() - batchExecTime0) : (batchFrames * dt);
+   batchRunning = false;
+
+   if (isMessageEnabled(MSG_INFO)) {
+      std::cout << "Station::runBatch(): " << batchFrames << " frames, " << batchSimTime << " simulated seconds in ";
+      std::cout << batchWallTime << " seconds (" << getBatchSpeed() << " x real time)" << std::endl;
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// isBatchRunComplete() -- Batch run end condition: the run time has been
+// reached, stopBatch() has been called, or we're shutting down
+//------------------------------------------------------------------------------
+bool Station::isBatchRunComplete()
+{
+   bool done = batchStopReq || isShutdown() || (sim == nullptr);
+   if (!done && batchRunTime > 0) {
+      // (within half a frame of the run time)
+      const double runTime = sim->getExecTimeSec() - batchExecTime0;
+      done = (runTime >= (batchRunTime - 0.5 / getTimeCriticalRate()));
+   }
+   return done;
+}
+
+// Ends the batch run at the end of the current frame
+void Station::stopBatch()
+{
+   batchStopReq = true;
+}
+
 //------------------------------------------------------------------------------
 // processTimeCriticalTasks() -- Process T/C tasks
 //------------------------------------------------------------------------------
 void Station::processTimeCriticalTasks(const double dt)
 {
+   MIXR_TRACE_ZONE("Station::processTimeCriticalTasks");
    for (unsigned int jj = 0; jj < getFastForwardRate(); jj++) {
       tcFrame( dt );
    }
@@ -555,6 +688,8 @@ void Station::processTimeCriticalTasks(const double dt)
 //------------------------------------------------------------------------------
 void Station::processBackgroundTasks(const double dt)
 {
+   MIXR_TRACE_ZONE("Station::processBackgroundTasks");
+
    // Note: interoperability networks are handled by
    // processNetworkInputTasks() and processNetworkOutputTasks()
 
@@ -582,6 +717,9 @@ void Station::processBackgroundTasks(const double dt)
          item = item->getNext();
       }
    }
+
+   // The tracer's overrun dump, if it was requested
+   base::Tracer::processRequests();
 }
 
 
@@ -597,6 +735,7 @@ void Station::processNetworkInputTasks(const double dt)
          const auto pair = static_cast<base::Pair*>(item->getValue());
          const auto p = static_cast<AbstractNetIO*>(pair->object());
 
+         MIXR_TRACE_ZONE("NetIO::inputFrame");
          p->inputFrame( dt );
 
          item = item->getNext();
@@ -616,6 +755,7 @@ void Station::processNetworkOutputTasks(const double dt)
          const auto pair = static_cast<base::Pair*>(item->getValue());
          const auto p = static_cast<AbstractNetIO*>(pair->object());
 
+         MIXR_TRACE_ZONE("NetIO::outputFrame");
          p->outputFrame( dt );
 
          item = item->getNext();
@@ -735,12 +875,89 @@ unsigned int Station::getTimeCriticalStackSize() const
    return tcStackSize;
 }
 
+// Time-critical thread overrun policy
+base::PeriodicTask::OverrunPolicy Station::getTimeCriticalOverrunPolicy() const
+{
+   return tcOverrunPolicy;
+}
+
+// Time-critical thread busy wait time (seconds)
+double Station::getTimeCriticalBusyWait() const
+{
+   return tcBusyWait;
+}
+
+// Batch mode enabled?
+bool Station::isBatchModeEnabled() const
+{
+   return batchMode;
+}
+
+// Simulated time of each batch run (seconds; zero if no time limit)
+double Station::getBatchRunTime() const
+{
+   return batchRunTime;
+}
+
+// Is runBatch() running?
+bool Station::isBatchRunning() const
+{
+   return batchRunning;
+}
+
+// Number of frames of the last batch run
+unsigned int Station::getBatchFrames() const
+{
+   return batchFrames;
+}
+
+// Simulated time of the last batch run (seconds)
+double Station::getBatchSimTime() const
+{
+   return batchSimTime;
+}
+
+// Wall clock time of the last batch run (seconds)
+double Station::getBatchWallTime() const
+{
+   return batchWallTime;
+}
+
+// Simulated seconds per wall clock second of the last batch run
+double Station::getBatchSpeed() const
+{
+   double speed = 0.0;
+   if (batchWallTime > 0.0) speed = batchSimTime / batchWallTime;
+   return speed;
+}
+
+//------------------------------------------------------------------------------
+// dumpTrace() -- Writes the tracing profiler's zones to our trace file
+//------------------------------------------------------------------------------
+bool Station::dumpTrace()
+{
+   bool ok = false;
+   if (traceFile != nullptr) {
+      ok = base::Tracer::dump(*traceFile);
+      if (!ok && isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "Station::dumpTrace(): unable to write the trace file: " << *traceFile << std::endl;
+      }
+   }
+   return ok;
+}
+
 // Do we have a T/C thread?
 bool Station::doWeHaveTheTcThread() const
 {
    return (tcThread != nullptr);
 }
 
+// Time-critical thread frame statistics
+bool Station::getTimeCriticalFrameStats(base::PeriodicTask::FrameStats* const stats) const
+{
+   return getFrameStats(tcThread.getRefPtr(), stats);
+}
+
 // Pre-ref() pointer to the T/Cthread
 base::Thread* Station::getTcThread()
 {
@@ -775,6 +992,12 @@ bool Station::doWeHaveTheBgThread() const
    return (bgThread != nullptr);
 }
 
+// Background thread frame statistics
+bool Station::getBackgroundFrameStats(base::PeriodicTask::FrameStats* const stats) const
+{
+   return getFrameStats(bgThread.getRefPtr(), stats);
+}
+
 // Pre-ref() pointer to the Background thread
 base::Thread* Station::getBgThread()
 {
@@ -809,6 +1032,27 @@ bool Station::doWeHaveTheNetThread() const
    return (netThread != nullptr);
 }
 
+// Network thread frame statistics
+bool Station::getNetworkFrameStats(base::PeriodicTask::FrameStats* const stats) const
+{
+   return getFrameStats(netThread.getRefPtr(), stats);
+}
+
+// Frame statistics of a (pre-ref()'d) thread, if it's a periodic task
+bool Station::getFrameStats(const base::Thread* const thread, base::PeriodicTask::FrameStats* const stats)
+{
+   bool ok = false;
+   if (thread != nullptr) {
+      const auto p = dynamic_cast<const base::PeriodicTask*>(thread);
+      if (p != nullptr && stats != nullptr) {
+         p->getFrameStats(stats);
+         ok = true;
+      }
+      thread->unref();
+   }
+   return ok;
+}
+
 // Pre-ref() pointer to the Network thread
 base::Thread* Station::getNetThread()
 {
@@ -834,6 +1078,29 @@ bool Station::setUpdateTimersEnable(const bool enb)
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Set batch mode and the batch run time
+//------------------------------------------------------------------------------
+bool Station::setBatchMode(const bool enb)
+{
+   bool ok = false;
+   if (!isBatchRunning() && (!enb || (tcThread == nullptr && netThread == nullptr && bgThread == nullptr))) {
+      batchMode = enb;
+      ok = true;
+   }
+   return ok;
+}
+
+bool Station::setBatchRunTime(const double secs)
+{
+   bool ok = false;
+   if (secs >= 0.0) {
+      batchRunTime = secs;
+      ok = true;
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // Set thread stack sizes
 //------------------------------------------------------------------------------
@@ -855,6 +1122,25 @@ bool Station::setBackgroundStackSize(const unsigned int bytes)
    return true;
 }
 
+//------------------------------------------------------------------------------
+// Set the time-critical thread's overrun policy and busy wait time
+//------------------------------------------------------------------------------
+bool Station::setTimeCriticalOverrunPolicy(const base::PeriodicTask::OverrunPolicy p)
+{
+   tcOverrunPolicy = p;
+   return true;
+}
+
+bool Station::setTimeCriticalBusyWait(const double secs)
+{
+   bool ok = false;
+   if (secs >= 0.0) {
+      tcBusyWait = secs;
+      ok = true;
+   }
+   return ok;
+}
+
 //------------------------------------------------------------------------------
 // Set thread handle functions
 //------------------------------------------------------------------------------
@@ -1200,6 +1486,45 @@ bool Station::setSlotTimeCriticalStackSize(const base::Number* const num)
 }
 
 
+//------------------------------------------------------------------------------
+// setSlotTimeCriticalOverrunPolicy() -- Sets the T/C thread overrun policy
+//------------------------------------------------------------------------------
+bool Station::setSlotTimeCriticalOverrunPolicy(const base::Identifier* const msg)
+{
+    bool ok = false;
+    if (msg != nullptr) {
+        if (*msg == "catchUp") {
+            ok = setTimeCriticalOverrunPolicy( base::PeriodicTask::CATCH_UP );
+        }
+        else if (*msg == "skipFrames") {
+            ok = setTimeCriticalOverrunPolicy( base::PeriodicTask::SKIP_FRAMES );
+        }
+        else if (*msg == "realDt") {
+            ok = setTimeCriticalOverrunPolicy( base::PeriodicTask::REAL_DT );
+        }
+        else {
+            std::cerr << "Station::setSlotTimeCriticalOverrunPolicy: Invalid policy; use catchUp, skipFrames or realDt" << std::endl;
+        }
+    }
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+// setSlotTimeCriticalBusyWait() -- Sets the T/C thread busy wait time
+//------------------------------------------------------------------------------
+bool Station::setSlotTimeCriticalBusyWait(const base::Time* const msg)
+{
+    bool ok = false;
+    if (msg != nullptr) {
+        ok = setTimeCriticalBusyWait( base::Seconds::convertStatic(*msg) );
+        if (!ok) {
+            std::cerr << "Station::setSlotTimeCriticalBusyWait: Busy wait time must be zero or greater" << std::endl;
+        }
+    }
+    return ok;
+}
+
+
 //------------------------------------------------------------------------------
 // setSlotNetworkRate() -- Sets the network thread rate (hz)
 //------------------------------------------------------------------------------
@@ -1359,5 +1684,69 @@ bool Station::setSlotEnableUpdateTimers(const base::Number* const msg)
    return ok;
 }
 
+//------------------------------------------------------------------------------
+// setSlotBatchMode() -- Enables batch (as-fast-as-possible) mode
+//------------------------------------------------------------------------------
+bool Station::setSlotBatchMode(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setBatchMode( msg->getBoolean() );
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// setSlotBatchRunTime() -- Sets the simulated time of each batch run
+//------------------------------------------------------------------------------
+bool Station::setSlotBatchRunTime(const base::Time* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      ok = setBatchRunTime( base::Seconds::convertStatic(*msg) );
+      if (!ok) {
+         std::cerr << "Station::setSlotBatchRunTime: Run time must be zero or greater" << std::endl;
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// setSlotTrace() -- Enables the tracing profiler
+//------------------------------------------------------------------------------
+bool Station::setSlotTrace(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      base::Tracer::setEnabled( msg->getBoolean() );
+      ok = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// setSlotTraceFile() -- Sets the trace file (see dumpTrace())
+//------------------------------------------------------------------------------
+bool Station::setSlotTraceFile(const base::String* const msg)
+{
+   if (traceFile != nullptr) traceFile->unref();
+   traceFile = nullptr;
+   if (msg != nullptr) traceFile = msg->clone();
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// setSlotTraceOverrunFile() -- Sets the tracer's frame overrun file
+//------------------------------------------------------------------------------
+bool Station::setSlotTraceOverrunFile(const base::String* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      base::Tracer::setOverrunFile(*msg);
+      ok = true;
+   }
+   return ok;
+}
+
 }
 }
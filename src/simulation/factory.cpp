@@ -1,8 +1,10 @@
 
 #include "mixr/simulation/factory.hpp"
 
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 
+#include "mixr/simulation/Ensemble.hpp"
 #include "mixr/simulation/Simulation.hpp"
 #include "mixr/simulation/Station.hpp"
 
@@ -11,18 +13,21 @@
 namespace mixr {
 namespace simulation {
 
-base::Object* factory(const std::string& name)
-{
-    base::Object* obj {};
+namespace {
 
-    if ( name == Simulation::getFactoryName() ) {
-        obj = new Simulation();
-    }
-    else if ( name == Station::getFactoryName() ) {
-        obj = new Station();
-    }
+const base::FactoryTable::Entry entries[] = {
+    FACTORY_ENTRY(Simulation),
+    FACTORY_ENTRY(Station),
+    FACTORY_ENTRY(Ensemble),
+};
 
-    return obj;
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+
+}
+
+base::Object* factory(const std::string& name)
+{
+    return table.create(name);
 }
 
 }
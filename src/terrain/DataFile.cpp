@@ -2,6 +2,7 @@
 #include "mixr/terrain/DataFile.hpp"
 
 #include "mixr/base/network/NetHandler.hpp"
+#include "mixr/base/util/atomics.hpp"
 #include "mixr/base/units/angle_utils.hpp"
 #include "mixr/base/units/distance_utils.hpp"
 
@@ -11,6 +12,28 @@ namespace terrain {
 IMPLEMENT_ABSTRACT_SUBCLASS(DataFile, "DataFile")
 EMPTY_SLOTTABLE(DataFile)
 
+//------------------------------------------------------------------------------
+// Reference counted owner of the elevation data columns, which are shared
+// by a data file and its copies
+//------------------------------------------------------------------------------
+class DataFile::SharedColumns : public base::Referenced
+{
+public:
+   SharedColumns(short** const c, const unsigned int n) : columns(c), ncols(n) {}
+
+   virtual ~SharedColumns()
+   {
+      for (unsigned int i = 0; i < ncols; i++) {
+         delete[] columns[i];
+      }
+      delete[] columns;
+   }
+
+private:
+   short** columns;        // Array of data columns
+   unsigned int ncols;     // Number of columns
+};
+
 DataFile::DataFile()
 {
    STANDARD_CONSTRUCTOR()
@@ -30,19 +53,17 @@ void DataFile::copyData(const DataFile& org, const bool)
 
    if (org.columns != nullptr && org.nptlat > 0 && org.nptlong > 0) {
 
-      // Allocate memory space for the elevation data and copy the data
-      columns = new short*[nptlong];
-      for (unsigned int i = 0; i < nptlong; i++) {
-         if (org.columns[i] != nullptr) {
-            columns[i] = new short[nptlat];
-            for (unsigned int j = 0; j < nptlat; j++) {
-               columns[i][j] = org.columns[i][j];
-            }
-         }
-         else {
-            columns[i] = nullptr;
-         }
+      // Share the elevation data; the first copy hands the original's
+      // columns over to a shared owner
+      base::lock( org.semaphore );
+      if (org.shared == nullptr) {
+         org.shared = new SharedColumns(org.columns, org.nptlong);
       }
+      shared = org.shared;
+      shared->ref();
+      base::unlock( org.semaphore );
+
+      columns = org.columns;
 
    } // end columns check
 
@@ -97,6 +118,12 @@ double DataFile::getLonSpacing() const
    return v;
 }
 
+// Value representing a void (missing) data point
+short DataFile::getVoidValue() const
+{
+   return voidValue;
+}
+
 const short* DataFile::getColumn(const unsigned int idx) const
 {
    const short* p = nullptr;
@@ -403,6 +430,15 @@ bool DataFile::computeLongitude(double* const lon, const unsigned int icol) cons
 //------------------------------------------------------------------------------
 void DataFile::clearData()
 {
+   // Release the shared columns of data
+   if (shared != nullptr) {
+      base::lock( semaphore );
+      shared->unref();
+      shared = nullptr;
+      columns = nullptr;
+      base::unlock( semaphore );
+   }
+
    // Delete the columns of data
    if (columns != nullptr) {
       // Delete the columns of data
@@ -9,6 +9,7 @@
 #include "mixr/base/Pair.hpp"
 #include "mixr/base/String.hpp"
 
+#include "mixr/base/units/angle_utils.hpp"
 #include "mixr/base/util/nav_utils.hpp"
 
 #include "mixr/base/osg/Vec2d"
@@ -246,6 +247,140 @@ bool Terrain::targetOcculting(
    return occulted;
 }
 
+//------------------------------------------------------------------------------
+// Batch target occulting: sets occulted[i] true if the target point
+// [ tgtLat[i] tgtLon[i] tgtAlt[i] ] is occulted by the terrain as seen from the
+// ref point [ refLat refLon refAlt ].
+//
+// The targets are checked farthest first, and a nearer target that's on about
+// the same bearing as an earlier (farther) one reuses the front of that
+// target's elevation profile, so each ray is sampled once for all of the
+// targets along it.  The bearings match if the nearer target is within half
+// of a profile's point spacing of the profile's ray, and the nearer target is
+// checked against the profile's points up to its range, which is rounded to
+// the nearest point; i.e., the same sampling error as the single target
+// check.  The farthest target on each ray gets the same result as
+// targetOcculting().
+//------------------------------------------------------------------------------
+void Terrain::targetsOcculting(
+      bool* const occulted,          // Occulted flags (true if the target is occulted)
+      const unsigned int n,          // Number of targets
+      const double refLat,           // Ref latitude (degs)
+      const double refLon,           // Ref longitude (degs)
+      const double refAlt,           // Ref altitude (meters)
+      const double* const tgtLat,    // Target latitudes (degs)
+      const double* const tgtLon,    // Target longitudes (degs)
+      const double* const tgtAlt     // Target altitudes (meters)
+   ) const
+{
+   // 1200 points gives us 100 meter data up to a distance
+   // of one degree at the equator
+   static const unsigned int MAX_POINTS = 1200;
+
+   // Targets are sorted and checked in blocks of up to BLOCK_SIZE
+   static const unsigned int BLOCK_SIZE = 64;
+
+   // Number of elevation profiles (rays) that are kept for each block
+   static const unsigned int MAX_PROFILES = 4;
+
+   if (occulted == nullptr || tgtLat == nullptr || tgtLon == nullptr || tgtAlt == nullptr) return;
+
+   // Elevation profile along a ray and its valid flags
+   struct Profile {
+      double elevations[MAX_POINTS];
+      bool validFlags[MAX_POINTS];
+      double brg;                // Bearing of the ray (degs)
+      double dist;               // Range to the last point (meters)
+      double spacing;            // Spacing between the points (meters)
+      unsigned int numPts;       // Number of points
+      unsigned int num;          // Number of elevations found
+   };
+   Profile profiles[MAX_PROFILES];
+
+   // Bearing, distance and number of points to each target of the block
+   double brgs[BLOCK_SIZE];
+   double dists[BLOCK_SIZE];
+   unsigned int pts[BLOCK_SIZE];
+   unsigned int order[BLOCK_SIZE];
+
+   for (unsigned int i0 = 0; i0 < n; i0 += BLOCK_SIZE) {
+
+      unsigned int m = n - i0;
+      if (m > BLOCK_SIZE) m = BLOCK_SIZE;
+
+      // Compute bearings and distances to the targets (flat earth)
+      for (unsigned int k = 0; k < m; k++) {
+         const unsigned int i = i0 + k;
+         occulted[i] = false;
+
+         double brgDeg = 0.0;
+         double distNM = 0.0;
+         base::nav::fll2bd(refLat, refLon, tgtLat[i], tgtLon[i], &brgDeg, &distNM);
+         brgs[k] = brgDeg;
+         dists[k] = (distNM * base::distance::NM2M);
+
+         // Number of points (default: 100M data)
+         unsigned int numPts = static_cast<unsigned int>((dists[k] / 100.0f) + 0.5f);
+         if (numPts > MAX_POINTS) numPts = MAX_POINTS;
+         pts[k] = numPts;
+
+         // Sort by distance, farthest first
+         unsigned int j = k;
+         while (j > 0 && dists[order[j-1]] < dists[k]) {
+            order[j] = order[j-1];
+            j--;
+         }
+         order[j] = k;
+      }
+
+      // Check the targets
+      unsigned int numProfiles = 0;
+      unsigned int nextProfile = 0;
+      for (unsigned int j = 0; j < m; j++) {
+         const unsigned int k = order[j];
+         if (pts[k] <= 1) continue;
+
+         // Look for a ray that passes within half a point spacing of the target
+         const Profile* prof = nullptr;
+         for (unsigned int p = 0; p < numProfiles && prof == nullptr; p++) {
+            const double dBrg = base::angle::aepcdDeg(brgs[k] - profiles[p].brg) * base::angle::D2RCC;
+            if (std::fabs(dBrg) * dists[k] <= (profiles[p].spacing * 0.5)) prof = &profiles[p];
+         }
+
+         if (prof == nullptr) {
+            // Get the elevations along the ray to this target (the oldest
+            // profile is replaced once they're all in use)
+            Profile* const np = &profiles[nextProfile];
+            nextProfile = (nextProfile + 1) % MAX_PROFILES;
+            if (numProfiles < MAX_PROFILES) numProfiles++;
+
+            for (unsigned int q = 0; q < pts[k]; q++) { np->validFlags[q] = false; }
+            np->num = getElevations(np->elevations, np->validFlags, pts[k], refLat, refLon, brgs[k], dists[k], false);
+            np->brg = brgs[k];
+            np->dist = dists[k];
+            np->numPts = pts[k];
+            np->spacing = dists[k] / (pts[k] - 1);
+            prof = np;
+         }
+
+         // And check occulting against the points up to the target
+         if (prof->num > 0) {
+            unsigned int numPts = prof->numPts;
+            double range = prof->dist;
+            if (dists[k] < prof->dist) {
+               numPts = static_cast<unsigned int>((dists[k] / prof->spacing) + 0.5) + 1;
+               if (numPts > prof->numPts) numPts = prof->numPts;
+               range = (numPts - 1) * prof->spacing;
+            }
+            if (numPts > 1) {
+               const double tgtTan = (tgtAlt[i0 + k] - refAlt) / dists[k];
+               occulted[i0 + k] = occultCheck2(prof->elevations, prof->validFlags, numPts, range, refAlt, tgtTan);
+            }
+         }
+      }
+   }
+}
+
 //------------------------------------------------------------------------------
 // Target occulting #2: returns true if any terrain in the 'truBrg' direction
 // for 'dist' meters occults (or masks) a target with a look angle of atan(tanLookAng)
@@ -305,47 +440,18 @@ bool Terrain::occultCheck(
       const double refAlt,             // Ref altitude (meters)
       const double tgtAlt)             // Target altitude (meters)
 {
-   bool occulted = false;
-
    // Early out checks
    if (  elevations == nullptr ||    // The elevation array wasn't provided, or
          n < 2 ||              // there are too few points, or
          range <= 0            // the range is less than or equal to zero
-         ) return occulted;
+         ) return false;
 
    // Tangent of the angle to the target point --
    // If the angle to any terrain point is greater than this
    // angle then the target is occulted by the terrain point
    const double tgtTan = (tgtAlt - refAlt) / range;
 
-   // Loop through all elevation points looking for an angle
-   // that's greater than our ref angle
-   const double deltaRng = (range / (n - 1));
-   double currentRange = 0;
-   if (validFlags != nullptr) {
-      // with valid flags
-      for (unsigned int i = 1; i < (n-1) && !occulted; i++) {
-         currentRange += deltaRng;
-         if (validFlags[i]) {
-            const double tstTan = (elevations[i] - refAlt) / currentRange;
-            if (tstTan >= tgtTan) {
-               occulted = true;
-            }
-         }
-      }
-   }
-   else {
-      // without valid flags
-      for (unsigned int i = 1; i < (n-1) && !occulted; i++) {
-         currentRange += deltaRng;
-         const double tstTan = (elevations[i] - refAlt) / currentRange;
-         if (tstTan >= tgtTan) {
-            occulted = true;
-         }
-      }
-   }
-
-   return occulted;
+   return tangentCheck(elevations, validFlags, n, range, refAlt, tgtTan);
 }
 
 //------------------------------------------------------------------------------
@@ -361,38 +467,63 @@ bool Terrain::occultCheck2(
       const double refAlt,          // Ref altitude (meters)
       const double tanLookAng)      // Tangent of the look angle
 {
-   bool occulted = false;
-
    // Early out checks
    if (  elevations == nullptr ||   // The elevation array wasn't provided, or
          n < 2 ||                   // there are too few points, or
          range <= 0                 // the range is less than or equal to zero
-         ) return occulted;
+         ) return false;
+
+   return tangentCheck(elevations, validFlags, n, range, refAlt, tanLookAng);
+}
+
+//------------------------------------------------------------------------------
+// Tangent check: returns true if the tangent of the angle (from level) to any
+// of the inner elevation points, [1 .. n-2], as seen from the ref altitude is
+// greater than or equal to 'tanAng'.
+//
+// The points are checked in blocks without any branches, so the compiler is
+// able to vectorize the checks, and we early out between the blocks.  The
+// ranges to the points are accumulated the same as a point by point check.
+//------------------------------------------------------------------------------
+bool Terrain::tangentCheck(
+      const double* const elevations, // The elevation array (meters)
+      const bool* const validFlags,   // (Optional) Valid elevation flag array (true if elevation was found)
+      const unsigned int n,           // Size of the arrays
+      const double range,             // Range (meters)
+      const double refAlt,            // Ref altitude (meters)
+      const double tanAng)            // Tangent of the angle
+{
+   static const unsigned int BLOCK_SIZE = 16;
+
+   bool occulted = false;
 
-   // Loop through all elevation points looking for an angle
-   // that's greater than our ref angle
    const double deltaRng = (range / (n - 1));
    double currentRange = 0;
-   if (validFlags != nullptr) {
-      // with valid flags
-      for (unsigned int i = 1; i < (n-1) && !occulted; i++) {
+   double ranges[BLOCK_SIZE];
+   for (unsigned int i0 = 1; i0 < (n-1) && !occulted; i0 += BLOCK_SIZE) {
+
+      unsigned int m = (n-1) - i0;
+      if (m > BLOCK_SIZE) m = BLOCK_SIZE;
+
+      for (unsigned int k = 0; k < m; k++) {
          currentRange += deltaRng;
-         if (validFlags[i]) {
-            const double tstTan = (elevations[i] - refAlt) / currentRange;
-            if (tstTan >= tanLookAng) {
-               occulted = true;
-            }
+         ranges[k] = currentRange;
+      }
+
+      const double* const elev = elevations + i0;
+      int hits = 0;
+      if (validFlags != nullptr) {
+         const bool* const valid = validFlags + i0;
+         for (unsigned int k = 0; k < m; k++) {
+            hits |= (valid[k] & (((elev[k] - refAlt) / ranges[k]) >= tanAng));
          }
       }
-   } else {
-      // without valid flags
-      for (unsigned int i = 1; i < (n-1) && !occulted; i++) {
-         currentRange += deltaRng;
-         const double tstTan = (elevations[i] - refAlt) / currentRange;
-         if (tstTan >= tanLookAng) {
-            occulted = true;
+      else {
+         for (unsigned int k = 0; k < m; k++) {
+            hits |= (((elev[k] - refAlt) / ranges[k]) >= tanAng);
          }
       }
+      occulted = (hits != 0);
    }
 
    return occulted;
@@ -0,0 +1,775 @@
+
+#include "mixr/terrain/TiledFile.hpp"
+
+#include "mixr/terrain/DataFile.hpp"
+
+#include "mixr/base/numeric/Number.hpp"
+#include "mixr/base/units/angle_utils.hpp"
+#include "mixr/base/units/distance_utils.hpp"
+#include "mixr/base/util/atomics.hpp"
+
+#if defined(WIN32)
+   #include "mixr/base/util/platform_api.hpp"
+#else
+   #include <sys/mman.h>
+   #include <sys/stat.h>
+   #include <fcntl.h>
+   #include <unistd.h>
+#endif
+
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <cmath>
+
+namespace mixr {
+namespace terrain {
+
+//==============================================================================
+// Tiled file format
+//
+//    [FileHeader]
+//    [tile index]    -- one std::uint32_t per tile (column major by tile);
+//                       stored tile slot number plus one, or zero if the tile
+//                       isn't stored
+//    [tiles]         -- starting at 'dataOffset'; TILE_SIZE x TILE_SIZE shorts
+//                       per tile, column major (i.e., [icol][irow])
+//
+//    Tile and post indices start at the southwest corner of the mosaic.
+//==============================================================================
+namespace {
+
+const char FILE_MAGIC[8] = { 'M', 'I', 'X', 'R', 'T', 'I', 'L', 'E' };
+const std::uint32_t FILE_BYTE_ORDER = 0x01020304;
+const std::uint32_t FILE_VERSION = 1;
+const std::uint64_t FILE_ALIGNMENT = 65536;   // Tile data alignment (bytes)
+
+struct FileHeader {
+   char magic[8];                // FILE_MAGIC
+   std::uint32_t byteOrder;      // FILE_BYTE_ORDER
+   std::uint32_t version;        // FILE_VERSION
+   std::uint32_t tileSize;       // TILE_SIZE
+   std::uint32_t nptlat;         // Number of points in latitude (rows)
+   std::uint32_t nptlong;        // Number of points in longitude (columns)
+   std::uint32_t ntlat;          // Number of tile rows
+   std::uint32_t ntlong;         // Number of tile columns
+   std::uint32_t numTiles;       // Number of stored tiles
+   std::uint64_t dataOffset;     // Offset to the first tile (bytes)
+   double swLat;                 // Southwest corner latitude (degs)
+   double swLon;                 // Southwest corner longitude (degs)
+   double latSpacing;            // Spacing between latitude points (degs)
+   double lonSpacing;            // Spacing between longitude points (degs)
+   double minElev;               // Minimum elevation (meters)
+   double maxElev;               // Maximum elevation (meters)
+   std::int32_t voidValue;       // Void (missing) data point value
+   std::uint32_t spare;
+};
+
+const std::uint64_t TILE_BYTES = TiledFile::TILE_SIZE * TiledFile::TILE_SIZE * sizeof(short);
+
+std::uint64_t alignUp(const std::uint64_t v, const std::uint64_t a)
+{
+   return ((v + a - 1) / a) * a;
+}
+
+// Placement of a data file's posts within the mosaic (convert())
+struct Placement {
+   unsigned int row0;            // Mosaic row of the file's first (south) row
+   unsigned int col0;            // Mosaic column of the file's first (west) column
+   unsigned int row1;            // Mosaic row of the file's last (north) row
+   unsigned int col1;            // Mosaic column of the file's last (east) column
+   double rowScale;              // Mosaic to file row scale (mosaic / file latitude spacing)
+   double colScale;              // Mosaic to file column scale (mosaic / file longitude spacing)
+};
+
+}
+
+IMPLEMENT_SUBCLASS(TiledFile, "TiledFile")
+
+BEGIN_SLOTTABLE(TiledFile)
+   "maxTiles",       // 1) Max number of resident tiles (default: 256)
+END_SLOTTABLE(TiledFile)
+
+BEGIN_SLOT_MAP(TiledFile)
+   ON_SLOT(1, setSlotMaxTiles, base::Number)
+END_SLOT_MAP()
+
+TiledFile::TiledFile()
+{
+   STANDARD_CONSTRUCTOR()
+}
+
+void TiledFile::copyData(const TiledFile& org, const bool)
+{
+   BaseClass::copyData(org);
+
+   maxTiles = org.maxTiles;
+
+   // Map our own view of the file
+   if (org.isDataLoaded()) {
+      loadData();
+   }
+}
+
+void TiledFile::deleteData()
+{
+   clearData();
+}
+
+//------------------------------------------------------------------------------
+// Slot functions
+//------------------------------------------------------------------------------
+bool TiledFile::setSlotMaxTiles(const base::Number* const msg)
+{
+   bool ok = false;
+   if (msg != nullptr) {
+      const int v = msg->getInt();
+      if (v > 0 && !isDataLoaded()) {
+         maxTiles = static_cast<unsigned int>(v);
+         ok = true;
+      }
+      else if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "TiledFile::setSlotMaxTiles(): invalid number of tiles, or the data is already loaded" << std::endl;
+      }
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+// Access functions
+//------------------------------------------------------------------------------
+
+// Has the data been loaded
+bool TiledFile::isDataLoaded() const
+{
+   return (mapAddr != nullptr);
+}
+
+//------------------------------------------------------------------------------
+// Locates an array of (at least two) elevation points (and sets valid flags if found)
+// returns the number of points found within this TiledFile
+//------------------------------------------------------------------------------
+unsigned int TiledFile::getElevations(
+      double* const elevations,     // The elevation array (meters)
+      bool* const validFlags,       // Valid elevation flag array (true if elevation was found)
+      const unsigned int n,         // Size of elevation and valdFlags arrays
+      const double lat,             // Starting latitude (degs)
+      const double lon,             // Starting longitude (degs)
+      const double direction,       // True direction (heading) angle of the data (degs)
+      const double maxRng,          // Range to last elevation point (meters)
+      const bool interp            // Interpolate between elevation posts (if true)
+   ) const
+{
+   unsigned int num = 0;
+
+   // Early out tests
+   if ( !isDataLoaded() ||             // Not loaded, or
+        elevations == nullptr ||       // the elevation array wasn't provided, or
+        validFlags == nullptr ||       // the valid flag array wasn't provided, or
+        n < 2 ||                       // there are too few points, or
+        (lat < -89.0 || lat > 89.0) || // and we're not starting at the north or south poles
+        maxRng <= 0                    // the max range is less than or equal to zero
+      ) return num;
+
+   // Upper limit points
+   const double maxLatPoint = static_cast<double>(nptlat-1);
+   const double maxLonPoint = static_cast<double>(nptlong-1);
+
+   // Starting points
+   double pointsLat = (lat - getLatitudeSW()) / latSpacing;
+   double pointsLon = (lon - getLongitudeSW()) / lonSpacing;
+
+   // Spacing between points (in each direction)
+   const double deltaPoint = maxRng / (n - 1);
+   const double dirR = direction * base::angle::D2RCC;
+   const double deltaNorth = deltaPoint * std::cos(dirR) * base::distance::M2NM;  // (NM)
+   const double deltaEast  = deltaPoint * std::sin(dirR) * base::distance::M2NM;
+   const double deltaLat = deltaNorth/60.0;
+   const double deltaLon = deltaEast/(60.0 * std::cos(lat * base::angle::D2RCC));
+   const double deltaPointsLat = deltaLat / latSpacing;
+   const double deltaPointsLon = deltaLon / lonSpacing;
+
+   // ---
+   // Loop for the number of points in the arrays;
+   // ---
+   for (unsigned int i = 0; i < n; i++) {
+
+      if ( !validFlags[i] &&                                // Not already found and
+          (pointsLat >= 0 && pointsLat <= maxLatPoint) &&   // and within latitude range and
+          (pointsLon >= 0 && pointsLon <= maxLonPoint) ) {  // and within longitude range ...
+
+         double value = 0;          // the elevation (meters)
+         bool found = false;
+
+         if (interp) {
+            // South-west corner post is [icol][irow]
+            unsigned int irow = static_cast<unsigned int>(pointsLat);
+            unsigned int icol = static_cast<unsigned int>(pointsLon);
+            if (irow > (nptlat-2)) irow = (nptlat-2);
+            if (icol > (nptlong-2)) icol = (nptlong-2);
+
+            short sw {}, nw {}, se {}, ne {};
+            if ( getPost(&sw, icol, irow)   && getPost(&nw, icol, irow+1) &&
+                 getPost(&se, icol+1, irow) && getPost(&ne, icol+1, irow+1) ) {
+
+               // delta from s-w corner post
+               const double dLat = static_cast<double>(pointsLat - static_cast<double>(irow));
+               const double dLon = static_cast<double>(pointsLon - static_cast<double>(icol));
+
+               const double westPoint = sw + (nw - sw) * dLat;
+               const double eastPoint = se + (ne - se) * dLat;
+               value = westPoint + (eastPoint - westPoint) * dLon;
+               found = true;
+            }
+         }
+         else {
+            // Nearest post
+            unsigned int irow = static_cast<unsigned int>(pointsLat + 0.5);
+            unsigned int icol = static_cast<unsigned int>(pointsLon + 0.5);
+            if (irow >= nptlat) irow = (nptlat-1);
+            if (icol >= nptlong) icol = (nptlong-1);
+
+            short v {};
+            if (getPost(&v, icol, irow)) {
+               value = static_cast<double>(v);
+               found = true;
+            }
+         }
+
+         if (found) {
+            elevations[i] = value;
+            validFlags[i] = true;
+            num++;
+         }
+
+      } // end lat/lon point checks
+
+      // Update our location within our data array
+      pointsLat += deltaPointsLat;
+      pointsLon += deltaPointsLon;
+
+   } // end loop
+
+   return num;
+}
+
+//------------------------------------------------------------------------------
+// Locates an elevation value (meters) for a given reference point and returns
+// it in 'elev'.  Function returns true if successful, otherwise 'elev' is unchanged.
+//------------------------------------------------------------------------------
+bool TiledFile::getElevation(
+      double* const elev,     // The elevation value (meters)
+      const double lat,       // Reference latitude (degs)
+      const double lon,       // Reference longitude (degs)
+      const bool interp       // Interpolate between elevation posts (if true)
+   ) const
+{
+   // Early out tests
+   if ( !isDataLoaded() ||          // Not loaded or
+        (lat < getLatitudeSW()  ||
+         lat > getLatitudeNE()) ||  // wrong latitude or
+        (lon < getLongitudeSW() ||
+         lon > getLongitudeNE())    // wrong longitude
+        ) return false;
+
+   double pointsLat = (lat - getLatitudeSW()) / latSpacing;
+   if (pointsLat < 0) pointsLat = 0;
+
+   double pointsLon = (lon - getLongitudeSW()) / lonSpacing;
+   if (pointsLon < 0) pointsLon = 0;
+
+   if (interp) {
+      // South-west corner post is [icol][irow]
+      unsigned int irow = static_cast<unsigned int>(pointsLat);
+      unsigned int icol = static_cast<unsigned int>(pointsLon);
+      if (irow > (nptlat-2)) irow = (nptlat-2);
+      if (icol > (nptlong-2)) icol = (nptlong-2);
+
+      short sw {}, nw {}, se {}, ne {};
+      if ( !getPost(&sw, icol, irow)   || !getPost(&nw, icol, irow+1) ||
+           !getPost(&se, icol+1, irow) || !getPost(&ne, icol+1, irow+1) ) return false;
+
+      // delta from s-w corner post
+      const double dLat = static_cast<double>(pointsLat - static_cast<double>(irow));
+      const double dLon = static_cast<double>(pointsLon - static_cast<double>(icol));
+
+      const double westPoint = sw + (nw - sw) * dLat;
+      const double eastPoint = se + (ne - se) * dLat;
+      *elev = westPoint + (eastPoint - westPoint) * dLon;
+   }
+   else {
+      // Nearest post
+      unsigned int irow = static_cast<unsigned int>(pointsLat + 0.5f);
+      unsigned int icol = static_cast<unsigned int>(pointsLon + 0.5f);
+      if (irow >= nptlat) irow = (nptlat-1);
+      if (icol >= nptlong) icol = (nptlong-1);
+
+      short v {};
+      if (!getPost(&v, icol, irow)) return false;
+      *elev = static_cast<double>(v);
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Posts and tiles
+//------------------------------------------------------------------------------
+
+// Elevation at post [icol][irow], or false if the post has no data
+bool TiledFile::getPost(short* const v, const unsigned int icol, const unsigned int irow) const
+{
+   const short* tile = getTile(icol, irow);
+   if (tile == nullptr) return false;
+
+   const short value = tile[(icol % TILE_SIZE) * TILE_SIZE + (irow % TILE_SIZE)];
+   if (value == voidValue) return false;
+
+   *v = value;
+   return true;
+}
+
+// Returns the tile that contains post [icol][irow], or zero if not stored
+const short* TiledFile::getTile(const unsigned int icol, const unsigned int irow) const
+{
+   const unsigned int idx = (icol / TILE_SIZE) * ntlat + (irow / TILE_SIZE);
+   const std::uint32_t slot = tileIndex[idx];
+   if (slot == 0) return nullptr;
+
+   touchTile(idx);
+   return tileData + static_cast<std::uint64_t>(slot - 1) * (TILE_SIZE * TILE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+// touchTile() -- marks tile 'idx' as referenced; if it isn't resident then it
+// replaces the first tile that the clock hand finds that hasn't been referenced
+// since the hand last passed it.
+//------------------------------------------------------------------------------
+void TiledFile::touchTile(const unsigned int idx) const
+{
+   unsigned char state = tileState[idx].load(std::memory_order_relaxed);
+   if (state == TILE_REFERENCED) return;
+   if (state == TILE_RESIDENT && tileState[idx].compare_exchange_strong(state, TILE_REFERENCED, std::memory_order_relaxed)) return;
+
+   base::lock(clockLock);
+   if (tileState[idx].load(std::memory_order_relaxed) == TILE_RELEASED) {
+      if (numResident < maxTiles) {
+         clock[numResident++] = idx;
+      }
+      else {
+         bool replaced = false;
+         while (!replaced) {
+            const unsigned int old = clock[hand];
+            unsigned char oldState = TILE_RESIDENT;
+            if (tileState[old].compare_exchange_strong(oldState, TILE_RELEASED, std::memory_order_relaxed)) {
+               releaseTile(old);
+               clock[hand] = idx;
+               replaced = true;
+            }
+            else {
+               // Referenced; give it another pass
+               tileState[old].store(TILE_RESIDENT, std::memory_order_relaxed);
+            }
+            hand = (hand + 1) % maxTiles;
+         }
+      }
+   }
+   tileState[idx].store(TILE_REFERENCED, std::memory_order_relaxed);
+   base::unlock(clockLock);
+}
+
+//------------------------------------------------------------------------------
+// releaseTile() -- releases tile 'idx' back to the operating system; the tile
+// stays mapped and will be paged in again by its next reference.
+//------------------------------------------------------------------------------
+void TiledFile::releaseTile(const unsigned int idx) const
+{
+   const std::uint32_t slot = tileIndex[idx];
+   if (slot == 0) return;
+
+   void* addr = const_cast<short*>(tileData + static_cast<std::uint64_t>(slot - 1) * (TILE_SIZE * TILE_SIZE));
+#if defined(WIN32)
+   // Unlocking pages that aren't locked removes them from our working set
+   ::VirtualUnlock(addr, static_cast<SIZE_T>(TILE_BYTES));
+#else
+   ::madvise(addr, static_cast<size_t>(TILE_BYTES), MADV_DONTNEED);
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Load (map) the tiled file
+//------------------------------------------------------------------------------
+bool TiledFile::loadData()
+{
+   clearData();
+
+   // Compute the filename
+   std::string filename;
+   const char* p = getPathname();
+   if (p != nullptr) {
+      filename += p;
+      filename += '/';
+   }
+   p = getFilename();
+   if (p != nullptr) {
+      filename += p;
+   }
+
+   if (!mapFile(filename.c_str())) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "TiledFile::loadData() ERROR, could not map file: " << filename << std::endl;
+      }
+      return false;
+   }
+
+   // Check the header
+   bool ok = (mapSize >= sizeof(FileHeader));
+   FileHeader hdr {};
+   if (ok) {
+      std::memcpy(&hdr, mapAddr, sizeof(FileHeader));
+      ok = ( std::memcmp(hdr.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0 &&
+             hdr.byteOrder == FILE_BYTE_ORDER &&
+             hdr.version == FILE_VERSION &&
+             hdr.tileSize == TILE_SIZE &&
+             hdr.nptlat >= 2 && hdr.nptlong >= 2 &&
+             hdr.ntlat == ((hdr.nptlat + TILE_SIZE - 1) / TILE_SIZE) &&
+             hdr.ntlong == ((hdr.nptlong + TILE_SIZE - 1) / TILE_SIZE) &&
+             hdr.latSpacing > 0 && hdr.lonSpacing > 0 &&
+             (hdr.dataOffset % FILE_ALIGNMENT) == 0 );
+   }
+   const std::uint64_t ntiles = static_cast<std::uint64_t>(hdr.ntlat) * hdr.ntlong;
+   if (ok) {
+      ok = ( (sizeof(FileHeader) + ntiles * sizeof(std::uint32_t)) <= hdr.dataOffset &&
+             (hdr.dataOffset + hdr.numTiles * TILE_BYTES) <= mapSize );
+   }
+   if (ok) {
+      tileIndex = reinterpret_cast<const std::uint32_t*>(mapAddr + sizeof(FileHeader));
+      for (std::uint64_t i = 0; i < ntiles && ok; i++) {
+         ok = (tileIndex[i] <= hdr.numTiles);
+      }
+   }
+   if (!ok) {
+      if (isMessageEnabled(MSG_ERROR)) {
+         std::cerr << "TiledFile::loadData() ERROR, invalid tiled file: " << filename << std::endl;
+      }
+      clearData();
+      return false;
+   }
+
+   tileData = reinterpret_cast<const short*>(mapAddr + hdr.dataOffset);
+
+   nptlat = hdr.nptlat;
+   nptlong = hdr.nptlong;
+   ntlat = hdr.ntlat;
+   ntlong = hdr.ntlong;
+   latSpacing = hdr.latSpacing;
+   lonSpacing = hdr.lonSpacing;
+   voidValue = static_cast<short>(hdr.voidValue);
+
+   setLatitudeSW(hdr.swLat);
+   setLongitudeSW(hdr.swLon);
+   setLatitudeNE(hdr.swLat + (nptlat - 1) * latSpacing);
+   setLongitudeNE(hdr.swLon + (nptlong - 1) * lonSpacing);
+   setMinElevation(hdr.minElev);
+   setMaxElevation(hdr.maxElev);
+
+   // Resident tiles
+   tileState = new std::atomic<unsigned char>[ntiles];
+   for (std::uint64_t i = 0; i < ntiles; i++) {
+      tileState[i].store(TILE_RELEASED, std::memory_order_relaxed);
+   }
+   clock = new unsigned int[maxTiles];
+   numResident = 0;
+   hand = 0;
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Map and unmap the file
+//------------------------------------------------------------------------------
+bool TiledFile::mapFile(const char* const filename)
+{
+#if defined(WIN32)
+   HANDLE fh = ::CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+   if (fh == INVALID_HANDLE_VALUE) return false;
+
+   LARGE_INTEGER size {};
+   HANDLE mh = nullptr;
+   const void* addr = nullptr;
+   if (::GetFileSizeEx(fh, &size) && size.QuadPart > 0) {
+      mh = ::CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mh != nullptr) {
+         addr = ::MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+      }
+   }
+   if (addr == nullptr) {
+      if (mh != nullptr) ::CloseHandle(mh);
+      ::CloseHandle(fh);
+      return false;
+   }
+
+   fileHandle = fh;
+   mapHandle = mh;
+   mapAddr = static_cast<const unsigned char*>(addr);
+   mapSize = static_cast<std::uint64_t>(size.QuadPart);
+#else
+   const int fdes = ::open(filename, O_RDONLY);
+   if (fdes < 0) return false;
+
+   struct stat st {};
+   void* addr = MAP_FAILED;
+   if (::fstat(fdes, &st) == 0 && st.st_size > 0) {
+      addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fdes, 0);
+   }
+   if (addr == MAP_FAILED) {
+      ::close(fdes);
+      return false;
+   }
+
+   // Access to the tiles is random
+   ::madvise(addr, static_cast<size_t>(st.st_size), MADV_RANDOM);
+
+   fd = fdes;
+   mapAddr = static_cast<const unsigned char*>(addr);
+   mapSize = static_cast<std::uint64_t>(st.st_size);
+#endif
+   return true;
+}
+
+void TiledFile::unmapFile()
+{
+   if (mapAddr != nullptr) {
+#if defined(WIN32)
+      ::UnmapViewOfFile(mapAddr);
+      ::CloseHandle(static_cast<HANDLE>(mapHandle));
+      ::CloseHandle(static_cast<HANDLE>(fileHandle));
+      mapHandle = nullptr;
+      fileHandle = nullptr;
+#else
+      ::munmap(const_cast<unsigned char*>(mapAddr), static_cast<size_t>(mapSize));
+      ::close(fd);
+      fd = -1;
+#endif
+   }
+   mapAddr = nullptr;
+   mapSize = 0;
+   tileIndex = nullptr;
+   tileData = nullptr;
+}
+
+//------------------------------------------------------------------------------
+// clear our data
+//------------------------------------------------------------------------------
+void TiledFile::clearData()
+{
+   unmapFile();
+
+   if (tileState != nullptr) { delete[] tileState; tileState = nullptr; }
+   if (clock != nullptr)     { delete[] clock;     clock = nullptr; }
+   numResident = 0;
+   hand = 0;
+
+   nptlat = 0;
+   nptlong = 0;
+   ntlat = 0;
+   ntlong = 0;
+   latSpacing = 0;
+   lonSpacing = 0;
+
+   setLatitudeSW(0);
+   setLongitudeSW(0);
+   setLatitudeNE(0);
+   setLongitudeNE(0);
+
+   setMinElevation(0);
+   setMaxElevation(0);
+}
+
+//------------------------------------------------------------------------------
+// convert() -- creates the tiled file 'filename' from the 'n' loaded data
+// files in 'files'.  The mosaic has the finest latitude and longitude post
+// spacings of the files, and the posts of files with a coarser spacing (e.g.,
+// DTED longitude spacing above 50 degrees latitude) are resampled to it using
+// the nearest post.  Where the files overlap, the first file's non-void posts
+// are used.
+//------------------------------------------------------------------------------
+bool TiledFile::convert(
+      const char* const filename,         // Tiled file name
+      const DataFile* const* const files, // Data files
+      const unsigned int n                // Number of data files
+   )
+{
+   if (filename == nullptr || files == nullptr || n == 0) return false;
+
+   // ---
+   // Check the data files and find the extent of the mosaic
+   // ---
+   for (unsigned int i = 0; i < n; i++) {
+      if (files[i] == nullptr || !files[i]->isDataLoaded() ||
+          files[i]->getNumLatPoints() < 2 || files[i]->getNumLonPoints() < 2) {
+         std::cerr << "TiledFile::convert() ERROR, data file " << i << " isn't loaded" << std::endl;
+         return false;
+      }
+   }
+   double latSpacing = files[0]->getLatSpacing();
+   double lonSpacing = files[0]->getLonSpacing();
+   double swLat = files[0]->getLatitudeSW();
+   double swLon = files[0]->getLongitudeSW();
+   double neLat = files[0]->getLatitudeNE();
+   double neLon = files[0]->getLongitudeNE();
+   for (unsigned int i = 1; i < n; i++) {
+      if (files[i]->getLatSpacing() < latSpacing) latSpacing = files[i]->getLatSpacing();
+      if (files[i]->getLonSpacing() < lonSpacing) lonSpacing = files[i]->getLonSpacing();
+      if (files[i]->getLatitudeSW() < swLat)  swLat = files[i]->getLatitudeSW();
+      if (files[i]->getLongitudeSW() < swLon) swLon = files[i]->getLongitudeSW();
+      if (files[i]->getLatitudeNE() > neLat)  neLat = files[i]->getLatitudeNE();
+      if (files[i]->getLongitudeNE() > neLon) neLon = files[i]->getLongitudeNE();
+   }
+
+   const double nlat = std::floor((neLat - swLat) / latSpacing + 0.5) + 1.0;
+   const double nlon = std::floor((neLon - swLon) / lonSpacing + 0.5) + 1.0;
+   const double nt = std::ceil(nlat / TILE_SIZE) * std::ceil(nlon / TILE_SIZE);
+   if (nt >= 4294967295.0) {
+      std::cerr << "TiledFile::convert() ERROR, too many tiles" << std::endl;
+      return false;
+   }
+
+   FileHeader hdr {};
+   std::memcpy(hdr.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+   hdr.byteOrder = FILE_BYTE_ORDER;
+   hdr.version = FILE_VERSION;
+   hdr.tileSize = TILE_SIZE;
+   hdr.nptlat = static_cast<std::uint32_t>(nlat);
+   hdr.nptlong = static_cast<std::uint32_t>(nlon);
+   hdr.ntlat = (hdr.nptlat + TILE_SIZE - 1) / TILE_SIZE;
+   hdr.ntlong = (hdr.nptlong + TILE_SIZE - 1) / TILE_SIZE;
+   hdr.swLat = swLat;
+   hdr.swLon = swLon;
+   hdr.latSpacing = latSpacing;
+   hdr.lonSpacing = lonSpacing;
+   hdr.minElev = 0;
+   hdr.maxElev = 0;
+   hdr.voidValue = -32767;
+
+   const unsigned int ntiles = hdr.ntlat * hdr.ntlong;
+   hdr.dataOffset = alignUp(sizeof(FileHeader) + static_cast<std::uint64_t>(ntiles) * sizeof(std::uint32_t), FILE_ALIGNMENT);
+
+   // ---
+   // Post offsets of each data file within the mosaic, and the tiles to store
+   // ---
+   Placement* place = new Placement[n];
+   std::uint32_t* index = new std::uint32_t[ntiles];
+   for (unsigned int t = 0; t < ntiles; t++) index[t] = 0;
+
+   for (unsigned int i = 0; i < n; i++) {
+      Placement& pl = place[i];
+      pl.row0 = static_cast<unsigned int>(std::floor((files[i]->getLatitudeSW() - swLat) / latSpacing + 0.5));
+      pl.col0 = static_cast<unsigned int>(std::floor((files[i]->getLongitudeSW() - swLon) / lonSpacing + 0.5));
+      pl.rowScale = latSpacing / files[i]->getLatSpacing();
+      pl.colScale = lonSpacing / files[i]->getLonSpacing();
+      pl.row1 = pl.row0 + static_cast<unsigned int>(std::floor((files[i]->getNumLatPoints() - 1) / pl.rowScale + 0.5));
+      pl.col1 = pl.col0 + static_cast<unsigned int>(std::floor((files[i]->getNumLonPoints() - 1) / pl.colScale + 0.5));
+      if (pl.row1 >= hdr.nptlat) pl.row1 = hdr.nptlat - 1;
+      if (pl.col1 >= hdr.nptlong) pl.col1 = hdr.nptlong - 1;
+
+      for (unsigned int tc = pl.col0 / TILE_SIZE; tc <= pl.col1 / TILE_SIZE; tc++) {
+         for (unsigned int tr = pl.row0 / TILE_SIZE; tr <= pl.row1 / TILE_SIZE; tr++) {
+            index[tc * hdr.ntlat + tr] = 1;
+         }
+      }
+   }
+   for (unsigned int t = 0; t < ntiles; t++) {
+      if (index[t] != 0) index[t] = ++hdr.numTiles;
+   }
+
+   // ---
+   // Write the header and the tile index
+   // ---
+   std::ofstream out;
+   out.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+   bool ok = !out.fail();
+   if (ok) {
+      out.write(reinterpret_cast<const char*>(&hdr), sizeof(FileHeader));
+      out.write(reinterpret_cast<const char*>(index), static_cast<std::streamsize>(ntiles * sizeof(std::uint32_t)));
+      const std::uint64_t pad = hdr.dataOffset - (sizeof(FileHeader) + static_cast<std::uint64_t>(ntiles) * sizeof(std::uint32_t));
+      for (std::uint64_t k = 0; k < pad; k++) out.put('\0');
+      ok = !out.fail();
+   }
+
+   // ---
+   // Write the tiles
+   // ---
+   short* tile = new short[TILE_SIZE * TILE_SIZE];
+   double minElev = 999999.0;
+   double maxElev = -999999.0;
+   for (unsigned int t = 0; t < ntiles && ok; t++) {
+      if (index[t] == 0) continue;
+
+      for (unsigned int k = 0; k < (TILE_SIZE * TILE_SIZE); k++) tile[k] = static_cast<short>(hdr.voidValue);
+
+      // Post range of this tile
+      const unsigned int c0 = (t / hdr.ntlat) * TILE_SIZE;
+      const unsigned int r0 = (t % hdr.ntlat) * TILE_SIZE;
+
+      for (unsigned int i = 0; i < n; i++) {
+         const Placement& pl = place[i];
+         if ( pl.row1 < r0 || pl.row0 >= (r0 + TILE_SIZE) ||
+              pl.col1 < c0 || pl.col0 >= (c0 + TILE_SIZE) ) continue;
+
+         const unsigned int nr = files[i]->getNumLatPoints();
+         const unsigned int nc = files[i]->getNumLonPoints();
+         const unsigned int cb = (pl.col0 > c0 ? pl.col0 : c0);
+         const unsigned int ce = (pl.col1 < (c0 + TILE_SIZE - 1) ? pl.col1 : (c0 + TILE_SIZE - 1));
+         const unsigned int rb = (pl.row0 > r0 ? pl.row0 : r0);
+         const unsigned int re = (pl.row1 < (r0 + TILE_SIZE - 1) ? pl.row1 : (r0 + TILE_SIZE - 1));
+         const short fileVoid = files[i]->getVoidValue();
+
+         for (unsigned int c = cb; c <= ce; c++) {
+            // Nearest file column
+            unsigned int fc = static_cast<unsigned int>((c - pl.col0) * pl.colScale + 0.5);
+            if (fc >= nc) fc = nc - 1;
+            const short* column = files[i]->getColumn(fc);
+            if (column == nullptr) continue;
+            short* dst = tile + (c - c0) * TILE_SIZE;
+            for (unsigned int r = rb; r <= re; r++) {
+               // Nearest file row
+               unsigned int fr = static_cast<unsigned int>((r - pl.row0) * pl.rowScale + 0.5);
+               if (fr >= nr) fr = nr - 1;
+               const short v = column[fr];
+               if (v == fileVoid || v == hdr.voidValue || dst[r - r0] != hdr.voidValue) continue;
+               dst[r - r0] = v;
+               if (v < minElev) minElev = v;
+               if (v > maxElev) maxElev = v;
+            }
+         }
+      }
+
+      out.write(reinterpret_cast<const char*>(tile), static_cast<std::streamsize>(TILE_BYTES));
+      ok = !out.fail();
+   }
+
+   // Rewrite the header with the elevation limits
+   if (ok && minElev <= maxElev) {
+      hdr.minElev = minElev;
+      hdr.maxElev = maxElev;
+      out.seekp(0);
+      out.write(reinterpret_cast<const char*>(&hdr), sizeof(FileHeader));
+      ok = !out.fail();
+   }
+   out.close();
+
+   if (!ok) {
+      std::cerr << "TiledFile::convert() ERROR, could not write file: " << filename << std::endl;
+   }
+
+   delete[] tile;
+   delete[] index;
+   delete[] place;
+
+   return ok;
+}
+
+}
+}
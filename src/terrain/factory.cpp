@@ -1,9 +1,11 @@
 
 #include "mixr/terrain/factory.hpp"
 
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 
 #include "mixr/terrain/QuadMap.hpp"
+#include "mixr/terrain/TiledFile.hpp"
 #include "mixr/terrain/ded/DedFile.hpp"
 #include "mixr/terrain/dted/DtedFile.hpp"
 #include "mixr/terrain/srtm/SrtmHgtFile.hpp"
@@ -13,24 +15,23 @@
 namespace mixr {
 namespace terrain {
 
+namespace {
+
+const base::FactoryTable::Entry entries[] = {
+    FACTORY_ENTRY(QuadMap),
+    FACTORY_ENTRY(TiledFile),
+    FACTORY_ENTRY(DedFile),
+    FACTORY_ENTRY(DtedFile),
+    FACTORY_ENTRY(SrtmHgtFile),
+};
+
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+
+}
+
 base::Object* factory(const std::string& name)
 {
-    base::Object* obj {};
-
-    if ( name == QuadMap::getFactoryName() ) {
-        obj = new QuadMap();
-    }
-    else if ( name == DedFile::getFactoryName() ) {
-        obj = new DedFile();
-    }
-    else if ( name == DtedFile::getFactoryName() ) {
-        obj = new DtedFile();
-    }
-    else if ( name == SrtmHgtFile::getFactoryName() ) {
-        obj = new SrtmHgtFile();
-    }
-
-    return obj;
+    return table.create(name);
 }
 
 }
@@ -1,6 +1,7 @@
 
 #include "mixr/ui/glut/factory.hpp"
 
+#include "mixr/base/FactoryTable.hpp"
 #include "mixr/base/Object.hpp"
 
 #include "mixr/ui/glut/GlutDisplay.hpp"
@@ -11,47 +12,31 @@
 namespace mixr {
 namespace glut {
 
-base::Object* factory(const std::string& name)
-{
-    base::Object* obj {};
+namespace {
 
+const base::FactoryTable::Entry entries[] = {
     // General graphics support
-    if ( name == GlutDisplay::getFactoryName() ) {
-      obj = new GlutDisplay();
-    }
+    FACTORY_ENTRY(GlutDisplay),
     // glut shapes support
-    else if ( name == Sphere::getFactoryName() ) {
-      obj = new Sphere();
-    }
-    else if ( name == Cylinder::getFactoryName() ) {
-      obj = new Cylinder();
-    }
-    else if ( name == Cone::getFactoryName() ) {
-      obj = new Cone();
-    }
-    else if ( name == Cube::getFactoryName() ) {
-      obj = new Cube();
-    }
-    else if ( name == Torus::getFactoryName() ) {
-      obj = new Torus();
-    }
-    else if ( name == Dodecahedron::getFactoryName() ) {
-      obj = new Dodecahedron();
-    }
-    else if ( name == Tetrahedron::getFactoryName() ) {
-      obj = new Tetrahedron();
-    }
-    else if ( name == Icosahedron::getFactoryName() ) {
-      obj = new Icosahedron();
-    }
-    else if ( name == Octahedron::getFactoryName() ) {
-      obj = new Octahedron();
-    }
-    else if ( name == Teapot::getFactoryName() ) {
-      obj = new Teapot();
-    }
-
-    return obj;
+    FACTORY_ENTRY(Sphere),
+    FACTORY_ENTRY(Cylinder),
+    FACTORY_ENTRY(Cone),
+    FACTORY_ENTRY(Cube),
+    FACTORY_ENTRY(Torus),
+    FACTORY_ENTRY(Dodecahedron),
+    FACTORY_ENTRY(Tetrahedron),
+    FACTORY_ENTRY(Icosahedron),
+    FACTORY_ENTRY(Octahedron),
+    FACTORY_ENTRY(Teapot),
+};
+
+const base::FactoryTable table(entries, sizeof(entries)/sizeof(entries[0]));
+
+}
+
+base::Object* factory(const std::string& name)
+{
+    return table.create(name);
 }
 
 }